@@ -105,6 +105,9 @@ set(USE_GRAPH_EXECUTOR ON)
 # Whether enable tiny graph executor with CUDA Graph
 set(USE_GRAPH_EXECUTOR_CUDA_GRAPH OFF)
 
+# Whether enable tiny graph executor with hipGraph
+set(USE_GRAPH_EXECUTOR_ROCM_GRAPH OFF)
+
 # Whether to enable the profiler for the graph executor and vm
 set(USE_PROFILER ON)
 
@@ -198,6 +201,9 @@ set(USE_ROCBLAS OFF)
 # Whether use contrib sort
 set(USE_SORT ON)
 
+# Whether use contrib embedding lookup
+set(USE_EMBEDDING ON)
+
 # Whether use MKL-DNN (DNNL) codegen
 set(USE_DNNL_CODEGEN OFF)
 
@@ -263,12 +269,20 @@ set(USE_VTA_FPGA OFF)
 # Whether use Thrust
 set(USE_THRUST OFF)
 
+# Whether use the batched CUDA NMS kernel
+set(USE_CUDA_NMS OFF)
+
 # Whether to build the TensorFlow TVMDSOOp module
 set(USE_TF_TVMDSOOP OFF)
 
 # Whether to use STL's std::unordered_map or TVM's POD compatible Map
 set(USE_FALLBACK_STL_MAP OFF)
 
+# Whether to compile internal checks (ICHECK) down to raw branch-hinted
+# conditionals without error message formatting. Intended for release
+# runtime builds where check overhead is measurable in tight loops.
+set(USE_MINIMAL_RUNTIME_CHECKS OFF)
+
 # Whether to use hexagon device
 set(USE_HEXAGON_DEVICE OFF)
 set(USE_HEXAGON_SDK /path/to/sdk)
@@ -65,6 +65,14 @@ if(USE_CUDA)
     list(APPEND RUNTIME_SRCS ${CONTRIB_THRUST_SRC})
   endif(USE_THRUST)
 
+  if(USE_CUDA_NMS)
+    message(STATUS "Build with CUDA NMS support")
+    cmake_minimum_required(VERSION 3.13) # to compile CUDA code
+    enable_language(CUDA)
+    file(GLOB CONTRIB_NMS_SRC src/runtime/contrib/nms/*.cu)
+    list(APPEND RUNTIME_SRCS ${CONTRIB_NMS_SRC})
+  endif(USE_CUDA_NMS)
+
   if(USE_GRAPH_EXECUTOR_CUDA_GRAPH)
     if(NOT USE_GRAPH_EXECUTOR)
       message(FATAL_ERROR "CUDA Graph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
@@ -65,6 +65,15 @@ if(USE_ROCM)
     list(APPEND TVM_RUNTIME_LINKER_LIBS roc::rocthrust)
   endif(USE_THRUST)
 
+  if(USE_GRAPH_EXECUTOR_ROCM_GRAPH)
+    if(NOT USE_GRAPH_EXECUTOR)
+      message(FATAL_ERROR "hipGraph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
+    endif()
+    message(STATUS "Build with Graph executor with hipGraph support...")
+    file(GLOB RUNTIME_ROCM_GRAPH_SRCS src/runtime/graph_executor/rocm_graph/*.cc)
+    list(APPEND RUNTIME_SRCS ${RUNTIME_ROCM_GRAPH_SRCS})
+  endif()
+
 else(USE_ROCM)
   list(APPEND COMPILER_SRCS src/target/opt/build_rocm_off.cc)
 endif(USE_ROCM)
@@ -147,6 +147,13 @@ class ConstIntBoundAnalyzer {
    */
   TVM_DLL void Bind(const Var& var, const Range& range, bool allow_override = false);
 
+  /*!
+   * \brief Reset the memo table of analyzed bounds.
+   *
+   *  Called when facts the cached results may rely on change.
+   */
+  TVM_DLL void ResetMemo();
+
  private:
   friend class Analyzer;
   friend class ConstraintContext;
@@ -163,6 +170,8 @@ class ConstIntBoundAnalyzer {
   class Impl;
   /*! \brief Internal impl */
   Impl* impl_;
+  /*! \brief pointer to the parent analyzer, used to invalidate dependent memo tables */
+  Analyzer* parent_{nullptr};
 };
 
 /*!
@@ -228,6 +237,14 @@ class ModularSetAnalyzer {
    */
   TVM_DLL void Update(const Var& var, const ModularSet& info, bool allow_override = false);
 
+  /*!
+   * \brief Reset the memo table of analyzed modular sets.
+   *
+   *  Called when facts the cached results may rely on change, including facts of the
+   *  other sub-analyzers, which are consulted through the parent analyzer.
+   */
+  TVM_DLL void ResetMemo();
+
  private:
   friend class Analyzer;
   friend class ConstraintContext;
@@ -267,6 +284,15 @@ class RewriteSimplifier {
    */
   TVM_DLL void Update(const Var& var, const PrimExpr& new_expr, bool allow_override = false);
 
+  /*!
+   * \brief Reset the memo table of simplified expressions.
+   *
+   *  Cached results may depend on facts in the other sub-analyzers through the parent
+   *  analyzer, so this must be called whenever such facts are updated without going
+   *  through Update or EnterConstraint (e.g. when a range is bound on the analyzer).
+   */
+  TVM_DLL void ResetMemo();
+
   std::function<void()> EnterConstraint(const PrimExpr& constraint);
 
  private:
@@ -38,6 +38,8 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/te/schedule.h>
 
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -165,6 +167,44 @@ class AccessAnalyzer : public ObjectRef {
   TVM_DEFINE_OBJECT_REF_METHODS(AccessAnalyzer, ObjectRef, AccessAnalyzerNode);
 };
 
+/*!
+ * \brief A thread-safe memo of InferBound results, keyed by the record
+ * serialization of a state's transform steps.
+ *
+ * During evolutionary search the same state is bound-inferred many times
+ * (survivors pass through every generation), so reusing the exact result
+ * removes a large share of the schedule replays. Entries only describe the
+ * DAG that owns the memo: copying the owning node starts with an empty memo.
+ */
+class InferBoundMemo {
+ public:
+  InferBoundMemo() = default;
+  InferBoundMemo(const InferBoundMemo&) {}
+  InferBoundMemo& operator=(const InferBoundMemo&) { return *this; }
+
+  /*!
+   * \brief Look up the memoized result for a step sequence.
+   * \param key The record serialization of the transform steps.
+   * \param out The memoized state with bound information, if found.
+   * \return Whether the key was found.
+   */
+  bool Lookup(const std::string& key, State* out) const;
+
+  /*!
+   * \brief Memoize the result for a step sequence.
+   * \param key The record serialization of the transform steps.
+   * \param state The state with bound information.
+   */
+  void Add(const std::string& key, const State& state) const;
+
+ private:
+  /*! \brief Drop all entries once the memo grows to this many states. */
+  static constexpr size_t kMaxEntries = 65536;
+  /*! \brief The members are mutable so the memo can live in a const node. */
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, State> memo_;
+};
+
 /*! \brief The auto-scheduler's computational graph and related program analyses. */
 class ComputeDAGNode : public Object {
  public:
@@ -181,6 +221,8 @@ class ComputeDAGNode : public Object {
   State init_state;
   /*! \brief The static read-write access analyzer. */
   AccessAnalyzer access_analyzer;
+  /*! \brief Memoized InferBound results; not part of the visited attributes. */
+  InferBoundMemo infer_bound_memo;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("tensors", &tensors);
@@ -118,6 +118,55 @@ class RandomModel : public CostModel {
   using ContainerType = RandomModelNode;
 };
 
+/*!
+ * \brief A lightweight multi-layer perceptron cost model implemented in C++.
+ *
+ * The model is trained on the per-store feature vectors produced by feature.cc
+ * and scores a state from the mean of its per-store feature blocks. Both
+ * training and batched inference stay inside C++, so search policies can score
+ * large populations without the FFI round trip of PythonBasedModel.
+ */
+class MLPModelNode : public CostModelNode {
+ public:
+  /*! \brief The maximum number of buffers per store used in feature extraction. */
+  int max_n_bufs{5};
+  /*! \brief The width of one per-store feature block; set on the first update. */
+  int feature_size{0};
+  /*! \brief The width of the hidden layer. */
+  int hidden_size{128};
+  /*! \brief Hidden layer weights, row major with shape [hidden_size, feature_size]. */
+  std::vector<float> w1;
+  /*! \brief Hidden layer bias with shape [hidden_size]. */
+  std::vector<float> b1;
+  /*! \brief Output layer weights with shape [hidden_size]. */
+  std::vector<float> w2;
+  /*! \brief Output layer bias. */
+  float b2{0.0f};
+  /*! \brief All measure inputs seen so far; the model is retrained on the full set. */
+  Array<MeasureInput> measured_inputs;
+  /*! \brief All measure results seen so far. */
+  Array<MeasureResult> measured_results;
+
+  void Update(const Array<MeasureInput>& inputs, const Array<MeasureResult>& results) final;
+
+  void Predict(const SearchTask& task, const Array<State>& states,
+               std::vector<float>* scores) final;
+
+  static constexpr const char* _type_key = "auto_scheduler.MLPModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(MLPModelNode, CostModelNode);
+};
+
+/*!
+ * \brief Managed reference to MLPModelNode.
+ * \sa MLPModelNode
+ */
+class MLPModel : public CostModel {
+ public:
+  MLPModel();
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(MLPModel, CostModel, MLPModelNode);
+};
+
 /*! \brief A wrapper for cost model defined by python code
  *  This class will call functions defined in the python */
 class PythonBasedModelNode : public CostModelNode {
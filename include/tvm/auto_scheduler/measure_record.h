@@ -134,6 +134,27 @@ void WriteMeasureRecords(std::ostream* os, const Array<MeasureInput>& inputs,
 void ReadMeasureRecord(const std::string& str, MeasureInputNode* inp, MeasureResultNode* res,
                        std::string* log_version);
 
+/*!
+ * \brief Build or refresh the sidecar index of a record log file.
+ *
+ * The index (stored next to the log as `filename + ".idx"`) keeps the byte offset and cost
+ * of the best valid record for every (workload key, target) pair in the log. It is extended
+ * incrementally: only the part of the log appended since the last call is scanned, so records
+ * can keep being appended to the log without invalidating the index.
+ * \param filename The name of the record log file.
+ */
+void UpdateRecordIndex(const String& filename);
+
+/*!
+ * \brief Load the best valid record of every (workload key, target) pair from a log file.
+ *
+ * This uses the sidecar index built by UpdateRecordIndex (refreshing it first if the log
+ * has grown), so only the best records are parsed instead of the whole log.
+ * \param filename The name of the record log file.
+ * \return The best MeasureInputs and MeasureResults, one pair per workload.
+ */
+std::pair<Array<MeasureInput>, Array<MeasureResult>> ReadBestRecords(const String& filename);
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
@@ -69,6 +69,10 @@ class HardwareParamsNode : public Object {
 
   /*!
    * \brief Get the default hardware params.
+   *
+   * For GPU targets the parameters are queried from the device API; for CPU
+   * targets compiled for the host they are probed with small microbenchmarks.
+   * Detection runs on the first use of a target and the result is cached.
    * \param target A `tvm.target`.
    * \param target_host A `tvm.target` for host device.
    * \return A HardwareParams object.
@@ -0,0 +1,134 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/auto_scheduler/task_scheduler.h
+ * \brief Allocate the measurement budget of one tuning run across several
+ * search tasks, so trials go where end-to-end latency improves most.
+ *
+ * All tasks share one ProgramMeasurer, so measurement infrastructure
+ * (builder, runner, record callbacks) is set up once per run. Progress is
+ * checkpointed through the regular measure record log: restarting with the
+ * same log restores per-task trial counts and best costs and preloads the
+ * measured states into each search policy.
+ */
+
+#ifndef TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+#define TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
+
+#include <tvm/auto_scheduler/auto_schedule.h>
+#include <tvm/auto_scheduler/search_policy.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace auto_scheduler {
+
+/*! \brief A scheduler tuning multiple search tasks within one measurement budget. */
+class TaskSchedulerNode : public Object {
+ public:
+  /*! \brief The search policies, one per task. */
+  Array<SearchPolicy> search_policies;
+  /*! \brief The weight (number of appearances in the end-to-end model) of each task. */
+  Array<FloatImm> task_weights;
+  /*! \brief The allocation strategy: "round-robin" or "gradient". */
+  String strategy;
+  /*! \brief A measure record log to restore the tuning state from; empty to start fresh. */
+  String load_log_file;
+  /*! \brief Blend factor between backward and forward gradient in the gradient strategy. */
+  double alpha;
+  /*! \brief Number of rounds the backward gradient looks over. */
+  int backward_window_size;
+  /*! \brief Stop tuning a task after this many trials without improvement; -1 to disable. */
+  int per_task_early_stopping;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("search_policies", &search_policies);
+    v->Visit("task_weights", &task_weights);
+    v->Visit("strategy", &strategy);
+    v->Visit("load_log_file", &load_log_file);
+    v->Visit("alpha", &alpha);
+    v->Visit("backward_window_size", &backward_window_size);
+    v->Visit("per_task_early_stopping", &per_task_early_stopping);
+  }
+
+  /*!
+   * \brief Tune all tasks within one measurement budget.
+   * \param tuning_options The options shared by all tasks. num_measure_trials is the
+   * total budget and num_measures_per_round is the slice a task gets when picked.
+   */
+  void Tune(const TuningOptions& tuning_options);
+
+  static constexpr const char* _type_key = "auto_scheduler.TaskScheduler";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TaskSchedulerNode, Object);
+
+ private:
+  /*! \brief Sum of weighted best costs, the end-to-end latency estimate. */
+  double ComputeScore() const;
+  /*! \brief Pick the next task index with the configured strategy. */
+  int NextTaskIdx();
+  /*! \brief Run one search round of one task on the shared measurer. */
+  void TuneTask(int idx, const ProgramMeasurer& measurer);
+  /*! \brief Restore per-task counters and best costs from the log file. */
+  void RestoreStatus();
+
+  // Round-robin cursor.
+  int last_task_idx_{-1};
+  // Number of finished rounds and best cost of each task.
+  std::vector<int> task_cts_;
+  std::vector<int> task_best_cts_;
+  std::vector<double> best_costs_;
+  // Best cost after each finished round, driving the backward gradient.
+  std::vector<std::vector<double>> cost_history_;
+  // Tasks that stopped improving or ran out of search space.
+  std::unordered_set<int> dead_tasks_;
+  // Trials consumed so far and the per-pick slice.
+  int trial_ct_{0};
+  int num_measures_per_round_{0};
+};
+
+/*!
+ * \brief Managed reference to TaskSchedulerNode.
+ * \sa TaskSchedulerNode
+ */
+class TaskScheduler : public ObjectRef {
+ public:
+  /*!
+   * \brief The constructor.
+   * \param search_policies The search policies, one per task.
+   * \param task_weights The weight of each task in the end-to-end latency.
+   * \param strategy The allocation strategy, "round-robin" or "gradient".
+   * \param load_log_file A measure record log to restore state from; empty for none.
+   * \param alpha Blend factor between backward and forward gradient.
+   * \param backward_window_size Number of rounds the backward gradient looks over.
+   * \param per_task_early_stopping Per-task no-improvement trial limit; -1 to disable.
+   */
+  TaskScheduler(Array<SearchPolicy> search_policies, Array<FloatImm> task_weights, String strategy,
+                String load_log_file, double alpha, int backward_window_size,
+                int per_task_early_stopping);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(TaskScheduler, ObjectRef, TaskSchedulerNode);
+};
+
+}  // namespace auto_scheduler
+}  // namespace tvm
+
+#endif  // TVM_AUTO_SCHEDULER_TASK_SCHEDULER_H_
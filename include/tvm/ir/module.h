@@ -157,6 +157,27 @@ class IRModuleNode : public Object {
    */
   TVM_DLL Array<GlobalVar> GetGlobalVars() const;
 
+  /*!
+   * \brief Look up the stable integer id of a global function.
+   *
+   *  Ids are dense, assigned in insertion order and never reused, so they
+   *  survive updates to the function's definition and can key dense
+   *  per-function side tables in passes.
+   * \param var The global var of the function.
+   * \returns The stable id of the function.
+   */
+  TVM_DLL int64_t GetFunctionId(const GlobalVar& var) const;
+
+  /*!
+   * \brief Collect the global vars of all functions in stable id order.
+   *
+   *  Unlike GetGlobalVars, the result does not depend on the layout of the
+   *  underlying map, which gives passes a deterministic and cheap iteration
+   *  order over the module's functions.
+   * \returns An array of global vars sorted by their stable function ids.
+   */
+  TVM_DLL Array<GlobalVar> GetFunctionOrder() const;
+
   /*!
    * \brief Look up a global function by its name.
    * \param str The unique string specifying the global variable.
@@ -266,6 +287,16 @@ class IRModuleNode : public Object {
    */
   std::unordered_map<int32_t, Constructor> constructor_tag_map_;
 
+  /*! \brief Stable function ids keyed by the function's global name.
+   * Ids are dense, assigned in insertion order and never reused.
+   */
+  std::unordered_map<String, int64_t> function_id_map_;
+
+  /*! \brief Global vars indexed by their stable function id.
+   * Slots of removed functions are left undefined.
+   */
+  std::vector<GlobalVar> function_order_;
+
   /*! \brief The files previously imported, required to ensure
       importing is idempotent for each module.
    */
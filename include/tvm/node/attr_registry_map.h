@@ -79,6 +79,25 @@ class AttrRegistryMapContainerMap {
       return def_value;
     }
   }
+  /*!
+   * \brief Get a pointer to the stored value at key without conversion.
+   *
+   *  A single table probe that merges the usual count() + operator[] pair and
+   *  skips the TVMRetValue -> ValueType conversion, for passes that query an
+   *  attribute once per visited node. The pointer stays valid until the next
+   *  attribute registration resizes the table, so do not hold it across
+   *  registrations.
+   * \param key The key to the map.
+   * \return Pointer to the stored value, or nullptr when not registered.
+   */
+  const runtime::TVMRetValue* GetRaw(const KeyType& key) const {
+    if (!key.defined()) return nullptr;
+    const uint32_t idx = key->AttrRegistryIndex();
+    if (idx < data_.size() && data_[idx].second != 0) {
+      return &data_[idx].first;
+    }
+    return nullptr;
+  }
 
  private:
   /*! \brief The name of the attr field */
@@ -124,6 +143,13 @@ class AttrRegistryMap {
    * \return the const reference to the content value.
    */
   ValueType get(const KeyType& key, ValueType def_value) const { return map_.get(key, def_value); }
+  /*!
+   * \brief Get a pointer to the raw stored value at key without conversion.
+   * \param key The key to the map
+   * \return Pointer to the stored value, or nullptr when not registered.
+   * \sa AttrRegistryMapContainerMap::GetRaw
+   */
+  const runtime::TVMRetValue* GetRaw(const KeyType& key) const { return map_.GetRaw(key); }
 
  protected:
   /*! \brief The internal map field */
@@ -47,5 +47,28 @@ TVM_DLL std::string SaveJSON(const runtime::ObjectRef& node);
  */
 TVM_DLL runtime::ObjectRef LoadJSON(std::string json_str);
 
+/*!
+ * \brief Save the node as well as all the nodes it depends on as a compact
+ *  binary blob.
+ *
+ *  The format stores the same reflection-based node table as SaveJSON but
+ *  with varint-encoded indices, an interned string pool and raw NDArray
+ *  payloads, so it is both smaller and much faster to load. Use it for
+ *  machine-consumed artifacts such as caches; JSON remains the format of
+ *  record for anything meant to be read or diffed by people.
+ *
+ * \param node The object to be serialized.
+ * \return the binary representation of the node.
+ */
+TVM_DLL std::string SaveBinary(const runtime::ObjectRef& node);
+
+/*!
+ * \brief Load a TVM object from the binary format produced by SaveBinary.
+ * \param blob The binary blob to load from.
+ *
+ * \return The loaded object.
+ */
+TVM_DLL runtime::ObjectRef LoadBinary(std::string blob);
+
 }  // namespace tvm
 #endif  // TVM_NODE_SERIALIZATION_H_
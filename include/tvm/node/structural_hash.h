@@ -82,6 +82,22 @@ class StructuralHash : public BaseValueHash {
    * \return The hash value.
    */
   TVM_DLL size_t operator()(const ObjectRef& key) const;
+  /*!
+   * \brief Compute the structural hash of an object, reusing a process-wide
+   *        cache of previously hashed objects.
+   *
+   *  The cache keeps a strong reference to every object it hashed, so an
+   *  address is never reused while its entry is alive. Only pass objects that
+   *  follow the IR convention of being structurally immutable once
+   *  constructed; mutable containers such as IRModule must use operator()
+   *  instead.
+   *
+   * \param key The object to hash.
+   * \return The hash value.
+   */
+  TVM_DLL static size_t Cached(const ObjectRef& key);
+  /*! \brief Drop all entries of the cache used by Cached(). */
+  TVM_DLL static void InvalidateCache();
 };
 
 /*!
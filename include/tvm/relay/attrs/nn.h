@@ -992,6 +992,16 @@ struct BatchMatmulAttrs : public tvm::AttrsNode<BatchMatmulAttrs> {
   }
 };
 
+/*! \brief Attributes for fused attention operator */
+struct AttentionAttrs : public tvm::AttrsNode<AttentionAttrs> {
+  double scale;
+
+  TVM_DECLARE_ATTRS(AttentionAttrs, "relay.attrs.AttentionAttrs") {
+    TVM_ATTR_FIELD(scale).set_default(1.0).describe(
+        "The scaling factor applied to the attention scores, typically 1/sqrt(d_k)");
+  }
+};
+
 /*! \brief Attributes for sparse_dense operator */
 struct SparseDenseAttrs : public tvm::AttrsNode<SparseDenseAttrs> {
   bool sparse_lhs;
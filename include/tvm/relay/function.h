@@ -147,6 +147,13 @@ constexpr const char* kPartitionedFromPattern = "PartitionedFromPattern";
 
 /*! \brief Mark the function as only composed of reshape operations. */
 constexpr const char* kReshapeOnly = "relay.reshape_only";
+
+/*!
+ * \brief Mark the function as only composed of elementwise operations.
+ * Such a function writes every output element from the same index of its
+ * inputs, so the memory planner may let the output share an input storage.
+ */
+constexpr const char* kElemwiseOnly = "relay.elemwise_only";
 }  // namespace attr
 
 }  // namespace relay
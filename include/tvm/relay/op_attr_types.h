@@ -179,6 +179,19 @@ using FTVMConvertOpLayout = runtime::TypedPackedFunc<Expr(
 using FTVMLegalize = runtime::TypedPackedFunc<Expr(const Attrs& attrs, const Array<Expr>& args,
                                                    const Array<tvm::relay::Type>& arg_types)>;
 
+/*!
+ * \brief Unpack a normalization operator into its inference-time chain of
+ *  primitive expressions. Invoked by the SimplifyInference pass; registering
+ *  this attribute is all a new normalization flavor needs for the pass (and
+ *  the scale folding that runs afterwards) to pick it up.
+ * \param attrs The attribute of the original node.
+ * \param args The input symbols of the original node.
+ * \param data_type The checked type of the data input.
+ * \return new_expr The unpacked expression.
+ */
+using FNormInferUnpack = runtime::TypedPackedFunc<Expr(
+    const Attrs& attrs, const Array<Expr>& args, const Type& data_type)>;
+
 /*!
  * \brief Annotates an expression to indicate if an op should be compiled using
  * the given compiler/target.
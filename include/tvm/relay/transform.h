@@ -54,12 +54,17 @@ using Sequential = tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param interested_ops Optional names of the only operators the pass can
+ *        rewrite. When non-empty, functions calling none of these operators
+ *        are passed through unchanged without invoking pass_func. Leave empty
+ *        for passes whose effect is not keyed on specific operators.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required,
+    tvm::Array<String> interested_ops = {});
 
 /*! \brief Remove expressions which does not effect the program result.
  *
@@ -91,6 +96,21 @@ TVM_DLL Pass DeadCodeElimination(bool inline_once = false);
  */
 TVM_DLL Pass LazyGradientInit();
 
+/*!
+ * \brief Automatically insert annotation.checkpoint boundaries for training.
+ *
+ * Accumulates the activation bytes produced along the dataflow and wraps an
+ * expensive op's output in a checkpoint once the running total exceeds
+ * \p max_segment_bytes, so the gradient pass re-executes the segment instead
+ * of retaining its intermediates. User-placed checkpoints are kept and reset
+ * the accumulation.
+ *
+ * \param max_segment_bytes Activation budget per recompute segment.
+ *
+ * \return the pass
+ */
+TVM_DLL Pass AutoCheckpoint(int64_t max_segment_bytes = 1 << 26);
+
 /*!
  * \brief Fold constant expressions.
  *
@@ -115,6 +135,16 @@ TVM_DLL Pass FuseOps(int fuse_opt_level = -1);
  */
 TVM_DLL Pass DefuseOps();
 
+/*!
+ * \brief Group independent small fused kernels into one batched dispatch.
+ *
+ * The pass is a no-op unless relay.BatchSmallOps.max_output_size is set to a
+ * positive number of elements in the pass context.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass BatchSmallOps();
+
 /*!
  * \brief Rewrite the annotated program.
  *
@@ -218,6 +248,21 @@ TVM_DLL Pass SimplifyInference();
  */
 TVM_DLL Pass FastMath();
 
+/*!
+ * \brief Automatically convert fp32 computation to a reduced-precision dtype.
+ *
+ * Compute-bound ops always convert (accumulating in fp32), elementwise ops
+ * follow the precision of their inputs, and numerically sensitive ops stay in
+ * fp32 islands with casts inserted around them. Function signatures are
+ * preserved. Per-op behavior can be overridden via the TMixedPrecisionPolicy
+ * op attribute or the relay.ToMixedPrecision.skip_ops pass config.
+ *
+ * \param mixed_dtype The reduced-precision data type, typically float16.
+ *
+ * \return The Pass.
+ */
+TVM_DLL Pass ToMixedPrecision(DataType mixed_dtype = DataType::Float(16));
+
 /*!
  * \brief Find Dynamic ops and make them static
  *
@@ -420,6 +465,14 @@ TVM_DLL Pass RemoveUnusedFunctions(Array<runtime::String> entry_functions);
  */
 TVM_DLL Pass SimplifyExpr();
 
+/*!
+ * \brief Rewrite the unfused attention idiom (batch_matmul -> scale -> softmax
+ * -> batch_matmul of the transposed values) to nn.fused_attention.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass FuseAttention();
+
 /*!
  * \brief A pass for manifesting explicit memory allocations and rewriting
  * specific dialects.
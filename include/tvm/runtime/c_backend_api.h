@@ -100,6 +100,27 @@ TVM_DLL void* TVMBackendAllocWorkspace(int device_type, int device_id, uint64_t
  */
 TVM_DLL int TVMBackendFreeWorkspace(int device_type, int device_id, void* ptr);
 
+/*!
+ * \brief Backend function marking the entry of a profiled stage.
+ *
+ *  Emitted by the tir.InstrumentProfileStages pass around loop nests that
+ *  carry a "profile_stage" pragma. The matching TVMBackendProfileStageEnd
+ *  call accumulates the elapsed time under \p name in the process-wide
+ *  stage profiler.
+ *
+ * \param name The stage name, a compile-time string literal.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileStageBegin(const char* name);
+
+/*!
+ * \brief Backend function marking the exit of a profiled stage.
+ *
+ * \param name The stage name passed to the matching TVMBackendProfileStageBegin.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileStageEnd(const char* name);
+
 /*!
  * \brief Backend function to register execution environment(e.g. python)
  *        specific C APIs.
@@ -123,6 +144,12 @@ typedef struct {
   void* sync_handle;
   /*! \brief total amount of task */
   int32_t num_task;
+  /*!
+   * \brief Shared cursor of dynamically scheduled loops, consumed through
+   *  TVMBackendParallelNextChunk. NULL when the launcher does not support
+   *  dynamic scheduling.
+   */
+  void* chunk_handle;
 } TVMParallelGroupEnv;
 
 /*!
@@ -153,6 +180,24 @@ TVM_DLL int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, in
  */
 TVM_DLL int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv);
 
+/*!
+ * \brief Claim the next chunk of a dynamically scheduled parallel loop.
+ *
+ *  All workers of one parallel launch share a chunk cursor. Each call hands
+ *  out half of the per-worker share of the remaining iterations (guided
+ *  scheduling), so chunks start large and shrink towards the tail; workers
+ *  that finish cheap iterations early keep pulling work instead of idling.
+ *  Only one dynamically scheduled loop may run per parallel launch.
+ *
+ * \param penv The parallel environment backs the execution.
+ * \param extent The total iteration extent of the loop.
+ * \param out_begin The begin of the claimed chunk.
+ * \param out_end The end of the claimed chunk.
+ * \return 1 when a chunk was claimed, 0 when the loop is drained.
+ */
+TVM_DLL int TVMBackendParallelNextChunk(TVMParallelGroupEnv* penv, int64_t extent,
+                                        int64_t* out_begin, int64_t* out_end);
+
 /*!
  * \brief Simple static initialization function.
  *  Run f once and set handle to be not null.
@@ -443,6 +443,19 @@ class ArrayNode : public Object, public InplaceArrayBase<ArrayNode, ObjectRef> {
     return p;
   }
 
+  /*!
+   * \brief A process-wide empty ArrayNode shared by all default-constructed
+   *  Arrays, so that constructing an empty Array costs no allocation.
+   *  The node is never unique (this function holds a reference), so any
+   *  mutation goes through the copy-on-write path and copies it first.
+   * \return Ref-counted ArrayNode
+   */
+  static ObjectPtr<ArrayNode> SharedEmpty() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    static ObjectPtr<ArrayNode>* inst = new ObjectPtr<ArrayNode>(Empty(0));
+    return *inst;
+  }
+
   /*!
    * \brief Inplace-initialize the elements starting idx from [first, last)
    * \param idx The starting point
@@ -571,7 +584,7 @@ class Array : public ObjectRef {
   /*!
    * \brief default constructor
    */
-  Array() { data_ = ArrayNode::Empty(); }
+  Array() { data_ = ArrayNode::SharedEmpty(); }
 
   /*!
    * \brief move constructor
@@ -847,9 +860,15 @@ class Array : public ObjectRef {
 
   /*! \brief Release reference to all the elements */
   void clear() {
-    if (data_ != nullptr) {
-      ArrayNode* p = CopyOnWrite();
+    ArrayNode* p = GetArrayNode();
+    if (p == nullptr || p->size_ == 0) {
+      return;
+    }
+    if (data_.unique()) {
       p->clear();
+    } else {
+      // no need to copy the elements just to destroy them
+      data_ = ArrayNode::SharedEmpty();
     }
   }
 
@@ -882,32 +901,25 @@ class Array : public ObjectRef {
     if (data_ == nullptr) {
       return;
     }
-    struct StackFrame {
-      ArrayNode* p;
-      ObjectRef* itr;
-      int64_t i;
-      int64_t size;
-    };
-    std::unique_ptr<StackFrame> s = std::make_unique<StackFrame>();
-    s->p = GetArrayNode();
-    s->itr = s->p->MutableBegin();
-    s->i = 0;
-    s->size = s->p->size_;
+    ArrayNode* p = GetArrayNode();
+    ObjectRef* itr = p->MutableBegin();
+    int64_t i = 0;
+    int64_t size = p->size_;
     if (!data_.unique()) {
       // Loop invariant: keeps iterating when
       // 1) data is not unique
       // 2) no elements are actually mutated yet
-      for (; s->i < s->size; ++s->i, ++s->itr) {
-        T new_elem = fmutate(DowncastNoCheck<T>(*s->itr));
+      for (; i < size; ++i, ++itr) {
+        T new_elem = fmutate(DowncastNoCheck<T>(*itr));
         // do nothing when there is no mutation
-        if (new_elem.same_as(*s->itr)) {
+        if (new_elem.same_as(*itr)) {
           continue;
         }
         // loop invariant breaks when the first real mutation happens
         // we copy the elements into a new unique array
-        ObjectPtr<ArrayNode> copy = ArrayNode::CopyFrom(s->p->capacity_, s->p);
-        s->itr = copy->MutableBegin() + (s->i++);
-        *s->itr++ = std::move(new_elem);
+        ObjectPtr<ArrayNode> copy = ArrayNode::CopyFrom(p->capacity_, p);
+        itr = copy->MutableBegin() + (i++);
+        *itr++ = std::move(new_elem);
         data_ = std::move(copy);
         // make sure `data_` is unique and break
         break;
@@ -916,8 +928,8 @@ class Array : public ObjectRef {
     // when execution comes to this line, it is guaranteed that either
     //    1) i == size
     // or 2) data_.unique() is true
-    for (; s->i < s->size; ++s->i, ++s->itr) {
-      *s->itr = std::move(fmutate(std::move(DowncastNoCheck<T>(std::move(*s->itr)))));
+    for (; i < size; ++i, ++itr) {
+      *itr = std::move(fmutate(std::move(DowncastNoCheck<T>(std::move(*itr)))));
     }
   }
 
@@ -984,7 +996,9 @@ class Array : public ObjectRef {
     if (p->capacity_ >= p->size_ + reserve_extra) {
       return CopyOnWrite();
     }
-    int64_t cap = p->capacity_ * ArrayNode::kIncFactor;
+    // necessary to get around the constexpr address issue before c++17
+    const int64_t kInitSize = ArrayNode::kInitSize;
+    int64_t cap = std::max(p->capacity_ * ArrayNode::kIncFactor, kInitSize);
     cap = std::max(cap, p->size_ + reserve_extra);
     return SwitchContainer(cap);
   }
@@ -1103,6 +1117,23 @@ class ADT : public ObjectRef {
    */
   ADT(int32_t tag, std::initializer_list<ObjectRef> init) : ADT(tag, init.begin(), init.end()){};
 
+  /*!
+   * \brief Construct an ADT object reference using a custom object allocator.
+   * \param allocator The allocator that creates the underlying object storage.
+   * \param tag The tag of the ADT object.
+   * \param begin The begin iterator to the start of the fields array.
+   * \param end The end iterator to the end of the fields array.
+   * \return The constructed ADT object reference.
+   */
+  template <typename Allocator, typename Iterator>
+  static ADT Allocate(Allocator* allocator, int32_t tag, Iterator begin, Iterator end) {
+    size_t num_elems = std::distance(begin, end);
+    auto ptr = allocator->template make_inplace_array<ADTObj, ObjectRef>(num_elems);
+    ptr->tag = tag;
+    ptr->Init(begin, end);
+    return ADT(std::move(ptr));
+  }
+
   /*!
    * \brief Access element at index.
    *
@@ -1230,6 +1261,9 @@ class String : public ObjectRef {
    * before other, positive otherwise.
    */
   int compare(const String& other) const {
+    // Strings interned through Intern (and copies of one reference) share a
+    // single object, so equality is decided without touching the bytes.
+    if (same_as(other)) return 0;
     return memncmp(data(), other.data(), size(), other.size());
   }
 
@@ -1331,6 +1365,20 @@ class String : public ObjectRef {
    */
   inline static bool CanConvertFrom(const TVMArgValue& val);
 
+  /*!
+   * \brief Return the canonical process-wide String for the given content.
+   *
+   * All calls with equal content return references to one StringObj for the
+   * lifetime of the process, so interned strings compare equal by pointer
+   * (see compare) and repeated keys cost no allocation. Intended for known
+   * hot key sets such as attribute, operator and option names; the table
+   * only grows, so do not intern unbounded user data.
+   *
+   * \param content The content to intern.
+   * \return The canonical String.
+   */
+  TVM_DLL static String Intern(const std::string& content);
+
   /*!
    * \brief Hash the binary bytes
    * \param data The data pointer
@@ -1778,6 +1826,16 @@ class MapNode : public Object {
    * \return The object created
    */
   static ObjectPtr<MapNode> Empty() { return make_object<MapNode>(); }
+  /*!
+   * \brief A process-wide empty container shared by all default-constructed
+   *  Maps. The node is never unique, so any mutation copies it first.
+   * \return The object
+   */
+  static ObjectPtr<MapNode> SharedEmpty() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state
+    static ObjectPtr<MapNode>* inst = new ObjectPtr<MapNode>(Empty());
+    return *inst;
+  }
 
  protected:
   /*!
@@ -1935,6 +1993,12 @@ class MapNode : public Object {
    * \return The object created
    */
   static inline ObjectPtr<MapNode> Empty();
+  /*!
+   * \brief A process-wide empty container shared by all default-constructed
+   *  Maps. The node is never unique, so any mutation copies it first.
+   * \return The object
+   */
+  static inline ObjectPtr<MapNode> SharedEmpty();
 
  protected:
   /*!
@@ -1971,7 +2035,10 @@ class MapNode : public Object {
 class SmallMapNode : public MapNode,
                      public runtime::InplaceArrayBase<SmallMapNode, MapNode::KVType> {
  private:
-  static constexpr uint64_t kInitSize = 2;
+  // Starting at the maximum capacity means a small map never re-allocates
+  // while it grows; typical attribute maps hold only a handful of entries
+  // and the slack is at most 3 KV slots.
+  static constexpr uint64_t kInitSize = 4;
   static constexpr uint64_t kMaxSize = 4;
 
  public:
@@ -2086,7 +2153,9 @@ class SmallMapNode : public MapNode,
   static ObjectPtr<SmallMapNode> CopyFrom(SmallMapNode* from) {
     KVType* first = static_cast<KVType*>(from->AddressOf(0));
     KVType* last = first + from->size_;
-    return CreateFromRange(from->size_, first, last);
+    // keep the slack of the source, so that the common copy-then-insert
+    // pattern of copy-on-write does not immediately re-allocate
+    return CreateFromRange(from->slots_, first, last);
   }
   /*!
    * \brief InsertMaybeReHash an entry into the given hash map
@@ -2825,6 +2894,14 @@ inline void MapNode::erase(const MapNode::iterator& position) {
 
 inline ObjectPtr<MapNode> MapNode::Empty() { return SmallMapNode::Empty(); }
 
+inline ObjectPtr<MapNode> MapNode::SharedEmpty() {
+  // The shared node is created with zero slots so that an insert through a
+  // stale unique handle still re-allocates instead of writing in place.
+  // NOTE: explicitly use new to avoid exit-time destruction of global state
+  static ObjectPtr<MapNode>* inst = new ObjectPtr<MapNode>(SmallMapNode::Empty(0));
+  return *inst;
+}
+
 inline ObjectPtr<MapNode> MapNode::CopyFrom(MapNode* from) {
   if (from->slots_ <= SmallMapNode::kMaxSize) {
     return SmallMapNode::CopyFrom(static_cast<SmallMapNode*>(from));
@@ -2897,7 +2974,7 @@ class Map : public ObjectRef {
   /*!
    * \brief default constructor
    */
-  Map() { data_ = MapNode::Empty(); }
+  Map() { data_ = MapNode::SharedEmpty(); }
   /*!
    * \brief move constructor
    * \param other source
@@ -2983,8 +3060,8 @@ class Map : public ObjectRef {
   /*! \brief Release reference to all the elements */
   void clear() {
     MapNode* n = GetMapNode();
-    if (n != nullptr) {
-      data_ = MapNode::Empty();
+    if (n != nullptr && n->size() != 0) {
+      data_ = MapNode::SharedEmpty();
     }
   }
   /*!
@@ -2993,7 +3070,14 @@ class Map : public ObjectRef {
    * \param value The value to be setted.
    */
   void Set(const K& key, const V& value) {
-    CopyOnWrite();
+    MapNode* n = GetMapNode();
+    if (n == nullptr || (n->size() == 0 && !data_.unique())) {
+      // inserting into a shared (or absent) empty map: start from a fresh
+      // node directly instead of copying an empty container first
+      data_ = MapNode::Empty();
+    } else {
+      CopyOnWrite();
+    }
     MapNode::InsertMaybeReHash(MapNode::KVType(key, value), &data_);
   }
   /*! \return begin iterator */
@@ -46,6 +46,9 @@ typedef struct TVMOpParam {
 typedef struct TVMGraphExecutorGraphAttr {
   uint32_t storage_num_not_alloctaed;
   uint32_t* storage_id;
+  // Optional static memory plan: byte offset of each entry's storage inside
+  // one contiguous pool. NULL when the graph carries no "storage_offset" attribute.
+  uint32_t* storage_offset;
   uint32_t* device_index;
   char* dltype;  // "int8", "int16", "float32"
   uint32_t dltype_count;
@@ -75,6 +75,20 @@ struct MemoryManagerInterface {
 tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
                                         size_t memory_pool_size_bytes, size_t page_size_bytes_log2);
 
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+/*!
+ * \brief Retrieve the high-water mark of pages handed out by the allocator.
+ *
+ * Used to right-size the memory pool on constrained targets. Only available
+ * when TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS is defined in crt_config.h.
+ *
+ * \param interface Interface returned from PageMemoryManagerCreate.
+ * \param peak_bytes Pointer which receives the peak allocation, in bytes.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t PageMemoryManagerPeakBytes(MemoryManagerInterface* interface, size_t* peak_bytes);
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -129,6 +129,15 @@ class TVM_DLL DeviceAPI {
    */
   virtual TVMStreamHandle CreateStream(Device dev);
 
+  /*!
+   * \brief Create a new stream of execution with the given priority.
+   *
+   * \param dev The device of allocation.
+   * \param priority The stream priority, lower numbers mean higher priority.
+   *        Devices without priority support ignore the value.
+   */
+  virtual TVMStreamHandle CreateStream(Device dev, int priority);
+
   /*!
    * \brief Free a stream of execution
    *
@@ -32,6 +32,7 @@
 #include <dmlc/common.h>
 #include <tvm/runtime/c_runtime_api.h>
 
+#include <atomic>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
@@ -61,6 +62,21 @@
 #define TVM_ALWAYS_INLINE inline __attribute__((always_inline))
 #endif
 
+/*!
+ * \brief Macro helpers to annotate the expected truth value of a branch.
+ *
+ *  Used on the conditions of the check macros so the compiler lays out
+ *  the failure arm out of line, keeping the hot path free of the error
+ *  handling code.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_LIKELY(x) __builtin_expect(!!(x), 1)
+#define TVM_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define TVM_LIKELY(x) (x)
+#define TVM_UNLIKELY(x) (x)
+#endif
+
 /*!
  * \brief Macro helper for exception throwing.
  */
@@ -94,6 +110,21 @@
 #define TVM_LOG_CUSTOMIZE 0
 #endif
 
+/*!
+ * \brief Whether to compile the internal-invariant checks (ICHECK family)
+ *  down to raw branch-hinted conditionals.
+ *
+ *  When enabled, a passing ICHECK costs a single predicted-not-taken
+ *  branch and a failing one calls a cold out-of-line function; the
+ *  streamed message operands are discarded instead of being formatted.
+ *  Intended for release runtime-only builds where the check/log
+ *  machinery is measurable in tight interpreter loops. User-facing
+ *  CHECK macros keep their full error messages.
+ */
+#ifndef TVM_MINIMAL_RUNTIME_CHECKS
+#define TVM_MINIMAL_RUNTIME_CHECKS 0
+#endif
+
 // a technique that enables overriding macro names on the number of parameters. This is used
 // to define other macros below
 #define GET_MACRO(_1, _2, _3, _4, _5, NAME, ...) NAME
@@ -431,7 +462,7 @@ std::unique_ptr<std::string> LogCheckFormat(const X& x, const Y& y) {
 #define TVM_CHECK_FUNC(name, op)                                                          \
   template <typename X, typename Y>                                                       \
   TVM_ALWAYS_INLINE std::unique_ptr<std::string> LogCheck##name(const X& x, const Y& y) { \
-    if (x op y) return nullptr;                                                           \
+    if (TVM_LIKELY(x op y)) return nullptr;                                               \
     return LogCheckFormat(x, y);                                                          \
   }                                                                                       \
   TVM_ALWAYS_INLINE std::unique_ptr<std::string> LogCheck##name(int x, int y) {           \
@@ -447,6 +478,52 @@ TVM_CHECK_FUNC(_GE, >=)
 TVM_CHECK_FUNC(_EQ, ==)
 TVM_CHECK_FUNC(_NE, !=)
 #pragma GCC diagnostic pop
+
+/*!
+ * \brief Raise an InternalError for a failed internal check without any
+ *  ostream machinery at the call site.
+ * \param file The file where the check failed.
+ * \param lineno The line number where the check failed.
+ * \param expr The text of the failed expression.
+ * \sa TVM_MINIMAL_RUNTIME_CHECKS
+ */
+[[noreturn]] TVM_DLL void MinimalCheckFailed(const char* file, int lineno, const char* expr);
+
+/*!
+ * \brief Sink for a failed check under TVM_MINIMAL_RUNTIME_CHECKS.
+ *
+ *  Swallows the streamed message operands and raises from the
+ *  destructor, so the call site only contains the conditional branch
+ *  and one cold call.
+ */
+class MinimalCheckFatal {
+ public:
+  MinimalCheckFatal(const char* file, int lineno, const char* expr)
+      : file_(file), lineno_(lineno), expr_(expr) {}
+  ~MinimalCheckFatal() TVM_THROW_EXCEPTION { MinimalCheckFailed(file_, lineno_, expr_); }
+  // Takes the discarded operand by value: binding a reference would
+  // odr-use constexpr statics (e.g. _type_key) that have no out-of-class
+  // definition before C++17.
+  template <typename T>
+  MinimalCheckFatal& operator<<(T) {
+    return *this;
+  }
+
+ private:
+  const char* file_;
+  int lineno_;
+  const char* expr_;
+};
+
+/*!
+ * \brief Count a visit to a sampled log site and decide whether to log.
+ * \param counter The per-site occurrence counter.
+ * \param n The sampling period.
+ * \return Whether this occurrence should be logged.
+ */
+TVM_ALWAYS_INLINE bool LogEveryNEnabled(std::atomic<int64_t>* counter, int64_t n) {
+  return counter->fetch_add(1, std::memory_order_relaxed) % n == 0;
+}
 }  // namespace detail
 
 #define LOG(level) LOG_##level
@@ -461,7 +538,7 @@ TVM_CHECK_FUNC(_NE, !=)
       << "Check failed: " << #x " " #op " " #y << *__tvm__log__err << ": "
 
 #define CHECK(x)                                                \
-  if (!(x))                                                     \
+  if (TVM_UNLIKELY(!(x)))                                       \
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream() \
       << "Check failed: (" #x << ") is false: "
 
@@ -479,6 +556,22 @@ TVM_CHECK_FUNC(_NE, !=)
 #define LOG_IF(severity, condition) \
   !(condition) ? (void)0 : ::tvm::runtime::detail::LogMessageVoidify() & LOG(severity)
 
+#define TVM_LOG_EVERY_N_CONCAT_(a, b) a##b
+#define TVM_LOG_EVERY_N_COUNTER_(line) TVM_LOG_EVERY_N_CONCAT_(__tvm_log_every_n_, line)
+
+/*!
+ * \brief Log only every n-th occurrence of a site, for messages on paths
+ *  hot enough that unconditional logging is measurable in production.
+ *
+ * \note Expands to more than one statement; wrap in braces when used as
+ *  the body of an unbraced if/for.
+ */
+#define LOG_EVERY_N(severity, n)                                     \
+  static std::atomic<int64_t> TVM_LOG_EVERY_N_COUNTER_(__LINE__)(0); \
+  LOG_IF(severity, ::tvm::runtime::detail::LogEveryNEnabled(         \
+                       &TVM_LOG_EVERY_N_COUNTER_(__LINE__), (n)))    \
+      << "[sampled 1/" << (n) << "] "
+
 #if TVM_LOG_DEBUG
 
 #define LOG_DFATAL LOG_FATAL
@@ -524,6 +617,27 @@ TVM_CHECK_FUNC(_NE, !=)
 
 #define TVM_ICHECK_INDENT "  "
 
+#if TVM_MINIMAL_RUNTIME_CHECKS
+
+// A passing check is a single predicted-not-taken branch; on failure a
+// cold out-of-line function raises InternalError with the expression
+// text only. Streamed message operands are swallowed unformatted.
+#define ICHECK(x) \
+  if (TVM_UNLIKELY(!(x))) ::tvm::runtime::detail::MinimalCheckFatal(__FILE__, __LINE__, #x)
+
+#define ICHECK_LT(x, y) ICHECK((x) < (y))
+#define ICHECK_GT(x, y) ICHECK((x) > (y))
+#define ICHECK_LE(x, y) ICHECK((x) <= (y))
+#define ICHECK_GE(x, y) ICHECK((x) >= (y))
+#define ICHECK_EQ(x, y) ICHECK((x) == (y))
+#define ICHECK_NE(x, y) ICHECK((x) != (y))
+#define ICHECK_NOTNULL(x)                                                                        \
+  ((x) == nullptr                                                                                \
+       ? (::tvm::runtime::detail::MinimalCheckFailed(__FILE__, __LINE__, #x " != nullptr"), (x)) \
+       : (x))  // NOLINT(*)
+
+#else
+
 #define ICHECK_BINARY_OP(name, op, x, y)                                   \
   if (auto __tvm__log__err = ::tvm::runtime::detail::LogCheck##name(x, y)) \
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream()            \
@@ -531,7 +645,7 @@ TVM_CHECK_FUNC(_NE, !=)
       << TVM_ICHECK_INDENT << "Check failed: " << #x " " #op " " #y << *__tvm__log__err << ": "
 
 #define ICHECK(x)                                                                 \
-  if (!(x))                                                                       \
+  if (TVM_UNLIKELY(!(x)))                                                         \
   ::tvm::runtime::detail::LogFatal(__FILE__, __LINE__).stream()                   \
       << ::tvm::runtime::detail::kTVM_INTERNAL_ERROR_MESSAGE << TVM_ICHECK_INDENT \
       << "Check failed: (" #x << ") is false: "
@@ -548,6 +662,8 @@ TVM_CHECK_FUNC(_NE, !=)
                         << TVM_ICHECK_INDENT << "Check not null: " #x << ' ',     \
    (x) : (x))  // NOLINT(*)
 
+#endif  // TVM_MINIMAL_RUNTIME_CHECKS
+
 }  // namespace runtime
 // Re-export error types
 using runtime::Error;
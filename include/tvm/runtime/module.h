@@ -201,6 +201,12 @@ class TVM_DLL ModuleNode : public Object {
  private:
   /*! \brief Cache used by GetImport */
   std::unordered_map<std::string, std::shared_ptr<PackedFunc> > import_cache_;
+  /*!
+   * \brief Flattened view of the import tree (DFS order, deduplicated),
+   *  built lazily by GetFuncFromEnv so misses walk each module once instead
+   *  of re-traversing shared subtrees. Cleared when a new import is added.
+   */
+  std::vector<Module> import_lookup_;
 };
 
 /*!
@@ -230,6 +236,10 @@ constexpr const char* tvm_module_main = "__tvm_main__";
 constexpr const char* tvm_param_prefix = "__tvm_param__";
 /*! \brief A PackedFunc that looks up linked parameters by storage_id. */
 constexpr const char* tvm_lookup_linked_param = "_lookup_linked_param";
+/*! \brief A PackedFunc that resolves a function name to its raw backend packed C symbol. */
+constexpr const char* tvm_lookup_packed_cfunc = "__tvm_lookup_packed_cfunc";
+/*! \brief A PackedFunc(device_id) that eagerly performs a module's lazy device setup. */
+constexpr const char* tvm_module_warm_up = "__tvm_module_warm_up";
 /*! \brief The main AOT executor function */
 constexpr const char* tvm_run_func_prefix = "tvm__run_func";
 }  // namespace symbol
@@ -234,12 +234,51 @@ class NDArray::ContainerBase {
    */
   void* manager_ctx{nullptr};
 
+  /*! \brief Number of dimensions stored inline without a heap allocation. */
+  static constexpr int kInlineShapeDims = 6;
+
  protected:
+  /*!
+   * \brief Install the shape, keeping small ranks in the inline buffer.
+   * \param shape The shape data.
+   */
+  void SetShape(std::vector<int64_t> shape) {
+    dl_tensor.ndim = static_cast<int>(shape.size());
+    if (dl_tensor.ndim <= kInlineShapeDims) {
+      for (int i = 0; i < dl_tensor.ndim; ++i) {
+        inline_shape_[i] = shape[i];
+      }
+      dl_tensor.shape = inline_shape_;
+    } else {
+      shape_ = std::move(shape);
+      dl_tensor.shape = dmlc::BeginPtr(shape_);
+    }
+  }
+  /*!
+   * \brief Install the shape from a raw array, keeping small ranks inline.
+   * \param shape The shape data.
+   * \param ndim The number of dimensions.
+   */
+  void SetShape(const int64_t* shape, int ndim) {
+    dl_tensor.ndim = ndim;
+    if (ndim <= kInlineShapeDims) {
+      for (int i = 0; i < ndim; ++i) {
+        inline_shape_[i] = shape[i];
+      }
+      dl_tensor.shape = inline_shape_;
+    } else {
+      shape_.assign(shape, shape + ndim);
+      dl_tensor.shape = dmlc::BeginPtr(shape_);
+    }
+  }
   /*!
    * \brief The shape container,
    *  can be used used for shape data.
+   *  Only used when the rank exceeds kInlineShapeDims.
    */
   std::vector<int64_t> shape_;
+  /*! \brief Inline storage for small-rank shapes. */
+  int64_t inline_shape_[kInlineShapeDims];
 };
 
 /*!
@@ -263,9 +302,7 @@ class NDArray::Container : public Object, public NDArray::ContainerBase {
     // Initialize the type index.
     type_index_ = Container::RuntimeTypeIndex();
     dl_tensor.data = data;
-    shape_ = std::move(shape);
-    dl_tensor.ndim = static_cast<int>(shape_.size());
-    dl_tensor.shape = dmlc::BeginPtr(shape_);
+    SetShape(std::move(shape));
     dl_tensor.dtype = dtype;
     dl_tensor.strides = nullptr;
     dl_tensor.byte_offset = 0;
@@ -276,6 +313,22 @@ class NDArray::Container : public Object, public NDArray::ContainerBase {
    * \param deleter The deleter.
    */
   void SetDeleter(FDeleter deleter) { deleter_ = deleter; }
+  /*!
+   * \brief Allocate storage for a container, reusing a recycled block when one
+   *  is available. Containers are created and dropped at a high rate by the
+   *  executors, so their fixed-size headers are kept in a thread-local free
+   *  list instead of hitting the heap allocator each time.
+   * \param nbytes The allocation size.
+   * \return The allocated block.
+   */
+  TVM_DLL static void* operator new(size_t nbytes);
+  /*!
+   * \brief Return a container block to the free list, or to the heap when the
+   *  list is full or the size does not match.
+   * \param ptr The block to release.
+   * \param nbytes The allocation size.
+   */
+  TVM_DLL static void operator delete(void* ptr, size_t nbytes);
 
   // Expose DecRef and IncRef as public function
   // NOTE: they are only for developer purposes only.
@@ -297,6 +297,18 @@ class TVM_DLL Object {
    * \note The deleter will be called when ref_counter_ becomes zero.
    */
   inline void DecRef();
+  /*!
+   * \brief Invoke the deleter of an object whose reference count reached zero.
+   *
+   *  Destroying the last reference to a deep object graph (e.g. the Let
+   *  chain of a large IRModule) would otherwise recurse through one deleter
+   *  frame per node and can overflow the stack. Releases that happen inside
+   *  another deleter are pushed to a per-thread worklist that the outermost
+   *  release drains iteratively, so the destructor stack depth stays bounded
+   *  regardless of the shape of the graph.
+   * \param self The object to be destroyed; its deleter must not be nullptr.
+   */
+  static void DeferredDelete(Object* self);
 
  private:
   /*!
@@ -793,7 +805,7 @@ inline void Object::DecRef() {
   if (ref_counter_.fetch_sub(1, std::memory_order_release) == 1) {
     std::atomic_thread_fence(std::memory_order_acquire);
     if (this->deleter_ != nullptr) {
-      (*this->deleter_)(this);
+      Object::DeferredDelete(this);
     }
   }
 }
@@ -807,7 +819,7 @@ inline void Object::IncRef() { ++ref_counter_; }
 inline void Object::DecRef() {
   if (--ref_counter_ == 0) {
     if (this->deleter_ != nullptr) {
-      (*this->deleter_)(this);
+      Object::DeferredDelete(this);
     }
   }
 }
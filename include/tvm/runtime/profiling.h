@@ -30,6 +30,7 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <mutex>
 #include <stack>
 #include <string>
 #include <unordered_map>
@@ -278,6 +279,118 @@ class Profiler {
   std::stack<CallFrame> in_flight_;
 };
 
+/*! \brief A single span recorded by EventRecorder. */
+struct EventRecord {
+  /*! \brief Index into the recorder's span name table. */
+  int span;
+  /*! \brief Begin timestamp in nanoseconds on the recorder's clock. */
+  int64_t begin_ns;
+  /*! \brief End timestamp in nanoseconds on the recorder's clock. */
+  int64_t end_ns;
+  /*! \brief The device the span ran on. */
+  Device dev;
+};
+
+/*!
+ * \brief Always-on, low overhead per-op event recorder.
+ *
+ * Executors record one begin/end pair per op into a fixed size ring buffer.
+ * A record costs two clock reads and one slot write, so recording can stay
+ * enabled in production; when the ring is full the oldest records are
+ * overwritten. Recording is off unless TVM_PROFILE_EVENTS is set (ring size
+ * is TVM_PROFILE_EVENTS_RING, default 65536 records) and costs a single
+ * branch per run when disabled.
+ *
+ * Timestamps are host side: for asynchronous devices a span covers the
+ * kernel launch plus whatever synchronization the op itself performs. Use
+ * the debug executor's Profile() when device-accurate per-op times are
+ * needed; this recorder is for watching production behavior over time.
+ */
+class TVM_DLL EventRecorder {
+ public:
+  /*! \brief The process-wide recorder. */
+  static EventRecorder* Global();
+  /*! \return The current timestamp on the recorder's clock in nanoseconds. */
+  static int64_t Now();
+  /*! \return Whether recording is enabled. */
+  bool enabled() const { return capacity_ != 0; }
+  /*!
+   * \brief Register a span name once; records refer to it by index.
+   * \param name The name of the span, e.g. the op's function name.
+   * \return The span index to pass to Record.
+   */
+  int RegisterSpan(const std::string& name);
+  /*!
+   * \brief Record one completed span. No-op when recording is disabled.
+   * \param span The span index from RegisterSpan.
+   * \param begin_ns The begin timestamp from Now().
+   * \param end_ns The end timestamp from Now().
+   * \param dev The device the span ran on.
+   */
+  void Record(int span, int64_t begin_ns, int64_t end_ns, Device dev);
+  /*! \brief Aggregate the buffered records per span into a Report. */
+  Report Summary() const;
+  /*!
+   * \brief Export the buffered records as Chrome trace JSON.
+   *
+   * The result loads into chrome://tracing or Perfetto, which render the
+   * spans as a per-device flame graph over time.
+   */
+  std::string AsChromeTrace() const;
+  /*! \brief Drop all buffered records. */
+  void Clear();
+
+ private:
+  EventRecorder();
+  mutable std::mutex mutex_;
+  /*! \brief Names of registered spans. */
+  std::vector<std::string> span_names_;
+  /*! \brief The ring buffer of records. */
+  std::vector<EventRecord> ring_;
+  /*! \brief Ring capacity; zero when recording is disabled. */
+  size_t capacity_{0};
+  /*! \brief Total records ever written; the next slot is next_ % capacity_. */
+  uint64_t next_{0};
+};
+
+/*!
+ * \brief Aggregation buffer for stage counters injected into generated code.
+ *
+ * The tir.InstrumentProfileStages pass wraps pragma-marked loop nests with
+ * calls to TVMBackendProfileStageBegin/End, which accumulate wall time and a
+ * hit count per stage name here. Unlike EventRecorder this keeps no per-event
+ * history: one total per stage, so it attributes time within a fused kernel
+ * without unbounded memory.
+ *
+ * Begin/End pairs nest structurally (they wrap loop nests), so per-thread
+ * begin timestamps live on a stack; only the accumulation takes the lock.
+ */
+class TVM_DLL StageProfiler {
+ public:
+  /*! \brief The process-wide stage profiler. */
+  static StageProfiler* Global();
+  /*!
+   * \brief Enter a stage: push a begin timestamp for the calling thread.
+   * \param name The stage name from the profile_stage pragma.
+   */
+  void Begin(const char* name);
+  /*!
+   * \brief Leave a stage: accumulate the elapsed time under its name.
+   * \param name The stage name; must match the innermost open Begin.
+   */
+  void End(const char* name);
+  /*! \brief Aggregate the per-stage totals into a Report. */
+  Report Summary() const;
+  /*! \brief Reset all stage totals. */
+  void Clear();
+
+ private:
+  StageProfiler() = default;
+  mutable std::mutex mutex_;
+  /*! \brief Accumulated nanoseconds and hit count per stage name. */
+  std::unordered_map<std::string, std::pair<int64_t, int64_t>> totals_;
+};
+
 /* \brief A duration in time. */
 class DurationNode : public Object {
  public:
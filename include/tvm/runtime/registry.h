@@ -45,6 +45,7 @@
 
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -301,6 +302,9 @@ class Registry {
    * \param name The name of the function.
    * \return pointer to the registered function,
    *   nullptr if it does not exist.
+   * \note The registry never frees registered entries, so the returned
+   *   handle stays valid for the lifetime of the process and can be cached;
+   *   see GlobalFuncHandle for a ready-made cache.
    */
   TVM_DLL static const PackedFunc* Get(const std::string& name);  // NOLINT(*)
   /*!
@@ -320,6 +324,50 @@ class Registry {
   friend struct Manager;
 };
 
+/*!
+ * \brief A handle to a global function that caches the registry lookup.
+ *
+ *  The name is resolved through Registry::Get on first use and the handle is
+ *  memoized, so repeated calls on hot paths cost a single atomic pointer
+ *  load. Typical usage is a static at the call site:
+ *
+ * \code
+ *   static GlobalFuncHandle fhandle("runtime.MyFunc");
+ *   if (const PackedFunc* f = fhandle.Get()) {
+ *     (*f)(args...);
+ *   }
+ * \endcode
+ *
+ * \note The handle does not observe a later Registry::Remove or re-Register
+ *   of the same name; use Registry::Get directly when that matters.
+ */
+class GlobalFuncHandle {
+ public:
+  /*!
+   * \brief Construct a handle for the given global function name.
+   * \param name The name of the function.
+   */
+  explicit GlobalFuncHandle(std::string name) : name_(std::move(name)) {}
+  /*!
+   * \brief Resolve the handle.
+   * \return pointer to the registered function, nullptr if it does not exist.
+   */
+  const PackedFunc* Get() {
+    const PackedFunc* f = func_.load(std::memory_order_acquire);
+    if (f == nullptr) {
+      f = Registry::Get(name_);
+      func_.store(f, std::memory_order_release);
+    }
+    return f;
+  }
+
+ private:
+  /*! \brief name of the function */
+  std::string name_;
+  /*! \brief cached handle, resolved on first use */
+  std::atomic<const PackedFunc*> func_{nullptr};
+};
+
 #define TVM_FUNC_REG_VAR_DEF static TVM_ATTRIBUTE_UNUSED ::tvm::runtime::Registry& __mk_##TVM
 
 /*!
@@ -64,12 +64,19 @@ class ThreadGroup {
   enum AffinityMode : int {
     kBig = 1,
     kLittle = -1,
+    /*!
+     * \brief Restrict the workers to the cores of a single NUMA node.
+     *  The node is selected by the TVM_NUMA_NODE environment variable
+     *  (default node 0). Worker stacks and arenas become node-local via
+     *  first touch under the binding.
+     */
+    kNuma = 2,
   };
 
   /*!
    * \brief configure the CPU id affinity
    *
-   * \param mode The preferred CPU type (1 = big, -1 = little).
+   * \param mode The preferred CPU type (1 = big, -1 = little, 2 = one NUMA node).
    * \param nthreads The number of threads to use (0 = use all).
    * \param exclude_worker0 Whether to use the main thread as a worker.
    *        If  `true`, worker0 will not be launched in a new thread and
@@ -68,6 +68,7 @@ enum class Opcode {
   ShapeOf = 17U,
   ReshapeTensor = 18U,
   DeviceCopy = 19U,
+  AffineShape = 20U,
 };
 
 /*! \brief A single virtual machine instruction.
@@ -215,6 +216,24 @@ struct Instruction {
       /*! \brief The destination device type. */
       Index dst_device_type;
     };
+    struct /* AffineShape Operands */ {
+      /*! \brief The number of output shape elements. */
+      Index ndim;
+      /*! \brief The number of input shape tensors. */
+      Index num_inputs;
+      /*! \brief The register holding the output shape tensor to fill in. */
+      RegName out;
+      /*! \brief The registers holding the input shape tensors. */
+      RegName* shape_inputs;
+      /*! \brief Per element: the input tensor the element reads, or -1 for a constant. */
+      int64_t* src_input;
+      /*! \brief Per element: the index read out of the chosen input tensor. */
+      int64_t* src_elem;
+      /*! \brief Per element: the multiplier applied to the source element. */
+      int64_t* coeff;
+      /*! \brief Per element: the additive constant. */
+      int64_t* bias;
+    } affine_shape;
   };
 
   /*!
@@ -383,6 +402,27 @@ struct Instruction {
    */
   static Instruction DeviceCopy(RegName src, Index src_device_type, Index dst_device_type,
                                 RegName dst);
+  /*!
+   * \brief Evaluate a closed-form shape function inline.
+   *
+   * Writes `coeff[i] * shape_inputs[src_input[i]][src_elem[i]] + bias[i]` (or
+   * just `bias[i]` when `src_input[i]` is -1) into element i of the output
+   * shape tensor, replacing a packed-func call for shape functions that reduce
+   * to affine expressions over the input shape elements.
+   * \param ndim The number of output shape elements.
+   * \param shape_inputs The registers holding the input shape tensors.
+   * \param src_input Per element, the input tensor read, or -1 for a constant.
+   * \param src_elem Per element, the index read out of the chosen input tensor.
+   * \param coeff Per element, the multiplier applied to the source element.
+   * \param bias Per element, the additive constant.
+   * \param out The register holding the output shape tensor to fill in.
+   * \return The affine shape instruction.
+   */
+  static Instruction AffineShape(Index ndim, const std::vector<RegName>& shape_inputs,
+                                 const std::vector<int64_t>& src_input,
+                                 const std::vector<int64_t>& src_elem,
+                                 const std::vector<int64_t>& coeff,
+                                 const std::vector<int64_t>& bias, RegName out);
 
   Instruction();
   Instruction(const Instruction& instr);
@@ -31,12 +31,17 @@
 #include <tvm/runtime/vm/bytecode.h>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace tvm {
 namespace runtime {
+
+class MmapFile;
+
 namespace vm {
 
 struct VMFunction;
@@ -96,6 +101,21 @@ class Executable : public ModuleNode {
    */
   static runtime::Module Load(const std::string& code, const runtime::Module lib);
 
+  /*!
+   * \brief Load a saved VM executable by memory mapping the file.
+   *
+   * The constants alias the (read-only) mapping instead of being copied, so
+   * loading a large executable is bounded by page faults on the constants
+   * actually touched, and concurrent processes share one page cache copy.
+   * Falls back to an in-memory load when mmap is unavailable.
+   *
+   * \param path The path of the file written by `SaveToFile`.
+   * \param lib The compiled runtime library.
+   *
+   * \return exe The constructed executable.
+   */
+  static runtime::Module LoadFromFileMmap(const std::string& path, const runtime::Module lib);
+
   /*!
    * \brief Get the serialized form of the `functions`. This is
    * essentially bytecode serialization.
@@ -171,6 +191,27 @@ class Executable : public ModuleNode {
    */
   std::string GetFunctionParameterName(std::string func, uint32_t index) const;
 
+  /*!
+   * \brief Ensure the instructions of the function at `index` are decoded.
+   *
+   * Executables created by `Load` or `LoadFromFileMmap` keep only the byte
+   * window of each function's bytecode and decode it on first use, so loading
+   * a multi-entry executable does not pay for functions an entry point never
+   * reaches. Executables assembled in memory by the compiler are always
+   * materialized and this is a no-op.
+   *
+   * \param index The index into `functions`.
+   * \return The materialized function.
+   */
+  const VMFunction& EnsureFunction(Index index) const;
+
+  /*!
+   * \brief Materialize the function at `entry_index` together with every
+   * function it can reach through Invoke and AllocClosure instructions.
+   * \param entry_index The index of the entry function in `functions`.
+   */
+  void EnsureReachableFunctions(Index entry_index) const;
+
   virtual ~Executable() {}
 
   const char* type_key() const final { return "VMExecutable"; }
@@ -185,8 +226,11 @@ class Executable : public ModuleNode {
   std::unordered_map<std::string, Index> primitive_map;
   /*! \brief The structural hashes of the operators in this function. */
   std::map<Index, Map<String, ObjectRef>> op_attrs;
-  /*! \brief The virtual machine's function table. */
-  std::vector<VMFunction> functions;
+  /*!
+   * \brief The virtual machine's function table. For loaded executables the
+   * instructions of an entry may be decoded lazily; see `EnsureFunction`.
+   */
+  mutable std::vector<VMFunction> functions;
   /*! \brief The device type for each constant. */
   std::vector<Index> const_device_type;
 
@@ -229,9 +273,13 @@ class Executable : public ModuleNode {
   /*!
    * \brief Load the constant pool.
    *
-   * \param strm The input stream.
+   * \param strm The input stream, positioned inside the serialized blob.
+   * \param mmap_base Start of the blob when it lives in a memory mapped
+   * file, in which case aligned constant payloads alias the mapping.
+   * \param mmap The mapping keeping `mmap_base` alive.
    */
-  void LoadConstantSection(dmlc::Stream* strm);
+  void LoadConstantSection(dmlc::SeekStream* strm, char* mmap_base = nullptr,
+                           std::shared_ptr<MmapFile> mmap = nullptr);
 
   /*!
    * \brief Load primitive op names.
@@ -243,9 +291,37 @@ class Executable : public ModuleNode {
   /*!
    * \brief Load the vm functions.
    *
-   * \param strm The input stream.
+   * Only the per-function headers are decoded; each function's instructions
+   * are recorded as a byte window of the loaded blob and deserialized by
+   * `EnsureFunction` on first use.
+   *
+   * \param strm The input stream, positioned inside the serialized blob.
+   */
+  void LoadCodeSection(dmlc::SeekStream* strm);
+
+  /*! \brief The byte window of a function's not-yet-decoded bytecode. */
+  struct LazyFunction {
+    /*! \brief Offset of the first serialized instruction in the blob. */
+    size_t begin{0};
+    /*! \brief The number of serialized instructions. */
+    size_t num_instructions{0};
+    /*! \brief Whether the instructions have been decoded into `functions`. */
+    bool loaded{false};
+  };
+
+  /*!
+   * \brief Lazy state per function, indexed like `functions`. Empty when the
+   * executable was assembled in memory by the compiler.
    */
-  void LoadCodeSection(dmlc::Stream* strm);
+  mutable std::vector<LazyFunction> lazy_functions_;
+  /*! \brief Start of the serialized blob the lazy byte windows refer to. */
+  const char* lazy_code_base_{nullptr};
+  /*! \brief Size of the serialized blob. */
+  size_t lazy_code_size_{0};
+  /*! \brief Keeps the mapping alive when the blob lives in a mapped file. */
+  std::shared_ptr<MmapFile> mmap_;
+  /*! \brief Guards materialization; VMs on different threads may share an executable. */
+  mutable std::mutex lazy_mutex_;
 
   /*! \brief The serialized bytecode. */
   std::string code_;
@@ -123,12 +123,13 @@ struct VMFrame {
   /*! \brief Register in caller's frame to put return value */
   RegName caller_return_register;
 
-  VMFrame(Index pc, Index func_index, Index args, const Instruction* code, Index register_file_size)
+  VMFrame(Index pc, Index func_index, Index args, const Instruction* code,
+          std::vector<ObjectRef> register_file)
       : pc(pc),
         func_index(func_index),
         args(args),
         code(code),
-        register_file(register_file_size),
+        register_file(std::move(register_file)),
         caller_return_register(0) {}
 };
 
@@ -193,12 +194,24 @@ class VirtualMachine : public runtime::ModuleNode {
    */
   inline void WriteRegister(RegName reg, const ObjectRef& obj);
 
+  /*!
+   * \brief Write to a VM register, taking ownership of the object.
+   * \param reg The register to write to.
+   * \param obj The object to write to.
+   */
+  inline void WriteRegister(RegName reg, ObjectRef&& obj);
+
   /*!
    * \brief Read a VM register.
+   *
+   * The returned reference borrows the register slot: it stays valid until
+   * the register is written again, so callers that need the value beyond
+   * that point must copy it.
+   *
    * \param reg The register to read from.
    * \return The read object.
    */
-  inline ObjectRef ReadRegister(RegName reg) const;
+  inline const ObjectRef& ReadRegister(RegName reg) const;
 
   /*!
    * \brief Read a VM register and cast it to int32_t
@@ -238,6 +251,17 @@ class VirtualMachine : public runtime::ModuleNode {
   virtual void InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count,
                             Index output_size, const std::vector<ObjectRef>& args);
 
+  /*!
+   * \brief Hook called before executing instructions that do attributable
+   * work outside InvokePacked (tensor/storage allocation, reshape, device
+   * copy), so subclasses such as the profiler VM can time them.
+   * \param instr The instruction about to execute.
+   */
+  virtual void OpStartHook(const Instruction& instr) {}
+
+  /*! \brief Hook called when the instruction passed to OpStartHook retires. */
+  virtual void OpStopHook() {}
+
   /*!
    * \brief Initialize the virtual machine for a set of devices.
    * \param devices The set of TVM devices.
@@ -259,10 +283,143 @@ class VirtualMachine : public runtime::ModuleNode {
   void InvokeGlobal(const VMFunction& func, const std::vector<ObjectRef>& args);
 
  protected:
-  /*! \brief The virtual machine's packed function table. */
+  /*!
+   * \brief Find runs of consecutive InvokePacked instructions with disjoint
+   * register sets, which RunLoop may issue concurrently. Enabled with
+   * TVM_VM_PARALLEL_PACKED=1.
+   */
+  void AnalyzePackedGroups();
+
+  /*!
+   * \brief Issue the independent InvokePacked group starting at the current
+   * pc concurrently and join before advancing past it.
+   * \param group_size Number of instructions in the group.
+   */
+  void RunPackedGroup(Index group_size);
+
+  /*!
+   * \brief Get the packed function at `packed_index`, binding its symbol from
+   * the kernel library on first use.
+   *
+   * Late binding keeps executable load time independent of how many
+   * primitives the executable declares; only the kernels an invocation
+   * actually reaches are looked up.
+   *
+   * \param packed_index The offset of the PackedFunction in all functions.
+   * \return The bound function; fatal when the symbol is missing.
+   */
+  const PackedFunc& GetPackedFunc(Index packed_index);
+
+  /*!
+   * \brief Prefault the closure of an entry function: decode its reachable
+   * bytecode and bind every kernel it can invoke, so the first call pays no
+   * deserialization or symbol-lookup cost.
+   * \param func_name The entry function to warm up.
+   */
+  void Warmup(const std::string& func_name);
+
+  /*!
+   * \brief Pick the kernel to run for an InvokePacked given its argument
+   * shapes.
+   *
+   * When shape specialization is enabled (TVM_VM_SHAPE_SPECIALIZE) the VM
+   * counts how often each shape signature of a primitive is observed. Once a
+   * signature becomes hot, a statically shaped variant is looked up: first as
+   * a pre-seeded symbol in the kernel library, then through the optional
+   * "vm.shape_specialize" global the compiler may register to JIT one. Hits
+   * on the inline cache dispatch to the variant; everything else falls back
+   * to the generic kernel.
+   *
+   * \param packed_index The offset of the PackedFunction in all functions.
+   * \param args Arguments to the PackedFunction.
+   * \return The kernel to invoke; always valid.
+   */
+  const PackedFunc& SelectPackedFunc(Index packed_index, const std::vector<ObjectRef>& args);
+
+  /*!
+   * \brief Record the shape signature of an entry-function invocation.
+   *
+   * The per-function signature counts are retrievable through the
+   * "get_shape_profile" function and feed profile-guided static
+   * specialization of mostly-static workloads. Non-tensor arguments are not
+   * profiled.
+   *
+   * \param name The entry function being invoked.
+   * \param args Arguments to the invocation.
+   */
+  void RecordShapeProfile(const std::string& name, const std::vector<ObjectRef>& args);
+
+  /*! \brief Per-signature state for shape-specialized dispatch. */
+  struct ShapeSpecialEntry {
+    /*! \brief How often this signature has been observed. */
+    int64_t hits{0};
+    /*! \brief Whether a specialized kernel lookup has been attempted. */
+    bool resolved{false};
+    /*! \brief The specialized kernel, or nullptr when none exists. */
+    PackedFunc func{nullptr};
+  };
+
+  /*!
+   * \brief The virtual machine's packed function table. Entries are bound
+   * lazily from the kernel library; access them through GetPackedFunc.
+   */
   std::vector<PackedFunc> packed_funcs_;
+  /*! \brief The name of each packed function, indexed like packed_funcs_. */
+  std::vector<std::string> packed_names_;
+  /*!
+   * \brief Inline cache of shape signature to specialized kernel, one table
+   * per packed function. Empty unless TVM_VM_SHAPE_SPECIALIZE is set.
+   */
+  std::vector<std::unordered_map<std::string, ShapeSpecialEntry>> shape_special_cache_;
+  /*!
+   * \brief Number of observations before a signature is considered hot.
+   * Zero disables shape-specialized dispatch.
+   */
+  int64_t shape_special_threshold_{0};
+  /*!
+   * \brief Count of observed shape signatures per entry function, capped at
+   * kShapeSpecialMaxSignatures distinct signatures each.
+   */
+  std::unordered_map<std::string, std::unordered_map<std::string, int64_t>> invoke_shape_profile_;
   /*! \brief The current stack of call frames. */
   std::vector<VMFrame> frames_;
+  /*!
+   * \brief Recycled register files. PopFrame parks the (cleared) register
+   * file of the dying frame here and PushFrame reuses it, so steady-state
+   * invocation does not allocate.
+   */
+  std::vector<std::vector<ObjectRef>> free_register_files_;
+  /*!
+   * \brief Length of each independent InvokePacked group, keyed by the
+   * address of its first instruction. Empty unless TVM_VM_PARALLEL_PACKED
+   * is set.
+   */
+  std::unordered_map<const Instruction*, Index> parallel_group_len_;
+  /*! \brief A storage buffer kept across invocations for reuse. */
+  struct StorageReservation {
+    /*! \brief The reserved storage. */
+    Storage storage;
+    /*! \brief The invocation that last handed the storage out. */
+    uint64_t epoch{0};
+  };
+  /*!
+   * \brief Storage reservations keyed by their AllocStorage instruction,
+   * kept across invocations when reserve_storage_ is on. A reservation is
+   * reused whenever its buffer is at least as large as the requested size,
+   * so a warm-up call with maximum (envelope) shapes sizes every entry and
+   * later calls with smaller shapes allocate nothing. The epoch guards
+   * loops: only the first execution of an instruction per invocation may
+   * reuse or replace its reservation.
+   */
+  std::unordered_map<const Instruction*, StorageReservation> storage_reservations_;
+  /*!
+   * \brief Whether AllocStorage reuses envelope-sized reservations. Only
+   * valid when the caller guarantees the previous invocation's results are
+   * no longer referenced when the next invocation starts.
+   */
+  bool reserve_storage_{false};
+  /*! \brief Monotonic invocation counter for reservation epochs. */
+  uint64_t invoke_epoch_{0};
   /*! \brief The fuction table index of the current function. */
   Index func_index_;
   /*! \brief The current pointer to the code section. */
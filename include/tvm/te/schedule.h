@@ -321,6 +321,24 @@ class Schedule : public ObjectRef {
    */
   TVM_DLL Tensor cache_read(const Tensor& tensor, const std::string& scope,
                             const Array<Operation>& readers);
+  /*!
+   * \brief Create a packed copy of tensor in a cache-blocked layout.
+   *  Dimension i of the tensor is blocked by block_factors[i]: the packed
+   *  tensor carries all block indices as outer dimensions followed by all
+   *  intra-block offsets, so one block is contiguous in memory. Reads in the
+   *  readers are redirected to the packed layout; partial tail blocks are
+   *  padded and the padding is never read. A new stage computing the packed
+   *  tensor is created, and its bounds flow through InferBound like any
+   *  other compute stage.
+   * \param tensor The tensor to be packed.
+   * \param block_factors The block size of each dimension, must be positive
+   *  constants with one entry per dimension.
+   * \param scope The scope of the packed tensor.
+   * \param readers The readers to redirect to the packed tensor.
+   * \return The created tensor.
+   */
+  TVM_DLL Tensor pack(const Tensor& tensor, const Array<Integer>& block_factors,
+                      const std::string& scope, const Array<Operation>& readers);
   /*!
    * \brief Create a cache write tensor for producing tensor.
    *  The the tensor will take over body of original tensor op.
@@ -104,6 +104,16 @@ TVM_DLL const Op& large_uint_imm();
  */
 TVM_DLL const Op& q_multiply_shift();
 
+/*!
+ * \brief Compute 4-way dot products of 8 bit integers with accumulation.
+ *
+ *  For an accumulator acc with n lanes of int32 and operands a, b with
+ *  4 * n lanes of int8/uint8:
+ *
+ *  dp4a(a, b, acc)[i] = acc[i] + sum_{j<4} a[i * 4 + j] * b[i * 4 + j]
+ */
+TVM_DLL const Op& dp4a();
+
 /*!
  * \brief See pesudo code
  *
@@ -1270,6 +1270,11 @@ constexpr const char* double_buffer_scope = "double_buffer_scope";
  * \brief Marks region used by double buffer write
  */
 constexpr const char* double_buffer_write = "double_buffer_write";
+/*!
+ * \brief Marks production of a software pipelined buffer,
+ *  value is the number of buffered versions.
+ */
+constexpr const char* software_pipeline_scope = "software_pipeline_scope";
 /*! \brief Mark of scan update scope */
 constexpr const char* scan_update_scope = "scan_update_scope";
 /*! \brief Mark of scan init scope */
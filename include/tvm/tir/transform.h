@@ -63,6 +63,15 @@ TVM_DLL Pass CreatePrimFuncPass(
  */
 TVM_DLL Pass InjectPrefetch();
 
+/*!
+ * \brief Automatically prefetch streaming loads detected from their strides.
+ *
+ *  Controlled by the tir.AutoPrefetch pass config, disabled by default.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass AutoInjectPrefetch();
+
 // TODO(tvm-team): consolidate configs to the PassContext
 /*!
  * \brief Flatten the multi-dimensional read/write
@@ -135,6 +144,14 @@ TVM_DLL Pass InjectVirtualThread();
  */
 TVM_DLL Pass InjectDoubleBuffer();
 
+/*!
+ * \brief Inject software pipelined producers for annotated buffers,
+ *  overlapping data fetch with compute across loop iterations.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass InjectSoftwarePipeline();
+
 /*!
  * \brief Rewrite storage allocation pattern.
  *  Moves the allocation to outer most possible scope.
@@ -153,6 +170,15 @@ TVM_DLL Pass StorageRewrite();
  */
 TVM_DLL Pass UnrollLoop();
 
+/*!
+ * \brief Flatten perfectly nested constant-bound serial loops into their
+ *        parallel parent loop, so shallow outer loops expose the full
+ *        iteration count to the parallel launcher.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass FlattenParallelLoops();
+
 /*!
  * \brief Remove No Op from the Stmt.
  *
@@ -160,6 +186,23 @@ TVM_DLL Pass UnrollLoop();
  */
 TVM_DLL Pass RemoveNoOp();
 
+/*!
+ * \brief Hoist repeated scalar subexpressions inside loop bodies into
+ *        LetStmt bindings. Buffer loads are only hoisted out of bodies
+ *        that contain no writes.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass CommonSubexprElim();
+
+/*!
+ * \brief Hoist loop-invariant, load-free scalar computations into LetStmt
+ *        bindings above the loops that recompute them.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass HoistLoopInvariants();
+
 /*!
  * \brief Detect and rewrite unsafe select that contains memory access.
  *
@@ -181,6 +224,15 @@ TVM_DLL Pass Simplify();
  */
 TVM_DLL Pass InstrumentBoundCheckers();
 
+/*!
+ * \brief Wrap loop nests carrying a "profile_stage" pragma with calls to
+ *        TVMBackendProfileStageBegin/End so the runtime stage profiler can
+ *        attribute time inside fused kernels.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass InstrumentProfileStages();
+
 /*!
  * \brief Transform the high-level PrimFunc to a low-level version
  *        that can be used as an API function.
@@ -212,6 +264,29 @@ TVM_DLL Pass InstrumentBoundCheckers();
  */
 TVM_DLL Pass MakePackedAPI(int num_unpacked_args);
 
+/*!
+ * \brief Transform the high-level PrimFunc to a C signature that takes the
+ *  raw data pointers of its buffer arguments directly.
+ *
+ *  The function signature becomes
+ *
+ *  \code
+ *
+ *  int32_t f(void* arg_0, ..., void* arg_n)
+ *
+ *  \endcode
+ *
+ *  where each argument is the data field of the DLTensor the packed API
+ *  would have received. Shapes and strides are assumed static, so no
+ *  type or shape checking code is emitted. This is used by the AOT
+ *  executor in direct-call mode, where call sites and callees are
+ *  compiled together and the packed-function marshalling would only add
+ *  overhead.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass MakeUnpackedAPI();
+
 /*!
  * \brief Remap the thread axis
  *
@@ -321,6 +396,17 @@ TVM_DLL Pass CombineContextCall();
  */
 TVM_DLL Pass NarrowDataType(int target_bits);
 
+/*!
+ * \brief Narrow the datatype of indexing vars without provable bounds,
+ *        guarded by a runtime check that every buffer's element count fits
+ *        into the target type; oversized shapes fall back to the original
+ *        wide-index body.
+ *
+ * \param target_bits The target bits
+ * \return The pass.
+ */
+TVM_DLL Pass GuardedNarrowDataType(int target_bits);
+
 /*!
  * \brief Legalize bf16 typed Ops. Add a cast to fp32
  *   before Ops, then add a cast back to bf16.
@@ -380,13 +380,9 @@ inline Tensor full_like(const Tensor& x, const PrimExpr fill_value,
 }
 
 /*!
- * \brief Fast exponential function implementation
+ * \brief Fast exponential expression
  *
- * \param _x The input tensor
- * \param name The name of the operation
- * \param tag The tag to mark the operation
- *
- * \return A Tensor whose op member is exponent operation
+ * \param arg The input expression.
  *
  * \note Function computes:
  * log2(e^x) = x * log2(e) * log2(2) =>
@@ -400,7 +396,7 @@ inline Tensor full_like(const Tensor& x, const PrimExpr fill_value,
  * Approximation for fractional part:
  * y = exp(f) = 1 + 2 * P(x**2)/(Q(x**2) - P(x**2))
  */
-inline Tensor fast_exp_float32(const Tensor& _x, std::string name, std::string tag) {
+inline PrimExpr fast_exp_float_expr(PrimExpr arg) {
   auto x_hi = make_const(DataType::Float(32), 88.3762626647950f);
   auto x_lo = make_const(DataType::Float(32), -88.3762626647949f);
   auto log2e = make_const(DataType::Float(32), 1.44269504088896341f);
@@ -415,23 +411,22 @@ inline Tensor fast_exp_float32(const Tensor& _x, std::string name, std::string t
   auto one_half = make_const(DataType::Float(32), 0.5f);
   auto b = make_const(DataType::Float(32), 127.0f);
 
+  // clamp x
+  auto x = ::tvm::max(::tvm::min(arg, x_hi), x_lo);
+  // integer part
+  auto n = ::tvm::floor(x * log2e + one_half);
+  // fractional part
+  auto f = x - n * ln2;
+  auto y =
+      (((((p[0] * f + p[1]) * f + p[2]) * f + p[3]) * f + p[4]) * f + p[5]) * f * f + f + one;
+  // Return 2^m * exp(r).
+  auto ef = tvm::reinterpret(DataType::Float(32), ::tvm::cast(DataType::Int(32), n + b) << 23);
+  return ::tvm::max(ef * y, arg);  // NOLINT(*)
+}
+
+inline Tensor fast_exp_float32(const Tensor& _x, std::string name, std::string tag) {
   return compute(
-      _x->shape,
-      [&](const Array<Var>& i) {
-        // clamp x
-        auto x = ::tvm::max(::tvm::min(_x(i), x_hi), x_lo);
-        // integer part
-        auto n = ::tvm::floor(x * log2e + one_half);
-        // fractional part
-        auto f = x - n * ln2;
-        auto y =
-            (((((p[0] * f + p[1]) * f + p[2]) * f + p[3]) * f + p[4]) * f + p[5]) * f * f + f + one;
-        // Return 2^m * exp(r).
-        auto ef =
-            tvm::reinterpret(DataType::Float(32), ::tvm::cast(DataType::Int(32), n + b) << 23);
-        return ::tvm::max(ef * y, _x(i));  // NOLINT(*)
-      },
-      name, tag);
+      _x->shape, [&](const Array<Var>& i) { return fast_exp_float_expr(_x(i)); }, name, tag);
 }
 
 /*!
@@ -455,6 +450,38 @@ inline Tensor fast_exp(const Tensor& x, std::string name = "T_fast_exp",
   }
 }
 
+/*!
+ * \brief Fast sigmoid implementation
+ *
+ * \note Computes 1 / (1 + e^-x) with the exponential replaced by the
+ * fast_exp polynomial approximation.
+ */
+inline Tensor fast_sigmoid_float32(const Tensor& _x, std::string name, std::string tag) {
+  auto one = make_const(DataType::Float(32), 1.0f);
+  return compute(
+      _x->shape, [&](const Array<Var>& i) { return one / (one + fast_exp_float_expr(-_x(i))); },
+      name, tag);
+}
+
+/*!
+ * \brief Fast sigmoid implementation
+ *
+ * \param x The input tensor
+ * \param name The name of the operation
+ * \param tag The tag to mark the operation
+ *
+ * \return A Tensor whose op member is sigmoid operation
+ *
+ */
+inline Tensor fast_sigmoid(const Tensor& x, std::string name = "T_fast_sigmoid",
+                           std::string tag = kElementWise) {
+  if (x->dtype == DataType::Float(32)) {
+    return fast_sigmoid_float32(x, name, tag);
+  } else {
+    return sigmoid(x);
+  }
+}
+
 /*!
  * \brief Fast_erf_float expression from Eigen
  * https://github.com/eigenteam/eigen-git-mirror/blob/master/unsupported/Eigen/src/SpecialFunctions/SpecialFunctionsImpl.h#L290
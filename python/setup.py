@@ -167,8 +167,8 @@ if include_libs:
 
 
 def get_package_data_files():
-    # Relay standard libraries
-    return ["relay/std/prelude.rly", "relay/std/core.rly"]
+    # Relay standard libraries and bundled schedule databases
+    return ["relay/std/prelude.rly", "relay/std/core.rly", "autotvm/bundles/*.schdb"]
 
 
 # Temporarily add this directory to the path so we can import the requirements generator
@@ -165,6 +165,7 @@ class Device(ctypes.Structure):
     MASK2STR = {
         1: "cpu",
         2: "cuda",
+        3: "cuda_host",
         4: "opencl",
         5: "aocl",
         6: "sdaccel",
@@ -184,6 +185,7 @@ class Device(ctypes.Structure):
         "c": 1,
         "cuda": 2,
         "nvptx": 2,
+        "cuda_host": 3,
         "cl": 4,
         "opencl": 4,
         "aocl": 5,
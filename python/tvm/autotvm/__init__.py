@@ -35,6 +35,7 @@ from . import task
 from . import tuner
 from . import utils
 from . import env
+from . import bundle
 from . import tophub
 
 # some shortcuts
@@ -0,0 +1,273 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""
+Bundled schedule database.
+
+Binary releases can ship a database of best-known configs for common
+(workload, target key) pairs so that users without any tuning
+infrastructure still get tuned schedules out of the box. Unlike TopHub,
+nothing is downloaded: the bundles sit inside the installed package and
+are consulted below any user supplied or TopHub logs.
+
+A bundle file is a binary index over ordinary autotvm log records. The
+index is read once when the bundle is opened; the record blob is mapped
+into memory and an individual record is only decoded the first time a
+query hits it, so shipping a large database costs neither import time
+nor memory for builds that never touch most of it.
+"""
+# pylint: disable=invalid-name
+
+import json
+import logging
+import mmap
+import os
+import struct
+from pathlib import Path
+
+import numpy as np
+
+from ..target import Target
+from .record import decode, encode, load_from_file
+from .task.dispatcher import DispatchContext
+from .utils import EmptyContext
+
+logger = logging.getLogger("autotvm")
+
+# environment variable listing extra bundle files, separated by os.pathsep
+AUTOTVM_BUNDLE_PATH_VAR = "TVM_AUTOTVM_BUNDLE_PATH"
+
+# directory inside the package where release tooling places the bundles,
+# one "<device or target kind>.schdb" file per backend
+AUTOTVM_BUNDLE_DIR = Path(__file__).parent / "bundles"
+
+# A bundle file is laid out as: MAGIC, u32 version, u32 number of index
+# entries, u64 index size in bytes, the index, then the record blob. Each
+# index entry is a u32 key length, the key bytes, and the u64 offset and
+# size of the record line inside the blob. Records shared by several keys
+# are stored once.
+BUNDLE_MAGIC = b"TVMSCHDB"
+BUNDLE_VERSION = 1
+
+_HEADER = struct.Struct("<II")
+_INDEX_SIZE = struct.Struct("<Q")
+_KEY_LEN = struct.Struct("<I")
+_ENTRY = struct.Struct("<QQ")
+
+
+def _bundle_key(target_key, workload):
+    """Serialize a (target key, workload) pair into bundle key bytes."""
+    return json.dumps((target_key, workload)).encode("utf-8")
+
+
+def create_bundle(records, path):
+    """Pack the best record per (target key, workload) into a bundle file.
+
+    Parameters
+    ----------
+    records : str or iterator of (autotvm.measure.MeasureInput, autotvm.measure.MeasureResult)
+        Collection of tuning records. If is str, then it should be the
+        filename of a records log file.
+    path : str
+        The output bundle file.
+    """
+    if isinstance(records, Path):
+        records = str(records)
+    if isinstance(records, str):
+        records = load_from_file(records)
+
+    best = {}
+    for inp, res in records:
+        if res.error_no != 0:
+            continue
+        keys = [(k, inp.task.workload) for k in inp.target.keys]
+        if inp.target.model != "unknown":
+            keys.append((inp.target.model, inp.task.workload))
+        for key in keys:
+            bkey = _bundle_key(*key)
+            if bkey not in best or np.mean(best[bkey][1].costs) > np.mean(res.costs):
+                best[bkey] = (inp, res)
+
+    blob = bytearray()
+    index = bytearray()
+    offsets = {}
+    for bkey in sorted(best):
+        inp, res = best[bkey]
+        line = encode(inp, res).encode("utf-8")
+        if line not in offsets:
+            offsets[line] = (len(blob), len(line))
+            blob.extend(line)
+        offset, size = offsets[line]
+        index.extend(_KEY_LEN.pack(len(bkey)))
+        index.extend(bkey)
+        index.extend(_ENTRY.pack(offset, size))
+
+    with open(path, "wb") as fout:
+        fout.write(BUNDLE_MAGIC)
+        fout.write(_HEADER.pack(BUNDLE_VERSION, len(best)))
+        fout.write(_INDEX_SIZE.pack(len(index)))
+        fout.write(bytes(index))
+        fout.write(bytes(blob))
+
+    logger.debug("Packed %d entries into schedule bundle %s", len(best), path)
+
+
+class ApplyBundle(DispatchContext):
+    """Apply the best configs from a bundle file.
+
+    Parameters
+    ----------
+    path : str
+        The path to the bundle file created by :any:`create_bundle`.
+    """
+
+    def __init__(self, path):
+        super(ApplyBundle, self).__init__()
+        self.path = str(path)
+        with open(self.path, "rb") as fin:
+            magic = fin.read(len(BUNDLE_MAGIC))
+            if magic != BUNDLE_MAGIC:
+                raise ValueError("%s is not a schedule bundle file" % self.path)
+            version, num_entries = _HEADER.unpack(fin.read(_HEADER.size))
+            if version != BUNDLE_VERSION:
+                raise ValueError(
+                    "Schedule bundle %s has version %d, expected %d"
+                    % (self.path, version, BUNDLE_VERSION)
+                )
+            (index_size,) = _INDEX_SIZE.unpack(fin.read(_INDEX_SIZE.size))
+            index = fin.read(index_size)
+            blob_start = fin.tell()
+            # The records stay in the mapping; only the ones a query hits
+            # are ever paged in and decoded.
+            self._mmap = mmap.mmap(fin.fileno(), 0, access=mmap.ACCESS_READ)
+
+        self._index = {}
+        pos = 0
+        for _ in range(num_entries):
+            (key_len,) = _KEY_LEN.unpack_from(index, pos)
+            pos += _KEY_LEN.size
+            key = bytes(index[pos : pos + key_len])
+            pos += key_len
+            offset, size = _ENTRY.unpack_from(index, pos)
+            pos += _ENTRY.size
+            self._index[key] = (blob_start + offset, size)
+        self._cache = {}
+
+    def _lookup(self, bkey):
+        if bkey in self._cache:
+            return self._cache[bkey]
+        entry = self._index.get(bkey)
+        if entry is None:
+            return None
+        offset, size = entry
+        line = self._mmap[offset : offset + size].decode("utf-8")
+        inp, _ = decode(line)
+        self._cache[bkey] = inp.config
+        return inp.config
+
+    def _query_inside(self, target, workload):
+        if target is None:
+            return None
+
+        # first try matching by model, then by target key, like ApplyHistoryBest
+        if target.model != "unknown":
+            cfg = self._lookup(_bundle_key(target.model, workload))
+            if cfg is not None:
+                return cfg
+        for k in target.keys:
+            cfg = self._lookup(_bundle_key(k, workload))
+            if cfg is not None:
+                return cfg
+        return None
+
+    def update(self, target, workload, cfg):
+        # assume a user provided config is the best
+        cfg.cost = 0
+        self._cache[_bundle_key(target.model, workload)] = cfg
+        for k in target.keys:
+            self._cache[_bundle_key(k, workload)] = cfg
+
+
+class StackedContext(DispatchContext):
+    """Query a list of dispatch contexts in order; the first hit wins.
+
+    Parameters
+    ----------
+    contexts : list of DispatchContext
+        The contexts to query, in decreasing priority.
+    """
+
+    def __init__(self, contexts):
+        super(StackedContext, self).__init__()
+        self._contexts = list(contexts)
+
+    def _query_inside(self, target, workload):
+        # pylint: disable=protected-access
+        for ctx in self._contexts:
+            ret = ctx._query_inside(target, workload)
+            if ret is not None:
+                return ret
+        return None
+
+    def update(self, target, workload, cfg):
+        self._contexts[0].update(target, workload, cfg)
+
+
+def context(target):
+    """Return a dispatch context backed by the schedule bundles that ship
+    with this build of TVM, or an :any:`EmptyContext` when none apply.
+
+    Parameters
+    ----------
+    target: Target or List of Target
+        The compilation target
+    """
+    targets = target if isinstance(target, (list, tuple)) else [target]
+
+    paths = []
+    env_paths = os.getenv(AUTOTVM_BUNDLE_PATH_VAR)
+    if env_paths:
+        paths.extend(Path(p) for p in env_paths.split(os.pathsep) if p)
+
+    for tgt in targets:
+        if isinstance(tgt, str):
+            tgt = Target(tgt)
+        possible_names = []
+        device = tgt.attrs.get("device", "")
+        if device != "":
+            possible_names.append(str(device))
+        possible_names.append(tgt.kind.name)
+        for name in possible_names:
+            paths.append(AUTOTVM_BUNDLE_DIR / ("%s.schdb" % name))
+
+    contexts = []
+    seen = set()
+    for path in paths:
+        if str(path) in seen:
+            continue
+        seen.add(str(path))
+        if not path.is_file():
+            continue
+        try:
+            contexts.append(ApplyBundle(path))
+        except (OSError, ValueError) as err:
+            logger.warning("Failed to load schedule bundle %s: %s", path, err)
+
+    if not contexts:
+        return EmptyContext()
+    if len(contexts) == 1:
+        return contexts[0]
+    return StackedContext(contexts)
@@ -60,6 +60,9 @@ try:
     _get_itervar_feature_flatten = tvm._ffi.get_global_func(
         "autotvm.feature.GetItervarFeatureFlatten"
     )
+    _get_itervar_feature_flatten_batch = tvm._ffi.get_global_func(
+        "autotvm.feature.GetItervarFeatureFlattenBatch"
+    )
 except ValueError as e:
 
     def raise_error(*args, **kwargs):  # pylint: disable=unused-argument
@@ -67,7 +70,7 @@ except ValueError as e:
 
     _get_buffer_curve_sample_flatten = (
         _get_itervar_feature
-    ) = _get_itervar_feature_flatten = raise_error
+    ) = _get_itervar_feature_flatten = _get_itervar_feature_flatten_batch = raise_error
 
 
 def get_itervar_feature(sch, args, take_log=False):
@@ -142,6 +145,37 @@ def get_itervar_feature_flatten(sch, args, take_log=True):
     return feas
 
 
+def get_itervar_feature_flatten_batch(sch_args_pairs, take_log=True):
+    """get flatten features of iter vars for a batch of schedules
+
+    The statements are featurized in parallel in C++, which is much faster
+    than calling get_itervar_feature_flatten in a loop when featurizing many
+    configs of one task.
+
+    Parameters
+    ----------
+    sch_args_pairs: list of (tvm.te.schedule.Schedule, Array of te.tensor.Tensor)
+        the schedules and their buffer args for lower
+    take_log: bool
+        whether take log of numerical statics
+
+    Returns
+    -------
+    flatten_features: list of np.ndarray
+        one one-dimensional vector per schedule
+    """
+    stmts = [ana_lower(sch, args, simple_mode=True) for sch, args in sch_args_pairs]
+    blob = _get_itervar_feature_flatten_batch(stmts, take_log)
+    (n,) = struct.unpack_from("1i", blob, 0)
+    sizes = struct.unpack_from("%di" % n, blob, 4)
+    ret = []
+    offset = 4 + 4 * n
+    for size in sizes:
+        ret.append(np.array(struct.unpack_from("%df" % size, blob, offset), dtype=np.float32))
+        offset += 4 * size
+    return ret
+
+
 def get_flatten_name(fea):
     """Get names of feature after flatten.
 
@@ -27,6 +27,7 @@ from os import getenv
 import sys
 from pathlib import Path
 
+from . import bundle
 from .task import ApplyHistoryBest
 from ..target import Target
 from ..contrib.download import download
@@ -125,6 +126,12 @@ def context(target, extra_files=None):
         for filename in extra_files:
             best_context.load(filename)
 
+    # Schedule bundles shipped with the package sit below the TopHub logs,
+    # so downloaded or user supplied records always win.
+    bundle_context = bundle.context(targets)
+    if not isinstance(bundle_context, EmptyContext):
+        best_context = bundle.StackedContext([best_context, bundle_context])
+
     return best_context
 
 
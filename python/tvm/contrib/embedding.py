@@ -0,0 +1,144 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""External function interface to fused CPU embedding-lookup kernels."""
+import tvm
+from tvm import te
+
+
+def lookup(table, indices, **kwargs):
+    """Gather rows of an embedding table with software prefetching.
+
+    Parameters
+    ----------
+    table : Tensor
+        The embedding table, rows along the first axis.
+    indices : Tensor
+        1-D tensor of row indices (int32 or int64).
+
+    Returns
+    -------
+    out : Tensor
+        The gathered rows, shape (len(indices),) + table.shape[1:].
+    """
+    out_shape = (indices.shape[0],) + tuple(table.shape[1:])
+    return te.extern(
+        out_shape,
+        [table, indices],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.embedding.lookup", ins[0], ins[1], outs[0]
+        ),
+        name="embedding_lookup",
+        **kwargs,
+    )
+
+
+def lookup_sum(table, indices, offsets, num_bags, **kwargs):
+    """Bag-style lookup: sum the table rows of each index segment.
+
+    Bag ``b`` sums the rows ``indices[offsets[b]:offsets[b+1]]``; offsets
+    carries one entry per bag plus the trailing total, CSR style.
+
+    Parameters
+    ----------
+    table : Tensor
+        The float32 embedding table, rows along the first axis.
+    indices : Tensor
+        1-D tensor of row indices (int32 or int64).
+    offsets : Tensor
+        1-D tensor of bag boundaries, same dtype as indices.
+    num_bags : int
+        Number of bags, i.e. len(offsets) - 1.
+
+    Returns
+    -------
+    out : Tensor
+        The per-bag sums, shape (num_bags,) + table.shape[1:].
+    """
+    out_shape = (num_bags,) + tuple(table.shape[1:])
+    return te.extern(
+        out_shape,
+        [table, indices, offsets],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.embedding.lookup_sum", ins[0], ins[1], ins[2], outs[0]
+        ),
+        name="embedding_lookup_sum",
+        **kwargs,
+    )
+
+
+def lookup_concat(tables, indices, **kwargs):
+    """Fused gather from several tables concatenated along the feature axis.
+
+    Row ``i`` of the output is the concatenation of ``tables[t][indices[t][i]]``
+    over all tables, produced in a single pass without the intermediate
+    per-table gather results.
+
+    Parameters
+    ----------
+    tables : list of Tensor
+        The embedding tables; dtypes must match.
+    indices : list of Tensor
+        One 1-D index tensor per table, all of the same length.
+
+    Returns
+    -------
+    out : Tensor
+        Shape (len(indices[0]), sum of table feature widths).
+    """
+    assert len(tables) == len(indices) and tables, "need one index tensor per table"
+    width = sum(int(t.shape[1]) for t in tables)
+    out_shape = (indices[0].shape[0], width)
+    ins_flat = []
+    for tbl, idx in zip(tables, indices):
+        ins_flat += [tbl, idx]
+    return te.extern(
+        out_shape,
+        ins_flat,
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.embedding.lookup_concat", outs[0], *ins
+        ),
+        name="embedding_lookup_concat",
+        dtype=tables[0].dtype,
+        **kwargs,
+    )
+
+
+def empty_table(shape, dtype="float32", device=None):
+    """Allocate an embedding table backed by huge pages when available.
+
+    Large tables gathered at random addresses miss the TLB on nearly every
+    row; 2MB pages cover far more memory per TLB entry. Falls back to
+    transparent huge pages (and then to a normal allocation) when no huge
+    pages are reserved.
+
+    Parameters
+    ----------
+    shape : tuple of int
+        The table shape.
+    dtype : str
+        The element type.
+    device : Device
+        The device; defaults to cpu(0) and must be a CPU device.
+
+    Returns
+    -------
+    arr : tvm.nd.NDArray
+        The allocated table.
+    """
+    if device is None:
+        device = tvm.cpu(0)
+    return tvm.nd.empty(shape, dtype, device, mem_scope="global.hugepage")
@@ -160,6 +160,9 @@ class GraphModule(object):
         self._get_num_inputs = module["get_num_inputs"]
         self._load_params = module["load_params"]
         self._share_params = module["share_params"]
+        self._set_managed_storage = module["set_managed_storage"]
+        self._set_online_tuning = module["set_online_tuning"]
+        self._online_tuning_report = module["online_tuning_report"]
 
     def set_input(self, key=None, value=None, **params):
         """Set inputs to the module via kwargs
@@ -295,6 +298,51 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def set_managed_storage(self, budget_bytes, names):
+        """Back the named weights with host memory and stream them on demand.
+
+        The device copies of the managed weights form an LRU cache bounded by
+        `budget_bytes`, so a model whose weights exceed device memory can
+        still run as long as the weights of any single op fit. Call after
+        loading parameters.
+
+        Parameters
+        ----------
+        budget_bytes : int
+            Device cache budget in bytes; 0 means unbounded.
+        names : list of str
+            The input names of the weights to manage.
+        """
+        self._set_managed_storage(budget_bytes, *names)
+
+    def set_online_tuning(self, rounds):
+        """Enable online selection between kernel variants.
+
+        Only meaningful for modules built with the
+        `relay.backend.kernel_variants` config, which compiles several
+        schedule candidates per op. The first `rounds` invocations of each
+        variant are timed; after that the fastest variant is locked in for
+        the rest of the module lifetime.
+
+        Parameters
+        ----------
+        rounds : int
+            Number of timed invocations per variant. 0 disables tuning and
+            runs the primary variant.
+        """
+        self._set_online_tuning(rounds)
+
+    def online_tuning_report(self):
+        """Return a per-op summary of the variant timings collected so far.
+
+        Returns
+        -------
+        report : str
+            One line per multi-variant op with the mean time of each variant
+            and the winner, once locked in.
+        """
+        return self._online_tuning_report()
+
     def __getitem__(self, key):
         """Get internal module function
 
@@ -244,3 +244,33 @@ def ir_lower_vtcm():
 
 def ir_lower_vtcm_pass():
     return [(3, ir_lower_vtcm())]
+
+
+### DMA
+
+
+def intrin_dma_copy(src, dst, pad_before, pad_after, pad_value):  # pylint: disable=unused-argument
+    """Lower a copy stage marked with the 'dma_copy' pragma to DMA calls.
+
+    The copy is issued through HexagonBackendDmaStart and immediately
+    fenced with HexagonBackendDmaWait; schedules that want to overlap the
+    transfer with compute combine the pragma with double buffering so two
+    transfers are in flight across iterations.
+    """
+    if pad_before or pad_after:
+        raise RuntimeError("DMA copy does not support padding")
+    elem_bytes = tvm.runtime.DataType(dst.dtype).bits // 8
+    nbytes = ft.reduce(lambda x, y: x * y, dst.shape, elem_bytes)
+    ticket = tvm.tir.call_extern(
+        "uint32", "HexagonBackendDmaStart", dst.access_ptr("w"), src.access_ptr("r"), nbytes
+    )
+    return tvm.tir.Evaluate(tvm.tir.call_extern("", "HexagonBackendDmaWait", ticket))
+
+
+def ir_lower_dma_copy():
+    """Create a pass lowering 'dma_copy' pragmas to the DMA runtime calls."""
+    return tvm.tir.transform.InjectCopyIntrin("dma_copy", intrin_dma_copy)
+
+
+def ir_lower_dma_copy_pass():
+    return [(3, ir_lower_dma_copy())]
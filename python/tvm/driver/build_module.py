@@ -221,8 +221,10 @@ def lower(
     pass_list += [
         tvm.tir.transform.VectorizeLoop(not disable_vectorize),
         tvm.tir.transform.InjectVirtualThread(),
+        tvm.tir.transform.InjectSoftwarePipeline(),
         tvm.tir.transform.InjectDoubleBuffer(),
         tvm.tir.transform.StorageRewrite(),
+        tvm.tir.transform.AutoInjectPrefetch(),
         tvm.tir.transform.UnrollLoop(),
     ]
     pass_list += lower_phase2
@@ -54,6 +54,24 @@ class Node(Object):
         """
         return _ffi_api.AsText(self, show_meta_data, annotate)
 
+    def astext_to_file(self, file_name, show_meta_data=True):
+        """Write the text format of the expression directly to a file.
+
+        The text is streamed to the file as it is generated, so printing
+        very large modules does not materialize the whole text in memory.
+
+        Parameters
+        ----------
+        file_name : str
+            The path of the output file.
+
+        show_meta_data : bool
+            Whether to include meta data section in the text
+            if there is meta data. Keeping it enabled makes the
+            output fully parseable.
+        """
+        _ffi_api.AsTextToFile(self, file_name, show_meta_data)
+
     def __str__(self):
         return _ffi_api.PrettyPrint(self)
 
@@ -340,6 +340,31 @@ def render_pass_profiles():
     return _ffi_transform_api.render_pass_profiles()
 
 
+def render_pass_profiles_json():
+    """Returns the pass profiling data as a JSON string.
+
+    Each record carries the pass name, its duration in microseconds, node
+    counts and structural hashes of the module before and after the pass ran,
+    and nested records for sub-passes. The hashes are stable across processes,
+    so the artifacts of two builds can be diffed stage by stage to find where
+    they diverged.
+    """
+    return _ffi_transform_api.render_pass_profiles_json()
+
+
+def export_pass_profiles(path):
+    """Write the collected pass profiling data as JSON, e.g. next to an
+    exported library.
+
+    Parameters
+    ----------
+    path : str
+        The file path to write to.
+    """
+    with open(path, "w") as f:
+        f.write(render_pass_profiles_json())
+
+
 def clear_pass_profiles():
     """Clears all stored pass profiling data."""
     _ffi_transform_api.clear_pass_profiles()
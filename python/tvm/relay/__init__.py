@@ -36,6 +36,7 @@ from .build_module import build, create_executor, optimize
 from .transform import build_config
 from . import debug
 from . import param_dict
+from . import shape_specialize
 from .backend import vm
 
 # Root operators
@@ -54,6 +54,36 @@ def _search_dense_op_weight(expr):
     return _ffi_api.search_dense_op_weight(expr)
 
 
+# Candidate formats tried when no block size is forced: (1, 1) stands for CSR,
+# the rest are BSR block shapes the x86/cuda sparse_dense schedules handle well.
+_AUTO_BLOCK_SIZE_CANDIDATES = [(1, 1), (4, 1), (8, 1), (16, 1)]
+
+# Relative cost of one irregular index lookup against one multiply-accumulate
+# in the sparse kernels; gathers dominate at small block sizes, fill-in
+# (padding stored blocks with zeros) dominates at large ones.
+_INDEX_OVERHEAD = 4.0
+
+
+def _sparse_dense_cost(w_np, block_size):
+    """Estimate the cost of running sparse_dense with the weight in the given format."""
+    if block_size == (1, 1):
+        nnz = np.count_nonzero(w_np)
+        return nnz * (1.0 + _INDEX_OVERHEAD)
+    sparse_w = sp.bsr_matrix(w_np, blocksize=block_size)
+    num_blocks = sparse_w.data.shape[0]
+    return num_blocks * (block_size[0] * block_size[1] + _INDEX_OVERHEAD)
+
+
+def _best_block_size(w_np):
+    """Pick the cheapest format for the measured sparsity pattern of a weight."""
+    candidates = [
+        bs
+        for bs in _AUTO_BLOCK_SIZE_CANDIDATES
+        if w_np.shape[0] % bs[0] == 0 and w_np.shape[1] % bs[1] == 0
+    ]
+    return min(candidates, key=lambda bs: _sparse_dense_cost(w_np, bs))
+
+
 def process_params(expr, params, block_size, sparsity_threshold):
     """[summary]
 
@@ -63,15 +93,17 @@ def process_params(expr, params, block_size, sparsity_threshold):
         Expr of the network
     params : Dict[String, tvm.nd.array]
         parameters of the network
-    block_size : Tuple(int, int)
-        Blocksize in BSR matrix
+    block_size : Tuple(int, int) or None
+        Blocksize in BSR matrix, with (1, 1) meaning CSR. None selects the
+        cheapest format per weight from its measured sparsity pattern, so one
+        model can mix CSR and several BSR block sizes.
     sparsity_threshold : float
         Minimal sparsity requirement for converting to sparse operation
 
     Returns
     -------
     ret : Namedtuple[weight_name: Array[String], weight_shape: Array[Array[IntImm]]]
-        return names of qualified dense weight and the shape in BSR format
+        return names of qualified dense weight and the shape in BSR or CSR format
     """
 
     # pylint: disable=import-outside-toplevel
@@ -86,7 +118,13 @@ def process_params(expr, params, block_size, sparsity_threshold):
         w_np = params[name].numpy()
         sparsity = 1.0 - (np.count_nonzero(w_np) / w_np.size)
         if sparsity >= sparsity_threshold:
-            sparse_weight = sp.bsr_matrix(w_np, blocksize=block_size)
+            weight_block_size = (
+                tuple(block_size) if block_size is not None else _best_block_size(w_np)
+            )
+            if weight_block_size == (1, 1):
+                sparse_weight = sp.csr_matrix(w_np)
+            else:
+                sparse_weight = sp.bsr_matrix(w_np, blocksize=weight_block_size)
             # remove dense weight
             del params[name]
             memo.weight_name.append(name)
@@ -99,32 +137,33 @@ def process_params(expr, params, block_size, sparsity_threshold):
             params[name + ".indices"] = tvm.nd.array(sparse_weight.indices)
             params[name + ".indptr"] = tvm.nd.array(sparse_weight.indptr)
 
-            prefix = "sparse_dense_bsr_%d_%d_%d_%d_%d_%d_" % (
-                w_np.shape[0],
-                w_np.shape[1],
-                block_size[0],
-                block_size[1],
-                sparse_weight.indices.shape[0],
-                sparse_weight.indptr.shape[0],
-            )
-            register_task_input_buffer(
-                "default",
-                prefix + "W_data",
-                tvm.runtime.ndarray.array(sparse_weight.data),
-                overwrite=True,
-            )
-            register_task_input_buffer(
-                "default",
-                prefix + "W_indices",
-                tvm.runtime.ndarray.array(sparse_weight.indices),
-                overwrite=True,
-            )
-            register_task_input_buffer(
-                "default",
-                prefix + "W_indptr",
-                tvm.runtime.ndarray.array(sparse_weight.indptr),
-                overwrite=True,
-            )
+            if weight_block_size != (1, 1):
+                prefix = "sparse_dense_bsr_%d_%d_%d_%d_%d_%d_" % (
+                    w_np.shape[0],
+                    w_np.shape[1],
+                    weight_block_size[0],
+                    weight_block_size[1],
+                    sparse_weight.indices.shape[0],
+                    sparse_weight.indptr.shape[0],
+                )
+                register_task_input_buffer(
+                    "default",
+                    prefix + "W_data",
+                    tvm.runtime.ndarray.array(sparse_weight.data),
+                    overwrite=True,
+                )
+                register_task_input_buffer(
+                    "default",
+                    prefix + "W_indices",
+                    tvm.runtime.ndarray.array(sparse_weight.indices),
+                    overwrite=True,
+                )
+                register_task_input_buffer(
+                    "default",
+                    prefix + "W_indptr",
+                    tvm.runtime.ndarray.array(sparse_weight.indptr),
+                    overwrite=True,
+                )
     ret = SparseAnalysisResult(
         weight_name=tvm.runtime.convert(memo.weight_name),
         weight_shape=tvm.runtime.convert(memo.weight_shape),
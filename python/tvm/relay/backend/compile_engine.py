@@ -191,6 +191,19 @@ def select_implementation(op, attrs, inputs, out_type, target, use_autotvm=True)
     all_impls = get_valid_implementations(op, attrs, inputs, out_type, target)
     best_plevel_impl = max(all_impls, key=lambda x: x.plevel)
 
+    # When the compile engine lowers extra kernel variants for online
+    # selection, it asks for the k-th candidate by priority instead of the
+    # best one. Wrap around so every variant index yields an implementation.
+    variant_index = PassContext.current().config.get("relay.backend.kernel_variant_index", None)
+    if variant_index is not None:
+        impls = sorted(all_impls, key=lambda x: -x.plevel)
+        impl = impls[int(variant_index) % len(impls)]
+        logger.info(
+            "Using %s for %s as kernel variant %d", impl.name, op.name, int(variant_index)
+        )
+        outs = impl.compute(attrs, inputs, out_type)
+        return impl, outs
+
     # Disable autotvm if auto_scheduler is enabled.
     # (i.e., always return the implementation with the highest priority for auto-scheduler).
     if PassContext.current().config.get("relay.backend.use_auto_scheduler", False):
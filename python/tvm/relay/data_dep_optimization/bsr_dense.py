@@ -32,8 +32,10 @@ def convert(func, params, blocksize, sparsity_threshold):
         Expr will be optimized to sparse operation
     params : Dict[Srting, tvm.nd.array]
         Parameters of the Expr
-    blocksize : Tuple(int, int)
-        Blocksize for BSR matrix
+    blocksize : Tuple(int, int) or None
+        Blocksize for BSR matrix, with (1, 1) meaning CSR. None picks the
+        cheapest format per weight from its sparsity pattern, mixing CSR and
+        several BSR block sizes within one model.
     sparsity_threshold : float
         Minimal sparsity requirement for converting.
         If weight sparsity is lower than this threshold,
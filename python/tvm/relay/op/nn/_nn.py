@@ -47,6 +47,11 @@ reg.register_strategy("nn.fast_softmax", strategy.fast_softmax_strategy)
 reg.register_pattern("nn.fast_softmax", OpPattern.OPAQUE)
 
 
+# fused_attention
+reg.register_strategy("nn.fused_attention", strategy.fused_attention_strategy)
+reg.register_pattern("nn.fused_attention", OpPattern.OPAQUE)
+
+
 # log_softmax
 reg.register_schedule("nn.log_softmax", strategy.schedule_log_softmax)
 reg.register_pattern("nn.log_softmax", OpPattern.OPAQUE)
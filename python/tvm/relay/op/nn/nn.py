@@ -2121,6 +2121,40 @@ def batch_matmul(x, y, out_dtype=""):
     return _make.batch_matmul(x, y, out_dtype)
 
 
+def fused_attention(query, key, value, scale=1.0):
+    r"""
+    Computes scaled dot-product attention as one fused kernel.
+
+    .. math::
+
+        \mbox{fused_attention}(Q, K, V) = \mbox{softmax}(scale \cdot Q K^T) V
+
+    with query of shape `(b, m, d)`, key of shape `(b, n, d)`, value of
+    shape `(b, n, d_v)` and output of shape `(b, m, d_v)`.
+
+    Parameters
+    ----------
+    query : tvm.relay.Expr
+        The query matrix.
+
+    key : tvm.relay.Expr
+        The key matrix.
+
+    value : tvm.relay.Expr
+        The value matrix.
+
+    scale : float, optional
+        The scaling factor applied to the attention scores, typically
+        1/sqrt(d).
+
+    Returns
+    -------
+    result: tvm.relay.Expr
+        The computed result.
+    """
+    return _make.fused_attention(query, key, value, scale)
+
+
 # pylint: disable=no-else-return,inconsistent-return-statements
 def sparse_dense(dense_mat, sparse_mat, sparse_lhs=False):
     r"""
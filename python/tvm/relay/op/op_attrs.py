@@ -74,6 +74,11 @@ class SoftmaxAttrs(Attrs):
     """Attributes for nn.softmax"""
 
 
+@tvm._ffi.register_object("relay.attrs.AttentionAttrs")
+class AttentionAttrs(Attrs):
+    """Attributes for nn.fused_attention"""
+
+
 @tvm._ffi.register_object("relay.attrs.FIFOBufferAttrs")
 class FIFOBufferAttrs(Attrs):
     """Attributes for nn.fifo_buffer"""
@@ -89,6 +89,18 @@ def softmax_strategy_cuda(attrs, inputs, out_type, target):
     return strategy
 
 
+@fused_attention_strategy.register(["cuda", "gpu"])
+def fused_attention_strategy_cuda(attrs, inputs, out_type, target):
+    """fused_attention cuda strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.cuda.schedule_fused_attention),
+        name="fused_attention.cuda",
+    )
+    return strategy
+
+
 @schedule_log_softmax.register(["cuda", "gpu"])
 def schedule_log_softmax_cuda(attrs, outs, target):
     """scheudle log_softmax for cuda"""
@@ -181,6 +181,28 @@ def fast_softmax_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# fused_attention
+def wrap_compute_fused_attention(topi_compute):
+    """Wrap fused_attention topi compute"""
+
+    def _compute_fused_attention(attrs, inputs, out_type):
+        return [topi_compute(inputs[0], inputs[1], inputs[2], attrs.scale)]
+
+    return _compute_fused_attention
+
+
+@override_native_generic_func("fused_attention_strategy")
+def fused_attention_strategy(attrs, inputs, out_type, target):
+    """fused_attention generic strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.generic.schedule_fused_attention),
+        name="fused_attention.generic",
+    )
+    return strategy
+
+
 # log_softmax
 @generic_func
 def schedule_log_softmax(attrs, outs, target):
@@ -79,6 +79,18 @@ def softmax_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@fused_attention_strategy.register("cpu")
+def fused_attention_strategy_cpu(attrs, inputs, out_type, target):
+    """fused_attention x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.x86.schedule_fused_attention),
+        name="fused_attention.x86",
+    )
+    return strategy
+
+
 @schedule_log_softmax.register("cpu")
 def schedule_log_softmax_cpu(attrs, outs, target):
     """schedule log_softmax op for x86"""
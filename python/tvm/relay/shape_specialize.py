@@ -0,0 +1,167 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Profile-guided static specialization of dynamic-shape modules.
+
+DynToStatic can only remove dynamism the type checker can prove away.  For
+models that are dynamic in their types but mostly static in practice, the VM
+records the concrete shapes it actually sees (see
+:py:meth:`tvm.runtime.vm.VirtualMachine.get_shape_profile`).  This module turns
+such a profile into a statically-typed copy of the module plus a guarded
+executor that runs the static copy when the inputs match and falls back to the
+dynamic VM otherwise.
+"""
+import tvm
+from tvm.ir import IRModule
+
+from . import expr as _expr
+from . import transform as _transform
+from .function import Function
+
+
+def parse_shape_signature(sig):
+    """Parse a VM shape signature into a list of shape tuples.
+
+    Parameters
+    ----------
+    sig : str
+        A signature as produced by the VM shape profile, e.g. ``"_8x64_s"``.
+        Each ``_``-separated token encodes one tensor argument as its
+        ``x``-joined dimensions; ``s`` denotes a scalar.
+
+    Returns
+    -------
+    shapes : List[Tuple[int, ...]]
+        One shape tuple per argument; scalars become the empty tuple.
+    """
+    shapes = []
+    for token in sig.split("_")[1:]:
+        if token == "s":
+            shapes.append(())
+        else:
+            shapes.append(tuple(int(dim) for dim in token.split("x")))
+    return shapes
+
+
+def specialize_module(mod, input_shapes):
+    """Rebind the main function of ``mod`` to concrete input shapes.
+
+    The parameters of ``main`` are replaced by fresh variables carrying the
+    given static shapes, the body is rebound, and DynToStatic is run so shape
+    functions and dynamic ops downstream of the inputs collapse to their
+    static forms.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The (possibly dynamic) source module.
+
+    input_shapes : List[Tuple[int, ...]]
+        A static shape for each parameter of ``main``, in order.
+
+    Returns
+    -------
+    static_mod : tvm.IRModule
+        A copy of ``mod`` whose ``main`` only accepts the given shapes.
+    """
+    mod = _transform.InferType()(mod)
+    func = mod["main"]
+    if len(func.params) != len(input_shapes):
+        raise ValueError(
+            "main takes %d parameters but %d input shapes were given"
+            % (len(func.params), len(input_shapes))
+        )
+    binds = {}
+    new_params = []
+    for param, shape in zip(func.params, input_shapes):
+        ty = param.checked_type
+        if not isinstance(ty, tvm.ir.TensorType):
+            raise ValueError("cannot specialize non-tensor parameter %s" % param.name_hint)
+        new_param = _expr.var(param.name_hint, shape=shape, dtype=ty.dtype)
+        new_params.append(new_param)
+        binds[param] = new_param
+    body = _expr.bind(func.body, binds)
+    static_mod = IRModule(functions=mod.functions, type_definitions=mod.type_definitions)
+    static_mod["main"] = Function(new_params, body)
+    static_mod = _transform.InferType()(static_mod)
+    return _transform.DynamicToStatic()(static_mod)
+
+
+def specialize_from_profile(mod, profile, func_name="main"):
+    """Specialize ``mod`` to the most frequent profiled signature.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The dynamic source module.
+
+    profile : Dict[str, Dict[str, int]]
+        A shape profile as returned by
+        :py:meth:`tvm.runtime.vm.VirtualMachine.get_shape_profile`.
+
+    func_name : str
+        The profiled entry function, by default ``"main"``.
+
+    Returns
+    -------
+    static_mod, input_shapes : tvm.IRModule, List[Tuple[int, ...]]
+        The specialized module and the shapes it was specialized to.
+    """
+    if func_name not in profile:
+        raise ValueError("no shape profile recorded for function %s" % func_name)
+    sig = max(profile[func_name].items(), key=lambda kv: kv[1])[0]
+    input_shapes = parse_shape_signature(sig)
+    return specialize_module(mod, input_shapes), input_shapes
+
+
+class ShapeGuardedVirtualMachine:
+    """Guarded dispatch between a shape-specialized and a dynamic VM.
+
+    Calls whose tensor arguments match ``input_shapes`` exactly run on the
+    specialized VM; everything else falls back to the dynamic one, so the
+    guard is safe even when the profile missed a shape.
+
+    Parameters
+    ----------
+    specialized_vm : tvm.runtime.vm.VirtualMachine
+        A VM built from the output of :py:func:`specialize_module`.
+
+    dynamic_vm : tvm.runtime.vm.VirtualMachine
+        A VM built from the original dynamic module.
+
+    input_shapes : List[Tuple[int, ...]]
+        The shapes the specialized VM was built for.
+    """
+
+    def __init__(self, specialized_vm, dynamic_vm, input_shapes):
+        self._specialized = specialized_vm
+        self._dynamic = dynamic_vm
+        self._input_shapes = [tuple(shape) for shape in input_shapes]
+
+    def _matches(self, args):
+        if len(args) != len(self._input_shapes):
+            return False
+        for arg, shape in zip(args, self._input_shapes):
+            if not hasattr(arg, "shape") or tuple(arg.shape) != shape:
+                return False
+        return True
+
+    def run(self, *args, **kwargs):
+        """Run the entry function, dispatching on the argument shapes."""
+        if not kwargs and self._matches(args):
+            return self._specialized.run(*args)
+        return self._dynamic.run(*args, **kwargs)
@@ -0,0 +1,135 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Automatic, target-aware layout selection built on top of ConvertLayout."""
+import tvm
+from tvm import relay
+
+from . import transform as _transform
+
+# Candidate (data layout, kernel layout) pairs per anchor operator. Every
+# candidate assignment applies one column of this table globally; the
+# non-anchor operators adapt through the InferCorrectLayout infrastructure.
+_ANCHOR_CANDIDATES = {
+    "nn.conv2d": [("NCHW", "OIHW"), ("NHWC", "HWIO")],
+    "nn.conv2d_transpose": [("NCHW", "OIHW"), ("NHWC", "HWIO")],
+    "qnn.conv2d": [("NCHW", "OIHW"), ("NHWC", "HWIO")],
+}
+
+# Preferred anchor data layout per target kind. The schedules for CUDA
+# tensor cores and most NPU-ish targets want NHWC for fp16, while the
+# x86 and default CUDA schedules are written for NCHW (x86 later derives
+# NCHWc from NCHW in AlterOpLayout).
+_PREFERRED_LAYOUT = {
+    "cuda": {"float16": "NHWC", "default": "NCHW"},
+    "rocm": {"float16": "NHWC", "default": "NCHW"},
+    "llvm": {"default": "NCHW"},
+    "c": {"default": "NCHW"},
+    "default": {"default": "NCHW"},
+}
+
+# A convolution running in a layout its schedules were not written for is
+# charged this many times its output bytes; a layout_transform is charged
+# its output bytes once. The ratio only has to reflect that transposing a
+# tensor is much cheaper than running the anchor op badly.
+_MISMATCH_PENALTY = 8
+
+
+def _tensor_bytes(ttype):
+    """Size of a tensor type in bytes; dynamic dimensions count as one."""
+    if not isinstance(ttype, tvm.ir.TensorType):
+        return 0
+    bits = tvm.runtime.DataType(ttype.dtype).bits
+    size = (bits + 7) // 8
+    for dim in ttype.shape:
+        if isinstance(dim, tvm.tir.IntImm):
+            size *= dim.value
+    return size
+
+
+def _preferred_layout(target, dtype):
+    kinds = _PREFERRED_LAYOUT.get(target.kind.name, _PREFERRED_LAYOUT["default"])
+    return kinds.get(dtype, kinds["default"])
+
+
+def _estimate_cost(mod, target):
+    """Layout-transition bytes plus mismatch penalties for anchor ops."""
+    cost = [0]
+
+    def fvisit(expr):
+        if not isinstance(expr, relay.Call) or not isinstance(expr.op, tvm.ir.Op):
+            return
+        if expr.op.name == "layout_transform":
+            cost[0] += _tensor_bytes(expr.checked_type)
+        elif expr.op.name in _ANCHOR_CANDIDATES:
+            out_type = expr.checked_type
+            layout = expr.attrs.data_layout
+            dtype = out_type.dtype if isinstance(out_type, tvm.ir.TensorType) else "default"
+            if layout != _preferred_layout(target, dtype):
+                cost[0] += _MISMATCH_PENALTY * _tensor_bytes(out_type)
+
+    relay.analysis.post_order_visit(mod["main"], fvisit)
+    return cost[0]
+
+
+def AutoLayout(target=None):
+    """Pick the layouts of anchor ops automatically for the given target.
+
+    Each global layout assignment from the candidate table is applied with
+    ConvertLayout and scored by the bytes moved through the inserted
+    layout_transform ops plus a penalty for every anchor op left in a
+    layout its target schedules are not written for; the cheapest module
+    wins. Leaving the module unchanged is always one of the candidates, so
+    the pass never makes a model strictly worse under its own cost model.
+
+    Parameters
+    ----------
+    target : str or tvm.target.Target, optional
+        The compilation target the layouts are chosen for. Defaults to the
+        current target context, or "llvm".
+
+    Returns
+    -------
+    pass : tvm.transform.Pass
+        The registered module pass.
+    """
+
+    @tvm.transform.module_pass(opt_level=3, name="AutoLayout")
+    def _auto_layout(mod, _ctx):
+        tgt = target
+        if tgt is None:
+            tgt = tvm.target.Target.current() or "llvm"
+        tgt = tvm.target.Target(tgt)
+
+        seq = tvm.transform.Sequential([_transform.InferType()])
+        best_mod = seq(mod)
+        best_cost = _estimate_cost(best_mod, tgt)
+        num_candidates = max(len(v) for v in _ANCHOR_CANDIDATES.values())
+        for i in range(num_candidates):
+            desired = {op: list(layouts[i]) for op, layouts in _ANCHOR_CANDIDATES.items()}
+            seq = tvm.transform.Sequential(
+                [_transform.ConvertLayout(desired), _transform.InferType()]
+            )
+            with tvm.transform.PassContext(opt_level=3):
+                candidate = seq(mod)
+            cost = _estimate_cost(candidate, tgt)
+            if cost < best_cost:
+                best_mod = candidate
+                best_cost = cost
+        return best_mod
+
+    return _auto_layout
@@ -196,6 +196,29 @@ def FastMath():
     return _ffi_api.FastMath()
 
 
+def ToMixedPrecision(mixed_dtype="float16"):
+    """Automatically convert fp32 computation to a reduced-precision dtype.
+
+    Compute-bound ops (conv, dense, batch_matmul) always convert and accumulate
+    in fp32, elementwise ops follow the precision of their inputs, and
+    numerically sensitive ops stay in fp32 islands with casts inserted around
+    them. Function signatures are preserved. Ops listed in the
+    relay.ToMixedPrecision.skip_ops pass config are forced to stay fp32, which
+    is the knob a calibration loop flips when a model loses accuracy.
+
+    Parameters
+    ----------
+    mixed_dtype : str
+        The reduced-precision data type, "float16" by default.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass to convert to mixed precision.
+    """
+    return _ffi_api.ToMixedPrecision(mixed_dtype)
+
+
 def CanonicalizeOps():
     """Canonicalize special operators to basic operators.
     This can simplify followed analysis, e.g. expanding bias_add to
@@ -240,6 +263,30 @@ def LazyGradientInit():
     return _ffi_api.LazyGradientInit()
 
 
+def AutoCheckpoint(max_segment_bytes=1 << 26):
+    """Automatically insert gradient checkpoint annotations.
+
+    Walks the dataflow accumulating activation bytes and wraps the output of
+    an expensive op (reduction or fusion root) in annotation.checkpoint each
+    time the running total exceeds the budget. The higher-order gradient pass
+    then re-executes those segments during the backward pass instead of
+    retaining their intermediate activations. Checkpoints already placed by
+    the user are kept and reset the accumulation.
+
+    Parameters
+    ----------
+    max_segment_bytes : int
+        Activation budget per recompute segment, in bytes. Smaller budgets
+        checkpoint more often: less memory retained, more recompute.
+
+    Returns
+    -------
+    ret: tvm.transform.Pass
+        The registered pass that inserts checkpoint annotations.
+    """
+    return _ffi_api.AutoCheckpoint(max_segment_bytes)
+
+
 def FoldConstantExpr(expr, mod):
     """Fold the constant expressions in a Relay program.
     Parameters
@@ -297,6 +344,24 @@ def DefuseOps():
     return _ffi_api.DefuseOps()
 
 
+def BatchSmallOps():
+    """Group independent small fused kernels into one batched dispatch.
+
+    Runs after FuseOps and collects mutually independent primitive calls with
+    small, statically known outputs into a single primitive function returning
+    a tuple, so the whole group becomes one kernel launch. The pass is a no-op
+    unless the pass context sets relay.BatchSmallOps.max_output_size to a
+    positive number of elements; relay.BatchSmallOps.max_batch_size bounds the
+    group size (default 64).
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass for batching small kernels.
+    """
+    return _ffi_api.BatchSmallOps()
+
+
 def CombineParallelConv2D(min_num_branches=3):
     """Combine multiple conv2d operators into one.
 
@@ -326,14 +391,6 @@ def CombineParallelDense(min_num_branches=3, to_batch=True):
 
     Would become:
 
-    .. code-block
-
-                data
-                |
-            batch_matmul+elemwise/bcast (2,2,2)
-
-    or (if to_batch=False)
-
     .. code-block
 
                 data
@@ -347,8 +404,10 @@ def CombineParallelDense(min_num_branches=3, to_batch=True):
         optimization.
 
     to_batch_matmul : bool
-        If True, combine parallel dense ops into batch_matmul op.
-        If False, combine parallel dense ops into dense op.
+        If True, combine parallel dense ops into one dense op whenever the
+        shapes are static enough for that (the output dims of the branches
+        may differ), and into batch_matmul otherwise.
+        If False, only combine parallel dense ops into dense op.
 
     Returns
     -------
@@ -1146,6 +1205,19 @@ def SimplifyExpr():
     return _ffi_api.SimplifyExpr()
 
 
+def FuseAttention():
+    """
+    Rewrite the unfused attention idiom (batch_matmul -> scale -> softmax ->
+    batch_matmul of the transposed values) to nn.fused_attention.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered FuseAttention pass.
+    """
+    return _ffi_api.FuseAttention()
+
+
 def FoldExplicitPadding():
     """
     FoldExplicitPadding finds explict padding before an op that can support
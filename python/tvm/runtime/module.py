@@ -31,7 +31,9 @@ from . import _ffi_api
 
 
 # profile result of time evaluator
-ProfileResult = namedtuple("ProfileResult", ["mean", "results"])
+ProfileResult = namedtuple("ProfileResult", ["mean", "results", "hw_counters"])
+# keep ProfileResult(mean=..., results=...) working for existing callers
+ProfileResult.__new__.__defaults__ = (None,)
 
 
 class Module(object):
@@ -169,7 +171,31 @@ class Module(object):
         """
         _ffi_api.ModuleSaveToFile(self, file_name, fmt)
 
-    def time_evaluator(self, func_name, dev, number=10, repeat=1, min_repeat_ms=0, f_preproc=""):
+    def warm_up(self, device_id=0):
+        """Eagerly perform the lazy device setup of this module and its imports.
+
+        Device modules normally defer expensive setup (e.g. cuModuleLoad of
+        the embedded binary) to the first kernel launch. Calling this from a
+        background thread after loading hides that latency from the first
+        inference. Modules without a warm-up hook are skipped.
+
+        Parameters
+        ----------
+        device_id : int, optional
+            The device to warm up.
+        """
+        _ffi_api.ModuleWarmUp(self, device_id)
+
+    def time_evaluator(
+        self,
+        func_name,
+        dev,
+        number=10,
+        repeat=1,
+        min_repeat_ms=0,
+        f_preproc="",
+        collect_hw_counters=False,
+    ):
         """Get an evaluator that measures time cost of running function.
 
         Parameters
@@ -201,6 +227,14 @@ class Module(object):
         f_preproc: str, optional
             The preprocess function name we want to execute before executing the time evaluator.
 
+        collect_hw_counters: bool, optional
+            Whether to also collect hardware performance counters (instructions,
+            cycles, cache references and cache misses) for each `repeat` via
+            perf_event. The counters cover the thread calling the function and
+            are reported as per-invocation averages, like the time. Only
+            supported on Linux; zeros are reported when perf_event is
+            unavailable.
+
         Note
         ----
         The function will be invoked  (1 + number x repeat) times,
@@ -222,6 +256,7 @@ class Module(object):
                 repeat,
                 min_repeat_ms,
                 f_preproc,
+                collect_hw_counters,
             )
 
             def evaluator(*args):
@@ -229,9 +264,20 @@ class Module(object):
                 # Wrap feval so we can add more stats in future.
                 blob = feval(*args)
                 fmt = "@" + ("d" * repeat)
-                results = struct.unpack(fmt, blob)
+                tsize = struct.calcsize(fmt)
+                results = struct.unpack(fmt, blob[:tsize])
                 mean = sum(results) / float(repeat)
-                return ProfileResult(mean=mean, results=results)
+                hw_counters = None
+                if collect_hw_counters:
+                    names = ("instructions", "cycles", "cache_references", "cache_misses")
+                    raw = struct.unpack("@" + "Q" * (len(names) * repeat), blob[tsize:])
+                    hw_counters = []
+                    for i in range(repeat):
+                        counters = dict(zip(names, raw[i * len(names) : (i + 1) * len(names)]))
+                        cycles = counters["cycles"]
+                        counters["ipc"] = counters["instructions"] / cycles if cycles else 0.0
+                        hw_counters.append(counters)
+                return ProfileResult(mean=mean, results=results, hw_counters=hw_counters)
 
             return evaluator
         except NameError:
@@ -477,6 +523,36 @@ def load_module(path, fmt=""):
     return _ffi_api.ModuleLoadFromFile(path, fmt)
 
 
+def load_modules(paths, fmt=""):
+    """Load several module files concurrently.
+
+    The module blobs are deserialized on multiple threads, so loading many
+    model libraries at startup scales with the number of cores. Unlike
+    :py:func:`load_module` this does not invoke the C++ compiler for ``.o``
+    or ``.tar`` inputs; the paths must point to loadable libraries.
+
+    Parameters
+    ----------
+    paths : list of str
+        The paths to the module files.
+
+    fmt : str, optional
+        The format of the files, if not specified
+        it will be inferred from the suffix of each file.
+
+    Returns
+    -------
+    modules : list of runtime.Module
+        The loaded modules, in the order of `paths`.
+    """
+    real_paths = []
+    for path in paths:
+        if not os.path.isfile(path):
+            raise ValueError("cannot find file %s" % path)
+        real_paths.append(os.path.realpath(path))
+    return list(_ffi_api.ModuleLoadFromFiles(real_paths, fmt))
+
+
 def enabled(target):
     """Whether module runtime is enabled for target
 
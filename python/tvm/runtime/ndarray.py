@@ -388,6 +388,25 @@ def cuda(dev_id=0):
     return Device(2, dev_id)
 
 
+def cuda_host(dev_id=0):
+    """Construct a pinned CUDA host device.
+
+    Arrays created on this device live in page-locked host memory, so
+    copies between them and a CUDA device run at full transfer speed.
+
+    Parameters
+    ----------
+    dev_id : int, optional
+        The integer device id
+
+    Returns
+    -------
+    dev : Device
+        The created device
+    """
+    return Device(3, dev_id)
+
+
 def gpu(dev_id=0):
     """Construct a CUDA GPU device
 
@@ -346,6 +346,10 @@ class VirtualMachine(object):
         self._get_output = self.module["get_output"]
         self._get_num_outputs = self.module["get_num_outputs"]
         self._set_input = self.module["set_input"]
+        self._set_reserve_storage = self.module["set_reserve_storage"]
+        self._release_storage_reservations = self.module["release_storage_reservations"]
+        self._get_shape_profile = self.module["get_shape_profile"]
+        self._warmup = self.module["warmup"]
         self._setup_device(device, memory_cfg)
 
     def _setup_device(self, dev, memory_cfg):
@@ -442,6 +446,63 @@ class VirtualMachine(object):
             self.set_input(func_name, *args, **kwargs)
         return self._invoke(func_name)
 
+    def warmup(self, func_name="main"):
+        """Prefault an entry function ahead of its first invocation.
+
+        Loaded executables decode a function's bytecode and bind its kernels
+        only when they are first needed. Warming an entry up moves that cost
+        out of the first call: its reachable functions are deserialized and
+        every kernel they can invoke is resolved from the library.
+
+        Parameters
+        ----------
+        func_name : str, optional
+            The name of the entry function to warm up.
+        """
+        self._warmup(func_name)
+
+    def reserve_storage(self, enable=True):
+        """Enable or disable storage reservations for dynamic shapes.
+
+        When enabled, the buffers produced by AllocStorage instructions are
+        kept across invocations and reused whenever they are large enough.
+        Invoking once with maximum (envelope) shapes sizes every reservation,
+        after which calls with smaller shapes perform no storage allocation.
+
+        Reuse overwrites the reserved buffers, so this is only valid when the
+        results of one invocation are consumed before the next one starts.
+        Disabling also drops the existing reservations.
+
+        Parameters
+        ----------
+        enable : bool, optional
+            Whether to reserve storage across invocations.
+        """
+        self._set_reserve_storage(enable)
+
+    def release_storage_reservations(self):
+        """Drop storage reservations kept by :py:meth:`reserve_storage`."""
+        self._release_storage_reservations()
+
+    def get_shape_profile(self):
+        """Return the shape signatures observed at entry-function invocations.
+
+        Every invocation records the concrete shapes of its tensor arguments.
+        The profile drives profile-guided static specialization, see
+        :py:mod:`tvm.relay.shape_specialize`.
+
+        Returns
+        -------
+        profile : Dict[str, Dict[str, int]]
+            Maps function name to a dict from shape signature (the per-argument
+            "_d0xd1"-style encoding) to the number of times it was observed.
+        """
+        profile = {}
+        for line in self._get_shape_profile().splitlines():
+            name, sig, count = line.split(" ")
+            profile.setdefault(name, {})[sig] = int(count)
+        return profile
+
     def run(self, *args, **kwargs):
         """Run the main function.
 
@@ -141,6 +141,37 @@ class Schedule(Object):
         readers = [t.op if isinstance(t, _tensor.Tensor) else t for t in readers]
         return _ffi_api.ScheduleCacheRead(self, tensor, scope, readers)
 
+    def pack(self, tensor, block_factors, scope, readers):
+        """Create a packed copy of tensor in a cache-blocked layout.
+
+        Dimension i of the tensor is blocked by block_factors[i]: the packed
+        tensor carries all block indices as outer dimensions followed by all
+        intra-block offsets, so one block is contiguous in memory. This will
+        mutate the body of the readers to load from the blocked layout.
+        A new stage computing the packed tensor will be created.
+        Call this before doing any split/fuse schedule.
+
+        Parameters
+        ----------
+        tensor : Tensor
+            The tensor to be packed.
+        block_factors : list of int
+            The block size of each dimension, one entry per dimension.
+        scope : str
+            The scope of the packed tensor.
+        readers : list of Tensor or Operation
+            The readers to redirect to the packed tensor.
+
+        Returns
+        -------
+        packed : Tensor
+            The created packed tensor.
+        """
+        if isinstance(readers, (_tensor.Tensor, _tensor.Operation)):
+            readers = [readers]
+        readers = [t.op if isinstance(t, _tensor.Tensor) else t for t in readers]
+        return _ffi_api.SchedulePack(self, tensor, block_factors, scope, readers)
+
     def cache_write(self, tensor, scope):
         """Create a cache write of original tensor, before storing into tensor.
 
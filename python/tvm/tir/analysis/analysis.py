@@ -168,3 +168,26 @@ def detect_buffer_access_lca(func: PrimFunc) -> Dict[Buffer, Stmt]:
         Map from buffer to the LCA of all access to it.
     """
     return _ffi_api.detect_buffer_access_lca(func)  # pylint: disable=no-member
+
+
+def estimate_unroll_cost(loop):
+    """Estimate what unrolling a loop costs.
+
+    The estimate is the same model the UnrollLoop pass applies against the
+    ``tir.UnrollLoop`` ``auto_max_body_size`` and ``auto_max_live_values``
+    budgets, so schedule search can weigh candidate unroll factors instead
+    of enumerating pragma values blindly.
+
+    Parameters
+    ----------
+    loop : tvm.tir.For
+        The loop to be estimated.
+
+    Returns
+    -------
+    result : Dict[str, int]
+        body_size and live_values of one iteration, the constant extent
+        (-1 when symbolic), and when the extent is constant the
+        expanded_size and expanded_live_values after full unrolling.
+    """
+    return _ffi_api.estimate_unroll_cost(loop)
@@ -1093,6 +1093,34 @@ def q_multiply_shift(x, y, q, s):
     return call_intrin("int32", "tir.q_multiply_shift", x, y, q, s)
 
 
+def dp4a(vec1, vec2, acc):
+    """Four-element dot product with accumulation. Each lane of the
+    result accumulates the dot product of the corresponding group of
+    four 8-bit elements:
+
+       out[i] = acc[i] + sum(vec1[i*4+j] * vec2[i*4+j] for j in range(4))
+
+    Targets with a native int8 dot-product instruction (dp4a on CUDA,
+    AVX-512 VNNI on x86) lower this directly; others expand it into a
+    widened multiply-accumulate.
+
+    Parameters
+    ----------
+    vec1 : PrimExpr
+        First int8/uint8 vector, with four lanes per accumulator lane.
+    vec2 : PrimExpr
+        Second int8/uint8 vector, with four lanes per accumulator lane.
+    acc : PrimExpr
+        The int32 accumulator.
+
+    Returns
+    -------
+    y : PrimExpr
+        The result.
+    """
+    return call_intrin(acc.dtype, "tir.dp4a", vec1, vec2, acc)
+
+
 def fmod(x, y):
     """Return the remainder of x divided by y with the same sign as x.
 
@@ -73,6 +73,19 @@ def InjectPrefetch():
     return _ffi_api.InjectPrefetch()
 
 
+def AutoInjectPrefetch():
+    """Automatically prefetch streaming loads detected from their strides.
+
+    Controlled by the tir.AutoPrefetch pass config, disabled by default.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.AutoInjectPrefetch()
+
+
 def StorageFlatten(cache_line_size, create_bound_attribute=False):
     """Flatten the multi-dimensional read/write to 1D.
 
@@ -190,6 +203,17 @@ def InjectDoubleBuffer():
     return _ffi_api.InjectDoubleBuffer()
 
 
+def InjectSoftwarePipeline():
+    """Inject software pipelined producers for annotated buffers.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectSoftwarePipeline()
+
+
 def StorageRewrite():
     """Rewrite storage allocation pattern.
 
@@ -218,6 +242,21 @@ def UnrollLoop():
     return _ffi_api.UnrollLoop()
 
 
+def FlattenParallelLoops():
+    """Flatten perfectly nested serial loops into their parallel parent.
+
+    A parallel loop whose body is a perfect nest of constant-bound serial
+    loops is collapsed into a single parallel loop over the product extent,
+    with the original indices reconstructed by div/mod.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.FlattenParallelLoops()
+
+
 def RemoveNoOp():
     """Remove No Op from the Stmt.
 
@@ -229,6 +268,32 @@ def RemoveNoOp():
     return _ffi_api.RemoveNoOp()
 
 
+def CommonSubexprElim():
+    """Hoist repeated scalar subexpressions in loop bodies into let bindings.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.CommonSubexprElim()
+
+
+def HoistLoopInvariants():
+    """Hoist loop-invariant scalar computations out of the loops.
+
+    Maximal load-free subexpressions of a loop body that reference no
+    variable defined inside the loop are bound above it; invariant leading
+    let bindings migrate up the nest the same way.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.HoistLoopInvariants()
+
+
 def BF16Legalize():
     """Legalize bf16 typed Ops.
     Runs BF16Promote, BF16CastElimination and BF16TypeLowering
@@ -317,6 +382,22 @@ def InstrumentBoundCheckers():
     return _ffi_api.InstrumentBoundCheckers()
 
 
+def InstrumentProfileStages():
+    """Wrap loop nests marked with a "profile_stage" pragma with stage
+    profiling calls (TVMBackendProfileStageBegin/End).
+
+    Enabled in the lowering pipeline via the pass config
+    ``tir.instrument_profile_stages``; query the accumulated per-stage
+    totals with ``tvm.get_global_func("runtime.profiling.StageSummary")``.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InstrumentProfileStages()
+
+
 def LowerCustomDatatypes():
     """Lower custom datatypes.
 
@@ -347,6 +428,22 @@ def MakePackedAPI(num_unpacked_params=0):
     return _ffi_api.MakePackedAPI(num_unpacked_params)
 
 
+def MakeUnpackedAPI():
+    """Transform the PrimFuncs in the module to a C API compatible with internal calls.
+
+    Each buffer argument is replaced by the raw pointer to its data, without
+    any of the packed-function marshalling or runtime type checking. This is
+    used by the AOT executor in direct-call mode, where the caller and the
+    callee are compiled together.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.MakeUnpackedAPI()
+
+
 def SplitHostDevice():
     """Split the function into a host function and device functions.
 
@@ -497,6 +594,31 @@ def NarrowDataType(target_bits):
     return _ffi_api.NarrowDataType(target_bits)
 
 
+def GuardedNarrowDataType(target_bits):
+    """Narrow indexing datatypes without provable bounds behind a runtime guard.
+
+    A fast-path copy of the body with indices narrowed to target_bits is
+    guarded by a check that every buffer's element count fits into the
+    target type; oversized shapes fall back to the original wide-index body.
+
+    Parameters
+    ----------
+    target_bits : int
+        The target bit configuration.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+
+    Note
+    ----
+    Run this pass after StorageFlatten, on functions that still carry
+    their buffer map.
+    """
+    return _ffi_api.GuardedNarrowDataType(target_bits)
+
+
 def VerifyMemory():
     """Verify if func contains illegal host side direct memory access.
 
@@ -47,6 +47,7 @@ from .einsum import *
 from .unique import *
 from . import generic
 from . import nn
+from . import micro_kernel
 from . import x86
 from . import cuda
 from . import arm_cpu
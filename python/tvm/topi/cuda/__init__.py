@@ -40,6 +40,7 @@ from .dense import *
 from .pooling import *
 from .nn import schedule_lrn
 from .batch_matmul import *
+from .attention import *
 from .batch_matmul_tensorcore import *
 from .vision import *
 from .ssd import *
@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, unused-variable
+"""Schedule for fused attention operator"""
+from tvm import te
+
+
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention op.
+
+    One thread block handles one query row: its score and probability rows
+    live in shared memory and the softmax reductions are cross-thread tree
+    reductions, so nothing round-trips through global memory between the two
+    matrix products. The row length is bounded by shared memory; the online
+    softmax recurrence that would lift that bound is not expressible as a
+    te.compute reduction.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention in the format
+          of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+    output = outs[0]
+
+    context = output.op.input_tensors[0]
+    expsum = output.op.input_tensors[1]
+    exp = context.op.input_tensors[0]
+    scaled = exp.op.input_tensors[0]
+    max_elem = exp.op.input_tensors[1]
+    scores = scaled.op.input_tensors[0]
+
+    num_thread = 64
+    block_x = te.thread_axis("blockIdx.x")
+    thread_x = te.thread_axis((0, num_thread), "threadIdx.x")
+
+    # (5) normalize: one block per (batch, query row), threads tile the
+    # value columns
+    b, i, j = s[output].op.axis
+    bi = s[output].fuse(b, i)
+    jo, ji = s[output].split(j, nparts=num_thread)
+    s[output].bind(bi, block_x)
+    s[output].bind(jo, thread_x)
+
+    # (4) context: each thread contracts the value columns it normalizes
+    s[context].compute_at(s[output], jo)
+
+    # (3) expsum: cross-thread tree reduction
+    k = expsum.op.reduce_axis[0]
+    ko, _ = s[expsum].split(k, nparts=num_thread)
+    s[expsum].bind(ko, thread_x)
+    s[expsum].compute_at(s[output], bi)
+
+    # (2) exp: the probability row stays in shared memory
+    s[exp].set_scope("shared")
+    xo, _ = s[exp].split(exp.op.axis[2], nparts=num_thread)
+    s[exp].bind(xo, thread_x)
+    s[exp].compute_at(s[output], bi)
+
+    s[scaled].compute_inline()
+
+    # (1) max_elem: cross-thread tree reduction over the scaled scores
+    k = max_elem.op.reduce_axis[0]
+    ko, _ = s[max_elem].split(k, nparts=num_thread)
+    s[max_elem].bind(ko, thread_x)
+    s[max_elem].compute_at(s[output], bi)
+
+    # (0) scores: the score row stays in shared memory as well
+    s[scores].set_scope("shared")
+    xo, _ = s[scores].split(scores.op.axis[2], nparts=num_thread)
+    s[scores].bind(xo, thread_x)
+    s[scores].compute_at(s[output], bi)
+
+    return s
@@ -172,25 +172,36 @@ def schedule_winograd_cuda(cfg, s, output, pre_computed):
     input_tile, B = s[data_pack].op.input_tensors
     pad_data = s[input_tile].op.input_tensors[0]
 
+    # Fusing the data transform into the bgemm kernel removes one kernel
+    # launch and the global round trip for data_pack, at the price of
+    # recomputing the transform once per output-channel tile. The trade pays
+    # off for small-channel layers, so let the tuner pick per workload.
+    cfg.define_knob("fuse_data_pack", [0, 1])
+    fuse_data_pack = cfg["fuse_data_pack"].val
+
     # data transform
     s[B].compute_inline()
 
-    data_l = s.cache_write(data_pack, "local")
-    eps, nu, c, p = s[data_l].op.axis
-    r_a, r_b = s[data_l].op.reduce_axis
-    for axis in [eps, nu, r_a, r_b]:
-        s[data_l].unroll(axis)
-
-    eps, nu, c, p = s[data_pack].op.axis
-    p, pi = s[data_pack].split(p, 1)
-    fused = s[data_pack].fuse(c, p)
-    bb, tt = s[data_pack].split(fused, 128)
-    s[data_pack].reorder(bb, tt, pi, eps, nu)
-    s[data_pack].bind(bb, te.thread_axis("blockIdx.x"))
-    s[data_pack].bind(tt, te.thread_axis("threadIdx.x"))
-
-    s[data_l].compute_at(s[data_pack], pi)
-    s[input_tile].compute_at(s[data_pack], pi)
+    if fuse_data_pack:
+        # data_pack is staged in shared memory inside the bgemm kernel below
+        s[input_tile].compute_inline()
+    else:
+        data_l = s.cache_write(data_pack, "local")
+        eps, nu, c, p = s[data_l].op.axis
+        r_a, r_b = s[data_l].op.reduce_axis
+        for axis in [eps, nu, r_a, r_b]:
+            s[data_l].unroll(axis)
+
+        eps, nu, c, p = s[data_pack].op.axis
+        p, pi = s[data_pack].split(p, 1)
+        fused = s[data_pack].fuse(c, p)
+        bb, tt = s[data_pack].split(fused, 128)
+        s[data_pack].reorder(bb, tt, pi, eps, nu)
+        s[data_pack].bind(bb, te.thread_axis("blockIdx.x"))
+        s[data_pack].bind(tt, te.thread_axis("threadIdx.x"))
+
+        s[data_l].compute_at(s[data_pack], pi)
+        s[input_tile].compute_at(s[data_pack], pi)
     s[pad_data].compute_inline()
 
     # transform kernel
@@ -244,7 +255,11 @@ def schedule_winograd_cuda(cfg, s, output, pre_computed):
 
     OL = s.cache_write(C, "local")
     AA = s.cache_read(A0, "shared", [OL])
-    BB = s.cache_read(B0, "shared", [OL])
+    if fuse_data_pack:
+        s[data_pack].set_scope("shared")
+        BB = B0
+    else:
+        BB = s.cache_read(B0, "shared", [OL])
 
     b = s[bgemm].fuse(b1, b2)
 
@@ -275,7 +290,8 @@ def schedule_winograd_cuda(cfg, s, output, pre_computed):
     s[AA].compute_at(s[OL], rco)
     s[BB].compute_at(s[OL], rco)
 
-    # cooperative fetching
+    # cooperative fetching; in the fused variant each BB element is the data
+    # transform itself, computed in place rather than loaded from global
     for load in [AA, BB]:
         fused = s[load].fuse(*list(s[load].op.axis))
         fused, tx = s[load].split(fused, cfg["tile_x"].size[2])
@@ -284,6 +300,9 @@ def schedule_winograd_cuda(cfg, s, output, pre_computed):
         s[load].bind(tz, te.thread_axis("threadIdx.z"))
         s[load].bind(ty, te.thread_axis("threadIdx.y"))
         s[load].bind(tx, te.thread_axis("threadIdx.x"))
+    if fuse_data_pack:
+        for axis in s[BB].op.reduce_axis:
+            s[BB].unroll(axis)
 
     s[C].pragma(bgemm_scope, "auto_unroll_max_step", cfg["auto_unroll_max_step"].val)
     s[C].pragma(bgemm_scope, "unroll_explicit", cfg["unroll_explicit"].val)
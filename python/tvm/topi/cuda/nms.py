@@ -988,6 +988,46 @@ def _collect_selected_indices_ir(num_class, selected_indices, num_detections, ro
     return ib.get()
 
 
+def _can_use_batched_nms(max_output_boxes_per_class, iou_threshold, score_threshold):
+    """Whether the single-launch contrib bitmask NMS kernel applies.
+
+    The kernel takes its thresholds as scalars, so dynamic (tensor) thresholds
+    fall back to the TE pipeline, as does a runtime built without the kernel.
+    """
+    return (
+        isinstance(max_output_boxes_per_class, int)
+        and isinstance(iou_threshold, float)
+        and isinstance(score_threshold, float)
+        and tvm.get_global_func("tvm.contrib.cuda.batched_nms", allow_missing=True) is not None
+    )
+
+
+def _run_batched_nms(
+    boxes, sorted_scores, sorted_indices, num_class, max_out, iou_threshold, score_threshold
+):
+    """Run the whole per-row suppression, score cut included, in one kernel."""
+    batch_class, num_boxes = sorted_scores.shape
+    return te.extern(
+        [(batch_class, num_boxes), (1, batch_class)],
+        [boxes, sorted_scores, sorted_indices],
+        lambda ins, outs: tvm.tir.call_packed(
+            "tvm.contrib.cuda.batched_nms",
+            ins[0],
+            ins[1],
+            ins[2],
+            outs[0],
+            outs[1],
+            num_class,
+            max_out,
+            iou_threshold,
+            score_threshold,
+        ),
+        dtype=["int32", "int32"],
+        name="batched_nms",
+        tag="batched_nms",
+    )
+
+
 def all_class_non_max_suppression(
     boxes, scores, max_output_boxes_per_class, iou_threshold, score_threshold
 ):
@@ -1027,17 +1067,33 @@ def all_class_non_max_suppression(
 
     scores = reshape(scores, (batch * num_class, num_boxes))
     sorted_scores, sorted_indices = _dispatch_sort(scores, ret_type="both")
-    valid_count = _get_valid_box_count(sorted_scores, score_threshold)
 
-    selected_indices, num_detections = run_all_class_nms(
-        boxes,
-        sorted_scores,
-        sorted_indices,
-        valid_count,
-        max_output_boxes_per_class,
-        iou_threshold,
-        _nms_loop,
-    )
+    if _can_use_batched_nms(max_output_boxes_per_class, iou_threshold, score_threshold) and isinstance(
+        num_class, (int, tvm.tir.IntImm)
+    ):
+        # Single-launch bitmask kernel; fuses the valid-count cut, so the
+        # separate valid-count kernel and per-box device syncs disappear.
+        selected_indices, num_detections = _run_batched_nms(
+            boxes,
+            sorted_scores,
+            sorted_indices,
+            int(num_class),
+            max_output_boxes_per_class,
+            iou_threshold,
+            score_threshold,
+        )
+    else:
+        valid_count = _get_valid_box_count(sorted_scores, score_threshold)
+
+        selected_indices, num_detections = run_all_class_nms(
+            boxes,
+            sorted_scores,
+            sorted_indices,
+            valid_count,
+            max_output_boxes_per_class,
+            iou_threshold,
+            _nms_loop,
+        )
 
     row_offsets, num_total_detections = exclusive_scan(
         num_detections, return_reduction=True, output_dtype="int64"
@@ -178,6 +178,114 @@ def exclusive_scan_ir(data, output, reduction=None, binop=tvm.tir.generic.add, i
     return ib.get()
 
 
+def exclusive_scan_blocked_ir(
+    data, output, reduction=None, binop=tvm.tir.generic.add, identity_value=0
+):
+    """Low level IR for a blocked exclusive scan along rows of 2D input.
+
+    A classic reduce-then-scan formulation in three kernels regardless of the
+    scan length: every thread serially scans one contiguous chunk of its row
+    and records the chunk total, one thread per row scans the chunk totals,
+    and a final elementwise kernel folds the chunk offsets in. Compared to the
+    upsweep/downsweep formulation in exclusive_scan_ir this touches the data
+    three times instead of O(log n) times and needs three kernel launches
+    instead of 2 * ceil_log2(n).
+
+    A fully single-pass decoupled-lookback scan would additionally need each
+    block to spin on the status flags of its predecessors; TIR has no volatile
+    or acquire loads, so the CUDA backend may legally cache the flag read and
+    deadlock the wait loop. Hence the chunk totals go through a separate
+    kernel instead.
+
+    Parameters are the same as for exclusive_scan_ir.
+    """
+    num_chunks = 1024
+
+    batch_size = prod(data.shape[:-1])
+    scan_axis_size = data.shape[-1]
+
+    ib = tvm.tir.ir_builder.create()
+
+    data = ib.buffer_ptr(data)
+    output = ib.buffer_ptr(output)
+
+    out_dtype = output.dtype
+
+    if reduction is not None:
+        reduction = ib.buffer_ptr(reduction)
+
+    max_threads = int(tvm.target.Target.current(allow_none=False).max_num_threads)
+
+    with ib.if_scope(scan_axis_size == 0):
+        with ib.new_scope():
+            bx = te.thread_axis("blockIdx.x")
+            ib.scope_attr(bx, "thread_extent", batch_size)
+            with ib.if_scope(bx < batch_size):
+                if reduction is not None:
+                    reduction[bx] = cast(identity_value, out_dtype)
+    with ib.else_scope():
+        chunk_len = ceil_div(scan_axis_size, num_chunks)
+        sums = ib.allocate(out_dtype, (batch_size * num_chunks,), name="chunk_sums", scope="global")
+
+        # (1) each thread serially scans one chunk and records its total
+        with ib.new_scope():
+            nthread_tx = max_threads
+            nthread_bx = ceil_div(num_chunks, max_threads)
+            tx = te.thread_axis("threadIdx.x")
+            bx = te.thread_axis("blockIdx.x")
+            by = te.thread_axis("blockIdx.y")
+            ib.scope_attr(tx, "thread_extent", nthread_tx)
+            ib.scope_attr(bx, "thread_extent", nthread_bx)
+            ib.scope_attr(by, "thread_extent", batch_size)
+            tid = bx * nthread_tx + tx
+            with ib.if_scope(tid < num_chunks):
+                start = ib.allocate("int64", (1,), name="start", scope="local")
+                end = ib.allocate("int64", (1,), name="end", scope="local")
+                running = ib.allocate(out_dtype, (1,), name="running", scope="local")
+                start[0] = cast(tid, "int64") * cast(chunk_len, "int64")
+                end[0] = tvm.te.min(start[0] + cast(chunk_len, "int64"), cast(scan_axis_size, "int64"))
+                running[0] = cast(identity_value, out_dtype)
+                with ib.for_range(0, end[0] - start[0], dtype="int64") as i:
+                    k = start[0] + i
+                    output[by * scan_axis_size + k] = running[0]
+                    running[0] = binop(running[0], cast(data[by * scan_axis_size + k], out_dtype))
+                sums[by * num_chunks + tid] = running[0]
+
+        # (2) one thread per row turns the chunk totals into running offsets
+        with ib.new_scope():
+            bx = te.thread_axis("blockIdx.x")
+            ib.scope_attr(bx, "thread_extent", batch_size)
+            with ib.if_scope(bx < batch_size):
+                running = ib.allocate(out_dtype, (1,), name="running", scope="local")
+                tmp = ib.allocate(out_dtype, (1,), name="tmp", scope="local")
+                running[0] = cast(identity_value, out_dtype)
+                with ib.for_range(0, num_chunks) as c:
+                    tmp[0] = sums[bx * num_chunks + c]
+                    sums[bx * num_chunks + c] = running[0]
+                    running[0] = binop(running[0], tmp[0])
+                if reduction is not None:
+                    reduction[bx] = running[0]
+
+        # (3) fold the chunk offsets into the per-chunk scans
+        with ib.new_scope():
+            nthread_tx = max_threads
+            nthread_bx = ceil_div(scan_axis_size, max_threads)
+            tx = te.thread_axis("threadIdx.x")
+            bx = te.thread_axis("blockIdx.x")
+            by = te.thread_axis("blockIdx.y")
+            ib.scope_attr(tx, "thread_extent", nthread_tx)
+            ib.scope_attr(bx, "thread_extent", nthread_bx)
+            ib.scope_attr(by, "thread_extent", batch_size)
+            tid = bx * nthread_tx + tx
+            with ib.if_scope(tid < scan_axis_size):
+                chunk = tid // chunk_len
+                output[by * scan_axis_size + tid] = binop(
+                    sums[by * num_chunks + chunk], output[by * scan_axis_size + tid]
+                )
+
+    return ib.get()
+
+
 def get_reduction_from_exclusive_scan(data, ex_scan_output, binop=tvm.tir.generic.add):
     """Return the sum of the last element of data and the exclusive scan output.
     The is the reduction of data along each row (for 2-D case).
@@ -389,7 +497,7 @@ def exclusive_scan(
             output, reduction = te.extern(
                 [data.shape, data.shape[:-1]],
                 [data],
-                lambda ins, outs: exclusive_scan_ir(
+                lambda ins, outs: exclusive_scan_blocked_ir(
                     ins[0], outs[0], outs[1], binop=binop, identity_value=identity_value
                 ),
                 dtype=[output_dtype, output_dtype],
@@ -401,7 +509,7 @@ def exclusive_scan(
             output = te.extern(
                 [data.shape],
                 [data],
-                lambda ins, outs: exclusive_scan_ir(
+                lambda ins, outs: exclusive_scan_blocked_ir(
                     ins[0], outs[0], binop=binop, identity_value=identity_value
                 ),
                 dtype=[output_dtype],
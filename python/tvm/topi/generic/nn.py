@@ -563,6 +563,23 @@ def schedule_softmax(outs):
     return _default_schedule(outs, False)
 
 
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    return _default_schedule(outs, False)
+
+
 def schedule_dense(outs):
     """Schedule for dense
 
@@ -728,6 +728,22 @@ def fast_tanh(x):
     return cpp.fast_tanh(x, x.dtype, tag.ELEMWISE)
 
 
+def fast_sigmoid(x):
+    """Take sigmoid of input x using fast_sigmoid implementation
+
+    Parameters
+    ----------
+    x : tvm.te.Tensor
+        Input argument.
+
+    Returns
+    -------
+    y : tvm.te.Tensor
+        The result.
+    """
+    return cpp.fast_sigmoid(x, x.dtype, tag.ELEMWISE)
+
+
 def fast_erf(x):
     """Take gauss error function of input x using fast_erf implementation.
 
@@ -0,0 +1,149 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Registry of tensorize-ready micro kernels.
+
+Hand-written inner kernels routinely beat searched schedules on the
+innermost tile, but today every schedule that wants one re-declares its
+own TensorIntrin per target. This module keeps a single registry keyed
+by (kernel kind, operand dtypes, ISA), so schedules and search policies
+can ask for "the best gemm core for this target" instead of hard-coding
+one, and new ISAs only need a registration, not schedule changes.
+"""
+import tvm
+from tvm import te
+
+#: (kind, dtypes, isa) -> fcreate() returning a TensorIntrin
+_MICRO_KERNEL_REGISTRY = {}
+
+
+def register_micro_kernel(kind, dtypes, isa, override=False):
+    """Register a micro kernel factory.
+
+    Parameters
+    ----------
+    kind : str
+        The kernel shape class, e.g. "gemm_6x16" or "dot_16x1x16".
+    dtypes : str
+        Comma separated operand dtypes, e.g. "float32" or "uint8,int8,int32".
+    isa : str
+        The ISA the kernel is built for, e.g. "avx512", "vnni" or "generic".
+    override : bool
+        Whether to allow replacing an existing registration.
+
+    Returns
+    -------
+    fregister : function
+        A decorator taking a zero-argument factory that returns a TensorIntrin.
+    """
+
+    def _register(fcreate):
+        key = (kind, dtypes, isa)
+        if not override and key in _MICRO_KERNEL_REGISTRY:
+            raise ValueError("Micro kernel %s is already registered" % str(key))
+        _MICRO_KERNEL_REGISTRY[key] = fcreate
+        return fcreate
+
+    return _register
+
+
+def _isa_preference(target):
+    """Return the ISA search order for a target, best first."""
+    mcpu = target.mcpu if target else ""
+    if mcpu == "cascadelake":
+        return ["vnni", "avx512", "generic"]
+    if mcpu == "skylake-avx512":
+        return ["avx512", "generic"]
+    return ["generic"]
+
+
+def micro_kernel(kind, dtypes, target=None):
+    """Look up the best registered micro kernel for a target.
+
+    Parameters
+    ----------
+    kind : str
+        The kernel shape class used at registration.
+    dtypes : str
+        Comma separated operand dtypes used at registration.
+    target : tvm.target.Target, optional
+        The target to select the ISA for, defaults to the current target.
+
+    Returns
+    -------
+    intrin : te.TensorIntrin or None
+        The instantiated kernel, or None if no registration matches.
+    """
+    target = target or tvm.target.Target.current()
+    for isa in _isa_preference(target):
+        fcreate = _MICRO_KERNEL_REGISTRY.get((kind, dtypes, isa))
+        if fcreate is not None:
+            return fcreate()
+    return None
+
+
+def _gemm_update_mxn_fp32(m, n):
+    """An m x n fp32 rank-1 GEMM update core: C[m, n] += A[m, 1] * B[1, n].
+
+    Tensorize this over (i, j, ki) after splitting the reduction by 1;
+    each row of C stays in one (possibly legalized) vector register and
+    the A element is broadcast against a vector load of B.
+    """
+    A = te.placeholder((m, 1), name="a", dtype="float32")
+    B = te.placeholder((1, n), name="b", dtype="float32")
+    k = te.reduce_axis((0, 1), name="k")
+    C = te.compute((m, n), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="c")
+
+    Ab = tvm.tir.decl_buffer(A.shape, A.dtype, name="A_buf", offset_factor=1, strides=[te.var("sa"), 1])
+    Bb = tvm.tir.decl_buffer(B.shape, B.dtype, name="B_buf", offset_factor=1, strides=[te.var("sb"), 1])
+    Cb = tvm.tir.decl_buffer(C.shape, C.dtype, name="C_buf", offset_factor=1, strides=[te.var("sc"), 1])
+
+    vec_type = "float32x%d" % n
+
+    def _intrin_func(ins, outs):
+        ba, bb = ins
+        bc = outs[0]
+
+        def _body():
+            ib = tvm.tir.ir_builder.create()
+            b_vec = bb.vload([0, 0], vec_type)
+            for i in range(m):
+                a_elem = ba.vload([i, 0], "float32")
+                acc = bc.vload([i, 0], vec_type)
+                ib.emit(bc.vstore([i, 0], acc + tvm.tir.Broadcast(a_elem, n) * b_vec))
+            return ib.get()
+
+        def _reduce_reset():
+            ib = tvm.tir.ir_builder.create()
+            for i in range(m):
+                ib.emit(bc.vstore([i, 0], tvm.tir.const(0, "float32x%d" % n)))
+            return ib.get()
+
+        return _body(), _reduce_reset(), _body()
+
+    return te.decl_tensor_intrin(C.op, _intrin_func, binds={A: Ab, B: Bb, C: Cb})
+
+
+@register_micro_kernel("gemm_6x16", "float32", "generic")
+def gemm_6x16_fp32():
+    """A 6 x 16 fp32 GEMM update core.
+
+    Six accumulator rows of sixteen lanes keep register pressure below
+    sixteen vector registers on both avx2 (two registers per row) and
+    avx512 (one per row), which is the classic BLIS-style fp32 core.
+    """
+    return _gemm_update_mxn_fp32(6, 16)
@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Fused scaled dot-product attention operator"""
+import tvm
+from tvm import te
+
+
+@tvm.te.tag_scope(tag="fused_attention_output")
+def fused_attention(query, key, value, scale=1.0):
+    """Fused scaled dot-product attention.
+
+    Computes `softmax(scale * query @ key^T) @ value` as one chain of stages
+    so a schedule can keep the score rows and the softmax on chip instead of
+    spilling them to global memory between kernels.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        3-D with shape [batch, seq_q, dim]
+
+    key : tvm.te.Tensor
+        3-D with shape [batch, seq_kv, dim]
+
+    value : tvm.te.Tensor
+        3-D with shape [batch, seq_kv, dim_v]
+
+    scale : float
+        The scaling factor applied to the attention scores, typically
+        1/sqrt(dim).
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        3-D with shape [batch, seq_q, dim_v]
+    """
+    assert len(query.shape) == 3 and len(key.shape) == 3 and len(value.shape) == 3
+    batch, seq_q, dim = query.shape
+    seq_kv = key.shape[1]
+    dim_v = value.shape[2]
+    scale_const = tvm.tir.const(scale, query.dtype)
+
+    kd = te.reduce_axis((0, dim), name="kd")
+    scores = te.compute(
+        (batch, seq_q, seq_kv),
+        lambda b, i, j: te.sum(query[b, i, kd] * key[b, j, kd], axis=kd),
+        name="T_attention_scores",
+    )
+    scaled = te.compute(
+        (batch, seq_q, seq_kv),
+        lambda b, i, j: scores[b, i, j] * scale_const,
+        name="T_attention_scaled",
+    )
+    k1 = te.reduce_axis((0, seq_kv), name="k1")
+    max_elem = te.compute(
+        (batch, seq_q),
+        lambda b, i: te.max(scaled[b, i, k1], axis=k1),
+        name="T_attention_maxelem",
+    )
+    exp = te.compute(
+        (batch, seq_q, seq_kv),
+        lambda b, i, j: te.exp(scaled[b, i, j] - max_elem[b, i]),
+        name="T_attention_exp",
+    )
+    k2 = te.reduce_axis((0, seq_kv), name="k2")
+    expsum = te.compute(
+        (batch, seq_q),
+        lambda b, i: te.sum(exp[b, i, k2], axis=k2),
+        name="T_attention_expsum",
+    )
+    kv = te.reduce_axis((0, seq_kv), name="kv")
+    context = te.compute(
+        (batch, seq_q, dim_v),
+        lambda b, i, j: te.sum(exp[b, i, kv] * value[b, kv, j], axis=kv),
+        name="T_attention_context",
+    )
+    # Normalizing after the value contraction needs one division per output
+    # element instead of one per attention weight.
+    return te.compute(
+        (batch, seq_q, dim_v),
+        lambda b, i, j: context[b, i, j] / expsum[b, i],
+        name="T_attention_output",
+    )
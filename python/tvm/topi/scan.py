@@ -111,6 +111,47 @@ def scanop(
             elif i > axis:
                 axis_mul_after *= value
 
+    def gen_blocked_ir(data_buf, out_buf):
+        # A single scan axis offers no row parallelism, so parallelize along
+        # the axis itself: every worker serially scans one contiguous chunk,
+        # the chunk totals are scanned, and the offsets are folded back in.
+        num_chunks = 128
+
+        ib = ir_builder.create()
+        data_buf = ib.buffer_ptr(data_buf)
+        out_buf = ib.buffer_ptr(out_buf)
+
+        chunk_len = (cumsum_axis_len + num_chunks - 1) // num_chunks
+        sums = ib.allocate(dtype, (num_chunks,), name="chunk_sums", scope="global")
+
+        with ib.for_range(0, num_chunks, "chunk", kind="parallel") as c:
+            start = c * chunk_len
+            extent = tvm.te.min(chunk_len, cumsum_axis_len - start)
+            running = ib.allocate(dtype, (1,), name="running", scope="local")
+            running[0] = cast(identity_value, dtype)
+            with ib.for_range(0, extent, "i") as i:
+                k = start + i
+                if exclusive:
+                    out_buf[k] = running[0]
+                    running[0] = binop(running[0], maybe_cast(data_buf[k]))
+                else:
+                    running[0] = binop(running[0], maybe_cast(data_buf[k]))
+                    out_buf[k] = running[0]
+            sums[c] = running[0]
+
+        # inclusive scan of the chunk totals; chunk c is offset by sums[c - 1]
+        with ib.for_range(0, num_chunks - 1, "c") as c:
+            sums[c + 1] = binop(sums[c], sums[c + 1])
+
+        with ib.for_range(0, num_chunks - 1, "chunk", kind="parallel") as c:
+            start = (c + 1) * chunk_len
+            extent = tvm.te.min(chunk_len, cumsum_axis_len - start)
+            with ib.for_range(0, extent, "i") as i:
+                k = start + i
+                out_buf[k] = binop(sums[c], out_buf[k])
+
+        return ib.get()
+
     def gen_ir(data_buf, out_buf):
         ib = ir_builder.create()
         data_buf = ib.buffer_ptr(data_buf)
@@ -137,10 +178,20 @@ def scanop(
 
     out_buf = decl_buffer(shape, dtype, "out_buf")
 
+    # With a single row there is nothing for the row-parallel loop to chew on,
+    # so scan the axis itself with multiple workers.
+    single_row = (
+        isinstance(axis_mul_before, int)
+        and axis_mul_before == 1
+        and isinstance(axis_mul_after, int)
+        and axis_mul_after == 1
+    )
+    gen = gen_blocked_ir if single_row else gen_ir
+
     return extern(
         [shape],
         [data],
-        lambda ins, outs: gen_ir(ins[0], outs[0]),
+        lambda ins, outs: gen(ins[0], outs[0]),
         dtype=dtype,
         out_buffers=[out_buf],
         name=op_name,
@@ -0,0 +1,65 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name, unused-variable
+"""x86 schedule for fused attention operator"""
+from tvm import te
+
+
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention op.
+
+    Parallelizes over (batch, query row) and keeps all intermediate rows of
+    one query local to the worker thread, so scores, softmax and the value
+    contraction stay in cache between the two matrix products.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention in the format
+          of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+    output = outs[0]
+
+    context = output.op.input_tensors[0]
+    expsum = output.op.input_tensors[1]
+    exp = context.op.input_tensors[0]
+    scaled = exp.op.input_tensors[0]
+    max_elem = exp.op.input_tensors[1]
+    scores = scaled.op.input_tensors[0]
+
+    s[scaled].compute_inline()
+
+    b, i, j = s[output].op.axis
+    fused = s[output].fuse(b, i)
+    s[output].parallel(fused)
+    jo, ji = s[output].split(j, factor=16)
+    s[output].vectorize(ji)
+
+    # Keep every per-row intermediate inside the parallel worker.
+    for tensor in [context, expsum, exp, max_elem, scores]:
+        s[tensor].compute_at(s[output], fused)
+    s[exp].vectorize(s[exp].op.axis[2])
+    s[scores].vectorize(s[scores].op.axis[2])
+
+    return s
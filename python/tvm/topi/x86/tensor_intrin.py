@@ -20,6 +20,8 @@ import tvm
 from tvm import te
 import tvm.target.codegen
 
+from ..micro_kernel import register_micro_kernel
+
 
 def dot_16x1x16_uint8_int8_int32():
     """Dispatch the most optimized intrin depending on the target"""
@@ -326,3 +328,14 @@ def dot_16x1x16_uint8_int8_int32_cascadelake():
         binds={data: a_buffer, kernel: b_buffer},
         default_buffer_params=buffer_params,
     )
+
+
+# The int8 dot cores double as 4x64-style int8 GEMM micro kernels: register
+# them so schedules can pick them up by (kind, dtypes, ISA) instead of
+# dispatching on mcpu by hand.
+register_micro_kernel("dot_16x1x16", "uint8,int8,int32", "avx512")(
+    dot_16x1x16_uint8_int8_int32_skylake
+)
+register_micro_kernel("dot_16x1x16", "uint8,int8,int32", "vnni")(
+    dot_16x1x16_uint8_int8_int32_cascadelake
+)
@@ -117,6 +117,8 @@ class ConstIntBoundAnalyzer::Impl
       }
     }
     var_map_[var] = info;
+    // cached results may rely on the old bound.
+    memo_.clear();
   }
 
   Entry VisitExpr_(const LetNode* op) final {
@@ -126,6 +128,8 @@ class ConstIntBoundAnalyzer::Impl
       var_map_[op->var] = this->VisitExpr(op->value);
       Entry ret = VisitExpr(op->body);
       var_map_.erase(op->var);
+      // drop results cached under the temporary binding.
+      memo_.clear();
       return ret;
     } else {
       return VisitExpr(op->body);
@@ -142,6 +146,15 @@ class ConstIntBoundAnalyzer::Impl
   }
 
   Entry VisitExpr(const PrimExpr& expr) final {
+    // The same sub-expressions are analyzed over and over, both within one query and
+    // across queries of the same analyzer, so memoize by object identity. The external
+    // lookup table path has its own memoization contract, so it bypasses the memo.
+    if (bound_ == nullptr) {
+      auto memo_it = memo_.find(expr);
+      if (memo_it != memo_.end()) {
+        return memo_it->second;
+      }
+    }
     Entry res = ExprFunctor::VisitExpr(expr);
     tir::ExprDeepEqual equal;
     // a linear search over additional info
@@ -162,6 +175,11 @@ class ConstIntBoundAnalyzer::Impl
             << "Detected bound for " << expr << "conflicts with memorization";
       }
       (*bound_)[expr] = ConstIntBound(res.min_value, res.max_value);
+    } else {
+      if (memo_.size() >= kMaxMemoSize) {
+        memo_.clear();
+      }
+      memo_.emplace(expr, res);
     }
     return res;
   }
@@ -370,9 +388,12 @@ class ConstIntBoundAnalyzer::Impl
     size_t old_size = additional_info_.size();
     additional_info_.insert(additional_info_.end(), info.begin(), info.end());
     size_t new_size = old_size + info.size();
+    // results cached under the new constraint must not leak out of its scope.
+    memo_.clear();
     auto frecover = [old_size, new_size, this]() {
       ICHECK_EQ(additional_info_.size(), new_size);
       additional_info_.resize(old_size);
+      memo_.clear();
     };
     return frecover;
   }
@@ -383,6 +404,10 @@ class ConstIntBoundAnalyzer::Impl
   std::unordered_map<Var, Entry, ObjectPtrHash, ObjectPtrEqual> var_map_;
   // additional bound info
   std::vector<BoundInfo> additional_info_;
+  // memo table of analyzed results, reset whenever the known facts change
+  std::unordered_map<PrimExpr, Entry, ObjectPtrHash, ObjectPtrEqual> memo_;
+  // maximum size of the memo table before it is cleared wholesale
+  static const constexpr size_t kMaxMemoSize = 100000;
   // look up table for memorization
   BoundMapType* bound_{nullptr};
   // constants: the limit value means umlimited
@@ -618,17 +643,25 @@ ConstIntBound ConstIntBoundAnalyzer::operator()(const PrimExpr& expr, BoundMapTy
 
 void ConstIntBoundAnalyzer::Update(const Var& var, const ConstIntBound& info, bool allow_override) {
   impl_->Update(var, info, allow_override);
+  // the other sub-analyzers consult the bounds through the parent analyzer.
+  parent_->modular_set.ResetMemo();
+  parent_->rewrite_simplify.ResetMemo();
 }
 
 void ConstIntBoundAnalyzer::Bind(const Var& var, const Range& range, bool allow_override) {
   impl_->Bind(var, range, allow_override);
+  parent_->modular_set.ResetMemo();
+  parent_->rewrite_simplify.ResetMemo();
 }
 
+void ConstIntBoundAnalyzer::ResetMemo() { impl_->memo_.clear(); }
+
 std::function<void()> ConstIntBoundAnalyzer::EnterConstraint(const PrimExpr& constraint) {
   return impl_->EnterConstraint(constraint);
 }
 
-ConstIntBoundAnalyzer::ConstIntBoundAnalyzer(Analyzer* parent) : impl_(new Impl()) {}
+ConstIntBoundAnalyzer::ConstIntBoundAnalyzer(Analyzer* parent)
+    : impl_(new Impl()), parent_(parent) {}
 
 ConstIntBoundAnalyzer::~ConstIntBoundAnalyzer() { delete impl_; }
 
@@ -100,10 +100,20 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       }
     }
     var_map_[var] = Entry(info->coeff, info->base);
+    // cached results may rely on the old set, here and in the rewrite simplifier,
+    // which consults the modular sets through the parent analyzer.
+    memo_.clear();
+    parent_->rewrite_simplify.ResetMemo();
   }
 
+  /*! \brief Reset the memo table of analyzed results. */
+  void ResetMemo() { memo_.clear(); }
+
   // Detect useful constraints and use them in the analysis scope.
   std::function<void()> EnterConstraint(const PrimExpr& constraint) {
+    // The analysis consults the other sub-analyzers through the parent, so results
+    // cached under any constraint must not leak out of its scope.
+    memo_.clear();
     PVar<Var> var;
     PVar<IntImm> coeff, base;
     // pattern match interesting constraints
@@ -112,10 +122,25 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       Entry entry(coeff.Eval()->value, base.Eval()->value);
       return UpdateByIntersect(var.Eval(), entry);
     }
-    return nullptr;
+    return [this]() { memo_.clear(); };
   }
 
   // Override visitor behaviors
+  Entry VisitExpr(const PrimExpr& expr) final {
+    // memoize by object identity: the same sub-expressions are analyzed repeatedly
+    // within and across queries of the same analyzer.
+    auto it = memo_.find(expr);
+    if (it != memo_.end()) {
+      return it->second;
+    }
+    Entry res = ExprFunctor::VisitExpr(expr);
+    if (memo_.size() >= kMaxMemoSize) {
+      memo_.clear();
+    }
+    memo_.emplace(expr, res);
+    return res;
+  }
+
   Entry VisitExprDefault_(const Object* op) final { return Everything(); }
 
   Entry VisitExpr_(const LetNode* op) final {
@@ -125,6 +150,8 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       var_map_[op->var] = this->VisitExpr(op->value);
       Entry ret = VisitExpr(op->body);
       var_map_.erase(op->var);
+      // drop results cached under the temporary binding.
+      memo_.clear();
       return ret;
     } else {
       return VisitExpr(op->body);
@@ -248,6 +275,10 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
   Analyzer* parent_{nullptr};
   // internal variable map
   std::unordered_map<Var, Entry, ObjectPtrHash, ObjectPtrEqual> var_map_;
+  // memo table of analyzed results, reset whenever the known facts change
+  std::unordered_map<PrimExpr, Entry, ObjectPtrHash, ObjectPtrEqual> memo_;
+  // maximum size of the memo table before it is cleared wholesale
+  static const constexpr size_t kMaxMemoSize = 100000;
   /*!
    * \brief Update var by intersecting entry with var's current set.
    * \param var The variable.
@@ -261,8 +292,12 @@ class ModularSetAnalyzer::Impl : public ExprFunctor<ModularSetAnalyzer::Entry(co
       old = it->second;
     }
     var_map_[var] = Intersect(old, entry);
+    memo_.clear();
     // reover function.
-    return [this, old, var]() { var_map_[var] = old; };
+    return [this, old, var]() {
+      var_map_[var] = old;
+      memo_.clear();
+    };
   }
   /*!
    * \brief Create union of two sets.
@@ -332,6 +367,8 @@ void ModularSetAnalyzer::Update(const Var& var, const ModularSet& info, bool all
   impl_->Update(var, info, allow_override);
 }
 
+void ModularSetAnalyzer::ResetMemo() { impl_->ResetMemo(); }
+
 std::function<void()> ModularSetAnalyzer::EnterConstraint(const PrimExpr& constraint) {
   return impl_->EnterConstraint(constraint);
 }
@@ -28,7 +28,13 @@
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/op.h>
 
+#include <tvm/runtime/registry.h>
+
 #include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
 
 #include "../target/datatype/registry.h"
 #include "const_fold.h"
@@ -39,30 +45,95 @@ namespace arith {
 
 using namespace tir;
 
+/*!
+ * \brief Hit counters of the rewrite patterns, keyed by the source line of the
+ * TVM_TRY_REWRITE* macro that defines each pattern.
+ *
+ * Counting is off by default; set the environment variable TVM_ARITH_COUNT_REWRITES=1
+ * to enable it and use arith.GetRewriteRuleHits to retrieve the counters. This is meant
+ * for finding out which of the hundreds of patterns actually fire on a workload.
+ */
+class RewriteRuleCounters {
+ public:
+  static RewriteRuleCounters* Global() {
+    static RewriteRuleCounters* inst = new RewriteRuleCounters();
+    return inst;
+  }
+
+  bool enabled() const { return enabled_; }
+
+  void Record(int line) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++counts_[line];
+  }
+
+  Map<String, Integer> GetCounts() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Map<String, Integer> ret;
+    for (const auto& kv : counts_) {
+      ret.Set("rewrite_simplify.cc:" + std::to_string(kv.first), Integer(kv.second));
+    }
+    return ret;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counts_.clear();
+  }
+
+ private:
+  RewriteRuleCounters() {
+    const char* flag = std::getenv("TVM_ARITH_COUNT_REWRITES");
+    enabled_ = flag != nullptr && std::atoi(flag) > 0;
+  }
+
+  bool enabled_;
+  std::mutex mutex_;
+  std::map<int, int64_t> counts_;
+};
+
+// record a hit of the rewrite pattern on the current source line.
+#define TVM_RECORD_REWRITE_HIT()                   \
+  if (RewriteRuleCounters::Global()->enabled()) {  \
+    RewriteRuleCounters::Global()->Record(__LINE__); \
+  }
+
 // macro for doing simple rewrite
 #define TVM_TRY_REWRITE(SrcExpr, ResExpr) \
   if ((SrcExpr).Match(ret)) {             \
+    TVM_RECORD_REWRITE_HIT();             \
     return (ResExpr).Eval();              \
   }
 
 // macro for rewrite + recursively rewrite ResExpr
 #define TVM_TRY_RECURSIVE_REWRITE(SrcExpr, ResExpr) \
   if ((SrcExpr).Match(ret)) {                       \
+    TVM_RECORD_REWRITE_HIT();                       \
     return RecursiveRewrite((ResExpr).Eval());      \
   }
 
 // macro rewrite only if CondExor is true after match.
 #define TVM_TRY_REWRITE_IF(SrcExpr, ResExpr, CondExpr) \
   if ((SrcExpr).Match(ret) && (CondExpr)) {            \
+    TVM_RECORD_REWRITE_HIT();                          \
     return (ResExpr).Eval();                           \
   }
 
 // macro rewrite + recursive_rewrite only if CondExor is true after match.
 #define TVM_TRY_RECURSIVE_REWRITE_IF(SrcExpr, ResExpr, CondExpr) \
   if ((SrcExpr).Match(ret) && (CondExpr)) {                      \
+    TVM_RECORD_REWRITE_HIT();                                    \
     return RecursiveRewrite((ResExpr).Eval());                   \
   }
 
+TVM_REGISTER_GLOBAL("arith.GetRewriteRuleHits").set_body_typed([]() {
+  return RewriteRuleCounters::Global()->GetCounts();
+});
+
+TVM_REGISTER_GLOBAL("arith.ClearRewriteRuleHits").set_body_typed([]() {
+  RewriteRuleCounters::Global()->Clear();
+});
+
 // NOTE for developers:
 //
 // We mainly focus on index expression simplification.
@@ -115,6 +186,27 @@ void RewriteSimplifier::Impl::Update(const Var& var, const PrimExpr& info, bool
     }
   }
   var_map_[var] = info;
+  // Cached results may rely on the old binding, here and in the modular set analyzer,
+  // which consults the bindings through the parent analyzer.
+  memo_.clear();
+  analyzer_->modular_set.ResetMemo();
+}
+
+PrimExpr RewriteSimplifier::Impl::VisitExpr(const PrimExpr& expr) {
+  auto it = memo_.find(expr);
+  if (it != memo_.end()) {
+    return it->second;
+  }
+  PrimExpr res = IRMutatorWithAnalyzer::VisitExpr(expr);
+  // Only memoize results of complete rewrites: inside RecursiveRewrite the depth limit
+  // can cut the rewrite short and the result would be cached in a less simplified form.
+  if (recur_depth_ == 0) {
+    if (memo_.size() >= kMaxMemoSize) {
+      memo_.clear();
+    }
+    memo_.emplace(expr, res);
+  }
+  return res;
 }
 
 PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
@@ -130,6 +222,8 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
   PVar<FloatImm> c4;
   // Pattern var for lanes in broadcast and ramp
   PVar<int> lanes;
+  // Root kinds of the operands, used to skip pattern groups that cannot match.
+  unsigned kinds = GetRootKind(op->a) | GetRootKind(op->b);
   // Vector rules
   if (op->dtype.lanes() != 1) {
     TVM_TRY_REWRITE(ramp(b1, s1, lanes) + ramp(b2, s2, lanes), ramp(b1 + b2, s1 + s2, lanes));
@@ -148,29 +242,35 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
     TVM_TRY_REWRITE((x - y) + (y - z), x - z);
     TVM_TRY_REWRITE((x - y) + (z - x), z - y);
 
-    TVM_TRY_REWRITE(min(x, y - z) + z, min(x + z, y));
-    TVM_TRY_REWRITE(min(x - z, y) + z, min(x, y + z));
-    TVM_TRY_REWRITE(max(x, y - z) + z, max(x + z, y));
-    TVM_TRY_REWRITE(max(x - z, y) + z, max(x, y + z));
-
-    TVM_TRY_REWRITE_IF(min(x, y + z * c1) + z * c2, min(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, y + z * c1) + z * c2, max(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(y + z * c1, x) + z * c2, min(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(y + z * c1, x) + z * c2, max(x + z * c2, y),
-                       c1.Eval()->value == -c2.Eval()->value);
-
-    TVM_TRY_REWRITE(max(x, y) + min(x, y), x + y);
-    TVM_TRY_REWRITE(min(x, y) + max(x, y), x + y);
-    TVM_TRY_REWRITE(max(x, y) + min(y, x), x + y);
-    TVM_TRY_REWRITE(min(x, y) + max(y, x), x + y);
-
-    TVM_TRY_REWRITE_IF(min(x, y + c1) + c2, min(x + c2, y), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(x + c1, y) + c2, min(x, y + c2), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, y + c1) + c2, max(x + c2, y), c1.Eval()->value == -c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x + c1, y) + c2, max(x, y + c2), c1.Eval()->value == -c2.Eval()->value);
+    if (kinds & kRootMinMax) {
+      TVM_TRY_REWRITE(min(x, y - z) + z, min(x + z, y));
+      TVM_TRY_REWRITE(min(x - z, y) + z, min(x, y + z));
+      TVM_TRY_REWRITE(max(x, y - z) + z, max(x + z, y));
+      TVM_TRY_REWRITE(max(x - z, y) + z, max(x, y + z));
+
+      TVM_TRY_REWRITE_IF(min(x, y + z * c1) + z * c2, min(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, y + z * c1) + z * c2, max(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(y + z * c1, x) + z * c2, min(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(y + z * c1, x) + z * c2, max(x + z * c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+
+      TVM_TRY_REWRITE(max(x, y) + min(x, y), x + y);
+      TVM_TRY_REWRITE(min(x, y) + max(x, y), x + y);
+      TVM_TRY_REWRITE(max(x, y) + min(y, x), x + y);
+      TVM_TRY_REWRITE(min(x, y) + max(y, x), x + y);
+
+      TVM_TRY_REWRITE_IF(min(x, y + c1) + c2, min(x + c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(x + c1, y) + c2, min(x, y + c2),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, y + c1) + c2, max(x + c2, y),
+                         c1.Eval()->value == -c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x + c1, y) + c2, max(x, y + c2),
+                         c1.Eval()->value == -c2.Eval()->value);
+    }
 
     // constant folding
     // NOTE: canonicalization might better at this.
@@ -188,10 +288,12 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
     TVM_TRY_REWRITE(y * x + z * x, x * (y + z));
 
     // DivMod rules
-    // truc div
-    TVM_TRY_REWRITE(truncdiv(x, c1) * c1 + truncmod(x, c1), x);
-    // floor div
-    TVM_TRY_REWRITE(floordiv(x, c1) * c1 + floormod(x, c1), x);
+    if (HasDivModNearRoot(op->a) || HasDivModNearRoot(op->b)) {
+      // truc div
+      TVM_TRY_REWRITE(truncdiv(x, c1) * c1 + truncmod(x, c1), x);
+      // floor div
+      TVM_TRY_REWRITE(floordiv(x, c1) * c1 + floormod(x, c1), x);
+    }
 
     // canonicalization rule
     // will try rewrite again after canonicalization.
@@ -203,14 +305,18 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const AddNode* op) {
     TVM_TRY_RECURSIVE_REWRITE(x + min(y, z), min(y, z) + x);
 
     // DivMod rules
-    // truc div
-    TVM_TRY_RECURSIVE_REWRITE(truncmod(y, c1) + x * c1, x * c1 + truncmod(y, c1));
-    // floor div
-    TVM_TRY_RECURSIVE_REWRITE(floormod(y, c1) + x * c1, x * c1 + floormod(y, c1));
+    if (kinds & kRootDivMod) {
+      // truc div
+      TVM_TRY_RECURSIVE_REWRITE(truncmod(y, c1) + x * c1, x * c1 + truncmod(y, c1));
+      // floor div
+      TVM_TRY_RECURSIVE_REWRITE(floormod(y, c1) + x * c1, x * c1 + floormod(y, c1));
+    }
   }
 
   // condition rules.
-  TVM_TRY_REWRITE(select(x, b1, b2) + select(x, s1, s2), select(x, b1 + s1, b2 + s2));
+  if (kinds & kRootSelect) {
+    TVM_TRY_REWRITE(select(x, b1, b2) + select(x, s1, s2), select(x, b1 + s1, b2 + s2));
+  }
   // default value
   return ret;
 }
@@ -221,9 +327,12 @@ std::function<void()> RewriteSimplifier::Impl::EnterConstraint(const PrimExpr& c
   // so simplify the constarint as well
   literal_constraints_.push_back(operator()(constraint));
   size_t new_literal_size = literal_constraints_.size();
+  // results cached under the new constraint must not leak out of its scope.
+  memo_.clear();
   auto frecover = [old_literal_size, new_literal_size, this]() {
     ICHECK_EQ(literal_constraints_.size(), new_literal_size);
     literal_constraints_.resize(old_literal_size);
+    memo_.clear();
   };
   return frecover;
 }
@@ -239,6 +348,8 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const SubNode* op) {
   PVar<IntImm> c1, c2, c3;
   // Pattern var for lanes in broadcast and ramp
   PVar<int> lanes;
+  // Root kinds of the operands, used to skip pattern groups that cannot match.
+  unsigned kinds = GetRootKind(op->a) | GetRootKind(op->b);
   // Vector rules
   if (op->dtype.lanes() != 1) {
     TVM_TRY_REWRITE(ramp(b1, s1, lanes) - ramp(b2, s2, lanes), ramp(b1 - b2, s1 - s2, lanes));
@@ -255,15 +366,17 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const SubNode* op) {
     TVM_TRY_REWRITE(x - (y + x), 0 - y);
     TVM_TRY_REWRITE(x - (x + y), 0 - y);
 
-    TVM_TRY_REWRITE(min(x, y) - x, min(0, y - x));
-    TVM_TRY_REWRITE(min(x, y) - y, min(x - y, 0));
-    TVM_TRY_REWRITE(max(x, y) - x, max(0, y - x));
-    TVM_TRY_REWRITE(max(x, y) - y, max(x - y, 0));
+    if (kinds & kRootMinMax) {
+      TVM_TRY_REWRITE(min(x, y) - x, min(0, y - x));
+      TVM_TRY_REWRITE(min(x, y) - y, min(x - y, 0));
+      TVM_TRY_REWRITE(max(x, y) - x, max(0, y - x));
+      TVM_TRY_REWRITE(max(x, y) - y, max(x - y, 0));
 
-    TVM_TRY_REWRITE(x - max(x, y), min(0, x - y));
-    TVM_TRY_REWRITE(y - max(x, y), min(y - x, 0));
-    TVM_TRY_REWRITE(x - min(x, y), max(0, x - y));
-    TVM_TRY_REWRITE(y - min(x, y), max(y - x, 0));
+      TVM_TRY_REWRITE(x - max(x, y), min(0, x - y));
+      TVM_TRY_REWRITE(y - max(x, y), min(y - x, 0));
+      TVM_TRY_REWRITE(x - min(x, y), max(0, x - y));
+      TVM_TRY_REWRITE(y - min(x, y), max(y - x, 0));
+    }
 
     // mul co-efficient folding
     TVM_TRY_REWRITE(x - x, ZeroWithTypeLike(x));
@@ -286,115 +399,120 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const SubNode* op) {
     TVM_TRY_REWRITE((y + x) - (z + x), y - z);
     TVM_TRY_REWRITE((y + x) - (x + z), y - z);
 
-    TVM_TRY_REWRITE(min(x + y, z) - x, min(y, z - x));
-    TVM_TRY_REWRITE(min(y + x, z) - x, min(y, z - x));
-    TVM_TRY_REWRITE(min(z, x + y) - x, min(z - x, y));
-    TVM_TRY_REWRITE(min(z, y + x) - x, min(z - x, y));
-
-    TVM_TRY_REWRITE(max(x + y, z) - x, max(y, z - x));
-    TVM_TRY_REWRITE(max(y + x, z) - x, max(y, z - x));
-    TVM_TRY_REWRITE(max(z, x + y) - x, max(z - x, y));
-    TVM_TRY_REWRITE(max(z, y + x) - x, max(z - x, y));
-
-    TVM_TRY_REWRITE(x - min(x + y, z), max(0 - y, x - z));
-    TVM_TRY_REWRITE(x - min(y + x, z), max(0 - y, x - z));
-    TVM_TRY_REWRITE(x - min(z, x + y), max(x - z, 0 - y));
-    TVM_TRY_REWRITE(x - min(z, y + x), max(x - z, 0 - y));
-
-    TVM_TRY_REWRITE(min(x, y) - min(y, x), ZeroWithTypeLike(x));
-    TVM_TRY_REWRITE(max(x, y) - max(y, x), ZeroWithTypeLike(x));
-
-    TVM_TRY_REWRITE_IF(min(b1, b2) - min(s1, s2), b1 - s1,
-                       CanProveEqual(((b1 - s1) - (b2 - s2)).Eval(), 0));
-
-    TVM_TRY_REWRITE_IF(min(b1, b2) - min(s1, s2), b1 - s2,
-                       CanProveEqual(((b1 - s2) - (b2 - s1)).Eval(), 0));
-    TVM_TRY_REWRITE_IF(max(b1, b2) - max(s1, s2), b1 - s1,
-                       CanProveEqual(((b1 - s1) - (b2 - s2)).Eval(), 0));
-    TVM_TRY_REWRITE_IF(max(b1, b2) - max(s1, s2), b1 - s2,
-                       CanProveEqual(((b1 - s2) - (b2 - s1)).Eval(), 0));
+    if (kinds & kRootMinMax) {
+      TVM_TRY_REWRITE(min(x + y, z) - x, min(y, z - x));
+      TVM_TRY_REWRITE(min(y + x, z) - x, min(y, z - x));
+      TVM_TRY_REWRITE(min(z, x + y) - x, min(z - x, y));
+      TVM_TRY_REWRITE(min(z, y + x) - x, min(z - x, y));
+
+      TVM_TRY_REWRITE(max(x + y, z) - x, max(y, z - x));
+      TVM_TRY_REWRITE(max(y + x, z) - x, max(y, z - x));
+      TVM_TRY_REWRITE(max(z, x + y) - x, max(z - x, y));
+      TVM_TRY_REWRITE(max(z, y + x) - x, max(z - x, y));
+
+      TVM_TRY_REWRITE(x - min(x + y, z), max(0 - y, x - z));
+      TVM_TRY_REWRITE(x - min(y + x, z), max(0 - y, x - z));
+      TVM_TRY_REWRITE(x - min(z, x + y), max(x - z, 0 - y));
+      TVM_TRY_REWRITE(x - min(z, y + x), max(x - z, 0 - y));
+
+      TVM_TRY_REWRITE(min(x, y) - min(y, x), ZeroWithTypeLike(x));
+      TVM_TRY_REWRITE(max(x, y) - max(y, x), ZeroWithTypeLike(x));
+
+      TVM_TRY_REWRITE_IF(min(b1, b2) - min(s1, s2), b1 - s1,
+                         CanProveEqual(((b1 - s1) - (b2 - s2)).Eval(), 0));
+
+      TVM_TRY_REWRITE_IF(min(b1, b2) - min(s1, s2), b1 - s2,
+                         CanProveEqual(((b1 - s2) - (b2 - s1)).Eval(), 0));
+      TVM_TRY_REWRITE_IF(max(b1, b2) - max(s1, s2), b1 - s1,
+                         CanProveEqual(((b1 - s1) - (b2 - s2)).Eval(), 0));
+      TVM_TRY_REWRITE_IF(max(b1, b2) - max(s1, s2), b1 - s2,
+                         CanProveEqual(((b1 - s2) - (b2 - s1)).Eval(), 0));
+    }
 
     // DivMod rules
+    bool has_div_mod = HasDivModNearRoot(op->a) || HasDivModNearRoot(op->b);
     // trucdiv
     // NOTE: c*(x/c) + x % c == x is true all division mode.
-    TVM_TRY_REWRITE_IF(x - truncdiv(x, c1) * c1, truncmod(x, c1), c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(truncdiv(x, c1) * c1 - x, 0 - truncmod(x, c1), c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(x - (truncdiv(x + y, c1)) * c1, truncmod(x + y, c1) - y,
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF((truncdiv(x + y, c1)) * c1 - x, y - truncmod(x + y, c1),
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(x - truncdiv(x - y, c1) * c1, truncmod(x - y, c1) + y,
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(truncdiv(x - y, c1) * c1 - x, 0 - truncmod(x - y, c1) - y,
-                       c1.Eval()->value != 0);
-
-    TVM_TRY_REWRITE_IF(
-        x * c2 - truncdiv(x, c1) * c3, truncmod(x, c1) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        truncdiv(x, c1) * c3 - x * c2, 0 - truncmod(x, c1) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        x * c2 - truncdiv(x + y, c1) * c3, (truncmod(x + y, c1) - y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        truncdiv(x + y, c1) * c3 - x * c2, (y - truncmod(x + y, c1)) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        x * c2 - truncdiv(x - y, c1) * c3, (truncmod(x - y, c1) + y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        truncdiv(x - y, c1) * c3 - x * c2, (0 - truncmod(x - y, c1) - y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-
-    // Proof in the case of floordiv, need positive condition.
-    // let x = a * c3 + r
-    // (x + c1) / c3 - x / c3 => (r + c1) / c3
-    // NOTE: the use of floormod(c2, c3) was intentional to simplify the const.
-    TVM_TRY_REWRITE_IF(truncdiv(x + c1, c3) - truncdiv(x + c2, c3),
-                       truncdiv(truncmod(x + floormod(c2, c3), c3) + (c1 - c2), c3),
-                       CanProveGreaterEqual(x.Eval(), -c2.Eval()->value) &&
-                           c1.Eval()->value >= c2.Eval()->value && c3.Eval()->value > 0);
-    TVM_TRY_REWRITE_IF(
-        truncdiv(x + c1, c3) - truncdiv(x, c3), truncdiv(truncmod(x, c3) + c1, c3),
-        CanProveGreaterEqual(x.Eval(), 0) && c1.Eval()->value >= 0 && c3.Eval()->value > 0);
-
-    // floordiv
-    TVM_TRY_REWRITE_IF(x - floordiv(x, c1) * c1, floormod(x, c1), c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(floordiv(x, c1) * c1 - x, 0 - floormod(x, c1), c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(x - floordiv(x + y, c1) * c1, floormod(x + y, c1) - y,
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(floordiv(x + y, c1) * c1 - x, y - floormod(x + y, c1),
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(x - floordiv(x - y, c1) * c1, floormod(x - y, c1) + y,
-                       c1.Eval()->value != 0);
-    TVM_TRY_REWRITE_IF(floordiv(x - y, c1) * c1 - x, 0 - floormod(x - y, c1) - y,
-                       c1.Eval()->value != 0);
-
-    TVM_TRY_REWRITE_IF(
-        x * c2 - floordiv(x, c1) * c3, floormod(x, c1) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        floordiv(x, c1) * c3 - x * c2, 0 - floormod(x, c1) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        x * c2 - floordiv(x + y, c1) * c3, (floormod(x + y, c1) - y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        floordiv(x + y, c1) * c3 - x * c2, (y - floormod(x + y, c1)) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        x * c2 - floordiv(x - y, c1) * c3, (floormod(x - y, c1) + y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(
-        floordiv(x - y, c1) * c3 - x * c2, (0 - floormod(x - y, c1) - y) * c2,
-        c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
-
-    TVM_TRY_REWRITE_IF(floordiv(x + c1, c3) - floordiv(x + c2, c3),
-                       floordiv(floormod(x + floormod(c2, c3), c3) + (c1 - c2), c3),
-                       c3.Eval()->value > 0);
-    TVM_TRY_REWRITE_IF(floordiv(x + c1, c3) - floordiv(x, c3), floordiv(floormod(x, c3) + c1, c3),
-                       c3.Eval()->value > 0);
+    if (has_div_mod) {
+      TVM_TRY_REWRITE_IF(x - truncdiv(x, c1) * c1, truncmod(x, c1), c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(truncdiv(x, c1) * c1 - x, 0 - truncmod(x, c1), c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(x - (truncdiv(x + y, c1)) * c1, truncmod(x + y, c1) - y,
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF((truncdiv(x + y, c1)) * c1 - x, y - truncmod(x + y, c1),
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(x - truncdiv(x - y, c1) * c1, truncmod(x - y, c1) + y,
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(truncdiv(x - y, c1) * c1 - x, 0 - truncmod(x - y, c1) - y,
+                         c1.Eval()->value != 0);
+
+      TVM_TRY_REWRITE_IF(
+          x * c2 - truncdiv(x, c1) * c3, truncmod(x, c1) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          truncdiv(x, c1) * c3 - x * c2, 0 - truncmod(x, c1) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          x * c2 - truncdiv(x + y, c1) * c3, (truncmod(x + y, c1) - y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          truncdiv(x + y, c1) * c3 - x * c2, (y - truncmod(x + y, c1)) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          x * c2 - truncdiv(x - y, c1) * c3, (truncmod(x - y, c1) + y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          truncdiv(x - y, c1) * c3 - x * c2, (0 - truncmod(x - y, c1) - y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+
+      // Proof in the case of floordiv, need positive condition.
+      // let x = a * c3 + r
+      // (x + c1) / c3 - x / c3 => (r + c1) / c3
+      // NOTE: the use of floormod(c2, c3) was intentional to simplify the const.
+      TVM_TRY_REWRITE_IF(truncdiv(x + c1, c3) - truncdiv(x + c2, c3),
+                         truncdiv(truncmod(x + floormod(c2, c3), c3) + (c1 - c2), c3),
+                         CanProveGreaterEqual(x.Eval(), -c2.Eval()->value) &&
+                             c1.Eval()->value >= c2.Eval()->value && c3.Eval()->value > 0);
+      TVM_TRY_REWRITE_IF(
+          truncdiv(x + c1, c3) - truncdiv(x, c3), truncdiv(truncmod(x, c3) + c1, c3),
+          CanProveGreaterEqual(x.Eval(), 0) && c1.Eval()->value >= 0 && c3.Eval()->value > 0);
+
+      // floordiv
+      TVM_TRY_REWRITE_IF(x - floordiv(x, c1) * c1, floormod(x, c1), c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(floordiv(x, c1) * c1 - x, 0 - floormod(x, c1), c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(x - floordiv(x + y, c1) * c1, floormod(x + y, c1) - y,
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(floordiv(x + y, c1) * c1 - x, y - floormod(x + y, c1),
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(x - floordiv(x - y, c1) * c1, floormod(x - y, c1) + y,
+                         c1.Eval()->value != 0);
+      TVM_TRY_REWRITE_IF(floordiv(x - y, c1) * c1 - x, 0 - floormod(x - y, c1) - y,
+                         c1.Eval()->value != 0);
+
+      TVM_TRY_REWRITE_IF(
+          x * c2 - floordiv(x, c1) * c3, floormod(x, c1) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          floordiv(x, c1) * c3 - x * c2, 0 - floormod(x, c1) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          x * c2 - floordiv(x + y, c1) * c3, (floormod(x + y, c1) - y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          floordiv(x + y, c1) * c3 - x * c2, (y - floormod(x + y, c1)) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          x * c2 - floordiv(x - y, c1) * c3, (floormod(x - y, c1) + y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(
+          floordiv(x - y, c1) * c3 - x * c2, (0 - floormod(x - y, c1) - y) * c2,
+          c1.Eval()->value != 0 && c3.Eval()->value == c1.Eval()->value * c2.Eval()->value);
+
+      TVM_TRY_REWRITE_IF(floordiv(x + c1, c3) - floordiv(x + c2, c3),
+                         floordiv(floormod(x + floormod(c2, c3), c3) + (c1 - c2), c3),
+                         c3.Eval()->value > 0);
+      TVM_TRY_REWRITE_IF(floordiv(x + c1, c3) - floordiv(x, c3), floordiv(floormod(x, c3) + c1, c3),
+                         c3.Eval()->value > 0);
+    }
 
     // canonicalization rule
     // will try rewrite again after canonicalization.
@@ -405,9 +523,11 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const SubNode* op) {
   }
 
   // condition rules.
-  TVM_TRY_REWRITE(select(x, b1, b2) - select(x, s1, s2), select(x, b1 - s1, b2 - s2));
-  TVM_TRY_REWRITE(select(x, y, z) - z, select(x, y - z, ZeroWithTypeLike(z)));
-  TVM_TRY_REWRITE(select(x, y, z) - y, select(x, ZeroWithTypeLike(y), z - y));
+  if (kinds & kRootSelect) {
+    TVM_TRY_REWRITE(select(x, b1, b2) - select(x, s1, s2), select(x, b1 - s1, b2 - s2));
+    TVM_TRY_REWRITE(select(x, y, z) - z, select(x, y - z, ZeroWithTypeLike(z)));
+    TVM_TRY_REWRITE(select(x, y, z) - y, select(x, ZeroWithTypeLike(y), z - y));
+  }
   return ret;
 }
 
@@ -908,6 +1028,10 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MinNode* op) {
   // Pattern var match IntImm
   PVar<IntImm> c1, c2;
   PVar<int> lanes;
+  // Root kinds of the operands, used to skip pattern groups that cannot match.
+  unsigned akind = GetRootKind(op->a);
+  unsigned bkind = GetRootKind(op->b);
+  unsigned kinds = akind | bkind;
 
   // vector rule
   if (op->dtype.lanes() != 1) {
@@ -952,109 +1076,123 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MinNode* op) {
     }
 
     // DivMod rules
-    // Divide up rounding: truc div
-    // NOTE: trucdiv(x, y) >= floordiv(x, y)
-    TVM_TRY_REWRITE_IF(min(truncdiv(x + c1, c2) * c2, x), x,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(truncdiv(x + c1, c2) * c2, max(x, c2)), max(x, c2),
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value &&
-                           CanProveGreaterEqual(x.Eval(), 0));
+    if (HasDivModNearRoot(op->a) || HasDivModNearRoot(op->b)) {
+      // Divide up rounding: truc div
+      // NOTE: trucdiv(x, y) >= floordiv(x, y)
+      TVM_TRY_REWRITE_IF(min(truncdiv(x + c1, c2) * c2, x), x,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(truncdiv(x + c1, c2) * c2, max(x, c2)), max(x, c2),
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value &&
+                             CanProveGreaterEqual(x.Eval(), 0));
+
+      TVM_TRY_REWRITE_IF(min(x, truncdiv(x + c1, c2) * c2), x,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(max(x, c2), truncdiv(x + c1, c2) * c2), max(x, c2),
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value &&
+                             CanProveGreaterEqual(x.Eval(), 0));
+
+      // Divide up rounding: floor div
+      TVM_TRY_REWRITE_IF(min(floordiv(x + c1, c2) * c2, x), x,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(floordiv(x + c1, c2) * c2, max(x, c2)), max(x, c2),
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+
+      TVM_TRY_REWRITE_IF(min(x, floordiv(x + c1, c2) * c2), x,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(min(max(x, c2), floordiv(x + c1, c2) * c2), max(x, c2),
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+
+      TVM_TRY_REWRITE_IF(min(x, floordiv(x, c2) * c2), floordiv(x, c2) * c2,
+                         c2.Eval()->value > 0);
+      TVM_TRY_REWRITE_IF(min(floordiv(x, c2) * c2, x), floordiv(x, c2) * c2,
+                         c2.Eval()->value > 0);
+
+      // scaling rule
+      if (min(truncdiv(x, c1), truncdiv(y, c1)).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return truncdiv(min(x, y), c1).Eval();
+        } else {
+          return truncdiv(max(x, y), c1).Eval();
+        }
+      }
+      if (min(floordiv(x, c1), floordiv(y, c1)).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return floordiv(min(x, y), c1).Eval();
+        } else {
+          return floordiv(max(x, y), c1).Eval();
+        }
+      }
+    }
 
-    TVM_TRY_REWRITE_IF(min(x, truncdiv(x + c1, c2) * c2), x,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(max(x, c2), truncdiv(x + c1, c2) * c2), max(x, c2),
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value &&
-                           CanProveGreaterEqual(x.Eval(), 0));
+    if (kinds & kRootMinMax) {
+      TVM_TRY_REWRITE(min(max(x, y), min(x, y)), min(x, y));
+      TVM_TRY_REWRITE(min(max(x, y), min(y, x)), min(x, y));
+      TVM_TRY_REWRITE(min(min(x, y), max(x, y)), min(x, y));
+      TVM_TRY_REWRITE(min(min(x, y), max(y, x)), min(x, y));
+
+      TVM_TRY_REWRITE(min(max(x, y), x), x);
+      TVM_TRY_REWRITE(min(max(x, y), y), y);
+      TVM_TRY_REWRITE(min(min(x, y), x), min(x, y));
+      TVM_TRY_REWRITE(min(min(x, y), y), min(x, y));
+
+      TVM_TRY_REWRITE(min(x, max(x, y)), x);
+      TVM_TRY_REWRITE(min(y, max(x, y)), y);
+      TVM_TRY_REWRITE(min(x, min(x, y)), min(x, y));
+      TVM_TRY_REWRITE(min(y, min(x, y)), min(x, y));
+
+      TVM_TRY_REWRITE(min(min(min(x, y), z), y), min(min(x, y), z));
+      TVM_TRY_REWRITE(min(min(min(min(x, y), z), s1), y), min(min(min(x, y), z), s1));
+      TVM_TRY_REWRITE(min(min(min(min(min(x, y), z), s1), s2), y),
+                      min(min(min(min(x, y), z), s1), s2));
+
+      TVM_TRY_REWRITE(min(max(x, y), max(x, z)), max(min(y, z), x));
+      TVM_TRY_REWRITE(min(max(x, y), max(z, x)), max(min(y, z), x));
+      TVM_TRY_REWRITE(min(max(y, x), max(x, z)), max(min(y, z), x));
+      TVM_TRY_REWRITE(min(max(y, x), max(z, x)), max(min(y, z), x));
+
+      TVM_TRY_REWRITE(min(min(x, y), min(x, z)), min(min(y, z), x));
+      TVM_TRY_REWRITE(min(min(x, y), min(z, x)), min(min(y, z), x));
+      TVM_TRY_REWRITE(min(min(y, x), min(x, z)), min(min(y, z), x));
+      TVM_TRY_REWRITE(min(min(y, x), min(z, x)), min(min(y, z), x));
+
+      // constant folding rule.
+      TVM_TRY_REWRITE(min(min(x, c1), c2), min(x, min(c1, c2)));
+    }
 
-    // Divide up rounding: floor div
-    TVM_TRY_REWRITE_IF(min(floordiv(x + c1, c2) * c2, x), x,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(floordiv(x + c1, c2) * c2, max(x, c2)), max(x, c2),
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-
-    TVM_TRY_REWRITE_IF(min(x, floordiv(x + c1, c2) * c2), x,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(min(max(x, c2), floordiv(x + c1, c2) * c2), max(x, c2),
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-
-    TVM_TRY_REWRITE_IF(min(x, floordiv(x, c2) * c2), floordiv(x, c2) * c2, c2.Eval()->value > 0);
-    TVM_TRY_REWRITE_IF(min(floordiv(x, c2) * c2, x), floordiv(x, c2) * c2, c2.Eval()->value > 0);
-
-    TVM_TRY_REWRITE(min(max(x, y), min(x, y)), min(x, y));
-    TVM_TRY_REWRITE(min(max(x, y), min(y, x)), min(x, y));
-    TVM_TRY_REWRITE(min(min(x, y), max(x, y)), min(x, y));
-    TVM_TRY_REWRITE(min(min(x, y), max(y, x)), min(x, y));
-
-    TVM_TRY_REWRITE(min(max(x, y), x), x);
-    TVM_TRY_REWRITE(min(max(x, y), y), y);
-    TVM_TRY_REWRITE(min(min(x, y), x), min(x, y));
-    TVM_TRY_REWRITE(min(min(x, y), y), min(x, y));
-
-    TVM_TRY_REWRITE(min(x, max(x, y)), x);
-    TVM_TRY_REWRITE(min(y, max(x, y)), y);
-    TVM_TRY_REWRITE(min(x, min(x, y)), min(x, y));
-    TVM_TRY_REWRITE(min(y, min(x, y)), min(x, y));
-
-    TVM_TRY_REWRITE(min(min(min(x, y), z), y), min(min(x, y), z));
-    TVM_TRY_REWRITE(min(min(min(min(x, y), z), s1), y), min(min(min(x, y), z), s1));
-    TVM_TRY_REWRITE(min(min(min(min(min(x, y), z), s1), s2), y),
-                    min(min(min(min(x, y), z), s1), s2));
-
-    TVM_TRY_REWRITE(min(max(x, y), max(x, z)), max(min(y, z), x));
-    TVM_TRY_REWRITE(min(max(x, y), max(z, x)), max(min(y, z), x));
-    TVM_TRY_REWRITE(min(max(y, x), max(x, z)), max(min(y, z), x));
-    TVM_TRY_REWRITE(min(max(y, x), max(z, x)), max(min(y, z), x));
-
-    TVM_TRY_REWRITE(min(min(x, y), min(x, z)), min(min(y, z), x));
-    TVM_TRY_REWRITE(min(min(x, y), min(z, x)), min(min(y, z), x));
-    TVM_TRY_REWRITE(min(min(y, x), min(x, z)), min(min(y, z), x));
-    TVM_TRY_REWRITE(min(min(y, x), min(z, x)), min(min(y, z), x));
-
-    TVM_TRY_REWRITE(min(y + x, z + x), min(y, z) + x);
-    TVM_TRY_REWRITE(min(y + x, x + z), min(y, z) + x);
-    TVM_TRY_REWRITE(min(x + y, x + z), min(y, z) + x);
-    TVM_TRY_REWRITE(min(x + y, z + x), min(y, z) + x);
+    if ((akind & kRootAdd) && (bkind & kRootAdd)) {
+      TVM_TRY_REWRITE(min(y + x, z + x), min(y, z) + x);
+      TVM_TRY_REWRITE(min(y + x, x + z), min(y, z) + x);
+      TVM_TRY_REWRITE(min(x + y, x + z), min(y, z) + x);
+      TVM_TRY_REWRITE(min(x + y, z + x), min(y, z) + x);
+    }
 
     // sub distribution
-    TVM_TRY_REWRITE(min(y - x, z - x), min(y, z) - x);
-    TVM_TRY_REWRITE(min(x - y, x - z), x - max(y, z));
-
-    // constant folding rule.
-    TVM_TRY_REWRITE(min(min(x, c1), c2), min(x, min(c1, c2)));
+    if ((akind & kRootSub) && (bkind & kRootSub)) {
+      TVM_TRY_REWRITE(min(y - x, z - x), min(y, z) - x);
+      TVM_TRY_REWRITE(min(x - y, x - z), x - max(y, z));
+    }
 
     // scaling rule
-    if (min(truncdiv(x, c1), truncdiv(y, c1)).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return truncdiv(min(x, y), c1).Eval();
-      } else {
-        return truncdiv(max(x, y), c1).Eval();
-      }
-    }
-    if (min(floordiv(x, c1), floordiv(y, c1)).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return floordiv(min(x, y), c1).Eval();
-      } else {
-        return floordiv(max(x, y), c1).Eval();
-      }
-    }
-    if (min(x * c1, y * c1).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return (min(x, y) * c1).Eval();
-      } else {
-        return (max(x, y) * c1).Eval();
-      }
-    }
-    if (min(x * c1, c2).Match(ret)) {
-      int64_t c1val = c1.Eval()->value;
-      int64_t c2val = c2.Eval()->value;
-      if (c1val == 0) {
-        return c2val < 0 ? c2.Eval() : c1.Eval();
-      }
-      if (c2val % c1val == 0) {
-        if (c1val > 0) {
-          return (min(x, c2val / c1val) * c1val).Eval();
+    if (akind & kRootMul) {
+      if (min(x * c1, y * c1).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return (min(x, y) * c1).Eval();
         } else {
-          return (max(x, c2val / c1val) * c1val).Eval();
+          return (max(x, y) * c1).Eval();
+        }
+      }
+      if (min(x * c1, c2).Match(ret)) {
+        int64_t c1val = c1.Eval()->value;
+        int64_t c2val = c2.Eval()->value;
+        if (c1val == 0) {
+          return c2val < 0 ? c2.Eval() : c1.Eval();
+        }
+        if (c2val % c1val == 0) {
+          if (c1val > 0) {
+            return (min(x, c2val / c1val) * c1val).Eval();
+          } else {
+            return (max(x, c2val / c1val) * c1val).Eval();
+          }
         }
       }
     }
@@ -1065,7 +1203,9 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MinNode* op) {
   }
 
   // condition rules.
-  TVM_TRY_REWRITE(min(select(x, y, z), select(x, s1, s2)), select(x, min(y, s1), min(z, s2)));
+  if (kinds & kRootSelect) {
+    TVM_TRY_REWRITE(min(select(x, y, z), select(x, s1, s2)), select(x, min(y, s1), min(z, s2)));
+  }
   return ret;
 }
 
@@ -1080,6 +1220,10 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MaxNode* op) {
   // Pattern var match IntImm
   PVar<IntImm> c1, c2;
   PVar<int> lanes;
+  // Root kinds of the operands, used to skip pattern groups that cannot match.
+  unsigned akind = GetRootKind(op->a);
+  unsigned bkind = GetRootKind(op->b);
+  unsigned kinds = akind | bkind;
 
   // vector rule
   if (op->dtype.lanes() != 1) {
@@ -1124,100 +1268,112 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MaxNode* op) {
     }
 
     // DivMod rules
-    // Divide up rounding: truc div
-    // NOTE: trucdiv(x, y) >= floordiv(x, y)
-    TVM_TRY_REWRITE_IF(max(truncdiv(x + c1, c2) * c2, x), truncdiv(x + c1, c2) * c2,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, truncdiv(x + c1, c2) * c2), truncdiv(x + c1, c2) * c2,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-
-    // Divide up rounding: floor div
-    TVM_TRY_REWRITE_IF(max(floordiv(x + c1, c2) * c2, x), floordiv(x + c1, c2) * c2,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-    TVM_TRY_REWRITE_IF(max(x, floordiv(x + c1, c2) * c2), floordiv(x + c1, c2) * c2,
-                       c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
-
-    TVM_TRY_REWRITE_IF(max(floordiv(x, c2) * c2, x), x, c2.Eval()->value > 0);
-    TVM_TRY_REWRITE_IF(max(x, floordiv(x, c2) * c2), x, c2.Eval()->value > 0);
-
-    TVM_TRY_REWRITE(max(min(x, y), max(x, y)), max(x, y));
-    TVM_TRY_REWRITE(max(min(x, y), max(y, x)), max(x, y));
-    TVM_TRY_REWRITE(max(max(x, y), min(x, y)), max(x, y));
-    TVM_TRY_REWRITE(max(max(x, y), min(y, x)), max(x, y));
-
-    TVM_TRY_REWRITE(max(min(x, y), x), x);
-    TVM_TRY_REWRITE(max(min(x, y), y), y);
-    TVM_TRY_REWRITE(max(max(x, y), x), max(x, y));
-    TVM_TRY_REWRITE(max(max(x, y), y), max(x, y));
-
-    TVM_TRY_REWRITE(max(x, min(x, y)), x);
-    TVM_TRY_REWRITE(max(y, min(x, y)), y);
-    TVM_TRY_REWRITE(max(x, max(x, y)), max(x, y));
-    TVM_TRY_REWRITE(max(y, max(x, y)), max(x, y));
-
-    TVM_TRY_REWRITE(max(max(max(x, y), z), y), max(max(x, y), z));
-    TVM_TRY_REWRITE(max(max(max(max(x, y), z), s1), y), max(max(max(x, y), z), s1));
-    TVM_TRY_REWRITE(max(max(max(max(max(x, y), z), s1), s2), y),
-                    max(max(max(max(x, y), z), s1), s2));
-
-    // max/max cancelation
-    TVM_TRY_REWRITE(max(max(x, y), max(x, z)), max(max(y, z), x));
-    TVM_TRY_REWRITE(max(max(x, y), max(z, x)), max(max(y, z), x));
-    TVM_TRY_REWRITE(max(max(y, x), max(x, z)), max(max(y, z), x));
-    TVM_TRY_REWRITE(max(max(y, x), max(z, x)), max(max(y, z), x));
-
-    // max/min distribution
-    TVM_TRY_REWRITE(max(min(x, y), min(x, z)), min(max(y, z), x));
-    TVM_TRY_REWRITE(max(min(x, y), min(z, x)), min(max(y, z), x));
-    TVM_TRY_REWRITE(max(min(y, x), min(x, z)), min(max(y, z), x));
-    TVM_TRY_REWRITE(max(min(y, x), min(z, x)), min(max(y, z), x));
+    if (HasDivModNearRoot(op->a) || HasDivModNearRoot(op->b)) {
+      // Divide up rounding: truc div
+      // NOTE: trucdiv(x, y) >= floordiv(x, y)
+      TVM_TRY_REWRITE_IF(max(truncdiv(x + c1, c2) * c2, x), truncdiv(x + c1, c2) * c2,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, truncdiv(x + c1, c2) * c2), truncdiv(x + c1, c2) * c2,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+
+      // Divide up rounding: floor div
+      TVM_TRY_REWRITE_IF(max(floordiv(x + c1, c2) * c2, x), floordiv(x + c1, c2) * c2,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+      TVM_TRY_REWRITE_IF(max(x, floordiv(x + c1, c2) * c2), floordiv(x + c1, c2) * c2,
+                         c2.Eval()->value > 0 && c1.Eval()->value + 1 == c2.Eval()->value);
+
+      TVM_TRY_REWRITE_IF(max(floordiv(x, c2) * c2, x), x, c2.Eval()->value > 0);
+      TVM_TRY_REWRITE_IF(max(x, floordiv(x, c2) * c2), x, c2.Eval()->value > 0);
+
+      // scaling rule
+      if (max(truncdiv(x, c1), truncdiv(y, c1)).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return truncdiv(max(x, y), c1).Eval();
+        } else {
+          return truncdiv(min(x, y), c1).Eval();
+        }
+      }
+      if (max(floordiv(x, c1), floordiv(y, c1)).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return floordiv(max(x, y), c1).Eval();
+        } else {
+          return floordiv(min(x, y), c1).Eval();
+        }
+      }
+    }
+
+    if (kinds & kRootMinMax) {
+      TVM_TRY_REWRITE(max(min(x, y), max(x, y)), max(x, y));
+      TVM_TRY_REWRITE(max(min(x, y), max(y, x)), max(x, y));
+      TVM_TRY_REWRITE(max(max(x, y), min(x, y)), max(x, y));
+      TVM_TRY_REWRITE(max(max(x, y), min(y, x)), max(x, y));
+
+      TVM_TRY_REWRITE(max(min(x, y), x), x);
+      TVM_TRY_REWRITE(max(min(x, y), y), y);
+      TVM_TRY_REWRITE(max(max(x, y), x), max(x, y));
+      TVM_TRY_REWRITE(max(max(x, y), y), max(x, y));
+
+      TVM_TRY_REWRITE(max(x, min(x, y)), x);
+      TVM_TRY_REWRITE(max(y, min(x, y)), y);
+      TVM_TRY_REWRITE(max(x, max(x, y)), max(x, y));
+      TVM_TRY_REWRITE(max(y, max(x, y)), max(x, y));
+
+      TVM_TRY_REWRITE(max(max(max(x, y), z), y), max(max(x, y), z));
+      TVM_TRY_REWRITE(max(max(max(max(x, y), z), s1), y), max(max(max(x, y), z), s1));
+      TVM_TRY_REWRITE(max(max(max(max(max(x, y), z), s1), s2), y),
+                      max(max(max(max(x, y), z), s1), s2));
+
+      // max/max cancelation
+      TVM_TRY_REWRITE(max(max(x, y), max(x, z)), max(max(y, z), x));
+      TVM_TRY_REWRITE(max(max(x, y), max(z, x)), max(max(y, z), x));
+      TVM_TRY_REWRITE(max(max(y, x), max(x, z)), max(max(y, z), x));
+      TVM_TRY_REWRITE(max(max(y, x), max(z, x)), max(max(y, z), x));
+
+      // max/min distribution
+      TVM_TRY_REWRITE(max(min(x, y), min(x, z)), min(max(y, z), x));
+      TVM_TRY_REWRITE(max(min(x, y), min(z, x)), min(max(y, z), x));
+      TVM_TRY_REWRITE(max(min(y, x), min(x, z)), min(max(y, z), x));
+      TVM_TRY_REWRITE(max(min(y, x), min(z, x)), min(max(y, z), x));
+
+      // constant folding rule.
+      TVM_TRY_REWRITE(max(max(x, c1), c2), max(x, max(c1, c2)));
+    }
 
     // add distribution
-    TVM_TRY_REWRITE(max(y + x, z + x), max(y, z) + x);
-    TVM_TRY_REWRITE(max(y + x, x + z), max(y, z) + x);
-    TVM_TRY_REWRITE(max(x + y, x + z), max(y, z) + x);
-    TVM_TRY_REWRITE(max(x + y, z + x), max(y, z) + x);
+    if ((akind & kRootAdd) && (bkind & kRootAdd)) {
+      TVM_TRY_REWRITE(max(y + x, z + x), max(y, z) + x);
+      TVM_TRY_REWRITE(max(y + x, x + z), max(y, z) + x);
+      TVM_TRY_REWRITE(max(x + y, x + z), max(y, z) + x);
+      TVM_TRY_REWRITE(max(x + y, z + x), max(y, z) + x);
+    }
 
     // sub distribution
-    TVM_TRY_REWRITE(max(y - x, z - x), max(y, z) - x);
-    TVM_TRY_REWRITE(max(x - y, x - z), x - min(y, z));
-
-    // constant folding rule.
-    TVM_TRY_REWRITE(max(max(x, c1), c2), max(x, max(c1, c2)));
+    if ((akind & kRootSub) && (bkind & kRootSub)) {
+      TVM_TRY_REWRITE(max(y - x, z - x), max(y, z) - x);
+      TVM_TRY_REWRITE(max(x - y, x - z), x - min(y, z));
+    }
 
     // scaling rule
-    if (max(truncdiv(x, c1), truncdiv(y, c1)).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return truncdiv(max(x, y), c1).Eval();
-      } else {
-        return truncdiv(min(x, y), c1).Eval();
-      }
-    }
-    if (max(floordiv(x, c1), floordiv(y, c1)).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return floordiv(max(x, y), c1).Eval();
-      } else {
-        return floordiv(min(x, y), c1).Eval();
-      }
-    }
-    if (max(x * c1, y * c1).Match(ret)) {
-      if (c1.Eval()->value > 0) {
-        return (max(x, y) * c1).Eval();
-      } else {
-        return (min(x, y) * c1).Eval();
-      }
-    }
-    if (max(x * c1, c2).Match(ret)) {
-      int64_t c1val = c1.Eval()->value;
-      int64_t c2val = c2.Eval()->value;
-      if (c1val == 0) {
-        return c2val > 0 ? c2.Eval() : c1.Eval();
-      }
-      if (c2val % c1val == 0) {
-        if (c1val > 0) {
-          return (max(x, c2val / c1val) * c1val).Eval();
+    if (akind & kRootMul) {
+      if (max(x * c1, y * c1).Match(ret)) {
+        if (c1.Eval()->value > 0) {
+          return (max(x, y) * c1).Eval();
         } else {
-          return (min(x, c2val / c1val) * c1val).Eval();
+          return (min(x, y) * c1).Eval();
+        }
+      }
+      if (max(x * c1, c2).Match(ret)) {
+        int64_t c1val = c1.Eval()->value;
+        int64_t c2val = c2.Eval()->value;
+        if (c1val == 0) {
+          return c2val > 0 ? c2.Eval() : c1.Eval();
+        }
+        if (c2val % c1val == 0) {
+          if (c1val > 0) {
+            return (max(x, c2val / c1val) * c1val).Eval();
+          } else {
+            return (min(x, c2val / c1val) * c1val).Eval();
+          }
         }
       }
     }
@@ -1228,7 +1384,9 @@ PrimExpr RewriteSimplifier::Impl::VisitExpr_(const MaxNode* op) {
   }
 
   // condition rules.
-  TVM_TRY_REWRITE(max(select(x, y, z), select(x, s1, s2)), select(x, max(y, s1), max(z, s2)));
+  if (kinds & kRootSelect) {
+    TVM_TRY_REWRITE(max(select(x, y, z), select(x, s1, s2)), select(x, max(y, s1), max(z, s2)));
+  }
   return ret;
 }
 
@@ -1610,6 +1768,8 @@ void RewriteSimplifier::Update(const Var& var, const PrimExpr& info, bool allow_
   impl_->Update(var, info, allow_override);
 }
 
+void RewriteSimplifier::ResetMemo() { impl_->ResetMemo(); }
+
 std::function<void()> RewriteSimplifier::EnterConstraint(const PrimExpr& constraint) {
   return impl_->EnterConstraint(constraint);
 }
@@ -51,6 +51,7 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
   explicit Impl(Analyzer* parent) : IRMutatorWithAnalyzer(parent) {}
 
   void Update(const Var& var, const PrimExpr& info, bool override_info);
+  PrimExpr VisitExpr(const PrimExpr& expr) override;
   PrimExpr VisitExpr_(const AddNode* op) override;
   PrimExpr VisitExpr_(const SubNode* op) override;
   PrimExpr VisitExpr_(const MulNode* op) override;
@@ -77,6 +78,9 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   std::function<void()> EnterConstraint(const PrimExpr& constraint);
 
+  /*! \brief Reset the memo table of simplified results. */
+  void ResetMemo() { memo_.clear(); }
+
  protected:
   /*! \brief internal structure for comparison. */
   enum CompareResult { kUnknown, kEQ, kGT, kGE, kLT, kLE, kNE };
@@ -87,8 +91,17 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
 
   std::vector<PrimExpr> literal_constraints_;
 
+  // Memo table from expression to simplified result. The expressions handed to the
+  // simplifier by InferBound and the storage passes share many identical subtrees, so
+  // hits are keyed by object identity, which is much cheaper than structural hashing.
+  // The table is reset whenever the known facts change: on Update, when entering or
+  // leaving a constraint scope, and when bounds are registered on the parent analyzer.
+  std::unordered_map<PrimExpr, PrimExpr, ObjectPtrHash, ObjectPtrEqual> memo_;
+
   // maximum number of recursion allowed during a single pass.
   static const constexpr int kMaxRecurDepth = 5;
+  // maximum size of the memo table before it is cleared wholesale.
+  static const constexpr size_t kMaxMemoSize = 100000;
 
   /*!
    * \brief try to compare x against val.
@@ -105,6 +118,43 @@ class RewriteSimplifier::Impl : public IRMutatorWithAnalyzer {
    */
   bool CanInlineLet(const LetNode* op);
 
+  // Bitmask of the root operator kind of an operand. Trying a pattern is not free --
+  // every attempt re-walks the operand trees -- so the visitors group their rewrite
+  // patterns by the operator kinds required at an operand root and skip whole groups
+  // that cannot possibly match.
+  enum RootKindMask : unsigned {
+    kRootOther = 0,
+    kRootAdd = 1 << 0,
+    kRootSub = 1 << 1,
+    kRootMul = 1 << 2,
+    kRootDivMod = 1 << 3,
+    kRootMinMax = 1 << 4,
+    kRootSelect = 1 << 5,
+  };
+
+  static unsigned GetRootKind(const PrimExpr& expr) {
+    if (expr->IsInstance<AddNode>()) return kRootAdd;
+    if (expr->IsInstance<SubNode>()) return kRootSub;
+    if (expr->IsInstance<MulNode>()) return kRootMul;
+    if (expr->IsInstance<DivNode>() || expr->IsInstance<ModNode>() ||
+        expr->IsInstance<FloorDivNode>() || expr->IsInstance<FloorModNode>()) {
+      return kRootDivMod;
+    }
+    if (expr->IsInstance<MinNode>() || expr->IsInstance<MaxNode>()) return kRootMinMax;
+    if (expr->IsInstance<SelectNode>()) return kRootSelect;
+    return kRootOther;
+  }
+
+  // Whether a division or remainder occurs at the operand root or directly under a root
+  // multiplication, which is the deepest position the DivMod pattern groups refer to one in.
+  static bool HasDivModNearRoot(const PrimExpr& expr) {
+    if (GetRootKind(expr) == kRootDivMod) return true;
+    if (const auto* mul = expr.as<MulNode>()) {
+      return GetRootKind(mul->a) == kRootDivMod || GetRootKind(mul->b) == kRootDivMod;
+    }
+    return false;
+  }
+
  private:
   // Whether x >= val
   bool CanProveGreaterEqual(const PrimExpr& x, int64_t val) {
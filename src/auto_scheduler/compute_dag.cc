@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <queue>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -1299,9 +1300,50 @@ String ComputeDAG::PrintDAG(bool simple_mode) const {
   return String(ss.str());
 }
 
+bool InferBoundMemo::Lookup(const std::string& key, State* out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = memo_.find(key);
+  if (it == memo_.end()) {
+    return false;
+  }
+  *out = it->second;
+  return true;
+}
+
+void InferBoundMemo::Add(const std::string& key, const State& state) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (memo_.size() >= kMaxEntries) {
+    memo_.clear();
+  }
+  memo_.emplace(key, state);
+}
+
+// Serialize transform steps in their record format to key the InferBound memo.
+std::string SerializeTransformSteps(const Array<Step>& transform_steps) {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray(false);
+  for (const auto& step : transform_steps) {
+    writer.WriteArraySeperator();
+    writer.BeginArray(false);
+    step->WriteToRecord(&writer);
+    writer.EndArray();
+  }
+  writer.EndArray();
+  return os.str();
+}
+
 State ComputeDAG::InferBound(const State& state) const {
   ICHECK(state->concrete) << "Only concrete state can be processed to get bound info.";
 
+  // The bound information is a deterministic function of the transform steps,
+  // so identical step sequences can reuse the memoized result.
+  std::string memo_key = SerializeTransformSteps(state->transform_steps);
+  State cached;
+  if (operator->()->infer_bound_memo.Lookup(memo_key, &cached)) {
+    return cached;
+  }
+
   State ret_state;
   StateNode* pstate;
 
@@ -1358,21 +1400,27 @@ State ComputeDAG::InferBound(const State& state) const {
         i, Stage(stage->op, stage->op_type, new_iters, stage->compute_at, stage->attrs));
   }
 
+  operator->()->infer_bound_memo.Add(memo_key, ret_state);
   return ret_state;
 }
 
 Array<State> ComputeDAG::InferBound(const Array<State>& states) const {
   Array<State> out_states(states.size(), State());
 
-  support::parallel_for(0, states.size(), [this, &states, &out_states](int i) {
-    try {
-      out_states.Set(i, (states[i].defined()) ? this->InferBound(states[i]) : states[i]);
-    } catch (Error& e) {
-      LOG(WARNING) << "InferBound fails on the state:\n"
-                   << states[i] << "\n"
-                   << "with: " << e.what() << std::endl;
-    }
-  });
+  // The time InferBound takes varies a lot across states, so claim the states
+  // dynamically instead of a static partition.
+  support::parallel_for_dynamic(0, states.size(), std::thread::hardware_concurrency(),
+                                [this, &states, &out_states](int, int i) {
+                                  try {
+                                    out_states.Set(i, (states[i].defined())
+                                                          ? this->InferBound(states[i])
+                                                          : states[i]);
+                                  } catch (Error& e) {
+                                    LOG(WARNING) << "InferBound fails on the state:\n"
+                                                 << states[i] << "\n"
+                                                 << "with: " << e.what() << std::endl;
+                                  }
+                                });
 
   return out_states;
 }
@@ -23,12 +23,24 @@
  */
 
 #include <tvm/auto_scheduler/cost_model.h>
+#include <tvm/auto_scheduler/feature.h>
+#include <tvm/support/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace tvm {
 namespace auto_scheduler {
 
 TVM_REGISTER_OBJECT_TYPE(CostModelNode);
 TVM_REGISTER_OBJECT_TYPE(RandomModelNode);
+TVM_REGISTER_OBJECT_TYPE(MLPModelNode);
 TVM_REGISTER_OBJECT_TYPE(PythonBasedModelNode);
 
 RandomModel::RandomModel() {
@@ -48,6 +60,161 @@ void RandomModelNode::Predict(const SearchTask& task, const Array<State>& states
   (*random_number_func)(states.size(), static_cast<void*>(scores->data()));
 }
 
+// Reduce the variable number of per-store feature blocks of one state into a
+// single fixed-width sample by taking the mean of the blocks. Returns false
+// when the state failed feature extraction.
+bool PoolStoreFeatures(const std::vector<float>& row, int* feature_size, std::vector<float>* out) {
+  if (row.size() <= 1) {
+    return false;
+  }
+  int n_stores = static_cast<int>(row[0]);
+  if (n_stores <= 0 || (row.size() - 1) % n_stores != 0) {
+    return false;
+  }
+  int width = static_cast<int>((row.size() - 1) / n_stores);
+  if (*feature_size == 0) {
+    *feature_size = width;
+  } else if (width != *feature_size) {
+    return false;
+  }
+  out->assign(width, 0.0f);
+  for (int i = 0; i < n_stores; ++i) {
+    const float* block = row.data() + 1 + i * width;
+    for (int k = 0; k < width; ++k) {
+      (*out)[k] += block[k];
+    }
+  }
+  for (int k = 0; k < width; ++k) {
+    (*out)[k] /= n_stores;
+  }
+  return true;
+}
+
+MLPModel::MLPModel() { data_ = make_object<MLPModelNode>(); }
+
+void MLPModelNode::Update(const Array<MeasureInput>& inputs,
+                          const Array<MeasureResult>& results) {
+  for (const auto& x : inputs) {
+    measured_inputs.push_back(x);
+  }
+  for (const auto& x : results) {
+    measured_results.push_back(x);
+  }
+
+  // Retrain from scratch on the full measured set, like the python models do.
+  std::vector<std::vector<float>> features;
+  std::vector<float> throughputs;
+  std::vector<int> task_ids;
+  GetPerStoreFeaturesFromMeasurePairs(measured_inputs, measured_results, 0, max_n_bufs, &features,
+                                      &throughputs, &task_ids);
+
+  std::vector<std::vector<float>> samples;
+  std::vector<float> labels;
+  std::vector<float> pooled;
+  for (size_t i = 0; i < features.size(); ++i) {
+    if (PoolStoreFeatures(features[i], &feature_size, &pooled)) {
+      samples.push_back(pooled);
+      labels.push_back(throughputs[i]);
+    }
+  }
+  if (samples.empty()) {
+    return;
+  }
+
+  std::mt19937 rng(0);
+  if (w1.empty()) {
+    // Uniform Glorot initialization.
+    float scale1 = std::sqrt(6.0f / (feature_size + hidden_size));
+    float scale2 = std::sqrt(6.0f / (hidden_size + 1));
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    w1.resize(static_cast<size_t>(hidden_size) * feature_size);
+    b1.assign(hidden_size, 0.0f);
+    w2.resize(hidden_size);
+    for (auto& w : w1) {
+      w = dist(rng) * scale1;
+    }
+    for (auto& w : w2) {
+      w = dist(rng) * scale2;
+    }
+    b2 = 0.0f;
+  }
+
+  // Plain SGD on the squared error with per-sample updates.
+  const int num_epochs = 30;
+  const float lr = 1e-3f;
+  std::vector<int> order(samples.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<float> hidden(hidden_size);
+  for (int epoch = 0; epoch < num_epochs; ++epoch) {
+    std::shuffle(order.begin(), order.end(), rng);
+    for (int idx : order) {
+      const float* x = samples[idx].data();
+      // Forward, keeping the hidden activations for the backward step.
+      float pred = b2;
+      for (int j = 0; j < hidden_size; ++j) {
+        const float* w = w1.data() + static_cast<size_t>(j) * feature_size;
+        float acc = b1[j];
+        for (int k = 0; k < feature_size; ++k) {
+          acc += w[k] * x[k];
+        }
+        hidden[j] = acc > 0.0f ? acc : 0.0f;
+        pred += w2[j] * hidden[j];
+      }
+      // Backward.
+      float err = pred - labels[idx];
+      b2 -= lr * err;
+      for (int j = 0; j < hidden_size; ++j) {
+        float grad_out = err * w2[j];
+        w2[j] -= lr * err * hidden[j];
+        if (hidden[j] > 0.0f) {
+          float* w = w1.data() + static_cast<size_t>(j) * feature_size;
+          b1[j] -= lr * grad_out;
+          for (int k = 0; k < feature_size; ++k) {
+            w[k] -= lr * grad_out * x[k];
+          }
+        }
+      }
+    }
+  }
+}
+
+void MLPModelNode::Predict(const SearchTask& task, const Array<State>& states,
+                           std::vector<float>* scores) {
+  scores->assign(states.size(), 0.0f);
+  if (w1.empty()) {
+    // Not trained yet; every state scores the same.
+    return;
+  }
+
+  std::vector<std::vector<float>> features;
+  GetPerStoreFeaturesFromStates(states, task, 0, max_n_bufs, &features);
+
+  support::parallel_for_dynamic(
+      0, states.size(), std::thread::hardware_concurrency(),
+      [this, &features, &scores](int, int i) {
+        std::vector<float> pooled;
+        int width = feature_size;
+        if (!PoolStoreFeatures(features[i], &width, &pooled)) {
+          // States that fail lowering never get picked.
+          (*scores)[i] = -std::numeric_limits<float>::infinity();
+          return;
+        }
+        const float* x = pooled.data();
+        float pred = b2;
+        for (int j = 0; j < hidden_size; ++j) {
+          const float* w = w1.data() + static_cast<size_t>(j) * feature_size;
+          float acc = b1[j];
+          for (int k = 0; k < feature_size; ++k) {
+            acc += w[k] * x[k];
+          }
+          if (acc > 0.0f) {
+            pred += w2[j] * acc;
+          }
+        }
+        (*scores)[i] = pred;
+      });
+}
+
 PythonBasedModel::PythonBasedModel(PackedFunc update_func, PackedFunc predict_func,
                                    PackedFunc predict_stage_func) {
   auto node = make_object<PythonBasedModelNode>();
@@ -147,6 +314,8 @@ void PythonBasedModelNode::PredictStages(const SearchTask& task, const Array<Sta
 
 TVM_REGISTER_GLOBAL("auto_scheduler.RandomModel").set_body_typed([]() { return RandomModel(); });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.MLPModel").set_body_typed([]() { return MLPModel(); });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.PythonBasedModel")
     .set_body_typed([](PackedFunc update_func, PackedFunc predict_func,
                        PackedFunc predict_stage_func) {
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -1025,6 +1026,13 @@ void GetPerStoreFeature(const Stmt& stmt, int cache_line_size, int max_n_bufs,
   PerStoreFeatureExtractor extractor(cache_line_size);
   extractor(stmt);
 
+  // Reserve the whole feature vector up front; each store contributes a
+  // fixed-width block (57 + max_n_bufs * 18 + ARITH_INTENSITY_CURVE_SAMPLE_N + 7,
+  // see the section totals in GetPerStoreFeatureName).
+  const size_t size_per_store =
+      57 + static_cast<size_t>(max_n_bufs) * 18 + ARITH_INTENSITY_CURVE_SAMPLE_N + 7;
+  ret->reserve(ret->size() + 1 + extractor.buffer_features.size() * size_per_store);
+
   ret->push_back(extractor.buffer_features.size());
 
   for (const auto& x : extractor.buffer_features) {
@@ -1341,11 +1349,14 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask&
 
   std::atomic<int> error_ct(0);
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&task, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  // The lowering time varies a lot across candidate states, so schedule the
+  // extraction dynamically instead of a static partition.
+  support::parallel_for_dynamic(skip_first_n_feature_extraction, states.size(),
+                                std::thread::hardware_concurrency(),
+                                [&task, &states, &max_n_bufs, &features, &error_ct](int, int i) {
+                                  GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
+                                                                &(*features)[i], &error_ct);
+                                });
 }
 
 void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector<SearchTask>& tasks,
@@ -1356,11 +1367,12 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector
 
   std::atomic<int> error_ct(0);
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&tasks, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(tasks[i], states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  support::parallel_for_dynamic(skip_first_n_feature_extraction, states.size(),
+                                std::thread::hardware_concurrency(),
+                                [&tasks, &states, &max_n_bufs, &features, &error_ct](int, int i) {
+                                  GetPerStoreFeaturesWorkerFunc(tasks[i], states[i], max_n_bufs,
+                                                                &(*features)[i], &error_ct);
+                                });
 }
 
 void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int max_n_bufs,
@@ -1557,7 +1569,7 @@ TVMByteArray SerializeFeatures(std::vector<std::vector<float>>&& features,
   ICHECK_EQ(size_vector.size(), size_vector_size);
 
   // allocate memory
-  out_data->reserve(total_bytes);
+  out_data->resize(total_bytes);
   char* ptr = out_data->data();
 
   // serialize size_vector
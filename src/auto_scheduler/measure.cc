@@ -23,12 +23,24 @@
  */
 
 #include <tvm/auto_scheduler/measure.h>
+#include <tvm/driver/driver_api.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
+#include <tvm/tir/analysis.h>
 
 #include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "search_policy/empty_policy.h"
 #include "search_policy/sketch_policy.h"
+#include "search_policy/utils.h"
 #include "utils.h"
 
 namespace tvm {
@@ -105,6 +117,188 @@ MeasureResult MeasureResultNode::copy() const {
   return MeasureResult(node);
 }
 
+/********** Native build & run fallback **********/
+
+/*! \brief The cost reported for a measurement that errored out. */
+static const double kMaxCost = 1e10;
+
+/*! \brief Get the current time in seconds since epoch. */
+inline double CurrentTimestamp() {
+  return std::chrono::duration_cast<std::chrono::duration<double>>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/*!
+ * \brief A process-wide table holding the modules built by the native builder.
+ *
+ * The native builder keeps built modules in memory and hands the runner an opaque key in
+ * BuildResult::filename instead of exporting a shared library, which would require invoking
+ * a host compiler. The native runner pops the module from this table; filenames that are not
+ * found here are treated as real files and loaded from disk.
+ */
+class NativeBuildCache {
+ public:
+  static NativeBuildCache* Global() {
+    static NativeBuildCache* inst = new NativeBuildCache();
+    return inst;
+  }
+
+  String Add(runtime::Module mod) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string key = "native-build://" + std::to_string(counter_++);
+    mods_[key] = std::move(mod);
+    return key;
+  }
+
+  bool Pop(const std::string& key, runtime::Module* out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = mods_.find(key);
+    if (it == mods_.end()) {
+      return false;
+    }
+    *out = it->second;
+    mods_.erase(it);
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  uint64_t counter_{0};
+  std::unordered_map<std::string, runtime::Module> mods_;
+};
+
+/*!
+ * \brief Build the programs of the measure inputs in-process.
+ *
+ * This is used when the Python-side builder is not registered, e.g. when tuning from a pure
+ * C++ deployment. Lowering and codegen errors are caught and turned into error BuildResults.
+ * Unlike the Python path there is no process isolation, so `timeout` is not enforced here.
+ */
+Array<BuildResult> NativeBuildPrograms(const Array<MeasureInput>& inputs, int n_parallel) {
+  std::vector<BuildResult> results(inputs.size(), BuildResult());
+  int num_threads = n_parallel > 0 ? n_parallel : std::thread::hardware_concurrency();
+  support::parallel_for_dynamic(
+      0, inputs.size(), num_threads, [&inputs, &results](int, int i) {
+        const SearchTask& task = inputs[i]->task;
+        auto t_begin = std::chrono::high_resolution_clock::now();
+        try {
+          te::Schedule sch;
+          Array<te::Tensor> args;
+          std::tie(sch, args) = task->compute_dag.ApplySteps(inputs[i]->state->transform_steps);
+          runtime::Module mod =
+              build(lower(sch, args, "main", {}), task->target, task->target_host);
+          double cost = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::high_resolution_clock::now() - t_begin)
+                            .count();
+          results[i] = BuildResult(NativeBuildCache::Global()->Add(std::move(mod)), args,
+                                   static_cast<int>(MeasureErrorNO::kNoError), "", cost);
+        } catch (const std::exception& e) {
+          double cost = std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::high_resolution_clock::now() - t_begin)
+                            .count();
+          results[i] = BuildResult("", Array<te::Tensor>(),
+                                   static_cast<int>(MeasureErrorNO::kCompileHostError), e.what(),
+                                   cost);
+        }
+      });
+  return Array<BuildResult>(results.begin(), results.end());
+}
+
+/*!
+ * \brief Run the built programs in-process with the time evaluator.
+ *
+ * This is used when the Python-side runner is not registered. Programs are run one after
+ * another so measurements do not disturb each other. Runtime errors are caught and turned
+ * into error MeasureResults; `timeout` is not enforced as there is no process isolation.
+ */
+Array<MeasureResult> NativeRunPrograms(const Array<MeasureInput>& inputs,
+                                       const Array<BuildResult>& build_results, int number,
+                                       int repeat, int min_repeat_ms, double cooldown_interval,
+                                       bool enable_cpu_cache_flush) {
+  const auto* time_evaluator = runtime::Registry::Get("runtime.RPCTimeEvaluator");
+  ICHECK(time_evaluator != nullptr) << "runtime.RPCTimeEvaluator is not registered";
+  const auto* random_fill = runtime::Registry::Get("tvm.contrib.random.random_fill");
+
+  Array<MeasureResult> results;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const SearchTask& task = inputs[i]->task;
+    const BuildResult& build_res = build_results[i];
+    if (build_res->error_no != static_cast<int>(MeasureErrorNO::kNoError)) {
+      // Pass through the build error.
+      results.push_back(MeasureResult({FloatImm(DataType::Float(64), kMaxCost)},
+                                      build_res->error_no, build_res->error_msg,
+                                      build_res->time_cost, CurrentTimestamp()));
+      continue;
+    }
+
+    auto t_begin = std::chrono::high_resolution_clock::now();
+    try {
+      runtime::Module mod;
+      if (!NativeBuildCache::Global()->Pop(build_res->filename, &mod)) {
+        mod = runtime::Module::LoadFromFile(build_res->filename);
+      }
+      Device dev;
+      dev.device_type = static_cast<DLDeviceType>(task->target->kind->device_type);
+      dev.device_id = 0;
+      PackedFunc timer =
+          (*time_evaluator)(mod, "main", static_cast<int>(dev.device_type), dev.device_id, number,
+                            repeat, min_repeat_ms,
+                            enable_cpu_cache_flush ? "cache_flush_cpu_non_first_arg" : "");
+
+      // Allocate (and optionally randomly fill) the arguments.
+      std::vector<runtime::NDArray> arrays;
+      for (const te::Tensor& arg : build_res->args) {
+        std::vector<int64_t> shape;
+        for (const PrimExpr& dim : arg->shape) {
+          shape.push_back(GetIntImm(dim));
+        }
+        runtime::NDArray array = runtime::NDArray::Empty(shape, arg->dtype, dev);
+        if (random_fill != nullptr) {
+          (*random_fill)(array);
+        }
+        arrays.push_back(array);
+      }
+      runtime::DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
+
+      std::vector<TVMValue> values(arrays.size());
+      std::vector<int> type_codes(arrays.size());
+      runtime::TVMArgsSetter setter(values.data(), type_codes.data());
+      for (size_t k = 0; k < arrays.size(); ++k) {
+        setter(k, arrays[k]);
+      }
+      TVMRetValue ret;
+      timer.CallPacked(TVMArgs(values.data(), type_codes.data(), arrays.size()), &ret);
+
+      std::string blob = ret;
+      const double* speeds = reinterpret_cast<const double*>(blob.data());
+      Array<PrimExpr> costs;
+      for (size_t k = 0; k < blob.size() / sizeof(double); ++k) {
+        costs.push_back(FloatImm(DataType::Float(64), speeds[k]));
+      }
+      double all_cost = build_res->time_cost +
+                        std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::high_resolution_clock::now() - t_begin)
+                            .count();
+      results.push_back(MeasureResult(costs, static_cast<int>(MeasureErrorNO::kNoError), "",
+                                      all_cost, CurrentTimestamp()));
+    } catch (const std::exception& e) {
+      double all_cost = build_res->time_cost +
+                        std::chrono::duration_cast<std::chrono::duration<double>>(
+                            std::chrono::high_resolution_clock::now() - t_begin)
+                            .count();
+      results.push_back(MeasureResult({FloatImm(DataType::Float(64), kMaxCost)},
+                                      static_cast<int>(MeasureErrorNO::kRuntimeDeviceError),
+                                      e.what(), all_cost, CurrentTimestamp()));
+    }
+
+    if (cooldown_interval > 0) {
+      std::this_thread::sleep_for(std::chrono::duration<double>(cooldown_interval));
+    }
+  }
+  return results;
+}
+
 /********** LocalBuilder **********/
 LocalBuilder::LocalBuilder(int timeout, int n_parallel, const String& build_func) {
   auto node = make_object<LocalBuilderNode>();
@@ -119,10 +313,8 @@ Array<BuildResult> LocalBuilderNode::Build(const Array<MeasureInput>& inputs, in
     Array<BuildResult> results = (*f)(inputs, timeout, n_parallel, build_func, verbose);
     return results;
   }
-  LOG(FATAL) << "auto_scheduler.local_builder.build is not registered. "
-             << "This is a function registered in Python, "
-             << "make sure the TVM Python runtime has been loaded successfully.";
-  throw;
+  // Fall back to building in-process when the Python runtime is not loaded.
+  return NativeBuildPrograms(inputs, n_parallel);
 }
 
 /********** LocalRunner **********/
@@ -146,10 +338,9 @@ Array<MeasureResult> LocalRunnerNode::Run(const Array<MeasureInput>& inputs,
              enable_cpu_cache_flush, verbose);
     return results;
   }
-  LOG(FATAL) << "auto_scheduler.local_runner.run is not registered. "
-             << "This is a function registered in Python, "
-             << "make sure the TVM Python runtime has been loaded successfully.";
-  throw;
+  // Fall back to running in-process when the Python runtime is not loaded.
+  return NativeRunPrograms(inputs, build_results, number, repeat, min_repeat_ms, cooldown_interval,
+                           enable_cpu_cache_flush);
 }
 
 /********** RPCRunner **********/
@@ -206,6 +397,41 @@ void PythonBasedMeasureCallbackNode::Callback(const SearchPolicy& policy,
 }
 
 /********** ProgramMeasurer **********/
+
+/*!
+ * \brief Lower one candidate and check it against the device limits of its task.
+ *
+ * This runs the same lowering the builder will run and verifies shared/local
+ * memory per block, threads per block, vthread extent and vector width against
+ * the task's hardware parameters, the same constraints the cost model applies
+ * during feature extraction. Returns an empty string when the candidate fits
+ * and a short diagnostic otherwise. Lowering errors propagate as exceptions.
+ */
+String StaticCheckGPULimits(const SearchTask& task, const State& state) {
+  te::Schedule sch;
+  Array<te::Tensor> args;
+  std::tie(sch, args) = task->compute_dag.ApplySteps(state->transform_steps);
+  IRModule mod = lower(sch, args, "main", {});
+
+  Map<String, PrimExpr> constraints{
+      {"max_shared_memory_per_block", task->hardware_params->max_shared_memory_per_block},
+      {"max_local_memory_per_block", task->hardware_params->max_local_memory_per_block},
+      {"max_threads_per_block", task->hardware_params->max_threads_per_block},
+      {"max_vector_bytes", task->hardware_params->vector_unit_bytes},
+      {"max_vthread", task->hardware_params->max_vthread_extent},
+  };
+  for (const auto& kv : mod->functions) {
+    if (const auto* func = kv.second.as<tir::PrimFuncNode>()) {
+      if (!tir::VerifyGPUCode(GetRef<tir::PrimFunc>(func), constraints)) {
+        return "Rejected by the static device limit check: the lowered code exceeds a hardware "
+               "budget (shared/local memory per block, threads per block, vthread extent or "
+               "vector width).";
+      }
+    }
+  }
+  return "";
+}
+
 ProgramMeasurer::ProgramMeasurer(ProgramBuilder builder, ProgramRunner runner,
                                  Optional<Array<MeasureCallback>> callbacks, int verbose,
                                  int max_continuous_error) {
@@ -314,13 +540,50 @@ void ProgramMeasurerNode::SilentMeasure(const SearchTask& task, const Array<Meas
   results->clear();
   results->reserve(inputs.size());
 
-  // Call builder and runner
-  Array<BuildResult> build_res_batch = builder->Build(inputs, verbose);
-  Array<MeasureResult> result_batch = runner->Run(inputs, build_res_batch, verbose);
+  // Statically reject candidates that can never run on the device (shared
+  // memory overflow, too many threads per block, ...) so they do not burn a
+  // build and measurement slot. CPU tasks have no such limits to check.
+  std::vector<MeasureResult> rejected(inputs.size(), MeasureResult());
+  if (IsGPUTask(task)) {
+    support::parallel_for_dynamic(0, inputs.size(), std::thread::hardware_concurrency(),
+                                  [&task, &inputs, &rejected](int, int i) {
+                                    std::string error_msg;
+                                    try {
+                                      error_msg = StaticCheckGPULimits(task, inputs[i]->state);
+                                    } catch (const std::exception& e) {
+                                      error_msg = e.what();
+                                    }
+                                    if (!error_msg.empty()) {
+                                      rejected[i] = MeasureResult(
+                                          {FloatImm(DataType::Float(64), kMaxCost)},
+                                          static_cast<int>(MeasureErrorNO::kInstantiationError),
+                                          error_msg, 0.0, CurrentTimestamp());
+                                    }
+                                  });
+  }
+
+  Array<MeasureInput> valid_inputs;
+  std::vector<size_t> valid_pos;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (!rejected[i].defined()) {
+      valid_inputs.push_back(inputs[i]);
+      valid_pos.push_back(i);
+    }
+  }
+
+  // Call builder and runner on the surviving candidates
+  std::vector<MeasureResult> result_batch(inputs.size(), MeasureResult());
+  if (!valid_inputs.empty()) {
+    Array<BuildResult> build_res_batch = builder->Build(valid_inputs, verbose);
+    Array<MeasureResult> run_res_batch = runner->Run(valid_inputs, build_res_batch, verbose);
+    for (size_t k = 0; k < valid_pos.size(); ++k) {
+      result_batch[valid_pos[k]] = run_res_batch[k];
+    }
+  }
 
-  // Store result batch
-  for (auto& res : result_batch) {
-    results->push_back(res);
+  // Store result batch, rejected and measured results interleaved in input order
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    results->push_back(rejected[i].defined() ? rejected[i] : result_batch[i]);
   }
 }
 
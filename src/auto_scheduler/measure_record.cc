@@ -31,6 +31,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -403,6 +404,150 @@ std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordReaderNode::ReadLines
   return std::make_pair(inputs, results);
 }
 
+/*! \brief Version of the sidecar record index format. */
+static constexpr int kRecordIndexVersion = 1;
+
+/*! \brief Get the path of the sidecar index of a record log file. */
+inline std::string GetRecordIndexPath(const std::string& filename) { return filename + ".idx"; }
+
+/*!
+ * \brief The sidecar index of a record log file.
+ *
+ * For every (workload key, target) pair seen in the log, the index keeps the byte offset and
+ * the cost of the best valid record, so best-record queries only parse one line per workload
+ * instead of re-scanning the whole log. The entries are stored as parallel arrays: slot i of
+ * each array belongs to the same workload.
+ */
+struct RecordIndex {
+  /*! \brief The number of bytes of the log that are covered by this index. */
+  uint64_t indexed_bytes{0};
+  /*! \brief The workload key of each entry. */
+  std::vector<std::string> workload_keys;
+  /*! \brief The target string of each entry. */
+  std::vector<std::string> targets;
+  /*! \brief The byte offset of the best record of each entry. */
+  std::vector<uint64_t> offsets;
+  /*! \brief The cost of the best record of each entry. */
+  std::vector<double> costs;
+
+  /*! \brief Load the index from a file. Return false if it is missing or has a stale version. */
+  bool Load(const std::string& path) {
+    std::ifstream ifs(path, std::ifstream::in);
+    if (!ifs.good()) {
+      return false;
+    }
+    int version = 0;
+    dmlc::JSONReader reader(&ifs);
+    dmlc::JSONObjectReadHelper helper;
+    helper.DeclareField("version", &version);
+    helper.DeclareField("indexed_bytes", &indexed_bytes);
+    helper.DeclareField("workload_keys", &workload_keys);
+    helper.DeclareField("targets", &targets);
+    helper.DeclareField("offsets", &offsets);
+    helper.DeclareField("costs", &costs);
+    helper.ReadAllFields(&reader);
+    if (version != kRecordIndexVersion) {
+      *this = RecordIndex();
+      return false;
+    }
+    return true;
+  }
+
+  /*! \brief Save the index to a file. */
+  void Save(const std::string& path) const {
+    std::ofstream ofs(path);
+    dmlc::JSONWriter writer(&ofs);
+    writer.BeginObject();
+    writer.WriteObjectKeyValue("version", kRecordIndexVersion);
+    writer.WriteObjectKeyValue("indexed_bytes", indexed_bytes);
+    writer.WriteObjectKeyValue("workload_keys", workload_keys);
+    writer.WriteObjectKeyValue("targets", targets);
+    writer.WriteObjectKeyValue("offsets", offsets);
+    writer.WriteObjectKeyValue("costs", costs);
+    writer.EndObject();
+  }
+};
+
+void UpdateRecordIndex(const String& filename) {
+  std::ifstream infile(filename, std::ifstream::in);
+  ICHECK(infile.good()) << "Failed to open record file: " << filename;
+  infile.seekg(0, std::ifstream::end);
+  uint64_t file_bytes = infile.tellg();
+
+  RecordIndex index;
+  index.Load(GetRecordIndexPath(filename));
+  if (index.indexed_bytes > file_bytes) {
+    // The log was truncated or rewritten since the index was built, so the stored
+    // offsets can no longer be trusted. Rebuild from scratch.
+    index = RecordIndex();
+  }
+  if (index.indexed_bytes == file_bytes) {
+    return;
+  }
+
+  // Map from "workload_key$target" to the slot of the entry in the parallel arrays.
+  std::unordered_map<std::string, size_t> entry_slot;
+  for (size_t i = 0; i < index.workload_keys.size(); ++i) {
+    entry_slot[index.workload_keys[i] + "$" + index.targets[i]] = i;
+  }
+
+  // Scan only the part of the log appended since the index was last updated.
+  auto inp = make_object<MeasureInputNode>();
+  auto res = make_object<MeasureResultNode>();
+  std::string line, log_version;
+  infile.seekg(index.indexed_bytes, std::ifstream::beg);
+  uint64_t offset = infile.tellg();
+  while (std::getline(infile, line)) {
+    if (!line.empty() && line[0] != '#' && line[0] != ' ') {
+      ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+      if (res->error_no == 0) {
+        double cost = FloatArrayMean(res->costs);
+        std::string key = inp->task->workload_key + "$" + inp->task->target->str();
+        auto it = entry_slot.find(key);
+        if (it == entry_slot.end()) {
+          entry_slot[key] = index.workload_keys.size();
+          index.workload_keys.push_back(inp->task->workload_key);
+          index.targets.push_back(inp->task->target->str());
+          index.offsets.push_back(offset);
+          index.costs.push_back(cost);
+        } else if (cost < index.costs[it->second]) {
+          index.offsets[it->second] = offset;
+          index.costs[it->second] = cost;
+        }
+      }
+    }
+    offset = infile.tellg();
+  }
+
+  index.indexed_bytes = file_bytes;
+  index.Save(GetRecordIndexPath(filename));
+}
+
+std::pair<Array<MeasureInput>, Array<MeasureResult>> ReadBestRecords(const String& filename) {
+  UpdateRecordIndex(filename);
+
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  RecordIndex index;
+  if (!index.Load(GetRecordIndexPath(filename))) {
+    return std::make_pair(inputs, results);
+  }
+
+  std::ifstream infile(filename, std::ifstream::in);
+  auto inp = make_object<MeasureInputNode>();
+  auto res = make_object<MeasureResultNode>();
+  std::string line, log_version;
+  for (uint64_t offset : index.offsets) {
+    infile.seekg(offset, std::ifstream::beg);
+    std::getline(infile, line);
+    ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+    inputs.push_back(inp->copy());
+    results.push_back(res->copy());
+  }
+
+  return std::make_pair(inputs, results);
+}
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RecordToFile").set_body_typed([](const String& filename) {
   return RecordToFile(filename);
 });
@@ -427,6 +572,15 @@ TVM_REGISTER_GLOBAL("auto_scheduler.RecordReaderReadNext").set_body_typed([](Rec
   }
 });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.UpdateRecordIndex").set_body_typed([](const String& filename) {
+  UpdateRecordIndex(filename);
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.ReadBestRecords").set_body_typed([](const String& filename) {
+  const auto& res = ReadBestRecords(filename);
+  return Array<ObjectRef>{res.first, res.second};
+});
+
 TVM_REGISTER_GLOBAL("auto_scheduler.ReadMeasureRecord").set_body_typed([](const std::string& str) {
   auto inp = make_object<MeasureInputNode>();
   auto res = make_object<MeasureResultNode>();
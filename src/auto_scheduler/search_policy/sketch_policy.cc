@@ -30,12 +30,14 @@
 #include <tvm/support/parallel_for.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <limits>
 #include <memory>
 #include <queue>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -401,8 +403,9 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
   while (static_cast<int>(out_states.size()) < sample_init_min_pop_) {
     std::vector<State> temp_states(population);
 
-    // Sample a batch of states randomly
-    support::parallel_for(0, population, [this, &temp_states, &sketches, &rand_gens](int index) {
+    // Sample a batch of states randomly. The annotation rules have very
+    // uneven costs, so schedule the slots dynamically.
+    auto sample_one = [this, &temp_states, &sketches, &rand_gens](int, int index) {
       // Randomly choose a sketch
       State tmp_s = sketches[(rand_gens[index])() % sketches.size()];
       // Apply random annotation rules one by one
@@ -417,7 +420,8 @@ Array<State> SketchPolicyNode::SampleInitPopulation(const Array<State>& sketches
       if (valid) {
         temp_states[index] = std::move(tmp_s);
       }
-    });
+    };
+    support::parallel_for_dynamic(0, population, std::thread::hardware_concurrency(), sample_one);
 
     // Filter out the states that were failed to apply initial rules
     Array<State> cand_states;
@@ -522,7 +526,14 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
   float max_score = -1e-10f;
   pop_scores.reserve(population);
   pop_selection_probs.reserve(population);
-  std::uniform_real_distribution<> dis(0.0, 1.0);
+
+  // Per-slot generators so the parallel mutation below draws its parents and
+  // rules independently of how the slots are scheduled onto threads.
+  std::vector<std::mt19937> rand_gens;
+  rand_gens.reserve(population);
+  for (size_t i = 0; i < population; ++i) {
+    rand_gens.push_back(std::mt19937(rand_gen()));
+  }
 
   // mutation rules
   int mutation_success_ct, mutation_fail_ct;
@@ -587,21 +598,38 @@ Array<State> SketchPolicyNode::EvolutionarySearch(const Array<State>& init_popul
 
     // TODO(merrymercy, comaniac): add crossover.
 
-    // Do mutation
+    // Do mutation in parallel. Failed mutations leave their slot undefined,
+    // so keep drawing batches until the next population is full.
     while (pnext->size() < population) {
-      State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, &rand_gen)];
-
-      if (dis(rand_gen) < mutation_prob) {
-        const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, &rand_gen)];
-        if (rule->Apply(this, &tmp_s, &rand_gen) == PopulationGenerationRule::ResultKind::kValid) {
-          pnext->push_back(std::move(tmp_s));
-          mutation_success_ct++;
+      std::vector<State> next_states(population - pnext->size(), State());
+      std::atomic<int> success_ct(0), fail_ct(0);
+      auto mutate_one = [this, &next_states, &pnow, &pop_selection_probs, &rule_selection_probs,
+                         &rand_gens, mutation_prob, &success_ct, &fail_ct](int, int index) {
+        std::mt19937* gen = &rand_gens[index];
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+        State tmp_s = (*pnow)[RandomChoose(pop_selection_probs, gen)];
+
+        if (dis(*gen) < mutation_prob) {
+          const auto& rule = mutation_rules[RandomChoose(rule_selection_probs, gen)];
+          if (rule->Apply(this, &tmp_s, gen) == PopulationGenerationRule::ResultKind::kValid) {
+            next_states[index] = std::move(tmp_s);
+            success_ct++;
+          } else {
+            fail_ct++;
+          }
         } else {
-          mutation_fail_ct++;
+          next_states[index] = std::move(tmp_s);
+        }
+      };
+      support::parallel_for_dynamic(0, next_states.size(), std::thread::hardware_concurrency(),
+                                    mutate_one);
+      for (auto& state : next_states) {
+        if (state.defined()) {
+          pnext->push_back(std::move(state));
         }
-      } else {
-        pnext->push_back(std::move(tmp_s));
       }
+      mutation_success_ct += success_ct;
+      mutation_fail_ct += fail_ct;
     }
 
     std::swap(pnext, pnow);
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -675,6 +676,13 @@ class SplitFactorizationMemo {
 
  private:
   void DfsEnumerate(int now, int remaining_length, int max_innermost_factor);
+  const std::vector<int>& GetFactorsUnlocked(int n);
+
+  /*!
+   * \brief Protects the memo tables. The mutation rules query the shared
+   * per-policy memo from parallel workers.
+   */
+  std::mutex mutex_;
 
   std::unordered_map<QueryKey, Array<Array<Integer>>> memory_;
 
@@ -28,7 +28,14 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace tvm {
 namespace auto_scheduler {
@@ -51,12 +58,77 @@ HardwareParams::HardwareParams(int num_cores, int vector_unit_bytes, int cache_l
   data_ = std::move(node);
 }
 
-HardwareParams HardwareParamsNode::GetDefaultHardwareParams(const Target& target,
-                                                            const Target& target_host) {
+namespace {
+
+/*!
+ * \brief Probe the cache line size of the host with a strided-traversal microbenchmark.
+ *
+ * Walk a buffer much larger than the last-level cache at increasing strides and
+ * time the cost per touched element. While the stride is smaller than a cache
+ * line, doubling it roughly doubles the per-element cost (the same lines are
+ * fetched for half the touches); once the stride covers a full line every touch
+ * misses and the cost flattens out. The first stride where the cost stops
+ * growing is the line size. Falls back to 64 bytes when no clear plateau shows
+ * up (e.g. when the hardware prefetcher hides all the misses).
+ */
+int ProbeCacheLineBytes() {
+  constexpr size_t kBufferSize = 16 << 20;
+  constexpr int kMaxLineBytes = 256;
+  std::vector<char> buffer(kBufferSize, 1);
+  volatile char sink = 0;
+
+  // Cost per touched element (up to a constant factor), best of three runs.
+  auto time_stride = [&](int stride) {
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < 3; ++run) {
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < kBufferSize; i += stride) {
+        sink = sink + buffer[i];
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      best = std::min(best, elapsed.count() * stride);
+    }
+    return best;
+  };
+
+  double prev = time_stride(16);
+  for (int stride = 32; stride <= kMaxLineBytes; stride *= 2) {
+    double cur = time_stride(stride);
+    if (cur < prev * 1.5) {
+      return stride / 2;
+    }
+    prev = cur;
+  }
+  return 64;
+}
+
+/*! \brief The widest vector unit the host CPU supports, in bytes. */
+int DetectVectorUnitBytes() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  if (__builtin_cpu_supports("avx512f")) {
+    return 64;
+  }
+  if (__builtin_cpu_supports("avx")) {
+    return 32;
+  }
+  return 16;  // SSE2 baseline
+#else
+  return 16;  // NEON and other 128-bit SIMD ISAs
+#endif
+}
+
+HardwareParams MakeDefaultHardwareParams(const Target& target, const Target& target_host) {
   // There is no use of target_host so no updates here in the function.
   const auto device_type = target->kind->device_type;
   if (device_type == kDLCPU) {
-    return HardwareParams(tvm::runtime::threading::MaxConcurrency(), 64, 64, 0, 0, 0, 0, 0);
+    int num_cores = tvm::runtime::threading::MaxConcurrency();
+    // Probe the host only when it is also the deploy target; an explicit
+    // mtriple usually means cross compilation, where the host tells us nothing.
+    if (!target->GetAttr<String>("mtriple")) {
+      return HardwareParams(num_cores, DetectVectorUnitBytes(), ProbeCacheLineBytes(), 0, 0, 0, 0,
+                            0);
+    }
+    return HardwareParams(num_cores, 64, 64, 0, 0, 0, 0, 0);
   } else if (device_type == kDLCUDA || device_type == kDLROCM) {
     auto dev = Device{static_cast<DLDeviceType>(device_type), 0};
     auto device_name = device_type == kDLCUDA ? "device_api.cuda" : "device_api.rocm";
@@ -136,6 +208,25 @@ HardwareParams HardwareParamsNode::GetDefaultHardwareParams(const Target& target
   return HardwareParams();
 }
 
+}  // namespace
+
+HardwareParams HardwareParamsNode::GetDefaultHardwareParams(const Target& target,
+                                                            const Target& target_host) {
+  // Device attribute queries and host probes are not free, so run the
+  // detection once per target and reuse the result for every later task.
+  static std::mutex cache_mutex;
+  static std::unordered_map<std::string, HardwareParams> cache;
+  std::string key = target->str();
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  HardwareParams params = MakeDefaultHardwareParams(target, target_host);
+  cache.emplace(std::move(key), params);
+  return params;
+}
+
 SearchTask::SearchTask(ComputeDAG compute_dag, String workload_key, Target target,
                        Target target_host, Optional<HardwareParams> hardware_params,
                        LayoutRewriteOption layout_rewrite_option, Array<String> task_input_names,
@@ -0,0 +1,260 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_scheduler/task_scheduler.cc
+ * \brief Allocate the measurement budget of one tuning run across several
+ * search tasks. The gradient strategy follows section 6 of
+ * "Ansor : Generating High-Performance Tensor Programs for Deep Learning".
+ */
+
+#include <tvm/auto_scheduler/measure_record.h>
+#include <tvm/auto_scheduler/task_scheduler.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils.h"
+
+namespace tvm {
+namespace auto_scheduler {
+
+TVM_REGISTER_NODE_TYPE(TaskSchedulerNode);
+
+// A cost this high means the task has not produced a valid schedule yet.
+static constexpr double kMaxCost = 1e10;
+
+TaskScheduler::TaskScheduler(Array<SearchPolicy> search_policies, Array<FloatImm> task_weights,
+                             String strategy, String load_log_file, double alpha,
+                             int backward_window_size, int per_task_early_stopping) {
+  ICHECK(!search_policies.empty()) << "There should be at least one task to tune";
+  ICHECK(task_weights.empty() || task_weights.size() == search_policies.size())
+      << "Number of task weights must match the number of tasks";
+  ICHECK(strategy == "round-robin" || strategy == "gradient")
+      << "Invalid strategy: " << strategy;
+  auto node = make_object<TaskSchedulerNode>();
+  node->search_policies = std::move(search_policies);
+  node->task_weights = std::move(task_weights);
+  node->strategy = std::move(strategy);
+  node->load_log_file = std::move(load_log_file);
+  node->alpha = alpha;
+  node->backward_window_size = backward_window_size;
+  node->per_task_early_stopping = per_task_early_stopping;
+  data_ = std::move(node);
+}
+
+double TaskSchedulerNode::ComputeScore() const {
+  double score = 0;
+  for (size_t i = 0; i < search_policies.size(); ++i) {
+    double weight = task_weights.empty() ? 1.0 : task_weights[i]->value;
+    score += weight * best_costs_[i];
+  }
+  return score;
+}
+
+void TaskSchedulerNode::TuneTask(int idx, const ProgramMeasurer& measurer) {
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  std::tie(inputs, results) =
+      search_policies[idx]->ContinueSearchOneRound(num_measures_per_round_, measurer);
+
+  task_cts_[idx] += 1;
+
+  for (const MeasureResult& res : results) {
+    if (res->error_no != 0) continue;
+    double cost = FloatArrayMean(res->costs);
+    if (cost < best_costs_[idx]) {
+      best_costs_[idx] = cost;
+      task_best_cts_[idx] = task_cts_[idx];
+    }
+  }
+
+  // Stop tuning this task if its search space is exhausted or it has not
+  // improved for a long while.
+  int no_change_trials = (task_cts_[idx] - task_best_cts_[idx]) * num_measures_per_round_;
+  if (inputs.empty() ||
+      (per_task_early_stopping >= 0 && no_change_trials > per_task_early_stopping)) {
+    dead_tasks_.insert(idx);
+  }
+
+  cost_history_[idx].push_back(best_costs_[idx]);
+  trial_ct_ += inputs.size();
+}
+
+void TaskSchedulerNode::RestoreStatus() {
+  std::unordered_map<std::string, int> workload_to_idx;
+  for (size_t i = 0; i < search_policies.size(); ++i) {
+    workload_to_idx[search_policies[i]->search_task->workload_key] = i;
+  }
+
+  std::vector<int> record_cts(search_policies.size(), 0);
+  RecordReader reader(load_log_file);
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  std::tie(inputs, results) = reader->ReadLines();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto it = workload_to_idx.find(inputs[i]->task->workload_key);
+    if (it == workload_to_idx.end()) continue;
+    int idx = it->second;
+    ++record_cts[idx];
+    if (results[i]->error_no != 0) continue;
+    double cost = FloatArrayMean(results[i]->costs);
+    if (cost < best_costs_[idx]) {
+      best_costs_[idx] = cost;
+    }
+  }
+
+  for (size_t i = 0; i < search_policies.size(); ++i) {
+    // Round the raw record count into finished rounds.
+    task_cts_[i] = (record_cts[i] + num_measures_per_round_ / 2) / num_measures_per_round_;
+    task_best_cts_[i] = task_cts_[i];
+    if (task_cts_[i] > 0) {
+      cost_history_[i].assign(task_cts_[i], best_costs_[i]);
+    }
+    search_policies[i]->PreloadMeasuredStates(load_log_file);
+  }
+}
+
+int TaskSchedulerNode::NextTaskIdx() {
+  int num_tasks = static_cast<int>(search_policies.size());
+  if (strategy == "round-robin") {
+    int idx = (last_task_idx_ + 1) % num_tasks;
+    while (dead_tasks_.count(idx)) {
+      idx = (idx + 1) % num_tasks;
+    }
+    return idx;
+  }
+
+  // Gradient strategy: pick the task whose next round is expected to lower
+  // the weighted end-to-end latency the most (the most negative gradient).
+  std::vector<double> gradients(num_tasks, 0.0);
+  for (int i = 0; i < num_tasks; ++i) {
+    if (dead_tasks_.count(i)) continue;
+
+    // chain rule: d(score) / d(cost_i) is simply the task weight
+    double chain_grad = task_weights.empty() ? 1.0 : task_weights[i]->value;
+
+    // backward gradient: improvement rate over the last rounds
+    double backward_grad = 0;
+    int ct = task_cts_[i];
+    if (ct - 1 < static_cast<int>(cost_history_[i].size()) &&
+        ct - 1 - backward_window_size >= 0) {
+      backward_grad = (cost_history_[i][ct - 1] - cost_history_[i][ct - 1 - backward_window_size]) /
+                      backward_window_size;
+    }
+
+    // forward gradient: optimistic estimate of the next improvement
+    double g_next = best_costs_[i] - best_costs_[i] / task_cts_[i];
+    double forward_grad = g_next - best_costs_[i];
+
+    gradients[i] = chain_grad * (alpha * backward_grad + (1 - alpha) * forward_grad);
+  }
+
+  auto minmax = std::minmax_element(gradients.begin(), gradients.end());
+  if (*minmax.first == *minmax.second) {
+    // no signal yet; fall back to round robin among the live tasks
+    int idx = (last_task_idx_ + 1) % num_tasks;
+    while (dead_tasks_.count(idx)) {
+      idx = (idx + 1) % num_tasks;
+    }
+    return idx;
+  }
+  return static_cast<int>(minmax.first - gradients.begin());
+}
+
+void TaskSchedulerNode::Tune(const TuningOptions& tuning_options) {
+  int num_tasks = static_cast<int>(search_policies.size());
+  task_cts_.assign(num_tasks, 0);
+  task_best_cts_.assign(num_tasks, 0);
+  best_costs_.assign(num_tasks, kMaxCost);
+  cost_history_.assign(num_tasks, {});
+  dead_tasks_.clear();
+  trial_ct_ = 0;
+  last_task_idx_ = -1;
+
+  // Make sure every task can be tuned at least once.
+  num_measures_per_round_ =
+      std::min(tuning_options->num_measures_per_round,
+               tuning_options->num_measure_trials / num_tasks);
+  ICHECK_GT(num_measures_per_round_, 0)
+      << "num_measure_trials is too small, it should be at least " << num_tasks;
+
+  // One measurer serves all tasks, so builder, runner and record callbacks
+  // are shared across the whole run.
+  ProgramMeasurer measurer =
+      ProgramMeasurer(tuning_options->builder, tuning_options->runner,
+                      tuning_options->measure_callbacks, tuning_options->verbose);
+
+  if (!load_log_file.empty()) {
+    RestoreStatus();
+  }
+
+  // Round robin warm up, skipping tasks already covered by the restored log.
+  for (int i = 0; i < num_tasks; ++i) {
+    if (task_cts_[i] == 0) {
+      TuneTask(i, measurer);
+    }
+  }
+
+  double best_score = ComputeScore();
+  int best_trial_ct = trial_ct_;
+  int early_stopping =
+      tuning_options->early_stopping < 0 ? std::numeric_limits<int>::max()
+                                         : tuning_options->early_stopping;
+
+  while (trial_ct_ < tuning_options->num_measure_trials &&
+         static_cast<int>(dead_tasks_.size()) < num_tasks) {
+    int idx = NextTaskIdx();
+    TuneTask(idx, measurer);
+    last_task_idx_ = idx;
+
+    double score = ComputeScore();
+    if (score < best_score) {
+      best_score = score;
+      best_trial_ct = trial_ct_;
+    } else if (trial_ct_ - best_trial_ct >= early_stopping &&
+               *std::max_element(best_costs_.begin(), best_costs_.end()) < kMaxCost) {
+      StdCout(tuning_options->verbose)
+          << "Stop early since no performance improvement in the last " << early_stopping
+          << " measurement trials." << std::endl;
+      break;
+    }
+  }
+}
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskScheduler")
+    .set_body_typed([](Array<SearchPolicy> search_policies, Array<FloatImm> task_weights,
+                       String strategy, String load_log_file, double alpha,
+                       int backward_window_size, int per_task_early_stopping) {
+      return TaskScheduler(search_policies, task_weights, strategy, load_log_file, alpha,
+                           backward_window_size, per_task_early_stopping);
+    });
+
+TVM_REGISTER_GLOBAL("auto_scheduler.TaskSchedulerTune")
+    .set_body_typed([](TaskScheduler scheduler, TuningOptions tuning_options) {
+      scheduler->Tune(tuning_options);
+    });
+
+}  // namespace auto_scheduler
+}  // namespace tvm
@@ -24,10 +24,13 @@
 
 #include "touch_extractor.h"
 
+#include <tvm/support/parallel_for.h>
+
 #include <algorithm>
 #include <cmath>
-#include <set>
+#include <cstring>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace tvm {
 namespace autotvm {
@@ -90,19 +93,20 @@ bool TouchExtractor::EnterItervar_(Var var, int64_t length, AnnotationType ann_t
     itervar_stack_.push_back(var);
     topdown_product_ *= length;
 
-    if (itervar_map.count(var) != 0) {
+    auto it = itervar_map.find(var);
+    if (it != itervar_map.end()) {
       // find two duplicated axes
       // these happens when we create tvm.thread_axis("threadIdx.x") once and
       // bind it twice. Here we treat them as two axes
       // so we create a snapshot for the old one and freeze it
       Var old = Var(var.get()->name_hint);
-      itervar_map.insert({old, itervar_map[var]});
+      itervar_map[old] = it->second;
       itervar_map.erase(var);
     }
 
-    itervar_map.insert(
-        {var, ItervarFeature(var, length, static_cast<int>(itervar_stack_.size()), ann_type,
-                             topdown_product_, static_cast<int>(itervar_counter_++))});
+    itervar_map[var] =
+        arena_.make<ItervarFeature>(var, length, static_cast<int>(itervar_stack_.size()), ann_type,
+                                    topdown_product_, static_cast<int>(itervar_counter_++));
   }
 
   return true;
@@ -114,46 +118,47 @@ void TouchExtractor::ExitItervar_() {
     return;
   }
   Var var = itervar_stack_.back();
+  ItervarFeature* fea = itervar_map.at(var);
 
   // update count and reuse ratio for upper iter vars (includes self)
-  for (auto kv : itervar_map[var].touch_feature) {
-    if (kv.second.stride != 0) {  // multiply count
+  for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+    if (p->value.pattern.stride != 0) {  // multiply count
       for (auto stack_var : itervar_stack_) {
-        auto touch_pattern = itervar_map[stack_var].touch_feature.find(kv.first);
-        ICHECK(touch_pattern != itervar_map[stack_var].touch_feature.end());
-        touch_pattern->second.count *= itervar_map[var].length;
+        TouchPattern* touch_pattern = FindTouch(itervar_map.at(stack_var), p->value.buffer);
+        ICHECK(touch_pattern != nullptr);
+        touch_pattern->count *= fea->length;
       }
     } else {  // multiply reuse ratio
       for (auto stack_var : itervar_stack_) {
-        auto touch_pattern = itervar_map[stack_var].touch_feature.find(kv.first);
-        ICHECK(touch_pattern != itervar_map[stack_var].touch_feature.end());
-        touch_pattern->second.reuse *= itervar_map[var].length;
+        TouchPattern* touch_pattern = FindTouch(itervar_map.at(stack_var), p->value.buffer);
+        ICHECK(touch_pattern != nullptr);
+        touch_pattern->reuse *= fea->length;
       }
     }
   }
   itervar_stack_.pop_back();
 
-  int64_t length = itervar_map[var].length;
+  int64_t length = fea->length;
   if (length != 0) topdown_product_ /= length;
   int64_t bottomup_product = -1;
-  for (auto kv : itervar_map[var].touch_feature) {
-    bottomup_product = std::max(bottomup_product, kv.second.count * kv.second.reuse);
+  for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+    bottomup_product = std::max(bottomup_product, p->value.pattern.count * p->value.pattern.reuse);
   }
 
-  itervar_map[var].bottomup_product = bottomup_product;
+  fea->bottomup_product = bottomup_product;
 
   // push base to upper parallel axis
-  int para_level = ParallelLevel(itervar_map[var].ann);
+  int para_level = ParallelLevel(fea->ann);
   // if is the separate line of parallel level, push the base to upper parallel level
   if (!itervar_stack_.empty() &&
-      ParallelLevel(itervar_map[itervar_stack_.back()].ann) == para_level + 1) {
-    for (auto kv : itervar_map[var].touch_feature) {
+      ParallelLevel(itervar_map.at(itervar_stack_.back())->ann) == para_level + 1) {
+    for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
       for (auto stack_var : itervar_stack_) {
-        if (ParallelLevel(itervar_map[stack_var].ann) == para_level + 1) {
-          auto touch_pattern = itervar_map[stack_var].touch_feature.find(kv.first);
-          ICHECK(touch_pattern != itervar_map[stack_var].touch_feature.end());
-          touch_pattern->second.thread_reuse = -kv.second.reuse;
-          touch_pattern->second.thread_count = -kv.second.count;
+        if (ParallelLevel(itervar_map.at(stack_var)->ann) == para_level + 1) {
+          TouchPattern* touch_pattern = FindTouch(itervar_map.at(stack_var), p->value.buffer);
+          ICHECK(touch_pattern != nullptr);
+          touch_pattern->thread_reuse = -p->value.pattern.reuse;
+          touch_pattern->thread_count = -p->value.pattern.count;
           // NOTE: use minus as a flag to denote it is a base,
           // indicating it is not the final value
         }
@@ -161,19 +166,18 @@ void TouchExtractor::ExitItervar_() {
     }
   }
 
-  for (auto kv : itervar_map[var].touch_feature) {
-    if (kv.second.thread_count < 0) {
-      itervar_map[var].touch_feature[kv.first].thread_count =
-          kv.second.count / (-kv.second.thread_count);
-      itervar_map[var].touch_feature[kv.first].thread_reuse =
-          kv.second.reuse / (-kv.second.thread_reuse);
+  for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+    TouchPattern& t = p->value.pattern;
+    if (t.thread_count < 0) {
+      t.thread_count = t.count / (-t.thread_count);
+      t.thread_reuse = t.reuse / (-t.thread_reuse);
     }
   }
 }
 
 void TouchExtractor::EnterMem_(Var buffer_var, PrimExpr index) {
   std::string name = buffer_var.get()->name_hint;
-  TouchedBuffer buf = name + "_" + std::to_string(buffer_counter_[name]++);
+  TouchedBufferId buf = InternBuffer(name + "_" + std::to_string(buffer_counter_[name]++));
 
   // extract touch pattern from index
   IndexParser parser;
@@ -181,17 +185,48 @@ void TouchExtractor::EnterMem_(Var buffer_var, PrimExpr index) {
 
   // push up mem access info
   for (auto var : itervar_stack_) {
+    auto* node = arena_.make<support::LinkNode<TouchEntry>>();
+    node->value.buffer = buf;
     auto x = parser.pattern_map.find(var.get());
     if (x != parser.pattern_map.end()) {
-      itervar_map[var].touch_feature[buf] = x->second;
+      node->value.pattern = x->second;
     } else {
-      itervar_map[var].touch_feature[buf] = TouchPattern();
+      node->value.pattern = TouchPattern();
     }
+    GetFeature(var)->touch_feature.Push(node);
   }
 }
 
 void TouchExtractor::ExitMem_() {}
 
+namespace {
+
+// itervars sorted according to their first occurrence position in IR
+std::vector<Var> SortedItervars(const TouchExtractor& ext) {
+  std::vector<Var> vars;
+  for (auto kv : ext.itervar_map) {
+    vars.push_back(kv.first);
+  }
+  std::sort(vars.begin(), vars.end(), [&](const Var& lhs, const Var& rhs) -> bool {
+    return ext.itervar_map.at(lhs)->order < ext.itervar_map.at(rhs)->order;
+  });
+  return vars;
+}
+
+// touch entries of an itervar, sorted by their unique buffer names
+std::vector<const TouchEntry*> SortedTouch(const TouchExtractor& ext, const ItervarFeature* fea) {
+  std::vector<const TouchEntry*> entries;
+  for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+    entries.push_back(&p->value);
+  }
+  std::sort(entries.begin(), entries.end(), [&](const TouchEntry* lhs, const TouchEntry* rhs) {
+    return ext.buffer_name(lhs->buffer) < ext.buffer_name(rhs->buffer);
+  });
+  return entries;
+}
+
+}  // namespace
+
 /*!
  * \brief Get axis-based feature for all axes
  * \param stmt The statement to be extracted
@@ -226,13 +261,7 @@ void GetItervarFeature(Stmt stmt, bool take_log, Array<Array<Array<PrimExpr> > >
   touch_analyzer.Analyze(stmt);
 
   // sort according to order
-  std::vector<Var> vars;
-  for (auto kv : touch_analyzer.itervar_map) {
-    vars.push_back(kv.first);
-  }
-  std::sort(vars.begin(), vars.end(), [&](const Var& lhs, const Var& rhs) -> bool {
-    return touch_analyzer.itervar_map[lhs].order < touch_analyzer.itervar_map[rhs].order;
-  });
+  std::vector<Var> vars = SortedItervars(touch_analyzer);
 
   // whether take log for numerical feature
   std::function<double(int64_t)> trans;
@@ -249,40 +278,35 @@ void GetItervarFeature(Stmt stmt, bool take_log, Array<Array<Array<PrimExpr> > >
   // serialize for front end
   for (auto var : vars) {
     Array<Array<PrimExpr> > feature_row;
-    ItervarFeature& fea = touch_analyzer.itervar_map[var];
+    const ItervarFeature* fea = touch_analyzer.itervar_map.at(var);
     feature_row.push_back(Array<PrimExpr>{tvm::tir::StringImm("_itervar_"), var});
 
     Array<PrimExpr> attr{
         tvm::tir::StringImm("_attr_"),
-        FloatImm(DataType::Float(32), trans(fea.length)),
-        IntImm(DataType::Int(32), fea.nest_level),
-        FloatImm(DataType::Float(32), trans(fea.topdown_product)),
-        FloatImm(DataType::Float(32), trans(fea.bottomup_product)),
+        FloatImm(DataType::Float(32), trans(fea->length)),
+        IntImm(DataType::Int(32), fea->nest_level),
+        FloatImm(DataType::Float(32), trans(fea->topdown_product)),
+        FloatImm(DataType::Float(32), trans(fea->bottomup_product)),
     };
     // one hot annotation
     for (int i = 0; i < kNum; i++) {
-      attr.push_back(i == fea.ann);
+      attr.push_back(i == fea->ann);
     }
     feature_row.push_back(attr);
 
     // arithmetic
     feature_row.push_back(Array<PrimExpr>{
         tvm::tir::StringImm("_arith_"),
-        FloatImm(DataType::Float(32), trans(fea.add_ct)),
-        FloatImm(DataType::Float(32), trans(fea.mul_ct)),
-        FloatImm(DataType::Float(32), trans(fea.div_ct)),
+        FloatImm(DataType::Float(32), trans(fea->add_ct)),
+        FloatImm(DataType::Float(32), trans(fea->mul_ct)),
+        FloatImm(DataType::Float(32), trans(fea->div_ct)),
     });
 
     // touch map
-    std::vector<TouchedBuffer> bufs;
-    for (auto kv : fea.touch_feature) {
-      bufs.push_back(kv.first);
-    }
-    std::sort(bufs.begin(), bufs.end());
-    for (auto k : bufs) {
-      TouchPattern& v = fea.touch_feature[k];
+    for (const TouchEntry* entry : SortedTouch(touch_analyzer, fea)) {
+      const TouchPattern& v = entry->pattern;
       feature_row.push_back(Array<PrimExpr>{
-          tvm::tir::StringImm(k),
+          tvm::tir::StringImm(touch_analyzer.buffer_name(entry->buffer)),
           FloatImm(DataType::Float(32), trans(v.stride)),
           FloatImm(DataType::Float(32), trans(v.mod)),
           FloatImm(DataType::Float(32), trans(v.count)),
@@ -311,13 +335,7 @@ void GetItervarFeatureFlatten(Stmt stmt, bool take_log, std::vector<float>* ret_
   touch_analyzer.Analyze(stmt);
 
   // sort according to order
-  std::vector<Var> vars;
-  for (auto kv : touch_analyzer.itervar_map) {
-    vars.push_back(kv.first);
-  }
-  std::sort(vars.begin(), vars.end(), [&](const Var& lhs, const Var& rhs) -> bool {
-    return touch_analyzer.itervar_map[lhs].order < touch_analyzer.itervar_map[rhs].order;
-  });
+  std::vector<Var> vars = SortedItervars(touch_analyzer);
 
   // whether take log for numerical feature
   std::function<float(int64_t)> trans;
@@ -333,31 +351,26 @@ void GetItervarFeatureFlatten(Stmt stmt, bool take_log, std::vector<float>* ret_
 
   // serialize for front end
   for (auto var : vars) {
-    ItervarFeature& fea = touch_analyzer.itervar_map[var];
+    const ItervarFeature* fea = touch_analyzer.itervar_map.at(var);
 
-    ret_feature->push_back(trans(fea.length));
-    ret_feature->push_back(fea.nest_level);
-    ret_feature->push_back(trans(fea.topdown_product));
-    ret_feature->push_back(trans(fea.bottomup_product));
+    ret_feature->push_back(trans(fea->length));
+    ret_feature->push_back(fea->nest_level);
+    ret_feature->push_back(trans(fea->topdown_product));
+    ret_feature->push_back(trans(fea->bottomup_product));
 
     // one hot annotation
     for (int i = 0; i < kNum; i++) {
-      ret_feature->push_back(i == fea.ann);
+      ret_feature->push_back(i == fea->ann);
     }
 
     // arithmetic
-    ret_feature->push_back(trans(fea.add_ct));
-    ret_feature->push_back(trans(fea.mul_ct));
-    ret_feature->push_back(trans(fea.div_ct));
+    ret_feature->push_back(trans(fea->add_ct));
+    ret_feature->push_back(trans(fea->mul_ct));
+    ret_feature->push_back(trans(fea->div_ct));
 
     // touch map
-    std::vector<TouchedBuffer> bufs;
-    for (auto kv : fea.touch_feature) {
-      bufs.push_back(kv.first);
-    }
-    std::sort(bufs.begin(), bufs.end());
-    for (auto k : bufs) {
-      TouchPattern& v = fea.touch_feature[k];
+    for (const TouchEntry* entry : SortedTouch(touch_analyzer, fea)) {
+      const TouchPattern& v = entry->pattern;
       ret_feature->push_back(trans(v.stride));
       ret_feature->push_back(trans(v.mod));
       ret_feature->push_back(trans(v.count));
@@ -368,6 +381,24 @@ void GetItervarFeatureFlatten(Stmt stmt, bool take_log, std::vector<float>* ret_
   }
 }
 
+/*!
+ * \brief Extract flatten itervar features for a batch of statements in parallel.
+ * \param stmts The statements to be extracted.
+ * \param take_log Whether take log for numerical feature.
+ * \param ret_features One feature vector per statement.
+ *
+ * \note Each statement is extracted independently, so the batch is spread over
+ *       the thread pool with support::parallel_for. This is the preferred
+ *       entry for cost models that featurize many configs of one task at once.
+ */
+void GetItervarFeatureFlattenBatched(const Array<Stmt>& stmts, bool take_log,
+                                     std::vector<std::vector<float> >* ret_features) {
+  ret_features->resize(stmts.size());
+  support::parallel_for(0, static_cast<int>(stmts.size()), [&stmts, take_log, ret_features](int i) {
+    GetItervarFeatureFlatten(stmts[i], take_log, &(*ret_features)[i]);
+  });
+}
+
 /*!
  * \brief Get curve sample feature (relation feature) and flatten them into a one-dimensional
  * vector. \param stmt The statement to be extracted \param sample_n The number of points used for
@@ -380,47 +411,41 @@ void GetCurveSampleFeatureFlatten(Stmt stmt, int sample_n, std::vector<float>* r
   touch_ext.Analyze(stmt);
 
   // sort according to order
-  std::vector<Var> vars;
-  for (auto kv : touch_ext.itervar_map) {
-    vars.push_back(kv.first);
-  }
-  std::sort(vars.begin(), vars.end(), [&](const Var& lhs, const Var& rhs) -> bool {
-    return touch_ext.itervar_map[lhs].order < touch_ext.itervar_map[rhs].order;
-  });
+  std::vector<Var> vars = SortedItervars(touch_ext);
 
   int max_depth = 0;
-  std::map<TouchedBuffer, std::vector<double> > reuse_curve;
-  std::map<TouchedBuffer, std::vector<double> > count_curve;
-  std::map<TouchedBuffer, std::vector<double> > topdown_curve;
-  std::map<TouchedBuffer, std::vector<double> > bottomup_curve;
-  std::set<TouchedBuffer> innermost_buffers;
-  std::set<std::string> added;
+  std::unordered_map<TouchedBufferId, std::vector<double> > reuse_curve;
+  std::unordered_map<TouchedBufferId, std::vector<double> > count_curve;
+  std::unordered_map<TouchedBufferId, std::vector<double> > topdown_curve;
+  std::unordered_map<TouchedBufferId, std::vector<double> > bottomup_curve;
+  std::unordered_set<TouchedBufferId> innermost_buffers;
+  std::unordered_set<std::string> added;
 
   // find maximum depth of loop nest
   for (auto var : vars) {
-    ItervarFeature& fea = touch_ext.itervar_map[var];
-    max_depth = std::max(max_depth, fea.nest_level);
+    max_depth = std::max(max_depth, touch_ext.itervar_map.at(var)->nest_level);
   }
 
   // mark inner most buffer
   for (auto iter = vars.rbegin(); iter != vars.rend(); iter++) {
     auto var = *iter;
-    ItervarFeature& fea = touch_ext.itervar_map[var];
-    if (fea.nest_level == max_depth) {
-      for (auto kv : fea.touch_feature) {
+    const ItervarFeature* fea = touch_ext.itervar_map.at(var);
+    if (fea->nest_level == max_depth) {
+      for (const TouchEntry* entry : SortedTouch(touch_ext, fea)) {
+        const std::string& buf_name = touch_ext.buffer_name(entry->buffer);
         // delete buffer no (e.g. 'A_0' -> 'A', 'A_1' -> 'A')
-        std::string raw_name = kv.first.substr(0, kv.first.rfind("_"));
+        std::string raw_name = buf_name.substr(0, buf_name.rfind("_"));
 
         // delete memory scope (e.g. 'A.local' -> 'A', 'A.shared' -> 'A')
         size_t pos = raw_name.find(".");
-        if (pos < kv.first.size()) raw_name = raw_name.substr(0, pos);
+        if (pos < buf_name.size()) raw_name = raw_name.substr(0, pos);
 
         // If there are multiple innermost buffers that are derived from a same raw buffer
         // We only record the last occurrence (note the `iter` is in reverse order)
         // e.g. `A.local`, `A.shared` are derived from `A`, if they all occurred at the inner most
         // level, we will only record the last occurrence,
         if (added.find(raw_name) == added.end()) {
-          innermost_buffers.insert(kv.first);
+          innermost_buffers.insert(entry->buffer);
           added.insert(raw_name);
         }
       }
@@ -437,13 +462,14 @@ void GetCurveSampleFeatureFlatten(Stmt stmt, int sample_n, std::vector<float>* r
 
   // extract curves
   for (auto var : vars) {
-    ItervarFeature& fea = touch_ext.itervar_map[var];
-    for (auto kv : fea.touch_feature) {
-      if (innermost_buffers.find(kv.first) != innermost_buffers.end()) {
-        reuse_curve[kv.first].emplace_back(std::log(kv.second.reuse) / std::log(2));
-        count_curve[kv.first].emplace_back(std::log(kv.second.count) / std::log(2));
-        topdown_curve[kv.first].emplace_back(std::log(fea.topdown_product) / std::log(2));
-        bottomup_curve[kv.first].emplace_back(std::log(fea.bottomup_product) / std::log(2));
+    const ItervarFeature* fea = touch_ext.itervar_map.at(var);
+    for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+      if (innermost_buffers.find(p->value.buffer) != innermost_buffers.end()) {
+        reuse_curve[p->value.buffer].emplace_back(std::log(p->value.pattern.reuse) / std::log(2));
+        count_curve[p->value.buffer].emplace_back(std::log(p->value.pattern.count) / std::log(2));
+        topdown_curve[p->value.buffer].emplace_back(std::log(fea->topdown_product) / std::log(2));
+        bottomup_curve[p->value.buffer].emplace_back(std::log(fea->bottomup_product) /
+                                                     std::log(2));
       }
     }
   }
@@ -463,8 +489,14 @@ void GetCurveSampleFeatureFlatten(Stmt stmt, int sample_n, std::vector<float>* r
     }
   };
 
-  // serialize to frontend
-  for (auto k : innermost_buffers) {
+  // serialize to frontend, buffers sorted by their unique names
+  std::vector<TouchedBufferId> sorted_innermost(innermost_buffers.begin(),
+                                                innermost_buffers.end());
+  std::sort(sorted_innermost.begin(), sorted_innermost.end(),
+            [&](TouchedBufferId lhs, TouchedBufferId rhs) {
+              return touch_ext.buffer_name(lhs) < touch_ext.buffer_name(rhs);
+            });
+  for (auto k : sorted_innermost) {
     std::vector<double>& count = count_curve[k];
     std::vector<double>& reuse = reuse_curve[k];
     std::vector<double>& top_down = topdown_curve[k];
@@ -506,6 +538,48 @@ TVM_REGISTER_GLOBAL("autotvm.feature.GetItervarFeatureFlatten")
       *ret = arr;
     });
 
+// Serialization format:
+// {
+//   int   n;
+//   int   sizes[n];            // number of floats of each feature vector
+//   float features_0[sizes[0]];
+//   ...
+//   float features_n-1[sizes[n-1]];
+// }
+TVM_REGISTER_GLOBAL("autotvm.feature.GetItervarFeatureFlattenBatch")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      Array<Stmt> stmts = args[0];
+      bool take_log = args[1];
+      std::vector<std::vector<float> > features;
+
+      GetItervarFeatureFlattenBatched(stmts, take_log, &features);
+
+      size_t total_bytes = sizeof(int) * (1 + features.size());
+      for (const auto& x : features) {
+        total_bytes += sizeof(float) * x.size();
+      }
+      std::vector<char> byte_data(total_bytes);
+      char* ptr = byte_data.data();
+      int n = static_cast<int>(features.size());
+      std::memcpy(ptr, &n, sizeof(int));
+      ptr += sizeof(int);
+      for (const auto& x : features) {
+        int size = static_cast<int>(x.size());
+        std::memcpy(ptr, &size, sizeof(int));
+        ptr += sizeof(int);
+      }
+      for (const auto& x : features) {
+        std::memcpy(ptr, x.data(), sizeof(float) * x.size());
+        ptr += sizeof(float) * x.size();
+      }
+      ICHECK_EQ(static_cast<size_t>(ptr - byte_data.data()), total_bytes);
+
+      TVMByteArray arr;
+      arr.size = byte_data.size();
+      arr.data = byte_data.data();
+      *ret = arr;
+    });
+
 TVM_REGISTER_GLOBAL("autotvm.feature.GetCurveSampleFeatureFlatten")
     .set_body([](TVMArgs args, TVMRetValue* ret) {
       Stmt stmt = args[0];
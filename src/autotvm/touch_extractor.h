@@ -29,19 +29,24 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/expr_functor.h>
 
+#include <cstdint>
 #include <deque>
-#include <map>
-#include <stack>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "../support/arena.h"
 #include "feature_visitor.h"
 
 namespace tvm {
 namespace autotvm {
 
-using TouchedBuffer = std::string;
+/*!
+ * \brief Interned id of a touched buffer (a buffer name plus its occurrence
+ *  number, e.g. "data_vec_0"). Ids are assigned per extractor in first-touch
+ *  order; the owning TouchExtractor maps them back to names.
+ */
+using TouchedBufferId = uint32_t;
 
 // touch pattern buf[(stride * var) % mod) + other]
 struct TouchPattern {
@@ -54,7 +59,16 @@ struct TouchPattern {
   int64_t thread_reuse{0};  // reuse ratio move thread axis into innermost
 };
 
+// touch pattern of one buffer under an itervar, linked in the extractor arena
+struct TouchEntry {
+  TouchedBufferId buffer;
+  TouchPattern pattern;
+};
+
 // all the feature of an iter var
+// Allocated from the extractor arena, so members must stay trivially
+// destructible; the touched buffers form an arena linked list instead of a
+// string-keyed map.
 struct ItervarFeature {
   ItervarFeature(Var var, int64_t extent, int nest, AnnotationType ann_type, int64_t topdown,
                  int counter)
@@ -62,14 +76,14 @@ struct ItervarFeature {
   ItervarFeature() {}
 
   // Axis Attributes
-  int64_t length;
-  int nest_level;
-  AnnotationType ann;        // one-hot axis type
-  int64_t topdown_product;   // accumulative product of axis length, in top-down order
-  int64_t bottomup_product;  // accumulative product of axis length, in bottom-up order
+  int64_t length{0};
+  int nest_level{0};
+  AnnotationType ann{kNum};  // one-hot axis type
+  int64_t topdown_product{0};   // accumulative product of axis length, in top-down order
+  int64_t bottomup_product{0};  // accumulative product of axis length, in bottom-up order
   // bottomup_product = reuse * count for any touched buffer
 
-  int order;  // used for soring axis
+  int order{0};  // used for soring axis
 
   // Arithmetic feature
   int add_ct{0};
@@ -77,7 +91,7 @@ struct ItervarFeature {
   int div_ct{0};
 
   // Memory Touch Feature
-  std::unordered_map<TouchedBuffer, TouchPattern> touch_feature;
+  support::LinkedList<TouchEntry> touch_feature;
 };
 
 // extract iter vars and their touch pattern from ir
@@ -87,31 +101,43 @@ class TouchExtractor : public FeatureVisitor {
 
   // arithmetic stats
   void VisitExpr_(const AddNode* op) final {
-    if (op->dtype.is_float()) itervar_map[itervar_stack_.back()].add_ct++;
+    if (op->dtype.is_float()) GetFeature(itervar_stack_.back())->add_ct++;
     FeatureVisitor::VisitExpr_(op);
   }
 
   void VisitExpr_(const SubNode* op) final {
-    if (op->dtype.is_float()) itervar_map[itervar_stack_.back()].add_ct++;
+    if (op->dtype.is_float()) GetFeature(itervar_stack_.back())->add_ct++;
     FeatureVisitor::VisitExpr_(op);
   }
 
   void VisitExpr_(const MulNode* op) final {
-    if (op->dtype.is_float()) itervar_map[itervar_stack_.back()].mul_ct++;
+    if (op->dtype.is_float()) GetFeature(itervar_stack_.back())->mul_ct++;
     FeatureVisitor::VisitExpr_(op);
   }
 
   void VisitExpr_(const DivNode* op) final {
-    if (op->dtype.is_float()) itervar_map[itervar_stack_.back()].div_ct++;
+    if (op->dtype.is_float()) GetFeature(itervar_stack_.back())->div_ct++;
     FeatureVisitor::VisitExpr_(op);
   }
 
   void VisitExpr_(const ModNode* op) final {
-    if (op->dtype.is_float()) itervar_map[itervar_stack_.back()].div_ct++;
+    if (op->dtype.is_float()) GetFeature(itervar_stack_.back())->div_ct++;
     FeatureVisitor::VisitExpr_(op);
   }
 
-  std::unordered_map<Var, ItervarFeature, tvm::ObjectPtrHash, tvm::ObjectPtrEqual> itervar_map;
+  /*! \brief Return the feature of var, creating an empty one on first use. */
+  ItervarFeature* GetFeature(const Var& var) {
+    auto it = itervar_map.find(var);
+    if (it != itervar_map.end()) return it->second;
+    ItervarFeature* fea = arena_.make<ItervarFeature>();
+    itervar_map[var] = fea;
+    return fea;
+  }
+
+  /*! \brief Return the interned name of a touched buffer. */
+  const std::string& buffer_name(TouchedBufferId id) const { return buffer_names_[id]; }
+
+  std::unordered_map<Var, ItervarFeature*, tvm::ObjectPtrHash, tvm::ObjectPtrEqual> itervar_map;
 
  private:
   bool EnterItervar_(Var var, int64_t length, AnnotationType ann_type);
@@ -119,8 +145,32 @@ class TouchExtractor : public FeatureVisitor {
   void EnterMem_(Var buffer_var, PrimExpr index);
   void ExitMem_();
 
+  /*! \brief Find the touch pattern of buf in fea, or nullptr. */
+  static TouchPattern* FindTouch(ItervarFeature* fea, TouchedBufferId buf) {
+    for (auto* p = fea->touch_feature.head; p != nullptr; p = p->next) {
+      if (p->value.buffer == buf) return &p->value.pattern;
+    }
+    return nullptr;
+  }
+
+  /*! \brief Intern a touched buffer name, assigning ids in first-touch order. */
+  TouchedBufferId InternBuffer(const std::string& name) {
+    auto it = buffer_ids_.find(name);
+    if (it != buffer_ids_.end()) return it->second;
+    TouchedBufferId id = static_cast<TouchedBufferId>(buffer_names_.size());
+    buffer_names_.push_back(name);
+    buffer_ids_[name] = id;
+    return id;
+  }
+
+  // Arena owning the ItervarFeature structs and their touch entries. It is
+  // freed as a whole when the extractor dies, so extraction does no
+  // per-entry allocation or destruction.
+  support::Arena arena_;
   int64_t topdown_product_{1};
-  std::map<std::string, size_t> buffer_counter_;
+  std::unordered_map<std::string, size_t> buffer_counter_;
+  std::vector<std::string> buffer_names_;
+  std::unordered_map<std::string, TouchedBufferId> buffer_ids_;
   size_t itervar_counter_{0};
   std::deque<Var> itervar_stack_;  // use deque instead of stack for indexing
   std::deque<size_t> skip_stack_size_;
@@ -32,8 +32,11 @@
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <future>
 #include <mutex>
 #include <stack>
+#include <utility>
+#include <vector>
 
 namespace tvm {
 
@@ -41,9 +44,13 @@ namespace tvm {
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.noalias", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.detect_global_barrier", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_bound_checkers", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_profile_stages", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_assert", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.use_unpacked_api", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.disable_vectorize", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.add_lower_pass", Array<Array<ObjectRef>>);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.parallel_device_codegen", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.native_bf16", Bool);
 
 using runtime::PackedFunc;
 using runtime::TVMArgs;
@@ -151,6 +158,9 @@ IRModule lower(te::Schedule sch, const Array<te::Tensor>& args, const std::strin
   bool disable_vectorize = pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value();
   bool instrument_bound_checkers =
       pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value();
+  bool instrument_profile_stages =
+      pass_ctx->GetConfig<Bool>("tir.instrument_profile_stages", Bool(false)).value();
+  bool native_bf16 = pass_ctx->GetConfig<Bool>("tir.native_bf16", Bool(false)).value();
 
   if (noalias) {
     f = WithAttr(std::move(f), "tir.noalias", Bool(true));
@@ -163,22 +173,36 @@ IRModule lower(te::Schedule sch, const Array<te::Tensor>& args, const std::strin
   pass_list.push_back(tir::transform::InjectPrefetch());
   pass_list.push_back(tir::transform::StorageFlatten(64, instrument_bound_checkers));
   // Phase 1
-  pass_list.push_back(tir::transform::BF16Legalize());
+  // With native bf16 enabled, bf16 compute reaches the LLVM backend as a
+  // first-class floating type so targets with hardware conversions (e.g.
+  // AVX512-BF16) can use them; the fp32-promoting legalization stays the
+  // default for everything else.
+  if (!native_bf16) {
+    pass_list.push_back(tir::transform::BF16Legalize());
+  }
   pass_list.push_back(tir::transform::NarrowDataType(32));
   pass_list.push_back(tir::transform::Simplify());
   pass_list.push_back(tir::transform::LoopPartition());
   pass_list.push_back(tir::transform::VectorizeLoop(!disable_vectorize));
   pass_list.push_back(tir::transform::InjectVirtualThread());
+  pass_list.push_back(tir::transform::InjectSoftwarePipeline());
   pass_list.push_back(tir::transform::InjectDoubleBuffer());
   pass_list.push_back(tir::transform::StorageRewrite());
+  pass_list.push_back(tir::transform::AutoInjectPrefetch());
   pass_list.push_back(tir::transform::UnrollLoop());
+  pass_list.push_back(tir::transform::FlattenParallelLoops());
   // Phase 2
   pass_list.push_back(tir::transform::Simplify());
+  pass_list.push_back(tir::transform::CommonSubexprElim());
+  pass_list.push_back(tir::transform::HoistLoopInvariants());
   pass_list.push_back(tir::transform::RemoveNoOp());
   pass_list.push_back(tir::transform::RewriteUnsafeSelect());
   if (instrument_bound_checkers) {
     pass_list.push_back(tir::transform::InstrumentBoundCheckers());
   }
+  if (instrument_profile_stages) {
+    pass_list.push_back(tir::transform::InstrumentProfileStages());
+  }
   // run
   auto optimize = transform::Sequential(pass_list);
   mod = optimize(std::move(mod));
@@ -200,7 +224,13 @@ std::pair<IRModule, IRModule> SplitDevHostFuncs(IRModule mod_mixed, const Target
   mixed_pass_list.push_back(tir::transform::ThreadSync("warp"));
   mixed_pass_list.push_back(tir::transform::InferFragment());
   mixed_pass_list.push_back(tir::transform::LowerThreadAllreduce());
-  mixed_pass_list.push_back(tir::transform::MakePackedAPI(0));
+  if (pass_ctx->GetConfig<Bool>("tir.use_unpacked_api", Bool(false)).value()) {
+    // Direct-call mode: functions take raw data pointers and are invoked
+    // by statically linked code (AOT executor) without packed marshalling.
+    mixed_pass_list.push_back(tir::transform::MakeUnpackedAPI());
+  } else {
+    mixed_pass_list.push_back(tir::transform::MakePackedAPI(0));
+  }
   mixed_pass_list.push_back(tir::transform::SplitHostDevice());
   auto opt_mixed = transform::Sequential(mixed_pass_list);
   mod_mixed = opt_mixed(std::move(mod_mixed));
@@ -285,6 +315,14 @@ runtime::Module build(const Map<Target, IRModule>& inputs_arg, const Target& tar
 
   ICHECK(mhost_all.defined()) << "The host module must be defined";
 
+  // Device codegen only consumes the split-off device module, so it can run
+  // on worker threads while later targets are still being split and the host
+  // module is generated. Each codegen runs under the caller's pass context,
+  // which is otherwise thread-local.
+  bool parallel_device_codegen =
+      pass_ctx->GetConfig<Bool>("tir.parallel_device_codegen", Bool(false)).value();
+  std::vector<std::future<runtime::Module>> device_futures;
+
   for (const auto& it : inputs) {
     if (it.second.defined()) {
       auto pair = SplitDevHostFuncs(it.second, it.first, target_host, pass_ctx);
@@ -298,12 +336,24 @@ runtime::Module build(const Map<Target, IRModule>& inputs_arg, const Target& tar
       mhost_all->Update(mhost);
 
       if (mdevice->functions.size() != 0) {
-        device_modules.push_back(codegen::Build(mdevice, it.first));
+        if (parallel_device_codegen) {
+          Target target = it.first;
+          device_futures.push_back(
+              std::async(std::launch::async, [mdevice, target, pass_ctx]() {
+                With<transform::PassContext> ctx_scope(pass_ctx);
+                return codegen::Build(mdevice, target);
+              }));
+        } else {
+          device_modules.push_back(codegen::Build(mdevice, it.first));
+        }
       }
     }
   }
 
   runtime::Module mhost = codegen::Build(mhost_all, target_host);
+  for (auto& future : device_futures) {
+    device_modules.push_back(future.get());
+  }
   // Import all modules
   for (const auto& it : device_modules) {
     if (it.operator->()) {
@@ -26,10 +26,29 @@
 
 #include <rang.hpp>
 
+#include <cstdlib>
+
 namespace tvm {
 
 using tvm::parser::Source;
 
+/*!
+ * \brief The least severe diagnostic level that the terminal renderer reports.
+ *
+ * Diagnostics below this level are still recorded on the context and can be
+ * inspected programmatically, but are dropped before any string formatting
+ * happens. Controlled by the TVM_DIAGNOSTICS_MIN_LEVEL environment variable,
+ * holding the integer value of a DiagnosticLevel; by default everything is
+ * rendered. Errors and bugs are always rendered regardless of the threshold.
+ */
+DiagnosticLevel MinRenderLevel() {
+  static const int min_level = []() {
+    const char* env = std::getenv("TVM_DIAGNOSTICS_MIN_LEVEL");
+    return env != nullptr ? std::atoi(env) : static_cast<int>(DiagnosticLevel::kHelp);
+  }();
+  return static_cast<DiagnosticLevel>(min_level);
+}
+
 // failed to check to argument arg0.dims[0] != 0
 
 /* Diagnostic */
@@ -89,14 +108,16 @@ TVM_REGISTER_GLOBAL("diagnostics.DiagnosticRenderer")
 TVM_REGISTER_NODE_TYPE(DiagnosticContextNode);
 
 void DiagnosticContext::Render() {
-  (*this)->renderer.Render(*this);
+  // Render is called after every pass, so the clean path must stay
+  // near-free: skip the renderer entirely when nothing was recorded.
+  if ((*this)->diagnostics.size()) {
+    (*this)->renderer.Render(*this);
+  }
 
   int errs = 0;
-  if ((*this)->diagnostics.size()) {
-    for (auto diagnostic : (*this)->diagnostics) {
-      if (diagnostic->level == DiagnosticLevel::kError) {
-        errs += 1;
-      }
+  for (auto diagnostic : (*this)->diagnostics) {
+    if (diagnostic->level == DiagnosticLevel::kError) {
+      errs += 1;
     }
   }
 
@@ -281,6 +302,11 @@ void ReportAt(const DiagnosticContext& context, std::ostream& out, const Span& s
 DiagnosticRenderer TerminalRenderer(std::ostream& out) {
   return DiagnosticRenderer([&](const DiagnosticContext& ctx) {
     for (auto diagnostic : ctx->diagnostics) {
+      // Filter by severity before any formatting work happens; errors and
+      // bugs always pass so EmitFatal keeps its output.
+      if (diagnostic->level > MinRenderLevel() && diagnostic->level > DiagnosticLevel::kError) {
+        continue;
+      }
       ReportAt(ctx, out, diagnostic->span, diagnostic);
     }
   });
@@ -32,6 +32,9 @@
 #include <tvm/te/tensor.h>
 #include <tvm/tir/expr.h>
 
+#include <cstring>
+#include <unordered_map>
+
 namespace tvm {
 
 PrimExpr::PrimExpr(int32_t value) : PrimExpr(IntImm(DataType::Int(32), value)) {}
@@ -55,6 +58,31 @@ PrimExpr PrimExpr::FromObject_(ObjectRef ref) {
   return Downcast<PrimExpr>(ref);
 }
 
+namespace {
+/*!
+ * \brief Thread-local interning cache of small span-less IntImms.
+ *
+ *  Arithmetic simplification and type inference materialize the same small
+ *  immediates over and over; serving them from this cache removes most of
+ *  those allocations. Only span-less nodes of the dominant dtypes are
+ *  cached, and a cached node is never mutated in place: the cache's own
+ *  reference keeps the use count above one, so CopyOnWrite always copies.
+ */
+struct SmallIntCache {
+  static constexpr int64_t kMinValue = -8;
+  static constexpr int64_t kMaxValue = 120;
+  /*! \brief One slab per cached dtype; see SlabIndex. */
+  ObjectPtr<IntImmNode> entries[3][kMaxValue - kMinValue];
+
+  static int SlabIndex(DataType dtype) {
+    if (dtype == DataType::Int(32)) return 0;
+    if (dtype == DataType::Int(64)) return 1;
+    if (dtype == DataType::Bool()) return 2;
+    return -1;
+  }
+};
+}  // namespace
+
 IntImm::IntImm(DataType dtype, int64_t value, Span span) {
   ICHECK(dtype.is_scalar()) << "ValueError: IntImm can only take scalar, but " << dtype
                             << " was supplied.";
@@ -63,6 +91,20 @@ IntImm::IntImm(DataType dtype, int64_t value, Span span) {
   if (dtype.is_uint()) {
     ICHECK_GE(value, 0U);
   }
+  if (!span.defined() && value >= SmallIntCache::kMinValue && value < SmallIntCache::kMaxValue) {
+    int slab = SmallIntCache::SlabIndex(dtype);
+    if (slab >= 0) {
+      static thread_local SmallIntCache cache;
+      ObjectPtr<IntImmNode>& entry = cache.entries[slab][value - SmallIntCache::kMinValue];
+      if (entry == nullptr) {
+        entry = make_object<IntImmNode>();
+        entry->dtype = dtype;
+        entry->value = value;
+      }
+      data_ = entry;
+      return;
+    }
+  }
   ObjectPtr<IntImmNode> node = make_object<IntImmNode>();
   node->dtype = dtype;
   node->value = value;
@@ -88,6 +130,26 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
 
 FloatImm::FloatImm(DataType dtype, double value, Span span) {
   ICHECK_EQ(dtype.lanes(), 1) << "ValueError: FloatImm can only take scalar.";
+  // Intern span-less float immediates like the IntImm constructor does for
+  // integers; keyed by bit pattern so -0.0, nan payloads etc. stay distinct.
+  if (!span.defined() && (dtype == DataType::Float(32) || dtype == DataType::Float(64))) {
+    static constexpr size_t kMaxCached = 512;
+    static thread_local std::unordered_map<uint64_t, ObjectPtr<FloatImmNode>> caches[2];
+    auto& cache = caches[dtype == DataType::Float(32) ? 0 : 1];
+    if (cache.size() > kMaxCached) {
+      cache.clear();
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    ObjectPtr<FloatImmNode>& entry = cache[bits];
+    if (entry == nullptr) {
+      entry = make_object<FloatImmNode>();
+      entry->dtype = dtype;
+      entry->value = value;
+    }
+    data_ = entry;
+    return;
+  }
   ObjectPtr<FloatImmNode> node = make_object<FloatImmNode>();
   node->dtype = dtype;
   node->value = value;
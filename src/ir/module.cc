@@ -58,6 +58,9 @@ IRModule::IRModule(tvm::Map<GlobalVar, BaseFunc> functions,
     ICHECK(n->global_var_map_.count(kv.first->name_hint) == 0)
         << "Duplicate global function name " << kv.first->name_hint;
     n->global_var_map_.Set(kv.first->name_hint, kv.first);
+    n->function_id_map_.emplace(kv.first->name_hint,
+                                static_cast<int64_t>(n->function_order_.size()));
+    n->function_order_.push_back(kv.first);
   }
 
   for (const auto& kv : n->type_definitions) {
@@ -149,6 +152,25 @@ tvm::Array<GlobalVar> IRModuleNode::GetGlobalVars() const {
   return tvm::Array<GlobalVar>(global_vars);
 }
 
+int64_t IRModuleNode::GetFunctionId(const GlobalVar& var) const {
+  auto it = function_id_map_.find(var->name_hint);
+  ICHECK(it != function_id_map_.end())
+      << "There is no definition of " << var->name_hint << " in the Module";
+  return it->second;
+}
+
+tvm::Array<GlobalVar> IRModuleNode::GetFunctionOrder() const {
+  std::vector<GlobalVar> global_vars;
+  global_vars.reserve(function_id_map_.size());
+  for (const auto& var : function_order_) {
+    // slots of removed functions stay undefined so ids remain stable
+    if (var.defined()) {
+      global_vars.push_back(var);
+    }
+  }
+  return tvm::Array<GlobalVar>(global_vars);
+}
+
 GlobalTypeVar IRModuleNode::GetGlobalTypeVar(const String& name) const {
   ICHECK(global_type_var_map_.defined());
   auto it = global_type_var_map_.find(name);
@@ -209,6 +231,15 @@ void IRModuleNode::AddUnchecked(const GlobalVar& var, const BaseFunc& func) {
   }
 
   global_var_map_.Set(var->name_hint, var);
+
+  auto id_it = function_id_map_.find(var->name_hint);
+  if (id_it == function_id_map_.end()) {
+    function_id_map_.emplace(var->name_hint, static_cast<int64_t>(function_order_.size()));
+    function_order_.push_back(var);
+  } else {
+    // keep the id slot pointing at the latest var for this name
+    function_order_[id_it->second] = var;
+  }
 }
 
 void IRModuleNode::RegisterConstructors(const GlobalTypeVar& var, const TypeData& type) {
@@ -254,6 +285,12 @@ void IRModuleNode::Remove(const GlobalVar& var) {
   functions_node->erase(var);
   auto gvar_node = global_var_map_.CopyOnWrite();
   gvar_node->erase(var->name_hint);
+  auto id_it = function_id_map_.find(var->name_hint);
+  if (id_it != function_id_map_.end()) {
+    // ids are never reused; leave the slot undefined
+    function_order_[id_it->second] = GlobalVar(nullptr);
+    function_id_map_.erase(id_it);
+  }
 }
 
 BaseFunc IRModuleNode::Lookup(const GlobalVar& var) const {
@@ -85,8 +85,8 @@ TVM_REGISTER_GLOBAL("ir.GetOp").set_body_typed([](String name) -> Op { return Op
 TVM_REGISTER_GLOBAL("ir.OpGetAttr").set_body_typed([](Op op, String attr_name) -> TVMRetValue {
   auto op_map = Op::GetAttrMap<TVMRetValue>(attr_name);
   TVMRetValue rv;
-  if (op_map.count(op)) {
-    rv = op_map[op];
+  if (const TVMRetValue* raw = op_map.GetRaw(op)) {
+    rv = *raw;
   }
   return rv;
 });
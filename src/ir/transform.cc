@@ -24,16 +24,22 @@
 #include <dmlc/thread_local.h>
 #include <tvm/ir/transform.h>
 #include <tvm/node/repr_printer.h>
+#include <tvm/node/serialization.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/container.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 
 #include <chrono>
+#include <cstdlib>
+#include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <stack>
 #include <unordered_set>
 
 #include "../runtime/object_internal.h"
+#include "../support/utils.h"
 
 namespace tvm {
 namespace transform {
@@ -171,6 +177,48 @@ void PassContext::Trace(const IRModule& module, const PassInfo& info, bool is_be
 
 class ModulePass;
 
+/*! \brief Count every reachable node in an object graph, e.g. an IRModule. */
+class NodeCounter : public AttrVisitor {
+ public:
+  void Visit(const char* key, double* value) final {}
+  void Visit(const char* key, int64_t* value) final {}
+  void Visit(const char* key, uint64_t* value) final {}
+  void Visit(const char* key, int* value) final {}
+  void Visit(const char* key, bool* value) final {}
+  void Visit(const char* key, std::string* value) final {}
+  void Visit(const char* key, void** value) final {}
+  void Visit(const char* key, DataType* value) final {}
+  void Visit(const char* key, runtime::NDArray* value) final {}
+
+  void Visit(const char* key, ObjectRef* value) final { Count(value->get()); }
+
+  static size_t Run(const ObjectRef& obj) {
+    NodeCounter counter;
+    counter.Count(obj.get());
+    return counter.visited_.size();
+  }
+
+ private:
+  void Count(const Object* node) {
+    if (node == nullptr || !visited_.insert(node).second) return;
+    if (node->IsInstance<ArrayNode>()) {
+      for (const auto& sp : *static_cast<const ArrayNode*>(node)) {
+        Count(sp.get());
+      }
+    } else if (node->IsInstance<MapNode>()) {
+      for (const auto& kv : *static_cast<const MapNode*>(node)) {
+        Count(kv.first.get());
+        Count(kv.second.get());
+      }
+    } else {
+      reflection_->VisitAttrs(const_cast<Object*>(node), this);
+    }
+  }
+
+  std::unordered_set<const Object*> visited_;
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+};
+
 /*! \brief PassProfile stores profiling information for a given pass and its sub-passes. */
 struct PassProfile {
   // TODO(@altanh): expose PassProfile through TVM Object API
@@ -186,6 +234,14 @@ struct PassProfile {
   Time end;
   /*! \brief The total duration of the pass, i.e. end - start. */
   Duration duration;
+  /*! \brief The number of nodes in the module before the pass ran. */
+  size_t nodes_before{0};
+  /*! \brief The number of nodes in the module after the pass ran. */
+  size_t nodes_after{0};
+  /*! \brief Structural hash of the module before the pass ran. */
+  uint64_t hash_before{0};
+  /*! \brief Structural hash of the module after the pass ran. */
+  uint64_t hash_after{0};
   /*! \brief PassProfiles for all sub-passes invoked during the execution of the pass. */
   std::vector<PassProfile> children;
 
@@ -194,10 +250,10 @@ struct PassProfile {
 
   /*! \brief Gets the PassProfile of the currently executing pass. */
   static PassProfile* Current();
-  /*! \brief Pushes a new PassProfile with the given pass name. */
-  static void EnterPass(String name);
-  /*! \brief Pops the current PassProfile. */
-  static void ExitPass();
+  /*! \brief Pushes a new PassProfile with the given pass name and input module. */
+  static void EnterPass(String name, const IRModule& mod);
+  /*! \brief Pops the current PassProfile, recording the output module. */
+  static void ExitPass(const IRModule& mod);
 };
 
 struct PassProfileThreadLocalEntry {
@@ -214,19 +270,23 @@ struct PassProfileThreadLocalEntry {
 /*! \brief Thread local store to hold the pass profiling data. */
 typedef dmlc::ThreadLocalStore<PassProfileThreadLocalEntry> PassProfileThreadLocalStore;
 
-void PassProfile::EnterPass(String name) {
+void PassProfile::EnterPass(String name, const IRModule& mod) {
   if (!PassProfileThreadLocalStore::Get()->active) return;
   PassProfile* cur = PassProfile::Current();
   cur->children.emplace_back(name);
+  cur->children.back().nodes_before = NodeCounter::Run(mod);
+  cur->children.back().hash_before = StructuralHash()(mod);
   PassProfileThreadLocalStore::Get()->profile_stack.push(&cur->children.back());
 }
 
-void PassProfile::ExitPass() {
+void PassProfile::ExitPass(const IRModule& mod) {
   if (!PassProfileThreadLocalStore::Get()->active) return;
   PassProfile* cur = PassProfile::Current();
   ICHECK_NE(cur->name, "root") << "mismatched enter/exit for pass profiling";
   cur->end = std::move(PassProfile::Clock::now());
   cur->duration = std::chrono::duration_cast<PassProfile::Duration>(cur->end - cur->start);
+  cur->nodes_after = NodeCounter::Run(mod);
+  cur->hash_after = StructuralHash()(mod);
   PassProfileThreadLocalStore::Get()->profile_stack.pop();
 }
 
@@ -239,21 +299,117 @@ PassProfile* PassProfile::Current() {
   }
 }
 
+/*!
+ * \brief Cache of pass results, keyed by the pass name, the pass config, and
+ * the structural hash of the input module.
+ *
+ * The cache is opt-in through the "ir.enable_pass_cache" config option since
+ * a hit replays the recorded result and skips the pass together with its
+ * tracing and diagnostics. Setting TVM_PASS_CACHE_DIR additionally persists
+ * results as JSON-serialized modules in that directory, so byte-identical
+ * rebuilds across processes hit the cache as well.
+ */
+class PassResultCache {
+ public:
+  static PassResultCache* Global() {
+    static auto* inst = new PassResultCache();
+    return inst;
+  }
+
+  static bool Enabled(const PassContext& pass_ctx) {
+    return pass_ctx->GetConfig<Bool>("ir.enable_pass_cache", Bool(false)).value();
+  }
+
+  std::string Key(const PassInfo& info, const PassContext& pass_ctx, const IRModule& mod) const {
+    uint64_t key = std::hash<std::string>()(info->name);
+    key = support::HashCombine(key, StructuralHash()(pass_ctx->config));
+    key = support::HashCombine(key, StructuralHash()(mod));
+    std::ostringstream os;
+    os << std::hex << key;
+    return os.str();
+  }
+
+  bool Lookup(const std::string& key, IRModule* out) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = cache_.find(key);
+      if (it != cache_.end()) {
+        *out = it->second;
+        return true;
+      }
+    }
+    if (persist_dir_.empty()) return false;
+    std::ifstream fs(persist_dir_ + "/" + key + ".json");
+    if (!fs.is_open()) return false;
+    std::ostringstream content;
+    content << fs.rdbuf();
+    *out = Downcast<IRModule>(LoadJSON(content.str()));
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.emplace(key, *out);
+    return true;
+  }
+
+  void Store(const std::string& key, const IRModule& mod) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cache_[key] = mod;
+    }
+    if (persist_dir_.empty()) return;
+    std::ofstream fs(persist_dir_ + "/" + key + ".json", std::ios::trunc);
+    if (!fs.is_open()) {
+      LOG(WARNING) << "Cannot write pass cache entry to " << persist_dir_;
+      return;
+    }
+    fs << SaveJSON(mod);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+  }
+
+ private:
+  PassResultCache() {
+    const char* dir = std::getenv("TVM_PASS_CACHE_DIR");
+    if (dir != nullptr) {
+      persist_dir_ = dir;
+    }
+  }
+
+  std::unordered_map<std::string, IRModule> cache_;
+  std::string persist_dir_;
+  std::mutex mutex_;
+};
+
+TVM_REGISTER_PASS_CONFIG_OPTION("ir.enable_pass_cache", Bool);
+
+TVM_REGISTER_GLOBAL("transform.ClearPassCache").set_body_typed([]() {
+  PassResultCache::Global()->Clear();
+});
+
 IRModule Pass::operator()(IRModule mod) const {
-  const PassNode* node = operator->();
-  ICHECK(node != nullptr);
-  PassProfile::EnterPass(node->Info()->name);
-  auto ret = node->operator()(std::move(mod));
-  PassProfile::ExitPass();
-  return std::move(ret);
+  return this->operator()(std::move(mod), PassContext::Current());
 }
 
 IRModule Pass::operator()(IRModule mod, const PassContext& pass_ctx) const {
   const PassNode* node = operator->();
   ICHECK(node != nullptr);
-  PassProfile::EnterPass(node->Info()->name);
+  PassProfile::EnterPass(node->Info()->name, mod);
+  if (PassResultCache::Enabled(pass_ctx)) {
+    PassResultCache* cache = PassResultCache::Global();
+    std::string key = cache->Key(node->Info(), pass_ctx, mod);
+    IRModule cached;
+    if (cache->Lookup(key, &cached)) {
+      PassProfile::ExitPass(cached);
+      return cached;
+    }
+    auto ret = node->operator()(std::move(mod), pass_ctx);
+    cache->Store(key, ret);
+    PassProfile::ExitPass(ret);
+    return std::move(ret);
+  }
   auto ret = node->operator()(std::move(mod), pass_ctx);
-  PassProfile::ExitPass();
+  PassProfile::ExitPass(ret);
   return std::move(ret);
 }
 
@@ -303,17 +459,60 @@ String RenderPassProfiles() {
     double parent_pct = profile->duration.count() / parent_duration.count() * 100.0;
     double total_pct = profile->duration.count() / top_dur.count() * 100.0;
 
+    int64_t node_delta =
+        static_cast<int64_t>(profile->nodes_after) - static_cast<int64_t>(profile->nodes_before);
+
     os << profile->name << ": ";
     os << std::setprecision(0);
     os << profile->duration.count() << "us [" << self_duration.count() << "us] ";
-    os << std::setprecision(2) << "(" << total_pct << "%; " << parent_pct << "%)\n";
+    os << std::setprecision(2) << "(" << total_pct << "%; " << parent_pct << "%) ";
+    os << "nodes: " << profile->nodes_before << " -> " << profile->nodes_after << " ("
+       << std::showpos << node_delta << std::noshowpos << ")\n";
   }
 
   return os.str();
 }
 
+void WritePassProfileJSON(const PassProfile& profile, std::ostream* os) {
+  *os << "{\"name\":\"" << profile.name << "\""
+      << ",\"duration_us\":" << profile.duration.count()
+      << ",\"nodes_before\":" << profile.nodes_before << ",\"nodes_after\":" << profile.nodes_after
+      << ",\"hash_before\":\"" << std::hex << profile.hash_before << "\""
+      << ",\"hash_after\":\"" << profile.hash_after << "\"" << std::dec << ",\"sub_passes\":[";
+  for (size_t i = 0; i < profile.children.size(); ++i) {
+    if (i != 0) {
+      *os << ",";
+    }
+    WritePassProfileJSON(profile.children[i], os);
+  }
+  *os << "]}";
+}
+
+String RenderPassProfilesJSON() {
+  PassProfileThreadLocalEntry* entry = PassProfileThreadLocalStore::Get();
+  CHECK(entry->profile_stack.empty()) << "cannot print pass profile while still in a pass!";
+
+  if (entry->root.children.empty()) {
+    LOG(WARNING) << "no passes have been profiled, did you enable pass profiling?";
+    return String();
+  }
+
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3) << "[";
+  for (size_t i = 0; i < entry->root.children.size(); ++i) {
+    if (i != 0) {
+      os << ",";
+    }
+    WritePassProfileJSON(entry->root.children[i], &os);
+  }
+  os << "]";
+  return os.str();
+}
+
 TVM_REGISTER_GLOBAL("transform.render_pass_profiles").set_body_typed(RenderPassProfiles);
 
+TVM_REGISTER_GLOBAL("transform.render_pass_profiles_json").set_body_typed(RenderPassProfilesJSON);
+
 TVM_REGISTER_GLOBAL("transform.clear_pass_profiles").set_body_typed([]() {
   PassProfileThreadLocalStore::Get()->root.children.clear();
 });
@@ -69,8 +69,11 @@ class AttrRegistry {
     uint32_t registry_index = static_cast<uint32_t>(entries_.size());
     auto entry = std::unique_ptr<EntryType>(new EntryType(registry_index));
     auto* eptr = entry.get();
-    eptr->name = name;
-    entry_map_[name] = eptr;
+    // Intern the name so every holder of the entry's name shares one
+    // pointer-comparable String.
+    String interned_name = String::Intern(name);
+    eptr->name = interned_name;
+    entry_map_[interned_name] = eptr;
     entries_.emplace_back(std::move(entry));
     return *eptr;
   }
@@ -98,10 +101,13 @@ class AttrRegistry {
                   int plevel) {
     using runtime::TVMRetValue;
     std::lock_guard<std::mutex> lock(mutex_);
-    auto& op_map = attrs_[attr_name];
+    // Attribute names form a small hot key set that is looked up on every
+    // GetAttrMap call; intern them so the lookups compare by pointer.
+    String interned_attr_name = String::Intern(attr_name);
+    auto& op_map = attrs_[interned_attr_name];
     if (op_map == nullptr) {
       op_map.reset(new AttrRegistryMapContainerMap<KeyType>());
-      op_map->attr_name_ = attr_name;
+      op_map->attr_name_ = interned_attr_name;
     }
 
     uint32_t index = key->AttrRegistryIndex();
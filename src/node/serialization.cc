@@ -34,6 +34,9 @@
 #include <cctype>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "../runtime/object_internal.h"
 #include "../support/base64.h"
@@ -473,7 +476,7 @@ struct JSONGraph {
     helper.ReadAllFields(reader);
   }
 
-  static JSONGraph Create(const ObjectRef& root) {
+  static JSONGraph Create(const ObjectRef& root, std::vector<std::string>* raw_ndarrays = nullptr) {
     JSONGraph g;
     NodeIndexer indexer;
     indexer.MakeIndex(const_cast<Object*>(root.get()));
@@ -492,10 +495,16 @@ struct JSONGraph {
     for (DLTensor* tensor : indexer.tensor_list_) {
       std::string blob;
       dmlc::MemoryStringStream mstrm(&blob);
-      support::Base64OutStream b64strm(&mstrm);
-      runtime::SaveDLTensor(&b64strm, tensor);
-      b64strm.Finish();
-      g.b64ndarrays.emplace_back(std::move(blob));
+      if (raw_ndarrays != nullptr) {
+        // the binary format keeps the payload as-is.
+        runtime::SaveDLTensor(&mstrm, tensor);
+        raw_ndarrays->emplace_back(std::move(blob));
+      } else {
+        support::Base64OutStream b64strm(&mstrm);
+        runtime::SaveDLTensor(&b64strm, tensor);
+        b64strm.Finish();
+        g.b64ndarrays.emplace_back(std::move(blob));
+      }
     }
     return g;
   }
@@ -536,6 +545,40 @@ struct JSONGraph {
   }
 };
 
+// Reconstruct the object graph from a loaded node table.
+// This part is shared by the json and the binary format.
+ObjectRef ConstructObjectGraph(JSONGraph* jgraph, const std::vector<runtime::NDArray>& tensors) {
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  size_t n_nodes = jgraph->nodes.size();
+  // Pass 1: create all non-container objects
+  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    const JSONNode& jnode = jgraph->nodes[i];
+    if (jnode.type_key.length() != 0) {
+      nodes[i] = reflection->CreateInitObject(jnode.type_key, jnode.repr_bytes);
+    }
+  }
+  // Pass 2: figure out all field dependency
+  {
+    FieldDependencyFinder dep_finder;
+    for (size_t i = 0; i < n_nodes; ++i) {
+      dep_finder.Find(nodes[i].get(), &jgraph->nodes[i]);
+    }
+  }
+  // Pass 3: topo sort
+  std::vector<size_t> topo_order = jgraph->TopoSort();
+  // Pass 4: set all values
+  {
+    JSONAttrSetter setter;
+    setter.node_list_ = &nodes;
+    setter.tensor_list_ = &tensors;
+    for (size_t i : topo_order) {
+      setter.Set(&nodes[i], &jgraph->nodes[i]);
+    }
+  }
+  return ObjectRef(nodes.at(jgraph->root));
+}
+
 std::string SaveJSON(const ObjectRef& n) {
   auto jgraph = JSONGraph::Create(n);
   std::ostringstream os;
@@ -545,7 +588,6 @@ std::string SaveJSON(const ObjectRef& n) {
 }
 
 ObjectRef LoadJSON(std::string json_str) {
-  ReflectionVTable* reflection = ReflectionVTable::Global();
   JSONGraph jgraph;
   {
     // load in json graph.
@@ -553,7 +595,6 @@ ObjectRef LoadJSON(std::string json_str) {
     dmlc::JSONReader reader(&is);
     jgraph.Load(&reader);
   }
-  size_t n_nodes = jgraph.nodes.size();
   std::vector<runtime::NDArray> tensors;
   {
     // load in tensors
@@ -566,36 +607,197 @@ ObjectRef LoadJSON(std::string json_str) {
       tensors.emplace_back(std::move(temp));
     }
   }
-  // Pass 1: create all non-container objects
-  std::vector<ObjectPtr<Object>> nodes(n_nodes, nullptr);
-  for (size_t i = 0; i < n_nodes; ++i) {
-    const JSONNode& jnode = jgraph.nodes[i];
-    if (jnode.type_key.length() != 0) {
-      nodes[i] = reflection->CreateInitObject(jnode.type_key, jnode.repr_bytes);
+  return ConstructObjectGraph(&jgraph, tensors);
+}
+
+// Magic number that heads the binary object graph format.
+constexpr uint64_t kTVMObjectGraphMagic = 0xAC8E0B3C61D7F1E5;
+
+// LEB128-style varint encoding; node indices and sizes are small,
+// so most of them take a single byte.
+inline void WriteVarUInt(dmlc::Stream* strm, uint64_t value) {
+  while (value >= 0x80) {
+    uint8_t byte = static_cast<uint8_t>(value & 0x7F) | 0x80;
+    strm->Write(&byte, 1);
+    value >>= 7;
+  }
+  uint8_t byte = static_cast<uint8_t>(value);
+  strm->Write(&byte, 1);
+}
+
+inline uint64_t ReadVarUInt(dmlc::Stream* strm) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte;
+    ICHECK_EQ(strm->Read(&byte, 1), 1U) << "Binary object graph is truncated";
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+  LOG(FATAL) << "Binary object graph contains an invalid varint";
+  return 0;
+}
+
+// Pool of interned strings. Type keys, attribute names and many attribute
+// values repeat across nodes; each distinct string is stored once and
+// referenced by varint index afterwards.
+class StringPool {
+ public:
+  size_t Intern(const std::string& s) {
+    auto it = index_.find(s);
+    if (it != index_.end()) return it->second;
+    size_t idx = list_.size();
+    index_.emplace(s, idx);
+    list_.push_back(s);
+    return idx;
+  }
+
+  void Save(dmlc::Stream* strm) const {
+    WriteVarUInt(strm, list_.size());
+    for (const std::string& s : list_) {
+      WriteVarUInt(strm, s.size());
+      strm->Write(s.data(), s.size());
     }
   }
-  // Pass 2: figure out all field dependency
-  {
-    FieldDependencyFinder dep_finder;
-    for (size_t i = 0; i < n_nodes; ++i) {
-      dep_finder.Find(nodes[i].get(), &jgraph.nodes[i]);
+
+  static std::vector<std::string> Load(dmlc::Stream* strm) {
+    std::vector<std::string> list(ReadVarUInt(strm));
+    for (std::string& s : list) {
+      s.resize(ReadVarUInt(strm));
+      if (s.size() != 0) {
+        ICHECK_EQ(strm->Read(&s[0], s.size()), s.size()) << "Binary object graph is truncated";
+      }
     }
+    return list;
   }
-  // Pass 3: topo sort
-  std::vector<size_t> topo_order = jgraph.TopoSort();
-  // Pass 4: set all values
-  {
-    JSONAttrSetter setter;
-    setter.node_list_ = &nodes;
-    setter.tensor_list_ = &tensors;
-    for (size_t i : topo_order) {
-      setter.Set(&nodes[i], &jgraph.nodes[i]);
+
+ private:
+  std::unordered_map<std::string, size_t> index_;
+  std::vector<std::string> list_;
+};
+
+std::string SaveBinary(const ObjectRef& n) {
+  std::vector<std::string> raw_ndarrays;
+  auto jgraph = JSONGraph::Create(n, &raw_ndarrays);
+
+  // First pass: populate the string pool so it can be written up front.
+  StringPool pool;
+  for (const JSONNode& jnode : jgraph.nodes) {
+    pool.Intern(jnode.type_key);
+    for (const auto& kv : jnode.attrs) {
+      pool.Intern(kv.first);
+      pool.Intern(kv.second);
+    }
+    for (const std::string& key : jnode.keys) {
+      pool.Intern(key);
     }
   }
-  return ObjectRef(nodes.at(jgraph.root));
+  for (const auto& kv : jgraph.attrs) {
+    pool.Intern(kv.first);
+    pool.Intern(kv.second);
+  }
+
+  std::string blob;
+  dmlc::MemoryStringStream mstrm(&blob);
+  dmlc::Stream* strm = &mstrm;
+  strm->Write(kTVMObjectGraphMagic);
+  pool.Save(strm);
+  WriteVarUInt(strm, jgraph.attrs.size());
+  for (const auto& kv : jgraph.attrs) {
+    WriteVarUInt(strm, pool.Intern(kv.first));
+    WriteVarUInt(strm, pool.Intern(kv.second));
+  }
+  WriteVarUInt(strm, jgraph.nodes.size());
+  for (const JSONNode& jnode : jgraph.nodes) {
+    WriteVarUInt(strm, pool.Intern(jnode.type_key));
+    // repr bytes can hold arbitrary binary and rarely repeat; stored inline.
+    WriteVarUInt(strm, jnode.repr_bytes.size());
+    strm->Write(jnode.repr_bytes.data(), jnode.repr_bytes.size());
+    WriteVarUInt(strm, jnode.attrs.size());
+    for (const auto& kv : jnode.attrs) {
+      WriteVarUInt(strm, pool.Intern(kv.first));
+      WriteVarUInt(strm, pool.Intern(kv.second));
+    }
+    WriteVarUInt(strm, jnode.keys.size());
+    for (const std::string& key : jnode.keys) {
+      WriteVarUInt(strm, pool.Intern(key));
+    }
+    WriteVarUInt(strm, jnode.data.size());
+    for (size_t index : jnode.data) {
+      WriteVarUInt(strm, index);
+    }
+  }
+  WriteVarUInt(strm, jgraph.root);
+  // raw tensor payloads; SaveDLTensor's layout is self-describing.
+  WriteVarUInt(strm, raw_ndarrays.size());
+  for (const std::string& tensor : raw_ndarrays) {
+    strm->Write(tensor.data(), tensor.size());
+  }
+  return blob;
+}
+
+ObjectRef LoadBinary(std::string blob) {
+  dmlc::MemoryStringStream mstrm(&blob);
+  dmlc::Stream* strm = &mstrm;
+  uint64_t magic = 0;
+  ICHECK(strm->Read(&magic)) << "Binary object graph is truncated";
+  ICHECK_EQ(magic, kTVMObjectGraphMagic) << "The blob is not a binary object graph";
+  std::vector<std::string> pool = StringPool::Load(strm);
+  auto str_at = [&pool](uint64_t index) -> const std::string& {
+    ICHECK_LT(index, pool.size()) << "Binary object graph refers to an unknown string";
+    return pool[index];
+  };
+  JSONGraph jgraph;
+  for (uint64_t i = 0, n = ReadVarUInt(strm); i < n; ++i) {
+    const std::string& key = str_at(ReadVarUInt(strm));
+    jgraph.attrs[key] = str_at(ReadVarUInt(strm));
+  }
+  jgraph.nodes.resize(ReadVarUInt(strm));
+  for (JSONNode& jnode : jgraph.nodes) {
+    jnode.type_key = str_at(ReadVarUInt(strm));
+    jnode.repr_bytes.resize(ReadVarUInt(strm));
+    if (jnode.repr_bytes.size() != 0) {
+      ICHECK_EQ(strm->Read(&jnode.repr_bytes[0], jnode.repr_bytes.size()),
+                jnode.repr_bytes.size())
+          << "Binary object graph is truncated";
+    }
+    for (uint64_t i = 0, n = ReadVarUInt(strm); i < n; ++i) {
+      const std::string& key = str_at(ReadVarUInt(strm));
+      jnode.attrs[key] = str_at(ReadVarUInt(strm));
+    }
+    jnode.keys.resize(ReadVarUInt(strm));
+    for (std::string& key : jnode.keys) {
+      key = str_at(ReadVarUInt(strm));
+    }
+    jnode.data.resize(ReadVarUInt(strm));
+    for (size_t& index : jnode.data) {
+      index = ReadVarUInt(strm);
+    }
+  }
+  jgraph.root = ReadVarUInt(strm);
+  std::vector<runtime::NDArray> tensors;
+  for (uint64_t i = 0, n = ReadVarUInt(strm); i < n; ++i) {
+    runtime::NDArray temp;
+    ICHECK(temp.Load(strm)) << "Invalid NDArray payload in binary object graph";
+    tensors.emplace_back(std::move(temp));
+  }
+  return ConstructObjectGraph(&jgraph, tensors);
 }
 
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body([](runtime::TVMArgs args, runtime::TVMRetValue* rv) {
+  ObjectRef node = args[0];
+  std::string blob = SaveBinary(node);
+  TVMByteArray arr;
+  arr.data = blob.data();
+  arr.size = blob.size();
+  *rv = arr;
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body([](runtime::TVMArgs args, runtime::TVMRetValue* rv) {
+  std::string blob = args[0];
+  *rv = LoadBinary(std::move(blob));
+});
 }  // namespace tvm
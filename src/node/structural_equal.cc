@@ -228,6 +228,11 @@ TVM_REGISTER_GLOBAL("node.StructuralEqual")
     });
 
 bool StructuralEqual::operator()(const ObjectRef& lhs, const ObjectRef& rhs) const {
+  // An object is always structurally equal to itself: free vars compare by
+  // address here, so identity mapping satisfies every constraint. The var
+  // remapping concern that rules out same_as inside the handler (see
+  // SEqualReduce above) only applies to interior nodes.
+  if (lhs.same_as(rhs)) return true;
   return RemapVarSEqualHandler(false).Equal(lhs, rhs, false);
 }
 
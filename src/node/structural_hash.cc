@@ -27,6 +27,7 @@
 #include <tvm/runtime/registry.h>
 
 #include <algorithm>
+#include <mutex>
 #include <unordered_map>
 
 #include "../support/str_escape.h"
@@ -262,6 +263,59 @@ size_t StructuralHash::operator()(const ObjectRef& object) const {
   return VarCountingSHashHandler().Hash(object, false);
 }
 
+/*!
+ * \brief Cross-call cache of structural hashes.
+ *
+ *  Callers like the relay compile engine key repeatedly rehash the same large
+ *  functions. Entries hold strong references to their keys, so a cached
+ *  pointer can never be reused by another allocation; correctness then only
+ *  relies on the keys being structurally immutable after construction, which
+ *  the IR nodes guarantee. Hashing itself runs outside the cache lock so
+ *  concurrent misses on different objects proceed in parallel.
+ */
+class StructuralHashCache {
+ public:
+  static StructuralHashCache* Global() {
+    static StructuralHashCache* inst = new StructuralHashCache();
+    return inst;
+  }
+
+  size_t Hash(const ObjectRef& object) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = memo_.find(object);
+      if (it != memo_.end()) return it->second;
+    }
+    size_t value = VarCountingSHashHandler().Hash(object, false);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Keep the held references bounded; dropping everything is fine since
+    // entries are plain memoization.
+    if (memo_.size() >= kMaxEntries) memo_.clear();
+    memo_.emplace(object, value);
+    return value;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memo_.clear();
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 1 << 16;
+  std::mutex mutex_;
+  std::unordered_map<ObjectRef, size_t, ObjectPtrHash, ObjectPtrEqual> memo_;
+};
+
+size_t StructuralHash::Cached(const ObjectRef& object) {
+  return StructuralHashCache::Global()->Hash(object);
+}
+
+void StructuralHash::InvalidateCache() { StructuralHashCache::Global()->Clear(); }
+
+TVM_REGISTER_GLOBAL("node.StructuralHashCached").set_body_typed([](const ObjectRef& object) {
+  return static_cast<int64_t>(StructuralHash::Cached(object));
+});
+
 // SEQualReduce traits for runtime containers.
 struct StringObjTrait {
   static constexpr const std::nullptr_t VisitAttrs = nullptr;
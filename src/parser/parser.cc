@@ -314,6 +314,9 @@ class Parser {
   /*! \brief The metadata section. */
   MetaTable meta_table;
 
+  /*! \brief Whether token spans alias one placeholder span (TVM_PARSER_FAST_PARSE). */
+  bool fast_mode = FastParseEnabled();
+
   Parser(IRModule module, DiagnosticContext ctx, const Source& source, std::vector<Token> tokens,
          OperatorTable op_table, MetaTable table)
       : module(module),
@@ -588,6 +591,12 @@ class Parser {
     DLOG(INFO) << "WithSpan: start_span = " << start_span;
     R ast = parser();
     if (ast.defined()) {
+      if (fast_mode) {
+        // All token spans alias one placeholder span in fast parse mode;
+        // reuse it instead of allocating a merged span per node.
+        ast->span = start_span;
+        return ast;
+      }
       // The token at the head of the stream is now 1 past where we parsed. So we find its start
       // position as its start and end, so that when we merge we only grow the spanned region
       // to the start of the current stream.
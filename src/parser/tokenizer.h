@@ -28,7 +28,9 @@
 #include <tvm/runtime/container.h>
 #include <tvm/runtime/object.h>
 
+#include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -66,6 +68,47 @@ bool IsIdentLetter(char c) { return '_' == c || ('a' <= c && c <= 'z') || ('A' <
 
 bool IsIdent(char c) { return IsIdentLetter(c) || IsDigit(c); }
 
+/*!
+ * \brief Whether the fast parse mode is enabled (TVM_PARSER_FAST_PARSE=1).
+ *
+ *  In fast mode the tokenizer does not record per-token source positions:
+ *  all tokens alias one placeholder span, so diagnostics lose their exact
+ *  location but token construction does no span allocation. The metadata
+ *  section is also memoized across parses. This makes loading very large
+ *  serialized modules interactive.
+ */
+bool FastParseEnabled() {
+  static const bool enabled = []() {
+    const char* flag = std::getenv("TVM_PARSER_FAST_PARSE");
+    return flag != nullptr && std::string(flag) != "0";
+  }();
+  return enabled;
+}
+
+/*!
+ * \brief Deserialize a metadata section, memoizing on the raw section text
+ *  in fast parse mode.
+ *
+ *  Round-tripping a big module deserializes the same multi-megabyte json
+ *  repeatedly; the loaded nodes are treated as immutable by the parser, so
+ *  sharing them between parses is safe.
+ */
+ObjectRef LoadMetadataSection(const std::string& text) {
+  if (!FastParseEnabled()) {
+    return tvm::LoadJSON(text);
+  }
+  static std::mutex mutex;
+  static std::unordered_map<std::string, ObjectRef> cache;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = cache.find(text);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  ObjectRef metadata = tvm::LoadJSON(text);
+  cache.emplace(text, metadata);
+  return metadata;
+}
+
 static std::unordered_map<std::string, TokenType> KEYWORD_TABLE = {
     {"let", TokenType::kLet},          {"fn", TokenType::kFn},
     {"def", TokenType::kDefn},         {"if", TokenType::kIf},
@@ -84,6 +127,10 @@ struct Tokenizer {
   char next_char;
   String source;
   std::vector<Token> tokens;
+  // fast parse mode: share one placeholder span and intern repeated lexemes
+  bool fast_mode;
+  Span shared_span;
+  std::unordered_map<std::string, String> intern_table;
 
   char Next() {
     char c = this->source.at(this->pos);
@@ -105,17 +152,37 @@ struct Tokenizer {
   }
 
   Token NewToken(TokenType token_type, ObjectRef data = ObjectRef(), int lines = 0, int cols = 1) {
+    if (fast_mode) {
+      return Token(this->shared_span, token_type, data);
+    }
     auto span =
         Span(this->source_name, this->line, this->line + lines, this->col, this->col + cols);
     return Token(span, token_type, data);
   }
 
   Span SpanFrom(int line, int column) {
+    if (fast_mode) {
+      return this->shared_span;
+    }
     int end_line = this->line;
     int end_column = this->col;
     return Span(this->source_name, line, end_line, column, end_column);
   }
 
+  /*!
+   * \brief Return a shared String for a lexeme, so repeated identifiers and
+   *  literals reference one object instead of allocating per occurrence.
+   */
+  String Intern(const std::string& str) {
+    auto it = intern_table.find(str);
+    if (it != intern_table.end()) {
+      return it->second;
+    }
+    String interned(str);
+    intern_table[str] = interned;
+    return interned;
+  }
+
   enum CommentParserState {
     Proceed,
     Forward,
@@ -298,7 +365,7 @@ struct Tokenizer {
         while (More()) {
           metadata << Next();
         }
-        ObjectRef metadata_map = tvm::LoadJSON(metadata.str());
+        ObjectRef metadata_map = LoadMetadataSection(metadata.str());
         auto span = SpanFrom(line, column);
         return Token(span, TokenType::kMetadata, metadata_map);
       }
@@ -354,7 +421,7 @@ struct Tokenizer {
         string_content << Next();
       }
       Next();
-      return NewToken(TokenType::kStringLiteral, tvm::String(string_content.str()));
+      return NewToken(TokenType::kStringLiteral, Intern(string_content.str()));
     } else if (IsWhitespace(next)) {
       auto token = NewToken(TokenType::kWhitespace);
       Next();
@@ -526,7 +593,7 @@ struct Tokenizer {
       }
 
       auto span = SpanFrom(line, col);
-      return Token(span, token_type, tvm::String(ss.str()));
+      return Token(span, token_type, Intern(keyword));
     } else {
       std::stringstream ss;
       while (More() && !IsWhitespace(Peek())) {
@@ -555,7 +622,9 @@ struct Tokenizer {
         col(1),
         line(1),
         source(source->source),
-        tokens() {}
+        tokens(),
+        fast_mode(FastParseEnabled()),
+        shared_span(fast_mode ? Span(source->source_name, 1, 1, 1, 1) : Span()) {}
 };
 
 std::vector<Token> Condense(const std::vector<Token>& tokens, Token* table) {
@@ -99,7 +99,12 @@ Doc& Doc::operator<<(const DocAtom& right) {
 
 std::string Doc::str() {
   std::ostringstream os;
-  for (auto atom : this->stream_) {
+  this->RenderTo(os);
+  return os.str();
+}
+
+void Doc::RenderTo(std::ostream& os) const {  // NOLINT(*)
+  for (const auto& atom : this->stream_) {
     if (auto* text = atom.as<DocTextNode>()) {
       os << text->str;
     } else if (auto* line = atom.as<DocLineNode>()) {
@@ -108,7 +113,6 @@ std::string Doc::str() {
       LOG(FATAL) << "do not expect type " << atom->GetTypeKey();
     }
   }
-  return os.str();
 }
 
 Doc Doc::NewLine(int indent) { return Doc() << DocLine(indent); }
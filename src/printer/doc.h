@@ -30,6 +30,7 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/object.h>
 
+#include <ostream>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -105,6 +106,14 @@ class Doc {
    * \return The string representation.
    */
   std::string str();
+  /*!
+   * \brief Render the doc stream to an output stream.
+   *
+   *  Unlike str() this does not materialize an intermediate string, so it
+   *  can be used to stream very large docs to a file.
+   * \param os The output stream.
+   */
+  void RenderTo(std::ostream& os) const;  // NOLINT(*)
   /*!
    * \brief Create a doc that represents text content.
    * \return The created doc.
@@ -27,6 +27,8 @@
 
 #include <tvm/tir/function.h>
 
+#include <fstream>
+#include <sstream>
 #include <string>
 
 namespace tvm {
@@ -65,27 +67,91 @@ Doc TextPrinter::PrintMod(const IRModule& mod) {
   return doc;
 }
 
+void TextPrinter::PrintModTo(const IRModule& mod, std::ostream& os) {
+  // Each definition is rendered and released before the next one is printed,
+  // so the peak memory use is one definition's doc rather than the module's.
+  int counter = 0;
+  // type definitions
+  for (const auto& kv : mod->type_definitions) {
+    if (counter++ != 0) {
+      os << "\n";
+    }
+    relay_text_printer_.Print(kv.second).RenderTo(os);
+    os << "\n";
+  }
+  // functions
+  for (const auto& kv : mod->functions) {
+    if (kv.second.as<relay::FunctionNode>()) {
+      relay_text_printer_.dg_ =
+          relay::DependencyGraph::Create(&relay_text_printer_.arena_, kv.second);
+    }
+    if (counter++ != 0) {
+      os << "\n";
+    }
+    if (kv.second.as<relay::FunctionNode>()) {
+      std::ostringstream name_os;
+      name_os << "def @" << kv.first->name_hint;
+      relay_text_printer_.PrintFunc(Doc::Text(name_os.str()), kv.second).RenderTo(os);
+    } else if (kv.second.as<tir::PrimFuncNode>()) {
+      tir_text_printer_.PrintPrimFunc(Downcast<tir::PrimFunc>(kv.second)).RenderTo(os);
+    }
+    os << "\n";
+  }
+}
+
+void TextPrinter::PrintFinalTo(const ObjectRef& node, std::ostream& os) {
+  if (node->IsInstance<IRModuleNode>()) {
+    PrintModTo(Downcast<IRModule>(node), os);
+  } else if (node->IsInstance<tir::PrimFuncNode>() || node->IsInstance<PrimExprNode>() ||
+             node->IsInstance<tir::StmtNode>()) {
+    tir_text_printer_.Print(node).RenderTo(os);
+  } else {
+    relay_text_printer_.PrintFinal(node).RenderTo(os);
+  }
+  if (!meta_.empty()) {
+    os << "\n";
+    if (show_meta_data_) {
+      os << "#[metadata]\n";
+      meta_.GetMetaSection().RenderTo(os);
+    } else if (show_warning_) {
+      os << "/* For debugging purposes the metadata section has been omitted.\n"
+         << " * If you would like to see the full metadata section you can set the \n"
+         << " * option to `True` when invoking `astext`. \n"
+         << " */";
+    }
+  }
+}
+
 String PrettyPrint(const ObjectRef& node) {
-  Doc doc;
-  doc << TextPrinter(false, nullptr, false).PrintFinal(node);
-  return doc.str();
+  std::ostringstream os;
+  TextPrinter(false, nullptr, false).PrintFinalTo(node, os);
+  return os.str();
 }
 
 String AsText(const ObjectRef& node, bool show_meta_data,
               runtime::TypedPackedFunc<String(ObjectRef)> annotate) {
-  Doc doc;
-  doc << "#[version = \"" << kSemVer << "\"]" << Doc::NewLine();
+  std::ostringstream os;
+  os << "#[version = \"" << kSemVer << "\"]\n";
   runtime::TypedPackedFunc<std::string(ObjectRef)> ftyped = nullptr;
   if (annotate != nullptr) {
     ftyped = runtime::TypedPackedFunc<std::string(ObjectRef)>(
         [&annotate](const ObjectRef& expr) -> std::string { return annotate(expr); });
   }
-  doc << TextPrinter(show_meta_data, ftyped).PrintFinal(node);
-  return doc.str();
+  TextPrinter(show_meta_data, ftyped).PrintFinalTo(node, os);
+  return os.str();
+}
+
+void AsTextToFile(const ObjectRef& node, const String& file_name, bool show_meta_data) {
+  std::ofstream os(file_name.operator std::string());
+  ICHECK(!os.fail()) << "Cannot open file " << file_name << " for writing";
+  os << "#[version = \"" << kSemVer << "\"]\n";
+  TextPrinter(show_meta_data, nullptr).PrintFinalTo(node, os);
 }
 
 TVM_REGISTER_GLOBAL("ir.PrettyPrint").set_body_typed(PrettyPrint);
 
 TVM_REGISTER_GLOBAL("ir.AsText").set_body_typed(AsText);
 
+TVM_REGISTER_GLOBAL("ir.AsTextToFile").set_body_typed(AsTextToFile);
+
 }  // namespace tvm
@@ -35,6 +35,7 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <ostream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -414,7 +415,25 @@ class TextPrinter {
     return doc;
   }
 
+  /*!
+   * \brief Print the node to an output stream.
+   *
+   *  Modules are rendered one definition at a time, so the peak memory use is
+   *  bounded by the largest definition instead of the whole module. Prefer
+   *  this entry point when writing large modules to a file.
+   * \param node The node to be printed.
+   * \param os The output stream.
+   */
+  void PrintFinalTo(const ObjectRef& node, std::ostream& os);  // NOLINT(*)
+
   Doc PrintMod(const IRModule& mod);
+
+  /*!
+   * \brief Stream the module to an output stream, one definition at a time.
+   * \param mod The module to be printed.
+   * \param os The output stream.
+   */
+  void PrintModTo(const IRModule& mod, std::ostream& os);  // NOLINT(*)
 };
 }  // namespace tvm
 
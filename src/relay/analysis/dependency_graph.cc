@@ -76,7 +76,9 @@ class DependencyGraph::Creator : private MixedModeVisitor {
   void VisitLeaf(const Expr& e) override {
     if (visited_.count(e) == 0) {
       if (graph_.expr_node.count(e) == 0) {
-        graph_.expr_node[e] = NewNode(false);
+        DependencyGraph::Node* n = NewNode(false);
+        n->expr = e.get();
+        graph_.expr_node[e] = n;
       }
       visited_.insert(e);
       MixedModeVisitor::VisitLeaf(e);
@@ -49,6 +49,10 @@ class DependencyGraph {
     // Determine scope boundaries. Used for calculating scopes, not for
     // constructing dependency graph.
     bool new_scope = false;
+    // The expression this node stands for; nullptr for the synthetic
+    // scope nodes created around if branches, function bodies etc.
+    // Does not hold a reference: the graph keeps the root alive.
+    const ExprNode* expr = nullptr;
     // incoming edges
     LinkedList<Node*> children;
     // outgoing edges
@@ -23,6 +23,7 @@
  */
 
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/object.h>
@@ -192,10 +193,64 @@ class AOTExecutorCodegen : public ExprVisitor {
     }
   }
 
+  /*!
+   * \brief Return the raw data pointers backing the storage of an expression.
+   *
+   * Used in direct-call mode, where kernels are lowered with MakeUnpackedAPI
+   * and take the data pointers themselves rather than DLTensor handles.
+   */
+  std::vector<PrimExpr> UnpackedBuffers(Expr expr) {
+    auto input_iter = std::find(input_vars_.begin(), input_vars_.end(), expr);
+    if (input_iter != input_vars_.end()) {
+      // Input variable: the signature carries the DLTensor handle
+      int main_index = std::distance(input_vars_.begin(), input_iter);
+      return {tvm::tir::Call(DataType::Handle(), tvm::tir::builtin::tvm_struct_get(),
+                             {main_signature_[main_index], 0, tir::builtin::kArrData})};
+    } else if (params_by_expr_.find(expr) != params_by_expr_.end()) {
+      // Parameter of the network: lookup_param already yields the data pointer
+      return {tvm::tir::Call(DataType::Handle(), tvm::tir::builtin::lookup_param(),
+                             {tir::StringImm(params_by_expr_[expr])})};
+    }
+    // Storage identifiers: sid buffers are allocated in the main function
+    // and used directly, outputs are handles from the signature
+    std::vector<PrimExpr> buffers;
+    Array<IntegerArray> sids = storage_device_map_[expr];
+    for (const auto& sid : sids[0]) {
+      int sid_int = static_cast<int>((sid.as<IntImmNode>())->value);
+      auto output_iter = std::find(return_sid_.begin(), return_sid_.end(), sid_int);
+      if (output_iter != return_sid_.end()) {
+        int output_index = std::distance(return_sid_.begin(), output_iter);
+        buffers.push_back(
+            tvm::tir::Call(DataType::Handle(), tvm::tir::builtin::tvm_struct_get(),
+                           {main_signature_[input_vars_.size() + output_index], 0,
+                            tir::builtin::kArrData}));
+      } else {
+        buffers.push_back(sids_table_[sid_int]);
+      }
+    }
+    return buffers;
+  }
+
   /*!
    * brief Call a function with a given name
    */
   void CreateFuncCall(Call call, std::string func_name) {
+    if (use_unpacked_api_) {
+      // Direct-call mode: emit a call_extern to the kernel's unpacked
+      // symbol, passing raw data pointers. There is no DLTensor staging
+      // and no packed-function dispatch at runtime.
+      tvm::Array<PrimExpr> args{tvm::tir::StringImm(func_name)};
+      for (Expr arg : call->args) {
+        args.push_back(UnpackedBuffers(arg)[0]);
+      }
+      for (const auto& buffer : UnpackedBuffers(Downcast<Expr>(call))) {
+        args.push_back(buffer);
+      }
+      stmts_.push_back(tir::Evaluate(
+          tvm::tir::Call(DataType::Int(32), tvm::tir::builtin::call_extern(), args)));
+      return;
+    }
+
     tvm::Array<PrimExpr> args{tvm::tir::StringImm(func_name)};
     std::vector<tir::Stmt> create_func_call_stmts;
 
@@ -561,6 +616,8 @@ class AOTExecutorCodegen : public ExprVisitor {
   std::vector<tir::Stmt> stmts_;
   /*! \brief the list of return sids (note that the function might return more then one output */
   IntegerArray return_sid_;
+  /*! \brief whether kernels are called through their unpacked symbol directly */
+  bool use_unpacked_api_{false};
 
  public:
   AOTExecutorCodegen(runtime::Module* mod, const TargetsMap& targets, Target target_host)
@@ -571,6 +628,13 @@ class AOTExecutorCodegen : public ExprVisitor {
   }
 
   LoweredOutput Codegen(relay::Function func) {
+    // Keep in sync with the pass pipeline: when tir.use_unpacked_api is set
+    // the kernels are lowered with MakeUnpackedAPI, so the main function has
+    // to call their unpacked symbols with raw data pointers.
+    use_unpacked_api_ = tvm::transform::PassContext::Current()
+                            ->GetConfig<Bool>("tir.use_unpacked_api", Bool(false))
+                            .value();
+
     // Get the module, storage map and token sizes
     auto pf = GetPackedFunc("relay.backend.GraphPlanMemory");
     storage_device_map_ = (*pf)(func);
@@ -388,6 +388,9 @@ class RelayBuildModule : public runtime::ModuleNode {
     // Fuse the operations if it is needed.
     relay_module = transform::FuseOps()(relay_module);
 
+    // Batch leftover small kernels; no-op unless enabled in the pass context.
+    relay_module = transform::BatchSmallOps()(relay_module);
+
     // Do layout rewrite for auto-scheduler.
     if (backend::IsAutoSchedulerEnabled() && targets.size() == 1) {
       const auto& target = (*targets.begin()).second;
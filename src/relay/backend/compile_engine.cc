@@ -25,12 +25,14 @@
 
 #include <tvm/driver/driver_api.h>
 #include <tvm/ir/type_functor.h>
+#include <tvm/node/serialization.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/device_copy.h>
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op.h>
 #include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
 #include <tvm/runtime/container.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/te/operation.h>
@@ -38,10 +40,15 @@
 #include <tvm/te/schedule_pass.h>
 #include <tvm/topi/tags.h>
 
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <mutex>
+#include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -94,6 +101,88 @@ Array<IndexExpr> GetShape(const Array<IndexExpr>& shape) {
   return res;
 }
 
+// Rewrites every dynamic (Any) dimension in tensor types to a fixed size.
+class DynamicDimRewriter : public TypeMutator {
+ public:
+  explicit DynamicDimRewriter(int64_t size) : size_(size) {}
+
+  Type VisitType_(const TensorTypeNode* op) final {
+    Array<IndexExpr> shape;
+    bool dynamic = false;
+    for (const IndexExpr& dim : op->shape) {
+      if (dim.as<tir::AnyNode>()) {
+        dynamic = true;
+        shape.push_back(IntImm(DataType::Int(32), size_));
+      } else {
+        shape.push_back(dim);
+      }
+    }
+    return dynamic ? TensorType(shape, op->dtype) : GetRef<Type>(op);
+  }
+
+ private:
+  int64_t size_;
+};
+
+/*!
+ * \brief Produce a statically shaped clone of a function with dynamic dims.
+ *
+ * Every Any dimension in the signature is pinned to \p size and the body is
+ * re-inferred so internal checked types become static as well. The uniform
+ * substitution matches how dynamic dims arise in practice: a fused primitive
+ * sees one varying extent (a sequence length or batch) threaded through all
+ * of its tensors.
+ *
+ * \param func The function with dynamic dims in its signature.
+ * \param size The static size to substitute for every dynamic dim.
+ * \return The statically shaped function.
+ */
+Function SpecializeFunctionShapes(const Function& func, int64_t size) {
+  DynamicDimRewriter rewriter(size);
+  Array<Var> params;
+  Map<Var, Expr> binds;
+  for (const Var& param : func->params) {
+    Type ann = param->type_annotation.defined() ? param->type_annotation : param->checked_type();
+    Var new_param(param->vid, rewriter.VisitType(ann));
+    params.push_back(new_param);
+    binds.Set(param, new_param);
+  }
+  Function spec(params, Bind(func->body, binds), rewriter.VisitType(func->ret_type),
+                func->type_params, func->attrs);
+  IRModule mod = IRModule::FromExpr(spec);
+  mod = transform::InferType()(mod);
+  return Downcast<Function>(mod->Lookup("main"));
+}
+
+/*!
+ * \brief Encode the static shapes of the lowered kernel's tensor args, e.g.
+ * "_16x64_64" for a (16, 64) and a (64,) tensor, with "_s" for scalars.
+ *
+ * This is the same encoding the VM's shape-specialized dispatch derives from
+ * runtime arguments, so a kernel lowered under "<name>_spec<sig>" is found by
+ * the inline cache without any extra plumbing.
+ *
+ * \param args The kernel's tensors, inputs followed by outputs.
+ * \return The signature, or an empty string if any dim is not a constant.
+ */
+std::string StaticShapeSignature(const Array<te::Tensor>& args) {
+  std::ostringstream os;
+  for (const te::Tensor& t : args) {
+    os << '_';
+    if (t->shape.empty()) {
+      os << 's';
+      continue;
+    }
+    for (size_t i = 0; i < t->shape.size(); ++i) {
+      const int64_t* dim = tir::as_const_int(t->shape[i]);
+      if (dim == nullptr) return "";
+      if (i != 0) os << 'x';
+      os << *dim;
+    }
+  }
+  return os.str();
+}
+
 // The getter to get schedule from compile engine.
 // Get schedule from functor.
 class ScheduleGetter : public backend::MemoizedExprTranslator<Array<te::Tensor>> {
@@ -712,13 +801,18 @@ class CompileEngineImpl : public CompileEngineNode {
  private:
   // implement lowered func
   CCacheValue LowerInternal(const CCacheKey& key) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     CCacheValue value;
     auto it = cache_.find(key);
     if (it != cache_.end()) {
       it->second->use_count += 1;
       if (it->second->cached_func.defined()) return it->second;
       value = it->second;
+      // Another thread is lowering this entry; wait so the work is done once.
+      while (lowering_in_progress_.count(key)) {
+        lowering_cv_.wait(lock);
+      }
+      if (value->cached_func.defined()) return value;
     } else {
       value = CCacheValue(make_object<CCacheValueNode>());
       value->use_count = 0;
@@ -740,10 +834,55 @@ class CompileEngineImpl : public CompileEngineNode {
       value->cached_func = CachedFunc(cache_node);
       return value;
     }
+
+    ICHECK(!value->cached_func.defined());
+    // Scheduling and lowering dominate the time spent here and only touch the
+    // engine state through GetUniqueName, which has its own lock. Release the
+    // engine lock so independent functions can be lowered concurrently; the
+    // entry is published once the lock is re-taken.
+    lowering_in_progress_.insert(key);
+    lock.unlock();
+    CachedFunc cached_func;
+    try {
+      cached_func = LowerToModule(key);
+    } catch (...) {
+      lock.lock();
+      lowering_in_progress_.erase(key);
+      lowering_cv_.notify_all();
+      throw;
+    }
+    lock.lock();
+    lowering_in_progress_.erase(key);
+    lowering_cv_.notify_all();
+    value->cached_func = cached_func;
+    return value;
+  }
+  /*!
+   * \brief Schedule and lower a non-external function.
+   *
+   *  Runs without the engine lock held; must only touch thread-safe or
+   *  thread-local state (target/pass contexts are scoped per thread).
+   *
+   * \param key The compile engine cache key.
+   * \return The lowered function.
+   */
+  CachedFunc LowerToModule(const CCacheKey& key) {
     // Enforce use the target.
     With<Target> target_scope(key->target);
 
-    ICHECK(!value->cached_func.defined());
+    // Number of schedule candidates to emit per kernel for online selection
+    // in the graph executor (see set_online_tuning). 1 emits only the best.
+    const int64_t num_variants = transform::PassContext::Current()
+                                     ->GetConfig<Integer>("relay.backend.kernel_variants", Integer(1))
+                                     .value()
+                                     ->value;
+    // Declared static sizes to pin dynamic dims to; each one adds a
+    // shape-specialized kernel alongside the generic one.
+    Array<Integer> dispatch_buckets =
+        transform::PassContext::Current()
+            ->GetConfig<Array<Integer>>("relay.backend.shape_dispatch_buckets", Array<Integer>())
+            .value();
+
     auto cfunc = CreateSchedule(key->source_func, key->target);
     auto cache_node = make_object<CachedFuncNode>(*(cfunc.operator->()));
 
@@ -751,8 +890,7 @@ class CompileEngineImpl : public CompileEngineNode {
     const Expr body = (key->source_func)->body;
     if (const CallNode* call_node = body.as<CallNode>()) {
       if (call_node->attrs.as<DeviceCopyAttrs>()) {
-        value->cached_func = CachedFunc(cache_node);
-        return value;
+        return CachedFunc(cache_node);
       }
     }
 
@@ -762,6 +900,16 @@ class CompileEngineImpl : public CompileEngineNode {
     for (te::Tensor arg : cache_node->outputs) {
       all_args.push_back(arg);
     }
+    // Reuse an earlier lowering of the same function from the disk cache.
+    // The cache key captures neither the variant nor the bucket config, so
+    // builds that emit extra kernels bypass it.
+    if (!DiskCacheDir().empty() && num_variants <= 1 && dispatch_buckets.empty()) {
+      IRModule cached = LoadLoweredFromDisk(key, cache_node->func_name);
+      if (cached.defined()) {
+        cache_node->funcs = cached;
+        return CachedFunc(cache_node);
+      }
+    }
     // lower the function
     if (const auto* f = runtime::Registry::Get("relay.backend.lower")) {
       cache_node->funcs = (*f)(cfunc->schedule, all_args, cache_node->func_name, key->source_func);
@@ -772,8 +920,63 @@ class CompileEngineImpl : public CompileEngineNode {
       std::unordered_map<te::Tensor, tir::Buffer> binds;
       cache_node->funcs = tvm::lower(cfunc->schedule, all_args, cache_node->func_name, binds);
     }
-    value->cached_func = CachedFunc(cache_node);
-    return value;
+    // Lower additional schedule candidates under "<name>__variant_<k>"
+    // symbols. They ride along in the same module so the graph executor can
+    // time them online and lock in the fastest one. Variant k asks the op
+    // strategy for its k-th candidate implementation; a candidate that fails
+    // to schedule is skipped.
+    for (int64_t k = 1; k < num_variants; ++k) {
+      auto ctx_node = make_object<transform::PassContextNode>(
+          *transform::PassContext::Current().operator->());
+      ctx_node->config.Set("relay.backend.kernel_variant_index", Integer(static_cast<int>(k)));
+      transform::PassContext variant_ctx(ctx_node);
+      With<transform::PassContext> variant_scope(variant_ctx);
+      try {
+        auto vfunc = CreateSchedule(key->source_func, key->target);
+        Array<te::Tensor> variant_args = vfunc->inputs;
+        for (te::Tensor arg : vfunc->outputs) {
+          variant_args.push_back(arg);
+        }
+        std::string variant_name = cache_node->func_name + "__variant_" + std::to_string(k);
+        With<transform::PassContext> fresh_pass_ctx_scope(transform::PassContext::Create());
+        std::unordered_map<te::Tensor, tir::Buffer> binds;
+        cache_node->funcs->Update(tvm::lower(vfunc->schedule, variant_args, variant_name, binds));
+      } catch (const std::exception& err) {
+        DLOG(WARNING) << "Failed to lower variant " << k << " of " << cache_node->func_name << ": "
+                      << err.what();
+      }
+    }
+    // For functions with dynamic dims, additionally lower a statically shaped
+    // kernel per declared bucket. Each lands in the same module under the
+    // "<name>_spec<shapes>" symbol the VM's shape-specialized dispatch probes
+    // at runtime, so shapes inside the declared envelope get static-shape
+    // code without deploying a module per size. A bucket that fails to
+    // schedule is skipped; the generic kernel always remains the fallback.
+    if (!dispatch_buckets.empty() && IsDynamic(key->source_func->checked_type())) {
+      for (const Integer& bucket : dispatch_buckets) {
+        try {
+          Function spec_func = SpecializeFunctionShapes(key->source_func, bucket->value);
+          auto sfunc = CreateSchedule(spec_func, key->target);
+          Array<te::Tensor> spec_args = sfunc->inputs;
+          for (te::Tensor arg : sfunc->outputs) {
+            spec_args.push_back(arg);
+          }
+          std::string sig = StaticShapeSignature(spec_args);
+          if (sig.empty()) continue;
+          std::string spec_name = cache_node->func_name + "_spec" + sig;
+          With<transform::PassContext> fresh_pass_ctx_scope(transform::PassContext::Create());
+          std::unordered_map<te::Tensor, tir::Buffer> binds;
+          cache_node->funcs->Update(tvm::lower(sfunc->schedule, spec_args, spec_name, binds));
+        } catch (const std::exception& err) {
+          DLOG(WARNING) << "Failed to lower shape bucket " << bucket->value << " of "
+                        << cache_node->func_name << ": " << err.what();
+        }
+      }
+    }
+    if (!DiskCacheDir().empty() && num_variants <= 1 && dispatch_buckets.empty()) {
+      SaveLoweredToDisk(key, cache_node->funcs);
+    }
+    return CachedFunc(cache_node);
   }
   // implement lowered shape func
   CCacheValue LowerShapeFuncInternal(const CCacheKey& key) {
@@ -811,12 +1014,79 @@ class CompileEngineImpl : public CompileEngineNode {
     value->cached_func = CachedFunc(cache_node);
     return value;
   }
+  /*!
+   * \brief Directory of the persistent lowering cache, empty when disabled.
+   *
+   *  When TVM_COMPILE_ENGINE_CACHE_DIR points at an existing directory, the
+   *  lowered IRModule of every primitive function is saved there, keyed by
+   *  CCacheKeyNode::Hash (structural hash of the function combined with the
+   *  target string). Later processes that lower the same function then skip
+   *  the schedule lowering pipeline and load the module instead. The key does
+   *  not capture autotvm tuning logs, so use a separate directory per log.
+   */
+  static const std::string& DiskCacheDir() {
+    static const std::string dir = []() {
+      const char* val = std::getenv("TVM_COMPILE_ENGINE_CACHE_DIR");
+      return val != nullptr ? std::string(val) : std::string();
+    }();
+    return dir;
+  }
+  /*!
+   * \brief Get the path of the disk cache entry of a cache key.
+   * \param key The compile engine cache key.
+   * \return The file path of the entry.
+   */
+  std::string DiskCachePath(const CCacheKey& key) {
+    std::ostringstream os;
+    os << DiskCacheDir() << "/" << std::hex << key->Hash() << ".lowered.json";
+    return os.str();
+  }
+  /*!
+   * \brief Try to load a previously lowered module from the disk cache.
+   * \param key The compile engine cache key.
+   * \param func_name The unique name assigned to the function in this process.
+   * \return The cached module, or an undefined module on a miss.
+   */
+  IRModule LoadLoweredFromDisk(const CCacheKey& key, const std::string& func_name) {
+    std::ifstream fs(DiskCachePath(key), std::ios::in | std::ios::binary);
+    if (fs.fail()) return IRModule(nullptr);
+    std::stringstream ss;
+    ss << fs.rdbuf();
+    IRModule funcs;
+    try {
+      funcs = Downcast<IRModule>(LoadJSON(ss.str()));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Ignore corrupted compile cache entry " << DiskCachePath(key) << ": "
+                   << e.what();
+      return IRModule(nullptr);
+    }
+    // The entry is only reusable when this process assigned the same unique
+    // name to the function; otherwise treat it as a miss and re-lower.
+    if (!funcs->ContainGlobalVar(func_name)) return IRModule(nullptr);
+    return funcs;
+  }
+  /*!
+   * \brief Save a lowered module to the disk cache.
+   * \param key The compile engine cache key.
+   * \param funcs The lowered module.
+   */
+  void SaveLoweredToDisk(const CCacheKey& key, const IRModule& funcs) {
+    std::string path = DiskCachePath(key);
+    std::ofstream fs(path, std::ios::out | std::ios::binary);
+    if (fs.fail()) {
+      LOG(WARNING) << "Cannot write compile cache entry " << path;
+      return;
+    }
+    std::string json = SaveJSON(funcs);
+    fs.write(json.data(), json.length());
+  }
   /*!
    * \brief Get unique name from name.
    * \param name The orginal name.
    * \return Updated name which is unique.
    */
   std::string GetUniqueName(std::string name) {
+    std::lock_guard<std::mutex> lock(name_map_mutex_);
     for (size_t i = 0; i < name.length(); ++i) {
       if (name[i] == '.') name[i] = '_';
     }
@@ -836,6 +1106,12 @@ class CompileEngineImpl : public CompileEngineNode {
   }
   /*! \brief compiler cache lock*/
   std::mutex mutex_;
+  /*! \brief signaled when a key is erased from lowering_in_progress_ */
+  std::condition_variable lowering_cv_;
+  /*! \brief keys whose lowering runs outside the cache lock right now */
+  std::unordered_set<CCacheKey> lowering_in_progress_;
+  /*! \brief lock for name_map_, which is also read while lowering */
+  std::mutex name_map_mutex_;
   /*! \brief internal name map to get an unique name */
   std::unordered_map<std::string, int> name_map_;
   /*! \brief internal compiler cache */
@@ -855,7 +1131,10 @@ CompileEngine& CompileEngine::Global() {
 }
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_auto_scheduler", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.kernel_variants", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.kernel_variant_index", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.disable_compile_engine_cache", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.shape_dispatch_buckets", Array<Integer>);
 
 TVM_REGISTER_GLOBAL("relay.backend._make_LoweredOutput")
     .set_body_typed([](tvm::Array<te::Tensor> outputs, OpImplementation impl) {
@@ -261,7 +261,9 @@ bool IsDynamic(const Type& ty);
 inline size_t CCacheKeyNode::Hash() const {
   if (hash_ != 0) return hash_;
   // do structral hash, avoid 0.
-  hash_ = tvm::StructuralHash()(this->source_func);
+  // go through the cross-call cache: every pass that builds a key for the
+  // same function would otherwise rehash its whole body.
+  hash_ = tvm::StructuralHash::Cached(this->source_func);
   hash_ = dmlc::HashCombine(hash_, std::hash<std::string>()(target->str()));
   if (hash_ == 0) hash_ = 1;
   return hash_;
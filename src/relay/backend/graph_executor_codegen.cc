@@ -25,14 +25,23 @@
 #include <dmlc/any.h>
 #include <dmlc/json.h>
 #include <tvm/ir/module.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/object.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/function.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <list>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "compile_engine.h"
@@ -77,6 +86,10 @@ class GraphNodeRef {
 
   inline void Load(dmlc::JSONReader* reader) { LOG(FATAL) << "Not implemented."; }
 
+  inline int ident() const { return ident_; }
+  inline int index() const { return index_; }
+  inline int version() const { return version_; }
+
  protected:
   int ident_;
   int index_{0};
@@ -272,14 +285,24 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
 
   LoweredOutput Codegen(relay::Function func) {
     auto pf = GetPackedFunc("relay.backend.GraphPlanMemory");
-    storage_device_map_ = (*pf)(func);
+    // Storage views (concat inputs / split outputs sharing one buffer) rely on
+    // pointer arithmetic into a flat address space, so only enable them for
+    // homogeneous compilation on targets whose device memory is flat.
+    bool use_storage_views = false;
+    if (targets_.size() == 1) {
+      const std::string& kind = (*targets_.begin()).second->kind->name;
+      use_storage_views = kind == "llvm" || kind == "c" || kind == "cuda" || kind == "rocm";
+    }
+    storage_device_map_ = (*pf)(func, use_storage_views);
     UpdateMainWorkspaceSize(func);
+    ParallelPreLower(func);
     // First we convert all the parameters into input nodes.
     for (auto param : func->params) {
       auto node_ptr = GraphInputNode::make_node_ptr(param->name_hint(), GraphAttrs());
       var_map_[param.get()] = AddNode(node_ptr, param);
     }
     heads_ = VisitExpr(func->body);
+    ReorderNodes();
     std::ostringstream os;
     dmlc::JSONWriter writer(&os);
     GetJSON(&writer);
@@ -306,6 +329,43 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
   }
 
  protected:
+  /*!
+   * \brief Lower all fused functions through the compile engine ahead of the
+   *  graph traversal, in parallel.
+   *
+   *  The graph traversal then only hits warm cache entries. Enabled by
+   *  setting TVM_RELAY_PARALLEL_LOWER; it must stay off when op strategies
+   *  or the lowering hook are registered from Python, since packed functions
+   *  implemented in Python cannot be entered from worker threads.
+   *
+   * \param func The main function.
+   */
+  void ParallelPreLower(const Function& func) {
+    const char* flag = std::getenv("TVM_RELAY_PARALLEL_LOWER");
+    if (flag == nullptr || std::string(flag) == "0") return;
+    std::vector<CCacheKey> keys;
+    std::unordered_set<CCacheKey> seen;
+    PostOrderVisit(func, [&](const Expr& expr) {
+      const CallNode* op = expr.as<CallNode>();
+      if (op == nullptr) return;
+      const auto* fn = op->op.as<FunctionNode>();
+      if (fn == nullptr) return;
+      Function f = GetRef<Function>(fn);
+      if (!f->HasNonzeroAttr(attr::kPrimitive)) return;
+      // External functions are only wrapped, not lowered; reshape-only
+      // functions that share storage become nops. Mirror the skips of
+      // VisitExpr_(CallNode) so no unused function gets lowered.
+      if (f->GetAttr<String>(attr::kCompiler).defined()) return;
+      if (f->HasNonzeroAttr(attr::kReshapeOnly) && ShareSameStorage(expr, op->args[0])) return;
+      if (IsStorageViewNop(op, f)) return;
+      if (!storage_device_map_.count(expr)) return;
+      auto call_dev_type = storage_device_map_[expr][1][0]->value;
+      CCacheKey key(f, GetTargetFromInteger(call_dev_type));
+      if (seen.insert(key).second) keys.push_back(key);
+    });
+    support::parallel_for(0, static_cast<int>(keys.size()),
+                          [&](int i) { compile_engine_->Lower(keys[i]); });
+  }
   /*!
    * \brief Extract shape from expr to vector<int64_t>
    *
@@ -333,13 +393,19 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     size_t count = storage_device_map_.count(expr);
     ICHECK_GT(count, 0) << "Expr is not existing in storage plan";
     auto storage_device_info = storage_device_map_[expr];
-    ICHECK_EQ(storage_device_info.size(), 3);
+    ICHECK_EQ(storage_device_info.size(), 4);
     // storage
     std::vector<int64_t> storage_info;
     for (auto& v : storage_device_info[0]) {
       storage_info.push_back(v->value);
     }
     node->attrs_["storage_id"] = std::move(storage_info);
+    // byte offset inside the storage; nonzero only for planned storage views
+    std::vector<int64_t> storage_offsets;
+    for (auto& v : storage_device_info[3]) {
+      storage_offsets.push_back(v->value);
+    }
+    node->attrs_["storage_offset"] = std::move(storage_offsets);
     // type
     std::vector<int64_t> device_types;
     for (auto& v : storage_device_info[1]) {
@@ -398,6 +464,19 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
 
   std::vector<GraphNodeRef> VisitExpr_(const ConstantNode* op) override {
     Expr expr = GetRef<Expr>(op);
+    // Layout folding and parallel-op combining leave distinct Constant nodes
+    // carrying identical tensors; emit a single parameter for all of them so
+    // the weight is stored and loaded once. The structural hash of a constant
+    // covers its tensor contents.
+    int64_t device_type = storage_device_map_[expr][1][0]->value;
+    size_t hash = StructuralHash::Cached(expr);
+    auto range = dedup_params_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.device_type == device_type &&
+          StructuralEqual()(it->second.expr, expr)) {
+        return it->second.refs;
+      }
+    }
     size_t index = params_.size();
     std::string name = "p" + std::to_string(index);
     auto node = GraphInputNode::make_node_ptr(name, GraphAttrs());
@@ -405,6 +484,7 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     CHECK_EQ(to_return.size(), 1) << "Expected exactly 1 parameter node created";
     param_storage_ids_[name] = storage_device_map_[expr][0][0]->value;
     params_[name] = op->data;
+    dedup_params_.emplace(hash, DedupParam{expr, device_type, to_return});
     return to_return;
   }
 
@@ -432,6 +512,51 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     return AddNode(node, GetRef<Expr>(op));
   }
 
+  /*!
+   * \brief Whether a fused concatenate or split call became a storage view.
+   *
+   * The memory planner may place the producers of an outermost-axis concat
+   * directly into the concat output buffer, and the outputs of an
+   * outermost-axis split at offsets into the split input. When it did, every
+   * entry of the call shares the storage id of its counterpart and the call
+   * itself moves no bytes, so it can be emitted as a __nop like a
+   * storage-sharing reshape. If the planner bailed on any input (for example
+   * because a producer's storage was claimed by reshape aliasing), the
+   * storage ids differ and the real kernel is emitted.
+   *
+   * \param op The call to the fused function.
+   * \param func The fused function it calls.
+   */
+  bool IsStorageViewNop(const CallNode* op, const Function& func) {
+    static const Op& concat_op = Op::Get("concatenate");
+    static const Op& split_op = Op::Get("split");
+    const auto* body = func->body.as<CallNode>();
+    if (body == nullptr) return false;
+    Expr expr = GetRef<Expr>(op);
+    if (body->op.same_as(concat_op)) {
+      const auto* param = body->attrs.as<ConcatenateAttrs>();
+      if (param == nullptr || param->axis != 0) return false;
+      if (op->args.size() < 2) return false;
+      for (const Expr& arg : op->args) {
+        if (!ShareSameStorage(expr, arg)) return false;
+      }
+      return true;
+    }
+    if (body->op.same_as(split_op)) {
+      const auto* param = body->attrs.as<SplitAttrs>();
+      if (param == nullptr || param->axis != 0) return false;
+      if (op->args.size() != 1) return false;
+      int64_t in_sid = storage_device_map_[op->args[0]][0][0]->value;
+      const auto& out_sids = storage_device_map_[expr][0];
+      if (out_sids.size() < 2) return false;
+      for (const auto& sid : out_sids) {
+        if (sid->value != in_sid) return false;
+      }
+      return true;
+    }
+    return false;
+  }
+
   bool ShareSameStorage(const Expr& lhs, const Expr& rhs) {
     auto lit = storage_device_map_.find(lhs);
     auto rit = storage_device_map_.find(rhs);
@@ -566,6 +691,13 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       return GraphAddCallNode(op, "reshape_nop", "__nop", attrs);
     }
 
+    // Concat inputs and split outputs planned as views of one buffer make the
+    // data-movement call itself a nop; the offsets ride the storage_offset
+    // graph attribute.
+    if (IsStorageViewNop(op, func)) {
+      return GraphAddCallNode(op, "storage_view_nop", "__nop", attrs);
+    }
+
     ICHECK_GE(storage_device_map_.count(expr), 0);
     auto& device_type = storage_device_map_[expr][1];
     auto call_dev_type = device_type[0]->value;
@@ -631,6 +763,149 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     throw std::invalid_argument("match case not yet implemented");
     return {};
   }
+  /*!
+   * \brief Reorder the graph nodes to shrink the live set of intermediates.
+   *
+   * The expression traversal emits one valid topological order, but for
+   * branchy graphs it can place the consumers of a large activation far
+   * from its producer, keeping the tensor live (and long evicted from
+   * cache) across unrelated work. Re-schedule greedily: among the ready
+   * nodes always run the one that releases the most intermediate bytes
+   * net of what it allocates, falling back to the original order on ties.
+   * Nodes touching the same storage id keep their original relative
+   * order, so tensors that share a storage id under the memory plan still
+   * never overlap in the new schedule.
+   */
+  void ReorderNodes() {
+    size_t num_nodes = nodes_.size();
+    if (num_nodes < 3) return;
+    // Per-entry bytes and storage ids, with entries flattened across nodes
+    // in the same way as node_row_ptr.
+    std::vector<size_t> entry_off{0};
+    std::vector<size_t> entry_bytes;
+    std::vector<int64_t> entry_sid;
+    for (const auto& node : nodes_) {
+      const auto& shape_vec = dmlc::get<ShapeVector>(node->attrs_["shape"]);
+      const auto& dtype_vec = dmlc::get<std::vector<std::string>>(node->attrs_["dtype"]);
+      const auto& sids = dmlc::get<std::vector<int64_t>>(node->attrs_["storage_id"]);
+      for (size_t j = 0; j < shape_vec.size(); ++j) {
+        DLDataType t = runtime::String2DLDataType(dtype_vec[j]);
+        size_t bytes = (t.bits * t.lanes + 7) / 8;
+        for (int64_t dim : shape_vec[j]) {
+          bytes *= static_cast<size_t>(dim);
+        }
+        entry_bytes.push_back(bytes);
+        entry_sid.push_back(sids[j]);
+      }
+      entry_off.push_back(entry_bytes.size());
+    }
+    // Dependency edges: data inputs, plus a chain over every storage id so
+    // its original toucher order is preserved.
+    std::vector<int> indegree(num_nodes, 0);
+    std::vector<std::vector<size_t>> succs(num_nodes);
+    std::vector<std::vector<size_t>> input_eids(num_nodes);
+    auto add_edge = [&](size_t src, size_t dst) {
+      if (src == dst) return;
+      succs[src].push_back(dst);
+      ++indegree[dst];
+    };
+    std::vector<int> entry_uses(entry_bytes.size(), 0);
+    std::unordered_map<int64_t, size_t> last_sid_toucher;
+    for (size_t i = 0; i < num_nodes; ++i) {
+      std::vector<int64_t> touched(entry_sid.begin() + entry_off[i],
+                                   entry_sid.begin() + entry_off[i + 1]);
+      if (const auto* op = dynamic_cast<const GraphOpNode*>(nodes_[i].get())) {
+        for (const auto& ref : op->inputs_) {
+          size_t eid = entry_off[ref.ident()] + ref.index();
+          ++entry_uses[eid];
+          input_eids[i].push_back(eid);
+          touched.push_back(entry_sid[eid]);
+          add_edge(static_cast<size_t>(ref.ident()), i);
+        }
+      }
+      for (int64_t sid : touched) {
+        auto it = last_sid_toucher.find(sid);
+        if (it != last_sid_toucher.end() && it->second != i) {
+          add_edge(it->second, i);
+        }
+        last_sid_toucher[sid] = i;
+      }
+    }
+    // Greedy list scheduling. Input nodes carry no cost and no release, so
+    // they score zero and surface right before their first consumer.
+    std::vector<size_t> entry_producer(entry_bytes.size());
+    for (size_t i = 0; i < num_nodes; ++i) {
+      for (size_t e = entry_off[i]; e < entry_off[i + 1]; ++e) entry_producer[e] = i;
+    }
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < num_nodes; ++i) {
+      if (indegree[i] == 0) ready.push_back(i);
+    }
+    std::vector<size_t> order;
+    order.reserve(num_nodes);
+    while (!ready.empty()) {
+      size_t best_at = 0;
+      int64_t best_score = 0;
+      for (size_t k = 0; k < ready.size(); ++k) {
+        size_t i = ready[k];
+        int64_t score = 0;
+        if (nodes_[i]->Type() == kGraphOpNode) {
+          for (size_t e = entry_off[i]; e < entry_off[i + 1]; ++e) {
+            score -= static_cast<int64_t>(entry_bytes[e]);
+          }
+          for (size_t eid : input_eids[i]) {
+            // released if this is the last consumer; count duplicate uses
+            // of the same entry within this node's argument list.
+            if (nodes_[entry_producer[eid]]->Type() != kGraphOpNode) continue;
+            int occurrences = 0;
+            for (size_t other : input_eids[i]) {
+              if (other == eid) ++occurrences;
+            }
+            if (entry_uses[eid] == occurrences) {
+              score += static_cast<int64_t>(entry_bytes[eid]) / occurrences;
+            }
+          }
+        }
+        if (k == 0 || score > best_score ||
+            (score == best_score && i < ready[best_at])) {
+          best_at = k;
+          best_score = score;
+        }
+      }
+      size_t picked = ready[best_at];
+      ready.erase(ready.begin() + best_at);
+      order.push_back(picked);
+      for (size_t eid : input_eids[picked]) --entry_uses[eid];
+      for (size_t succ : succs[picked]) {
+        if (--indegree[succ] == 0) ready.push_back(succ);
+      }
+    }
+    ICHECK_EQ(order.size(), num_nodes);
+    bool identity = true;
+    for (size_t i = 0; i < num_nodes; ++i) {
+      if (order[i] != i) identity = false;
+    }
+    if (identity) return;
+    // Renumber every node reference against the new order.
+    std::vector<int> old_to_new(num_nodes);
+    std::vector<GraphObjectPtr> new_nodes;
+    new_nodes.reserve(num_nodes);
+    for (size_t i = 0; i < num_nodes; ++i) {
+      old_to_new[order[i]] = static_cast<int>(i);
+      new_nodes.push_back(nodes_[order[i]]);
+    }
+    nodes_ = std::move(new_nodes);
+    auto remap = [&](const GraphNodeRef& ref) {
+      return GraphNodeRef(old_to_new[ref.ident()], ref.index(), ref.version());
+    };
+    for (auto& node : nodes_) {
+      if (auto* op = dynamic_cast<GraphOpNode*>(node.get())) {
+        for (auto& ref : op->inputs_) ref = remap(ref);
+      }
+    }
+    for (auto& ref : heads_) ref = remap(ref);
+  }
+
   /*!
    * \brief Generate Graph JSON
    *
@@ -647,12 +922,14 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     size_t num_entry = 0;
     ShapeVector shapes;
     std::vector<size_t> storage_ids;
+    std::vector<size_t> within_offsets;
     std::vector<size_t> device_types;
     std::vector<std::string> dltypes;
     std::vector<size_t> node_row_ptr{0};
     for (auto node : nodes_) {
       const auto& shape_vec = dmlc::get<ShapeVector>(node->attrs_["shape"]);
       const auto& storage_id = dmlc::get<std::vector<int64_t>>(node->attrs_["storage_id"]);
+      const auto& storage_offset = dmlc::get<std::vector<int64_t>>(node->attrs_["storage_offset"]);
       const auto& dtype_vec = dmlc::get<std::vector<std::string>>(node->attrs_["dtype"]);
 
       ICHECK_EQ(node->num_outputs_, shape_vec.size());
@@ -661,6 +938,7 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
       shapes.insert(shapes.end(), shape_vec.begin(), shape_vec.end());
       dltypes.insert(dltypes.end(), dtype_vec.begin(), dtype_vec.end());
       storage_ids.insert(storage_ids.end(), storage_id.begin(), storage_id.end());
+      within_offsets.insert(within_offsets.end(), storage_offset.begin(), storage_offset.end());
       if (node->attrs_.count("device_index")) {
         const auto& dev_types = dmlc::get<std::vector<int64_t>>(node->attrs_["device_index"]);
         device_types.insert(device_types.end(), dev_types.begin(), dev_types.end());
@@ -679,6 +957,16 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     if (device_types.size()) {
       attrs["device_index"].emplace_back(std::string("list_int"));
       attrs["device_index"].emplace_back(device_types);
+    } else {
+      // Single-device graphs additionally carry a static memory plan: the byte
+      // offset of each entry's storage inside one contiguous pool. Runtimes
+      // that allocate per storage id simply skip the attribute; the CRT graph
+      // executor uses it to replace many page-allocator requests with a single
+      // allocation, eliminating per-entry page rounding and fragmentation.
+      std::vector<size_t> storage_offsets =
+          PlanStorageOffsets(shapes, storage_ids, within_offsets, dltypes);
+      attrs["storage_offset"].emplace_back(std::string("list_int"));
+      attrs["storage_offset"].emplace_back(storage_offsets);
     }
     attrs["dltype"].emplace_back(std::string("list_str"));
     attrs["dltype"].emplace_back(dltypes);
@@ -687,6 +975,55 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
     writer->EndObject();
   }
 
+  /*!
+   * \brief Lay out every storage id at a fixed offset in one contiguous pool.
+   *
+   * Each storage id is sized to the largest entry mapped onto it and placed
+   * sequentially with aligned starts, so the pool total matches what per-id
+   * allocation would use, without the allocator's page-granularity overhead.
+   * Entries planned as storage views carry a nonzero offset inside their
+   * storage id; it is folded into the pool offset (and into the id's size)
+   * so each view lands at its byte range of the shared buffer.
+   *
+   * \param shapes Shape of each data entry.
+   * \param storage_ids Storage id assigned to each data entry by GraphPlanMemory.
+   * \param within_offsets Byte offset of each data entry inside its storage id.
+   * \param dltypes Data type string of each data entry.
+   * \return The byte offset of each data entry's storage.
+   */
+  std::vector<size_t> PlanStorageOffsets(const ShapeVector& shapes,
+                                         const std::vector<size_t>& storage_ids,
+                                         const std::vector<size_t>& within_offsets,
+                                         const std::vector<std::string>& dltypes) const {
+    std::vector<size_t> sid_bytes;
+    for (size_t i = 0; i < storage_ids.size(); ++i) {
+      size_t sid = storage_ids[i];
+      if (sid >= sid_bytes.size()) {
+        sid_bytes.resize(sid + 1, 0);
+      }
+      DLDataType t = runtime::String2DLDataType(dltypes[i]);
+      size_t bits = t.bits * t.lanes;
+      size_t bytes = (bits + 7) / 8;
+      for (int64_t dim : shapes[i]) {
+        bytes *= static_cast<size_t>(dim);
+      }
+      sid_bytes[sid] = std::max(sid_bytes[sid], bytes + within_offsets[i]);
+    }
+    std::vector<size_t> sid_offsets(sid_bytes.size(), 0);
+    size_t pool_size = 0;
+    for (size_t sid = 0; sid < sid_bytes.size(); ++sid) {
+      sid_offsets[sid] = pool_size;
+      size_t aligned = (sid_bytes[sid] + runtime::kAllocAlignment - 1) / runtime::kAllocAlignment *
+                       runtime::kAllocAlignment;
+      pool_size += aligned;
+    }
+    std::vector<size_t> storage_offsets(storage_ids.size());
+    for (size_t i = 0; i < storage_ids.size(); ++i) {
+      storage_offsets[i] = sid_offsets[storage_ids[i]] + within_offsets[i];
+    }
+    return storage_offsets;
+  }
+
   /*!
    * \brief Get unique name for func
    *
@@ -722,6 +1059,14 @@ class GraphExecutorCodegen : public backend::MemoizedExprTranslator<std::vector<
    */
   std::unordered_map<std::string, runtime::NDArray> params_;
   std::unordered_map<std::string, int64_t> param_storage_ids_;
+  /*! \brief A parameter emitted for a constant, used to fold duplicates. */
+  struct DedupParam {
+    Expr expr;
+    int64_t device_type;
+    std::vector<GraphNodeRef> refs;
+  };
+  /*! \brief emitted parameters keyed by the constant's structural hash */
+  std::unordered_multimap<size_t, DedupParam> dedup_params_;
   /*! \brief plan memory of device result */
   Map<Expr, Array<IntegerArray>> storage_device_map_;
   /*! \brief lowered funcs */
@@ -23,8 +23,10 @@
  *   the program in the graph executor.
  */
 #include <tvm/relay/analysis.h>
+#include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/expr.h>
 #include <tvm/relay/expr_functor.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/tir/op.h>
 
 #include "../../support/arena.h"
@@ -46,8 +48,38 @@ struct StorageToken {
   int device_type{0};
   /*! \brief The storage id */
   int64_t storage_id{-1};
+  /*!
+   * \brief The token whose storage this token aliases, or nullptr.
+   *
+   *  View tokens carry no storage of their own: they resolve to a byte range
+   *  of their base token, which turns pure data-movement ops (outermost-axis
+   *  concatenate and split) into pointer arithmetic. Views are never put on
+   *  the free list, since their bytes belong to the base.
+   */
+  StorageToken* view_of{nullptr};
+  /*! \brief Byte offset inside the storage of the base token. */
+  size_t byte_offset{0};
 };
 
+/*!
+ * \brief Get the memory requirement of a token.
+ * \param prototype The prototype token.
+ * \return The required memory size.
+ */
+static size_t GetMemorySize(StorageToken* prototype) {
+  const TensorTypeNode* ttype = prototype->ttype;
+  ICHECK(ttype != nullptr);
+  size_t size = 1;
+  for (IndexExpr dim : ttype->shape) {
+    const int64_t* pval = tir::as_const_int(dim);
+    ICHECK(pval != nullptr) << "Cannot allocate memory symbolic tensor shape " << ttype->shape;
+    ICHECK_GE(*pval, 0) << "Cannot allocate memory for tensor with negative shape" << *pval;
+    size *= static_cast<size_t>(pval[0]);
+  }
+  size *= (ttype->dtype.bits() * ttype->dtype.lanes() + 7) / 8;
+  return size;
+}
+
 class StorageAllocaBaseVisitor : public ExprVisitor {
  public:
   // run the visitor on a function.
@@ -127,13 +159,20 @@ class StorageAllocaBaseVisitor : public ExprVisitor {
 
 class StorageAllocaInit : protected StorageAllocaBaseVisitor {
  public:
-  explicit StorageAllocaInit(support::Arena* arena) : arena_(arena) {}
+  StorageAllocaInit(support::Arena* arena, bool enable_storage_views)
+      : arena_(arena), enable_storage_views_(enable_storage_views) {}
 
   /*! \return The internal token map */
   std::unordered_map<const ExprNode*, std::vector<StorageToken*> > GetInitTokenMap(
       const Function& func) {
     node_device_map_ = CollectDeviceInfo(func);
     this->Run(func);
+    // Device annotations may route tensors to devices without a flat address
+    // space, where a byte-offset view cannot be expressed; only plan views
+    // for homogeneous graphs the caller has vouched for.
+    if (enable_storage_views_ && node_device_map_.empty()) {
+      MarkStorageViews();
+    }
     return std::move(token_map_);
   }
 
@@ -177,13 +216,142 @@ class StorageAllocaInit : protected StorageAllocaBaseVisitor {
   }
 
  private:
+  /*!
+   * \brief Return the call a fused function wraps, if its body is exactly one op.
+   * \param call The call to a fused function.
+   * \param op The operator to look for.
+   * \return The inner call, or nullptr if the function computes anything else.
+   */
+  static const CallNode* GetOnlyOpBody(const CallNode* call, const Op& op) {
+    const auto* fn = call->op.as<FunctionNode>();
+    if (fn == nullptr) return nullptr;
+    const auto* body = fn->body.as<CallNode>();
+    if (body == nullptr || !body->op.same_as(op)) return nullptr;
+    return body;
+  }
+
+  /*!
+   * \brief Turn concatenate inputs and split outputs into views.
+   *
+   *  An outermost-axis concatenate only lays its inputs out back to back, so
+   *  when each input is produced by a call and read by nothing else, the
+   *  producers can write straight into adjacent ranges of the concat output
+   *  buffer and the concat becomes a nop. Split is the mirror image: its
+   *  outputs are adjacent ranges of the input. Marking happens on the
+   *  prototype tokens, before any storage is assigned, so producers allocate
+   *  into the packed buffer from the start; the graph codegen later drops
+   *  the kernel for calls whose inputs and outputs ended up on one storage.
+   */
+  void MarkStorageViews() {
+    for (const auto& kv : token_map_) {
+      if (!kv.first->IsInstance<CallNode>()) continue;
+      const auto* call = static_cast<const CallNode*>(kv.first);
+      TryMarkConcatViews(call);
+      TryMarkSplitViews(call);
+    }
+  }
+
+  void TryMarkConcatViews(const CallNode* call) {
+    static const Op& concat_op = Op::Get("concatenate");
+    const CallNode* body = GetOnlyOpBody(call, concat_op);
+    if (body == nullptr) return;
+    const auto* fn = call->op.as<FunctionNode>();
+    // The wrapper must pass its parameters through in order, so that outer
+    // argument i is exactly tuple field i of the concatenated input.
+    const auto* tuple = body->args[0].as<TupleNode>();
+    if (tuple == nullptr || call->args.size() != tuple->fields.size() ||
+        fn->params.size() != tuple->fields.size()) {
+      return;
+    }
+    for (size_t i = 0; i < tuple->fields.size(); ++i) {
+      if (!tuple->fields[i].same_as(fn->params[i])) return;
+    }
+    const auto* attrs = body->attrs.as<ConcatenateAttrs>();
+    auto out_it = token_map_.find(call);
+    if (attrs == nullptr || out_it == token_map_.end() || out_it->second.size() != 1) return;
+    StorageToken* out = out_it->second[0];
+    int ndim = static_cast<int>(out->ttype->shape.size());
+    int axis = attrs->axis < 0 ? attrs->axis + ndim : attrs->axis;
+    if (axis != 0 || call->args.size() < 2) return;
+    std::vector<StorageToken*> fields;
+    for (const Expr& arg : call->args) {
+      // Only call-produced inputs can be redirected; parameters and
+      // constants have externally owned storage.
+      if (!arg->IsInstance<CallNode>()) return;
+      auto it = token_map_.find(arg.get());
+      if (it == token_map_.end() || it->second.size() != 1) return;
+      StorageToken* tok = it->second[0];
+      // ref_counter == 1 means the concat is the only reader.
+      if (tok->ref_counter != 1 || tok->view_of != nullptr) return;
+      fields.push_back(tok);
+    }
+    std::vector<size_t> offsets;
+    size_t offset = 0;
+    for (StorageToken* tok : fields) {
+      // Producer kernels may assume their output pointer is aligned the way
+      // a fresh allocation would be.
+      if (offset % runtime::kAllocAlignment != 0) return;
+      offsets.push_back(offset);
+      offset += GetMemorySize(tok);
+    }
+    if (offset != GetMemorySize(out)) return;
+    for (size_t i = 0; i < fields.size(); ++i) {
+      fields[i]->view_of = out;
+      fields[i]->byte_offset = offsets[i];
+    }
+  }
+
+  void TryMarkSplitViews(const CallNode* call) {
+    static const Op& split_op = Op::Get("split");
+    const CallNode* body = GetOnlyOpBody(call, split_op);
+    if (body == nullptr) return;
+    const auto* fn = call->op.as<FunctionNode>();
+    if (call->args.size() != 1 || fn->params.size() != 1 ||
+        !body->args[0].same_as(fn->params[0])) {
+      return;
+    }
+    const auto* attrs = body->attrs.as<SplitAttrs>();
+    auto in_it = token_map_.find(call->args[0].get());
+    auto out_it = token_map_.find(call);
+    if (attrs == nullptr || in_it == token_map_.end() || in_it->second.size() != 1 ||
+        out_it == token_map_.end() || out_it->second.size() < 2) {
+      return;
+    }
+    StorageToken* in = in_it->second[0];
+    int ndim = static_cast<int>(in->ttype->shape.size());
+    int axis = attrs->axis < 0 ? attrs->axis + ndim : attrs->axis;
+    // The split must be the only reader: an in-place update of a dying
+    // output view could otherwise clobber bytes another reader still needs.
+    if (axis != 0 || in->ref_counter != 1) return;
+    const std::vector<StorageToken*>& outs = out_it->second;
+    std::vector<size_t> offsets;
+    size_t offset = 0;
+    for (StorageToken* tok : outs) {
+      if (tok->view_of != nullptr) return;
+      if (offset % runtime::kAllocAlignment != 0) return;
+      offsets.push_back(offset);
+      offset += GetMemorySize(tok);
+    }
+    if (offset != GetMemorySize(in)) return;
+    for (size_t i = 0; i < outs.size(); ++i) {
+      outs[i]->view_of = in;
+      outs[i]->byte_offset = offsets[i];
+    }
+    // Pin the input: its storage must survive all reads through the views.
+    in->ref_counter += 1;
+  }
+
   // allocator
   support::Arena* arena_;
+  bool enable_storage_views_;
   Map<Expr, Integer> node_device_map_;
 };
 
 class StorageAllocator : public StorageAllocaBaseVisitor {
  public:
+  explicit StorageAllocator(bool enable_storage_views)
+      : enable_storage_views_(enable_storage_views) {}
+
   /*!
    * \return totoal number of bytes allocated
    */
@@ -197,11 +365,13 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
 
   // Run storage allocation for a function.
   Map<Expr, Array<IntegerArray> > Plan(const Function& func) {
-    prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
+    prototype_ = StorageAllocaInit(&arena_, enable_storage_views_).GetInitTokenMap(func);
     this->Run(func);
 
-    // The value of smap contains two integer arrays where the first array
-    // contains the planned storage ids and the second holds the device types.
+    // The value of smap contains integer arrays where the first array
+    // contains the planned storage ids, the second holds the device types,
+    // the third the sizes in bytes and the fourth the byte offset of each
+    // entry inside its storage (nonzero only for view tokens).
     Map<Expr, Array<IntegerArray> > smap;
     int num_annotated_nodes = 0;
     int num_nodes = 0;
@@ -210,6 +380,7 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
       std::vector<Integer> storage_ids;
       std::vector<Integer> device_types;
       std::vector<Integer> sid_sizes_byte;
+      std::vector<Integer> byte_offsets;
       for (StorageToken* tok : kv.second) {
         if (tok->device_type) {
           num_annotated_nodes++;
@@ -218,9 +389,10 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
         storage_ids.push_back(tok->storage_id);
         device_types.push_back(tok->device_type);
         sid_sizes_byte.push_back(GetMemorySize(tok));
+        byte_offsets.push_back(static_cast<int64_t>(tok->byte_offset));
       }
       smap.Set(GetRef<Expr>(kv.first),
-               Array<IntegerArray>({storage_ids, device_types, sid_sizes_byte}));
+               Array<IntegerArray>({storage_ids, device_types, sid_sizes_byte, byte_offsets}));
     }
     // Either all or none of the nodes should be annotated.
     if (num_annotated_nodes != 0 && num_annotated_nodes != num_nodes) {
@@ -241,7 +413,16 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     std::vector<StorageToken*> tokens;
 
     for (StorageToken* tok : it->second) {
-      if (can_realloc) {
+      if (tok->view_of != nullptr) {
+        // The init pass planned this output as a view; bind it to a byte
+        // range of its base storage instead of requesting its own.
+        ResolveView(tok);
+        tokens.push_back(tok);
+      } else if (tok->storage_id >= 0) {
+        // Storage was already materialized by a view pointing at this token
+        // (e.g. a concat output allocated by its first producer).
+        tokens.push_back(tok);
+      } else if (can_realloc) {
         tokens.push_back(Request(tok));
       } else {
         // Allocate a new token,
@@ -254,6 +435,27 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     }
     token_map_[op] = tokens;
   }
+  /*!
+   * \brief Materialize the storage a view aliases and bind the view to it.
+   *
+   *  Bases form chains when concats or splits nest, so offsets accumulate;
+   *  after resolution byte_offset is relative to the storage id itself.
+   */
+  void ResolveView(StorageToken* tok) {
+    if (tok->storage_id >= 0) return;
+    StorageToken* base = tok->view_of;
+    ICHECK(base != nullptr);
+    if (base->storage_id < 0) {
+      if (base->view_of != nullptr) {
+        ResolveView(base);
+      } else {
+        Alloc(base, GetMemorySize(base));
+      }
+    }
+    tok->storage_id = base->storage_id;
+    tok->byte_offset += base->byte_offset;
+    tok->max_bytes = GetMemorySize(tok);
+  }
   // Mark op to reuse the input_token
   // tie the two memories together
   void ReuseInputToken(const ExprNode* op, StorageToken* input_token) {
@@ -290,6 +492,13 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     if (IsReshape(op)) {
       ICHECK_EQ(args.size(), 1U);
       ReuseInputToken(op, args[0]);
+    } else if (HasPlannedStorage(op)) {
+      // the output storage was fixed by view planning; honoring it keeps the
+      // concat or split this call feeds a nop.
+      CreateToken(op, true);
+    } else if (StorageToken* inplace_tok = FindInplaceArg(op, args)) {
+      // run the elementwise call in place on a dying input.
+      ReuseInputToken(op, inplace_tok);
     } else {
       // create token for the call node.
       CreateToken(op, true);
@@ -304,12 +513,17 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     }
   }
   /*!
-   * \brief ceil(size/word_size) to get number of words.
-   * \param size The original size.
-   * \param word_size The element size.
+   * \brief Whether view planning already fixed the storage of the outputs.
+   * \param call The call to be checked.
+   * \return the check result.
    */
-  static size_t DivRoundUp(size_t size, size_t word_size) {
-    return (size + word_size - 1) / word_size;
+  bool HasPlannedStorage(const CallNode* call) {
+    auto it = prototype_.find(call);
+    ICHECK(it != prototype_.end());
+    for (StorageToken* tok : it->second) {
+      if (tok->view_of != nullptr || tok->storage_id >= 0) return true;
+    }
+    return false;
   }
   /*!
    * \brief The call is an reshape only op
@@ -323,22 +537,46 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     return false;
   }
   /*!
-   * \brief Get the memory requirement.
-   * \param prototype The prototype token.
-   * \return The required memory size.
+   * \brief Find an argument whose storage the call can update in place.
+   *
+   *  An all-elementwise fused function writes every output element from the
+   *  same index of its inputs, so it may overwrite an input whose last read
+   *  this call holds. Only single-output calls qualify, and only arguments
+   *  on the same device that match the output element for element in memory;
+   *  parameters and constants keep an extra reference and are therefore
+   *  never picked.
+   *
+   * \param call The call to be planned.
+   * \param args The argument tokens of the call.
+   * \return The reusable token, or nullptr if none qualifies.
    */
-  size_t GetMemorySize(StorageToken* prototype) {
-    const TensorTypeNode* ttype = prototype->ttype;
-    ICHECK(ttype != nullptr);
-    size_t size = 1;
-    for (IndexExpr dim : ttype->shape) {
-      const int64_t* pval = tir::as_const_int(dim);
-      ICHECK(pval != nullptr) << "Cannot allocate memory symbolic tensor shape " << ttype->shape;
-      ICHECK_GE(*pval, 0) << "Cannot allocate memory for tensor with negative shape" << *pval;
-      size *= static_cast<size_t>(pval[0]);
-    }
-    size *= DivRoundUp(ttype->dtype.bits() * ttype->dtype.lanes(), 8);
-    return size;
+  StorageToken* FindInplaceArg(const CallNode* call, const std::vector<StorageToken*>& args) {
+    const auto* fn = call->op.as<FunctionNode>();
+    if (fn == nullptr || !fn->HasNonzeroAttr(attr::kElemwiseOnly)) return nullptr;
+    auto it = prototype_.find(call);
+    ICHECK(it != prototype_.end());
+    if (it->second.size() != 1U) return nullptr;
+    StorageToken* proto = it->second[0];
+    size_t size = GetMemorySize(proto);
+    const DataType& out_dtype = proto->ttype->dtype;
+    for (StorageToken* tok : args) {
+      // ref_counter == 1 means this call is the only remaining reader.
+      // An argument passed twice to the call counts twice and is skipped.
+      if (tok->ref_counter != 1) continue;
+      if (tok->device_type != proto->device_type) continue;
+      // Views occupy a byte range of a larger storage; writing over one
+      // could race with readers of its base.
+      if (tok->view_of != nullptr) continue;
+      // Output element i must land on the exact bytes that held input
+      // element i, which requires equal element widths and equal element
+      // counts. A width-changing cast shifts every element's byte offset,
+      // so an in-place kernel would clobber inputs it has not read yet.
+      const DataType& in_dtype = tok->ttype->dtype;
+      if (in_dtype.bits() * in_dtype.lanes() != out_dtype.bits() * out_dtype.lanes()) continue;
+      if (GetMemorySize(tok) != size) continue;
+      return tok;
+    }
+    return nullptr;
   }
   /*!
    * \brief Request a storage token for a given prototype.
@@ -401,7 +639,9 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   void CheckForRelease(StorageToken* tok) {
     ICHECK_GE(tok->storage_id, 0);
     ICHECK_GE(tok->ref_counter, 0);
-    if (tok->ref_counter == 0) {
+    // A view does not own its bytes; releasing it would hand a live range of
+    // its base storage to an unrelated tensor.
+    if (tok->ref_counter == 0 && tok->view_of == nullptr) {
       free_.insert({tok->max_bytes, tok});
     }
   }
@@ -409,6 +649,8 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
  private:
   // allocator
   support::Arena arena_;
+  // whether concat/split storage views may be planned
+  bool enable_storage_views_{false};
   // scale used for rough match
   size_t match_range_{16};
   // free list of storage entry
@@ -419,11 +661,16 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   std::unordered_map<const ExprNode*, std::vector<StorageToken*> > prototype_;
 };
 
-Map<Expr, Array<IntegerArray> > GraphPlanMemory(const Function& func) {
-  return StorageAllocator().Plan(func);
+Map<Expr, Array<IntegerArray> > GraphPlanMemory(const Function& func, bool enable_storage_views) {
+  return StorageAllocator(enable_storage_views).Plan(func);
 }
 
-TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory").set_body_typed(GraphPlanMemory);
+TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory").set_body([](TVMArgs args, TVMRetValue* rv) {
+  // Storage views assume a flat address space on every device; the graph
+  // executor codegen opts in after checking its targets.
+  bool enable_storage_views = args.num_args > 1 ? static_cast<bool>(args[1]) : false;
+  *rv = GraphPlanMemory(args[0], enable_storage_views);
+});
 
 }  // namespace relay
 }  // namespace tvm
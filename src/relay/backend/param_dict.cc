@@ -49,6 +49,14 @@ TVM_REGISTER_GLOBAL("tvm.relay._save_param_dict")
 TVM_REGISTER_GLOBAL("tvm.relay._load_param_dict").set_body_typed([](const String& s) {
   return ::tvm::runtime::LoadParams(s);
 });
+TVM_REGISTER_GLOBAL("tvm.relay._save_param_dict_aligned")
+    .set_body_typed([](const Map<String, NDArray>& params) {
+      std::string s = ::tvm::runtime::SaveParamsAligned(params);
+      // copy return array so it is owned by the ret value
+      TVMRetValue rv;
+      rv = TVMByteArray{s.data(), s.size()};
+      return rv;
+    });
 
 }  // namespace relay
 }  // namespace tvm
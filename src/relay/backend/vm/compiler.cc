@@ -26,6 +26,8 @@
 
 #include <tvm/driver/driver_api.h>
 #include <tvm/ir/error.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/device_copy.h>
 #include <tvm/relay/attrs/memory.h>
@@ -36,12 +38,15 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/vm/vm.h>
 #include <tvm/te/operation.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/stmt.h>
 
 #include <iostream>
 #include <map>
 #include <memory>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "../../../target/source/codegen_source_base.h"
@@ -247,6 +252,223 @@ int GetFallbackDevice() {
   return fallback_dev->value;
 }
 
+/*!
+ * \brief A closed-form description of a shape function: output element i is
+ *  `coeff[i] * input[src_input[i]][src_elem[i]] + bias[i]`, or the plain
+ *  constant `bias[i]` when `src_input[i]` is -1.
+ */
+struct ShapeFuncAffinePattern {
+  std::vector<int64_t> src_input;
+  std::vector<int64_t> src_elem;
+  std::vector<int64_t> coeff;
+  std::vector<int64_t> bias;
+};
+
+/*!
+ * \brief Try to reduce a lowered shape function to affine expressions over
+ *  the input shape elements.
+ *
+ *  Most shape functions compute nothing more than `(batch, constant)` or
+ *  `batch * constant`; recognizing them at compile time lets the VM fill in
+ *  the output shape tensor inline (Opcode::AffineShape) instead of paying a
+ *  packed-func call per inference. The matcher walks the flattened TIR body
+ *  and only succeeds when it is a sequence of stores of affine expressions
+ *  at constant indices covering every output element; anything else (max,
+ *  select, data-dependent loops, scratch buffers, ...) keeps the
+ *  InvokePacked path.
+ */
+class AffineShapeFuncMatcher {
+ public:
+  AffineShapeFuncMatcher(const tir::PrimFunc& func, size_t num_inputs) : func_(func) {
+    if (func->params.size() != num_inputs + 1) return;
+    for (size_t i = 0; i < func->params.size(); ++i) {
+      auto it = func->buffer_map.find(func->params[i]);
+      if (it == func->buffer_map.end()) return;
+      tir::Buffer buffer = (*it).second;
+      if (i < num_inputs) {
+        input_index_[buffer->data.get()] = static_cast<int64_t>(i);
+        input_dtype_[buffer->data.get()] = buffer->dtype;
+      } else {
+        // The single output is a 1-D int64 shape tensor of static length.
+        if (buffer->dtype != DataType::Int(64)) return;
+        if (buffer->shape.size() != 1) return;
+        const auto* len = buffer->shape[0].as<IntImmNode>();
+        if (len == nullptr) return;
+        out_var_ = buffer->data.get();
+        ndim_ = len->value;
+      }
+    }
+    valid_ = true;
+  }
+
+  bool Match(ShapeFuncAffinePattern* pattern) {
+    if (!valid_ || ndim_ < 0) return false;
+    pattern->src_input.assign(ndim_, -1);
+    pattern->src_elem.assign(ndim_, 0);
+    pattern->coeff.assign(ndim_, 0);
+    pattern->bias.assign(ndim_, 0);
+    defined_.assign(ndim_, false);
+    if (!VisitStmt(func_->body, pattern)) return false;
+    for (bool defined : defined_) {
+      if (!defined) return false;
+    }
+    return true;
+  }
+
+ private:
+  // An affine value over at most one input element; atom_input is -1 for
+  // constants, in which case the value is just `bias`.
+  struct AffineValue {
+    int64_t atom_input{-1};
+    int64_t atom_elem{0};
+    int64_t coeff{0};
+    int64_t bias{0};
+    bool IsConst() const { return atom_input < 0; }
+  };
+
+  bool VisitStmt(const tir::Stmt& stmt, ShapeFuncAffinePattern* pattern) {
+    if (const auto* op = stmt.as<tir::AttrStmtNode>()) {
+      return VisitStmt(op->body, pattern);
+    } else if (const auto* op = stmt.as<tir::SeqStmtNode>()) {
+      for (const tir::Stmt& s : op->seq) {
+        if (!VisitStmt(s, pattern)) return false;
+      }
+      return true;
+    } else if (const auto* op = stmt.as<tir::LetStmtNode>()) {
+      AffineValue value;
+      if (!VisitExpr(op->value, &value)) return false;
+      bindings_[op->var.get()] = value;
+      bool ok = VisitStmt(op->body, pattern);
+      bindings_.erase(op->var.get());
+      return ok;
+    } else if (const auto* op = stmt.as<tir::ForNode>()) {
+      const auto* min = op->min.as<IntImmNode>();
+      const auto* extent = op->extent.as<IntImmNode>();
+      // Shape tensors are tiny; unroll the loop symbolically.
+      if (min == nullptr || extent == nullptr || extent->value > kMaxUnroll) return false;
+      for (int64_t i = 0; i < extent->value; ++i) {
+        AffineValue iter;
+        iter.bias = min->value + i;
+        bindings_[op->loop_var.get()] = iter;
+        if (!VisitStmt(op->body, pattern)) {
+          bindings_.erase(op->loop_var.get());
+          return false;
+        }
+      }
+      bindings_.erase(op->loop_var.get());
+      return true;
+    } else if (const auto* op = stmt.as<tir::StoreNode>()) {
+      if (op->buffer_var.get() != out_var_) return false;
+      AffineValue index;
+      AffineValue predicate;
+      AffineValue value;
+      if (!VisitExpr(op->index, &index) || !index.IsConst()) return false;
+      if (!VisitExpr(op->predicate, &predicate) || !predicate.IsConst() || predicate.bias != 1) {
+        return false;
+      }
+      if (!VisitExpr(op->value, &value)) return false;
+      if (index.bias < 0 || index.bias >= ndim_) return false;
+      pattern->src_input[index.bias] = value.atom_input;
+      pattern->src_elem[index.bias] = value.atom_elem;
+      pattern->coeff[index.bias] = value.coeff;
+      pattern->bias[index.bias] = value.bias;
+      defined_[index.bias] = true;
+      return true;
+    }
+    return false;
+  }
+
+  bool VisitExpr(const PrimExpr& expr, AffineValue* out) {
+    if (const auto* op = expr.as<IntImmNode>()) {
+      out->bias = op->value;
+      return true;
+    } else if (const auto* op = expr.as<tir::CastNode>()) {
+      // Shape arithmetic stays integral; a cast between int types is exact.
+      if (!op->dtype.is_int() || !op->value.dtype().is_int()) return false;
+      return VisitExpr(op->value, out);
+    } else if (const auto* op = expr.as<tir::VarNode>()) {
+      auto it = bindings_.find(op);
+      if (it == bindings_.end()) return false;
+      *out = it->second;
+      return true;
+    } else if (const auto* op = expr.as<tir::LoadNode>()) {
+      auto it = input_index_.find(op->buffer_var.get());
+      if (it == input_index_.end()) return false;
+      // Only int64 inputs can be read back as shape elements at runtime.
+      if (input_dtype_[op->buffer_var.get()] != DataType::Int(64)) return false;
+      AffineValue index;
+      AffineValue predicate;
+      if (!VisitExpr(op->index, &index) || !index.IsConst()) return false;
+      if (!VisitExpr(op->predicate, &predicate) || !predicate.IsConst() || predicate.bias != 1) {
+        return false;
+      }
+      out->atom_input = it->second;
+      out->atom_elem = index.bias;
+      out->coeff = 1;
+      out->bias = 0;
+      return true;
+    } else if (const auto* op = expr.as<tir::AddNode>()) {
+      AffineValue a;
+      AffineValue b;
+      if (!VisitExpr(op->a, &a) || !VisitExpr(op->b, &b)) return false;
+      return Combine(a, b, /*b_scale=*/1, out);
+    } else if (const auto* op = expr.as<tir::SubNode>()) {
+      AffineValue a;
+      AffineValue b;
+      if (!VisitExpr(op->a, &a) || !VisitExpr(op->b, &b)) return false;
+      return Combine(a, b, /*b_scale=*/-1, out);
+    } else if (const auto* op = expr.as<tir::MulNode>()) {
+      AffineValue a;
+      AffineValue b;
+      if (!VisitExpr(op->a, &a) || !VisitExpr(op->b, &b)) return false;
+      if (b.IsConst()) {
+        std::swap(a, b);
+      }
+      if (!a.IsConst()) return false;
+      out->atom_input = b.atom_input;
+      out->atom_elem = b.atom_elem;
+      out->coeff = a.bias * b.coeff;
+      out->bias = a.bias * b.bias;
+      Normalize(out);
+      return true;
+    }
+    return false;
+  }
+
+  // Compute a + b_scale * b; fails when the result would mix two atoms.
+  bool Combine(const AffineValue& a, const AffineValue& b, int64_t b_scale, AffineValue* out) {
+    if (!a.IsConst() && !b.IsConst() &&
+        (a.atom_input != b.atom_input || a.atom_elem != b.atom_elem)) {
+      return false;
+    }
+    const AffineValue& atom = a.IsConst() ? b : a;
+    out->atom_input = atom.atom_input;
+    out->atom_elem = atom.atom_elem;
+    out->coeff = a.coeff + b_scale * b.coeff;
+    out->bias = a.bias + b_scale * b.bias;
+    Normalize(out);
+    return true;
+  }
+
+  static void Normalize(AffineValue* value) {
+    if (value->coeff == 0) {
+      value->atom_input = -1;
+      value->atom_elem = 0;
+    }
+  }
+
+  static constexpr int64_t kMaxUnroll = 32;
+
+  tir::PrimFunc func_;
+  std::unordered_map<const tir::VarNode*, int64_t> input_index_;
+  std::unordered_map<const tir::VarNode*, DataType> input_dtype_;
+  std::unordered_map<const tir::VarNode*, AffineValue> bindings_;
+  const tir::VarNode* out_var_{nullptr};
+  int64_t ndim_{-1};
+  bool valid_{false};
+  std::vector<bool> defined_;
+};
+
 class VMFunctionCompiler : ExprFunctor<void(const Expr& expr)> {
  public:
   VMFunctionCompiler(VMCompilerContext* context, TargetsMap targets, Target target_host,
@@ -334,6 +556,7 @@ class VMFunctionCompiler : ExprFunctor<void(const Expr& expr)> {
         last_register_ = instr.dst;
         break;
       case Opcode::InvokePacked:
+      case Opcode::AffineShape:
       case Opcode::If:
       case Opcode::Ret:
       case Opcode::Goto:
@@ -346,15 +569,33 @@ class VMFunctionCompiler : ExprFunctor<void(const Expr& expr)> {
   void VisitExpr_(const ConstantNode* const_node) {
     // Check the shape is valid
     NDArray data = const_node->data;
-    size_t konst_idx = context_->constants.size();
+    auto con = GetRef<Constant>(const_node);
+    Index device_type;
     if (expr_device_map_.empty()) {
-      context_->const_device_type.push_back(targets_.begin()->first);
+      device_type = targets_.begin()->first;
     } else {
-      auto con = GetRef<Constant>(const_node);
       ICHECK_GT(expr_device_map_.count(con), 0U);
-      context_->const_device_type.push_back(expr_device_map_[con].device_type);
+      device_type = expr_device_map_[con].device_type;
     }
+    // Tied weights and repeated blocks leave structurally identical
+    // constants in several functions; pool them so the executable stores
+    // and loads each unique tensor once. The structural hash of a constant
+    // covers its tensor contents.
+    size_t hash = StructuralHash::Cached(con);
+    auto range = context_->const_pool_map.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      size_t idx = it->second;
+      if (context_->const_device_type[idx] == device_type &&
+          StructuralEqual()(context_->constant_exprs[idx], con)) {
+        Emit(Instruction::LoadConst(idx, NewRegister()));
+        return;
+      }
+    }
+    size_t konst_idx = context_->constants.size();
+    context_->const_device_type.push_back(device_type);
     context_->constants.push_back(const_node->data);
+    context_->constant_exprs.push_back(con);
+    context_->const_pool_map.emplace(hash, konst_idx);
     Emit(Instruction::LoadConst(konst_idx, NewRegister()));
   }
 
@@ -464,17 +705,9 @@ class VMFunctionCompiler : ExprFunctor<void(const Expr& expr)> {
     // Lower shape function
     CCacheKey key(func, target_host_);
     auto cfunc = engine_->LowerShapeFunc(key);
-    int op_index = -1;
     // pick the only function inside the context
     ICHECK_EQ(cfunc->funcs->functions.size(), 1);
     auto pfunc = Downcast<tir::PrimFunc>((*cfunc->funcs->functions.begin()).second);
-    if (context_->seen_funcs.count(pfunc) == 0) {
-      op_index = context_->cached_funcs.size();
-      context_->cached_funcs.push_back(cfunc);
-      context_->seen_funcs[pfunc] = op_index;
-    } else {
-      op_index = context_->seen_funcs[pfunc];
-    }
 
     // Prepare input and output registers
     std::vector<Index> argument_registers;
@@ -490,6 +723,30 @@ class VMFunctionCompiler : ExprFunctor<void(const Expr& expr)> {
       argument_registers.push_back(reg->second);
     }
 
+    // When the lowered function reduces to affine expressions over the input
+    // shape elements, evaluate it inline in the VM instead of emitting a
+    // packed-func call.
+    if (outputs.size() == 1) {
+      ShapeFuncAffinePattern pattern;
+      if (AffineShapeFuncMatcher(pfunc, inputs.size()).Match(&pattern)) {
+        std::vector<RegName> input_registers(argument_registers.begin(),
+                                             argument_registers.end() - 1);
+        Emit(Instruction::AffineShape(pattern.src_input.size(), input_registers, pattern.src_input,
+                                      pattern.src_elem, pattern.coeff, pattern.bias,
+                                      argument_registers.back()));
+        return;
+      }
+    }
+
+    int op_index = -1;
+    if (context_->seen_funcs.count(pfunc) == 0) {
+      op_index = context_->cached_funcs.size();
+      context_->cached_funcs.push_back(cfunc);
+      context_->seen_funcs[pfunc] = op_index;
+    } else {
+      op_index = context_->seen_funcs[pfunc];
+    }
+
     Emit(Instruction::InvokePacked(op_index, argument_registers.size(), outputs.size(),
                                    argument_registers));
   }
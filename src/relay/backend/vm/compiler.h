@@ -79,6 +79,11 @@ struct VMCompilerContext {
   std::vector<NDArray> constants;
   // Device type for constants
   std::vector<Index> const_device_type;
+  // The constant expr behind each pool entry, for dedup equality checks
+  std::vector<Constant> constant_exprs;
+  // Constant pool indices keyed by the constant's structural hash; shared
+  // across functions so tied weights get one pool entry module-wide
+  std::unordered_multimap<size_t, size_t> const_pool_map;
   // List of cached functions
   std::vector<CachedFunc> cached_funcs;
   // The functions that have been lowered.
@@ -146,6 +146,22 @@ Expr PostOrderRewrite(const Expr& expr, ExprRewriter* rewriter) {
   return PostOrderRewriter(rewriter).VisitExpr(expr);
 }
 
+namespace {
+/*!
+ * \brief Apply fmutate to every element of arr.
+ *
+ *  Copies lazily: when no element changes, the original array is returned
+ *  untouched and nothing is allocated, so the unchanged-subtree checks in
+ *  the visitors below reduce a no-op pass to pointer comparisons.
+ */
+template <typename T, typename F>
+Array<T> MutateArray(const Array<T>& arr, F fmutate) {
+  Array<T> result = arr;
+  result.MutateByApply(fmutate);
+  return result;
+}
+}  // namespace
+
 Expr ExprMutator::VisitExpr(const Expr& expr) {
   auto it = this->memo_.find(expr);
   if (it != this->memo_.end()) {
@@ -175,15 +191,10 @@ Expr ExprMutator::VisitExpr_(const GlobalVarNode* op) { return GetRef<Expr>(op);
 Expr ExprMutator::VisitExpr_(const OpNode* op) { return GetRef<Expr>(op); }
 
 Expr ExprMutator::VisitExpr_(const TupleNode* op) {
-  tvm::Array<Expr> fields;
-  bool all_fields_unchanged = true;
-  for (auto field : op->fields) {
-    auto new_field = this->Mutate(field);
-    fields.push_back(new_field);
-    all_fields_unchanged &= new_field.same_as(field);
-  }
+  tvm::Array<Expr> fields =
+      MutateArray(op->fields, [this](const Expr& field) { return this->Mutate(field); });
 
-  if (all_fields_unchanged) {
+  if (fields.same_as(op->fields)) {
     return GetRef<Expr>(op);
   } else {
     return Tuple(fields, op->span);
@@ -191,28 +202,19 @@ Expr ExprMutator::VisitExpr_(const TupleNode* op) {
 }
 
 Expr ExprMutator::VisitExpr_(const FunctionNode* op) {
-  tvm::Array<TypeVar> ty_params;
-  bool all_ty_params_unchanged = true;
+  tvm::Array<TypeVar> ty_params = MutateArray(
+      op->type_params, [this](const TypeVar& ty_param) {
+        return Downcast<TypeVar>(this->VisitType(ty_param));
+      });
 
-  for (auto ty_param : op->type_params) {
-    TypeVar new_ty_param = Downcast<TypeVar>(VisitType(ty_param));
-    ty_params.push_back(new_ty_param);
-    all_ty_params_unchanged &= new_ty_param.same_as(ty_param);
-  }
-
-  tvm::Array<Var> params;
-  bool all_params_unchanged = true;
-  for (auto param : op->params) {
-    Var new_param = Downcast<Var>(this->Mutate(param));
-    params.push_back(new_param);
-    all_params_unchanged &= param.same_as(new_param);
-  }
+  tvm::Array<Var> params = MutateArray(
+      op->params, [this](const Var& param) { return Downcast<Var>(this->Mutate(param)); });
 
   auto ret_type = this->VisitType(op->ret_type);
   auto body = this->Mutate(op->body);
 
-  if (all_ty_params_unchanged && all_params_unchanged && ret_type.same_as(op->ret_type) &&
-      body.same_as(op->body)) {
+  if (ty_params.same_as(op->type_params) && params.same_as(op->params) &&
+      ret_type.same_as(op->ret_type) && body.same_as(op->body)) {
     return GetRef<Expr>(op);
   } else {
     return Function(params, body, ret_type, ty_params, op->attrs, op->span);
@@ -221,23 +223,15 @@ Expr ExprMutator::VisitExpr_(const FunctionNode* op) {
 
 Expr ExprMutator::VisitExpr_(const CallNode* call_node) {
   auto new_op = this->Mutate(call_node->op);
-  bool unchanged = call_node->op.same_as(new_op);
 
-  tvm::Array<Type> ty_args;
-  for (auto ty_arg : call_node->type_args) {
-    auto new_ty_arg = this->VisitType(ty_arg);
-    ty_args.push_back(new_ty_arg);
-    unchanged &= new_ty_arg.same_as(ty_arg);
-  }
+  tvm::Array<Type> ty_args = MutateArray(
+      call_node->type_args, [this](const Type& ty_arg) { return this->VisitType(ty_arg); });
 
-  tvm::Array<Expr> call_args;
-  for (auto arg : call_node->args) {
-    auto new_arg = this->Mutate(arg);
-    call_args.push_back(new_arg);
-    unchanged &= new_arg.same_as(arg);
-  }
+  tvm::Array<Expr> call_args =
+      MutateArray(call_node->args, [this](const Expr& arg) { return this->Mutate(arg); });
 
-  if (unchanged) {
+  if (new_op.same_as(call_node->op) && ty_args.same_as(call_node->type_args) &&
+      call_args.same_as(call_node->args)) {
     return GetRef<Expr>(call_node);
   } else {
     return Call(new_op, call_args, call_node->attrs, ty_args, call_node->span);
@@ -308,17 +302,11 @@ Expr ExprMutator::VisitExpr_(const RefWriteNode* op) {
 Expr ExprMutator::VisitExpr_(const ConstructorNode* c) { return GetRef<Expr>(c); }
 
 Expr ExprMutator::VisitExpr_(const MatchNode* m) {
-  bool unchanged = true;
-  std::vector<Clause> clauses;
-  for (const Clause& p : m->clauses) {
-    Clause c = VisitClause(p);
-    clauses.push_back(c);
-    unchanged &= c.same_as(p);
-  }
+  Array<Clause> clauses =
+      MutateArray(m->clauses, [this](const Clause& c) { return this->VisitClause(c); });
   Expr data = Mutate(m->data);
-  unchanged &= data.same_as(m->data);
 
-  if (unchanged) {
+  if (clauses.same_as(m->clauses) && data.same_as(m->data)) {
     return GetRef<Expr>(m);
   }
   return Match(data, clauses, m->complete, m->span);
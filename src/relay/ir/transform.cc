@@ -23,9 +23,14 @@
  */
 #include <dmlc/thread_local.h>
 #include <tvm/node/repr_printer.h>
+#include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/registry.h>
 
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace relay {
 namespace transform {
@@ -55,6 +60,11 @@ class FunctionPassNode : public PassNode {
    */
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func;
 
+  /*! \brief Names of the only operators the pass can rewrite. When non-empty,
+   * functions calling none of these operators skip pass_func entirely.
+   */
+  tvm::Array<String> interested_ops;
+
   FunctionPassNode() = default;
 
   void VisitAttrs(tvm::AttrVisitor* v) { v->Visit("pass_info", &pass_info); }
@@ -97,20 +107,95 @@ class FunctionPass : public Pass {
    */
   TVM_DLL FunctionPass(
       runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func,
-      PassInfo pass_info);
+      PassInfo pass_info, tvm::Array<String> interested_ops = {});
 
   TVM_DEFINE_OBJECT_REF_METHODS(FunctionPass, Pass, FunctionPassNode);
 };
 
 FunctionPass::FunctionPass(
     runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func,
-    PassInfo pass_info) {
+    PassInfo pass_info, tvm::Array<String> interested_ops) {
   auto n = make_object<FunctionPassNode>();
   n->pass_func = std::move(pass_func);
   n->pass_info = std::move(pass_info);
+  n->interested_ops = std::move(interested_ops);
   data_ = std::move(n);
 }
 
+namespace {
+// Whether the function calls at least one of the given operators.
+bool CallsAnyOp(const Function& func, const std::unordered_set<const Object*>& ops) {
+  bool found = false;
+  PostOrderVisit(func, [&](const Expr& e) {
+    if (found) return;
+    if (const auto* call = e.as<CallNode>()) {
+      if (ops.count(call->op.get())) {
+        found = true;
+      }
+    }
+  });
+  return found;
+}
+
+// Order the module's functions callees-first over the call graph, so
+// whatever a pass computes for a callee (e.g. its rewritten signature) is
+// already in place when its callers are visited. Roots are taken in
+// stable id order, which keeps the result deterministic; cycles between
+// mutually recursive functions are broken at the back edge. Functions
+// that are not relay::Function contribute no edges.
+Array<GlobalVar> BottomUpFunctionOrder(const IRModule& mod) {
+  Array<GlobalVar> roots = mod->GetFunctionOrder();
+  // single-function modules (the common case) need no ordering work
+  if (roots.size() <= 1) {
+    return roots;
+  }
+  std::vector<GlobalVar> order;
+  std::unordered_set<const GlobalVarNode*> emitted;
+  std::unordered_set<const GlobalVarNode*> on_stack;
+  // iterative DFS; the flag marks whether the callees were expanded
+  std::vector<std::pair<GlobalVar, bool> > stack;
+  for (const auto& root : roots) {
+    stack.push_back({root, false});
+    while (!stack.empty()) {
+      std::pair<GlobalVar, bool>& top = stack.back();
+      const GlobalVarNode* var = top.first.get();
+      if (top.second) {
+        // all callees are emitted; emit the function itself
+        on_stack.erase(var);
+        emitted.insert(var);
+        order.push_back(top.first);
+        stack.pop_back();
+        continue;
+      }
+      if (emitted.count(var) || on_stack.count(var)) {
+        // duplicate entry or a back edge of a recursive cycle
+        stack.pop_back();
+        continue;
+      }
+      top.second = true;
+      on_stack.insert(var);
+      BaseFunc base_func = mod->Lookup(top.first);
+      if (const auto* fn = base_func.as<FunctionNode>()) {
+        std::vector<GlobalVar> callees;
+        PostOrderVisit(GetRef<Function>(fn), [&](const Expr& e) {
+          if (const auto* gvn = e.as<GlobalVarNode>()) {
+            callees.push_back(GetRef<GlobalVar>(gvn));
+          }
+        });
+        // `top` may dangle once the stack grows; do not touch it below
+        for (auto it = callees.rbegin(); it != callees.rend(); ++it) {
+          if (!emitted.count(it->get()) && !on_stack.count(it->get()) &&
+              mod->ContainGlobalVar((*it)->name_hint)) {
+            stack.push_back({*it, false});
+          }
+        }
+      }
+    }
+  }
+  return Array<GlobalVar>(order);
+}
+}  // namespace
+
 // Perform Module -> Module optimizations at the Function level.
 IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx) const {
   DiagnosticContext previous = DiagnosticContext::Default(mod);
@@ -139,13 +224,28 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   IRModule updated_mod =
       IRModule(mod->functions, mod->type_definitions, mod->Imports(), mod->source_map);
 
+  // Resolve the declared op-interest set once per invocation; functions that
+  // call none of these operators are passed through untouched.
+  std::unordered_set<const Object*> interested;
+  for (const auto& op_name : interested_ops) {
+    interested.insert(Op::Get(op_name).get());
+  }
+
+  // Iterate the functions callees-first so the pass sees a callee's result
+  // before visiting its callers; the order is still deterministic as it is
+  // derived from the stable id order.
   std::vector<std::pair<GlobalVar, Function> > updates;
-  for (const auto& it : updated_mod->functions) {
+  for (const auto& var : BottomUpFunctionOrder(updated_mod)) {
+    BaseFunc base_func = updated_mod->Lookup(var);
     // only picks up relay::Function
-    if (auto* n = it.second.as<FunctionNode>()) {
+    if (auto* n = base_func.as<FunctionNode>()) {
       Function func = GetRef<Function>(n);
-      auto updated_func = SkipFunction(func) ? func : pass_func(func, updated_mod, pass_ctx);
-      updates.push_back({it.first, updated_func});
+      bool skip = SkipFunction(func) || (!interested.empty() && !CallsAnyOp(func, interested));
+      auto updated_func = skip ? func : pass_func(func, updated_mod, pass_ctx);
+      // re-adding an unchanged function would only repeat its sanity checks
+      if (!updated_func.same_as(func)) {
+        updates.push_back({var, updated_func});
+      }
     }
   }
 
@@ -161,6 +261,12 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
   pass_ctx.Trace(updated_mod, pass_info, false);
 
+  // A pass that touched nothing left the module's typing state intact, so
+  // the eager re-inference below would only reproduce it.
+  if (updates.empty()) {
+    return mod;
+  }
+
   // TODO(@jroesch): move away from eager type checking for performance reasons
   // make issue.
   return transform::InferType()(updated_mod);
@@ -173,9 +279,10 @@ bool FunctionPassNode::SkipFunction(const Function& func) const {
 
 Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
+    int opt_level, String name, tvm::Array<String> required,
+    tvm::Array<String> interested_ops) {
   PassInfo pass_info = PassInfo(opt_level, name, required);
-  return FunctionPass(pass_func, pass_info);
+  return FunctionPass(pass_func, pass_info, std::move(interested_ops));
 }
 
 TVM_REGISTER_NODE_TYPE(FunctionPassNode);
@@ -981,6 +981,71 @@ are data in batch.
     .set_support_level(10)
     .add_type_rel("BatchMatmul", BatchMatmulRel);
 
+// relay.nn.fused_attention
+TVM_REGISTER_NODE_TYPE(AttentionAttrs);
+
+bool FusedAttentionRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                       const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 4);
+  const auto* query = types[0].as<TensorTypeNode>();
+  const auto* key = types[1].as<TensorTypeNode>();
+  const auto* value = types[2].as<TensorTypeNode>();
+  if (query == nullptr || key == nullptr || value == nullptr) return false;
+
+  ICHECK(query->shape.size() == 3 && key->shape.size() == 3 && value->shape.size() == 3)
+      << "FusedAttention: query, key and value must be 3D (batch, seq, feature)";
+  ICHECK(reporter->AssertEQ(query->shape[0], key->shape[0]) &&
+         reporter->AssertEQ(query->shape[0], value->shape[0]))
+      << "FusedAttention: batch dimensions don't match, "
+      << " query shape=" << query->shape << ", key shape=" << key->shape
+      << ", value shape=" << value->shape;
+  ICHECK(reporter->AssertEQ(query->shape[2], key->shape[2]))
+      << "FusedAttention: feature dimensions of query and key don't match, "
+      << " query shape=" << query->shape << ", key shape=" << key->shape;
+  ICHECK(reporter->AssertEQ(key->shape[1], value->shape[1]))
+      << "FusedAttention: sequence dimensions of key and value don't match, "
+      << " key shape=" << key->shape << ", value shape=" << value->shape;
+
+  reporter->Assign(types[3],
+                   TensorType({query->shape[0], query->shape[1], value->shape[2]}, query->dtype));
+  return true;
+}
+
+// Positional relay function to create fused_attention operator used by frontend FFI.
+Expr MakeFusedAttention(Expr query, Expr key, Expr value, double scale) {
+  auto attrs = make_object<AttentionAttrs>();
+  attrs->scale = scale;
+  static const Op& op = Op::Get("nn.fused_attention");
+  return Call(op, {query, key, value}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.fused_attention").set_body_typed(MakeFusedAttention);
+
+RELAY_REGISTER_OP("nn.fused_attention")
+    .describe(R"code(Scaled dot-product attention computed as one fused kernel.
+
+.. math::
+
+  fused\_attention(Q, K, V) = softmax(scale \cdot Q K^T) V
+
+- **query**: `(b, m, d)`
+- **key**: `(b, n, d)`
+- **value**: `(b, n, d_v)`
+- **out**: `(b, m, d_v)`
+
+Keeping the softmax between the two matrix products inside one kernel avoids the
+global memory round trip of the unfused form, which FuseOps cannot merge across
+the softmax reductions.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<AttentionAttrs>()
+    .set_num_inputs(3)
+    .add_argument("query", "3D Tensor", "Query matrix.")
+    .add_argument("key", "3D Tensor", "Key matrix.")
+    .add_argument("value", "3D Tensor", "Value matrix.")
+    .set_support_level(10)
+    .add_type_rel("FusedAttention", FusedAttentionRel);
+
 // relay.nn.cross_entropy
 bool CrossEntropyRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
                      const TypeReporter& reporter) {
@@ -258,6 +258,16 @@ RELAY_REGISTER_UNARY_OP("sigmoid")
     .set_support_level(1)
     .set_attr<FTVMCompute>("FTVMCompute", RELAY_UNARY_COMPUTE(topi::sigmoid));
 
+RELAY_REGISTER_UNARY_OP("fast_sigmoid")
+    .describe(R"code(Returns the fast_sigmoid of input array, computed element-wise.
+
+.. math::
+   \fast_sigmoid(x)
+
+)code" TVM_ADD_FILELINE)
+    .set_support_level(1)
+    .set_attr<FTVMCompute>("FTVMCompute", RELAY_UNARY_COMPUTE(topi::fast_sigmoid));
+
 RELAY_REGISTER_UNARY_OP("copy")
     .describe(R"code(Copy a tensor.
 )code" TVM_ADD_FILELINE)
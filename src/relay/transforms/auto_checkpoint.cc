@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file auto_checkpoint.cc
+ * \brief Insert gradient checkpoint annotations by a memory heuristic.
+ *
+ * The higher-order gradient pass honors annotation.checkpoint: instead of
+ * every forward intermediate being captured by the backward closures, only a
+ * checkpoint's output is retained and the segment behind it is re-executed
+ * when its gradient is needed. Placing those annotations has been a manual
+ * job so far. This pass automates it: walking the dataflow in post-order, it
+ * accumulates the activation bytes produced since the last boundary and cuts
+ * a new checkpoint once the running total exceeds a budget, preferring to cut
+ * at reduction or fusion-root ops (conv/dense/reduce) so the retained values
+ * are the expensive ones and the re-executed interior is the cheap elemwise
+ * tail. The budget trades recompute FLOPs against live memory: a smaller
+ * budget checkpoints more often, retaining less and recomputing more.
+ */
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+
+namespace tvm {
+namespace relay {
+
+class CheckpointAnnotator : public ExprRewriter {
+ public:
+  explicit CheckpointAnnotator(int64_t max_segment_bytes)
+      : max_segment_bytes_(max_segment_bytes),
+        checkpoint_op_(Op::Get("annotation.checkpoint")),
+        fpattern_(Op::GetAttrMap<TOpPattern>("TOpPattern")) {}
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    const auto* op_node = pre->op.as<OpNode>();
+    if (op_node == nullptr) {
+      return post;
+    }
+    Op op = GetRef<Op>(op_node);
+    if (op == checkpoint_op_) {
+      // A user-placed boundary already splits the segment here.
+      bytes_since_boundary_ = 0;
+      return post;
+    }
+    const auto* ttype =
+        pre->checked_type_.defined() ? pre->checked_type().as<TensorTypeNode>() : nullptr;
+    if (ttype == nullptr) {
+      return post;
+    }
+    bytes_since_boundary_ += TensorBytes(ttype);
+    if (bytes_since_boundary_ < max_segment_bytes_) {
+      return post;
+    }
+    // Cut only after ops that are expensive to recompute, so the retained
+    // value is the costly one and the recomputed interior is cheap.
+    OpPatternKind pattern =
+        fpattern_.count(op) ? static_cast<OpPatternKind>(fpattern_[op]) : kOpaque;
+    if (pattern != kCommReduce && pattern != kOutEWiseFusable) {
+      return post;
+    }
+    bytes_since_boundary_ = 0;
+    return Call(checkpoint_op_, {post});
+  }
+
+ private:
+  /*! \brief Static size of a tensor in bytes, or 0 when a dim is dynamic. */
+  static int64_t TensorBytes(const TensorTypeNode* ttype) {
+    int64_t size = (ttype->dtype.bits() * ttype->dtype.lanes() + 7) / 8;
+    for (const PrimExpr& dim : ttype->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      if (imm == nullptr) {
+        return 0;
+      }
+      size *= imm->value;
+    }
+    return size;
+  }
+
+  int64_t max_segment_bytes_;
+  int64_t bytes_since_boundary_{0};
+  const Op& checkpoint_op_;
+  OpAttrMap<TOpPattern> fpattern_;
+};
+
+Expr AutoCheckpoint(const Expr& e, int64_t max_segment_bytes) {
+  auto rewriter = CheckpointAnnotator(max_segment_bytes);
+  return PostOrderRewrite(e, &rewriter);
+}
+
+namespace transform {
+
+Pass AutoCheckpoint(int64_t max_segment_bytes) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(AutoCheckpoint(f, max_segment_bytes));
+      };
+  return CreateFunctionPass(pass_func, 1, "AutoCheckpoint", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.AutoCheckpoint").set_body_typed(AutoCheckpoint);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,289 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/batch_small_ops.cc
+ * \brief Group independent small fused kernels into one batched dispatch.
+ *
+ * FuseOps merges along dataflow edges, so a graph can be left with many
+ * independent sub-microsecond kernels whose launch overhead dominates their
+ * compute. This pass runs after fusion and collects mutually independent
+ * calls to primitive functions with small, statically known outputs into a
+ * single primitive function that returns a tuple, turning the whole group
+ * into one kernel launch. Members are restricted to injective bodies so the
+ * combined function still lowers through the injective schedule.
+ *
+ * The pass is a no-op unless relay.BatchSmallOps.max_output_size is set to a
+ * positive number of elements; relay.BatchSmallOps.max_batch_size bounds the
+ * group size.
+ */
+
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relay {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.BatchSmallOps.max_output_size", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.BatchSmallOps.max_batch_size", Integer);
+
+namespace {
+
+/*! \brief Membership of a call in a batched group. */
+struct BatchMember {
+  /*! \brief Index of the group the call belongs to. */
+  size_t group_index;
+  /*! \brief Index of the call's output in the group's tuple. */
+  size_t output_index;
+};
+
+/*!
+ * \brief Assigns eligible primitive calls to batches.
+ *
+ * Nodes are processed in post-dfs order while tracking, per node, the newest
+ * batch the node transitively depends on. A call may join the open batch only
+ * when it does not depend on any of the batch's members, which keeps every
+ * group free of internal dataflow.
+ */
+class BatchPlanner {
+ public:
+  BatchPlanner(int64_t max_output_size, int64_t max_batch_size)
+      : max_output_size_(max_output_size), max_batch_size_(max_batch_size) {}
+
+  /*!
+   * \brief Plan batches over the given dataflow body.
+   * \param body The function body to scan.
+   * \return Whether planning succeeded; false when the body contains node
+   *         kinds the planner does not track dependencies through.
+   */
+  bool Plan(const Expr& body) {
+    bool supported = true;
+    PostOrderVisit(body, [&, this](const Expr& e) {
+      if (!supported) return;
+      if (e.as<VarNode>() || e.as<GlobalVarNode>() || e.as<ConstantNode>() || e.as<OpNode>() ||
+          e.as<FunctionNode>()) {
+        return;
+      }
+      int reach = -1;
+      if (const auto* call = e.as<CallNode>()) {
+        for (const Expr& arg : call->args) {
+          reach = std::max(reach, GetReach(arg));
+        }
+        if (IsCandidate(call)) {
+          if (reach >= current_batch_ ||
+              current_members_.size() >= static_cast<size_t>(max_batch_size_)) {
+            CloseBatch();
+          }
+          current_members_.push_back(call);
+          reach = current_batch_;
+        }
+      } else if (const auto* tuple = e.as<TupleNode>()) {
+        for (const Expr& field : tuple->fields) {
+          reach = std::max(reach, GetReach(field));
+        }
+      } else if (const auto* get_item = e.as<TupleGetItemNode>()) {
+        reach = GetReach(get_item->tuple);
+      } else {
+        // Control flow or binding constructs: the dependence tracking above
+        // does not see through them, so batching is skipped entirely.
+        supported = false;
+        return;
+      }
+      reach_[e.get()] = reach;
+    });
+    CloseBatch();
+    return supported;
+  }
+
+  /*! \brief The planned groups, each with at least two members. */
+  const std::vector<std::vector<const CallNode*>>& groups() const { return groups_; }
+  /*! \brief Membership info keyed by member call. */
+  const std::unordered_map<const CallNode*, BatchMember>& members() const { return members_; }
+
+ private:
+  int GetReach(const Expr& e) const {
+    auto it = reach_.find(e.get());
+    return it == reach_.end() ? -1 : it->second;
+  }
+
+  void CloseBatch() {
+    if (current_members_.size() >= 2) {
+      for (size_t i = 0; i < current_members_.size(); ++i) {
+        members_[current_members_[i]] = BatchMember{groups_.size(), i};
+      }
+      groups_.push_back(std::move(current_members_));
+    }
+    current_members_.clear();
+    ++current_batch_;
+  }
+
+  bool IsCandidate(const CallNode* call) {
+    const auto* fn = call->op.as<FunctionNode>();
+    if (fn == nullptr) return false;
+    // Only tensor results can become tuple fields with a stable index.
+    const auto* ttype = call->checked_type().as<TensorTypeNode>();
+    if (ttype == nullptr) return false;
+    int64_t size = 1;
+    for (const PrimExpr& dim : ttype->shape) {
+      const auto* dim_int = dim.as<IntImmNode>();
+      if (dim_int == nullptr) return false;
+      size *= dim_int->value;
+    }
+    if (size > max_output_size_) return false;
+    auto it = eligible_fns_.find(fn);
+    if (it == eligible_fns_.end()) {
+      it = eligible_fns_.emplace(fn, IsEligibleFunction(fn)).first;
+    }
+    return it->second;
+  }
+
+  // A function can join a batch when it is a plain primitive kernel whose ops
+  // are at most injective, so the batched tuple still lowers through the
+  // injective schedule.
+  bool IsEligibleFunction(const FunctionNode* fn) {
+    if (!fn->HasNonzeroAttr(attr::kPrimitive)) return false;
+    if (fn->GetAttr<String>(attr::kCompiler).defined()) return false;
+    // Reshape-only functions alias their input storage in the executors;
+    // keep that optimization instead of batching them.
+    if (fn->HasNonzeroAttr(attr::kReshapeOnly)) return false;
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    bool eligible = true;
+    PostOrderVisit(fn->body, [&](const Expr& e) {
+      if (const auto* call = e.as<CallNode>()) {
+        const auto* op = call->op.as<OpNode>();
+        if (op == nullptr || fpattern.get(GetRef<Op>(op), kOpaque) > kInjective) {
+          eligible = false;
+        }
+      }
+    });
+    return eligible;
+  }
+
+  int64_t max_output_size_;
+  int64_t max_batch_size_;
+  int current_batch_{0};
+  std::vector<const CallNode*> current_members_;
+  std::unordered_map<const Object*, int> reach_;
+  std::vector<std::vector<const CallNode*>> groups_;
+  std::unordered_map<const CallNode*, BatchMember> members_;
+  std::unordered_map<const FunctionNode*, bool> eligible_fns_;
+};
+
+/*!
+ * \brief Replaces each group member with a projection from the batched call.
+ */
+class BatchRewriter : public ExprMutator {
+ public:
+  BatchRewriter(const std::vector<std::vector<const CallNode*>>& groups,
+                const std::unordered_map<const CallNode*, BatchMember>& members)
+      : groups_(groups), members_(members) {}
+
+  Expr VisitExpr_(const CallNode* call) final {
+    auto it = members_.find(call);
+    if (it == members_.end()) {
+      return ExprMutator::VisitExpr_(call);
+    }
+    return TupleGetItem(GetBatchedCall(it->second.group_index), it->second.output_index);
+  }
+
+ private:
+  Expr GetBatchedCall(size_t group_index) {
+    auto it = batched_calls_.find(group_index);
+    if (it != batched_calls_.end()) {
+      return it->second;
+    }
+    Array<Var> params;
+    Array<Expr> args;
+    Array<Expr> bodies;
+    // Arguments shared between members are passed once.
+    std::unordered_map<const Object*, Var> arg_params;
+    for (const CallNode* member : groups_[group_index]) {
+      const auto* fn = member->op.as<FunctionNode>();
+      Map<Var, Expr> binds;
+      for (size_t i = 0; i < fn->params.size(); ++i) {
+        Expr new_arg = this->Mutate(member->args[i]);
+        Var param;
+        auto ait = arg_params.find(new_arg.get());
+        if (ait != arg_params.end()) {
+          param = ait->second;
+        } else {
+          param = Var("p" + std::to_string(params.size()), fn->params[i]->type_annotation);
+          params.push_back(param);
+          args.push_back(new_arg);
+          arg_params[new_arg.get()] = param;
+        }
+        binds.Set(fn->params[i], param);
+      }
+      bodies.push_back(Bind(fn->body, binds));
+    }
+    Function func = Function(params, Tuple(bodies), Type(), {});
+    func = WithAttr(std::move(func), attr::kPrimitive, tvm::Integer(1));
+    Expr batched = Call(func, args, Attrs());
+    batched_calls_[group_index] = batched;
+    return batched;
+  }
+
+  const std::vector<std::vector<const CallNode*>>& groups_;
+  const std::unordered_map<const CallNode*, BatchMember>& members_;
+  std::unordered_map<size_t, Expr> batched_calls_;
+};
+
+}  // namespace
+
+Expr BatchSmallOps(const Expr& expr, int64_t max_output_size, int64_t max_batch_size) {
+  BatchPlanner planner(max_output_size, max_batch_size);
+  if (!planner.Plan(expr) || planner.groups().empty()) {
+    return expr;
+  }
+  return BatchRewriter(planner.groups(), planner.members()).Mutate(expr);
+}
+
+namespace transform {
+
+Pass BatchSmallOps() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        int64_t max_output_size =
+            pc->GetConfig("relay.BatchSmallOps.max_output_size", Integer(0)).value()->value;
+        if (max_output_size <= 0) {
+          return f;
+        }
+        int64_t max_batch_size =
+            pc->GetConfig("relay.BatchSmallOps.max_batch_size", Integer(64)).value()->value;
+        Expr new_body = relay::BatchSmallOps(f->body, max_output_size, max_batch_size);
+        if (new_body.same_as(f->body)) {
+          return f;
+        }
+        return Function(f->params, new_body, f->ret_type, f->type_params, f->attrs);
+      };
+  return CreateFunctionPass(pass_func, 1, "BatchSmallOps", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.BatchSmallOps").set_body_typed(BatchSmallOps);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -151,7 +151,8 @@ Pass CombineParallelBatchMatmul(uint64_t min_num_branches) {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(CombineParallelBatchMatmul(f, min_num_branches));
       };
-  return CreateFunctionPass(pass_func, 4, "CombineParallelBatchMatmul", {"InferType"});
+  return CreateFunctionPass(pass_func, 4, "CombineParallelBatchMatmul", {"InferType"},
+                            {"nn.batch_matmul"});
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.CombineParallelBatchMatmul")
@@ -216,7 +216,7 @@ Pass CombineParallelConv2D(uint64_t min_num_branches) {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(CombineParallelConv2D(f, min_num_branches));
       };
-  return CreateFunctionPass(pass_func, 4, "CombineParallelConv2d", {"InferType"});
+  return CreateFunctionPass(pass_func, 4, "CombineParallelConv2d", {"InferType"}, {"nn.conv2d"});
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.CombineParallelConv2D").set_body_typed(CombineParallelConv2D);
@@ -22,13 +22,16 @@
  * \file combine_parallel_dense.cc
  * \brief Combine parallel dense ops into a single dense.
  *
- * This pass replaces dense ops that share the same input node, same shape,
- * and don't have "units" defined with a single batch matrix multiplication.
- * The inputs of the new batch_matmul is the stack of the original inputs.
- * Elemwise and broadcast ops following dense are also combined if possible.
+ * This pass replaces dense ops that share the same input node with a single
+ * dense whose weight is the concatenation of the original weights, so one
+ * wide GEMM replaces N narrow ones; the output dims of the branches may
+ * differ. Groups whose shapes are not static enough for that (e.g. dynamic
+ * output dims) are instead replaced with a batch matrix multiplication over
+ * the stacked inputs. Elemwise and broadcast ops following dense are also
+ * combined if possible.
  *
  * This prevents launching multiple kernels in networks with multiple
- * dense branches, such as BERT.
+ * dense branches, such as the QKV projections of BERT.
  */
 
 #include <tvm/relay/analysis.h>
@@ -108,6 +111,11 @@ class ParallelDenseToDenseCombiner : public ParallelOpCombiner {
     const auto* weight_a = a->args[1]->type_as<TensorTypeNode>();
     const auto* weight_b = b->args[1]->type_as<TensorTypeNode>();
     ICHECK(attrs_a != nullptr && attrs_b != nullptr && weight_a != nullptr && weight_b != nullptr);
+    // the weights are concatenated along the output axis and the result is
+    // recovered with strided_slice, so the output dims must be constants
+    if (!tir::as_const_int(weight_a->shape[0]) || !tir::as_const_int(weight_b->shape[0])) {
+      return false;
+    }
     // output dims (weight->shape[0]) can be different
     return eq(attrs_a->out_dtype, attrs_b->out_dtype) && eq(weight_a->shape[1], weight_b->shape[1]);
   }
@@ -141,6 +149,16 @@ class ParallelDenseToDenseCombiner : public ParallelOpCombiner {
     if (toutput_a->shape.size() < ta->shape.size() || toutput_b->shape.size() < tb->shape.size()) {
       return false;  // not broadcast/elemwise
     }
+    // the args are concatenated along their last axis, which requires the
+    // last dims of the args and of the branch outputs to be constants
+    if (!tir::as_const_int(toutput_a->shape[toutput_a->shape.size() - 1]) ||
+        !tir::as_const_int(toutput_b->shape[toutput_b->shape.size() - 1])) {
+      return false;
+    }
+    if (ta->shape.size() > 0 && (!tir::as_const_int(ta->shape[ta->shape.size() - 1]) ||
+                                 !tir::as_const_int(tb->shape[tb->shape.size() - 1]))) {
+      return false;
+    }
     if (ta->shape.size() > 0) {
       for (size_t i = 0; i < ta->shape.size() - 1; i++) {
         // shape dims must match except last dim
@@ -235,7 +253,18 @@ class ParallelDenseToDenseCombiner : public ParallelOpCombiner {
 /*! \brief Combine parallel dense if number of branches >= min_num_branches */
 Expr CombineParallelDense(const Expr& expr, uint64_t min_num_branches, bool to_batch) {
   if (to_batch) {
-    return ParallelDenseToBatchCombiner(min_num_branches).Combine(expr);
+    // Branches in a group always share their input (see BranchGroupFinder),
+    // so one dense over the concatenated weights beats batch_matmul, which
+    // has to stack a copy of the input per branch. Combine into a wide
+    // dense wherever the shapes allow it, then batch what remains.
+    Expr flat = ParallelDenseToDenseCombiner(min_num_branches).Combine(expr);
+    if (!flat.same_as(expr)) {
+      // the combined calls are untyped; re-infer so the batch combiner
+      // can inspect the argument types of the remaining groups.
+      IRModule mod = transform::InferType()(IRModule::FromExpr(flat));
+      flat = mod->Lookup("main");
+    }
+    return ParallelDenseToBatchCombiner(min_num_branches).Combine(flat);
   } else {
     return ParallelDenseToDenseCombiner(min_num_branches).Combine(expr);
   }
@@ -248,7 +277,7 @@ Pass CombineParallelDense(uint64_t min_num_branches, bool to_batch_matmul) {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(CombineParallelDense(f, min_num_branches, to_batch_matmul));
       };
-  return CreateFunctionPass(pass_func, 4, "CombineParallelDense", {"InferType"});
+  return CreateFunctionPass(pass_func, 4, "CombineParallelDense", {"InferType"}, {"nn.dense"});
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.CombineParallelDense").set_body_typed(CombineParallelDense);
@@ -96,10 +96,20 @@ class DenseToSparseDenseMutator : public ExprRewriter {
           const auto& prefix = weight->name_hint();
           const auto& ws = target_weights_.at(prefix);
           const auto data = post.as<CallNode>()->args[0];
-          auto ws_data_type =
-              relay::TensorType({ws.at(0), ws.at(1), ws.at(2)}, DataType::Float(32));
-          auto ws_indices_type = relay::TensorType({ws.at(3)}, DataType::Int(32));
-          auto ws_indptr_type = relay::TensorType({ws.at(4)}, DataType::Int(32));
+          // A 5 entry shape list describes a BSR weight with 3-D data, a 3
+          // entry one a CSR weight where data is 1-D; the sparse_dense kernels
+          // dispatch on the data rank, so formats can be mixed per layer.
+          relay::TensorType ws_data_type, ws_indices_type, ws_indptr_type;
+          if (ws.size() == 5) {
+            ws_data_type = relay::TensorType({ws.at(0), ws.at(1), ws.at(2)}, DataType::Float(32));
+            ws_indices_type = relay::TensorType({ws.at(3)}, DataType::Int(32));
+            ws_indptr_type = relay::TensorType({ws.at(4)}, DataType::Int(32));
+          } else {
+            ICHECK_EQ(ws.size(), 3U) << "weight shape must describe a BSR or CSR matrix";
+            ws_data_type = relay::TensorType({ws.at(0)}, DataType::Float(32));
+            ws_indices_type = relay::TensorType({ws.at(1)}, DataType::Int(32));
+            ws_indptr_type = relay::TensorType({ws.at(2)}, DataType::Int(32));
+          }
           Var weight_data(prefix + ".data", ws_data_type);
           Var weight_indices(prefix + ".indices", ws_indices_type);
           Var weight_indptr(prefix + ".indptr", ws_indptr_type);
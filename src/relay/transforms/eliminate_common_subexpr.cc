@@ -22,16 +22,32 @@
  * \file eliminate_common_subexpr.cc
  * \brief Combine common subexpressions.
  *
- * This is an optimization pass that eliminates common subexpressions. During the pass, it tries
- * to replace an expression with a previously appeared expression with the same input and
- * attributes. The fskip callback argument allows us to skip specific expressions.
+ * This is an optimization pass that eliminates common subexpressions. Every
+ * distinct value is assigned a small integer value number; a call's lookup key
+ * is built from its op, its attributes and the value numbers of its arguments,
+ * so each node is keyed in O(size of the node) regardless of how deep its
+ * subtree is, and the pass scales linearly with the program. Operands of
+ * commutative ops are put in canonical value-number order before keying, so
+ * add(a, b) and add(b, a) collapse. Structurally identical constants share a
+ * value number, and identical constants and primitive functions are
+ * canonicalized through tables shared across the functions of a module, so
+ * duplicate fused functions and repeated weights unify across function
+ * boundaries. The fskip callback argument allows us to skip specific
+ * expressions.
  */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "../../support/utils.h"
 #include "pattern_utils.h"
 
 namespace tvm {
@@ -39,7 +55,19 @@ namespace relay {
 
 class CommonSubexprEliminator : public MixedModeMutator {
  public:
-  explicit CommonSubexprEliminator(runtime::TypedPackedFunc<bool(Expr)> fskip) : fskip_(fskip) {}
+  /*!
+   * \brief Canonical constants and primitive functions, shared by the
+   *  rewrites of all functions in a module so duplicates unify across
+   *  function boundaries.
+   */
+  struct CrossFunctionTables {
+    std::unordered_multimap<size_t, Constant> constants;
+    std::unordered_multimap<size_t, Function> functions;
+  };
+
+  CommonSubexprEliminator(runtime::TypedPackedFunc<bool(Expr)> fskip,
+                          std::shared_ptr<CrossFunctionTables> tables)
+      : fskip_(fskip), tables_(std::move(tables)) {}
 
   Expr Rewrite_(const CallNode* call, const Expr& post) final {
     static auto op_stateful = Op::GetAttrMap<TOpIsStateful>("TOpIsStateful");
@@ -47,7 +75,6 @@ class CommonSubexprEliminator : public MixedModeMutator {
     const CallNode* new_call = new_expr.as<CallNode>();
     ICHECK(new_call);
     const OpNode* op = new_call->op.as<OpNode>();
-    StructuralEqual attrs_equal;
 
     if (new_call->args.size() == 0 || op == nullptr || op_stateful.get(GetRef<Op>(op), false)) {
       return new_expr;
@@ -56,27 +83,39 @@ class CommonSubexprEliminator : public MixedModeMutator {
       return new_expr;
     }
 
-    auto it = expr_map_.find(new_call->op);
-    if (it != expr_map_.end()) {
-      for (const Expr& candidate_expr : it->second) {
-        if (const CallNode* candidate = candidate_expr.as<CallNode>()) {
-          bool is_equivalent = true;
-          if (!attrs_equal(new_call->attrs, candidate->attrs)) {
-            continue;
-          }
-          for (size_t i = 0; i < new_call->args.size(); i++) {
-            if (!new_call->args[i].same_as(candidate->args[i]) &&
-                !IsEqualScalar(new_call->args[i], candidate->args[i])) {
-              is_equivalent = false;
-              break;
-            }
-          }
-          if (!is_equivalent) continue;
-          return GetRef<Call>(candidate);
-        }
+    std::vector<uint64_t> arg_vns;
+    arg_vns.reserve(new_call->args.size());
+    for (const Expr& arg : new_call->args) {
+      arg_vns.push_back(ValueNumber(arg));
+    }
+    // Canonical operand order makes commuted uses hash and compare equal.
+    if (arg_vns.size() == 2 && IsCommutative(op) && arg_vns[0] > arg_vns[1]) {
+      std::swap(arg_vns[0], arg_vns[1]);
+    }
+
+    uint64_t key = support::HashCombine(std::hash<const Object*>()(new_call->op.get()),
+                                        new_call->attrs.defined()
+                                            ? StructuralHash()(new_call->attrs)
+                                            : static_cast<size_t>(0));
+    for (uint64_t vn : arg_vns) {
+      key = support::HashCombine(key, vn);
+    }
+
+    StructuralEqual attrs_equal;
+    auto range = call_map_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      const Candidate& candidate = it->second;
+      // Value numbers identify values exactly (constants by structure,
+      // everything else by node), so matching numbers plus matching attrs
+      // mean the candidate computes the same value; only the hashed key can
+      // collide.
+      if (candidate.expr.as<CallNode>()->op.same_as(new_call->op) &&
+          candidate.arg_vns == arg_vns &&
+          attrs_equal(new_call->attrs, candidate.expr.as<CallNode>()->attrs)) {
+        return candidate.expr;
       }
     }
-    expr_map_[new_call->op].push_back(new_expr);
+    call_map_.emplace(key, Candidate{new_expr, std::move(arg_vns)});
     return new_expr;
   }
 
@@ -89,34 +128,130 @@ class CommonSubexprEliminator : public MixedModeMutator {
       return new_expr;
     }
 
-    auto it = expr_map_.find(new_tuple_item->tuple);
-    if (it != expr_map_.end()) {
-      for (const Expr& candidate_expr : it->second) {
-        if (const TupleGetItemNode* candidate = candidate_expr.as<TupleGetItemNode>()) {
-          if (new_tuple_item->index == candidate->index) {
-            return GetRef<Expr>(candidate);
-          }
-        }
+    uint64_t tuple_vn = ValueNumber(new_tuple_item->tuple);
+    uint64_t key = support::HashCombine(tuple_vn, static_cast<uint64_t>(new_tuple_item->index));
+    auto range = getitem_map_.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      const TupleGetItemNode* candidate = it->second.as<TupleGetItemNode>();
+      if (candidate->index == new_tuple_item->index &&
+          ValueNumber(candidate->tuple) == tuple_vn) {
+        return it->second;
       }
     }
-    expr_map_[new_tuple_item->tuple].push_back(new_expr);
+    getitem_map_.emplace(key, new_expr);
     return new_expr;
   }
 
-  std::unordered_map<Expr, std::vector<Expr>, ObjectPtrHash, ObjectPtrEqual> expr_map_;
+  Expr VisitExpr_(const ConstantNode* op) final {
+    if (tables_ == nullptr) {
+      return GetRef<Expr>(op);
+    }
+    // Canonicalize identical constants to one node, including across the
+    // functions of the module, so their consumers can unify by pointer.
+    Constant constant = GetRef<Constant>(op);
+    size_t hash = StructuralHash::Cached(constant);
+    auto range = tables_->constants.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (StructuralEqual()(it->second, constant)) {
+        return it->second;
+      }
+    }
+    tables_->constants.emplace(hash, constant);
+    return constant;
+  }
+
+  Expr VisitExpr_(const FunctionNode* op) final {
+    Expr post = ExprMutator::VisitExpr_(op);
+    if (tables_ == nullptr) {
+      return post;
+    }
+    // Fusion frequently produces structurally identical primitive functions;
+    // sharing one node deduplicates their hashing and lowering downstream.
+    Function func = Downcast<Function>(post);
+    if (!func->HasNonzeroAttr(attr::kPrimitive)) {
+      return post;
+    }
+    size_t hash = StructuralHash::Cached(func);
+    auto range = tables_->functions.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (StructuralEqual()(it->second, func)) {
+        return it->second;
+      }
+    }
+    tables_->functions.emplace(hash, func);
+    return post;
+  }
+
+ private:
+  struct Candidate {
+    Expr expr;
+    std::vector<uint64_t> arg_vns;
+  };
+
+  static bool IsCommutative(const OpNode* op) {
+    static const std::unordered_set<std::string> commutative_ops{
+        "add",        "multiply",   "maximum",     "minimum", "logical_and",
+        "logical_or", "logical_xor", "bitwise_and", "bitwise_or", "bitwise_xor",
+        "equal",      "not_equal"};
+    return commutative_ops.count(op->name) != 0;
+  }
+
+  /*!
+   * \brief The value number of an already-rewritten expression.
+   *
+   *  Numbers are handed out on first sight, so two expressions share a
+   *  number iff they are the same node — except constants, which share a
+   *  number whenever they are structurally identical.
+   */
+  uint64_t ValueNumber(const Expr& expr) {
+    auto it = value_number_.find(expr.get());
+    if (it != value_number_.end()) {
+      return it->second;
+    }
+    uint64_t vn;
+    if (expr.as<ConstantNode>()) {
+      size_t hash = StructuralHash::Cached(expr);
+      auto range = constant_vn_.equal_range(hash);
+      vn = next_value_number_;
+      for (auto cit = range.first; cit != range.second; ++cit) {
+        if (StructuralEqual()(cit->second.first, expr)) {
+          vn = cit->second.second;
+          break;
+        }
+      }
+      if (vn == next_value_number_) {
+        constant_vn_.emplace(hash, std::make_pair(expr, next_value_number_++));
+      }
+    } else {
+      vn = next_value_number_++;
+    }
+    value_number_[expr.get()] = vn;
+    return vn;
+  }
+
   runtime::TypedPackedFunc<bool(Expr)> fskip_;
+  std::shared_ptr<CrossFunctionTables> tables_;
+  uint64_t next_value_number_{0};
+  std::unordered_map<const Object*, uint64_t> value_number_;
+  std::unordered_multimap<size_t, std::pair<Expr, uint64_t>> constant_vn_;
+  std::unordered_multimap<uint64_t, Candidate> call_map_;
+  std::unordered_multimap<uint64_t, Expr> getitem_map_;
 };
 
 Expr EliminateCommonSubexpr(const Expr& expr, PackedFunc callback) {
-  return CommonSubexprEliminator(callback)(expr);
+  auto tables = std::make_shared<CommonSubexprEliminator::CrossFunctionTables>();
+  return CommonSubexprEliminator(callback, tables)(expr);
 }
 
 namespace transform {
 
 Pass EliminateCommonSubexpr(PackedFunc fskip) {
+  // One table of canonical constants and primitive functions serves every
+  // function the pass rewrites, so duplicates unify module-wide.
+  auto tables = std::make_shared<CommonSubexprEliminator::CrossFunctionTables>();
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
-        return Downcast<Function>(EliminateCommonSubexpr(f, fskip));
+        return Downcast<Function>(CommonSubexprEliminator(fskip, tables)(f));
       };
   return CreateFunctionPass(pass_func, 3, "EliminateCommonSubexpr", {"InferType"});
 }
@@ -34,7 +34,13 @@ namespace relay {
 
 class FastMathMutator : public ExprRewriter {
  public:
-  FastMathMutator() : exp_op_(Op::Get("exp")), erf_op_(Op::Get("erf")), tanh_op_(Op::Get("tanh")) {}
+  FastMathMutator()
+      : exp_op_(Op::Get("exp")),
+        erf_op_(Op::Get("erf")),
+        tanh_op_(Op::Get("tanh")),
+        sigmoid_op_(Op::Get("sigmoid")),
+        softmax_op_(Op::Get("nn.softmax")),
+        fast_softmax_op_(Op::Get("nn.fast_softmax")) {}
 
   Expr Rewrite_(const CallNode* pre, const Expr& post) override {
     if (pre->op == exp_op_) {
@@ -43,6 +49,10 @@ class FastMathMutator : public ExprRewriter {
       return FastErf(post.as<CallNode>()->args[0]);
     } else if (pre->op == tanh_op_) {
       return FastTanh(post.as<CallNode>()->args[0]);
+    } else if (pre->op == sigmoid_op_) {
+      return FastSigmoid(post.as<CallNode>()->args[0]);
+    } else if (pre->op == softmax_op_) {
+      return Call(fast_softmax_op_, post.as<CallNode>()->args, post.as<CallNode>()->attrs);
     }
     return post;
   }
@@ -54,6 +64,9 @@ class FastMathMutator : public ExprRewriter {
   const Op& exp_op_;
   const Op& erf_op_;
   const Op& tanh_op_;
+  const Op& sigmoid_op_;
+  const Op& softmax_op_;
+  const Op& fast_softmax_op_;
 };
 
 Expr FastMath(const Expr& e) {
@@ -20,6 +20,8 @@
 /*!
  * \file constant_folding.cc
  */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/expr_functor.h>
@@ -31,6 +33,11 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "pass_utils.h"
 #include "pattern_utils.h"
 
 namespace tvm {
@@ -38,6 +45,68 @@ namespace relay {
 
 using FInterpreter = runtime::TypedPackedFunc<ObjectRef(Expr)>;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.use_const_eval_cache", Bool);
+
+/*!
+ * \brief Process-wide cache of constant evaluation results.
+ *
+ * The constant islands of a model are dominated by weight transforms that are
+ * identical from one build to the next (the structural hash of a constant
+ * covers its tensor contents), so repeated builds can skip re-evaluating them
+ * entirely. Entries pin the evaluated tensors in host memory, hence the cache
+ * is opt-in through the relay.use_const_eval_cache pass config and is
+ * cleared wholesale when it grows past its bound. The cache is shared with
+ * every evaluation-driven pass via ConstEvalCacheLookup/Insert.
+ */
+class ConstEvalCache {
+ public:
+  static ConstEvalCache* Global() {
+    static ConstEvalCache* inst = new ConstEvalCache();
+    return inst;
+  }
+
+  Optional<ObjectRef> Lookup(const Expr& expr) {
+    size_t hash = StructuralHash::Cached(expr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (structural_equal_(it->second.input, expr)) {
+        return it->second.result;
+      }
+    }
+    return NullOpt;
+  }
+
+  void Insert(const Expr& expr, const ObjectRef& result) {
+    size_t hash = StructuralHash::Cached(expr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      entries_.clear();
+    }
+    entries_.emplace(hash, Entry{expr, result});
+  }
+
+ private:
+  struct Entry {
+    Expr input;
+    ObjectRef result;
+  };
+
+  static constexpr size_t kMaxEntries = 1024;
+
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, Entry> entries_;
+  StructuralEqual structural_equal_;
+};
+
+Optional<ObjectRef> ConstEvalCacheLookup(const Expr& expr) {
+  return ConstEvalCache::Global()->Lookup(expr);
+}
+
+void ConstEvalCacheInsert(const Expr& expr, const ObjectRef& result) {
+  ConstEvalCache::Global()->Insert(expr, result);
+}
+
 class ConstantChecker : private ExprVisitor {
  public:
   // Check whether an expression is constant. The results are memoized.
@@ -79,6 +148,9 @@ class ConstantFolder : public MixedModeMutator {
  public:
   explicit ConstantFolder(IRModule module)
       : module_(module),
+        use_eval_cache_(transform::PassContext::Current()
+                            ->GetConfig<Bool>("relay.use_const_eval_cache", Bool(false))
+                            .value()),
         device_copy_op_(Op::Get("device_copy")),
         shape_of_op_(Op::Get("shape_of")),
         vm_shape_of_op_(Op::Get("vm.shape_of")),
@@ -171,7 +243,9 @@ class ConstantFolder : public MixedModeMutator {
     static auto fnoncomputational = Op::GetAttrMap<TNonComputational>("TNonComputational");
     if (const auto* call_node = call->op.as<OpNode>()) {
       Op op = GetRef<Op>(call_node);
-      if ((fnoncomputational.count(op) && fnoncomputational[op]) || (call->op == device_copy_op_)) {
+      const runtime::TVMRetValue* noncomputational = fnoncomputational.GetRaw(op);
+      if ((noncomputational != nullptr && noncomputational->operator bool()) ||
+          (call->op == device_copy_op_)) {
         return GetRef<Call>(call);
       }
     }
@@ -203,6 +277,8 @@ class ConstantFolder : public MixedModeMutator {
   ConstantChecker checker_;
   // Module
   IRModule module_;
+  // Whether evaluation results are shared through the process-wide cache.
+  bool use_eval_cache_;
 
   // Cache the following ops for equivalence checking in this pass.
   const Op& device_copy_op_;
@@ -230,6 +306,15 @@ class ConstantFolder : public MixedModeMutator {
   }
   // Constant evaluate an expression.
   Expr ConstEvaluate(Expr expr) {
+    // Expressions reaching this point are closed (all call arguments are
+    // constant), so a structurally identical expression evaluates to the
+    // same result in any build.
+    Expr key = expr;
+    if (use_eval_cache_) {
+      if (Optional<ObjectRef> cached = ConstEvalCacheLookup(key)) {
+        return ObjectToExpr(cached.value());
+      }
+    }
     std::vector<transform::Pass> passes = {transform::FuseOps(0), transform::ToANormalForm(),
                                            transform::InferType()};
     Function func;
@@ -258,7 +343,11 @@ class ConstantFolder : public MixedModeMutator {
     With<PassContext> fresh_build_ctx(PassContext::Create());
 
     FInterpreter executor = CreateInterpreter(mod, dev, target);
-    return ObjectToExpr(executor(expr));
+    ObjectRef value = executor(expr);
+    if (use_eval_cache_) {
+      ConstEvalCacheInsert(key, value);
+    }
+    return ObjectToExpr(value);
   }
 
   // Evaluate a call to the shape_of operator for tensors with constant
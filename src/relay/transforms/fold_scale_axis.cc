@@ -583,6 +583,33 @@ RELAY_REGISTER_OP("nn.conv2d").set_attr<FForwardPrep>("FScaleAxisForwardPrep", C
 RELAY_REGISTER_OP("nn.conv2d")
     .set_attr<FForwardRewrite>("FScaleAxisForwardRewrite", Conv2DForwardRewrite);
 
+// Dense send out requirement of axis folding.
+Array<Message> DenseForwardPrep(const Call& call, const Message& out_message) {
+  // A scale on the reduction axis of the data folds into the weight, which is
+  // laid out [units, in_units]. Only the plain 2-D data case is handled.
+  const auto* data_ty = call->args[0]->checked_type().as<TensorTypeNode>();
+  if (data_ty == nullptr || data_ty->shape.size() != 2) {
+    return {NullValue<Message>(), NullValue<Message>()};
+  }
+  return {Message({1}, false), NullValue<Message>()};
+}
+
+// Dense consumes the sdata->scale axis during transformation.
+Expr DenseForwardRewrite(const Call& ref_call, const Array<Expr>& new_args,
+                         const Message& message) {
+  const auto* sdata = new_args[0].as<ScaledExprNode>();
+  const auto* sweight = new_args[1].as<ScaledExprNode>();
+  if (sdata == nullptr) return Expr();
+  if (sweight != nullptr) return Expr();
+  Expr weight = Multiply(new_args[1], ExpandBiasToMatchAxis(sdata->scale, 2, {1}));
+  return Call(ref_call->op, {sdata->value, weight}, ref_call->attrs, ref_call->type_args);
+}
+
+RELAY_REGISTER_OP("nn.dense").set_attr<FForwardPrep>("FScaleAxisForwardPrep", DenseForwardPrep);
+
+RELAY_REGISTER_OP("nn.dense")
+    .set_attr<FForwardRewrite>("FScaleAxisForwardRewrite", DenseForwardRewrite);
+
 Expr ForwardFoldScaleAxis(const Expr& data) {
   auto message = ForwardPrep().Prepare(data);
   auto fcontext = [&](const Call& call) -> ObjectRef {
@@ -971,6 +998,34 @@ RELAY_REGISTER_OP("nn.conv2d")
 RELAY_REGISTER_OP("nn.conv2d")
     .set_attr<FBackwardTransform>("FScaleAxisBackwardTransform", Conv2DBackwardTransform);
 
+// Dense send out requirement of axis folding.
+Message DenseBackwardPrep(const Call& call, const Array<Message>& in_messages) {
+  // A scale on the output units axis folds into axis 0 of the weight. Only
+  // the plain 2-D output case is handled.
+  const auto* out_ty = call->checked_type().as<TensorTypeNode>();
+  if (out_ty == nullptr || out_ty->shape.size() != 2) {
+    return NullValue<Message>();
+  }
+  return Message({1}, false);
+}
+
+// Dense consumes the scale axis during transformation.
+Expr DenseBackwardTransform(const Call& call, const Message& message, const Expr& scale,
+                            const BackwardTransformer& transformer) {
+  if (!message.defined()) {
+    return transformer->NormalCallTransform(call.operator->());
+  }
+  Expr data = transformer->Transform(call->args[0], NullValue<Message>(), NullValue<Expr>());
+  Expr weight = transformer->Transform(call->args[1], NullValue<Message>(), NullValue<Expr>());
+  weight = Multiply(weight, ExpandBiasToMatchAxis(scale, 2, {0}));
+  return Call(call->op, {data, weight}, call->attrs, call->type_args);
+}
+
+RELAY_REGISTER_OP("nn.dense").set_attr<FBackwardPrep>("FScaleAxisBackwardPrep", DenseBackwardPrep);
+
+RELAY_REGISTER_OP("nn.dense")
+    .set_attr<FBackwardTransform>("FScaleAxisBackwardTransform", DenseBackwardTransform);
+
 Expr BackwardFoldScaleAxis(const Expr& data) {
   return make_object<BackwardTransformerNode>()->Fold(data);
 }
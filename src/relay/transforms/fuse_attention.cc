@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/fuse_attention.cc
+ * \brief Rewrite the unfused attention idiom to nn.fused_attention.
+ *
+ * Transformer frontends emit scaled dot-product attention as
+ * batch_matmul -> (scale) -> softmax -> batch_matmul(transpose(value)),
+ * which FuseOps cannot merge because the softmax reductions break the
+ * injective fusion chain. This pass pattern-matches the idiom and replaces
+ * it with the first-class fused operator, so the whole computation lowers
+ * to one kernel.
+ */
+
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/attrs/transform.h>
+#include <tvm/relay/dataflow_matcher.h>
+#include <tvm/relay/expr.h>
+#include <tvm/relay/transform.h>
+
+#include "../op/make_op.h"
+#include "pattern_utils.h"
+#include "simplify_expr.h"
+
+namespace tvm {
+namespace relay {
+
+/*!
+ * \brief Matches softmax(scale * batch_matmul(Q, K)) * V^T and rewrites it to
+ *   nn.fused_attention. The score scaling is optional and may appear as a
+ *   multiply or divide by a scalar constant; scaling folded into the query by
+ *   the frontend matches the unscaled form.
+ */
+class FuseAttentionRewrite : public DFPatternRewrite {
+ public:
+  FuseAttentionRewrite() {
+    query_ = IsWildcard();
+    key_ = IsWildcard();
+    value_ = IsWildcard();
+    scale_ = IsConstant();
+
+    auto scores = IsOp("nn.batch_matmul")({query_, key_});
+    scaled_mul_lhs_ = IsOp("multiply")({scores, scale_});
+    scaled_mul_rhs_ = IsOp("multiply")({scale_, scores});
+    scaled_div_ = IsOp("divide")({scores, scale_});
+    softmax_ = IsOp("nn.softmax")({scaled_mul_lhs_ || scaled_mul_rhs_ || scaled_div_ || scores});
+    transpose_ = IsOp("transpose")({value_});
+    pattern_ = IsOp("nn.batch_matmul")({softmax_, transpose_});
+  }
+
+  Expr Callback(const Expr& pre, const Expr& post,
+                const Map<DFPattern, Array<Expr>>& node_map) const override {
+    auto query = node_map[query_][0];
+    auto key = node_map[key_][0];
+    auto value = node_map[value_][0];
+
+    // The fused op only covers 3D inputs with the softmax over the key axis.
+    const auto* query_type = query->checked_type().as<TensorTypeNode>();
+    if (query_type == nullptr || query_type->shape.size() != 3) {
+      return post;
+    }
+    const auto* softmax_call = node_map[softmax_][0].as<CallNode>();
+    const auto* softmax_attrs = softmax_call->attrs.as<SoftmaxAttrs>();
+    if (softmax_attrs->axis != -1 && softmax_attrs->axis != 2) {
+      return post;
+    }
+
+    // The second batch_matmul must undo relay's implicit transposition of its
+    // right operand, i.e. the value tensor comes in as transpose(V, [0, 2, 1]).
+    const auto* transpose_call = node_map[transpose_][0].as<CallNode>();
+    const auto* transpose_attrs = transpose_call->attrs.as<TransposeAttrs>();
+    if (!transpose_attrs->axes.defined() || transpose_attrs->axes.size() != 3) {
+      return post;
+    }
+    static const int64_t expected_axes[3] = {0, 2, 1};
+    for (int i = 0; i < 3; ++i) {
+      int64_t axis = transpose_attrs->axes[i];
+      if (axis < 0) {
+        axis += 3;
+      }
+      if (axis != expected_axes[i]) {
+        return post;
+      }
+    }
+
+    double scale = 1.0;
+    if (node_map.count(scale_)) {
+      const auto* scale_const = node_map[scale_][0].as<ConstantNode>();
+      if (!IsConstScalar(GetRef<Constant>(scale_const))) {
+        return post;
+      }
+      auto value_opt = TryToScalar(scale_const->data);
+      if (!value_opt) {
+        return post;
+      }
+      scale = static_cast<double>(value_opt.value());
+      if (node_map.count(scaled_div_)) {
+        if (scale == 0.0) {
+          return post;
+        }
+        scale = 1.0 / scale;
+      }
+    }
+
+    return MakeFusedAttention(query, key, value, scale);
+  }
+
+ private:
+  DFPattern query_, key_, value_, scale_;
+  DFPattern scaled_mul_lhs_, scaled_mul_rhs_, scaled_div_;
+  DFPattern softmax_, transpose_;
+};
+
+Expr FuseAttention(const Expr& expr, const IRModule& mod) {
+  DFPatternRewriteComposer composer;
+  composer.AddRewrite<FuseAttentionRewrite>();
+  return RewritePatterns(composer.MakeCallbacks(), expr, mod);
+}
+
+namespace transform {
+
+Pass FuseAttention() {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(FuseAttention(f, m));
+      };
+  return CreateFunctionPass(pass_func, 0, "FuseAttention", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.FuseAttention").set_body_typed(FuseAttention);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -24,12 +24,19 @@
  * \brief This is a backend-aware optimization pass.
  *   Fuse necessary ops into a single one.
  */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
 #include <tvm/tir/op.h>
 
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "../../support/arena.h"
 #include "pass_utils.h"
 #include "pattern_utils.h"
@@ -84,6 +91,7 @@ constexpr uint32_t kMaxFusedOps = 256;
 static const Op& stop_fusion_op = Op::Get("annotation.stop_fusion");
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.max_depth", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.incremental", Bool);
 
 /*!
  * \brief Indexed data flow graph in forward direction.
@@ -239,13 +247,26 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
     // Finally if the operator position is not a call node we will
     // need to call Update, as it may be an arbitrary expression.
     OpPatternKind op_pattern = kOpaque;
+    std::vector<bool> data_dependent_args;
     if (const OpNode* opnode = call->op.as<OpNode>()) {
       auto op = GetRef<Op>(opnode);
+      op_pattern = static_cast<OpPatternKind>(fpattern[op]);
       if (IsDynamic(call->checked_type()) && IsDataDependent(call)) {
-        // output of a shape func can't be fed to a data-dependent shape func
-        op_pattern = kOpaque;
-      } else {
-        op_pattern = static_cast<OpPatternKind>(fpattern[op]);
+        // The output of a shape func can't be fed to a data-dependent shape
+        // func: the shape of the fused group's output must be computable
+        // before the kernel runs, so an argument whose *data* the shape
+        // function reads has to stay a parameter of the group. Instead of
+        // giving up on the op, keep its pattern and make only the
+        // data-dependent argument edges opaque; producers can still fuse
+        // into shape-only arguments and consumers can fuse the output,
+        // since they compose this op's shape function by shape alone.
+        static auto tshape_data_dependent =
+            Op::GetAttrMap<TShapeDataDependent>("TShapeDataDependent");
+        Array<Integer> dep_spec = tshape_data_dependent[op];
+        for (size_t i = 0; i < call->args.size(); ++i) {
+          const Integer& dep = dep_spec[dep_spec.size() == 1 ? 0 : i];
+          data_dependent_args.push_back(dep->value != 0);
+        }
       }
     } else {
       this->Update(call->op, node, kOpaque);
@@ -263,6 +284,9 @@ class IndexedForwardGraph::Creator : private ExprVisitor {
           attr_equal_(rtype->shape, arg_type->shape)) {
         edge_pattern = kElemWise;
       }
+      if (i < data_dependent_args.size() && data_dependent_args[i]) {
+        edge_pattern = kOpaque;
+      }
       this->Update(call->args[i], node, edge_pattern);
     }
     ExprVisitor::VisitExpr_(call);
@@ -981,6 +1005,10 @@ class FuseMutator : private MixedModeMutator {
     if (visitor.has_call && visitor.reshape_only) {
       func = WithAttr(std::move(func), attr::kReshapeOnly, tvm::Integer(visitor.reshape_only));
     }
+    if (visitor.has_call && group->pattern == kElemWise) {
+      // Mark all-elementwise groups so the memory planner can run them in place.
+      func = WithAttr(std::move(func), attr::kElemwiseOnly, tvm::Integer(1));
+    }
     return Call(func, ginfo.arguments, Attrs());
   }
 
@@ -1019,6 +1047,64 @@ Expr FuseOps(const Expr& expr, int fuse_opt_level, size_t max_fuse_depth, const
   return FuseMutator().Transform(expr, fuse_opt_level, max_fuse_depth);
 }
 
+/*!
+ * \brief Process-wide cache of fusion results for incremental builds.
+ *
+ * Workflows that rebuild variations of one model (e.g. architecture search)
+ * re-fuse mostly unchanged functions on every build, and fusion dominates the
+ * pass pipeline on large graphs. Top-level relay functions are closed, and the
+ * fused result only references the input function's own params, so reusing the
+ * result of a structurally identical input is sound. Entries hold strong
+ * references; the cache is bounded and simply cleared when full.
+ *
+ * Enabled via the relay.FuseOps.incremental pass config.
+ */
+class FuseResultCache {
+ public:
+  static FuseResultCache* Global() {
+    static FuseResultCache* inst = new FuseResultCache();
+    return inst;
+  }
+
+  Optional<Function> Lookup(const Function& func, int fuse_opt_level, size_t max_fuse_depth) {
+    size_t hash = StructuralHash::Cached(func);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      const Entry& entry = it->second;
+      if (entry.fuse_opt_level == fuse_opt_level && entry.max_fuse_depth == max_fuse_depth &&
+          structural_equal_(entry.input, func)) {
+        return entry.result;
+      }
+    }
+    return NullOpt;
+  }
+
+  void Insert(const Function& func, int fuse_opt_level, size_t max_fuse_depth,
+              const Function& result) {
+    size_t hash = StructuralHash::Cached(func);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kMaxEntries) {
+      entries_.clear();
+    }
+    entries_.emplace(hash, Entry{func, fuse_opt_level, max_fuse_depth, result});
+  }
+
+ private:
+  struct Entry {
+    Function input;
+    int fuse_opt_level;
+    size_t max_fuse_depth;
+    Function result;
+  };
+
+  static constexpr size_t kMaxEntries = 256;
+
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, Entry> entries_;
+  StructuralEqual structural_equal_;
+};
+
 namespace transform {
 
 Pass FuseOps(int fuse_opt_level) {
@@ -1026,6 +1112,17 @@ Pass FuseOps(int fuse_opt_level) {
       [=](Function f, IRModule m, PassContext pc) {
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relay.FuseOps.max_depth", Integer(kMaxFusedOps));
+        bool incremental = pc->GetConfig<Bool>("relay.FuseOps.incremental", Bool(false)).value();
+        if (incremental) {
+          FuseResultCache* cache = FuseResultCache::Global();
+          size_t depth = static_cast<size_t>(max_fuse_depth.value()->value);
+          if (Optional<Function> hit = cache->Lookup(f, opt_level, depth)) {
+            return hit.value();
+          }
+          Function fused = Downcast<Function>(FuseOps(f, opt_level, depth, m));
+          cache->Insert(f, opt_level, depth, fused);
+          return fused;
+        }
         return Downcast<Function>(FuseOps(f, opt_level, max_fuse_depth.value(), m));
       };
   return CreateFunctionPass(pass_func, 1, "FuseOps", {"InferType"});
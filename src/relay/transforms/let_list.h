@@ -65,7 +65,12 @@ class LetList {
    */
   Var Push(Var pv, Expr expr) {
     ICHECK(!used_);
+#if TVM_LOG_DEBUG
+    // a full free-variable analysis per binding is quadratic in the number of
+    // bindings and dominates the allocation cost of large let lists, so only
+    // check well-formedness in debug builds.
     ICHECK(WellFormed(expr));
+#endif
     lets_.emplace_back(std::make_pair(pv, expr));
     return pv;
   }
@@ -37,7 +37,9 @@
 #include <cstdint>
 #include <cstdio>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../backend/compile_engine.h"
@@ -106,6 +108,7 @@ class DialectRewriter : public ExprMutator {
 
   Expr VisitExpr_(const LetNode* ln) final {
     scopes_.emplace_back();
+    shape_of_caches_.emplace_back();
 
     const LetNode* let = ln;
     Expr body;
@@ -119,6 +122,7 @@ class DialectRewriter : public ExprMutator {
     CHECK(body.defined());
     auto new_body = ExprMutator::Mutate(body);
     auto ret = scopes_.back().Get(new_body);
+    shape_of_caches_.pop_back();
     scopes_.pop_back();
     return ret;
   }
@@ -282,9 +286,18 @@ class DialectRewriter : public ExprMutator {
       if (state == 2) {
         std::vector<Expr> exprs = FromTupleType(ty, arg);
         for (size_t j = 0; j < exprs.size(); ++j) {
+          // Chains of dynamic ops keep asking for the shapes of the same
+          // tensors; materialize each tensor's shape once per scope.
+          if (Optional<Expr> cached = LookupShapeOf(exprs[j])) {
+            shape_func_ins.push_back(cached.value());
+            input_pos++;
+            continue;
+          }
           Expr sh_of = ExprMutator::Mutate(ShapeOf(exprs[j]));
           Var in_shape_var("in_shape_" + std::to_string(input_pos + j), Type(nullptr));
-          shape_func_ins.push_back(scope->Push(in_shape_var, sh_of));
+          Expr in_shape = scope->Push(in_shape_var, sh_of);
+          shape_of_caches_.back()[exprs[j].get()] = in_shape;
+          shape_func_ins.push_back(in_shape);
           input_pos++;
         }
         is_inputs.push_back(0);
@@ -375,17 +388,190 @@ class DialectRewriter : public ExprMutator {
     return ReshapeTensor(new_args[0], shape_expr, ret_ty->shape);
   }
 
+  // Find a previously materialized shape for the tensor, searching enclosing
+  // scopes so results from outer let chains are reused in inner ones.
+  Optional<Expr> LookupShapeOf(const Expr& tensor) const {
+    for (auto it = shape_of_caches_.rbegin(); it != shape_of_caches_.rend(); ++it) {
+      auto cached = it->find(tensor.get());
+      if (cached != it->end()) {
+        return cached->second;
+      }
+    }
+    return NullOpt;
+  }
+
  private:
   Target target_host_;
   AnalysisResultMap context_analysis_map_;
   std::vector<LetList> scopes_;
+  // Per-scope memo of tensor -> bound shape-of result, popped with the scope.
+  std::vector<std::unordered_map<const Object*, Expr>> shape_of_caches_;
 
   runtime::DataType compute_dtype_ = runtime::DataType::Int(64);
   Device default_device_{kDLCPU, 0};
 };
 
+/*!
+ * \brief Rebind statically sized storages onto earlier dead storages.
+ *
+ * After DialectRewriter every tensor gets its own memory.alloc_storage, so the
+ * VM leans entirely on the runtime allocator for reuse. This planner mirrors
+ * the storage-token reuse of graph_plan_memory for the straight-line part of
+ * the A-normal form: a storage is a candidate when its size and alignment are
+ * constant and its single tensor is only ever consumed as a direct input or
+ * output of vm.invoke_tvm_op calls in the top-level let chain. Once such a
+ * tensor's last use has passed, a later alloc_storage with a structurally
+ * identical allocation request is rewritten to rebind the dead storage var
+ * instead of allocating. Tensors that reach any other construct (the function
+ * result, branches, closures, reshapes) are conservatively left untouched.
+ */
+class StorageReuser : private ExprVisitor {
+ public:
+  Function Reuse(Function func) {
+    if (!func->body.as<LetNode>()) {
+      return func;
+    }
+    // Flatten the top-level let chain.
+    Expr expr = func->body;
+    while (const auto* let = expr.as<LetNode>()) {
+      bindings_.emplace_back(let->var, let->value);
+      expr = let->body;
+    }
+    CollectUses(expr);
+    PlanRebinds();
+    if (rebinds_.empty()) {
+      return func;
+    }
+    Expr body = expr;
+    for (auto it = bindings_.rbegin(); it != bindings_.rend(); ++it) {
+      auto rit = rebinds_.find(it->first.get());
+      Expr value = rit == rebinds_.end() ? it->second : rit->second;
+      body = Let(it->first, value, body);
+    }
+    return Function(func->params, body, func->ret_type, func->type_params, func->attrs);
+  }
+
+ private:
+  struct UseInfo {
+    /*! \brief Index of the last safe use in the binding chain, -1 if unused. */
+    int last_use = -1;
+    /*! \brief Number of times the var feeds an alloc_tensor as its storage. */
+    int tensor_uses = 0;
+    /*! \brief Whether the var is referenced outside the tracked positions. */
+    bool escapes = false;
+  };
+
+  void CollectUses(const Expr& result) {
+    static const Op& invoke_op = Op::Get("vm.invoke_tvm_op");
+    static const Op& alloc_tensor_op = Op::Get("memory.alloc_tensor");
+    for (size_t i = 0; i < bindings_.size(); ++i) {
+      const Expr& value = bindings_[i].second;
+      const auto* call = value.as<CallNode>();
+      if (call != nullptr && call->op == alloc_tensor_op) {
+        if (const auto* storage_var = call->args[0].as<VarNode>()) {
+          ++uses_[storage_var].tensor_uses;
+        } else {
+          MarkEscapes(call->args[0]);
+        }
+        for (size_t k = 1; k < call->args.size(); ++k) {
+          MarkEscapes(call->args[k]);
+        }
+      } else if (call != nullptr && call->op == invoke_op) {
+        // Inputs and outputs are tuple literals of vars; uses here keep the
+        // tensor alive only up to this instruction.
+        for (size_t k = 1; k < call->args.size(); ++k) {
+          if (const auto* tuple = call->args[k].as<TupleNode>()) {
+            for (const Expr& field : tuple->fields) {
+              if (const auto* var = field.as<VarNode>()) {
+                uses_[var].last_use = static_cast<int>(i);
+              } else {
+                MarkEscapes(field);
+              }
+            }
+          } else {
+            MarkEscapes(call->args[k]);
+          }
+        }
+      } else {
+        MarkEscapes(value);
+      }
+    }
+    MarkEscapes(result);
+  }
+
+  void MarkEscapes(const Expr& expr) { VisitExpr(expr); }
+
+  void VisitExpr_(const VarNode* op) final { uses_[op].escapes = true; }
+
+  void PlanRebinds() {
+    static const Op& alloc_storage_op = Op::Get("memory.alloc_storage");
+    static const Op& alloc_tensor_op = Op::Get("memory.alloc_tensor");
+    // Storage var -> index of its alloc_storage binding.
+    std::unordered_map<const VarNode*, size_t> storage_defs;
+    // Dead storages available for rebinding, with the request they satisfy and
+    // the binding index after which they are free.
+    struct FreeStorage {
+      Var var;
+      Expr request;
+      int free_after;
+    };
+    std::vector<FreeStorage> free_list;
+    StructuralEqual structural_equal;
+
+    for (size_t i = 0; i < bindings_.size(); ++i) {
+      const Var& var = bindings_[i].first;
+      const Expr& value = bindings_[i].second;
+      const auto* call = value.as<CallNode>();
+      if (call == nullptr) continue;
+      if (call->op == alloc_storage_op) {
+        if (call->args[0].as<ConstantNode>() && call->args[1].as<ConstantNode>()) {
+          storage_defs[var.get()] = i;
+        }
+      } else if (call->op == alloc_tensor_op) {
+        const auto* storage_var = call->args[0].as<VarNode>();
+        if (storage_var == nullptr) continue;
+        auto def_it = storage_defs.find(storage_var);
+        if (def_it == storage_defs.end()) continue;
+        size_t def_index = def_it->second;
+        // The storage must feed exactly this tensor: one safe use at the
+        // alloc_tensor, nothing else.
+        UseInfo storage_use = uses_[storage_var];
+        UseInfo tensor_use = uses_[var.get()];
+        bool single_tensor =
+            !storage_use.escapes && storage_use.last_use == -1 && storage_use.tensor_uses == 1;
+        if (!single_tensor || tensor_use.escapes || tensor_use.last_use < 0) continue;
+        const Expr& request = bindings_[def_index].second;
+        // Prefer an already-dead storage with an identical request.
+        bool rebound = false;
+        for (FreeStorage& free : free_list) {
+          if (free.free_after < static_cast<int>(def_index) &&
+              structural_equal(free.request, request)) {
+            rebinds_[bindings_[def_index].first.get()] = free.var;
+            free.free_after = tensor_use.last_use;
+            rebound = true;
+            break;
+          }
+        }
+        if (!rebound) {
+          free_list.push_back(
+              FreeStorage{bindings_[def_index].first, request, tensor_use.last_use});
+        }
+      }
+    }
+  }
+
+  /*! \brief The top-level let chain as (var, value) pairs. */
+  std::vector<std::pair<Var, Expr>> bindings_;
+  /*! \brief Use information for every var referenced in the function. */
+  std::unordered_map<const VarNode*, UseInfo> uses_;
+  /*! \brief Replacement values for rebound alloc_storage bindings. */
+  std::unordered_map<const VarNode*, Expr> rebinds_;
+};
+
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ManifestAlloc.reuse_storage", Bool);
+
 Pass ManifestAlloc(Target target_host, Map<tvm::Integer, tvm::Target> targets) {
   CheckAndUpdateHostConsistency(&targets, &target_host);
   return tvm::transform::CreateModulePass(
@@ -412,12 +598,18 @@ Pass ManifestAlloc(Target target_host, Map<tvm::Integer, tvm::Target> targets) {
         }
         auto ca = ContextAnalysis(mod, fallback_dev);
 
+        bool reuse_storage =
+            pass_ctx->GetConfig<Bool>("relay.ManifestAlloc.reuse_storage", Bool(false)).value();
+
         auto glob_funcs = mod->functions;
         for (const auto& it : glob_funcs) {
           if (auto* func_node = it.second.as<FunctionNode>()) {
             auto func = GetRef<Function>(func_node);
             auto rewriter = DialectRewriter(target_host, ca);
             auto updated_func = rewriter.Rewrite(func);
+            if (reuse_storage) {
+              updated_func = StorageReuser().Reuse(updated_func);
+            }
 
             mod->Update(it.first, updated_func);
           }
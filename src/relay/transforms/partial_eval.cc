@@ -102,10 +102,22 @@
 
 namespace tvm {
 namespace relay {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.PartialEval.max_steps", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.PartialEval.max_function_growth", Integer);
+
 namespace partial_eval {
 
 using namespace runtime;
 
+/*! \brief The default number of evaluation steps a single function may take. */
+constexpr int64_t kDefaultMaxSteps = 1 << 18;
+/*! \brief The default bound on how many times a function may grow. */
+constexpr int64_t kDefaultMaxFunctionGrowth = 16;
+
+/*! \brief Thrown to abandon the specialization of the current function. */
+struct BudgetExhausted {};
+
 /*! \brief Hash Var by it's id.
  * Different VarNode might has same vid, and they are considered to be the same var in such case.
  * Use VarHash to hash Var by id.
@@ -594,6 +606,9 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
   PartialEvaluator(const IRModule& mod) : mod_(mod) {}
 
   PStatic VisitExpr(const Expr& e, LetList* ll) final {
+    if (steps_left_ >= 0 && --steps_left_ < 0) {
+      throw BudgetExhausted();
+    }
     PStatic ret = ExprFunctor<PStatic(const Expr&, LetList*)>::VisitExpr(e, ll);
     ICHECK(IsAtomic(ret->dynamic)) << ret->dynamic;
     return ret;
@@ -645,10 +660,26 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
       if (auto* n = base_func.as<FunctionNode>()) {
         Function func = GetRef<Function>(n);
         InitializeFuncId(func);
-        Func f = VisitFuncStatic(func, gv);
-        gv_map_.insert({gv, HasStatic(MkSFunc(f), gv)});
-        func = AsFunc(PostProcess(VisitFuncDynamic(func, f, gv)));
-        mod_->Update(gv, func);
+        // Each function gets its own step budget, so a callee specialized from
+        // inside another function cannot starve its caller. Specialization is
+        // abandoned - leaving the function as written - when the budget runs
+        // out or the result grows past the allowed factor, both of which guard
+        // against the exponential blowup possible on control-flow heavy code.
+        int64_t saved_steps = steps_left_;
+        steps_left_ = max_steps_;
+        try {
+          Func f = VisitFuncStatic(func, gv);
+          gv_map_.insert({gv, HasStatic(MkSFunc(f), gv)});
+          Function new_func = AsFunc(PostProcess(VisitFuncDynamic(func, f, gv)));
+          if (WithinGrowthBudget(func, new_func)) {
+            mod_->Update(gv, new_func);
+          }
+        } catch (const BudgetExhausted&) {
+          if (gv_map_.count(gv) == 0) {
+            gv_map_.insert({gv, NoStatic(gv)});
+          }
+        }
+        steps_left_ = saved_steps;
         return gv_map_.at(gv);
       } else {
         return NoStatic(gv);
@@ -657,6 +688,21 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
     return gv_map_.at(gv);
   }
 
+  bool WithinGrowthBudget(const Function& before, const Function& after) const {
+    if (max_function_growth_ < 0) {
+      return true;
+    }
+    // A small absolute slack keeps the factor from rejecting legitimate
+    // specializations of very small functions.
+    return CountNodes(after) <= CountNodes(before) * max_function_growth_ + 64;
+  }
+
+  static int64_t CountNodes(const Expr& e) {
+    int64_t count = 0;
+    PostOrderVisit(e, [&count](const Expr&) { ++count; });
+    return count;
+  }
+
   PStatic VisitExpr_(const GlobalVarNode* op, LetList* ll) final {
     return VisitGlobalVar(GetRef<GlobalVar>(op));
   }
@@ -904,13 +950,22 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
 
   // Constant evaluate an expression.
   PStatic ConstEvaluate(const Expr& expr, LetList* ll) {
+    if (use_eval_cache_) {
+      if (Optional<ObjectRef> cached = ConstEvalCacheLookup(expr)) {
+        return Reify(cached.value(), ll);
+      }
+    }
     std::vector<transform::Pass> passes = {transform::FuseOps(0), transform::InferType()};
     auto mod = IRModule::FromExpr(expr);
     auto seq = transform::Sequential(passes);
     mod = seq(mod);
     auto entry_func = Downcast<Function>(mod->Lookup("main"));
     auto fused_infered = expr.as<FunctionNode>() == nullptr ? entry_func->body : entry_func;
-    return Reify(executor_(fused_infered), ll);
+    ObjectRef value = executor_(fused_infered);
+    if (use_eval_cache_) {
+      ConstEvalCacheInsert(expr, value);
+    }
+    return Reify(value, ll);
   }
 
   Func ConstEvaluateFunc(const Expr& expr) {
@@ -1138,6 +1193,22 @@ class PartialEvaluator : public ExprFunctor<PStatic(const Expr& e, LetList* ll)>
   Store store_;
   Device device_ = CPUDevice();
   FInterpreter executor_ = CPUInterpreter();
+  // Whether evaluation results are shared through the process-wide cache.
+  bool use_eval_cache_ = transform::PassContext::Current()
+                             ->GetConfig<Bool>("relay.use_const_eval_cache", Bool(false))
+                             .value();
+  // Per-function budgets; a negative value disables the corresponding bound.
+  int64_t max_steps_ = transform::PassContext::Current()
+                           ->GetConfig("relay.PartialEval.max_steps", Integer(kDefaultMaxSteps))
+                           .value()
+                           ->value;
+  int64_t max_function_growth_ =
+      transform::PassContext::Current()
+          ->GetConfig("relay.PartialEval.max_function_growth", Integer(kDefaultMaxFunctionGrowth))
+          .value()
+          ->value;
+  // Steps remaining for the function currently being specialized.
+  int64_t steps_left_{-1};
 };
 
 /*! \brief Remap multiple Var sharing the same Id into the same Var. */
@@ -34,7 +34,10 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include "../../support/arena.h"
+#include "../../support/arena_map.h"
 #include "../analysis/dependency_graph.h"
 #include "let_list.h"
 
@@ -82,6 +85,27 @@ Type TypeSubst(const Type& type, const tvm::Map<TypeVar, Type>& subst_map);
  */
 Expr TypeSubst(const Expr& expr, const tvm::Map<TypeVar, Type>& subst_map);
 
+/*!
+ * \brief Look up the process-wide constant-evaluation result cache.
+ *
+ *  The cache is shared by every pass that evaluates closed constant
+ *  expressions through the interpreter (FoldConstant, PartialEval), keyed by
+ *  the structural hash of the expression, which covers constant tensor
+ *  contents. It is only populated when the relay.use_const_eval_cache pass
+ *  config is enabled, since entries pin evaluated tensors in host memory.
+ *
+ * \param expr The closed expression about to be evaluated.
+ * \return The previously evaluated runtime value, or NullOpt.
+ */
+Optional<ObjectRef> ConstEvalCacheLookup(const Expr& expr);
+
+/*!
+ * \brief Record an evaluation result in the constant-evaluation cache.
+ * \param expr The closed expression that was evaluated.
+ * \param result The runtime value it evaluated to.
+ */
+void ConstEvalCacheInsert(const Expr& expr, const ObjectRef& result);
+
 /*!
  * \brief Check if type is dynamic.
  * \param ty The type to be checked.
@@ -193,7 +217,6 @@ struct TreeBranchNode : TreeNode<ConditionObjectPtr> {
 
 struct ScopeNode;
 using Scope = std::shared_ptr<ScopeNode>;
-using NodeScopeMap = std::unordered_map<DependencyGraph::Node*, Scope>;
 using ExprSet = std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>;
 
 /* Invariant: when parent is null level is 0
@@ -202,6 +225,8 @@ using ExprSet = std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>;
 struct ScopeNode {
   // the level of the scope
   size_t level;
+  // unique id of the scope within one CalcScope run, used to key the LCA cache
+  size_t id = 0;
   // the parent scope
   Scope parent;
   // the corresponding let list which holds all let bindings in the scope
@@ -210,41 +235,115 @@ struct ScopeNode {
   ScopeNode() : level(0) {}
 };
 
+/*! \brief Dependency graph node -> Scope table backed by the pass arena.
+ *
+ *  The keys are arena-allocated graph nodes, so an open-addressing table on
+ *  raw pointers avoids the per-entry heap allocation an unordered_map would
+ *  pay for each of the graph's nodes; the scopes themselves are kept alive
+ *  in one growing vector.
+ */
+class NodeScopeMap {
+ public:
+  explicit NodeScopeMap(support::Arena* arena) : slots_(arena) {}
+
+  /*! \brief Return the scope assigned to a node, which must have one. */
+  const Scope& at(DependencyGraph::Node* node) {
+    const size_t* idx = slots_.Find(node);
+    ICHECK(idx != nullptr) << "node has not been assigned a scope";
+    return scopes_[*idx];
+  }
+
+  /*! \brief Assign a scope to a node, overwriting any previous assignment. */
+  void Set(DependencyGraph::Node* node, Scope scope) {
+    size_t* idx = slots_.Find(node);
+    if (idx != nullptr) {
+      scopes_[*idx] = std::move(scope);
+    } else {
+      slots_.Set(node, scopes_.size());
+      scopes_.push_back(std::move(scope));
+    }
+  }
+
+ private:
+  support::ArenaPointerMap<size_t> slots_;
+  std::vector<Scope> scopes_;
+};
+
 /*! \brief Calculate the scope of nodes in the dependency graph by least common ancestor.
  *
+ *  \param arena the arena backing the dependency graph, used for the scope table
  *  \param dg the input dependency graph
- *  \param expr_scope the output node -> scope mapping for all nodes.
- *  \param lifted_exprs the output set of expressions whose scope is lifted due to dependency
+ *  \return the node -> scope mapping for all nodes, and the set of expressions
+ *          whose scope is lifted due to dependency
  */
-std::pair<NodeScopeMap, ExprSet> CalcScope(const DependencyGraph& dg);
+std::pair<NodeScopeMap, ExprSet> CalcScope(support::Arena* arena, const DependencyGraph& dg);
 
 /*! \brief find the least common ancestor of lhs scope and rhs scope.
  */
 Scope LCA(Scope lhs, Scope rhs);
 
+/*! \brief An expr -> expr memo table for rewriting passes that already carry an arena.
+ *
+ *  Keys are stored as raw object pointers in an arena-backed open-addressing
+ *  table, so memoizing a subexpression costs no heap allocation; the results
+ *  are kept alive in a single growing vector instead of one map node each.
+ *  The memo does not retain its keys: the caller must keep the source
+ *  expression (e.g. through the dependency graph) alive for as long as the
+ *  memo is consulted.
+ */
+class ArenaExprMemo {
+ public:
+  explicit ArenaExprMemo(support::Arena* arena) : slots_(arena) {}
+
+  /*! \brief Return the memoized result for e, or nullptr if absent.
+   *  The pointer is invalidated by the next Set. */
+  const Expr* Find(const Expr& e) {
+    size_t* idx = slots_.Find(e.get());
+    return idx == nullptr ? nullptr : &results_[*idx];
+  }
+
+  /*! \brief Memoize result as the rewrite of e, overwriting any previous entry. */
+  void Set(const Expr& e, const Expr& result) {
+    size_t* idx = slots_.Find(e.get());
+    if (idx != nullptr) {
+      results_[*idx] = result;
+    } else {
+      slots_.Set(e.get(), results_.size());
+      results_.push_back(result);
+    }
+  }
+
+ private:
+  support::ArenaPointerMap<size_t> slots_;
+  std::vector<Expr> results_;
+};
+
 /* Special care is needed to handle local recursion.
  * Fill additionally take a (possibly null) Var argument,
  * If it is not null, Fill is required to bind the transformed result to that var.
  */
 class Fill : ExprFunctor<Expr(const Expr&, const Var&)> {
  public:
-  static Expr ToANormalForm(const Expr& e, const DependencyGraph& dg, NodeScopeMap* node_scope);
+  static Expr ToANormalForm(support::Arena* arena, const Expr& e, const DependencyGraph& dg,
+                            NodeScopeMap* node_scope);
 
   // For basic block normal form, bind expressions only if the original expression's
   // scope should be lifted
-  static Expr ToBasicBlockNormalForm(const Expr& e, const DependencyGraph& dg,
-                                     NodeScopeMap* node_scope, ExprSet* lifted);
+  static Expr ToBasicBlockNormalForm(support::Arena* arena, const Expr& e,
+                                     const DependencyGraph& dg, NodeScopeMap* node_scope,
+                                     ExprSet* lifted);
 
  private:
   const DependencyGraph& dg_;
   NodeScopeMap* node_scope_ = nullptr;
-  std::unordered_map<Expr, Expr, ObjectPtrHash, ObjectPtrEqual> memo;
+  ArenaExprMemo memo;
   // a set of Expressions to include for let bindings. If set to nullptr
   // all Exprs will be pushed to the let list.
   ExprSet* include_set_ = nullptr;
 
-  Fill(const DependencyGraph& dg, NodeScopeMap* node_scope, ExprSet* include_set)
-      : dg_(dg), node_scope_(node_scope), include_set_(include_set) {}
+  Fill(support::Arena* arena, const DependencyGraph& dg, NodeScopeMap* node_scope,
+       ExprSet* include_set)
+      : dg_(dg), node_scope_(node_scope), memo(arena), include_set_(include_set) {}
 
   Scope GetScope(const Expr& e);
   Scope GetSubScope(const Expr& e, size_t i);
@@ -24,7 +24,9 @@
 #include <tvm/relay/attrs/nn.h>
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op.h>
+#include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
+#include <tvm/runtime/registry.h>
 
 #include "pattern_utils.h"
 
@@ -178,15 +180,38 @@ Expr L2NormToInferUnpack(const Attrs attrs, Expr data) {
   return Divide(data, sqrt);
 }
 
+// The remaining normalization ops decompose through the FNormInferUnpack op
+// attribute, so new flavors only need to register it to participate in the
+// pass. batch_norm and dropout stay special-cased: both return tuples and
+// need the surrounding TupleGetItem rewritten as well.
+RELAY_REGISTER_OP("nn.layer_norm")
+    .set_attr<FNormInferUnpack>(
+        "FNormInferUnpack", [](const Attrs& attrs, const Array<Expr>& args, const Type& tdata) {
+          return LayerNormToInferUnpack(attrs, args[0], args[1], args[2], tdata);
+        });
+
+RELAY_REGISTER_OP("nn.group_norm")
+    .set_attr<FNormInferUnpack>(
+        "FNormInferUnpack", [](const Attrs& attrs, const Array<Expr>& args, const Type& tdata) {
+          return GroupNormToInferUnpack(attrs, args[0], args[1], args[2], tdata);
+        });
+
+RELAY_REGISTER_OP("nn.instance_norm")
+    .set_attr<FNormInferUnpack>(
+        "FNormInferUnpack", [](const Attrs& attrs, const Array<Expr>& args, const Type& tdata) {
+          return InstanceNormToInferUnpack(attrs, args[0], args[1], args[2], tdata);
+        });
+
+RELAY_REGISTER_OP("nn.l2_normalize")
+    .set_attr<FNormInferUnpack>(
+        "FNormInferUnpack", [](const Attrs& attrs, const Array<Expr>& args, const Type& tdata) {
+          return L2NormToInferUnpack(attrs, args[0]);
+        });
+
 class InferenceSimplifier : public ExprMutator {
  public:
   InferenceSimplifier()
-      : batch_norm_op_(Op::Get("nn.batch_norm")),
-        dropout_op_(Op::Get("nn.dropout")),
-        instance_norm_op_(Op::Get("nn.instance_norm")),
-        layer_norm_op_(Op::Get("nn.layer_norm")),
-        group_norm_op_(Op::Get("nn.group_norm")),
-        l2_norm_op_(Op::Get("nn.l2_normalize")) {}
+      : batch_norm_op_(Op::Get("nn.batch_norm")), dropout_op_(Op::Get("nn.dropout")) {}
 
   Expr VisitExpr_(const TupleGetItemNode* n) final {
     Expr new_e = ExprMutator::VisitExpr_(n);
@@ -206,24 +231,16 @@ class InferenceSimplifier : public ExprMutator {
   }
 
   Expr VisitExpr_(const CallNode* n) {
+    static const auto fnorm_unpack = Op::GetAttrMap<FNormInferUnpack>("FNormInferUnpack");
     auto new_n = ExprMutator::VisitExpr_(n);
     if (n->op == batch_norm_op_) {
       ty_map_[new_n.as<CallNode>()->args[0]] = n->args[0]->checked_type();
-    } else if (n->op == layer_norm_op_) {
-      const auto* call = new_n.as<CallNode>();
-      return LayerNormToInferUnpack(call->attrs, call->args[0], call->args[1], call->args[2],
-                                    n->args[0]->checked_type());
-    } else if (n->op == group_norm_op_) {
-      const auto* call = new_n.as<CallNode>();
-      return GroupNormToInferUnpack(call->attrs, call->args[0], call->args[1], call->args[2],
-                                    n->args[0]->checked_type());
-    } else if (n->op == instance_norm_op_) {
-      const auto* call = new_n.as<CallNode>();
-      return InstanceNormToInferUnpack(call->attrs, call->args[0], call->args[1], call->args[2],
-                                       n->args[0]->checked_type());
-    } else if (n->op == l2_norm_op_) {
-      const auto* call = new_n.as<CallNode>();
-      return L2NormToInferUnpack(call->attrs, call->args[0]);
+    } else if (const auto* op_node = n->op.as<OpNode>()) {
+      Op op = GetRef<Op>(op_node);
+      if (fnorm_unpack.count(op)) {
+        const auto* call = new_n.as<CallNode>();
+        return fnorm_unpack[op](call->attrs, call->args, n->args[0]->checked_type());
+      }
     }
     return new_n;
   }
@@ -234,10 +251,6 @@ class InferenceSimplifier : public ExprMutator {
   // reduced.
   const Op& batch_norm_op_;
   const Op& dropout_op_;
-  const Op& instance_norm_op_;
-  const Op& layer_norm_op_;
-  const Op& group_norm_op_;
-  const Op& l2_norm_op_;
   std::unordered_map<Expr, Type, ObjectPtrHash, ObjectPtrEqual> ty_map_;
 };
 
@@ -250,7 +263,19 @@ Pass SimplifyInference() {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(SimplifyInference(f));
       };
-  return CreateFunctionPass(pass_func, 0, "SimplifyInference", {"InferType"});
+  // Collect the interested ops from the registry so flavors registered by
+  // other translation units (or frontends) are included automatically.
+  Array<String> interested_ops{"nn.batch_norm", "nn.dropout"};
+  const auto fnorm_unpack = Op::GetAttrMap<FNormInferUnpack>("FNormInferUnpack");
+  const auto* list_ops = runtime::Registry::Get("ir.ListOpNames");
+  ICHECK(list_ops != nullptr);
+  Array<String> all_ops = (*list_ops)();
+  for (const String& name : all_ops) {
+    if (fnorm_unpack.count(Op::Get(name))) {
+      interested_ops.push_back(name);
+    }
+  }
+  return CreateFunctionPass(pass_func, 0, "SimplifyInference", {"InferType"}, interested_ops);
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.SimplifyInference").set_body_typed(SimplifyInference);
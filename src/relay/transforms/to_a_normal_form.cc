@@ -50,15 +50,42 @@ Scope LCA(Scope lhs, Scope rhs) {
   return lhs;
 }
 
-std::pair<NodeScopeMap, ExprSet> CalcScope(const DependencyGraph& dg) {
-  NodeScopeMap expr_scope;
-  ExprSet lifted_exprs;
-  std::unordered_map<DependencyGraph::Node*, Expr> node_to_expr;
-  for (auto expr_node : dg.expr_node) {
-    node_to_expr[expr_node.second] = expr_node.first;
+namespace {
+
+/*! \brief LCA memoized on the ids of the two scopes.
+ *
+ *  In a wide graph every user of a value folds the value's scope into its
+ *  own through LCA, so the same scope pairs come up over and over; caching
+ *  them replaces the repeated parent-chain walks with one hash lookup and
+ *  keeps scope determination linear in practice.
+ */
+class CachedLCA {
+ public:
+  Scope operator()(Scope lhs, Scope rhs) {
+    if (lhs == rhs) return lhs;
+    uint64_t key = lhs->id < rhs->id ? (static_cast<uint64_t>(lhs->id) << 32 | rhs->id)
+                                     : (static_cast<uint64_t>(rhs->id) << 32 | lhs->id);
+    auto it = cache_.find(key);
+    if (it != cache_.end()) return it->second;
+    Scope ret = LCA(std::move(lhs), std::move(rhs));
+    cache_.emplace(key, ret);
+    return ret;
   }
+
+ private:
+  std::unordered_map<uint64_t, Scope> cache_;
+};
+
+}  // namespace
+
+std::pair<NodeScopeMap, ExprSet> CalcScope(support::Arena* arena, const DependencyGraph& dg) {
+  NodeScopeMap expr_scope(arena);
+  ExprSet lifted_exprs;
+  CachedLCA lca;
+  size_t num_scopes = 0;
   bool global_scope_used = false;
   Scope global_scope = std::make_shared<ScopeNode>();
+  global_scope->id = num_scopes++;
 
   for (auto it = dg.post_dfs_order.rbegin(); it != dg.post_dfs_order.rend(); ++it) {
     DependencyGraph::Node* n = *it;
@@ -73,37 +100,36 @@ std::pair<NodeScopeMap, ExprSet> CalcScope(const DependencyGraph& dg) {
       const auto original_s = s;
       iit = iit->next;
       for (; iit != nullptr; iit = iit->next) {
-        s = LCA(s, expr_scope.at(iit->value));
+        s = lca(s, expr_scope.at(iit->value));
       }
-      if (s != original_s && node_to_expr.find(n) != node_to_expr.end()) {
-        // filter out exprs whose scope do not matter
-        Expr expr = node_to_expr[n];
-        if (!expr.as<OpNode>()) {
-          lifted_exprs.insert(expr);
-        }
+      // filter out exprs whose scope do not matter
+      if (s != original_s && n->expr != nullptr && !n->expr->IsInstance<OpNode>()) {
+        lifted_exprs.insert(GetRef<Expr>(n->expr));
       }
     }
     if (n->new_scope) {
       auto child_scope = std::make_shared<ScopeNode>(s);
-      expr_scope.insert({n, child_scope});
+      child_scope->id = num_scopes++;
+      expr_scope.Set(n, child_scope);
     } else {
-      expr_scope.insert({n, s});
+      expr_scope.Set(n, s);
     }
   }
   ICHECK(global_scope_used);
-  return std::make_pair(expr_scope, lifted_exprs);
+  return std::make_pair(std::move(expr_scope), std::move(lifted_exprs));
 }
 
-Expr Fill::ToANormalForm(const Expr& e, const DependencyGraph& dg, NodeScopeMap* node_scope) {
-  Fill fi(dg, node_scope, nullptr);
+Expr Fill::ToANormalForm(support::Arena* arena, const Expr& e, const DependencyGraph& dg,
+                         NodeScopeMap* node_scope) {
+  Fill fi(arena, dg, node_scope, nullptr);
   return fi.GetScope(e)->let_list->Get(fi.VisitExpr(e));
 }
 
 // For basic block normal form, bind expressions only if the original expression's scope
 // should be lifted
-Expr Fill::ToBasicBlockNormalForm(const Expr& e, const DependencyGraph& dg,
+Expr Fill::ToBasicBlockNormalForm(support::Arena* arena, const Expr& e, const DependencyGraph& dg,
                                   NodeScopeMap* node_scope, ExprSet* lifted) {
-  Fill fi(dg, node_scope, lifted);
+  Fill fi(arena, dg, node_scope, lifted);
   auto var = fi.VisitExpr(e);
   return fi.GetScope(e)->let_list->Get(var);
 }
@@ -123,12 +149,16 @@ Scope Fill::GetSubScope(const Expr& e, size_t i) {
 }
 
 Expr Fill::VisitExpr(const Expr& e, const Var& v) {
-  if (memo.count(e) == 0) {
-    memo.insert({e, ExprFunctor<Expr(const Expr&, const Var&)>::VisitExpr(e, v)});
-  } else if (v.defined()) {
-    GetScope(e)->let_list->Push(v, memo.at(e));
+  Expr ret;
+  if (const Expr* cached = memo.Find(e)) {
+    ret = *cached;
+    if (v.defined()) {
+      GetScope(e)->let_list->Push(v, ret);
+    }
+  } else {
+    ret = ExprFunctor<Expr(const Expr&, const Var&)>::VisitExpr(e, v);
+    memo.Set(e, ret);
   }
-  auto ret = memo.at(e);
   // if no include_set is specified, every expression should be atomic.
   if (include_set_ == nullptr) ICHECK(IsAtomic(ret));
   return ret;
@@ -252,20 +282,49 @@ Expr Fill::VisitExpr_(const MatchNode* m, const Var& v) {
   return Compound(e, Match(data, clauses, m->complete), v);
 }
 
+Expr ToANormalFormAux(support::Arena* arena, const Expr& e) {
+  /* When you lift a lambda, what is inside is also being lift.
+   *
+   * So we must determine the scope of the lambda before determining the scope of it's body.
+   *
+   * To make this more principled,
+   * we always determine the scope of parent before determining the scope of children.
+   *
+   * So we calculate all the dependency between nodes.
+   */
+  DependencyGraph dg = DependencyGraph::Create(arena, e);
+  /* In order to model new subscopes created by lambda, if else and pattern matching,
+   * we also assign scope to edge as well.
+   * The scope of an edge is either the parent's scope, or a new subscope of the parent's scope.
+   *
+   * So, the scope of the whole expr is global.
+   * The scope of any subexpr, is the lowest common ancestor of all incoming edge.
+   *
+   * Every scope additionally contain a LetList which collect all value of that scope.
+   * We do an additional pass to fill all the LetList and we are done.
+   */
+  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(arena, dg);
+  return Fill::ToANormalForm(arena, e, dg, &scopes.first);
+}
+
 IRModule ToANormalForm(const IRModule& m) {
   DLOG(INFO) << "ToANF:" << std::endl << m;
 
   tvm::Map<GlobalVar, Function> updates;
   auto funcs = m->functions;
+  // one arena serves every function: recycling it between functions reuses
+  // the pages the previous dependency graph and scope tables grew into.
+  support::Arena arena;
   for (const auto& it : funcs) {
     ICHECK_EQ(FreeVars(it.second).size(), 0);
     if (const auto* n = it.second.as<FunctionNode>()) {
       if (n->GetAttr<String>(attr::kCompiler).defined()) continue;
     }
-    Expr ret = TransformF([&](const Expr& e) { return transform::ToANormalForm(e); }, it.second);
+    Expr ret = TransformF([&](const Expr& e) { return ToANormalFormAux(&arena, e); }, it.second);
     ICHECK_EQ(FreeVars(ret).size(), 0)
         << AsText(ret) << "should not has free vars: " << FreeVars(ret);
     updates.Set(it.first, Downcast<Function>(ret));
+    arena.RecycleAll();
   }
 
   for (auto pair : updates) {
@@ -280,29 +339,8 @@ IRModule ToANormalForm(const IRModule& m) {
 namespace transform {
 
 Expr ToANormalForm(const Expr& e) {
-  /* When you lift a lambda, what is inside is also being lift.
-   *
-   * So we must determine the scope of the lambda before determining the scope of it's body.
-   *
-   * To make this more principled,
-   * we always determine the scope of parent before determining the scope of children.
-   *
-   * So we calculate all the dependency between nodes.
-   */
   support::Arena arena;
-  DependencyGraph dg = DependencyGraph::Create(&arena, e);
-  /* In order to model new subscopes created by lambda, if else and pattern matching,
-   * we also assign scope to edge as well.
-   * The scope of an edge is either the parent's scope, or a new subscope of the parent's scope.
-   *
-   * So, the scope of the whole expr is global.
-   * The scope of any subexpr, is the lowest common ancestor of all incoming edge.
-   *
-   * Every scope additionally contain a LetList which collect all value of that scope.
-   * We do an additional pass to fill all the LetList and we are done.
-   */
-  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(dg);
-  return Fill::ToANormalForm(e, dg, &scopes.first);
+  return ToANormalFormAux(&arena, e);
 }
 
 Pass ToANormalForm() {
@@ -36,16 +36,15 @@
 namespace tvm {
 namespace relay {
 
-Expr ToBasicBlockNormalFormAux(const Expr& e) {
+Expr ToBasicBlockNormalFormAux(support::Arena* arena, const Expr& e) {
   // calculate all the dependency between nodes.
-  support::Arena arena;
-  DependencyGraph dg = DependencyGraph::Create(&arena, e);
+  DependencyGraph dg = DependencyGraph::Create(arena, e);
   /* The scope of the whole expr is global.
    * The scope of any subexpr, is the lowest common ancestor of all incoming edge.
    * We also record the set of expressions whose scope is lifted.
    */
-  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(dg);
-  return Fill::ToBasicBlockNormalForm(e, dg, &scopes.first, &scopes.second);
+  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(arena, dg);
+  return Fill::ToBasicBlockNormalForm(arena, e, dg, &scopes.first, &scopes.second);
 }
 
 IRModule ToBasicBlockNormalForm(const IRModule& mod) {
@@ -53,13 +52,18 @@ IRModule ToBasicBlockNormalForm(const IRModule& mod) {
 
   tvm::Map<GlobalVar, Function> updates;
   auto funcs = mod->functions;
+  // one arena serves every function: recycling it between functions reuses
+  // the pages the previous dependency graph and scope tables grew into.
+  support::Arena arena;
   for (const auto& it : funcs) {
     ICHECK_EQ(FreeVars(it.second).size(), 0) << "Expected no free variables";
     if (const auto* n = it.second.as<FunctionNode>()) {
       if (n->GetAttr<String>(attr::kCompiler).defined()) continue;
     }
-    Expr ret = TransformF([&](const Expr& e) { return ToBasicBlockNormalFormAux(e); }, it.second);
+    Expr ret = TransformF(
+        [&](const Expr& e) { return ToBasicBlockNormalFormAux(&arena, e); }, it.second);
     updates.Set(it.first, Downcast<Function>(ret));
+    arena.RecycleAll();
   }
 
   for (auto pair : updates) {
@@ -75,7 +79,7 @@ bool BasicBlockNormalFormCheck(const Expr& e) {
   // calculate all the dependency between nodes.
   support::Arena arena;
   DependencyGraph dg = DependencyGraph::Create(&arena, e);
-  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(dg);
+  std::pair<NodeScopeMap, ExprSet> scopes = CalcScope(&arena, dg);
   for (auto expr : scopes.second) {
     LOG(FATAL) << "The expression below violates the basic block normal form in that "
                << "its scope should be lifted:\n"
@@ -0,0 +1,333 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/to_mixed_precision.cc
+ * \brief Automatic fp32 -> reduced precision conversion with fp32 islands.
+ *
+ * Operators fall into three classes: compute-bound ops (conv, dense,
+ * batch_matmul) are always converted and accumulate in fp32 through their
+ * out_dtype attribute; elementwise and injective ops follow the precision of
+ * their inputs so converted regions grow without extra casts; numerically
+ * sensitive ops (softmax, exp, reductions, ...) and everything else stay in
+ * fp32, with casts inserted around them to form fp32 islands. The function
+ * signature is preserved: parameters keep their dtypes and the output is cast
+ * back to its original type.
+ *
+ * The defaults can be overridden per op through the TMixedPrecisionPolicy
+ * integer attribute (0 = never, 1 = follow, 2 = always), through the
+ * relay.ToMixedPrecision.skip_ops pass config (ops forced to fp32, the knob a
+ * calibration loop flips when a model loses accuracy), or globally through a
+ * packed function registered as relay.transform.mixed_precision_op_policy
+ * taking an op name and returning a policy (-1 to defer to the defaults).
+ */
+
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/op_attr_types.h>
+#include <tvm/relay/transform.h>
+#include <tvm/runtime/registry.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "pattern_utils.h"
+
+namespace tvm {
+namespace relay {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.ToMixedPrecision.skip_ops", Array<String>);
+
+namespace {
+
+/*! \brief How an operator participates in mixed precision execution. */
+enum class MixedPolicy : int {
+  /*! \brief Run in fp32; cast reduced-precision inputs back up. */
+  kNever = 0,
+  /*! \brief Run in reduced precision when any input already is. */
+  kFollow = 1,
+  /*! \brief Always run in reduced precision. */
+  kAlways = 2,
+};
+
+class MixedPrecisionRewriter : public MixedModeMutator {
+ public:
+  MixedPrecisionRewriter(DataType mixed_dtype, const Array<String>& skip_ops)
+      : mixed_dtype_(mixed_dtype), cast_op_(Op::Get("cast")) {
+    for (const String& name : skip_ops) {
+      skip_ops_.insert(name);
+    }
+  }
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) final {
+    const auto* call = post.as<CallNode>();
+    const auto* op_node = call->op.as<OpNode>();
+    if (op_node == nullptr) {
+      return post;
+    }
+    Op op = GetRef<Op>(op_node);
+    // Explicit casts fix their own output dtype; leave them alone.
+    if (op == cast_op_) {
+      return post;
+    }
+    switch (GetPolicy(op)) {
+      case MixedPolicy::kAlways:
+        return RewriteAlways(pre, call);
+      case MixedPolicy::kFollow:
+        return RewriteFollow(pre, call);
+      case MixedPolicy::kNever:
+      default:
+        return RewriteNever(pre, call);
+    }
+  }
+
+  /*! \brief Cast the rewritten body back to the function's original type. */
+  Expr RestoreOutputDtype(const Expr& pre_body, const Expr& new_body) {
+    const auto* pre_tuple = pre_body.as<TupleNode>();
+    const auto* new_tuple = new_body.as<TupleNode>();
+    if (pre_tuple && new_tuple) {
+      Array<Expr> fields;
+      bool changed = false;
+      for (size_t i = 0; i < pre_tuple->fields.size(); ++i) {
+        Expr field = RestoreOutputDtype(pre_tuple->fields[i], new_tuple->fields[i]);
+        changed |= !field.same_as(new_tuple->fields[i]);
+        fields.push_back(field);
+      }
+      return changed ? Tuple(fields) : new_body;
+    }
+    const auto* ttype = pre_body->checked_type().as<TensorTypeNode>();
+    if (ttype && CurrentDtype(pre_body) != ttype->dtype) {
+      return Cast(new_body, ttype->dtype);
+    }
+    return new_body;
+  }
+
+ private:
+  MixedPolicy GetPolicy(const Op& op) const {
+    if (skip_ops_.count(op->name)) {
+      return MixedPolicy::kNever;
+    }
+    // A registered policy hook (e.g. driven by a calibration loop) overrides
+    // everything; -1 defers to the defaults below.
+    static const runtime::PackedFunc* fhook =
+        runtime::Registry::Get("relay.transform.mixed_precision_op_policy");
+    if (fhook != nullptr) {
+      int policy = (*fhook)(op->name);
+      if (policy >= 0) {
+        return static_cast<MixedPolicy>(policy);
+      }
+    }
+    if (Op::HasAttrMap("TMixedPrecisionPolicy")) {
+      auto policy_map = Op::GetAttrMap<Integer>("TMixedPrecisionPolicy");
+      if (policy_map.count(op)) {
+        return static_cast<MixedPolicy>(policy_map[op]->value);
+      }
+    }
+    static const std::unordered_set<std::string> always_ops = {
+        "nn.conv2d", "nn.conv3d", "nn.conv2d_transpose", "nn.dense", "nn.batch_matmul"};
+    if (always_ops.count(op->name)) {
+      return MixedPolicy::kAlways;
+    }
+    static const std::unordered_set<std::string> never_ops = {
+        "nn.softmax", "nn.log_softmax", "exp",      "log",          "power",
+        "erf",        "sum",            "mean",     "variance",     "prod",
+        "nn.l2_normalize"};
+    if (never_ops.count(op->name)) {
+      return MixedPolicy::kNever;
+    }
+    static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+    return fpattern.get(op, kOpaque) <= kInjective ? MixedPolicy::kFollow : MixedPolicy::kNever;
+  }
+
+  // The dtype an argument has after rewriting, defaulting to its checked type.
+  DataType CurrentDtype(const Expr& pre_arg) const {
+    auto it = new_dtype_.find(pre_arg.get());
+    if (it != new_dtype_.end()) {
+      return it->second;
+    }
+    const auto* ttype = pre_arg->checked_type_.defined()
+                            ? pre_arg->checked_type().as<TensorTypeNode>()
+                            : nullptr;
+    return ttype ? ttype->dtype : DataType::Void();
+  }
+
+  bool IsConvertible(DataType dtype) const {
+    return dtype == DataType::Float(32) || dtype == mixed_dtype_;
+  }
+
+  // Cast a rewritten argument (tensor or tuple literal) to the given dtype,
+  // touching only convertible float tensors.
+  Expr CastArg(const Expr& pre_arg, const Expr& post_arg, DataType dtype) {
+    const auto* pre_tuple = pre_arg.as<TupleNode>();
+    const auto* post_tuple = post_arg.as<TupleNode>();
+    if (pre_tuple && post_tuple) {
+      Array<Expr> fields;
+      bool changed = false;
+      for (size_t i = 0; i < pre_tuple->fields.size(); ++i) {
+        Expr field = CastArg(pre_tuple->fields[i], post_tuple->fields[i], dtype);
+        changed |= !field.same_as(post_tuple->fields[i]);
+        fields.push_back(field);
+      }
+      return changed ? Tuple(fields) : post_arg;
+    }
+    DataType current = CurrentDtype(pre_arg);
+    if (IsConvertible(current) && current != dtype) {
+      return Cast(post_arg, dtype);
+    }
+    return post_arg;
+  }
+
+  // Whether any rewritten argument already carries the reduced precision.
+  bool AnyMixedArg(const CallNode* pre) const {
+    for (const Expr& arg : pre->args) {
+      if (const auto* tuple = arg.as<TupleNode>()) {
+        for (const Expr& field : tuple->fields) {
+          if (CurrentDtype(field) == mixed_dtype_) return true;
+        }
+      } else if (CurrentDtype(arg) == mixed_dtype_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Array<Expr> CastArgs(const CallNode* pre, const CallNode* post, DataType dtype, bool* changed) {
+    Array<Expr> new_args;
+    for (size_t i = 0; i < post->args.size(); ++i) {
+      Expr new_arg = CastArg(pre->args[i], post->args[i], dtype);
+      *changed |= !new_arg.same_as(post->args[i]);
+      new_args.push_back(new_arg);
+    }
+    return new_args;
+  }
+
+  // For ops with an out_dtype attribute, pin accumulation to fp32 so the
+  // reduced-precision inputs do not degrade long reductions.
+  Attrs AccumulateInFp32(const Attrs& attrs, bool* accumulates_fp32) const {
+    *accumulates_fp32 = false;
+    if (const auto* conv2d = attrs.as<Conv2DAttrs>()) {
+      return CopyWithOutDtype(conv2d, accumulates_fp32);
+    } else if (const auto* conv3d = attrs.as<Conv3DAttrs>()) {
+      return CopyWithOutDtype(conv3d, accumulates_fp32);
+    } else if (const auto* conv2d_t = attrs.as<Conv2DTransposeAttrs>()) {
+      return CopyWithOutDtype(conv2d_t, accumulates_fp32);
+    } else if (const auto* dense = attrs.as<DenseAttrs>()) {
+      return CopyWithOutDtype(dense, accumulates_fp32);
+    } else if (const auto* matmul = attrs.as<BatchMatmulAttrs>()) {
+      return CopyWithOutDtype(matmul, accumulates_fp32);
+    }
+    return attrs;
+  }
+
+  template <typename AttrsType>
+  Attrs CopyWithOutDtype(const AttrsType* attrs, bool* accumulates_fp32) const {
+    auto n = make_object<AttrsType>(*attrs);
+    n->out_dtype = DataType::Float(32);
+    *accumulates_fp32 = true;
+    return Attrs(n);
+  }
+
+  Expr RewriteAlways(const CallNode* pre, const CallNode* post) {
+    const auto* ttype = pre->checked_type().as<TensorTypeNode>();
+    // Only fp32 single-tensor results are converted; an explicit out_dtype
+    // means the model already manages its own precision here.
+    if (ttype == nullptr || ttype->dtype != DataType::Float(32) || OutDtypeIsSet(post->attrs)) {
+      return RewriteNever(pre, post);
+    }
+    bool changed = false;
+    Array<Expr> new_args = CastArgs(pre, post, mixed_dtype_, &changed);
+    bool accumulates_fp32 = false;
+    Attrs new_attrs = AccumulateInFp32(post->attrs, &accumulates_fp32);
+    Expr result = Call(post->op, new_args, new_attrs, post->type_args, post->span);
+    if (accumulates_fp32) {
+      result = Cast(result, mixed_dtype_);
+    }
+    new_dtype_[pre] = mixed_dtype_;
+    return result;
+  }
+
+  Expr RewriteFollow(const CallNode* pre, const CallNode* post) {
+    const auto* ttype = pre->checked_type().as<TensorTypeNode>();
+    if (ttype == nullptr || ttype->dtype != DataType::Float(32) || !AnyMixedArg(pre)) {
+      return RewriteNever(pre, post);
+    }
+    bool changed = false;
+    Array<Expr> new_args = CastArgs(pre, post, mixed_dtype_, &changed);
+    new_dtype_[pre] = mixed_dtype_;
+    if (!changed) {
+      return GetRef<Expr>(post);
+    }
+    return Call(post->op, new_args, post->attrs, post->type_args, post->span);
+  }
+
+  Expr RewriteNever(const CallNode* pre, const CallNode* post) {
+    bool changed = false;
+    Array<Expr> new_args = CastArgs(pre, post, DataType::Float(32), &changed);
+    if (!changed) {
+      return GetRef<Expr>(post);
+    }
+    return Call(post->op, new_args, post->attrs, post->type_args, post->span);
+  }
+
+  bool OutDtypeIsSet(const Attrs& attrs) const {
+    if (const auto* conv2d = attrs.as<Conv2DAttrs>()) return conv2d->out_dtype.bits() != 0;
+    if (const auto* conv3d = attrs.as<Conv3DAttrs>()) return conv3d->out_dtype.bits() != 0;
+    if (const auto* conv2d_t = attrs.as<Conv2DTransposeAttrs>())
+      return conv2d_t->out_dtype.bits() != 0;
+    if (const auto* dense = attrs.as<DenseAttrs>()) return dense->out_dtype.bits() != 0;
+    if (const auto* matmul = attrs.as<BatchMatmulAttrs>()) return matmul->out_dtype.bits() != 0;
+    return false;
+  }
+
+  DataType mixed_dtype_;
+  const Op& cast_op_;
+  std::unordered_set<std::string> skip_ops_;
+  // Result dtype of rewritten nodes, keyed by the pre-rewrite node; nodes
+  // whose dtype is unchanged are absent.
+  std::unordered_map<const Object*, DataType> new_dtype_;
+};
+
+}  // namespace
+
+namespace transform {
+
+Pass ToMixedPrecision(DataType mixed_dtype) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        Array<String> skip_ops =
+            pc->GetConfig("relay.ToMixedPrecision.skip_ops", Array<String>()).value();
+        MixedPrecisionRewriter rewriter(mixed_dtype, skip_ops);
+        Expr new_body = rewriter.Mutate(f->body);
+        new_body = rewriter.RestoreOutputDtype(f->body, new_body);
+        if (new_body.same_as(f->body)) {
+          return f;
+        }
+        return Function(f->params, new_body, f->ret_type, f->type_params, f->attrs);
+      };
+  return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.ToMixedPrecision").set_body_typed(ToMixedPrecision);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
@@ -45,6 +45,10 @@
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "../analysis/type_solver.h"
 #include "pass_utils.h"
 
@@ -809,8 +813,57 @@ void AddGlobalTypes(IRModule mod) {
   }
 }
 
+/*!
+ * \brief Find the functions whose types must be re-solved.
+ *
+ *  A function is dirty when any of its sub-expressions misses a checked type,
+ *  which is how mutating passes leave the nodes they rebuild. Dirtiness then
+ *  propagates to every (transitive) caller, since a changed function may
+ *  change the type observed at its call sites. Functions outside the returned
+ *  set, together with all of their dependencies, still carry the types of the
+ *  previous inference run.
+ *
+ * \param mod The module before inference.
+ * \return The global vars of the functions that must be re-inferred.
+ */
+std::unordered_set<const GlobalVarNode*> DirtyFunctions(const IRModule& mod) {
+  std::unordered_set<const GlobalVarNode*> dirty;
+  // Map from a function to the functions whose bodies reference it.
+  std::unordered_map<const GlobalVarNode*, std::vector<const GlobalVarNode*>> callers;
+  std::vector<const GlobalVarNode*> worklist;
+  for (const auto& it : mod->functions) {
+    if (auto* func_node = it.second.as<FunctionNode>()) {
+      auto func = GetRef<Function>(func_node);
+      bool complete = func->checked_type_.defined();
+      PostOrderVisit(func, [&](const Expr& e) {
+        // Ops and constructors carry no checked type, see AllCheckTypePopulated.
+        if (!e->checked_type_.defined() && !e.as<OpNode>() && !e.as<ConstructorNode>()) {
+          complete = false;
+        }
+        if (const auto* gv = e.as<GlobalVarNode>()) {
+          callers[gv].push_back(it.first.get());
+        }
+      });
+      if (!complete) worklist.push_back(it.first.get());
+    }
+  }
+  while (!worklist.empty()) {
+    const GlobalVarNode* gv = worklist.back();
+    worklist.pop_back();
+    if (!dirty.insert(gv).second) continue;
+    auto it = callers.find(gv);
+    if (it == callers.end()) continue;
+    for (const GlobalVarNode* caller : it->second) {
+      if (!dirty.count(caller)) worklist.push_back(caller);
+    }
+  }
+  return dirty;
+}
+
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.incremental_type_infer", Bool);
+
 Pass InferType() {
   auto pass_info = PassInfo(0, "InferType", {});
   return tvm::transform::CreateModulePass(
@@ -822,6 +875,17 @@ Pass InferType() {
 
         pass_ctx->diag_ctx = DiagnosticContext::Default(updated_mod);
 
+        // Only re-solve functions whose bodies or dependencies changed since
+        // the last run. Type definitions are not tracked by the dirty bits,
+        // so modules that use them always take the full path.
+        bool incremental =
+            pass_ctx->GetConfig<Bool>("relay.incremental_type_infer", Bool(false)).value() &&
+            mod->type_definitions.empty();
+        std::unordered_set<const GlobalVarNode*> dirty;
+        if (incremental) {
+          dirty = DirtyFunctions(updated_mod);
+        }
+
         // Add all the type annotations to the functions in the model.
         AddGlobalTypes(mod);
 
@@ -836,10 +900,12 @@ Pass InferType() {
           if (auto* func_node = it.second.as<FunctionNode>()) {
             auto func = GetRef<Function>(func_node);
 
-            // // If a function already has type information we can skip checking it.
-            // if (func->checked_type_.defined()) {
-            //   continue;
-            // }
+            // The function and everything it depends on are fully typed
+            // already; keep the result of the previous inference run.
+            if (incremental && !dirty.count(it.first.get())) {
+              it.first->checked_type_ = func->checked_type();
+              continue;
+            }
 
             // TODO(@jroesch): we should be able to move the type inferencer outside
             // of this function but it seems to be more stateful then I expect.
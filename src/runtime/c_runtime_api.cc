@@ -192,6 +192,8 @@ void DeviceAPI::FreeWorkspace(Device dev, void* ptr) { FreeDataSpace(dev, ptr);
 
 TVMStreamHandle DeviceAPI::CreateStream(Device dev) { return nullptr; }
 
+TVMStreamHandle DeviceAPI::CreateStream(Device dev, int priority) { return CreateStream(dev); }
+
 void DeviceAPI::FreeStream(Device dev, TVMStreamHandle stream) {}
 
 void DeviceAPI::SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) {
@@ -645,3 +647,16 @@ TVM_REGISTER_GLOBAL("runtime.GetDeviceAttr").set_body([](TVMArgs args, TVMRetVal
 });
 
 TVM_REGISTER_GLOBAL("runtime.TVMSetStream").set_body_typed(TVMSetStream);
+
+TVM_REGISTER_GLOBAL("runtime.TVMStreamCreate")
+    .set_body_typed([](int device_type, int device_id, int priority) -> void* {
+      DLDevice dev;
+      dev.device_type = static_cast<DLDeviceType>(device_type);
+      dev.device_id = device_id;
+      return DeviceAPIManager::Get(dev)->CreateStream(dev, priority);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.TVMStreamFree").set_body_typed(TVMStreamFree);
+
+TVM_REGISTER_GLOBAL("runtime.TVMStreamStreamSynchronize")
+    .set_body_typed(TVMStreamStreamSynchronize);
@@ -26,9 +26,32 @@
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/registry.h>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 namespace tvm {
 namespace runtime {
 
+String String::Intern(const std::string& content) {
+  struct InternTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, String> table;
+  };
+  // Leaked intentionally: interned strings may be referenced from other
+  // static-lifetime objects whose destruction order is unspecified.
+  static InternTable* intern_table = new InternTable();
+  std::lock_guard<std::mutex> lock(intern_table->mutex);
+  auto it = intern_table->table.find(content);
+  if (it != intern_table->table.end()) {
+    return it->second;
+  }
+  String canonical(content);
+  intern_table->table.emplace(content, canonical);
+  return canonical;
+}
+
 TVM_REGISTER_GLOBAL("runtime.GetADTTag").set_body([](TVMArgs args, TVMRetValue* rv) {
   ObjectRef obj = args[0];
   const auto& adt = Downcast<ADT>(obj);
@@ -44,7 +44,12 @@ typedef dmlc::ThreadLocalStore<CuBlasThreadEntry> CuBlasThreadStore;
 CuBlasThreadEntry* CuBlasThreadEntry::ThreadLocal() {
   auto stream = runtime::CUDAThreadEntry::ThreadLocal()->stream;
   CuBlasThreadEntry* retval = CuBlasThreadStore::Get();
-  CHECK_CUBLAS_ERROR(cublasSetStream(retval->handle, static_cast<cudaStream_t>(stream)));
+  // rebinding the stream on every call costs a cuBLAS dispatch; only do it
+  // when the thread's stream actually changed.
+  if (retval->bound_stream != static_cast<void*>(stream)) {
+    CHECK_CUBLAS_ERROR(cublasSetStream(retval->handle, static_cast<cudaStream_t>(stream)));
+    retval->bound_stream = static_cast<void*>(stream);
+  }
   return retval;
 }
 
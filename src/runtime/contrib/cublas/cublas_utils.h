@@ -74,6 +74,8 @@ struct CuBlasThreadEntry {
   CuBlasThreadEntry();
   ~CuBlasThreadEntry();
   cublasHandle_t handle{nullptr};
+  /*! \brief the stream currently bound to the handle, to skip redundant rebinds */
+  void* bound_stream{nullptr};
   static CuBlasThreadEntry* ThreadLocal();
 };  // CuBlasThreadEntry
 
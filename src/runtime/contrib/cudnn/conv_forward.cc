@@ -24,6 +24,11 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
 #include "cudnn_utils.h"
 
 namespace tvm {
@@ -192,6 +197,33 @@ void OutputShape(int format, int dims, int groups, const int pad[], const int st
 void FindAlgo(int format, int dims, int groups, const int pad[], const int stride[],
               const int dilation[], const int x_dim[], const int w_dim[], const int y_dim[],
               const std::string& data_dtype, const std::string& conv_dtype, TVMRetValue* ret) {
+  // Finding an algorithm benchmarks every candidate and is by far the most
+  // expensive part of setting up a cudnn conv. Identical workloads recur
+  // across layers and across repeated compilations of the same model, so the
+  // chosen algorithm is cached process-wide keyed on the workload signature.
+  static std::mutex algo_cache_mutex;
+  static std::unordered_map<std::string, int> algo_cache;
+
+  int device_id;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  std::ostringstream key;
+  key << device_id << "-" << format << "-" << dims << "-" << groups << "-" << data_dtype << "-"
+      << conv_dtype;
+  for (int i = 0; i < dims; ++i) {
+    key << "-" << pad[i] << "x" << stride[i] << "x" << dilation[i];
+  }
+  for (int i = 0; i < dims + 2; ++i) {
+    key << "-" << x_dim[i] << "x" << w_dim[i] << "x" << y_dim[i];
+  }
+  {
+    std::lock_guard<std::mutex> guard(algo_cache_mutex);
+    auto it = algo_cache.find(key.str());
+    if (it != algo_cache.end()) {
+      ret[0] = it->second;
+      return;
+    }
+  }
+
   CuDNNThreadEntry* entry_ptr = CuDNNThreadEntry::ThreadLocal();
 
   // Set Data Type
@@ -250,6 +282,10 @@ void FindAlgo(int format, int dims, int groups, const int pad[], const int strid
               << ", Memory: " << perf_results[i].memory;
   }
 
+  {
+    std::lock_guard<std::mutex> guard(algo_cache_mutex);
+    algo_cache[key.str()] = static_cast<int>(best_algo);
+  }
   ret[0] = best_algo;
 }
 
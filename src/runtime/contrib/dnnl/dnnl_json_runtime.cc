@@ -27,6 +27,7 @@
 
 #include <cstddef>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "../json/json_node.h"
@@ -40,6 +41,24 @@ namespace contrib {
 using namespace tvm::runtime;
 using namespace tvm::runtime::json;
 
+/*!
+ * \brief Process-wide DNNL engine and stream.
+ *
+ * A partitioned model instantiates one runtime module per subgraph; giving
+ * each of them a private engine/stream makes every partition pay engine
+ * construction and keeps their primitives on separate streams. All modules
+ * therefore share a single CPU engine and stream.
+ */
+dnnl::engine& GlobalCPUEngine() {
+  static dnnl::engine engine(dnnl::engine::kind::cpu, 0);
+  return engine;
+}
+
+dnnl::stream& GlobalCPUStream() {
+  static dnnl::stream stream(GlobalCPUEngine());
+  return stream;
+}
+
 class DNNLJSONRuntime : public JSONRuntimeBase {
   using tag = dnnl::memory::format_tag;
   using dt = dnnl::memory::data_type;
@@ -62,14 +81,31 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   }
 
   void Run() override {
-    // Fill in the input buffers.
+    // Bind the input buffers. All entries are bound to plain (non-blocked)
+    // layouts, so instead of copying into engine-owned buffers we hand the
+    // caller's DLTensor data pointer to the DNNL memory and let the engine
+    // read it in place. Entries carrying a non-zero offset alias the interior
+    // of another memory (batch-norm scale/shift) and still take the copy path.
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto eid = EntryID(input_nodes_[i], 0);
       // TODO(@comaniac): Support other data lengths.
       size_t offset_in_bytes = entry_out_mem_[eid].second * 4;
-      size_t buffer_size = GetDataSize(*data_entry_[eid]);
-      write_to_dnnl_memory(data_entry_[eid]->data, entry_out_mem_[eid].first, buffer_size,
-                           offset_in_bytes);
+      if (offset_in_bytes == 0 && !copy_only_eid_.count(eid)) {
+        entry_out_mem_[eid].first.set_data_handle(data_entry_[eid]->data);
+      } else {
+        size_t buffer_size = GetDataSize(*data_entry_[eid]);
+        write_to_dnnl_memory(data_entry_[eid]->data, entry_out_mem_[eid].first, buffer_size,
+                             offset_in_bytes);
+      }
+    }
+
+    // Point the output memories at the caller's buffers so results are
+    // produced in place rather than copied out afterwards.
+    for (size_t i = 0; i < outputs_.size(); ++i) {
+      auto eid = EntryID(outputs_[i]);
+      if (entry_out_mem_[eid].second == 0 && !copy_only_eid_.count(eid)) {
+        entry_out_mem_[eid].first.set_data_handle(data_entry_[eid]->data);
+      }
     }
 
     // Invoke the engine through intepreting the stream.
@@ -78,10 +114,11 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     }
     stream_.wait();
 
-    // Read output buffers.
+    // Copy out the outputs that could not be bound in place.
     for (size_t i = 0; i < outputs_.size(); ++i) {
       auto eid = EntryID(outputs_[i]);
       size_t offset_in_bytes = entry_out_mem_[eid].second * 4;
+      if (offset_in_bytes == 0 && !copy_only_eid_.count(eid)) continue;
       size_t buffer_size = GetDataSize(*data_entry_[eid]);
       read_from_dnnl_memory(data_entry_[eid]->data, entry_out_mem_[eid].first, buffer_size,
                             offset_in_bytes);
@@ -91,8 +128,8 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
  private:
   // Build up the engine based on the input graph.
   void BuildEngine() {
-    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
-    stream_ = dnnl::stream(engine_);
+    engine_ = GlobalCPUEngine();
+    stream_ = GlobalCPUStream();
 
     // Build subgraph engine.
     for (size_t nid = 0; nid < nodes_.size(); ++nid) {
@@ -119,6 +156,19 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
         }
       }
     }
+
+    // An entry whose DNNL memory is shared with another entry at a non-zero
+    // offset owns the storage for both; rebinding it to a caller buffer would
+    // make the aliased copy write out of bounds, so such entries keep the
+    // copy-based path.
+    for (const auto& kv : entry_out_mem_) {
+      if (kv.second.second == 0) continue;
+      for (const auto& other : entry_out_mem_) {
+        if (other.second.first == kv.second.first) {
+          copy_only_eid_.insert(other.first);
+        }
+      }
+    }
   }
 
   // Bind a JSON graph node entry to a DNNL memory.
@@ -437,6 +487,8 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   std::vector<std::unordered_map<int, dnnl::memory>> net_args_;
   /* The entry ID to its corresponding output memory. */
   std::unordered_map<uint32_t, std::pair<dnnl::memory, size_t>> entry_out_mem_;
+  /* Entries that must go through the copy-based data path. */
+  std::unordered_set<uint32_t> copy_only_eid_;
 };
 
 runtime::Module DNNLJSONRuntimeCreate(String symbol_name, String graph_json,
@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file Fused embedding-table lookup kernels.
+ *
+ * Gathering embedding rows is bound by TLB and cache misses: the indices are
+ * effectively random, so every row is a fresh miss and the naive loop stalls
+ * on each one. These kernels hide the misses by prefetching the rows of
+ * indices a fixed distance ahead, and avoid polluting the cache with the
+ * write-once output by using non-temporal stores for large rows. Work is
+ * sharded over contiguous output ranges so each worker first-touches its own
+ * shard, which places the output pages on the worker's NUMA node under the
+ * usual first-touch policy.
+ */
+
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+// How many indices ahead of the copy loop the prefetcher runs. Large enough
+// to cover a memory round trip at typical row sizes, small enough that the
+// prefetched lines survive until use.
+constexpr int64_t kPrefetchDistance = 8;
+// Rows at least this large are streamed past the cache; smaller rows are
+// likely re-read soon (e.g. by a following reduce) and stay cacheable.
+constexpr size_t kNontemporalMinBytes = 256;
+
+inline void PrefetchRead(const void* addr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr, /*rw=*/0, /*locality=*/1);
+#else
+  (void)addr;
+#endif
+}
+
+/*!
+ * \brief Copy one embedding row, bypassing the cache when profitable.
+ *
+ *  The output of a gather is written once and read much later (if at all by
+ *  this core), so filling the cache with it only evicts the table's hot rows.
+ *  Callers must issue a store fence once after their copy loop.
+ */
+inline void CopyRow(void* dst, const void* src, size_t nbytes) {
+#if defined(__SSE2__)
+  if (nbytes >= kNontemporalMinBytes && nbytes % 16 == 0 &&
+      reinterpret_cast<uintptr_t>(dst) % 16 == 0 && reinterpret_cast<uintptr_t>(src) % 16 == 0) {
+    const __m128i* s = reinterpret_cast<const __m128i*>(src);
+    __m128i* d = reinterpret_cast<__m128i*>(dst);
+    for (size_t i = 0; i < nbytes / 16; ++i) {
+      _mm_stream_si128(d + i, _mm_loadu_si128(s + i));
+    }
+    return;
+  }
+#endif
+  std::memcpy(dst, src, nbytes);
+}
+
+inline void StoreFence() {
+#if defined(__SSE2__)
+  _mm_sfence();
+#endif
+}
+
+/*! \brief Run fn(task_id, num_task) once per task on the TVM thread pool. */
+inline void ParallelLaunch(int num_task, const std::function<void(int, int)>& fn) {
+  num_task = std::min(num_task, threading::MaxConcurrency());
+  if (num_task <= 1) {
+    fn(0, 1);
+    return;
+  }
+  struct Env {
+    const std::function<void(int, int)>* fn;
+    int num_task;
+  } env{&fn, num_task};
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+    const Env* e = static_cast<const Env*>(cdata);
+    (*e->fn)(task_id, e->num_task);
+    return 0;
+  };
+  int res = TVMBackendParallelLaunch(flambda, &env, num_task);
+  ICHECK_EQ(res, 0) << "Parallel embedding lookup launch failed";
+}
+
+inline size_t RowBytes(const DLTensor* table) {
+  size_t bytes = (table->dtype.bits * table->dtype.lanes + 7) / 8;
+  for (int i = 1; i < table->ndim; ++i) {
+    bytes *= static_cast<size_t>(table->shape[i]);
+  }
+  return bytes;
+}
+
+inline int64_t NumElements(const DLTensor* tensor) {
+  int64_t n = 1;
+  for (int i = 0; i < tensor->ndim; ++i) {
+    n *= tensor->shape[i];
+  }
+  return n;
+}
+
+/*!
+ * \brief Gather rows of a table into a shard of the output.
+ *
+ *  The gather is dtype-agnostic: rows are moved as bytes, so any row layout
+ *  the table carries is preserved. dst_stride lets the same loop fill a
+ *  column slice of a wider output (the concat case).
+ */
+template <typename IndexType>
+void GatherShard(const char* table, int64_t num_rows, size_t row_bytes, const IndexType* indices,
+                 int64_t lo, int64_t hi, char* dst, size_t dst_stride) {
+  for (int64_t i = lo; i < hi; ++i) {
+    if (i + kPrefetchDistance < hi) {
+      PrefetchRead(table + static_cast<int64_t>(indices[i + kPrefetchDistance]) * row_bytes);
+    }
+    int64_t row = static_cast<int64_t>(indices[i]);
+    ICHECK(row >= 0 && row < num_rows) << "embedding index " << row << " out of range [0, "
+                                       << num_rows << ")";
+    CopyRow(dst + (i - lo) * dst_stride, table + row * row_bytes, row_bytes);
+  }
+  StoreFence();
+}
+
+template <typename IndexType>
+void LookupRows(const DLTensor* table, const DLTensor* indices, DLTensor* out) {
+  const size_t row_bytes = RowBytes(table);
+  const int64_t num_rows = table->shape[0];
+  const int64_t num_indices = NumElements(indices);
+  const auto* idx = static_cast<const IndexType*>(indices->data);
+  const char* src = static_cast<const char*>(table->data);
+  char* dst = static_cast<char*>(out->data);
+
+  int num_task = static_cast<int>(std::min<int64_t>(num_indices, threading::MaxConcurrency()));
+  const int64_t chunk = (num_indices + num_task - 1) / num_task;
+  ParallelLaunch(num_task, [&](int task_id, int nt) {
+    int64_t lo = std::min<int64_t>(task_id * chunk, num_indices);
+    int64_t hi = std::min<int64_t>(lo + chunk, num_indices);
+    GatherShard(src, num_rows, row_bytes, idx, lo, hi, dst + lo * row_bytes, row_bytes);
+  });
+}
+
+/*!
+ * \brief Bag-style lookup: sum the rows of each index segment.
+ *
+ *  offsets has one entry per bag plus a trailing total, CSR style; bag b sums
+ *  table rows indices[offsets[b]:offsets[b+1]]. Accumulation re-reads the
+ *  output row, so stores stay temporal here; only the table side prefetches.
+ */
+template <typename IndexType>
+void LookupSum(const DLTensor* table, const DLTensor* indices, const DLTensor* offsets,
+               DLTensor* out) {
+  const int64_t dim = table->ndim > 1 ? NumElements(table) / table->shape[0] : 1;
+  const int64_t num_rows = table->shape[0];
+  const int64_t num_bags = NumElements(offsets) - 1;
+  const auto* idx = static_cast<const IndexType*>(indices->data);
+  const auto* off = static_cast<const IndexType*>(offsets->data);
+  const auto* src = static_cast<const float*>(table->data);
+  auto* dst = static_cast<float*>(out->data);
+  const int64_t total = static_cast<int64_t>(off[num_bags]);
+  ICHECK_LE(total, NumElements(indices));
+
+  int num_task = static_cast<int>(std::min<int64_t>(num_bags, threading::MaxConcurrency()));
+  const int64_t chunk = (num_bags + num_task - 1) / num_task;
+  ParallelLaunch(num_task, [&](int task_id, int nt) {
+    int64_t bag_lo = std::min<int64_t>(task_id * chunk, num_bags);
+    int64_t bag_hi = std::min<int64_t>(bag_lo + chunk, num_bags);
+    for (int64_t b = bag_lo; b < bag_hi; ++b) {
+      float* out_row = dst + b * dim;
+      std::memset(out_row, 0, dim * sizeof(float));
+      int64_t lo = static_cast<int64_t>(off[b]);
+      int64_t hi = static_cast<int64_t>(off[b + 1]);
+      for (int64_t i = lo; i < hi; ++i) {
+        if (i + kPrefetchDistance < total) {
+          PrefetchRead(src + static_cast<int64_t>(idx[i + kPrefetchDistance]) * dim);
+        }
+        int64_t row = static_cast<int64_t>(idx[i]);
+        ICHECK(row >= 0 && row < num_rows) << "embedding index " << row << " out of range [0, "
+                                           << num_rows << ")";
+        const float* src_row = src + row * dim;
+        for (int64_t j = 0; j < dim; ++j) {
+          out_row[j] += src_row[j];
+        }
+      }
+    }
+  });
+}
+
+inline bool IsIndexType(DLDataType t, int bits) {
+  return t.code == kDLInt && t.bits == bits && t.lanes == 1;
+}
+
+TVM_REGISTER_GLOBAL("tvm.contrib.embedding.lookup").set_body([](TVMArgs args, TVMRetValue* ret) {
+  DLTensor* table = args[0];
+  DLTensor* indices = args[1];
+  DLTensor* out = args[2];
+  ICHECK_EQ(RowBytes(table), RowBytes(out)) << "table and output row sizes differ";
+  ICHECK_EQ(NumElements(indices), out->shape[0]);
+  if (IsIndexType(indices->dtype, 32)) {
+    LookupRows<int32_t>(table, indices, out);
+  } else if (IsIndexType(indices->dtype, 64)) {
+    LookupRows<int64_t>(table, indices, out);
+  } else {
+    LOG(FATAL) << "embedding indices must be int32 or int64";
+  }
+});
+
+TVM_REGISTER_GLOBAL("tvm.contrib.embedding.lookup_sum")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      DLTensor* table = args[0];
+      DLTensor* indices = args[1];
+      DLTensor* offsets = args[2];
+      DLTensor* out = args[3];
+      ICHECK(table->dtype.code == kDLFloat && table->dtype.bits == 32 && table->dtype.lanes == 1)
+          << "lookup_sum supports float32 tables";
+      ICHECK(indices->dtype.code == offsets->dtype.code &&
+             indices->dtype.bits == offsets->dtype.bits)
+          << "indices and offsets must share a dtype";
+      if (IsIndexType(indices->dtype, 32)) {
+        LookupSum<int32_t>(table, indices, offsets, out);
+      } else if (IsIndexType(indices->dtype, 64)) {
+        LookupSum<int64_t>(table, indices, offsets, out);
+      } else {
+        LOG(FATAL) << "embedding indices must be int32 or int64";
+      }
+    });
+
+// Fused multi-table gather: args are (out, table0, indices0, table1,
+// indices1, ...). Every index tensor holds the same number of lookups and
+// row i of the output is the concatenation of the gathered rows of every
+// table, so the separate gather-then-concatenate graph collapses into one
+// pass over the output.
+TVM_REGISTER_GLOBAL("tvm.contrib.embedding.lookup_concat")
+    .set_body([](TVMArgs args, TVMRetValue* ret) {
+      ICHECK_GE(args.num_args, 3) << "expected (out, table, indices, ...)";
+      ICHECK_EQ((args.num_args - 1) % 2, 0) << "tables and indices must come in pairs";
+      DLTensor* out = args[0];
+      const int num_tables = (args.num_args - 1) / 2;
+      std::vector<DLTensor*> tables(num_tables);
+      std::vector<DLTensor*> indices(num_tables);
+      size_t out_row_bytes = 0;
+      const int64_t num_lookups = out->shape[0];
+      for (int t = 0; t < num_tables; ++t) {
+        tables[t] = args[1 + 2 * t];
+        indices[t] = args[2 + 2 * t];
+        ICHECK_EQ(NumElements(indices[t]), num_lookups)
+            << "all index tensors must hold one index per output row";
+        out_row_bytes += RowBytes(tables[t]);
+      }
+      ICHECK_EQ(out_row_bytes, RowBytes(out)) << "output row must hold all table rows";
+
+      int num_task = static_cast<int>(std::min<int64_t>(num_lookups, threading::MaxConcurrency()));
+      const int64_t chunk = (num_lookups + num_task - 1) / num_task;
+      ParallelLaunch(num_task, [&](int task_id, int nt) {
+        int64_t lo = std::min<int64_t>(task_id * chunk, num_lookups);
+        int64_t hi = std::min<int64_t>(lo + chunk, num_lookups);
+        size_t col = 0;
+        for (int t = 0; t < num_tables; ++t) {
+          const size_t row_bytes = RowBytes(tables[t]);
+          char* dst = static_cast<char*>(out->data) + lo * out_row_bytes + col;
+          const char* src = static_cast<const char*>(tables[t]->data);
+          if (IsIndexType(indices[t]->dtype, 32)) {
+            GatherShard(src, tables[t]->shape[0], row_bytes,
+                        static_cast<const int32_t*>(indices[t]->data), lo, hi, dst, out_row_bytes);
+          } else if (IsIndexType(indices[t]->dtype, 64)) {
+            GatherShard(src, tables[t]->shape[0], row_bytes,
+                        static_cast<const int64_t*>(indices[t]->data), lo, hi, dst, out_row_bytes);
+          } else {
+            LOG(FATAL) << "embedding indices must be int32 or int64";
+          }
+          col += row_bytes;
+        }
+      });
+    });
+
+}  // namespace contrib
+}  // namespace tvm
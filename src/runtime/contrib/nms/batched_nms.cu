@@ -0,0 +1,183 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file Batched multi-class NMS as a single kernel launch.
+ *
+ * The TE-generated NMS pipeline runs a valid-count kernel, then a
+ * suppression loop that synchronizes the device once per surviving box and
+ * once per (batch, class) pair. This kernel assigns one thread block per
+ * (batch, class) row and runs the whole suppression there: the score
+ * threshold cut is a binary search over the sorted scores fused into the
+ * same launch, the suppression state is a shared-memory bitmask, each warp
+ * ballots the IoU decisions of 32 boxes into one mask word, and the pivot
+ * loop exits as soon as max_output_boxes_per_class boxes survive. All
+ * rows proceed independently, so multi-class batches need exactly one
+ * launch instead of a pipeline of them.
+ */
+
+#include <dlpack/dlpack.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+
+#include "../../cuda/cuda_common.h"
+
+namespace tvm {
+namespace contrib {
+
+using namespace runtime;
+
+namespace {
+
+constexpr int kThreadsPerBlock = 256;
+
+__device__ __forceinline__ float IoU(const float* a, const float* b) {
+  // Boxes are (y1, x1, y2, x2) or any corner layout with matching order on
+  // both operands; the formula only needs consistent min/max corners.
+  float a_y1 = min(a[0], a[2]), a_y2 = max(a[0], a[2]);
+  float a_x1 = min(a[1], a[3]), a_x2 = max(a[1], a[3]);
+  float b_y1 = min(b[0], b[2]), b_y2 = max(b[0], b[2]);
+  float b_x1 = min(b[1], b[3]), b_x2 = max(b[1], b[3]);
+  float inter_h = max(0.0f, min(a_y2, b_y2) - max(a_y1, b_y1));
+  float inter_w = max(0.0f, min(a_x2, b_x2) - max(a_x1, b_x1));
+  float inter = inter_h * inter_w;
+  float area_a = (a_y2 - a_y1) * (a_x2 - a_x1);
+  float area_b = (b_y2 - b_y1) * (b_x2 - b_x1);
+  float denom = area_a + area_b - inter;
+  return denom <= 0.0f ? 0.0f : inter / denom;
+}
+
+/*!
+ * \brief One block suppresses one (batch, class) row.
+ *
+ * Shared memory holds one suppression bit per box. Every pivot pass hands
+ * each warp a 32-box aligned chunk, the lanes evaluate IoU against the
+ * pivot in parallel and a single ballot merges their verdicts into the
+ * mask word, so no atomics are needed. Control flow is uniform across the
+ * block: the pivot scan reads only shared state, so __syncthreads stays
+ * legal.
+ */
+__global__ void BatchedBitmaskNMSKernel(const float* boxes, const float* sorted_scores,
+                                        const int32_t* sorted_indices, int num_class,
+                                        int num_boxes, float iou_threshold, float score_threshold,
+                                        int max_out, int32_t* out_indices, int32_t* out_count) {
+  extern __shared__ uint32_t suppressed[];
+  const int row = blockIdx.x;
+  const int batch = row / num_class;
+  const float* row_scores = sorted_scores + static_cast<int64_t>(row) * num_boxes;
+  const int32_t* row_indices = sorted_indices + static_cast<int64_t>(row) * num_boxes;
+  const float* batch_boxes = boxes + static_cast<int64_t>(batch) * num_boxes * 4;
+  int32_t* row_out = out_indices + static_cast<int64_t>(row) * num_boxes;
+
+  const int tid = threadIdx.x;
+  const int lane = tid & 31;
+  const int warp = tid >> 5;
+  const int num_warps = blockDim.x >> 5;
+  const int num_words = (num_boxes + 31) >> 5;
+
+  for (int w = tid; w < num_words; w += blockDim.x) {
+    suppressed[w] = 0;
+  }
+
+  // Scores are sorted descending; the first index below the threshold bounds
+  // the candidates. This replaces the separate valid-count kernel.
+  int lo = 0, hi = num_boxes;
+  while (lo < hi) {
+    int mid = (lo + hi) >> 1;
+    if (row_scores[mid] > score_threshold) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  const int n_valid = lo;
+  __syncthreads();
+
+  __shared__ float pivot_box[4];
+  int selected = 0;
+  for (int i = 0; i < n_valid && selected < max_out; ++i) {
+    if (suppressed[i >> 5] >> (i & 31) & 1) continue;
+    if (tid == 0) {
+      row_out[selected] = row_indices[i];
+      const float* b = batch_boxes + static_cast<int64_t>(row_indices[i]) * 4;
+      pivot_box[0] = b[0];
+      pivot_box[1] = b[1];
+      pivot_box[2] = b[2];
+      pivot_box[3] = b[3];
+    }
+    ++selected;
+    __syncthreads();
+    for (int w = warp + (i >> 5); (w << 5) < n_valid; w += num_warps) {
+      const int j = (w << 5) + lane;
+      bool kill = false;
+      if (j > i && j < n_valid && !(suppressed[w] >> lane & 1)) {
+        kill = IoU(pivot_box, batch_boxes + static_cast<int64_t>(row_indices[j]) * 4) >=
+               iou_threshold;
+      }
+      const uint32_t mask = __ballot_sync(0xffffffff, kill);
+      if (lane == 0 && mask) {
+        suppressed[w] |= mask;
+      }
+    }
+    __syncthreads();
+  }
+  if (tid == 0) {
+    out_count[row] = selected;
+  }
+}
+
+}  // namespace
+
+TVM_REGISTER_GLOBAL("tvm.contrib.cuda.batched_nms").set_body([](TVMArgs args, TVMRetValue* ret) {
+  DLTensor* boxes = args[0];
+  DLTensor* sorted_scores = args[1];
+  DLTensor* sorted_indices = args[2];
+  DLTensor* out_indices = args[3];
+  DLTensor* out_count = args[4];
+  int num_class = args[5];
+  int max_out = args[6];
+  double iou_threshold = args[7];
+  double score_threshold = args[8];
+
+  ICHECK_EQ(boxes->ndim, 3);
+  ICHECK_EQ(boxes->shape[2], 4);
+  ICHECK_EQ(sorted_scores->ndim, 2);
+  const int num_boxes = static_cast<int>(boxes->shape[1]);
+  const int num_rows = static_cast<int>(sorted_scores->shape[0]);
+  ICHECK_EQ(num_rows, boxes->shape[0] * num_class);
+  ICHECK(boxes->dtype.code == kDLFloat && boxes->dtype.bits == 32)
+      << "batched_nms supports float32 boxes";
+  ICHECK(sorted_indices->dtype.code == kDLInt && sorted_indices->dtype.bits == 32)
+      << "batched_nms supports int32 box indices";
+  if (max_out <= 0 || max_out > num_boxes) {
+    max_out = num_boxes;
+  }
+
+  const int num_words = (num_boxes + 31) / 32;
+  cudaStream_t stream = CUDAThreadEntry::ThreadLocal()->stream;
+  BatchedBitmaskNMSKernel<<<num_rows, kThreadsPerBlock, num_words * sizeof(uint32_t), stream>>>(
+      static_cast<const float*>(boxes->data), static_cast<const float*>(sorted_scores->data),
+      static_cast<const int32_t*>(sorted_indices->data), num_class, num_boxes,
+      static_cast<float>(iou_threshold), static_cast<float>(score_threshold), max_out,
+      static_cast<int32_t*>(out_indices->data), static_cast<int32_t*>(out_count->data));
+  CUDA_CALL(cudaGetLastError());
+});
+
+}  // namespace contrib
+}  // namespace tvm
@@ -19,21 +19,107 @@
 
 /*!
  * \file random/mt_random_engine.cc
- * \brief mt19937 random engine
+ * \brief mt19937-seeded random engine with counter-based tensor fills
  */
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/ndarray.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <ctime>
+#include <functional>
 #include <random>
+#include <thread>
+#include <vector>
 
 #include "../3rdparty/compiler-rt/builtin_fp16.h"
 
 namespace tvm {
 namespace contrib {
 
+/*!
+ * \brief Counter-based Philox4x32-10 block generator.
+ *
+ * Every 64-bit counter produces four independent 32-bit samples purely from
+ * (key, counter), so each element of a tensor fill is derived from its own
+ * index. That makes the fill embarrassingly parallel and deterministic no
+ * matter how the work is sharded, and the branch-free rounds auto-vectorize
+ * well, unlike the sequential mt19937 state walk.
+ */
+class Philox4x32 {
+ public:
+  explicit Philox4x32(uint64_t key)
+      : key0_(static_cast<uint32_t>(key)), key1_(static_cast<uint32_t>(key >> 32)) {}
+
+  /*! \brief Generate the four samples of the given counter block into out[0..3]. */
+  void operator()(uint64_t counter, uint32_t* out) const {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = key0_;
+    uint32_t k1 = key1_;
+    for (int round = 0; round < 10; ++round) {
+      uint64_t p0 = static_cast<uint64_t>(kMul0) * c0;
+      uint64_t p1 = static_cast<uint64_t>(kMul1) * c2;
+      uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+      uint32_t n1 = static_cast<uint32_t>(p1);
+      uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+      uint32_t n3 = static_cast<uint32_t>(p0);
+      c0 = n0;
+      c1 = n1;
+      c2 = n2;
+      c3 = n3;
+      k0 += kWeyl0;
+      k1 += kWeyl1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+ private:
+  static constexpr uint32_t kMul0 = 0xD2511F53;
+  static constexpr uint32_t kMul1 = 0xCD9E8D57;
+  static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+  uint32_t key0_;
+  uint32_t key1_;
+};
+
+/*! \brief Convert a 32-bit sample to a float uniformly distributed in [0, 1). */
+inline float ToUnitFloat(uint32_t x) { return (x >> 8) * (1.0f / (1 << 24)); }
+
+/*! \brief Convert a 32-bit sample to a float uniformly distributed in (0, 1]. */
+inline float ToPositiveUnitFloat(uint32_t x) { return ((x >> 8) + 1) * (1.0f / (1 << 24)); }
+
+/*!
+ * \brief Shard [0, size) across worker threads in chunks aligned to the
+ * four-sample Philox block, so no block straddles two workers. Since each
+ * element's value depends only on its index, the partitioning cannot change
+ * the result.
+ */
+void ParallelFill(int64_t size, const std::function<void(int64_t, int64_t)>& fill) {
+  constexpr int64_t kSerialThreshold = 1 << 14;
+  int nthreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  if (size < kSerialThreshold || nthreads == 1) {
+    fill(0, size);
+    return;
+  }
+  int64_t chunk = ((size + nthreads - 1) / nthreads + 3) / 4 * 4;
+  std::vector<std::thread> workers;
+  for (int64_t begin = chunk; begin < size; begin += chunk) {
+    workers.emplace_back(fill, begin, std::min(size, begin + chunk));
+  }
+  fill(0, std::min(size, chunk));
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
 /*!
  * \brief An interface for generating [tensors of] random numbers.
  */
@@ -83,9 +169,18 @@ class RandomEngine {
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
     if (data->device.device_type == kDLCPU) {
-      std::uniform_real_distribution<float> uniform_dist(low, high);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return uniform_dist(rnd_engine_); });
+      float* out = static_cast<float*>(data->data);
+      Philox4x32 philox(NextKey());
+      const float range = high - low;
+      ParallelFill(size, [&](int64_t begin, int64_t end) {
+        uint32_t block[4];
+        for (int64_t i = begin; i < end; i += 4) {
+          philox(static_cast<uint64_t>(i) / 4, block);
+          for (int64_t j = 0; j < 4 && i + j < end; ++j) {
+            out[i + j] = low + range * ToUnitFloat(block[j]);
+          }
+        }
+      });
     } else {
       LOG(FATAL) << "Do not support random.uniform on this device yet";
     }
@@ -107,9 +202,26 @@ class RandomEngine {
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
     if (data->device.device_type == kDLCPU) {
-      std::normal_distribution<float> normal_dist(loc, scale);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return normal_dist(rnd_engine_); });
+      float* out = static_cast<float*>(data->data);
+      Philox4x32 philox(NextKey());
+      constexpr float kTwoPi = 6.283185307179586f;
+      ParallelFill(size, [&](int64_t begin, int64_t end) {
+        uint32_t block[4];
+        float normal[4];
+        for (int64_t i = begin; i < end; i += 4) {
+          philox(static_cast<uint64_t>(i) / 4, block);
+          // Box-Muller on the two lane pairs of the block.
+          for (int p = 0; p < 2; ++p) {
+            float r = std::sqrt(-2.0f * std::log(ToPositiveUnitFloat(block[2 * p])));
+            float theta = kTwoPi * ToUnitFloat(block[2 * p + 1]);
+            normal[2 * p] = r * std::cos(theta);
+            normal[2 * p + 1] = r * std::sin(theta);
+          }
+          for (int64_t j = 0; j < 4 && i + j < end; ++j) {
+            out[i + j] = loc + scale * normal[j];
+          }
+        }
+      });
     } else {
       LOG(FATAL) << "Do not support random.normal on this device yet";
     }
@@ -133,32 +245,54 @@ class RandomEngine {
   }
 
  private:
+  /*!
+   * \brief Draw a fresh Philox key from the seeded engine, so filled values
+   * still follow the engine seed while the fill itself stays counter-based.
+   */
+  uint64_t NextKey() {
+    return (static_cast<uint64_t>(rnd_engine_()) << 32) | static_cast<uint32_t>(rnd_engine_());
+  }
+
+  template <typename T, typename FConvert>
+  void PhiloxFill(T* out, int64_t size, float low, float high, const FConvert& convert) {
+    Philox4x32 philox(NextKey());
+    const float range = high - low;
+    ParallelFill(size, [&](int64_t begin, int64_t end) {
+      uint32_t block[4];
+      for (int64_t i = begin; i < end; i += 4) {
+        philox(static_cast<uint64_t>(i) / 4, block);
+        for (int64_t j = 0; j < 4 && i + j < end; ++j) {
+          out[i + j] = convert(low + range * ToUnitFloat(block[j]));
+        }
+      }
+    });
+  }
+
+  template <typename T>
+  void PhiloxFill(T* out, int64_t size, float low, float high) {
+    PhiloxFill(out, size, low, high, [](float v) { return static_cast<T>(v); });
+  }
+
   void FillData(DLTensor* tensor, int64_t size) {
     // Make the value be 1.0 - 10.0, not (0.0 - 1.0) so that we could satisfy
     // quantized dtype (uint8 / int8) data non-empty requirement
-    std::uniform_real_distribution<> dist(1.0, 10.0);
     // Use float representation could make us work well on float / int type too.
     if (tensor->dtype.bits == 1) {
-      std::generate_n(static_cast<bool*>(tensor->data), size, [&]() { return dist(rnd_engine_); });
+      PhiloxFill(static_cast<bool*>(tensor->data), size, 1.0f, 10.0f);
     } else if (tensor->dtype.bits == 4) {
       // For uint4/int4 we pack two values into a single byte.
       // Thus, to ensure both values are non-zero, we use a distribution of 17 - 30.
-      std::uniform_real_distribution<> packed_dist(17.0, 30.0);
-      std::generate_n(reinterpret_cast<uint8_t*>(tensor->data), size,
-                      [&]() { return packed_dist(rnd_engine_); });
+      PhiloxFill(reinterpret_cast<uint8_t*>(tensor->data), size, 17.0f, 30.0f);
     } else if (tensor->dtype.bits == 8) {
-      std::generate_n(static_cast<uint8_t*>(tensor->data), size,
-                      [&]() { return dist(rnd_engine_); });
+      PhiloxFill(static_cast<uint8_t*>(tensor->data), size, 1.0f, 10.0f);
     } else if (tensor->dtype.bits == 16) {
-      std::generate_n(static_cast<uint16_t*>(tensor->data), size, [&]() {
-        return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(
-            static_cast<float>(dist(rnd_engine_)));
+      PhiloxFill(static_cast<uint16_t*>(tensor->data), size, 1.0f, 10.0f, [](float v) {
+        return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(v);
       });
     } else if (tensor->dtype.bits == 32) {
-      std::generate_n(static_cast<float*>(tensor->data), size, [&]() { return dist(rnd_engine_); });
+      PhiloxFill(static_cast<float*>(tensor->data), size, 1.0f, 10.0f);
     } else if (tensor->dtype.bits == 64) {
-      std::generate_n(static_cast<double*>(tensor->data), size,
-                      [&]() { return dist(rnd_engine_); });
+      PhiloxFill(static_cast<double*>(tensor->data), size, 1.0f, 10.0f);
     } else {
       LOG(FATAL) << "Doesn't support dtype code " << tensor->dtype.code << " dtype bits "
                  << tensor->dtype.bits;
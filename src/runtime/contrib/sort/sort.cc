@@ -22,9 +22,13 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <functional>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -42,6 +46,86 @@ bool CompareDescend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_
   return lhs.second > rhs.second;
 }
 
+// Comparators with an index tie-break. A plain (unstable) sort under these
+// produces exactly the ordering stable_sort produces under the value-only
+// comparators above, which keeps results deterministic while freeing us to
+// use the cheaper algorithms and to merge independently sorted runs.
+template <typename DType>
+bool TotalOrderAscend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
+  if (lhs.second != rhs.second) return lhs.second < rhs.second;
+  return lhs.first < rhs.first;
+}
+
+template <typename DType>
+bool TotalOrderDescend(const std::pair<int64_t, DType>& lhs, const std::pair<int64_t, DType>& rhs) {
+  if (lhs.second != rhs.second) return lhs.second > rhs.second;
+  return lhs.first < rhs.first;
+}
+
+// Sorting fewer elements than this stays serial; the launch and merge
+// overhead does not amortize on small rows.
+constexpr int64_t kParallelSortMinElems = 1 << 15;
+
+/*! \brief Run fn(task_id, num_task) once per task on the TVM thread pool. */
+inline void ParallelLaunch(int num_task, const std::function<void(int, int)>& fn) {
+  num_task = std::min(num_task, threading::MaxConcurrency());
+  if (num_task <= 1) {
+    fn(0, 1);
+    return;
+  }
+  struct Env {
+    const std::function<void(int, int)>* fn;
+    int num_task;
+  } env{&fn, num_task};
+  auto flambda = [](int task_id, TVMParallelGroupEnv* penv, void* cdata) -> int {
+    const Env* e = static_cast<const Env*>(cdata);
+    (*e->fn)(task_id, e->num_task);
+    return 0;
+  };
+  int res = TVMBackendParallelLaunch(flambda, &env, num_task);
+  ICHECK_EQ(res, 0) << "Parallel sort launch failed";
+}
+
+/*!
+ * \brief Parallel mergesort over the thread pool.
+ *
+ * Workers sort disjoint chunks, then adjacent sorted runs are merged pairwise
+ * in parallel until one run remains. The comparator must be a total order
+ * (see TotalOrderAscend) so the chunked sort agrees with a serial one.
+ */
+template <typename Iter, typename Compare>
+void ParallelSort(Iter begin, Iter end, Compare comp) {
+  const int64_t size = static_cast<int64_t>(end - begin);
+  int max_tasks = threading::MaxConcurrency();
+  if (size < kParallelSortMinElems || max_tasks <= 1) {
+    std::sort(begin, end, comp);
+    return;
+  }
+  // A power-of-two task count keeps the merge tree balanced.
+  int tasks = 1;
+  while (tasks * 2 <= max_tasks) tasks *= 2;
+  const int64_t chunk = (size + tasks - 1) / tasks;
+  ParallelLaunch(tasks, [&](int task_id, int num_task) {
+    int64_t lo = std::min<int64_t>(task_id * chunk, size);
+    int64_t hi = std::min<int64_t>(lo + chunk, size);
+    std::sort(begin + lo, begin + hi, comp);
+  });
+  for (int64_t width = chunk; width < size; width *= 2) {
+    const int64_t num_pairs = (size + 2 * width - 1) / (2 * width);
+    ParallelLaunch(static_cast<int>(std::min<int64_t>(num_pairs, max_tasks)),
+                   [&](int task_id, int num_task) {
+                     for (int64_t p = task_id; p < num_pairs; p += num_task) {
+                       int64_t lo = p * 2 * width;
+                       int64_t mid = std::min<int64_t>(lo + width, size);
+                       int64_t hi = std::min<int64_t>(lo + 2 * width, size);
+                       if (mid < hi) {
+                         std::inplace_merge(begin + lo, begin + mid, begin + hi, comp);
+                       }
+                     }
+                   });
+  }
+}
+
 // Argsort implemented C library sort for nms.
 // Return indices of sorted tensor.
 // By default, the last axis will be used to sort.
@@ -128,7 +212,6 @@ template <typename DataType, typename OutType>
 void sort_impl(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend, bool is_argsort) {
   auto data_ptr = static_cast<DataType*>(input->data);
   auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
   int axis_mul_before = 1;
   int axis_mul_after = 1;
@@ -139,30 +222,53 @@ void sort_impl(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend,
       axis_mul_after *= input->shape[i];
     }
   }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+  const int64_t axis_len = input->shape[axis];
+  const int64_t rows = static_cast<int64_t>(axis_mul_before) * axis_mul_after;
+  auto comp = is_ascend ? TotalOrderAscend<DataType> : TotalOrderDescend<DataType>;
+
+  auto sort_row = [&](int64_t row, std::vector<std::pair<int64_t, DataType>>* sorter,
+                      bool parallel_within_row) {
+    sorter->clear();
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t base_idx = i * axis_len * axis_mul_after + j;
+    for (int64_t k = 0; k < axis_len; ++k) {
+      sorter->emplace_back(std::make_pair(k, data_ptr[base_idx + k * axis_mul_after]));
+    }
+    if (parallel_within_row) {
+      ParallelSort(sorter->begin(), sorter->end(), comp);
+    } else {
+      std::sort(sorter->begin(), sorter->end(), comp);
+    }
+    if (is_argsort) {
+      for (int64_t k = 0; k < axis_len; ++k) {
+        out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>((*sorter)[k].first);
       }
-      if (is_argsort) {
-        for (int64_t k = 0; k < input->shape[axis]; ++k) {
-          out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>(sorter[k].first);
-        }
-      } else {
-        for (int64_t k = 0; k < input->shape[axis]; ++k) {
-          out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>(sorter[k].second);
-        }
+    } else {
+      for (int64_t k = 0; k < axis_len; ++k) {
+        out_ptr[base_idx + k * axis_mul_after] = static_cast<OutType>((*sorter)[k].second);
       }
     }
+  };
+
+  const int max_tasks = threading::MaxConcurrency();
+  if (rows >= max_tasks && rows * axis_len >= kParallelSortMinElems) {
+    // Enough independent rows to fill the pool: one stripe of rows per task.
+    ParallelLaunch(static_cast<int>(std::min<int64_t>(rows, max_tasks)),
+                   [&](int task_id, int num_task) {
+                     std::vector<std::pair<int64_t, DataType>> sorter;
+                     sorter.reserve(axis_len);
+                     for (int64_t row = task_id; row < rows; row += num_task) {
+                       sort_row(row, &sorter, false);
+                     }
+                   });
+  } else {
+    // Few (possibly huge) rows: parallelize inside each row sort instead.
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    sorter.reserve(axis_len);
+    for (int64_t row = 0; row < rows; ++row) {
+      sort_row(row, &sorter, true);
+    }
   }
 }
 
@@ -308,7 +414,6 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
 
   int axis_mul_before = 1;
   int axis_mul_after = 1;
@@ -319,36 +424,52 @@ void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, i
       axis_mul_after *= input->shape[i];
     }
   }
+  const int64_t axis_len = input->shape[axis];
   if (k < 1) {
-    k = input->shape[axis];
+    k = axis_len;
   }
-
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-      for (int64_t kk = 0; kk < input->shape[axis]; ++kk) {
-        int64_t full_idx = src_base_idx + kk * axis_mul_after;
-        sorter.emplace_back(std::make_pair(kk, data_ptr[full_idx]));
-      }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+  const int64_t rows = static_cast<int64_t>(axis_mul_before) * axis_mul_after;
+  auto comp = is_ascend ? TotalOrderAscend<DataType> : TotalOrderDescend<DataType>;
+
+  auto topk_row = [&](int64_t row, std::vector<std::pair<int64_t, DataType>>* sorter) {
+    sorter->clear();
+    int64_t i = row / axis_mul_after;
+    int64_t j = row % axis_mul_after;
+    int64_t src_base_idx = i * axis_len * axis_mul_after + j;
+    int64_t dst_base_idx = i * k * axis_mul_after + j;
+    for (int64_t kk = 0; kk < axis_len; ++kk) {
+      sorter->emplace_back(std::make_pair(kk, data_ptr[src_base_idx + kk * axis_mul_after]));
+    }
+    // Selecting the top k then ordering just that prefix is O(n + k log k)
+    // instead of a full O(n log n) sort.
+    if (k < axis_len) {
+      std::nth_element(sorter->begin(), sorter->begin() + k, sorter->end(), comp);
+      std::sort(sorter->begin(), sorter->begin() + k, comp);
+    } else {
+      std::sort(sorter->begin(), sorter->end(), comp);
+    }
+    for (int64_t kk = 0; kk < k; ++kk) {
+      if (indices_ptr != nullptr) {
+        indices_ptr[dst_base_idx + kk * axis_mul_after] =
+            static_cast<IndicesType>((*sorter)[kk].first);
       }
-      int64_t cnt = k > 0 ? k : input->shape[axis];
-      for (int64_t kk = 0; kk < cnt; ++kk) {
-        if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(sorter[kk].first);
-        }
-        if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] = static_cast<DataType>(sorter[kk].second);
-        }
+      if (values_ptr != nullptr) {
+        values_ptr[dst_base_idx + kk * axis_mul_after] =
+            static_cast<DataType>((*sorter)[kk].second);
       }
     }
-  }
+  };
+
+  const int tasks = rows * axis_len >= kParallelSortMinElems
+                        ? static_cast<int>(std::min<int64_t>(rows, threading::MaxConcurrency()))
+                        : 1;
+  ParallelLaunch(tasks, [&](int task_id, int num_task) {
+    std::vector<std::pair<int64_t, DataType>> sorter;
+    sorter.reserve(axis_len);
+    for (int64_t row = task_id; row < rows; row += num_task) {
+      topk_row(row, &sorter);
+    }
+  });
 }
 
 // Argsort implemented C library sort.
@@ -22,15 +22,17 @@
  */
 
 #include <thrust/device_ptr.h>
-#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
 #include <thrust/sort.h>
 #include <thrust/gather.h>
 #include <thrust/scan.h>
 #include <thrust/sequence.h>
 
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/device_api.h>
 #include <dlpack/dlpack.h>
 #include <algorithm>
+#include <cstddef>
 #include <vector>
 #include <functional>
 
@@ -39,6 +41,31 @@ namespace contrib {
 
 using namespace runtime;
 
+/*!
+ * \brief Allocator handing thrust temporary storage out of the device
+ *  workspace pool.
+ *
+ *  Every thrust algorithm invocation otherwise cudaMallocs its scratch
+ *  buffer and cudaFrees it on completion, which serializes the device;
+ *  the workspace pool caches blocks across calls so steady-state sort
+ *  and scan invocations allocate nothing.
+ */
+class WorkspaceAllocator {
+ public:
+  typedef char value_type;
+
+  explicit WorkspaceAllocator(Device dev) : dev_(dev) {}
+
+  char* allocate(std::ptrdiff_t nbytes) {
+    return static_cast<char*>(DeviceAPI::Get(dev_)->AllocWorkspace(dev_, nbytes));
+  }
+
+  void deallocate(char* ptr, size_t) { DeviceAPI::Get(dev_)->FreeWorkspace(dev_, ptr); }
+
+ private:
+  Device dev_;
+};
+
 // Performs sorting along axis -1 and returns both sorted values and indices.
 template<typename DataType, typename IndicesType>
 void thrust_sort(DLTensor* input,
@@ -54,29 +81,35 @@ void thrust_sort(DLTensor* input,
   for (int i = 0; i < input->ndim; ++i) {
     size *= input->shape[i];
   }
-  thrust::copy(data_ptr, data_ptr + size, values_ptr);
+  WorkspaceAllocator alloc(input->device);
+  auto policy = thrust::cuda::par(alloc);
+  thrust::copy(policy, data_ptr, data_ptr + size, values_ptr);
 
   if (size == static_cast<size_t>(input->shape[input->ndim - 1])) {
     // A fast path for single segment case
-    thrust::sequence(indices_ptr, indices_ptr + n_values);
+    thrust::sequence(policy, indices_ptr, indices_ptr + n_values);
     if (is_ascend) {
-      thrust::sort_by_key(values_ptr, values_ptr + n_values, indices_ptr);
+      thrust::sort_by_key(policy, values_ptr, values_ptr + n_values, indices_ptr);
     } else {
-      thrust::sort_by_key(values_ptr, values_ptr + n_values, indices_ptr,
+      thrust::sort_by_key(policy, values_ptr, values_ptr + n_values, indices_ptr,
                           thrust::greater<DataType>());
     }
   } else {
     // segmented sort by key
     // Follow the back-to-back stable_sort_by_key strategy explained below
     // https://groups.google.com/g/thrust-users/c/BoLsxO6b4FY
-    thrust::device_vector<int64_t> argsort_order(size);
-    thrust::sequence(argsort_order.begin(), argsort_order.end());
+    // The scratch arrays also come from the workspace pool; the frees below
+    // are in reverse order of the allocations to keep the pool happy.
+    DeviceAPI* device_api = DeviceAPI::Get(input->device);
+    thrust::device_ptr<int64_t> argsort_order(static_cast<int64_t*>(
+        device_api->AllocWorkspace(input->device, size * sizeof(int64_t))));
+    thrust::sequence(policy, argsort_order, argsort_order + size);
 
     // First, sort values and store the sorted order in argsort_order.
     if (is_ascend) {
-      thrust::stable_sort_by_key(values_ptr, values_ptr + size, argsort_order.begin());
+      thrust::stable_sort_by_key(policy, values_ptr, values_ptr + size, argsort_order);
     } else {
-      thrust::stable_sort_by_key(values_ptr, values_ptr + size, argsort_order.begin(),
+      thrust::stable_sort_by_key(policy, values_ptr, values_ptr + size, argsort_order,
                                  thrust::greater<DataType>());
     }
 
@@ -90,14 +123,15 @@ void thrust_sort(DLTensor* input,
                                                              linear_index_to_sort_axis_index);
 
     // This will reorder indices 0, 1, 2 ... in the sorted order of values_ptr
-    thrust::gather(argsort_order.begin(), argsort_order.end(), init_indices_iter, indices_ptr);
+    thrust::gather(policy, argsort_order, argsort_order + size, init_indices_iter, indices_ptr);
 
-    thrust::device_vector<int> segment_ids(size);
+    thrust::device_ptr<int> segment_ids(static_cast<int*>(
+        device_api->AllocWorkspace(input->device, size * sizeof(int))));
     auto linear_index_to_segment_id = [n_values] __host__ __device__(int64_t i) {
       return i / n_values;
     }; // NOLINT(*)
     // We also reorder segment indices 0, 0, 0, 1, 1, 1 ... in the order of values_ptr
-    thrust::transform(argsort_order.begin(), argsort_order.end(), segment_ids.begin(),
+    thrust::transform(policy, argsort_order, argsort_order + size, segment_ids,
                       linear_index_to_segment_id);
 
     // The second sort key-ed by segment_ids would bring segment_ids back to 0, 0, 0, 1, 1, 1 ...
@@ -105,7 +139,10 @@ void thrust_sort(DLTensor* input,
     // Since sorting has been done in a stable way, relative orderings of values and indices
     // in the segment do not change and hence they remain sorted.
     auto key_val_zip = thrust::make_zip_iterator(thrust::make_tuple(values_ptr, indices_ptr));
-    thrust::stable_sort_by_key(segment_ids.begin(), segment_ids.end(), key_val_zip);
+    thrust::stable_sort_by_key(policy, segment_ids, segment_ids + size, key_val_zip);
+
+    device_api->FreeWorkspace(input->device, segment_ids.get());
+    device_api->FreeWorkspace(input->device, argsort_order.get());
   }
 }
 
@@ -197,17 +234,20 @@ void thrust_stable_sort_by_key(DLTensor* keys_in,
   thrust::device_ptr<KeyType> keys_out_ptr(static_cast<KeyType *>(keys_out->data));
   thrust::device_ptr<ValueType> values_out_ptr(static_cast<ValueType *>(values_out->data));
 
+  WorkspaceAllocator alloc(keys_in->device);
+  auto policy = thrust::cuda::par(alloc);
   if (for_scatter) {
-    thrust::transform(keys_in_ptr, keys_in_ptr + size, keys_out_ptr, [size] __device__(KeyType k) {
+    thrust::transform(policy, keys_in_ptr, keys_in_ptr + size, keys_out_ptr,
+                      [size] __device__(KeyType k) {
       if (k < 0) return k + static_cast<KeyType>(size);
       return k;
     });
   } else {
-    thrust::copy(keys_in_ptr, keys_in_ptr + size, keys_out_ptr);
+    thrust::copy(policy, keys_in_ptr, keys_in_ptr + size, keys_out_ptr);
   }
-  thrust::copy(values_in_ptr, values_in_ptr + size, values_out_ptr);
+  thrust::copy(policy, values_in_ptr, values_in_ptr + size, values_out_ptr);
 
-  thrust::stable_sort_by_key(keys_out_ptr, keys_out_ptr + size, values_out_ptr);
+  thrust::stable_sort_by_key(policy, keys_out_ptr, keys_out_ptr + size, values_out_ptr);
 }
 
 TVM_REGISTER_GLOBAL("tvm.contrib.thrust.stable_sort_by_key")
@@ -285,15 +325,18 @@ void thrust_scan(DLTensor* data,
     return static_cast<OutType>(v);
   }); // NOLINT(*)
 
+  WorkspaceAllocator alloc(data->device);
+  auto policy = thrust::cuda::par(alloc);
+
   if (size == static_cast<size_t>(data->shape[data->ndim - 1])) {
     if (exclusive && need_cast) {
-      thrust::exclusive_scan(data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
+      thrust::exclusive_scan(policy, data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
     } else if (exclusive && !need_cast) {
-      thrust::exclusive_scan(data_ptr, data_ptr + scan_size, output_ptr);
+      thrust::exclusive_scan(policy, data_ptr, data_ptr + scan_size, output_ptr);
     } else if (!exclusive && need_cast) {
-      thrust::inclusive_scan(data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
+      thrust::inclusive_scan(policy, data_cast_ptr, data_cast_ptr + scan_size, output_ptr);
     } else {
-      thrust::inclusive_scan(data_ptr, data_ptr + scan_size, output_ptr);
+      thrust::inclusive_scan(policy, data_ptr, data_ptr + scan_size, output_ptr);
     }
   } else {
     // Use thrust segmented scan to compute scan on the inner most axis
@@ -310,13 +353,13 @@ void thrust_scan(DLTensor* data,
     auto key_iter = thrust::make_transform_iterator(counting_iter, linear_index_to_scan_key);
 
     if (exclusive && need_cast) {
-      thrust::exclusive_scan_by_key(key_iter, key_iter + size, data_cast_ptr, output_ptr);
+      thrust::exclusive_scan_by_key(policy, key_iter, key_iter + size, data_cast_ptr, output_ptr);
     } else if (exclusive && !need_cast) {
-      thrust::exclusive_scan_by_key(key_iter, key_iter + size, data_ptr, output_ptr);
+      thrust::exclusive_scan_by_key(policy, key_iter, key_iter + size, data_ptr, output_ptr);
     } else if (!exclusive && need_cast) {
-      thrust::inclusive_scan_by_key(key_iter, key_iter + size, data_cast_ptr, output_ptr);
+      thrust::inclusive_scan_by_key(policy, key_iter, key_iter + size, data_cast_ptr, output_ptr);
     } else {
-      thrust::inclusive_scan_by_key(key_iter, key_iter + size, data_ptr, output_ptr);
+      thrust::inclusive_scan_by_key(policy, key_iter, key_iter + size, data_ptr, output_ptr);
     }
   }
 }
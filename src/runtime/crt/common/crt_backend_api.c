@@ -54,11 +54,24 @@ int TVMBackendFreeWorkspace(int device_type, int device_id, void* ptr) {
 
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   TVMParallelGroupEnv env;
+  int64_t chunk_cursor = 0;
   env.num_task = 1;
+  env.chunk_handle = &chunk_cursor;
   flambda(0, &env, cdata);
   return 0;
 }
 
+int TVMBackendParallelNextChunk(TVMParallelGroupEnv* penv, int64_t extent, int64_t* out_begin,
+                                int64_t* out_end) {
+  /* single threaded runtime: the only worker takes the whole loop at once. */
+  int64_t* cursor = (int64_t*)penv->chunk_handle;
+  if (*cursor >= extent) return 0;
+  *out_begin = *cursor;
+  *out_end = extent;
+  *cursor = extent;
+  return 1;
+}
+
 int TVMBackendRegisterSystemLibSymbol(const char* name, void* ptr) {
   return TVMFuncRegisterGlobal(name, ptr, 0);
 }
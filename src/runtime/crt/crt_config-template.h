@@ -54,4 +54,7 @@
 /*! \brief Enable checks to enforce the stack allocator with a FIFO ordering. Off by default */
 // #define TVM_CRT_STACK_ALLOCATOR_ENABLE_FIFO_CHECK
 
+/*! \brief Track the page allocator high-water mark, for sizing the memory pool. Off by default */
+// #define TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+
 #endif  // TVM_RUNTIME_CRT_CRT_CONFIG_TEMPLATE_H_
@@ -345,6 +345,57 @@ int TVMGraphExecutorGraphAttr_Load(TVMGraphExecutorGraphAttr* attr, JSONReader*
         break;
       }
       bitmask |= 2;
+    } else if (!strcmp(key, "storage_offset")) {
+      // Optional static memory plan emitted by the graph executor codegen.
+      reader->BeginArray(reader);
+      if (!(reader->NextArrayItem(reader))) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      status = reader->ReadString(reader, type, sizeof(type));
+      if (status != 0) {
+        fprintf(stderr, "error reading storage_offset array item");
+      }
+      if (strcmp(type, "list_int")) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      if (!(reader->NextArrayItem(reader))) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
+      reader->BeginArray(reader);
+      size_t num_items = 0;
+      if (reader->ArrayLength(reader, &num_items) != 0) {
+        fprintf(stderr, "error determing list_int length\n");
+        status = -1;
+        break;
+      }
+      DLDevice dev = {kDLCPU, 0};
+      tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(uint32_t) * num_items, dev,
+                                                      (void**)&attr->storage_offset);
+      if (err != kTvmErrorNoError) {
+        fprintf(stderr, "memory allocate error: %08x", err);
+        return -1;
+      }
+      uint32_t storage_offset_count = 0;
+      while (reader->NextArrayItem(reader)) {
+        if (storage_offset_count == num_items) {
+          fprintf(stderr, "array too big\n");
+          status = -1;
+          return status;
+        }
+        reader->ReadUnsignedInteger(reader, &(attr->storage_offset[storage_offset_count]));
+        storage_offset_count++;
+      }
+      if (reader->NextArrayItem(reader)) {
+        fprintf(stderr, "Invalid json format\n");
+        status = -1;
+        break;
+      }
     } else if (!strcmp(key, "shape")) {
       reader->BeginArray(reader);
       if (!(reader->NextArrayItem(reader))) {
@@ -532,6 +583,14 @@ int TVMGraphExecutorGraphAttr_Release(TVMGraphExecutorGraphAttr* attr) {
       return -1;
     }
   }
+  if (attr->storage_offset) {
+    DLDevice dev = {kDLCPU, 0};
+    tvm_crt_error_t err = TVMPlatformMemoryFree(attr->storage_offset, dev);
+    attr->storage_offset = 0;
+    if (err != kTvmErrorNoError) {
+      return -1;
+    }
+  }
   if (attr->device_index) {
     DLDevice dev = {kDLCPU, 0};
     tvm_crt_error_t err = TVMPlatformMemoryFree(attr->device_index, dev);
@@ -964,9 +1023,44 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     if (sid >= pool_entry_count) {
       pool_entry_count = sid + 1;
     }
+    // device_type is never 0 once an entry was seen; memset left it at 0.
+    int first_seen = (pool_entry[sid].device_type == 0);
     pool_entry[sid].entry_id = idx;
-    pool_entry[sid].size = MAX(pool_entry[sid].size, bytes);
     pool_entry[sid].device_type = device_type;
+    if (attrs->storage_offset != NULL) {
+      // Entries sharing a storage id may sit at distinct planned offsets when
+      // they are views of one buffer (concat inputs, split outputs). Track the
+      // smallest offset as the slot base and keep the largest absolute end in
+      // size; it is rebased once all entries are seen.
+      size_t base = (size_t)attrs->storage_offset[idx];
+      if (first_seen || base < pool_entry[sid].offset) {
+        pool_entry[sid].offset = base;
+      }
+      pool_entry[sid].size = MAX(pool_entry[sid].size, base + bytes);
+    } else {
+      pool_entry[sid].size = MAX(pool_entry[sid].size, bytes);
+    }
+  }
+
+  // When the graph carries a static memory plan, back all storage entries with
+  // one contiguous allocation at the planned offsets. A single page-allocator
+  // request avoids the per-entry page rounding and fragmentation that otherwise
+  // force platforms to over-provision the memory pool. Storage that turns out
+  // to be a linked parameter still occupies its planned slot; the planner
+  // cannot know at compile time which parameters are linked into the binary.
+  if (attrs->storage_offset != NULL) {
+    size_t pool_size = 0;
+    for (idx = 0; idx < pool_entry_count; idx++) {
+      // Rebase size from absolute end to the slot's own extent.
+      pool_entry[idx].size -= pool_entry[idx].offset;
+      pool_size = MAX(pool_size, pool_entry[idx].offset + pool_entry[idx].size);
+    }
+    err = TVMPlatformMemoryAllocate(pool_size, alloc_dev, (void**)&executor->storage_pool_base);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    memset(executor->storage_pool_base, 0, pool_size);
   }
 
   // Allocate the space.
@@ -1003,9 +1097,17 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
           0,
       };
       shape[0] = (pit.size + 3) / 4;
-      int status = TVMNDArray_Empty(1, shape, dtype, dev,
-                                    &executor->storage_pool[executor->storage_pool_count].array);
-      CHECK_EQ(status, 0, "fail to create storage_pool with idx=%d\n", idx);
+      if (executor->storage_pool_base != NULL) {
+        // Place the entry at its planned offset inside the shared pool.
+        TVMNDArray* array = &executor->storage_pool[executor->storage_pool_count].array;
+        int status = TVMNDArray_Create(1, shape, dtype, dev, array);
+        CHECK_EQ(status, 0, "fail to create storage_pool with idx=%d\n", idx);
+        array->dl_tensor.data = executor->storage_pool_base + pit.offset;
+      } else {
+        int status = TVMNDArray_Empty(1, shape, dtype, dev,
+                                      &executor->storage_pool[executor->storage_pool_count].array);
+        CHECK_EQ(status, 0, "fail to create storage_pool with idx=%d\n", idx);
+      }
     }
     executor->storage_pool_count++;
   }
@@ -1027,6 +1129,14 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
                                        attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx],
                                        vtype[idx], &executor->data_entry[idx]);
     CHECK_EQ(status, 0, "fail to create for node with idx=%d, storage_id=%u\n", idx, storage_id);
+    if (attrs->storage_offset != NULL) {
+      // Views of a shared buffer start partway into their storage slot.
+      size_t rel = (size_t)attrs->storage_offset[idx] - pool_entry[storage_id].offset;
+      if (rel != 0) {
+        executor->data_entry[idx].dl_tensor.data =
+            (uint8_t*)executor->data_entry[idx].dl_tensor.data + rel;
+      }
+    }
   }
 
   // Release memory
@@ -1222,12 +1332,24 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
   }
   for (idx = 0; idx < executor->storage_pool_count; ++idx) {
     if (executor->storage_pool[idx].is_linked_param == 0) {
-      status = TVMNDArray_Release(&(executor->storage_pool[idx]).array);
+      if (executor->storage_pool_base != NULL) {
+        // Entry data lives inside the shared pool; only the shape is owned.
+        status = TVMPlatformMemoryFree(executor->storage_pool[idx].array.dl_tensor.shape, dev);
+      } else {
+        status = TVMNDArray_Release(&(executor->storage_pool[idx]).array);
+      }
       if (status != 0) {
         return status;
       }
     }
   }
+  if (executor->storage_pool_base != NULL) {
+    status = TVMPlatformMemoryFree(executor->storage_pool_base, dev);
+    if (status != 0) {
+      return status;
+    }
+    executor->storage_pool_base = NULL;
+  }
   for (idx = 0; idx < executor->data_entry_count; ++idx) {
     status = TVMPlatformMemoryFree(executor->data_entry[idx].dl_tensor.shape, dev);
     if (status != 0) {
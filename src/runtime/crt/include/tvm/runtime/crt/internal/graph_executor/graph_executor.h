@@ -32,6 +32,9 @@
 // Memory pool entry.
 typedef struct TVMGraphExecutorPoolEntry {
   size_t size;
+  // Planned byte offset inside the contiguous storage pool; only valid when
+  // the graph attributes carry a static memory plan.
+  size_t offset;
   int device_type;
   int entry_id;
 } TVMGraphExecutorPoolEntry;
@@ -96,6 +99,9 @@ typedef struct TVMGraphExecutor {
   /*! \brief Common storage pool for all devices. */
   TVMGraphExecutorStorageEntry* storage_pool;
   uint32_t storage_pool_count;
+  /*! \brief Single allocation backing the storage pool when the graph carries a
+   *  static memory plan; NULL when every entry is allocated individually. */
+  uint8_t* storage_pool_base;
   /*! \brief Data entry of each node. */
   TVMNDArray* data_entry;
   uint32_t data_entry_count;
@@ -103,6 +103,12 @@ typedef struct MemoryManager {
   TLB pmap;
   // Free map
   MultiMap free_map;
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+  // Pages currently handed out to callers.
+  size_t pages_in_use;
+  // Highest value of pages_in_use observed since startup.
+  size_t max_pages_in_use;
+#endif
 } MemoryManager;
 
 #ifdef __cplusplus
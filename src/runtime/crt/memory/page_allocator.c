@@ -156,6 +156,12 @@ tvm_crt_error_t PageMemoryManager_Allocate(MemoryManagerInterface* interface, si
     pmap->set(pmap, *out_ptr, &p);
   }
   mgr->interface.vleak_size++;
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+  mgr->pages_in_use += npage;
+  if (mgr->pages_in_use > mgr->max_pages_in_use) {
+    mgr->max_pages_in_use = mgr->pages_in_use;
+  }
+#endif
 #if TVM_CRT_DEBUG > 1
   TVMLogf("allocate: addr=%p, start=%" PRId64 "/%zu, npage=%" PRId64 ", vleak=%d\n", data, start,
           ptable->max_pages, npage, mgr->interface.vleak_size);
@@ -269,6 +275,9 @@ tvm_crt_error_t PageMemoryManager_Free(MemoryManagerInterface* interface, void*
   MultiMap* free_map = &(mgr->free_map);
   free_map->insert(free_map, p->num_pages, p);
   mgr->interface.vleak_size--;
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+  mgr->pages_in_use -= p->num_pages;
+#endif
 #if TVM_CRT_DEBUG > 1
   TVMLogf("release: addr=%p, start=%" PRId64 "/%zu, npage=%zu, vleak=%d", ptr,
           entry->page.ptable_begin, mgr->ptable.max_pages, entry->page.num_pages,
@@ -277,6 +286,14 @@ tvm_crt_error_t PageMemoryManager_Free(MemoryManagerInterface* interface, void*
   return kTvmErrorNoError;
 }
 
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+tvm_crt_error_t PageMemoryManagerPeakBytes(MemoryManagerInterface* interface, size_t* peak_bytes) {
+  MemoryManager* mgr = (MemoryManager*)interface;
+  *peak_bytes = mgr->max_pages_in_use * mgr->ptable.page_size_bytes;
+  return kTvmErrorNoError;
+}
+#endif  // TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+
 tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
                                         size_t memory_pool_size_bytes,
                                         size_t page_size_bytes_log2) {
@@ -326,6 +343,10 @@ tvm_crt_error_t PageMemoryManagerCreate(MemoryManagerInterface** interface, uint
   manager->free_map.end = MultiMap_End;
   manager->free_map.erase = MultiMap_Erase;
   manager->free_map.insert = MultiMap_Insert;
+#ifdef TVM_CRT_PAGE_ALLOCATOR_ENABLE_STATS
+  manager->pages_in_use = 0;
+  manager->max_pages_in_use = 0;
+#endif
 
   return kTvmErrorNoError;
 }
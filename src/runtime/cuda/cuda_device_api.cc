@@ -28,13 +28,387 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "cuda_common.h"
 
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Double-buffered pinned staging pool for pageable host copies.
+ *
+ * Transfers from pageable host memory go through the driver's internal
+ * staging path and run well below PCIe peak. Large copies are instead
+ * pipelined through this pool: one pinned chunk is in flight on the copy
+ * stream while the host fills (or drains) the other. Buffers, events and
+ * the fallback stream are kept per device, lazily created and recycled
+ * across copies in the same way WorkspacePool recycles device workspaces.
+ */
+class CUDAPinnedStagingPool {
+ public:
+  /*! \brief Size of one pinned staging chunk. */
+  static constexpr size_t kChunkBytes = 4 << 20;
+  /*! \brief Minimal copy size that goes through the pipeline. */
+  static constexpr size_t kMinPipelineBytes = 2 * kChunkBytes;
+  /*! \brief Number of staging chunks per device. */
+  static constexpr int kNumBuffers = 2;
+
+  /*!
+   * \brief Copy between pageable host memory and the current device.
+   * \param device_id The already activated device.
+   * \param from The source pointer.
+   * \param to The destination pointer.
+   * \param size Number of bytes, at least kMinPipelineBytes.
+   * \param kind Either cudaMemcpyHostToDevice or cudaMemcpyDeviceToHost.
+   * \param user_stream The caller stream, or nullptr for synchronous copy.
+   */
+  void Copy(int device_id, const void* from, void* to, size_t size, cudaMemcpyKind kind,
+            cudaStream_t user_stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeviceStaging& st = GetStaging(device_id);
+    cudaStream_t stream = user_stream != nullptr ? user_stream : st.stream;
+    if (kind == cudaMemcpyHostToDevice) {
+      int buf = 0;
+      for (size_t offset = 0; offset < size; offset += kChunkBytes) {
+        size_t nbytes = std::min(kChunkBytes, size - offset);
+        // Wait until the previous transfer out of this chunk has finished.
+        CUDA_CALL(cudaEventSynchronize(st.events[buf]));
+        memcpy(st.buffers[buf], static_cast<const char*>(from) + offset, nbytes);
+        CUDA_CALL(cudaMemcpyAsync(static_cast<char*>(to) + offset, st.buffers[buf], nbytes, kind,
+                                  stream));
+        CUDA_CALL(cudaEventRecord(st.events[buf], stream));
+        buf = (buf + 1) % kNumBuffers;
+      }
+      // The pageable source is fully staged; only the internal stream has to
+      // preserve the synchronous contract of a null caller stream.
+      if (user_stream == nullptr) {
+        CUDA_CALL(cudaStreamSynchronize(st.stream));
+      }
+    } else {
+      ICHECK(kind == cudaMemcpyDeviceToHost);
+      std::array<size_t, kNumBuffers> chunk_offset;
+      std::array<size_t, kNumBuffers> chunk_bytes;
+      size_t issued = 0, drained = 0;
+      int issue_buf = 0, drain_buf = 0, inflight = 0;
+      while (drained < size) {
+        while (issued < size && inflight < kNumBuffers) {
+          size_t nbytes = std::min(kChunkBytes, size - issued);
+          CUDA_CALL(cudaMemcpyAsync(st.buffers[issue_buf],
+                                    static_cast<const char*>(from) + issued, nbytes, kind,
+                                    stream));
+          CUDA_CALL(cudaEventRecord(st.events[issue_buf], stream));
+          chunk_offset[issue_buf] = issued;
+          chunk_bytes[issue_buf] = nbytes;
+          issued += nbytes;
+          issue_buf = (issue_buf + 1) % kNumBuffers;
+          ++inflight;
+        }
+        // Drain the oldest chunk while the other one is still in flight.
+        CUDA_CALL(cudaEventSynchronize(st.events[drain_buf]));
+        memcpy(static_cast<char*>(to) + chunk_offset[drain_buf], st.buffers[drain_buf],
+               chunk_bytes[drain_buf]);
+        drained += chunk_bytes[drain_buf];
+        drain_buf = (drain_buf + 1) % kNumBuffers;
+        --inflight;
+      }
+    }
+  }
+
+ private:
+  struct DeviceStaging {
+    void* buffers[kNumBuffers];
+    cudaEvent_t events[kNumBuffers];
+    cudaStream_t stream;
+  };
+
+  DeviceStaging& GetStaging(int device_id) {
+    auto it = staging_.find(device_id);
+    if (it != staging_.end()) return it->second;
+    DeviceStaging st;
+    for (int i = 0; i < kNumBuffers; ++i) {
+      CUDA_CALL(cudaMallocHost(&st.buffers[i], kChunkBytes));
+      CUDA_CALL(cudaEventCreateWithFlags(&st.events[i], cudaEventDisableTiming));
+    }
+    CUDA_CALL(cudaStreamCreate(&st.stream));
+    return staging_.emplace(device_id, st).first->second;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<int, DeviceStaging> staging_;
+};
+
+/*!
+ * \brief Best-fit suballocator over large cudaMalloc slabs.
+ *
+ * cudaMalloc takes a device-wide lock and synchronizes the device, so
+ * allocating every NDArray straight from the driver dominates latency for
+ * dynamic shapes. Device allocations are instead carved out of 32MB slabs
+ * with a best-fit free list and neighbor coalescing; requests of slab size
+ * or more get a dedicated driver allocation that is cached by size on
+ * free. Sitting below AllocDataSpace, the pool serves NDArray,
+ * WorkspacePool and the VM's PooledAllocator alike. When the driver runs
+ * out of memory, idle slabs and cached dedicated allocations are released
+ * and the allocation is retried.
+ */
+class CUDADeviceMemoryPool {
+ public:
+  /*! \brief Allocation granularity, matching the CUDA space alignment. */
+  static constexpr size_t kAlignment = 256;
+  /*! \brief Size of one driver slab. */
+  static constexpr size_t kSlabBytes = 32 << 20;
+
+  void* Alloc(int device_id, size_t nbytes) {
+    nbytes = (nbytes + kAlignment - 1) / kAlignment * kAlignment;
+    if (nbytes == 0) nbytes = kAlignment;
+    std::lock_guard<std::mutex> lock(mutex_);
+    DevicePool& pool = pools_[device_id];
+    ++pool.alloc_count;
+    if (nbytes >= kSlabBytes) {
+      // Reuse a cached dedicated allocation unless it wastes half the space.
+      auto it = pool.idle_dedicated.lower_bound(nbytes);
+      if (it != pool.idle_dedicated.end() && it->first <= nbytes * 2) {
+        void* ptr = it->second;
+        pool.busy_dedicated.emplace(ptr, it->first);
+        pool.bytes_in_use += it->first;
+        pool.idle_dedicated.erase(it);
+        return ptr;
+      }
+      void* ptr = RawAlloc(&pool, nbytes);
+      pool.bytes_reserved += nbytes;
+      pool.bytes_in_use += nbytes;
+      pool.busy_dedicated.emplace(ptr, nbytes);
+      return ptr;
+    }
+    auto it = pool.free_by_size.lower_bound(nbytes);
+    if (it == pool.free_by_size.end()) {
+      NewSlab(&pool);
+      it = pool.free_by_size.lower_bound(nbytes);
+      ICHECK(it != pool.free_by_size.end());
+    }
+    Block* block = it->second;
+    pool.free_by_size.erase(it);
+    block->free = false;
+    if (block->size >= nbytes + kAlignment) {
+      // Split the tail into a new free block.
+      Block* tail = new Block();
+      tail->ptr = block->ptr + nbytes;
+      tail->size = block->size - nbytes;
+      tail->free = true;
+      tail->prev = block;
+      tail->next = block->next;
+      if (tail->next != nullptr) tail->next->prev = tail;
+      block->next = tail;
+      block->size = nbytes;
+      tail->free_it = pool.free_by_size.emplace(tail->size, tail);
+    }
+    pool.busy.emplace(block->ptr, block);
+    pool.bytes_in_use += block->size;
+    return block->ptr;
+  }
+
+  void Free(int device_id, void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DevicePool& pool = pools_[device_id];
+    auto dit = pool.busy_dedicated.find(ptr);
+    if (dit != pool.busy_dedicated.end()) {
+      pool.bytes_in_use -= dit->second;
+      pool.idle_dedicated.emplace(dit->second, ptr);
+      pool.busy_dedicated.erase(dit);
+      return;
+    }
+    auto bit = pool.busy.find(ptr);
+    ICHECK(bit != pool.busy.end()) << "Attempt to free an unknown device pointer";
+    Block* block = bit->second;
+    pool.busy.erase(bit);
+    pool.bytes_in_use -= block->size;
+    block->free = true;
+    // Coalesce with free neighbors inside the slab.
+    Block* next = block->next;
+    if (next != nullptr && next->free) {
+      pool.free_by_size.erase(next->free_it);
+      block->size += next->size;
+      block->next = next->next;
+      if (block->next != nullptr) block->next->prev = block;
+      delete next;
+    }
+    Block* prev = block->prev;
+    if (prev != nullptr && prev->free) {
+      pool.free_by_size.erase(prev->free_it);
+      prev->size += block->size;
+      prev->next = block->next;
+      if (prev->next != nullptr) prev->next->prev = prev;
+      delete block;
+      block = prev;
+    }
+    block->free_it = pool.free_by_size.emplace(block->size, block);
+  }
+
+  /*! \brief Snapshot the per device usage counters as profiling metrics. */
+  Map<String, ObjectRef> Stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Map<String, ObjectRef> metrics;
+    for (const auto& kv : pools_) {
+      std::string prefix = "device" + std::to_string(kv.first) + ".";
+      const DevicePool& pool = kv.second;
+      metrics.Set(prefix + "alloc_count",
+                  ObjectRef(make_object<profiling::CountNode>(pool.alloc_count)));
+      metrics.Set(prefix + "raw_alloc_count",
+                  ObjectRef(make_object<profiling::CountNode>(pool.raw_alloc_count)));
+      metrics.Set(prefix + "bytes_in_use",
+                  ObjectRef(make_object<profiling::CountNode>(pool.bytes_in_use)));
+      metrics.Set(prefix + "bytes_reserved",
+                  ObjectRef(make_object<profiling::CountNode>(pool.bytes_reserved)));
+    }
+    return metrics;
+  }
+
+ private:
+  struct Block {
+    char* ptr{nullptr};
+    size_t size{0};
+    bool free{false};
+    Block* prev{nullptr};
+    Block* next{nullptr};
+    std::multimap<size_t, Block*>::iterator free_it;
+  };
+
+  struct Slab {
+    char* base;
+    Block* first;
+  };
+
+  struct DevicePool {
+    std::vector<Slab> slabs;
+    std::multimap<size_t, Block*> free_by_size;
+    std::unordered_map<void*, Block*> busy;
+    std::unordered_map<void*, size_t> busy_dedicated;
+    std::multimap<size_t, void*> idle_dedicated;
+    int64_t alloc_count{0};
+    int64_t raw_alloc_count{0};
+    int64_t bytes_in_use{0};
+    int64_t bytes_reserved{0};
+  };
+
+  void* RawAlloc(DevicePool* pool, size_t nbytes) {
+    void* ret;
+    cudaError_t err = cudaMalloc(&ret, nbytes);
+    if (err == cudaErrorMemoryAllocation) {
+      // Give the memory sitting idle in the pool back to the driver
+      // and try once more before reporting out of memory.
+      cudaGetLastError();
+      PurgeIdle(pool);
+      err = cudaMalloc(&ret, nbytes);
+    }
+    if (err != cudaSuccess) {
+      LOG(FATAL) << "CUDA: cudaMalloc of " << nbytes
+                 << " bytes failed: " << cudaGetErrorString(err);
+    }
+    ++pool->raw_alloc_count;
+    return ret;
+  }
+
+  void NewSlab(DevicePool* pool) {
+    void* base = RawAlloc(pool, kSlabBytes);
+    Block* block = new Block();
+    block->ptr = static_cast<char*>(base);
+    block->size = kSlabBytes;
+    block->free = true;
+    block->free_it = pool->free_by_size.emplace(block->size, block);
+    pool->slabs.push_back(Slab{block->ptr, block});
+    pool->bytes_reserved += kSlabBytes;
+  }
+
+  void PurgeIdle(DevicePool* pool) {
+    for (const auto& kv : pool->idle_dedicated) {
+      CUDA_CALL(cudaFree(kv.second));
+      pool->bytes_reserved -= kv.first;
+    }
+    pool->idle_dedicated.clear();
+    std::vector<Slab> remaining;
+    for (const Slab& slab : pool->slabs) {
+      Block* block = slab.first;
+      if (block->free && block->next == nullptr && block->prev == nullptr) {
+        pool->free_by_size.erase(block->free_it);
+        CUDA_CALL(cudaFree(slab.base));
+        pool->bytes_reserved -= block->size;
+        delete block;
+      } else {
+        remaining.push_back(slab);
+      }
+    }
+    pool->slabs = std::move(remaining);
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<int, DevicePool> pools_;
+};
+
+/*!
+ * \brief Recycling pool of CUDA streams.
+ *
+ * Stream creation and destruction take a device-wide lock inside the
+ * driver, which serializes executors that each manage their own streams.
+ * Released streams are parked per device and priority and handed back on
+ * the next request, the same way WorkspacePool recycles device workspaces.
+ */
+class CUDAStreamPool {
+ public:
+  /*! \brief Maximal number of idle streams kept per device and priority. */
+  static constexpr size_t kMaxIdleStreams = 32;
+
+  cudaStream_t Acquire(int device_id, int priority) {
+    // Clamp to the device range; numerically lower values run at higher
+    // priority and 0 is always valid.
+    int least, greatest;
+    CUDA_CALL(cudaDeviceGetStreamPriorityRange(&least, &greatest));
+    priority = std::min(std::max(priority, greatest), least);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<cudaStream_t>& idle = idle_[Key(device_id, priority)];
+      if (!idle.empty()) {
+        cudaStream_t stream = idle.back();
+        idle.pop_back();
+        return stream;
+      }
+    }
+    cudaStream_t stream;
+    CUDA_CALL(cudaStreamCreateWithPriority(&stream, cudaStreamDefault, priority));
+    return stream;
+  }
+
+  void Release(int device_id, cudaStream_t stream) {
+    // Drain pending work so the next owner does not inherit dependencies.
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    int priority = 0;
+    CUDA_CALL(cudaStreamGetPriority(stream, &priority));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<cudaStream_t>& idle = idle_[Key(device_id, priority)];
+      if (idle.size() < kMaxIdleStreams) {
+        idle.push_back(stream);
+        return;
+      }
+    }
+    CUDA_CALL(cudaStreamDestroy(stream));
+  }
+
+ private:
+  static uint64_t Key(int device_id, int priority) {
+    return (static_cast<uint64_t>(device_id) << 32) | static_cast<uint32_t>(priority);
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<cudaStream_t>> idle_;
+};
+
 class CUDADeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final { CUDA_CALL(cudaSetDevice(dev.device_id)); }
@@ -113,6 +487,9 @@ class CUDADeviceAPI final : public DeviceAPI {
     void* ret;
     if (dev.device_type == kDLCUDAHost) {
       CUDA_CALL(cudaMallocHost(&ret, nbytes));
+    } else if (MemoryPoolEnabled()) {
+      CUDA_CALL(cudaSetDevice(dev.device_id));
+      ret = memory_pool_.Alloc(dev.device_id, nbytes);
     } else {
       CUDA_CALL(cudaSetDevice(dev.device_id));
       CUDA_CALL(cudaMalloc(&ret, nbytes));
@@ -123,12 +500,18 @@ class CUDADeviceAPI final : public DeviceAPI {
   void FreeDataSpace(Device dev, void* ptr) final {
     if (dev.device_type == kDLCUDAHost) {
       CUDA_CALL(cudaFreeHost(ptr));
+    } else if (MemoryPoolEnabled()) {
+      CUDA_CALL(cudaSetDevice(dev.device_id));
+      memory_pool_.Free(dev.device_id, ptr);
     } else {
       CUDA_CALL(cudaSetDevice(dev.device_id));
       CUDA_CALL(cudaFree(ptr));
     }
   }
 
+  /*! \brief Usage counters of the device memory pool. */
+  Map<String, ObjectRef> MemoryPoolStats() { return memory_pool_.Stats(); }
+
  protected:
   void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset, size_t size,
                       Device dev_from, Device dev_to, DLDataType type_hint,
@@ -160,27 +543,34 @@ class CUDADeviceAPI final : public DeviceAPI {
       }
     } else if (dev_from.device_type == kDLCUDA && dev_to.device_type == kDLCPU) {
       CUDA_CALL(cudaSetDevice(dev_from.device_id));
-      GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
+      if (UsePinnedStaging(to, size)) {
+        staging_pool_.Copy(dev_from.device_id, from, to, size, cudaMemcpyDeviceToHost, cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
+      }
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLCUDA) {
       CUDA_CALL(cudaSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      if (UsePinnedStaging(from, size)) {
+        staging_pool_.Copy(dev_to.device_id, from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      }
     } else {
       LOG(FATAL) << "expect copy from/to GPU or between GPU";
     }
   }
 
  public:
-  TVMStreamHandle CreateStream(Device dev) {
+  TVMStreamHandle CreateStream(Device dev) { return CreateStream(dev, 0); }
+
+  TVMStreamHandle CreateStream(Device dev, int priority) final {
     CUDA_CALL(cudaSetDevice(dev.device_id));
-    cudaStream_t retval;
-    CUDA_CALL(cudaStreamCreate(&retval));
-    return static_cast<TVMStreamHandle>(retval);
+    return static_cast<TVMStreamHandle>(stream_pool_.Acquire(dev.device_id, priority));
   }
 
   void FreeStream(Device dev, TVMStreamHandle stream) {
     CUDA_CALL(cudaSetDevice(dev.device_id));
-    cudaStream_t cu_stream = static_cast<cudaStream_t>(stream);
-    CUDA_CALL(cudaStreamDestroy(cu_stream));
+    stream_pool_.Release(dev.device_id, static_cast<cudaStream_t>(stream));
   }
 
   void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) {
@@ -227,6 +617,44 @@ class CUDADeviceAPI final : public DeviceAPI {
       CUDA_CALL(cudaMemcpy(to, from, size, kind));
     }
   }
+
+  // Whether the host pointer is already known to CUDA, i.e. pinned or managed.
+  static bool IsPinnedHostPtr(const void* ptr) {
+    cudaPointerAttributes attr;
+    if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+      // Unregistered host memory reports an error on older toolkits.
+      cudaGetLastError();
+      return false;
+    }
+#if CUDART_VERSION >= 10000
+    return attr.type != cudaMemoryTypeUnregistered;
+#else
+    return true;
+#endif
+  }
+
+  // The staging pipeline pays off only for large pageable copies; pinned
+  // sources and destinations already transfer at full speed.
+  static bool UsePinnedStaging(const void* host_ptr, size_t size) {
+    static const bool enabled = []() {
+      const char* env = std::getenv("TVM_CUDA_PINNED_STAGING");
+      return env == nullptr || atoi(env) != 0;
+    }();
+    return enabled && size >= CUDAPinnedStagingPool::kMinPipelineBytes &&
+           !IsPinnedHostPtr(host_ptr);
+  }
+
+  static bool MemoryPoolEnabled() {
+    static const bool enabled = []() {
+      const char* env = std::getenv("TVM_CUDA_MEMORY_POOL");
+      return env == nullptr || atoi(env) != 0;
+    }();
+    return enabled;
+  }
+
+  CUDAPinnedStagingPool staging_pool_;
+  CUDAStreamPool stream_pool_;
+  CUDADeviceMemoryPool memory_pool_;
 };
 
 typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
@@ -245,6 +673,10 @@ TVM_REGISTER_GLOBAL("device_api.cuda_host").set_body([](TVMArgs args, TVMRetValu
   *rv = static_cast<void*>(ptr);
 });
 
+TVM_REGISTER_GLOBAL("profiling.cuda_memory_pool_stats").set_body_typed([]() {
+  return CUDADeviceAPI::Global()->MemoryPoolStats();
+});
+
 class GPUTimerNode : public TimerNode {
  public:
   virtual void Start() {
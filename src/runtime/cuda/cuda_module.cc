@@ -113,6 +113,16 @@ class CUDAModuleNode : public runtime::ModuleNode {
     }
     return func;
   }
+  // Eagerly load the per-device CUmodule, which is otherwise JIT-loaded on
+  // the first kernel launch. Callable from a background thread so serving
+  // processes can hide the load latency before the first inference.
+  void WarmUp(int device_id) {
+    CUDA_CALL(cudaSetDevice(device_id));
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (module_[device_id] == nullptr) {
+      CUDA_DRIVER_CALL(cuModuleLoadData(&(module_[device_id]), data_.c_str()));
+    }
+  }
   // get a global var from primary context in device_id
   CUdeviceptr GetGlobal(int device_id, const std::string& global_name, size_t expect_nbytes) {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -237,6 +247,12 @@ PackedFunc CUDAModuleNode::GetFunction(const std::string& name,
   if (name == symbol::tvm_prepare_global_barrier) {
     return PackedFunc(CUDAPrepGlobalBarrier(this, sptr_to_self));
   }
+  if (name == symbol::tvm_module_warm_up) {
+    return PackedFunc([this, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
+      int device_id = args.num_args > 0 ? args[0].operator int() : 0;
+      this->WarmUp(device_id);
+    });
+  }
   auto it = fmap_.find(name);
   if (it == fmap_.end()) return PackedFunc();
   const FunctionInfo& info = it->second;
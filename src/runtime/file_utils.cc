@@ -24,14 +24,28 @@
 
 #include <dmlc/json.h>
 #include <dmlc/memory_io.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(__linux__) || defined(__ANDROID__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TVM_FILE_UTILS_USE_MMAP 1
+#else
+#define TVM_FILE_UTILS_USE_MMAP 0
+#endif
+
 namespace tvm {
 namespace runtime {
 
@@ -214,6 +228,150 @@ std::string SaveParams(const Map<String, NDArray>& params) {
   return bytes;
 }
 
+std::string SaveParamsAligned(const Map<String, NDArray>& params) {
+  std::string bytes;
+  dmlc::MemoryStringStream mstrm(&bytes);
+  dmlc::Stream* strm = &mstrm;
+  std::vector<std::string> names;
+  // keep device arrays alive after the copy to host
+  std::vector<NDArray> arrays;
+  for (auto& p : params) {
+    names.push_back(p.first);
+    NDArray arr = p.second;
+    if (arr->device.device_type != kDLCPU) {
+      arr = arr.CopyTo(Device{kDLCPU, 0});
+    }
+    arrays.push_back(arr);
+  }
+
+  uint64_t header = kTVMNDArrayAlignedListMagic, reserved = 0;
+  strm->Write(header);
+  strm->Write(reserved);
+  strm->Write(names);
+  uint64_t sz = static_cast<uint64_t>(arrays.size());
+  strm->Write(sz);
+  for (const NDArray& arr : arrays) {
+    const DLTensor* tensor = arr.operator->();
+    ICHECK(tensor->strides == nullptr && tensor->byte_offset == 0)
+        << "Aligned parameter save expects compact tensors";
+    strm->Write(tensor->dtype);
+    std::vector<int64_t> shape(tensor->shape, tensor->shape + tensor->ndim);
+    strm->Write(shape);
+    uint64_t nbytes = GetDataSize(*tensor);
+    strm->Write(nbytes);
+    // pad so the payload starts at a kAllocAlignment boundary in the file
+    uint8_t zero = 0;
+    while (bytes.size() % kAllocAlignment != 0) {
+      strm->Write(zero);
+    }
+    strm->Write(tensor->data, nbytes);
+  }
+  return bytes;
+}
+
+MmapFile::~MmapFile() {
+#if TVM_FILE_UTILS_USE_MMAP
+  if (base_ != nullptr) munmap(base_, size_);
+#endif
+}
+
+std::shared_ptr<MmapFile> MmapFile::Open(const std::string& file_name) {
+#if TVM_FILE_UTILS_USE_MMAP
+  int fd = open(file_name.c_str(), O_RDONLY);
+  ICHECK_GE(fd, 0) << "Cannot open " << file_name;
+  struct stat st;
+  ICHECK_EQ(fstat(fd, &st), 0) << "Cannot stat " << file_name;
+  auto file = std::make_shared<MmapFile>();
+  file->size_ = static_cast<size_t>(st.st_size);
+  file->base_ = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  ICHECK(file->base_ != MAP_FAILED) << "Cannot mmap " << file_name;
+  return file;
+#else
+  return nullptr;
+#endif
+}
+
+namespace {
+// Deleter for NDArray::Container whose data aliases an MmapFile. The
+// manager_ctx holds a shared_ptr keeping the mapping alive.
+void MmapNDArrayDeleter(Object* obj) {
+  auto* container = static_cast<NDArray::Container*>(obj);
+  delete static_cast<std::shared_ptr<MmapFile>*>(container->manager_ctx);
+  delete container;
+}
+}  // namespace
+
+NDArray NDArrayFromMmap(const std::shared_ptr<MmapFile>& mmap, char* payload,
+                        std::vector<int64_t> shape, DLDataType dtype) {
+  // Alias the payload in place; the array is a read-only view of the file.
+  std::unique_ptr<NDArray::Container> container{
+      new NDArray::Container(payload, std::move(shape), dtype, Device{kDLCPU, 0})};
+  container->manager_ctx = new std::shared_ptr<MmapFile>(mmap);
+  container->SetDeleter(MmapNDArrayDeleter);
+  return NDArray(GetObjectPtr<Object>(container.release()));
+}
+
+namespace {
+// Parse a buffer holding the aligned parameter format. make_array
+// materializes one payload given its (aligned) position and metadata.
+Map<String, NDArray> ParseAlignedParams(
+    char* base, size_t size,
+    std::function<NDArray(char* payload, std::vector<int64_t> shape, DLDataType dtype,
+                          uint64_t nbytes)>
+        make_array) {
+  dmlc::MemoryFixedSizeStream mstrm(base, size);
+  dmlc::Stream* strm = &mstrm;
+  uint64_t header, reserved;
+  ICHECK(strm->Read(&header)) << "Invalid parameters file format";
+  ICHECK(header == kTVMNDArrayAlignedListMagic)
+      << "The blob is not in the aligned parameter format";
+  ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
+  std::vector<std::string> names;
+  ICHECK(strm->Read(&names)) << "Invalid parameters file format";
+  uint64_t sz;
+  ICHECK(strm->Read(&sz)) << "Invalid parameters file format";
+  ICHECK(sz == names.size()) << "Invalid parameters file format";
+
+  Map<String, NDArray> params;
+  for (size_t i = 0; i < sz; ++i) {
+    DLDataType dtype;
+    std::vector<int64_t> shape;
+    uint64_t nbytes;
+    ICHECK(strm->Read(&dtype)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&shape)) << "Invalid parameters file format";
+    ICHECK(strm->Read(&nbytes)) << "Invalid parameters file format";
+    size_t pos = mstrm.Tell();
+    pos = (pos + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment;
+    ICHECK_LE(pos + nbytes, size) << "Invalid parameters file format";
+    params.Set(names[i], make_array(base + pos, std::move(shape), dtype, nbytes));
+    mstrm.Seek(pos + nbytes);
+  }
+  return params;
+}
+}  // namespace
+
+Map<String, NDArray> LoadParamsMmap(const std::string& file_name) {
+  std::shared_ptr<MmapFile> mmap = MmapFile::Open(file_name);
+  if (mmap != nullptr) {
+    return ParseAlignedParams(
+        mmap->data(), mmap->size(),
+        [&mmap](char* payload, std::vector<int64_t> shape, DLDataType dtype, uint64_t nbytes) {
+          return NDArrayFromMmap(mmap, payload, std::move(shape), dtype);
+        });
+  }
+  // No mmap on this platform: fall back to an owned in-memory load.
+  std::string bytes;
+  LoadBinaryFromFile(file_name, &bytes);
+  return ParseAlignedParams(
+      &bytes[0], bytes.size(),
+      [](char* payload, std::vector<int64_t> shape, DLDataType dtype, uint64_t nbytes) {
+        NDArray arr = NDArray::Empty(shape, dtype, Device{kDLCPU, 0});
+        arr.CopyFromBytes(payload, nbytes);
+        return arr;
+      });
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, NDArray>& params) {
   std::string s = ::tvm::runtime::SaveParams(params);
   // copy return array so it is owned by the ret value
@@ -224,6 +382,17 @@ TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, ND
 TVM_REGISTER_GLOBAL("runtime.LoadParams").set_body_typed([](const String& s) {
   return ::tvm::runtime::LoadParams(s);
 });
+TVM_REGISTER_GLOBAL("runtime.SaveParamsAligned")
+    .set_body_typed([](const Map<String, NDArray>& params) {
+      std::string s = ::tvm::runtime::SaveParamsAligned(params);
+      // copy return array so it is owned by the ret value
+      TVMRetValue rv;
+      rv = TVMByteArray{s.data(), s.size()};
+      return rv;
+    });
+TVM_REGISTER_GLOBAL("runtime.LoadParamsMmap").set_body_typed([](const String& file_name) {
+  return ::tvm::runtime::LoadParamsMmap(file_name);
+});
 
 }  // namespace runtime
 }  // namespace tvm
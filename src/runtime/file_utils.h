@@ -26,13 +26,52 @@
 
 #include <tvm/runtime/container.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "meta_data.h"
 
 namespace tvm {
 namespace runtime {
+
+/*!
+ * \brief A read-only memory mapping of a file, kept alive (e.g. through an
+ *        NDArray container's manager_ctx) by every object aliasing its
+ *        contents.
+ */
+class MmapFile {
+ public:
+  ~MmapFile();
+  /*! \brief The mapped bytes. */
+  char* data() const { return static_cast<char*>(base_); }
+  /*! \brief Size of the mapping in bytes. */
+  size_t size() const { return size_; }
+  /*!
+   * \brief Map a file read-only.
+   * \param file_name The file to map.
+   * \return The mapping, or nullptr when mmap is unsupported on this platform.
+   */
+  static std::shared_ptr<MmapFile> Open(const std::string& file_name);
+
+ private:
+  void* base_{nullptr};
+  size_t size_{0};
+};
+
+/*!
+ * \brief Create a CPU NDArray whose data aliases a payload inside a mapped
+ *        file. The array's container keeps the mapping alive.
+ * \param mmap The mapping holding the payload.
+ * \param payload Pointer to the (kAllocAlignment aligned) payload bytes.
+ * \param shape Shape of the array.
+ * \param dtype Data type of the array.
+ * \return The aliasing array.
+ */
+NDArray NDArrayFromMmap(const std::shared_ptr<MmapFile>& mmap, char* payload,
+                        std::vector<int64_t> shape, DLDataType dtype);
+
 /*!
  * \brief Get file format from given file name or format argument.
  * \param file_name The name of the file.
@@ -96,6 +135,8 @@ void LoadMetaDataFromFile(const std::string& file_name,
 void RemoveFile(const std::string& file_name);
 
 constexpr uint64_t kTVMNDArrayListMagic = 0xF7E58D4F05049CB7;
+/*! \brief Magic number for the aligned (mmap-friendly) parameter format. */
+constexpr uint64_t kTVMNDArrayAlignedListMagic = 0xF7E58D4F05049CB8;
 /*!
  * \brief Load parameters from a string.
  * \param param_blob Serialized string of parameters.
@@ -120,6 +161,24 @@ std::string SaveParams(const Map<String, NDArray>& params);
  * \param params Parameters to save.
  */
 void SaveParams(dmlc::Stream* strm, const Map<String, NDArray>& params);
+/*!
+ * \brief Serialize parameters in the aligned format, where every tensor
+ *        payload starts at a kAllocAlignment boundary so that a file holding
+ *        the result can be memory mapped and the payloads referenced in place.
+ * \param params Parameters to save.
+ * \return String containing binary parameter data.
+ */
+std::string SaveParamsAligned(const Map<String, NDArray>& params);
+/*!
+ * \brief Load parameters saved in the aligned format by memory mapping the
+ *        file. The returned arrays alias the (read-only) mapping, so loading
+ *        is bounded by page faults and concurrent processes share one page
+ *        cache copy. Falls back to an in-memory load when mmap is
+ *        unavailable.
+ * \param file_name The file holding aligned parameters.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadParamsMmap(const std::string& file_name);
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_RUNTIME_FILE_UTILS_H_
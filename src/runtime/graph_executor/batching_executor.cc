@@ -0,0 +1,247 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file batching_executor.cc
+ * \brief Runtime module that coalesces concurrent single-sample requests
+ *        into padded batches.
+ *
+ *  The module wraps one or more graph executors built for different batch
+ *  sizes of the same model. Caller threads block in "infer" while a worker
+ *  thread collects requests up to the largest batch size or a deadline,
+ *  runs the smallest variant that fits, and scatters the batch outputs
+ *  back to the waiting callers.
+ */
+#include <tvm/runtime/container.h>
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief A single pending inference request. */
+struct BatchRequest {
+  /*! \brief Input names, shared by every request of one model. */
+  std::vector<std::string> names;
+  /*! \brief One single-sample array per input name. */
+  std::vector<NDArray> inputs;
+  /*! \brief Filled by the worker with one single-sample array per output. */
+  std::vector<NDArray> outputs;
+  /*! \brief Whether the worker finished this request. */
+  bool done{false};
+};
+
+/*! \brief One batch-size variant of the wrapped model. */
+struct BatchVariant {
+  /*! \brief The batch size the executor was built for. */
+  int batch_size;
+  /*! \brief The executor module. */
+  Module mod;
+  /*! \brief Cached packed functions of the executor. */
+  PackedFunc run;
+  PackedFunc get_input;
+  PackedFunc get_output;
+  PackedFunc get_num_outputs;
+};
+
+/*!
+ * \brief Module that batches single-sample requests across caller threads.
+ */
+class BatchingExecutor : public ModuleNode {
+ public:
+  BatchingExecutor(std::vector<BatchVariant> variants, int64_t deadline_us)
+      : variants_(std::move(variants)), deadline_us_(deadline_us) {
+    ICHECK(!variants_.empty());
+    std::sort(variants_.begin(), variants_.end(),
+              [](const BatchVariant& a, const BatchVariant& b) {
+                return a.batch_size < b.batch_size;
+              });
+    max_batch_ = variants_.back().batch_size;
+    worker_ = std::thread([this]() { this->WorkerLoop(); });
+  }
+
+  ~BatchingExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  const char* type_key() const final { return "BatchingExecutor"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "infer") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        // arguments come as name0, array0, name1, array1, ...
+        ICHECK_GE(args.num_args, 2);
+        ICHECK_EQ(args.num_args % 2, 0);
+        auto req = std::make_shared<BatchRequest>();
+        for (int i = 0; i < args.num_args; i += 2) {
+          req->names.push_back(args[i].operator String());
+          req->inputs.push_back(args[i + 1].operator NDArray());
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          queue_.push_back(req);
+        }
+        cv_.notify_all();
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return req->done; });
+        Array<NDArray> outputs(req->outputs.begin(), req->outputs.end());
+        *rv = outputs;
+      });
+    } else if (name == "max_batch") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = max_batch_; });
+    } else {
+      return PackedFunc();
+    }
+  }
+
+ private:
+  void WorkerLoop() {
+    while (true) {
+      std::vector<std::shared_ptr<BatchRequest>> batch;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return !queue_.empty() || !running_; });
+        if (!running_) return;
+        // wait for more requests until the batch is full or the deadline hits
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(deadline_us_);
+        while (static_cast<int>(queue_.size()) < max_batch_) {
+          if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) break;
+          if (!running_) return;
+        }
+        size_t n = std::min(queue_.size(), static_cast<size_t>(max_batch_));
+        batch.assign(queue_.begin(), queue_.begin() + n);
+        queue_.erase(queue_.begin(), queue_.begin() + n);
+      }
+      RunBatch(batch);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& req : batch) {
+          req->done = true;
+        }
+      }
+      cv_.notify_all();
+    }
+  }
+
+  /*! \brief Pick the smallest variant whose batch size fits n requests. */
+  const BatchVariant& PickVariant(size_t n) const {
+    for (const BatchVariant& v : variants_) {
+      if (static_cast<size_t>(v.batch_size) >= n) return v;
+    }
+    return variants_.back();
+  }
+
+  void RunBatch(const std::vector<std::shared_ptr<BatchRequest>>& batch) {
+    const BatchVariant& variant = PickVariant(batch.size());
+    // gather: copy each request's sample into its row of the batched inputs
+    for (size_t i = 0; i < batch[0]->names.size(); ++i) {
+      NDArray batched = variant.get_input(batch[0]->names[i]);
+      ICHECK(batched.defined()) << "Input " << batch[0]->names[i] << " does not exist";
+      size_t row_bytes = GetDataSize(*batched.operator->()) / variant.batch_size;
+      for (size_t r = 0; r < batch.size(); ++r) {
+        const std::shared_ptr<BatchRequest>& req = batch[r];
+        ICHECK_EQ(req->names[i], batch[0]->names[i])
+            << "All requests must supply the same set of inputs";
+        const DLTensor* src = req->inputs[i].operator->();
+        ICHECK_EQ(GetDataSize(*src), row_bytes)
+            << "Input " << req->names[i] << " does not match one batch row";
+        DLTensor dst_row = *batched.operator->();
+        dst_row.byte_offset += r * row_bytes;
+        dst_row.ndim = src->ndim;
+        dst_row.shape = src->shape;
+        NDArray::CopyFromTo(src, &dst_row);
+      }
+    }
+    // rows past batch.size() keep whatever data is in the buffer; their
+    // outputs are never read back.
+    variant.run();
+    // scatter: copy each row of every output back to its request
+    int num_outputs = variant.get_num_outputs();
+    for (int i = 0; i < num_outputs; ++i) {
+      NDArray batched = variant.get_output(i);
+      const DLTensor* btensor = batched.operator->();
+      size_t row_bytes = GetDataSize(*btensor) / variant.batch_size;
+      std::vector<int64_t> row_shape(btensor->shape, btensor->shape + btensor->ndim);
+      row_shape[0] = 1;
+      for (size_t r = 0; r < batch.size(); ++r) {
+        NDArray out = NDArray::Empty(row_shape, btensor->dtype, btensor->device);
+        DLTensor src_row = *btensor;
+        src_row.byte_offset += r * row_bytes;
+        src_row.shape = out.operator->()->shape;
+        NDArray::CopyFromTo(&src_row, out.operator->());
+        batch[r]->outputs.push_back(out);
+      }
+    }
+  }
+
+  /*! \brief The batch-size variants, sorted by ascending batch size. */
+  std::vector<BatchVariant> variants_;
+  /*! \brief How long the worker waits for more requests after the first one. */
+  int64_t deadline_us_;
+  /*! \brief Largest available batch size. */
+  int max_batch_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::shared_ptr<BatchRequest>> queue_;
+  bool running_{true};
+  std::thread worker_;
+};
+
+TVM_REGISTER_GLOBAL("tvm.batching_executor.create").set_body([](TVMArgs args, TVMRetValue* rv) {
+  // The argument order is deadline_us, batch_size0, executor0,
+  // [batch_size1, executor1], ...
+  ICHECK_GE(args.num_args, 3);
+  ICHECK_EQ((args.num_args - 1) % 2, 0);
+  int64_t deadline_us = args[0];
+  std::vector<BatchVariant> variants;
+  for (int i = 1; i < args.num_args; i += 2) {
+    BatchVariant variant;
+    variant.batch_size = args[i];
+    ICHECK_GT(variant.batch_size, 0);
+    variant.mod = args[i + 1].operator Module();
+    variant.run = variant.mod.GetFunction("run");
+    variant.get_input = variant.mod.GetFunction("get_input");
+    variant.get_output = variant.mod.GetFunction("get_output");
+    variant.get_num_outputs = variant.mod.GetFunction("get_num_outputs");
+    ICHECK(variant.run != nullptr) << "The executor module must provide run/get_input/get_output";
+    variants.push_back(variant);
+  }
+  *rv = Module(make_object<BatchingExecutor>(std::move(variants), deadline_us));
+});
+
+}  // namespace runtime
+}  // namespace tvm
@@ -23,6 +23,10 @@
 
 #include <tvm/runtime/registry.h>
 
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
 #include "../../cuda/cuda_common.h"
 #include "../graph_executor.h"
 
@@ -41,13 +45,21 @@ namespace runtime {
  */
 class GraphExecutorCudaGraph : public GraphExecutor {
  public:
+  ~GraphExecutorCudaGraph() {
+    for (auto& kv : capture_cache_) {
+      cudaGraphExecDestroy(kv.second);
+    }
+  }
+
   /*!
    * \brief Begin CUDA graph capture on stream, the stream enters capture mode.
    */
   void StartCapture() {
     const Device& dev = data_entry_[entry_id(0, 0)]->device;
 
-    TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
     TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
 
     CUDA_CALL(cudaStreamBeginCapture(static_cast<cudaStream_t>(capture_stream_),
@@ -55,17 +67,31 @@ class GraphExecutorCudaGraph : public GraphExecutor {
   }
 
   /*!
-   * \brief Launch the instantiated graph on stream
+   * \brief Launch the instantiated graph matching the current input binding.
+   *
+   *  The capture that was recorded with the same input/output binding
+   *  signature is looked up in the cache, so a service that cycles through a
+   *  fixed set of bindings (e.g. one buffer per batch size) captures each of
+   *  them once and gets graph-launch latency afterwards.
    */
   void RunCudaGraph() {
+    auto it = capture_cache_.find(BindingSignature());
+    ICHECK(it != capture_cache_.end())
+        << "No CUDA graph captured for the current input binding; "
+        << "call start_capture/end_capture after (re)binding inputs";
     cudaStream_t cuStream = static_cast<cudaStream_t>(capture_stream_);
-    CUDA_CALL(cudaGraphLaunch(cuda_graph_exec_, cuStream));
+    CUDA_CALL(cudaGraphLaunch(it->second, cuStream));
     CUDA_CALL(cudaStreamSynchronize(cuStream));
   }
 
   /*!
    * \brief End CUDA graph capture on stream, a graph will be created and
    * instantiated.
+   *
+   *  The instantiated graph is cached under the current binding signature.
+   *  When the signature was captured before, the existing executable graph
+   *  is patched in place with cudaGraphExecUpdate where the toolkit supports
+   *  it, which avoids the cost of re-instantiation.
    */
   void EndCapture() {
     cudaGraph_t graph;
@@ -76,7 +102,29 @@ class GraphExecutorCudaGraph : public GraphExecutor {
     CUDA_CALL(cudaGraphGetNodes(graph, nodes, &numNodes));
     LOG(INFO) << "Num of nodes in the cuda graph created using stream capture API = " << numNodes;
 
-    CUDA_CALL(cudaGraphInstantiate(&cuda_graph_exec_, graph, NULL, NULL, 0));
+    std::string sig = BindingSignature();
+    auto it = capture_cache_.find(sig);
+#if CUDART_VERSION >= 10020
+    if (it != capture_cache_.end()) {
+      cudaGraphNode_t error_node;
+      cudaGraphExecUpdateResult update_result;
+      if (cudaGraphExecUpdate(it->second, graph, &error_node, &update_result) == cudaSuccess) {
+        CUDA_CALL(cudaGraphDestroy(graph));
+        return;
+      }
+      // topology changed; fall through and instantiate from scratch.
+      cudaGetLastError();
+    }
+#endif
+    cudaGraphExec_t exec;
+    CUDA_CALL(cudaGraphInstantiate(&exec, graph, NULL, NULL, 0));
+    CUDA_CALL(cudaGraphDestroy(graph));
+    if (it != capture_cache_.end()) {
+      CUDA_CALL(cudaGraphExecDestroy(it->second));
+      it->second = exec;
+    } else {
+      capture_cache_[sig] = exec;
+    }
   }
 
   /*!
@@ -87,10 +135,37 @@ class GraphExecutorCudaGraph : public GraphExecutor {
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self);
 
  private:
+  /*!
+   * \brief Summarize the current input/output binding of the executor.
+   *
+   *  The signature covers the data pointers and shapes of all input and
+   *  output entries, which is exactly what a capture bakes into its kernel
+   *  launch parameters: rebinding via SetInputZeroCopy or a differently
+   *  shaped buffer yields a different signature and thus its own capture.
+   */
+  std::string BindingSignature() const {
+    std::ostringstream os;
+    auto add_entry = [&os, this](uint32_t eid) {
+      const DLTensor* t = data_entry_[eid].operator->();
+      os << reinterpret_cast<uintptr_t>(t->data) << "[";
+      for (int i = 0; i < t->ndim; ++i) {
+        os << t->shape[i] << ",";
+      }
+      os << "];";
+    };
+    for (uint32_t nid : input_nodes_) {
+      add_entry(entry_id(nid, 0));
+    }
+    for (const NodeEntry& e : outputs_) {
+      add_entry(entry_id(e));
+    }
+    return os.str();
+  }
+
   /*! \brief The Cuda stream on which to capture a CUDA graph. */
-  TVMStreamHandle capture_stream_;
-  /*! \brief The captured CUDA graph will be instantiated to this. */
-  cudaGraphExec_t cuda_graph_exec_;
+  TVMStreamHandle capture_stream_{nullptr};
+  /*! \brief Instantiated graphs, one per input/output binding signature. */
+  std::unordered_map<std::string, cudaGraphExec_t> capture_cache_;
 };
 
 PackedFunc GraphExecutorCudaGraph::GetFunction(const std::string& name,
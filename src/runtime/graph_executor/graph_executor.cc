@@ -22,6 +22,7 @@
  */
 #include "graph_executor.h"
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/container.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/ndarray.h>
@@ -31,15 +32,21 @@
 #include <tvm/runtime/serializer.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../file_utils.h"
+#include "../workspace_pool.h"
 
 namespace tvm {
 namespace runtime {
@@ -51,16 +58,171 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
 }
 }  // namespace details
 
+/*!
+ * \brief Process-wide pool of activation buffers shared across graph executors.
+ *
+ *  Executors that opt in (set TVM_GRAPH_EXECUTOR_SHARED_POOL) lease their
+ *  storage pool entries here instead of allocating privately. A buffer may
+ *  back storage ids of several live executors at once, so the activation
+ *  footprint of the process stays near the largest single plan instead of the
+ *  sum. This is only safe when the executors run serially and the outputs of
+ *  one run are consumed before another executor runs.
+ */
+class GraphExecutorSharedPool {
+ public:
+  static GraphExecutorSharedPool* Global() {
+    static GraphExecutorSharedPool* inst = new GraphExecutorSharedPool();
+    return inst;
+  }
+  /*!
+   * \brief Lease a buffer of at least nbytes on the given device.
+   * \param nbytes The requested size in bytes.
+   * \param dev The device the buffer must live on.
+   * \param used Buffers already leased by the calling executor. One buffer
+   *  cannot back two storage ids of the same plan.
+   * \return The leased buffer.
+   */
+  NDArray Lease(size_t nbytes, Device dev, const std::vector<std::pair<Device, NDArray>>& used) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entries = pool_[std::make_pair(static_cast<int>(dev.device_type), dev.device_id)];
+    for (auto it = entries.lower_bound(nbytes); it != entries.end(); ++it) {
+      const NDArray& arr = it->second.buffer;
+      auto in_use = [&arr](const std::pair<Device, NDArray>& kv) { return kv.second.same_as(arr); };
+      if (std::any_of(used.begin(), used.end(), in_use)) continue;
+      ++it->second.lease_count;
+      return arr;
+    }
+    std::vector<int64_t> shape;
+    size_t capacity = (nbytes + 3) / 4 * 4;
+    shape.push_back(static_cast<int64_t>(capacity / 4));
+    NDArray arr = NDArray::Empty(shape, DLDataType{kDLFloat, 32, 1}, dev);
+    entries.emplace(capacity, Entry{arr, 1});
+    return arr;
+  }
+  /*!
+   * \brief Return a leased buffer. The buffer stays cached for later leases.
+   * \param dev The device the buffer lives on.
+   * \param arr The buffer being returned.
+   */
+  void Return(Device dev, const NDArray& arr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entries = pool_[std::make_pair(static_cast<int>(dev.device_type), dev.device_id)];
+    for (auto& kv : entries) {
+      if (kv.second.buffer.same_as(arr)) {
+        ICHECK_GT(kv.second.lease_count, 0);
+        --kv.second.lease_count;
+        return;
+      }
+    }
+    LOG(FATAL) << "Returned buffer was not leased from the shared pool";
+  }
+  /*! \brief Free all buffers that no executor currently leases. */
+  void Trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& dev_entries : pool_) {
+      auto& entries = dev_entries.second;
+      for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.lease_count == 0) {
+          it = entries.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    NDArray buffer;
+    int lease_count{0};
+  };
+  std::mutex mutex_;
+  /*! \brief Buffers per (device_type, device_id), keyed by capacity in bytes. */
+  std::map<std::pair<int, int>, std::multimap<size_t, Entry>> pool_;
+};
+
+GraphExecutor::~GraphExecutor() {
+  for (const auto& kv : leased_storage_) {
+    GraphExecutorSharedPool::Global()->Return(kv.first, kv.second);
+  }
+  for (const auto& kv : copy_streams_) {
+    DeviceAPI::Get(kv.first)->FreeStream(kv.first, kv.second);
+  }
+}
+
+TVMStreamHandle GraphExecutor::GetCopyStream(Device dev) {
+  for (const auto& kv : copy_streams_) {
+    if (kv.first.device_type == dev.device_type && kv.first.device_id == dev.device_id) {
+      return kv.second;
+    }
+  }
+  TVMStreamHandle stream = DeviceAPI::Get(dev)->CreateStream(dev);
+  if (stream != nullptr) {
+    copy_streams_.emplace_back(dev, stream);
+  }
+  return stream;
+}
+
 /*!
  * \brief Run all the operations one by one.
  */
 void GraphExecutor::Run() {
+  profiling::EventRecorder* events = profiling::EventRecorder::Global();
+  if (events->enabled()) {
+    this->RunWithEvents(events);
+    return;
+  }
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
     if (op_execs_[i]) op_execs_[i]();
   }
 }
 
+/*!
+ * \brief Run all the operations, recording one event per op.
+ * \param events The recorder to write to.
+ */
+void GraphExecutor::RunWithEvents(profiling::EventRecorder* events) {
+  if (op_span_ids_.size() != op_execs_.size()) {
+    op_span_ids_.assign(op_execs_.size(), -1);
+    for (size_t i = 0; i < op_execs_.size(); ++i) {
+      if (op_execs_[i]) {
+        op_span_ids_[i] = events->RegisterSpan(nodes_[i].param.func_name);
+      }
+    }
+  }
+  for (size_t i = 0; i < op_execs_.size(); ++i) {
+    if (!op_execs_[i]) continue;
+    const Device& dev = data_entry_[entry_id(i, 0)]->device;
+    int64_t begin_ns = profiling::EventRecorder::Now();
+    op_execs_[i]();
+    events->Record(op_span_ids_[i], begin_ns, profiling::EventRecorder::Now(), dev);
+  }
+}
+
+/*!
+ * \brief Run the operations of a contiguous node range [node_begin, node_end).
+ * \param node_begin The first node id to run.
+ * \param node_end The node id to stop before.
+ */
+void GraphExecutor::RunOpRange(uint32_t node_begin, uint32_t node_end) {
+  ICHECK_LE(node_begin, node_end);
+  ICHECK_LE(node_end, op_execs_.size());
+  for (uint32_t i = node_begin; i < node_end; ++i) {
+    if (op_execs_[i]) op_execs_[i]();
+  }
+}
+
+std::vector<uint32_t> GraphExecutor::GetOpNodes() const {
+  std::vector<uint32_t> op_nodes;
+  for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
+    if (nodes_[nid].op_type != "null") {
+      op_nodes.push_back(nid);
+    }
+  }
+  return op_nodes;
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -73,9 +235,23 @@ void GraphExecutor::Run() {
 void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module module,
                          const std::vector<Device>& devs,
                          const PackedFunc lookup_linked_param_func) {
-  std::istringstream is(graph_json);
-  dmlc::JSONReader reader(&is);
-  this->Load(&reader);
+  bool loaded_binary = false;
+  if (graph_json.size() > sizeof(uint64_t)) {
+    // The graph argument may also hold the pre-parsed binary format,
+    // recognized by its magic number; see GraphJSONToBinary.
+    dmlc::MemoryFixedSizeStream strm(const_cast<char*>(graph_json.data()), graph_json.size());
+    uint64_t magic = 0;
+    if (strm.Read(&magic) && magic == kTVMGraphExecutorGraphMagic) {
+      this->LoadGraphBinary(&strm);
+      loaded_binary = true;
+    }
+  }
+  if (!loaded_binary) {
+    std::istringstream is(graph_json);
+    dmlc::JSONReader reader(&is);
+    this->Load(&reader);
+  }
+  graph_json_ = graph_json;
   module_ = module;
   devices_ = devs;
   lookup_linked_param_ = lookup_linked_param_func;
@@ -112,6 +288,7 @@ void GraphExecutor::SetInput(int index, DLTensor* data_in) {
   ICHECK_LT(static_cast<size_t>(index), input_nodes_.size());
   uint32_t eid = this->entry_id(input_nodes_[index], 0);
   data_entry_[eid].CopyFrom(data_in);
+  this->InvalidateManagedEntry(eid);
 }
 /*!
  * \brief set index-th input to the graph without copying the data.
@@ -138,6 +315,33 @@ void GraphExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
     t->data = data_ref->data;
   }
 }
+/*!
+ * \brief set index-th output to the graph without copying the data.
+ * \param index The output index.
+ * \param data_ref The output data that is referred.
+ */
+void GraphExecutor::SetOutputZeroCopy(int index, DLTensor* data_ref) {
+  ICHECK_LT(static_cast<size_t>(index), outputs_.size());
+  uint32_t eid = this->entry_id(outputs_[index]);
+  const DLTensor* old_t = data_entry_[eid].operator->();
+
+  // check the consistency of output
+  ICHECK_EQ(data_alignment_[eid], details::GetDataAlignment(*data_ref));
+  ICHECK_EQ(reinterpret_cast<size_t>(data_ref->data) % kAllocAlignment, 0);
+  ICHECK_EQ(old_t->ndim, static_cast<size_t>(data_ref->ndim));
+  ICHECK_EQ(old_t->device.device_type, data_ref->device.device_type);
+  ICHECK_EQ(old_t->device.device_id, data_ref->device.device_id);
+  for (auto i = 0; i < data_ref->ndim; ++i) {
+    ICHECK_EQ(old_t->shape[i], data_ref->shape[i]);
+  }
+
+  // Update the data pointer for each argument of each op that produces or
+  // consumes this entry, so the producing kernel writes straight into the
+  // external buffer.
+  for (DLTensor* t : output_dltensors_[eid]) {
+    t->data = data_ref->data;
+  }
+}
 /*!
  * \brief Get the number of outputs
  *
@@ -207,9 +411,179 @@ void GraphExecutor::LoadParams(dmlc::Stream* strm) {
     if (in_idx < 0) continue;
     uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
     data_entry_[eid].CopyFrom(p.second);
+    this->InvalidateManagedEntry(eid);
+    this->RecordParamEntry(eid);
   }
 }
 
+void GraphExecutor::LoadParamsMmap(const std::string& file_name) {
+  Map<String, NDArray> params = ::tvm::runtime::LoadParamsMmap(file_name);
+  bool need_setup = false;
+  for (auto& p : params) {
+    int in_idx = GetInputIndex(p.first);
+    if (in_idx < 0) continue;
+    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    if (managed_params_.count(eid)) {
+      // A managed weight must stay bound to its own host array; copy the
+      // mapped payload instead of aliasing it.
+      data_entry_[eid].CopyFrom(p.second);
+      this->InvalidateManagedEntry(eid);
+    } else if (data_entry_[eid]->device.device_type == kDLCPU) {
+      // alias the mapped (read-only) payload in place of the pool entry,
+      // so cold start is bounded by page faults instead of copies
+      data_entry_[eid] = p.second;
+      const DLTensor* tmp = data_entry_[eid].operator->();
+      data_alignment_[eid] = details::GetDataAlignment(*tmp);
+      need_setup = true;
+    } else {
+      data_entry_[eid].CopyFrom(p.second);
+    }
+    this->RecordParamEntry(eid);
+  }
+  if (need_setup) {
+    this->SetupOpExecs();
+  }
+}
+
+void GraphExecutor::RecordParamEntry(uint32_t eid) {
+  if (std::find(param_eids_.begin(), param_eids_.end(), eid) == param_eids_.end()) {
+    param_eids_.push_back(eid);
+  }
+}
+
+void GraphExecutor::SetManagedStorage(size_t budget_bytes,
+                                      const std::vector<std::string>& names) {
+  managed_budget_bytes_ = budget_bytes;
+  bool changed = false;
+  for (const std::string& name : names) {
+    int in_idx = GetInputIndex(name);
+    ICHECK_GE(in_idx, 0) << "Cannot manage unknown input " << name;
+    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
+    if (managed_params_.count(eid)) continue;
+    const DLTensor* cur = data_entry_[eid].operator->();
+    int sid = attrs_.storage_id[eid];
+    for (size_t i = 0; i < data_entry_.size(); ++i) {
+      ICHECK(i == eid || attrs_.storage_id[i] != sid)
+          << "Cannot manage input " << name << ": its storage is shared with entry " << i;
+    }
+    ManagedParam entry;
+    entry.dev = cur->device;
+    entry.bytes = GetDataSize(*cur);
+    std::vector<int64_t> shape(cur->shape, cur->shape + cur->ndim);
+    entry.host = NDArray::Empty(shape, cur->dtype, Device{kDLCPU, 0});
+    // Preserve a weight that was loaded before the switch.
+    entry.host.CopyFrom(data_entry_[eid]);
+    // Rebind the entry to the host copy and release the device storage, so
+    // the weight holds no device memory until an op asks for it.
+    storage_pool_[sid] = entry.host;
+    data_entry_[eid] = entry.host;
+    data_alignment_[eid] = details::GetDataAlignment(*entry.host.operator->());
+    managed_params_.emplace(eid, std::move(entry));
+    changed = true;
+  }
+  if (changed) {
+    this->SetupOpExecs();
+  }
+}
+
+void GraphExecutor::EnsureManagedResident(const std::vector<uint32_t>& eids) {
+  // Pin the whole working set of the op first, so filling one entry cannot
+  // evict another entry the same op is about to read.
+  for (uint32_t eid : eids) {
+    ManagedParam& entry = managed_params_.at(eid);
+    entry.pinned = true;
+    entry.last_use = ++managed_tick_;
+  }
+  for (uint32_t eid : eids) {
+    ManagedParam& entry = managed_params_.at(eid);
+    if (!entry.device.defined()) {
+      if (managed_budget_bytes_ != 0) {
+        size_t target =
+            entry.bytes < managed_budget_bytes_ ? managed_budget_bytes_ - entry.bytes : 0;
+        this->EvictManagedTo(target);
+      }
+      const DLTensor* host = entry.host.operator->();
+      std::vector<int64_t> shape(host->shape, host->shape + host->ndim);
+      entry.device = NDArray::Empty(shape, host->dtype, entry.dev);
+      entry.device.CopyFrom(entry.host);
+      managed_resident_bytes_ += entry.bytes;
+      // Point every op argument consuming this entry at the fresh copy. The
+      // pointers stay valid until the entry is evicted again.
+      const DLTensor* dtensor = entry.device.operator->();
+      for (DLTensor* t : input_dltensors_[eid]) {
+        t->data = dtensor->data;
+        t->byte_offset = 0;
+        t->device = dtensor->device;
+      }
+    }
+  }
+  for (uint32_t eid : eids) {
+    managed_params_.at(eid).pinned = false;
+  }
+}
+
+void GraphExecutor::EvictManagedTo(size_t target_bytes) {
+  while (managed_resident_bytes_ > target_bytes) {
+    uint32_t victim = 0;
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    bool found = false;
+    for (const auto& kv : managed_params_) {
+      const ManagedParam& entry = kv.second;
+      if (entry.device.defined() && !entry.pinned && entry.last_use < oldest) {
+        oldest = entry.last_use;
+        victim = kv.first;
+        found = true;
+      }
+    }
+    // Everything resident is pinned; let the cache overshoot its budget
+    // rather than evict a weight the current op still needs.
+    if (!found) break;
+    ManagedParam& entry = managed_params_.at(victim);
+    managed_resident_bytes_ -= entry.bytes;
+    entry.device = NDArray();
+  }
+}
+
+void GraphExecutor::InvalidateManagedEntry(uint32_t eid) {
+  auto it = managed_params_.find(eid);
+  if (it != managed_params_.end() && it->second.device.defined()) {
+    // The host copy just became the newer one; drop the stale device copy.
+    managed_resident_bytes_ -= it->second.bytes;
+    it->second.device = NDArray();
+  }
+}
+
+Module GraphExecutor::Fork() {
+  auto exec = make_object<GraphExecutor>();
+  exec->Init(graph_json_, module_, devices_, lookup_linked_param_);
+  // Share the immutable weight storage entries with the replica; only the
+  // activation storage stays private, so N instances cost 1x weights.
+  for (uint32_t eid : param_eids_) {
+    int sid = attrs_.storage_id[eid];
+    exec->storage_pool_[sid] = storage_pool_[sid];
+    exec->data_entry_[eid] = data_entry_[eid];
+    exec->data_alignment_[eid] = data_alignment_[eid];
+    exec->param_eids_.push_back(eid);
+  }
+  // Managed weights share the host copy; each replica caches its own device
+  // copies within its own budget.
+  for (const auto& kv : managed_params_) {
+    uint32_t eid = kv.first;
+    ManagedParam entry = kv.second;
+    entry.device = NDArray();
+    entry.last_use = 0;
+    entry.pinned = false;
+    int sid = attrs_.storage_id[eid];
+    exec->storage_pool_[sid] = entry.host;
+    exec->data_entry_[eid] = entry.host;
+    exec->data_alignment_[eid] = data_alignment_[eid];
+    exec->managed_params_.emplace(eid, std::move(entry));
+  }
+  exec->managed_budget_bytes_ = managed_budget_bytes_;
+  exec->SetupOpExecs();
+  return Module(exec);
+}
+
 void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm) {
   uint64_t header, reserved;
   ICHECK(strm->Read(&header)) << "Invalid parameters file format";
@@ -231,6 +605,7 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
     ICHECK_GT(data_entry_[eid].use_count(), 1);
     const DLTensor* tmp = data_entry_[eid].operator->();
     data_alignment_[eid] = details::GetDataAlignment(*tmp);
+    this->RecordParamEntry(eid);
   }
   this->SetupOpExecs();
 }
@@ -279,6 +654,27 @@ void GraphExecutor::SetupStorage() {
     vtype.push_back(tvm::runtime::String2DLDataType(s_type));
   }
 
+  // Byte offset of each entry inside its storage pool entry. The memory plan
+  // emits pool-absolute offsets and entries of one storage id share a base,
+  // so subtracting the id's minimum recovers the within-storage offset; it is
+  // nonzero only for entries planned as views (concat inputs, split outputs).
+  std::vector<size_t> entry_rel_offset(attrs_.shape.size(), 0);
+  if (!attrs_.storage_offset.empty()) {
+    ICHECK_EQ(attrs_.storage_offset.size(), attrs_.shape.size());
+    std::unordered_map<int, int64_t> sid_min_offset;
+    for (size_t i = 0; i < attrs_.shape.size(); ++i) {
+      int sid = attrs_.storage_id[i];
+      auto it = sid_min_offset.find(sid);
+      if (it == sid_min_offset.end() || attrs_.storage_offset[i] < it->second) {
+        sid_min_offset[sid] = attrs_.storage_offset[i];
+      }
+    }
+    for (size_t i = 0; i < attrs_.shape.size(); ++i) {
+      entry_rel_offset[i] =
+          static_cast<size_t>(attrs_.storage_offset[i] - sid_min_offset[attrs_.storage_id[i]]);
+    }
+  }
+
   // Size and device type of each storage pool entry.
   std::vector<PoolEntry> pool_entry;
   // Find the maximum space size.
@@ -297,7 +693,7 @@ void GraphExecutor::SetupStorage() {
     DLDataType t = vtype[i];
     size_t bits = t.bits * t.lanes;
     ICHECK(bits % 8U == 0U || bits == 1U || bits == 4U);
-    size_t bytes = ((bits + 7U) / 8U) * size;
+    size_t bytes = ((bits + 7U) / 8U) * size + entry_rel_offset[i];
 
     uint32_t sid = static_cast<uint32_t>(storage_id);
     if (sid >= pool_entry.size()) {
@@ -323,6 +719,8 @@ void GraphExecutor::SetupStorage() {
   }
 
   // Allocate the space.
+  const char* shared_pool_flag = std::getenv("TVM_GRAPH_EXECUTOR_SHARED_POOL");
+  bool use_shared_pool = shared_pool_flag != nullptr && std::string(shared_pool_flag) != "0";
   for (const auto& pit : pool_entry) {
     // This for loop is very fast since there are usually only a couple of
     // devices available on the same hardware.
@@ -332,6 +730,10 @@ void GraphExecutor::SetupStorage() {
     Device dev = cit == devices_.end() ? devices_[0] : *cit;
     if (pit.linked_param.defined()) {
       storage_pool_.push_back(pit.linked_param);
+    } else if (use_shared_pool) {
+      NDArray leased = GraphExecutorSharedPool::Global()->Lease(pit.size, dev, leased_storage_);
+      leased_storage_.emplace_back(dev, leased);
+      storage_pool_.push_back(leased);
     } else {
       std::vector<int64_t> shape;
       shape.push_back(static_cast<int64_t>(pit.size + 3) / 4);
@@ -348,6 +750,19 @@ void GraphExecutor::SetupStorage() {
     int storage_id = attrs_.storage_id[i];
     ICHECK_LT(static_cast<size_t>(storage_id), storage_pool_.size());
     data_entry_[i] = storage_pool_[storage_id].CreateView(attrs_.shape[i], vtype[i]);
+    if (entry_rel_offset[i] != 0) {
+      // Entries planned as views start partway into the shared buffer. The
+      // offset is applied to the data pointer rather than DLTensor
+      // byte_offset because compiled kernels assert a zero byte_offset; this
+      // is only valid on devices with a flat address space, which is what the
+      // planner restricts view planning to.
+      DLTensor* view = const_cast<DLTensor*>(data_entry_[i].operator->());
+      int dev_type = static_cast<int>(view->device.device_type);
+      ICHECK(dev_type == kDLCPU || dev_type == kDLCUDA || dev_type == kDLCUDAHost ||
+             dev_type == kDLROCM)
+          << "storage views require a flat device address space";
+      view->data = static_cast<char*>(view->data) + entry_rel_offset[i];
+    }
 
     const DLTensor* tmp = data_entry_[i].operator->();
     data_alignment_[i] = details::GetDataAlignment(*tmp);
@@ -356,12 +771,18 @@ void GraphExecutor::SetupStorage() {
 
 void GraphExecutor::SetupOpExecs() {
   op_execs_.resize(this->GetNumOfNodes());
+  variant_selectors_.clear();
   input_dltensors_.resize(num_node_entries());
+  output_dltensors_.resize(num_node_entries());
   std::unordered_set<uint32_t> input_node_eids;
   for (size_t i = 0; i < input_nodes_.size(); i++) {
     uint32_t nid = input_nodes_[i];
     input_node_eids.insert(entry_id(nid, 0));
   }
+  std::unordered_set<uint32_t> output_node_eids;
+  for (size_t i = 0; i < outputs_.size(); i++) {
+    output_node_eids.insert(entry_id(outputs_[i]));
+  }
 
   // setup the array and requirements.
   for (uint32_t nid = 0; nid < this->GetNumOfNodes(); ++nid) {
@@ -381,12 +802,41 @@ void GraphExecutor::SetupOpExecs() {
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args, inode.inputs.size());
 
+    if (!managed_params_.empty()) {
+      // Stream host-backed weights onto the device right before the op that
+      // consumes them; see SetManagedStorage.
+      std::vector<uint32_t> managed_eids;
+      for (const auto& e : inode.inputs) {
+        uint32_t eid = this->entry_id(e);
+        if (managed_params_.count(eid)) managed_eids.push_back(eid);
+      }
+      if (!managed_eids.empty()) {
+        std::function<void()> fexec = op_execs_[nid];
+        op_execs_[nid] = [this, fexec, managed_eids]() {
+          this->EnsureManagedResident(managed_eids);
+          fexec();
+        };
+      }
+    }
+
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t eid = this->entry_id(inode.inputs[i]);
       // check if op input is model input
       if (input_node_eids.count(eid) > 0) {
         input_dltensors_[eid].push_back(static_cast<DLTensor*>(op_args->arg_values[i].v_handle));
       }
+      // a graph output may also be consumed by a downstream op
+      if (output_node_eids.count(eid) > 0) {
+        output_dltensors_[eid].push_back(static_cast<DLTensor*>(op_args->arg_values[i].v_handle));
+      }
+    }
+    for (uint32_t i = 0; i < inode.param.num_outputs; ++i) {
+      uint32_t eid = this->entry_id(nid, i);
+      // check if op output is model output
+      if (output_node_eids.count(eid) > 0) {
+        output_dltensors_[eid].push_back(
+            static_cast<DLTensor*>(op_args->arg_values[inode.inputs.size() + i].v_handle));
+      }
     }
   }
 }
@@ -418,29 +868,170 @@ GraphExecutor::CreateTVMOp(const TVMOpParam& param, const std::vector<DLTensor>&
     return {[]() {}, arg_ptr};
   } else if (param.func_name == "__copy") {
     // Perform cross device data copy.
-    // Directly copy data from the input to the output.
-    auto fexec = [arg_ptr]() {
+    Device from_dev = arg_ptr->args[0].device;
+    Device to_dev = arg_ptr->args[1].device;
+    if (from_dev.device_type == kDLCPU && to_dev.device_type == kDLCPU) {
+      auto fexec = [arg_ptr]() {
+        DLTensor* from = static_cast<DLTensor*>(arg_ptr->arg_values[0].v_handle);
+        DLTensor* to = static_cast<DLTensor*>(arg_ptr->arg_values[1].v_handle);
+        TVM_CCALL(TVMArrayCopyFromTo(from, to, nullptr));
+      };
+      return {fexec, arg_ptr};
+    }
+    // Issue the copy on a dedicated per-device copy stream, ordered against
+    // the compute stream with events, so host-side segments can keep running
+    // while the device copies and computes.
+    Device dev = from_dev.device_type != kDLCPU ? from_dev : to_dev;
+    bool to_host = to_dev.device_type == kDLCPU;
+    auto fexec = [this, arg_ptr, dev, to_host]() {
       DLTensor* from = static_cast<DLTensor*>(arg_ptr->arg_values[0].v_handle);
       DLTensor* to = static_cast<DLTensor*>(arg_ptr->arg_values[1].v_handle);
-      TVM_CCALL(TVMArrayCopyFromTo(from, to, nullptr));
+      TVMStreamHandle copy_stream = this->GetCopyStream(dev);
+      if (copy_stream == nullptr) {
+        // The device API has no stream support; copy synchronously.
+        TVM_CCALL(TVMArrayCopyFromTo(from, to, nullptr));
+        return;
+      }
+      DeviceAPI* api = DeviceAPI::Get(dev);
+      // The producer's kernels are queued on the compute stream; make the
+      // copy wait for them without blocking the host.
+      api->SyncStreamFromTo(dev, nullptr, copy_stream);
+      TVM_CCALL(TVMArrayCopyFromTo(from, to, copy_stream));
+      if (to_host) {
+        // The destination is host memory read by the next host-side op, so
+        // wait for the copy itself (its producers have already been waited
+        // on by the copy stream).
+        api->StreamSync(dev, copy_stream);
+      } else {
+        // Downstream kernels wait on an event; the host keeps going.
+        api->SyncStreamFromTo(dev, copy_stream, nullptr);
+      }
+    };
+    return {fexec, arg_ptr};
+  }
+
+  // When the module was compiled with relay.backend.kernel_variants, the
+  // alternative lowerings of this kernel live alongside the primary one under
+  // "<name>__variant_<k>" symbols. Dispatch through a selector that can time
+  // the variants online and lock in the fastest (see set_online_tuning).
+  if (module_.GetFunction(param.func_name + "__variant_1", true) != nullptr) {
+    auto selector = std::make_shared<VariantSelector>();
+    selector->name = param.func_name;
+    selector->funcs.push_back(module_.GetFunction(param.func_name, true));
+    ICHECK(selector->funcs[0] != nullptr) << "no such function in module: " << param.func_name;
+    for (int k = 1;; ++k) {
+      PackedFunc variant =
+          module_.GetFunction(param.func_name + "__variant_" + std::to_string(k), true);
+      if (variant == nullptr) break;
+      selector->funcs.push_back(variant);
+    }
+    selector->total_ns.assign(selector->funcs.size(), 0);
+    selector->count.assign(selector->funcs.size(), 0);
+    variant_selectors_.push_back(selector);
+    // All variants write the same outputs, so the timing device is the
+    // device of the first output.
+    Device dev = arg_ptr->args[num_inputs].device;
+    std::string op_name = param.func_name;
+    auto fexec = [this, arg_ptr, selector, dev, op_name]() {
+      TVMRetValue rv;
+      TVMArgs targs(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+                    static_cast<int>(arg_ptr->arg_values.size()));
+      const char* prev_tag = WorkspacePool::SetAttributionTag(op_name.c_str());
+      if (selector->locked || this->online_tuning_rounds_ <= 0) {
+        selector->funcs[selector->chosen].CallPacked(targs, &rv);
+      } else {
+        size_t k = selector->next;
+        selector->next = (k + 1) % selector->funcs.size();
+        profiling::Timer timer = profiling::Timer::Start(dev);
+        selector->funcs[k].CallPacked(targs, &rv);
+        timer->Stop();
+        selector->total_ns[k] += timer->SyncAndGetElapsedNanos();
+        selector->count[k] += 1;
+        bool done = true;
+        for (int c : selector->count) {
+          if (c < this->online_tuning_rounds_) {
+            done = false;
+            break;
+          }
+        }
+        if (done) {
+          size_t best = 0;
+          for (size_t i = 1; i < selector->funcs.size(); ++i) {
+            // Compare mean times without dividing: a/m < b/n  <=>  a*n < b*m.
+            if (selector->total_ns[i] * selector->count[best] <
+                selector->total_ns[best] * selector->count[i]) {
+              best = i;
+            }
+          }
+          selector->chosen = best;
+          selector->locked = true;
+        }
+      }
+      WorkspacePool::SetAttributionTag(prev_tag);
     };
     return {fexec, arg_ptr};
   }
 
+  // Trusted direct call: when the function lives in a library-backed module,
+  // resolve its backend packed C symbol once and call it without going through
+  // the PackedFunc wrapper. The argument arrays are prepared above, so the
+  // per-launch cost reduces to a single indirect call plus the status check.
+  if (PackedFunc flookup = module_.GetFunction(symbol::tvm_lookup_packed_cfunc, true)) {
+    void* faddr = flookup(param.func_name);
+    if (faddr != nullptr) {
+      Module mod = module_;
+      std::string op_name = param.func_name;
+      auto fexec = [arg_ptr, mod, faddr, op_name]() {
+        const char* prev_tag = WorkspacePool::SetAttributionTag(op_name.c_str());
+        TVMValue ret_value;
+        int ret_type_code = kTVMNullptr;
+        int ret = reinterpret_cast<TVMBackendPackedCFunc>(faddr)(
+            arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+            static_cast<int>(arg_ptr->arg_values.size()), &ret_value, &ret_type_code, nullptr);
+        WorkspacePool::SetAttributionTag(prev_tag);
+        ICHECK_EQ(ret, 0) << TVMGetLastError();
+        if (ret_type_code != kTVMNullptr) {
+          TVMRetValue::MoveFromCHost(ret_value, ret_type_code);
+        }
+      };
+      return {fexec, arg_ptr};
+    }
+  }
+
   // Get compiled function from the module that contains both host and device
   // code.
   tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
   ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
 
-  auto fexec = [arg_ptr, pf]() {
+  std::string op_name = param.func_name;
+  auto fexec = [arg_ptr, pf, op_name]() {
+    const char* prev_tag = WorkspacePool::SetAttributionTag(op_name.c_str());
     TVMRetValue rv;
     TVMArgs targs(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
                   static_cast<int>(arg_ptr->arg_values.size()));
     pf.CallPacked(targs, &rv);
+    WorkspacePool::SetAttributionTag(prev_tag);
   };
   return {fexec, arg_ptr};
 }
 
+std::string GraphExecutor::OnlineTuningReport() const {
+  std::ostringstream os;
+  for (const auto& sel : variant_selectors_) {
+    os << sel->name << ":";
+    for (size_t i = 0; i < sel->funcs.size(); ++i) {
+      double mean_us =
+          sel->count[i] ? static_cast<double>(sel->total_ns[i]) / sel->count[i] / 1e3 : 0.0;
+      os << " v" << i << "=" << mean_us << "us(x" << sel->count[i] << ")";
+    }
+    if (sel->locked) {
+      os << " -> v" << sel->chosen;
+    }
+    os << "\n";
+  }
+  return os.str();
+}
+
 PackedFunc GraphExecutor::GetFunction(const std::string& name,
                                       const ObjectPtr<Object>& sptr_to_self) {
   // Return member functions during query.
@@ -462,6 +1053,10 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
         this->SetInputZeroCopy(args[0], args[1]);
       }
     });
+  } else if (name == "set_output_zero_copy") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetOutputZeroCopy(args[0], args[1]);
+    });
   } else if (name == "get_output") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       if (args.num_args == 2) {
@@ -494,6 +1089,13 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
     });
+  } else if (name == "load_params_mmap") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->LoadParamsMmap(args[0].operator std::string());
+    });
+  } else if (name == "fork") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->Fork(); });
   } else if (name == "share_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       const auto& module = args[0].operator Module();
@@ -502,11 +1104,74 @@ PackedFunc GraphExecutor::GetFunction(const std::string& name,
       dmlc::MemoryStringStream strm(const_cast<std::string*>(&param_blob));
       this->ShareParams(dynamic_cast<const GraphExecutor&>(*module.operator->()), &strm);
     });
+  } else if (name == "set_managed_storage") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      // arguments come as budget_bytes, name0, name1, ...
+      ICHECK_GE(args.num_args, 2);
+      std::vector<std::string> names;
+      for (int i = 1; i < args.num_args; ++i) {
+        names.push_back(args[i].operator String());
+      }
+      this->SetManagedStorage(static_cast<size_t>(args[0].operator int64_t()), names);
+    });
+  } else if (name == "set_online_tuning") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->online_tuning_rounds_ = args[0];
+    });
+  } else if (name == "online_tuning_report") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->OnlineTuningReport();
+    });
   } else {
     return PackedFunc();
   }
 }
 
+void GraphExecutor::SaveGraphBinary(dmlc::Stream* strm) const {
+  strm->Write(kTVMGraphExecutorGraphMagic);
+  strm->Write(static_cast<uint64_t>(nodes_.size()));
+  for (const Node& node : nodes_) {
+    node.Save(strm);
+  }
+  strm->Write(input_nodes_);
+  strm->Write(node_row_ptr_);
+  strm->Write(static_cast<uint64_t>(outputs_.size()));
+  for (const NodeEntry& e : outputs_) {
+    e.Save(strm);
+  }
+  attrs_.Save(strm);
+}
+
+void GraphExecutor::LoadGraphBinary(dmlc::Stream* strm) {
+  uint64_t num_nodes;
+  ICHECK(strm->Read(&num_nodes)) << "Invalid binary graph";
+  nodes_.resize(num_nodes);
+  for (Node& node : nodes_) {
+    ICHECK(node.Load(strm)) << "Invalid binary graph";
+  }
+  ICHECK(strm->Read(&input_nodes_)) << "Invalid binary graph";
+  ICHECK(strm->Read(&node_row_ptr_)) << "Invalid binary graph";
+  uint64_t num_outputs;
+  ICHECK(strm->Read(&num_outputs)) << "Invalid binary graph";
+  outputs_.resize(num_outputs);
+  for (NodeEntry& e : outputs_) {
+    ICHECK(e.Load(strm)) << "Invalid binary graph";
+  }
+  ICHECK(attrs_.Load(strm)) << "Invalid binary graph";
+}
+
+std::string GraphExecutor::GraphJSONToBinary(const std::string& graph_json) {
+  // Parse once with the json loader, then dump the parsed tables.
+  auto exec = make_object<GraphExecutor>();
+  std::istringstream is(graph_json);
+  dmlc::JSONReader reader(&is);
+  exec->Load(&reader);
+  std::string blob;
+  dmlc::MemoryStringStream mstrm(&blob);
+  exec->SaveGraphBinary(&mstrm);
+  return blob;
+}
+
 Module GraphExecutorCreate(const std::string& sym_json, const tvm::runtime::Module& m,
                            const std::vector<Device>& devs,
                            const PackedFunc lookup_linked_param_func) {
@@ -547,5 +1212,18 @@ TVM_REGISTER_GLOBAL("tvm.graph_executor.create").set_body([](TVMArgs args, TVMRe
   const auto& devices = GetAllDevice(args, dev_start_arg);
   *rv = GraphExecutorCreate(args[0], args[1], devices, lookup_linked_param_func);
 });
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor.shared_pool_trim").set_body([](TVMArgs args, TVMRetValue* rv) {
+  GraphExecutorSharedPool::Global()->Trim();
+});
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor.graph_json_to_binary")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string blob = GraphExecutor::GraphJSONToBinary(args[0]);
+      TVMByteArray arr;
+      arr.data = blob.data();
+      arr.size = blob.size();
+      *rv = arr;
+    });
 }  // namespace runtime
 }  // namespace tvm
@@ -40,6 +40,10 @@
 namespace tvm {
 namespace runtime {
 
+namespace profiling {
+class EventRecorder;
+}  // namespace profiling
+
 /*! \brief macro to do C API call */
 #define TVM_CCALL(func)                     \
   {                                         \
@@ -47,6 +51,9 @@ namespace runtime {
     ICHECK_EQ(ret, 0) << TVMGetLastError(); \
   }
 
+/*! \brief Magic number that heads the pre-parsed binary graph format. */
+constexpr uint64_t kTVMGraphExecutorGraphMagic = 0x7FDE6D4CE58A92B3;
+
 /*! \brief operator attributes about tvm op */
 struct TVMOpParam {
   std::string func_name;
@@ -71,6 +78,9 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   };
 
  public:
+  /*! \brief destructor, returns leased storage to the shared pool. */
+  ~GraphExecutor();
+
   /*!
    * \brief Get member function to front-end
    * \param name The name of the function.
@@ -84,6 +94,22 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   const char* type_key() const final { return "GraphExecutor"; }
   void Run();
+  /*!
+   * \brief Run all the operations, recording one event per op.
+   * \param events The recorder to write to.
+   */
+  void RunWithEvents(profiling::EventRecorder* events);
+  /*!
+   * \brief Run the operations of a contiguous node range [node_begin, node_end).
+   *  Used by the pipeline executor to run one stage of the graph.
+   * \param node_begin The first node id to run.
+   * \param node_end The node id to stop before.
+   */
+  void RunOpRange(uint32_t node_begin, uint32_t node_end);
+  /*!
+   * \brief Return the node ids that hold executable ops, in topological order.
+   */
+  std::vector<uint32_t> GetOpNodes() const;
 
   /*!
    * \brief Initialize the graph executor with graph and device.
@@ -119,6 +145,12 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param data_ref The input data that is referred.
    */
   void SetInputZeroCopy(int index, DLTensor* data_ref);
+  /*!
+   * \brief set index-th output to the graph without copying the data.
+   * \param index The output index.
+   * \param data_ref The output data that is referred.
+   */
+  void SetOutputZeroCopy(int index, DLTensor* data_ref);
   /*!
    * \brief Get the number of outputs
    *
@@ -161,6 +193,14 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param param_blob A binary blob of parameter.
    */
   void LoadParams(const std::string& param_blob);
+  /*!
+   * \brief Load parameters from a file in the aligned format by memory
+   *  mapping it. CPU-resident parameter entries alias the (read-only)
+   *  mapping in place instead of being copied; device-resident entries are
+   *  copied as usual.
+   * \param file_name The file holding aligned parameters.
+   */
+  void LoadParamsMmap(const std::string& file_name);
 
   /*!
    * \brief Share parameters from pre-existing GraphExecutor instance.
@@ -170,6 +210,42 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   void ShareParams(const GraphExecutor& other, dmlc::Stream* strm);
 
+  /*!
+   * \brief Create a new executor instance of the same graph that shares the
+   *  immutable weight storage entries (the entries previously populated by
+   *  LoadParams/ShareParams) with this instance, while keeping all
+   *  activation storage private. Intended for per-thread replicas of one
+   *  module.
+   * \return The forked executor module.
+   */
+  Module Fork();
+
+  /*!
+   * \brief Back the named weights with host memory and stream them to their
+   *  device on demand.
+   *
+   *  The device copies form an LRU cache bounded by budget_bytes, so a model
+   *  whose weights exceed device memory can still run as long as the largest
+   *  working set of any single op fits. Kernels are unaffected: the op
+   *  arguments are repointed at the cached device copy right before the
+   *  consuming op runs. Call after loading parameters; a later SetInput or
+   *  LoadParams on a managed weight invalidates its device copy.
+   * \param budget_bytes Device cache budget in bytes; 0 means unbounded.
+   * \param names The input names of the weights to manage.
+   */
+  void SetManagedStorage(size_t budget_bytes, const std::vector<std::string>& names);
+
+  /*!
+   * \brief Convert a graph json into the pre-parsed binary graph format.
+   *
+   *  The result can be passed to Init in place of the json. Loading it is a
+   *  single sequential read of the already tokenized tables, skipping the
+   *  json parser entirely.
+   * \param graph_json The graph json.
+   * \return The binary graph blob.
+   */
+  static std::string GraphJSONToBinary(const std::string& graph_json);
+
   /*!
    * \brief Get total number of nodes.
    * \return Total number of nodes.
@@ -207,6 +283,16 @@ class TVM_DLL GraphExecutor : public ModuleNode {
         version = 0;
       }
     }
+    // Binary serializer
+    void Save(dmlc::Stream* strm) const {
+      strm->Write(node_id);
+      strm->Write(index);
+      strm->Write(version);
+    }
+    // Binary loader
+    bool Load(dmlc::Stream* strm) {
+      return strm->Read(&node_id) && strm->Read(&index) && strm->Read(&version);
+    }
   };
   // Node
   struct Node {
@@ -271,10 +357,52 @@ class TVM_DLL GraphExecutor : public ModuleNode {
       }
       ICHECK_EQ(bitmask, 1 | 2 | 4) << "invalid format";
     }
+    // Binary serializer
+    void Save(dmlc::Stream* strm) const {
+      strm->Write(op_type);
+      strm->Write(name);
+      strm->Write(param.func_name);
+      strm->Write(param.num_inputs);
+      strm->Write(param.num_outputs);
+      strm->Write(param.flatten_data);
+      strm->Write(static_cast<uint64_t>(param.attrs.size()));
+      for (const auto& kv : param.attrs) {
+        strm->Write(kv.first);
+        strm->Write(std::string(Downcast<String>(kv.second)));
+      }
+      strm->Write(static_cast<uint64_t>(inputs.size()));
+      for (const NodeEntry& e : inputs) {
+        e.Save(strm);
+      }
+      strm->Write(control_deps);
+    }
+    // Binary loader
+    bool Load(dmlc::Stream* strm) {
+      uint64_t num_attrs, num_inputs;
+      if (!(strm->Read(&op_type) && strm->Read(&name) && strm->Read(&param.func_name) &&
+            strm->Read(&param.num_inputs) && strm->Read(&param.num_outputs) &&
+            strm->Read(&param.flatten_data) && strm->Read(&num_attrs))) {
+        return false;
+      }
+      for (uint64_t i = 0; i < num_attrs; ++i) {
+        std::string key, value;
+        if (!(strm->Read(&key) && strm->Read(&value))) return false;
+        param.attrs[key] = String(value);
+      }
+      if (!strm->Read(&num_inputs)) return false;
+      inputs.resize(num_inputs);
+      for (NodeEntry& e : inputs) {
+        if (!e.Load(strm)) return false;
+      }
+      return strm->Read(&control_deps);
+    }
   };
   struct GraphAttr {
     size_t storage_num_not_alloctaed{0};
     std::vector<int> storage_id;
+    // optional pool byte offset per entry; entries sharing a storage id may
+    // carry different offsets when planned as views of one buffer
+    std::vector<int64_t> storage_offset;
     std::vector<int> device_index;
     std::vector<std::string> dltype;
     std::vector<std::vector<int64_t>> shape;
@@ -319,6 +447,14 @@ class TVM_DLL GraphExecutor : public ModuleNode {
           ICHECK(reader->NextArrayItem());
           reader->Read(&device_index);
           ICHECK(!reader->NextArrayItem());
+        } else if (key == "storage_offset") {
+          reader->BeginArray();
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&type);
+          ICHECK_EQ(type, "list_int");
+          ICHECK(reader->NextArrayItem());
+          reader->Read(&storage_offset);
+          ICHECK(!reader->NextArrayItem());
         } else {
           reader->BeginArray();
           ICHECK(reader->NextArrayItem());
@@ -339,6 +475,19 @@ class TVM_DLL GraphExecutor : public ModuleNode {
       }
       ICHECK_EQ(bitmask, 1 | 2 | 4) << "invalid format";
     }
+    // Binary serializer
+    void Save(dmlc::Stream* strm) const {
+      strm->Write(storage_id);
+      strm->Write(storage_offset);
+      strm->Write(device_index);
+      strm->Write(dltype);
+      strm->Write(shape);
+    }
+    // Binary loader
+    bool Load(dmlc::Stream* strm) {
+      return strm->Read(&storage_id) && strm->Read(&storage_offset) &&
+             strm->Read(&device_index) && strm->Read(&dltype) && strm->Read(&shape);
+    }
   };
   // The graph attribute fields.
   void Load(dmlc::JSONReader* reader) {
@@ -369,6 +518,16 @@ class TVM_DLL GraphExecutor : public ModuleNode {
     }
     ICHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
   }
+  /*!
+   * \brief Save the parsed graph in the pre-parsed binary format.
+   * \param strm The output stream.
+   */
+  void SaveGraphBinary(dmlc::Stream* strm) const;
+  /*!
+   * \brief Load the graph from the pre-parsed binary format.
+   * \param strm The input stream, positioned after the magic number.
+   */
+  void LoadGraphBinary(dmlc::Stream* strm);
   /*! \brief PackedFunc to lookup a linked paramter from a local Module. */
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
@@ -377,6 +536,50 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void SetupStorage();
   /*! \brief Setup the executors. */
   void SetupOpExecs();
+  /*!
+   * \brief Online selection state of an op compiled with multiple kernel
+   *  variants (relay.backend.kernel_variants). While tuning is enabled the
+   *  executor round-robins the variants, timing each invocation, and locks
+   *  in the variant with the lowest mean time once every variant has run
+   *  for the configured number of rounds.
+   */
+  struct VariantSelector {
+    /*! \brief Name of the primary function, used in the report. */
+    std::string name;
+    /*! \brief The variant functions; entry 0 is the primary lowering. */
+    std::vector<PackedFunc> funcs;
+    /*! \brief Accumulated elapsed nanoseconds per variant. */
+    std::vector<int64_t> total_ns;
+    /*! \brief Number of timed invocations per variant. */
+    std::vector<int> count;
+    /*! \brief Next variant to try while tuning. */
+    size_t next{0};
+    /*! \brief Winning variant once locked, else 0. */
+    size_t chosen{0};
+    /*! \brief True once the winner has been locked in. */
+    bool locked{false};
+  };
+  /*!
+   * \brief State of one host-backed weight streamed to its device on demand.
+   *
+   *  The host array is the source of truth; the device array is a cache
+   *  entry created on first use and dropped again when the cache exceeds
+   *  its budget. See SetManagedStorage.
+   */
+  struct ManagedParam {
+    /*! \brief Host-resident copy of the weight, always valid. */
+    NDArray host;
+    /*! \brief Cached device copy; undefined while evicted. */
+    NDArray device;
+    /*! \brief The device the weight is consumed on. */
+    Device dev;
+    /*! \brief Size of the weight in bytes. */
+    size_t bytes{0};
+    /*! \brief Logical time of the last use, for LRU eviction. */
+    uint64_t last_use{0};
+    /*! \brief True while the entry belongs to the op currently being set up. */
+    bool pinned{false};
+  };
   /*!
    * \brief Create an execution function given input.
    * \param attrs The node attributes.
@@ -386,12 +589,46 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    */
   std::pair<std::function<void()>, std::shared_ptr<OpArgs>> CreateTVMOp(
       const TVMOpParam& attrs, const std::vector<DLTensor>& args, size_t num_inputs);
+  /*!
+   * \brief Summarize the per-variant timings collected so far, one line per
+   *  multi-variant op.
+   * \return The human readable report.
+   */
+  std::string OnlineTuningReport() const;
   // Get node entry index.
   uint32_t entry_id(uint32_t nid, uint32_t index) const { return node_row_ptr_[nid] + index; }
   // Get node entry index.
   uint32_t entry_id(const NodeEntry& e) const { return entry_id(e.node_id, e.index); }
   // Number of node entries.
   uint32_t num_node_entries() const { return node_row_ptr_.back(); }
+  // Remember that eid holds a parameter, for storage sharing in Fork.
+  void RecordParamEntry(uint32_t eid);
+  /*!
+   * \brief Make the managed weights consumed by one op device resident,
+   *  evicting least recently used device copies if the cache budget would
+   *  be exceeded, and repoint the recorded op arguments at the copies.
+   * \param eids The managed entry ids consumed by the op about to run.
+   */
+  void EnsureManagedResident(const std::vector<uint32_t>& eids);
+  /*!
+   * \brief Evict unpinned managed device copies, least recently used first,
+   *  until at most target_bytes stay resident.
+   * \param target_bytes The resident byte count to reach.
+   */
+  void EvictManagedTo(size_t target_bytes);
+  /*! \brief Drop the cached device copy of eid, if it is a managed weight. */
+  void InvalidateManagedEntry(uint32_t eid);
+  /*!
+   * \brief Return the dedicated copy stream of a device, creating it lazily.
+   *
+   *  Cross-device __copy nodes are issued on this stream and ordered against
+   *  the compute stream with events, so the host thread does not block on the
+   *  transfer. Returns nullptr when the device API has no stream support, in
+   *  which case the copy falls back to the synchronous path.
+   * \param dev The device owning the copy engine.
+   * \return The copy stream, or nullptr.
+   */
+  TVMStreamHandle GetCopyStream(Device dev);
   /*! \brief The graph nodes. */
   std::vector<Node> nodes_;
   /*! \brief The argument nodes. */
@@ -400,24 +637,48 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::unordered_map<std::string, uint32_t> input_map_;
   /*! \brief Used for quick node input DLTensor* lookup given an input eid. */
   std::vector<std::vector<DLTensor*>> input_dltensors_;
+  /*! \brief Used for quick node output DLTensor* lookup given an output eid. */
+  std::vector<std::vector<DLTensor*>> output_dltensors_;
   /*! \brief Used for quick entry indexing. */
   std::vector<uint32_t> node_row_ptr_;
   /*! \brief Output entries. */
   std::vector<NodeEntry> outputs_;
   /*! \brief Additional graph attributes. */
   GraphAttr attrs_;
+  /*! \brief The graph json this executor was initialized from, kept for Fork. */
+  std::string graph_json_;
+  /*! \brief Entry ids that hold parameters, shared with forked instances. */
+  std::vector<uint32_t> param_eids_;
+  /*! \brief Host-backed weights streamed to the device on demand, by eid. */
+  std::unordered_map<uint32_t, ManagedParam> managed_params_;
+  /*! \brief Device cache budget for managed weights; 0 means unbounded. */
+  size_t managed_budget_bytes_{0};
+  /*! \brief Bytes of managed weights currently device resident. */
+  size_t managed_resident_bytes_{0};
+  /*! \brief Logical clock for LRU bookkeeping of managed weights. */
+  uint64_t managed_tick_{0};
   /*! \brief The code module that contains both host and device code. */
   tvm::runtime::Module module_;
   /*! \brief Execution context of all devices including the host. */
   std::vector<Device> devices_;
   /*! \brief Common storage pool for all devices. */
   std::vector<NDArray> storage_pool_;
+  /*! \brief Storage pool entries leased from the process-wide shared pool. */
+  std::vector<std::pair<Device, NDArray>> leased_storage_;
+  /*! \brief Lazily created per-device copy streams for cross-device __copy nodes. */
+  std::vector<std::pair<Device, TVMStreamHandle>> copy_streams_;
+  /*! \brief Event recorder span id of each op, filled on first recorded run. */
+  std::vector<int> op_span_ids_;
   /*! \brief Data entry of each node. */
   std::vector<NDArray> data_entry_;
   /*! \brief Data alignment of each node. */
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*! \brief Selection state of ops compiled with multiple kernel variants. */
+  std::vector<std::shared_ptr<VariantSelector>> variant_selectors_;
+  /*! \brief Rounds per variant for online tuning; 0 disables timing. */
+  int online_tuning_rounds_{0};
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
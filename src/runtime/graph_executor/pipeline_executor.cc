@@ -0,0 +1,169 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file pipeline_executor.cc
+ */
+#include "pipeline_executor.h"
+
+#include <tvm/runtime/registry.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+PipelineExecutor::~PipelineExecutor() {
+  for (auto& queue : queues_) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    exit_now_ = true;
+    queue->cv.notify_all();
+  }
+  for (auto& worker : workers_) {
+    if (worker.joinable()) worker.join();
+  }
+}
+
+void PipelineExecutor::Init(const std::string& graph_json, tvm::runtime::Module module,
+                            const std::vector<Device>& devs, int num_stages) {
+  ICHECK_GE(num_stages, 1) << "The pipeline needs at least one stage";
+  num_stages_ = num_stages;
+  // Every slot gets a private replica so different requests never share
+  // activation storage while they move through the stages.
+  for (int i = 0; i < num_stages_; ++i) {
+    auto exec = make_object<GraphExecutor>();
+    exec->Init(graph_json, module, devs);
+    replicas_.push_back(exec);
+  }
+  // Partition the executable ops into contiguous stages of roughly equal
+  // op count; the ranges are expressed over node ids so non-op nodes are
+  // skipped for free by RunOpRange.
+  std::vector<uint32_t> op_nodes = replicas_[0]->GetOpNodes();
+  ICHECK_GE(static_cast<int>(op_nodes.size()), num_stages_)
+      << "The graph has fewer ops than pipeline stages";
+  uint32_t node_begin = 0;
+  for (int s = 0; s < num_stages_; ++s) {
+    size_t last_op = op_nodes.size() * (s + 1) / num_stages_ - 1;
+    uint32_t node_end =
+        (s + 1 == num_stages_) ? replicas_[0]->GetNumOfNodes() : op_nodes[last_op] + 1;
+    stage_ranges_.emplace_back(node_begin, node_end);
+    node_begin = node_end;
+  }
+  done_.resize(num_stages_, false);
+  for (int s = 0; s < num_stages_; ++s) {
+    queues_.emplace_back(std::unique_ptr<StageQueue>(new StageQueue()));
+  }
+  for (int s = 0; s < num_stages_; ++s) {
+    workers_.emplace_back([this, s] { this->RunStage(s); });
+  }
+}
+
+Module PipelineExecutor::GetExecutor(int slot) {
+  ICHECK_LT(static_cast<size_t>(slot), replicas_.size());
+  return Module(replicas_[slot]);
+}
+
+void PipelineExecutor::Submit(int slot) {
+  ICHECK_LT(static_cast<size_t>(slot), replicas_.size());
+  {
+    std::lock_guard<std::mutex> lock(done_mutex_);
+    done_[slot] = false;
+  }
+  StageQueue* queue = queues_[0].get();
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  queue->tasks.push(slot);
+  queue->cv.notify_one();
+}
+
+void PipelineExecutor::Wait(int slot) {
+  ICHECK_LT(static_cast<size_t>(slot), replicas_.size());
+  std::unique_lock<std::mutex> lock(done_mutex_);
+  done_cv_.wait(lock, [this, slot] { return done_[slot]; });
+}
+
+void PipelineExecutor::RunStage(int stage) {
+  StageQueue* queue = queues_[stage].get();
+  while (true) {
+    int slot;
+    {
+      std::unique_lock<std::mutex> lock(queue->mutex);
+      queue->cv.wait(lock, [this, queue] { return !queue->tasks.empty() || exit_now_; });
+      if (exit_now_) return;
+      slot = queue->tasks.front();
+      queue->tasks.pop();
+    }
+    replicas_[slot]->RunOpRange(stage_ranges_[stage].first, stage_ranges_[stage].second);
+    if (stage + 1 < num_stages_) {
+      StageQueue* next = queues_[stage + 1].get();
+      std::lock_guard<std::mutex> lock(next->mutex);
+      next->tasks.push(slot);
+      next->cv.notify_one();
+    } else {
+      std::lock_guard<std::mutex> lock(done_mutex_);
+      done_[slot] = true;
+      done_cv_.notify_all();
+    }
+  }
+}
+
+PackedFunc PipelineExecutor::GetFunction(const std::string& name,
+                                         const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "get_executor") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      *rv = this->GetExecutor(args[0]);
+    });
+  } else if (name == "submit") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Submit(args[0]); });
+  } else if (name == "wait") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Wait(args[0]); });
+  } else if (name == "run") {
+    // synchronous convenience path through slot 0
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->Submit(0);
+      this->Wait(0);
+    });
+  } else if (name == "get_num_stages") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumStages(); });
+  } else {
+    return PackedFunc();
+  }
+}
+
+Module PipelineExecutorCreate(const std::string& sym_json, const tvm::runtime::Module& m,
+                              const std::vector<Device>& devs, int num_stages) {
+  auto exec = make_object<PipelineExecutor>();
+  exec->Init(sym_json, m, devs, num_stages);
+  return Module(exec);
+}
+
+TVM_REGISTER_GLOBAL("tvm.pipeline_executor.create").set_body([](TVMArgs args, TVMRetValue* rv) {
+  ICHECK_GE(args.num_args, 5) << "The expected number of arguments for pipeline_executor.create is "
+                                 "at least 5, but it has "
+                              << args.num_args;
+  int num_stages = args[2];
+  const auto& devices = GetAllDevice(args, 3);
+  *rv = PipelineExecutorCreate(args[0], args[1], devices, num_stages);
+});
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Pipelined multi-request executor built on GraphExecutor.
+ * \file pipeline_executor.h
+ */
+#ifndef TVM_RUNTIME_GRAPH_EXECUTOR_PIPELINE_EXECUTOR_H_
+#define TVM_RUNTIME_GRAPH_EXECUTOR_PIPELINE_EXECUTOR_H_
+
+#include <tvm/runtime/packed_func.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Pipelined executor that runs different requests in different graph
+ *  stages concurrently.
+ *
+ *  The graph is partitioned into num_stages contiguous stages, each driven by
+ *  its own worker thread and task queue. Every pipeline slot owns a private
+ *  GraphExecutor replica of the module, so up to num_stages requests can be
+ *  in flight at once: slot r executes stage s while slot r' executes stage
+ *  s - 1. Callers lease a slot, set its inputs through the underlying
+ *  executor, submit it, and wait for completion.
+ */
+class TVM_DLL PipelineExecutor : public ModuleNode {
+ public:
+  ~PipelineExecutor();
+
+  /*!
+   * \brief Get member function to front-end
+   * \param name The name of the function.
+   * \param sptr_to_self The pointer to the module node.
+   * \return The corresponding member function.
+   */
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final;
+
+  /*!
+   * \return The type key of the executor.
+   */
+  const char* type_key() const final { return "PipelineExecutor"; }
+
+  /*!
+   * \brief Initialize the pipeline executor with graph and device.
+   * \param graph_json The execution graph.
+   * \param module The module containing the compiled functions.
+   * \param devs The devices to execute the graph on.
+   * \param num_stages Number of pipeline stages (and slots).
+   */
+  void Init(const std::string& graph_json, tvm::runtime::Module module,
+            const std::vector<Device>& devs, int num_stages);
+
+  /*! \brief Number of pipeline stages. */
+  int NumStages() const { return num_stages_; }
+
+  /*!
+   * \brief Get the executor replica that backs a pipeline slot, so inputs
+   *  and outputs of the slot can be accessed.
+   * \param slot The pipeline slot.
+   */
+  Module GetExecutor(int slot);
+
+  /*!
+   * \brief Submit a slot to the first pipeline stage. The slot's inputs must
+   *  be set and the slot must not already be in flight.
+   * \param slot The pipeline slot.
+   */
+  void Submit(int slot);
+
+  /*!
+   * \brief Block until the submitted slot has passed the last stage.
+   * \param slot The pipeline slot.
+   */
+  void Wait(int slot);
+
+ private:
+  // Per-stage task queue holding the slots waiting for this stage.
+  struct StageQueue {
+    std::queue<int> tasks;
+    std::mutex mutex;
+    std::condition_variable cv;
+  };
+
+  // Worker loop of one stage.
+  void RunStage(int stage);
+
+  // Number of stages (== number of slots).
+  int num_stages_{0};
+  // Node range [first, second) run by each stage.
+  std::vector<std::pair<uint32_t, uint32_t>> stage_ranges_;
+  // One executor replica per pipeline slot.
+  std::vector<ObjectPtr<GraphExecutor>> replicas_;
+  // One queue per stage.
+  std::vector<std::unique_ptr<StageQueue>> queues_;
+  // One worker thread per stage.
+  std::vector<std::thread> workers_;
+  // Completion flags of each slot, guarded by done_mutex_.
+  std::vector<bool> done_;
+  std::mutex done_mutex_;
+  std::condition_variable done_cv_;
+  // Signal for the stage workers to exit.
+  bool exit_now_{false};
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_GRAPH_EXECUTOR_PIPELINE_EXECUTOR_H_
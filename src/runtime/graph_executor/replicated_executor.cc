@@ -0,0 +1,247 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file replicated_executor.cc
+ * \brief Runtime module that replicates one model across devices.
+ *
+ *  One executor is instantiated per device from a single
+ *  GraphExecutorFactory, sharing the host-side graph json and params
+ *  source. Caller threads block in "infer" while per-replica workers
+ *  drain their queues; an idle worker steals work from the other
+ *  replicas so a slow device does not back up the whole pool.
+ */
+#include <tvm/runtime/container.h>
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief A single pending inference request. */
+struct ReplicaRequest {
+  /*! \brief Input names. */
+  std::vector<std::string> names;
+  /*! \brief One array per input name. */
+  std::vector<NDArray> inputs;
+  /*! \brief Filled by the serving replica, one array per output. */
+  std::vector<NDArray> outputs;
+  /*! \brief Whether a replica finished this request. */
+  bool done{false};
+};
+
+/*! \brief One per-device replica of the model. */
+struct Replica {
+  /*! \brief The device this replica runs on. */
+  Device device;
+  /*! \brief The executor module. */
+  Module mod;
+  /*! \brief Cached packed functions of the executor. */
+  PackedFunc set_input;
+  PackedFunc run;
+  PackedFunc get_output;
+  PackedFunc get_num_outputs;
+  /*! \brief Requests assigned to this replica; other workers steal from the back. */
+  std::deque<std::shared_ptr<ReplicaRequest>> queue;
+  /*! \brief Number of requests this replica served. */
+  uint64_t served{0};
+  /*! \brief Number of requests this replica stole from other queues. */
+  uint64_t stolen{0};
+};
+
+/*!
+ * \brief Module that load-balances requests across per-device replicas.
+ */
+class ReplicatedExecutor : public ModuleNode {
+ public:
+  explicit ReplicatedExecutor(std::vector<std::unique_ptr<Replica>> replicas)
+      : replicas_(std::move(replicas)) {
+    ICHECK(!replicas_.empty());
+    for (size_t i = 0; i < replicas_.size(); ++i) {
+      workers_.emplace_back([this, i]() { this->WorkerLoop(i); });
+    }
+  }
+
+  ~ReplicatedExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_all();
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  const char* type_key() const final { return "ReplicatedExecutor"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "infer") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        // arguments come as name0, array0, name1, array1, ...
+        ICHECK_GE(args.num_args, 2);
+        ICHECK_EQ(args.num_args % 2, 0);
+        auto req = std::make_shared<ReplicaRequest>();
+        for (int i = 0; i < args.num_args; i += 2) {
+          req->names.push_back(args[i].operator String());
+          req->inputs.push_back(args[i + 1].operator NDArray());
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          // round-robin initial placement; stealing evens out imbalance
+          replicas_[next_replica_]->queue.push_back(req);
+          next_replica_ = (next_replica_ + 1) % replicas_.size();
+        }
+        cv_.notify_all();
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return req->done; });
+        Array<NDArray> outputs(req->outputs.begin(), req->outputs.end());
+        *rv = outputs;
+      });
+    } else if (name == "num_replicas") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        *rv = static_cast<int>(replicas_.size());
+      });
+    } else if (name == "stats") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->Stats(); });
+    } else {
+      return PackedFunc();
+    }
+  }
+
+ private:
+  void WorkerLoop(size_t index) {
+    Replica* self = replicas_[index].get();
+    while (true) {
+      std::shared_ptr<ReplicaRequest> req;
+      bool stolen = false;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&]() { return !running_ || HasWork(index); });
+        if (!running_) return;
+        if (!self->queue.empty()) {
+          req = self->queue.front();
+          self->queue.pop_front();
+        } else {
+          // steal the most recently queued request of the busiest replica
+          for (size_t i = 1; i < replicas_.size() && req == nullptr; ++i) {
+            Replica* other = replicas_[(index + i) % replicas_.size()].get();
+            if (!other->queue.empty()) {
+              req = other->queue.back();
+              other->queue.pop_back();
+              stolen = true;
+            }
+          }
+        }
+      }
+      if (req == nullptr) continue;
+      Serve(self, req.get());
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        req->done = true;
+        self->served += 1;
+        if (stolen) self->stolen += 1;
+      }
+      cv_.notify_all();
+    }
+  }
+
+  bool HasWork(size_t index) {
+    for (const auto& replica : replicas_) {
+      if (!replica->queue.empty()) return true;
+    }
+    return false;
+  }
+
+  void Serve(Replica* replica, ReplicaRequest* req) {
+    for (size_t i = 0; i < req->names.size(); ++i) {
+      replica->set_input(req->names[i], req->inputs[i]);
+    }
+    replica->run();
+    int num_outputs = replica->get_num_outputs();
+    for (int i = 0; i < num_outputs; ++i) {
+      NDArray out = replica->get_output(i);
+      // hand back a copy so the replica can serve the next request
+      req->outputs.push_back(out.CopyTo(out.operator->()->device));
+    }
+  }
+
+  std::string Stats() {
+    std::ostringstream os;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < replicas_.size(); ++i) {
+      const Replica* r = replicas_[i].get();
+      os << "replica " << i << " dev(" << r->device.device_type << "," << r->device.device_id
+         << "): served=" << r->served << " stolen=" << r->stolen << " pending=" << r->queue.size()
+         << "\n";
+    }
+    return os.str();
+  }
+
+  /*! \brief The per-device replicas. */
+  std::vector<std::unique_ptr<Replica>> replicas_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t next_replica_{0};
+  bool running_{true};
+};
+
+TVM_REGISTER_GLOBAL("tvm.replicated_executor.create").set_body([](TVMArgs args, TVMRetValue* rv) {
+  // The argument order is factory_module, creator_name, dev_type0, dev_id0,
+  // [dev_type1, dev_id1], ...
+  ICHECK_GE(args.num_args, 4);
+  ICHECK_EQ(args.num_args % 2, 0);
+  Module factory = args[0].operator Module();
+  std::string creator_name = args[1].operator String();
+  PackedFunc fcreate = factory.GetFunction(creator_name);
+  ICHECK(fcreate != nullptr) << "Cannot find executor creator " << creator_name
+                             << " in the factory module";
+  std::vector<std::unique_ptr<Replica>> replicas;
+  for (int i = 2; i < args.num_args; i += 2) {
+    auto replica = std::make_unique<Replica>();
+    replica->device.device_type = static_cast<DLDeviceType>(args[i].operator int());
+    replica->device.device_id = args[i + 1];
+    replica->mod = fcreate(replica->device).operator Module();
+    replica->set_input = replica->mod.GetFunction("set_input");
+    replica->run = replica->mod.GetFunction("run");
+    replica->get_output = replica->mod.GetFunction("get_output");
+    replica->get_num_outputs = replica->mod.GetFunction("get_num_outputs");
+    ICHECK(replica->run != nullptr) << "The factory must create graph executor modules";
+    replicas.push_back(std::move(replica));
+  }
+  *rv = Module(make_object<ReplicatedExecutor>(std::move(replicas)));
+});
+
+}  // namespace runtime
+}  // namespace tvm
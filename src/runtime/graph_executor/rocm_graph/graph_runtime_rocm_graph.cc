@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_runtime_rocm_graph.cc
+ */
+
+#include <tvm/runtime/registry.h>
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "../../rocm/rocm_common.h"
+#include "../graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Graph executor with hipGraph support.
+ *
+ *  This is the ROCm sibling of GraphExecutorCudaGraph: the operations issued
+ *  by a run are captured on a dedicated stream into a hipGraph, which replays
+ *  the whole model with a single graph launch instead of per-kernel launches.
+ *  Stream capture requires ROCm 4.3 or above.
+ */
+class GraphExecutorRocmGraph : public GraphExecutor {
+ public:
+  ~GraphExecutorRocmGraph() {
+    for (auto& kv : capture_cache_) {
+      hipGraphExecDestroy(kv.second);
+    }
+  }
+
+  /*!
+   * \brief Begin hipGraph capture on stream, the stream enters capture mode.
+   */
+  void StartCapture() {
+    const Device& dev = data_entry_[entry_id(0, 0)]->device;
+
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
+    TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
+
+    ROCM_CALL(hipStreamBeginCapture(static_cast<hipStream_t>(capture_stream_),
+                                    hipStreamCaptureModeGlobal));
+  }
+
+  /*!
+   * \brief Launch the instantiated graph matching the current input binding.
+   *
+   *  The capture that was recorded with the same input/output binding
+   *  signature is looked up in the cache, so a service that cycles through a
+   *  fixed set of bindings (e.g. one buffer per batch size) captures each of
+   *  them once and gets graph-launch latency afterwards.
+   */
+  void RunRocmGraph() {
+    auto it = capture_cache_.find(BindingSignature());
+    ICHECK(it != capture_cache_.end())
+        << "No hipGraph captured for the current input binding; "
+        << "call start_capture/end_capture after (re)binding inputs";
+    hipStream_t hip_stream = static_cast<hipStream_t>(capture_stream_);
+    ROCM_CALL(hipGraphLaunch(it->second, hip_stream));
+    ROCM_CALL(hipStreamSynchronize(hip_stream));
+  }
+
+  /*!
+   * \brief End hipGraph capture on stream, a graph will be created and
+   * instantiated.
+   *
+   *  The instantiated graph is cached under the current binding signature.
+   *  When the signature was captured before, the existing executable graph
+   *  is patched in place with hipGraphExecUpdate where the toolkit supports
+   *  it, which avoids the cost of re-instantiation.
+   */
+  void EndCapture() {
+    hipGraph_t graph;
+    ROCM_CALL(hipStreamEndCapture(static_cast<hipStream_t>(capture_stream_), &graph));
+
+    hipGraphNode_t* nodes = NULL;
+    size_t numNodes = 0;
+    ROCM_CALL(hipGraphGetNodes(graph, nodes, &numNodes));
+    LOG(INFO) << "Num of nodes in the hip graph created using stream capture API = " << numNodes;
+
+    std::string sig = BindingSignature();
+    auto it = capture_cache_.find(sig);
+#if HIP_VERSION >= 40500000
+    if (it != capture_cache_.end()) {
+      hipGraphNode_t error_node;
+      hipGraphExecUpdateResult update_result;
+      if (hipGraphExecUpdate(it->second, graph, &error_node, &update_result) == hipSuccess) {
+        ROCM_CALL(hipGraphDestroy(graph));
+        return;
+      }
+      // topology changed; fall through and instantiate from scratch.
+      hipGetLastError();
+    }
+#endif
+    hipGraphExec_t exec;
+    ROCM_CALL(hipGraphInstantiate(&exec, graph, NULL, NULL, 0));
+    ROCM_CALL(hipGraphDestroy(graph));
+    if (it != capture_cache_.end()) {
+      ROCM_CALL(hipGraphExecDestroy(it->second));
+      it->second = exec;
+    } else {
+      capture_cache_[sig] = exec;
+    }
+  }
+
+  /*!
+   * \brief GetFunction Get the function based on input.
+   * \param name The function which needs to be invoked.
+   * \param sptr_to_self Packed function pointer.
+   */
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self);
+
+ private:
+  /*!
+   * \brief Summarize the current input/output binding of the executor.
+   *
+   *  The signature covers the data pointers and shapes of all input and
+   *  output entries, which is exactly what a capture bakes into its kernel
+   *  launch parameters: rebinding via SetInputZeroCopy or a differently
+   *  shaped buffer yields a different signature and thus its own capture.
+   */
+  std::string BindingSignature() const {
+    std::ostringstream os;
+    auto add_entry = [&os, this](uint32_t eid) {
+      const DLTensor* t = data_entry_[eid].operator->();
+      os << reinterpret_cast<uintptr_t>(t->data) << "[";
+      for (int i = 0; i < t->ndim; ++i) {
+        os << t->shape[i] << ",";
+      }
+      os << "];";
+    };
+    for (uint32_t nid : input_nodes_) {
+      add_entry(entry_id(nid, 0));
+    }
+    for (const NodeEntry& e : outputs_) {
+      add_entry(entry_id(e));
+    }
+    return os.str();
+  }
+
+  /*! \brief The hip stream on which to capture a hipGraph. */
+  TVMStreamHandle capture_stream_{nullptr};
+  /*! \brief Instantiated graphs, one per input/output binding signature. */
+  std::unordered_map<std::string, hipGraphExec_t> capture_cache_;
+};
+
+PackedFunc GraphExecutorRocmGraph::GetFunction(const std::string& name,
+                                               const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "run_rocm_graph") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->RunRocmGraph(); });
+  } else if (name == "start_capture") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartCapture(); });
+  } else if (name == "end_capture") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->EndCapture(); });
+  } else {
+    return GraphExecutor::GetFunction(name, sptr_to_self);
+  }
+}
+
+Module GraphExecutorRocmGraphCreate(const std::string& sym_json, const tvm::runtime::Module& m,
+                                    const std::vector<Device>& devs,
+                                    PackedFunc lookup_linked_param_func) {
+  auto exec = make_object<GraphExecutorRocmGraph>();
+  exec->Init(sym_json, m, devs, lookup_linked_param_func);
+  return Module(exec);
+}
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor_rocm_graph.create")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_GE(args.num_args, 4)
+          << "The expected number of arguments for graph_executor.create is "
+             "at least 4, but it has "
+          << args.num_args;
+      PackedFunc lookup_linked_param_func;
+      int dev_start_arg = 2;
+      if (args[2].type_code() == kTVMPackedFuncHandle) {
+        lookup_linked_param_func = args[2];
+        dev_start_arg++;
+      }
+
+      *rv = GraphExecutorRocmGraphCreate(args[0], args[1], GetAllDevice(args, dev_start_arg),
+                                         lookup_linked_param_func);
+    });
+}  // namespace runtime
+}  // namespace tvm
@@ -25,6 +25,7 @@
 #include <cstring>
 
 #include "hexagon_module.h"
+#include "hexagon_vtcm_pool.h"
 
 namespace tvm {
 namespace runtime {
@@ -132,13 +133,20 @@ TVM_REGISTER_GLOBAL("device_api.hexagon").set_body([](TVMArgs args, TVMRetValue*
 }  // namespace tvm
 
 // Hexagon-specific runtime functions to allocate/deallocate workspaces
-// in VTCM.
+// in VTCM, and to issue DMA transfers into it. These are emitted as
+// call_extern from TIR (see python/tvm/contrib/hexagon.py).
 extern "C" {
 void* HexagonBackendAllocateVTCM(uint32_t nbytes, uint32_t align) {
   align = std::max(align, 2048u);
-  return tvm::runtime::hexagon::Device::Global()->AllocVtcm(nbytes, align);
+  return tvm::runtime::hexagon::HexagonVtcmPool::Global()->Alloc(nbytes, align);
 }
 void HexagonBackendFreeVTCM(void* ptr) {
-  return tvm::runtime::hexagon::Device::Global()->FreeVtcm(ptr);
+  return tvm::runtime::hexagon::HexagonVtcmPool::Global()->Free(ptr);
+}
+uint32_t HexagonBackendDmaStart(void* dst, const void* src, uint32_t nbytes) {
+  return tvm::runtime::hexagon::HexagonVtcmPool::Global()->DmaStart(dst, src, nbytes);
+}
+void HexagonBackendDmaWait(uint32_t ticket) {
+  return tvm::runtime::hexagon::HexagonVtcmPool::Global()->DmaWait(ticket);
 }
 }
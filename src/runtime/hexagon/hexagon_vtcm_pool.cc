@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "hexagon_vtcm_pool.h"
+
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "hexagon_module.h"
+
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+
+HexagonVtcmPool* HexagonVtcmPool::Global() {
+  // NOTE: explicitly use new to avoid destruction of global state
+  // Global state will be recycled by OS as the process exits.
+  static HexagonVtcmPool* inst = new HexagonVtcmPool();
+  return inst;
+}
+
+HexagonVtcmPool::HexagonVtcmPool() {
+  unsigned pool_kb = 2048;
+  if (const char* env = std::getenv("TVM_HEXAGON_VTCM_POOL_KB")) {
+    pool_kb = static_cast<unsigned>(std::atoi(env));
+  }
+  if (pool_kb == 0) return;  // pool disabled, everything goes to the fallback
+  arena_size_ = pool_kb * 1024;
+  arena_ = static_cast<char*>(Device::Global()->AllocVtcm(arena_size_, kBlockSize));
+  if (arena_ == nullptr) {
+    LOG(WARNING) << "Unable to reserve " << pool_kb << "kB of VTCM for the pool, "
+                 << "falling back to direct allocations";
+    arena_size_ = 0;
+    return;
+  }
+  free_list_.emplace(0u, arena_size_);
+}
+
+void* HexagonVtcmPool::Alloc(unsigned nbytes, unsigned align) {
+  align = std::max(align, kBlockSize);
+  unsigned size = (nbytes + kBlockSize - 1) / kBlockSize * kBlockSize;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // first fit; the arena base is kBlockSize-aligned, so every block
+    // boundary satisfies alignments up to kBlockSize. Larger alignments
+    // take the first block boundary that is also aligned.
+    for (auto it = free_list_.begin(); it != free_list_.end(); ++it) {
+      unsigned begin = it->first;
+      unsigned aligned = (begin + align - 1) / align * align;
+      unsigned pad = aligned - begin;
+      if (it->second < pad || it->second - pad < size) continue;
+      unsigned range_size = it->second;
+      free_list_.erase(it);
+      if (pad != 0) free_list_.emplace(begin, pad);
+      if (range_size - pad - size != 0) {
+        free_list_.emplace(aligned + size, range_size - pad - size);
+      }
+      live_list_.emplace(aligned, size);
+      return arena_ + aligned;
+    }
+  }
+  // The arena is exhausted (or was never reserved); go to the device.
+  void* ptr = Device::Global()->AllocVtcm(nbytes, align);
+  if (ptr != nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fallback_allocs_.insert(ptr);
+  }
+  return ptr;
+}
+
+void HexagonVtcmPool::Free(void* ptr) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto fit = fallback_allocs_.find(ptr);
+    if (fit == fallback_allocs_.end()) {
+      unsigned begin = static_cast<unsigned>(static_cast<char*>(ptr) - arena_);
+      auto it = live_list_.find(begin);
+      ICHECK(it != live_list_.end()) << "Free of unknown VTCM pointer";
+      unsigned size = it->second;
+      live_list_.erase(it);
+      // insert and coalesce with the neighbouring free ranges
+      auto next = free_list_.emplace(begin, size).first;
+      if (next != free_list_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == next->first) {
+          prev->second += next->second;
+          free_list_.erase(next);
+          next = prev;
+        }
+      }
+      auto after = std::next(next);
+      if (after != free_list_.end() && next->first + next->second == after->first) {
+        next->second += after->second;
+        free_list_.erase(after);
+      }
+      return;
+    }
+    fallback_allocs_.erase(fit);
+  }
+  Device::Global()->FreeVtcm(ptr);
+}
+
+uint32_t HexagonVtcmPool::DmaStart(void* dst, const void* src, unsigned len) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The device layer copies synchronously; complete the transfer here and
+  // hand out the ticket so the start/wait contract is already in place
+  // when a descriptor-based DMA engine replaces this.
+  Device::Global()->CopyDeviceToDevice(dst, src, len);
+  return ++dma_ticket_;
+}
+
+void HexagonVtcmPool::DmaWait(uint32_t ticket) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ICHECK_LE(ticket, dma_ticket_) << "Wait on a DMA ticket that was never issued";
+}
+
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TVM_RUNTIME_HEXAGON_HEXAGON_VTCM_POOL_H_
+#define TVM_RUNTIME_HEXAGON_HEXAGON_VTCM_POOL_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+
+/*!
+ * \brief Pool allocator over one VTCM arena, plus a DMA transfer queue.
+ *
+ *  VTCM is a few megabytes of tightly-coupled memory; asking the device
+ *  for it on every workspace request is slow and fragments it quickly.
+ *  The pool reserves a single arena up front (size configurable with
+ *  TVM_HEXAGON_VTCM_POOL_KB) and serves requests from a first-fit free
+ *  list at VTCM-friendly 2048-byte granularity. Requests that do not fit
+ *  fall back to a direct device allocation, so the pool never turns a
+ *  working program into an OOM.
+ *
+ *  The DMA interface splits a copy into start/wait so schedules can
+ *  double-buffer DDR->VTCM transfers against HVX compute. The device
+ *  layer in this tree executes copies synchronously, so DmaStart issues
+ *  the copy immediately and DmaWait is a fence; the split is the stable
+ *  contract that a descriptor-based engine slots into.
+ */
+class HexagonVtcmPool {
+ public:
+  /*! \brief The global pool, created on first use. */
+  static HexagonVtcmPool* Global();
+
+  /*!
+   * \brief Allocate VTCM memory.
+   * \param nbytes  Requested size.
+   * \param align   Requested alignment, raised to at least 2048.
+   * \return Pointer to the allocated memory, or nullptr on failure.
+   */
+  void* Alloc(unsigned nbytes, unsigned align);
+
+  /*!
+   * \brief Release memory previously returned by \ref Alloc.
+   * \param ptr  Pointer to the allocation.
+   */
+  void Free(void* ptr);
+
+  /*!
+   * \brief Start a DMA copy between device-visible buffers.
+   * \param dst  Destination pointer (typically VTCM).
+   * \param src  Source pointer (typically DDR).
+   * \param len  Number of bytes to copy.
+   * \return A ticket to pass to \ref DmaWait.
+   */
+  uint32_t DmaStart(void* dst, const void* src, unsigned len);
+
+  /*!
+   * \brief Block until the copy for the given ticket has completed.
+   * \param ticket  A ticket returned by \ref DmaStart.
+   */
+  void DmaWait(uint32_t ticket);
+
+ private:
+  HexagonVtcmPool();
+
+  /*! \brief Allocation granularity and minimum alignment inside the arena. */
+  static constexpr unsigned kBlockSize = 2048;
+
+  std::mutex mutex_;
+  /*! \brief Base of the reserved arena; nullptr if reservation failed. */
+  char* arena_{nullptr};
+  unsigned arena_size_{0};
+  /*! \brief Free ranges inside the arena, offset -> size, coalesced. */
+  std::map<unsigned, unsigned> free_list_;
+  /*! \brief Sizes of live arena allocations, offset -> size. */
+  std::map<unsigned, unsigned> live_list_;
+  /*! \brief Allocations served directly by the device as a fallback. */
+  std::unordered_set<void*> fallback_allocs_;
+  /*! \brief Ticket of the last completed DMA copy. */
+  uint32_t dma_ticket_{0};
+};
+
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_HEXAGON_HEXAGON_VTCM_POOL_H_
@@ -27,7 +27,9 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/registry.h>
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -42,6 +44,27 @@ class LibraryModuleNode final : public ModuleNode {
   const char* type_key() const final { return "library"; }
 
   PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == runtime::symbol::tvm_lookup_packed_cfunc) {
+      // Hand out the raw symbol address so trusted callers such as the graph
+      // executor can skip the WrapPackedFunc indirection on the hot path.
+      return PackedFunc([this, sptr_to_self](TVMArgs args, TVMRetValue* rv) {
+        *rv = reinterpret_cast<void*>(GetSymbolCached(args[0].operator std::string()));
+      });
+    }
+    TVMBackendPackedCFunc faddr = GetSymbolCached(name);
+    if (faddr == nullptr) return PackedFunc();
+    return WrapPackedFunc(faddr, sptr_to_self);
+  }
+
+ private:
+  // Resolve a symbol through the library, memoizing the result (including
+  // misses) so each name costs one GetSymbol walk instead of one per lookup.
+  TVMBackendPackedCFunc GetSymbolCached(const std::string& name) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = symbol_index_.find(name);
+      if (it != symbol_index_.end()) return it->second;
+    }
     TVMBackendPackedCFunc faddr;
     if (name == runtime::symbol::tvm_module_main) {
       const char* entry_name =
@@ -52,12 +75,16 @@ class LibraryModuleNode final : public ModuleNode {
     } else {
       faddr = reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
     }
-    if (faddr == nullptr) return PackedFunc();
-    return WrapPackedFunc(faddr, sptr_to_self);
+    std::lock_guard<std::mutex> lock(mutex_);
+    symbol_index_.emplace(name, faddr);
+    return faddr;
   }
 
- private:
   ObjectPtr<Library> lib_;
+  /*! \brief Index of resolved symbols, built up as names are looked up. */
+  std::unordered_map<std::string, TVMBackendPackedCFunc> symbol_index_;
+  /*! \brief Protects symbol_index_. */
+  std::mutex mutex_;
 };
 
 /*!
@@ -174,3 +174,17 @@ LogFatal::Entry& LogFatal::GetEntry() {
 }  // namespace runtime
 }  // namespace tvm
 #endif  // TVM_LOG_CUSTOMIZE
+
+namespace tvm {
+namespace runtime {
+namespace detail {
+
+[[noreturn]] void MinimalCheckFailed(const char* file, int lineno, const char* expr) {
+  std::string message = "Check failed: (";
+  message += expr;
+  message += ") is false";
+  throw InternalError(file, lineno, message);
+}
+}  // namespace detail
+}  // namespace runtime
+}  // namespace tvm
@@ -29,6 +29,7 @@
 #import <Metal/MTLCommandBuffer.h>
 #import <Metal/MTLCommandQueue.h>
 #import <Metal/MTLDevice.h>
+#import <Metal/MTLHeap.h>
 #import <Metal/MTLLibrary.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/device_api.h>
@@ -53,20 +54,67 @@ class Stream {
   explicit Stream(id<MTLDevice> device) : error_happened_(false) {
     queue_ = [device newCommandQueue];
   }
-  ~Stream() { [queue_ release]; }
+  ~Stream() {
+    Sync();
+    [queue_ release];
+  }
+  /*!
+   * \brief Get the command buffer new work should be encoded into.
+   *
+   *  The buffer stays open across calls so that back-to-back kernel
+   *  dispatches and copies share a single commit; Commit() or Sync()
+   *  submits the batch. Once kMaxPendingWork encoders accumulate the
+   *  buffer is flushed eagerly to keep the GPU fed while the host keeps
+   *  encoding, mirroring the asynchronous CUDA stream semantics.
+   */
   id<MTLCommandBuffer> GetCommandBuffer() {
-    id<MTLCommandBuffer> cb = [queue_ commandBuffer];
-    [cb addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
-      if (buffer.status == MTLCommandBufferStatusError) SetErrorStatus();
-    }];
-    return cb;
+    if (pending_work_ >= kMaxPendingWork) Commit();
+    if (pending_cb_ == nil) {
+      pending_cb_ = [[queue_ commandBuffer] retain];
+      [pending_cb_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+        if (buffer.status == MTLCommandBufferStatusError) SetErrorStatus();
+      }];
+    }
+    ++pending_work_;
+    return pending_cb_;
+  }
+  /*! \brief Submit the open command buffer without waiting on it. */
+  void Commit() {
+    if (pending_cb_ == nil) return;
+    [pending_cb_ commit];
+    if (last_cb_ != nil) [last_cb_ release];
+    last_cb_ = pending_cb_;
+    pending_cb_ = nil;
+    pending_work_ = 0;
+  }
+  /*!
+   * \brief Wait until all work submitted to this stream has completed.
+   *
+   *  Command buffers on a queue execute in commit order, so waiting on
+   *  the most recently committed one fences everything before it.
+   */
+  void Sync() {
+    Commit();
+    if (last_cb_ != nil) {
+      [last_cb_ waitUntilCompleted];
+      [last_cb_ release];
+      last_cb_ = nil;
+    }
   }
   bool HasErrorHappened() { return error_happened_; }
 
  private:
   void SetErrorStatus() { error_happened_ = true; }
+  // Flush threshold for the open command buffer.
+  static constexpr size_t kMaxPendingWork = 64;
   // Queue
   id<MTLCommandQueue> queue_;
+  // Command buffer that is still collecting work.
+  id<MTLCommandBuffer> pending_cb_ = nil;
+  // The last committed command buffer, kept so Sync() can wait on it.
+  id<MTLCommandBuffer> last_cb_ = nil;
+  // Number of encoders recorded into pending_cb_.
+  size_t pending_work_{0};
   // Check if error happened in one previous run
   bool error_happened_;
 };
@@ -117,8 +165,15 @@ class MetalWorkspace final : public DeviceAPI {
                       TVMStreamHandle stream) final;
 
  private:
+  // Get the heap buffers are sub-allocated from, creating it on first
+  // use. Returns nil if heap allocation is disabled or unavailable.
+  id<MTLHeap> GetHeap(Device dev);
   // Pointers to default allocated streams
   std::vector<Stream*> default_streams_;
+  // Per-device heaps backing AllocDataSpace sub-allocations.
+  std::vector<id<MTLHeap> > heaps_;
+  // Size of the heap to reserve per device; 0 disables heaps.
+  size_t heap_bytes_{0};
 };
 
 /*! \brief Thread local workspace */
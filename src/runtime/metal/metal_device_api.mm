@@ -23,6 +23,7 @@
  */
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/registry.h>
+#include <cstdlib>
 #include "metal_common.h"
 
 namespace tvm {
@@ -120,6 +121,9 @@ int GetWarpSize(id<MTLDevice> dev) {
 }
 
 MetalWorkspace::~MetalWorkspace() {
+  for (auto x : heaps_) {
+    if (x != nil) [x release];
+  }
   for (auto x : devices) {
     [x release];
   }
@@ -133,6 +137,10 @@ void MetalWorkspace::Init() {
   std::lock_guard<std::mutex> lock(this->mutex);
   if (initialized_) return;
   initialized_ = true;
+  heap_bytes_ = 64 * 1024 * 1024;
+  if (const char* env = std::getenv("TVM_METAL_HEAP_SIZE_MB")) {
+    heap_bytes_ = static_cast<size_t>(std::atoll(env)) * 1024 * 1024;
+  }
   if (devices.size() != 0) return;
 #if TARGET_OS_IPHONE
   // on iPhone
@@ -159,6 +167,31 @@ void MetalWorkspace::SetDevice(Device dev) {
   MetalThreadEntry::ThreadLocal()->device.device_id = dev.device_id;
 }
 
+// Heap sub-allocation stays in user space, while newBufferWithLength on
+// the device is a kernel round-trip per tensor. Reserve one heap per
+// device (size configurable with TVM_METAL_HEAP_SIZE_MB, 0 disables it)
+// and serve buffers from it; requests that do not fit take the direct
+// allocation path, so exhausting the heap only costs the fast path.
+id<MTLHeap> MetalWorkspace::GetHeap(Device dev) {
+  if (heap_bytes_ == 0) return nil;
+  std::lock_guard<std::mutex> lock(this->mutex);
+  size_t index = static_cast<size_t>(dev.device_id);
+  if (heaps_.size() <= index) heaps_.resize(index + 1, nil);
+  if (heaps_[index] == nil) {
+    MTLHeapDescriptor* desc = [[MTLHeapDescriptor alloc] init];
+    desc.storageMode = MTLStorageModePrivate;
+    desc.size = heap_bytes_;
+    heaps_[index] = [GetDevice(dev) newHeapWithDescriptor:desc];
+    [desc release];
+    if (heaps_[index] == nil) {
+      LOG(WARNING) << "Unable to reserve a " << (heap_bytes_ >> 20) << "MB Metal heap, "
+                   << "falling back to direct buffer allocations";
+      heap_bytes_ = 0;
+    }
+  }
+  return heaps_[index];
+}
+
 void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignment,
                                      DLDataType type_hint) {
   @autoreleasepool {
@@ -173,7 +206,15 @@ void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignm
     storage_mode = MTLResourceStorageModeManaged;
     #endif
     */
-    id<MTLBuffer> buf = [dev newBufferWithLength:nbytes options:storage_mode];
+    id<MTLBuffer> buf = nil;
+    id<MTLHeap> heap = GetHeap(device);
+    if (heap != nil) {
+      // nil here means the heap has no room for the request.
+      buf = [heap newBufferWithLength:nbytes options:storage_mode];
+    }
+    if (buf == nil) {
+      buf = [dev newBufferWithLength:nbytes options:storage_mode];
+    }
     ICHECK(buf != nil);
     return (void*)(buf);
   }
@@ -181,9 +222,14 @@ void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignm
 
 void MetalWorkspace::FreeDataSpace(Device dev, void* ptr) {
   @autoreleasepool {
-    // MTLBuffer PurgeableState should be set to empty before manual
-    // release in order to prevent memory leak
-    [(id<MTLBuffer>)ptr setPurgeableState:MTLPurgeableStateEmpty];
+    id<MTLBuffer> buf = (id<MTLBuffer>)ptr;
+    // Purgeable state cannot be set on individual heap resources;
+    // releasing the buffer already returns its range to the heap.
+    if (buf.heap == nil) {
+      // MTLBuffer PurgeableState should be set to empty before manual
+      // release in order to prevent memory leak
+      [buf setPurgeableState:MTLPurgeableStateEmpty];
+    }
     // release the ptr.
     CFRelease(ptr);
   }
@@ -207,24 +253,26 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
       LOG(FATAL) << "Error! Some problems on GPU happaned! Cannot copy data to current stream";
     }
     if (dev_from.device_type == kDLCPU) dev = dev_to;
-    id<MTLCommandBuffer> cb = s->GetCommandBuffer();
     int from_dev_type = static_cast<int>(dev_from.device_type);
     int to_dev_type = static_cast<int>(dev_to.device_type);
 
     if (from_dev_type == kDLMetal && to_dev_type == kDLMetal) {
       ICHECK_EQ(dev_from.device_id, dev_to.device_id) << "Metal disallow cross device copy.";
+      // the blit stays in the stream's open command buffer and is
+      // committed together with the surrounding kernels.
+      id<MTLCommandBuffer> cb = s->GetCommandBuffer();
       id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
       [encoder copyFromBuffer:(id<MTLBuffer>)(from)
                  sourceOffset:from_offset
                      toBuffer:(id<MTLBuffer>)(to)destinationOffset:to_offset
                          size:size];
       [encoder endEncoding];
-      [cb commit];
     } else if (from_dev_type == kDLMetal && to_dev_type == kDLCPU) {
       // copy to a local buffer before get into global buffer.
       id<MTLBuffer> from_buf = (id<MTLBuffer>)(from);
       if (from_buf.storageMode != MTLStorageModeShared) {
         id<MTLBuffer> temp = MetalThreadEntry::ThreadLocal()->GetTempBuffer(dev_from, size);
+        id<MTLCommandBuffer> cb = s->GetCommandBuffer();
         id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
         [encoder copyFromBuffer:from_buf
                    sourceOffset:from_offset
@@ -232,10 +280,11 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
               destinationOffset:0
                            size:size];
         [encoder endEncoding];
-        [cb commit];
-        [cb waitUntilCompleted];
+        s->Sync();
         memcpy(static_cast<char*>(to) + to_offset, static_cast<char*>([temp contents]), size);
       } else {
+        // drain pending kernels that may still write the source buffer.
+        s->Sync();
         memcpy(static_cast<char*>(to) + to_offset,
                static_cast<char*>([from_buf contents]) + from_offset, size);
       }
@@ -244,6 +293,7 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
       if (to_buf.storageMode != MTLStorageModeShared) {
         id<MTLBuffer> temp = MetalThreadEntry::ThreadLocal()->GetTempBuffer(dev_to, size);
         memcpy([temp contents], static_cast<const char*>(from) + from_offset, size);
+        id<MTLCommandBuffer> cb = s->GetCommandBuffer();
         id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
         [encoder copyFromBuffer:temp
                    sourceOffset:0
@@ -251,9 +301,11 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
               destinationOffset:to_offset
                            size:size];
         [encoder endEncoding];
-        [cb commit];
-        [cb waitUntilCompleted];
+        // wait so the shared temp buffer can be reused right away.
+        s->Sync();
       } else {
+        // drain pending kernels that may still touch the destination.
+        s->Sync();
         memcpy(static_cast<char*>([to_buf contents]) + to_offset,
                static_cast<const char*>(from) + from_offset, size);
       }
@@ -278,10 +330,8 @@ void MetalWorkspace::FreeStream(Device dev, TVMStreamHandle stream) {
 void MetalWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   @autoreleasepool {
     Stream* s = GetStream(stream, dev.device_id);
-    // commit an empty command buffer and wait until it completes.
-    id<MTLCommandBuffer> cb = s->GetCommandBuffer();
-    [cb commit];
-    [cb waitUntilCompleted];
+    // commit the open command buffer and wait until the queue drains.
+    s->Sync();
     if (s->HasErrorHappened()) {
       LOG(FATAL) << "Error! Some problems on GPU happaned!";
     }
@@ -211,7 +211,10 @@ class MetalWrappedFunc {
       MTLSize dimBlock = MTLSizeMake(wl.block_dim(0), wl.block_dim(1), wl.block_dim(2));
       [encoder dispatchThreadgroups:dimGrid threadsPerThreadgroup:dimBlock];
       [encoder endEncoding];
-      [cb commit];
+      // the dispatch stays in the stream's open command buffer; the
+      // batch is committed at the next sync point (StreamSync or a
+      // copy to the host), so a run of graph executor ops costs one
+      // commit instead of one per kernel.
     }
   }
 
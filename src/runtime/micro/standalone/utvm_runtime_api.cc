@@ -49,7 +49,20 @@ const char* TVMGetLastError(void) { return g_last_error.c_str(); }
 
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   TVMParallelGroupEnv env;
+  int64_t chunk_cursor = 0;
   env.num_task = 1;
+  env.chunk_handle = &chunk_cursor;
   flambda(0, &env, cdata);
   return 0;
 }
+
+int TVMBackendParallelNextChunk(TVMParallelGroupEnv* penv, int64_t extent, int64_t* out_begin,
+                                int64_t* out_end) {
+  // single threaded runtime: the only worker takes the whole loop at once.
+  int64_t* cursor = static_cast<int64_t*>(penv->chunk_handle);
+  if (*cursor >= extent) return 0;
+  *out_begin = *cursor;
+  *out_end = extent;
+  *cursor = extent;
+  return 1;
+}
@@ -39,6 +39,7 @@ TVM_MICRO_RUNTIME_API_BACKEND_API void* TVMBackendAllocWorkspace(int device_type
 typedef struct {
   void* sync_handle;
   int32_t num_task;
+  void* chunk_handle;
 } TVMParallelGroupEnv;
 
 typedef int (*FTVMParallelLambda)(int task_id, TVMParallelGroupEnv* penv, void* cdata);
@@ -46,6 +47,11 @@ typedef int (*FTVMParallelLambda)(int task_id, TVMParallelGroupEnv* penv, void*
 TVM_MICRO_RUNTIME_API_BACKEND_API int TVMBackendParallelLaunch(FTVMParallelLambda flambda,
                                                                void* cdata, int num_task);
 
+TVM_MICRO_RUNTIME_API_BACKEND_API int TVMBackendParallelNextChunk(TVMParallelGroupEnv* penv,
+                                                                  int64_t extent,
+                                                                  int64_t* out_begin,
+                                                                  int64_t* out_end);
+
 TVM_MICRO_RUNTIME_API_BACKEND_API void TVMAPISetLastError(const char* msg);
 TVM_MICRO_RUNTIME_API_BACKEND_API const char* TVMGetLastError(void);
 
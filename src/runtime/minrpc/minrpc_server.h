@@ -86,10 +86,23 @@ class MinRPCServer {
 
     this->Read(&packet_len);
     if (packet_len == 0) return true;
-    this->Read(&code);
 
     allow_clean_shutdown_ = false;
 
+    // Pull the remaining packet (header + packed args + any tensor payload)
+    // from the transport in a single DMA-able read; the per-field Read calls
+    // below are then served out of this buffer. This turns one transport
+    // transaction per value into one per call, which matters on slow links
+    // such as UART.
+    recv_buf_ = nullptr;
+    uint8_t* packet = this->ArenaAlloc<uint8_t>(packet_len);
+    this->ReadRawBytes(packet, packet_len);
+    recv_buf_ = packet;
+    recv_buf_size_ = packet_len;
+    recv_buf_offset_ = 0;
+
+    this->Read(&code);
+
     if (code >= RPCCode::kSyscallCodeStart) {
       this->HandleSyscallFunc(code);
     } else {
@@ -111,6 +124,7 @@ class MinRPCServer {
           break;
         }
         case RPCCode::kShutdown: {
+          recv_buf_ = nullptr;
           this->Shutdown();
           return false;
         }
@@ -121,6 +135,8 @@ class MinRPCServer {
       }
     }
 
+    // The buffer lives in the arena and is recycled with it.
+    recv_buf_ = nullptr;
     return true;
   }
 
@@ -209,11 +225,11 @@ class MinRPCServer {
       RPCCode code = RPCCode::kCopyAck;
       uint64_t packet_nbytes = sizeof(code) + num_bytes;
 
-      io_->MessageStart(packet_nbytes);
+      this->MessageStart(packet_nbytes);
       this->Write(packet_nbytes);
       this->Write(code);
       this->WriteArray(data_ptr, num_bytes);
-      io_->MessageDone();
+      this->MessageDone();
     } else {
       this->ReturnLastTVMError();
     }
@@ -557,9 +573,22 @@ class MinRPCServer {
     return this->WriteRawBytes(data, sizeof(T) * count);
   }
 
-  void MessageStart(uint64_t packet_nbytes) { io_->MessageStart(packet_nbytes); }
+  void MessageStart(uint64_t packet_nbytes) {
+    io_->MessageStart(packet_nbytes);
+    // Gather the reply, including the length prefix written right after this
+    // call, so that MessageDone can hand the transport one contiguous buffer.
+    send_buf_size_ = packet_nbytes + sizeof(packet_nbytes);
+    send_buf_ = this->ArenaAlloc<uint8_t>(send_buf_size_);
+    send_buf_offset_ = 0;
+  }
 
-  void MessageDone() { io_->MessageDone(); }
+  void MessageDone() {
+    uint8_t* buf = send_buf_;
+    size_t size = send_buf_offset_;
+    send_buf_ = nullptr;
+    this->WriteRawBytes(buf, size);
+    io_->MessageDone();
+  }
 
  private:
   // Internal allocator that redirects alloc to TVM's C API.
@@ -608,12 +637,12 @@ class MinRPCServer {
 
     uint64_t packet_nbytes = sizeof(code) + sizeof(num_args) + sizeof(tcode);
 
-    io_->MessageStart(packet_nbytes);
+    this->MessageStart(packet_nbytes);
     this->Write(packet_nbytes);
     this->Write(code);
     this->Write(num_args);
     this->Write(tcode);
-    io_->MessageDone();
+    this->MessageDone();
   }
 
   void ReturnHandle(void* handle) {
@@ -624,13 +653,13 @@ class MinRPCServer {
     uint64_t packet_nbytes =
         sizeof(code) + sizeof(num_args) + sizeof(tcode) + sizeof(encode_handle);
 
-    io_->MessageStart(packet_nbytes);
+    this->MessageStart(packet_nbytes);
     this->Write(packet_nbytes);
     this->Write(code);
     this->Write(num_args);
     this->Write(tcode);
     this->Write(encode_handle);
-    io_->MessageDone();
+    this->MessageDone();
   }
 
   void ReturnException(const char* msg) { RPCReference::ReturnException(msg, this); }
@@ -642,6 +671,14 @@ class MinRPCServer {
   void ReturnLastTVMError() { this->ReturnException(TVMGetLastError()); }
 
   void ReadRawBytes(void* data, size_t size) {
+    if (recv_buf_ != nullptr) {
+      if (size > recv_buf_size_ - recv_buf_offset_) {
+        this->ThrowError(RPCServerStatus::kReadError);
+      }
+      memcpy(data, recv_buf_ + recv_buf_offset_, size);
+      recv_buf_offset_ += size;
+      return;
+    }
     uint8_t* buf = reinterpret_cast<uint8_t*>(data);
     size_t ndone = 0;
     while (ndone < size) {
@@ -663,6 +700,14 @@ class MinRPCServer {
   }
 
   void WriteRawBytes(const void* data, size_t size) {
+    if (send_buf_ != nullptr) {
+      if (size > send_buf_size_ - send_buf_offset_) {
+        this->ThrowError(RPCServerStatus::kWriteError);
+      }
+      memcpy(send_buf_ + send_buf_offset_, data, size);
+      send_buf_offset_ += size;
+      return;
+    }
     const uint8_t* buf = reinterpret_cast<const uint8_t*>(data);
     size_t ndone = 0;
     while (ndone < size) {
@@ -679,6 +724,14 @@ class MinRPCServer {
   TIOHandler* io_;
   /*! \brief internal arena. */
   support::GenericArena<PageAllocator> arena_;
+  /*! \brief Arena buffer holding the current request packet; reads are served from it. */
+  uint8_t* recv_buf_{nullptr};
+  size_t recv_buf_size_{0};
+  size_t recv_buf_offset_{0};
+  /*! \brief Arena buffer gathering the current reply packet, flushed by MessageDone. */
+  uint8_t* send_buf_{nullptr};
+  size_t send_buf_size_{0};
+  size_t send_buf_offset_{0};
   /*! \brief Whether we are in a state that allows clean shutdown. */
   bool allow_clean_shutdown_{true};
   static_assert(DMLC_LITTLE_ENDIAN, "MinRPC only works on little endian.");
@@ -25,8 +25,12 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include "file_utils.h"
 
@@ -59,6 +63,8 @@ void ModuleNode::Import(Module other) {
   }
   ICHECK(!visited.count(this)) << "Cyclic dependency detected during import";
   this->imports_.emplace_back(std::move(other));
+  // the flattened view is stale now; GetFuncFromEnv rebuilds it on demand
+  this->import_lookup_.clear();
 }
 
 PackedFunc ModuleNode::GetFunction(const std::string& name, bool query_imports) {
@@ -105,9 +111,23 @@ std::string ModuleNode::GetSource(const std::string& format) {
 const PackedFunc* ModuleNode::GetFuncFromEnv(const std::string& name) {
   auto it = import_cache_.find(name);
   if (it != import_cache_.end()) return it->second.get();
+  if (import_lookup_.empty() && !imports_.empty()) {
+    // Flatten the import tree in the order the recursive lookup would visit
+    // it, visiting each module once even when subtrees are shared.
+    std::unordered_set<const ModuleNode*> visited;
+    std::vector<Module> stack(imports_.rbegin(), imports_.rend());
+    while (!stack.empty()) {
+      Module m = std::move(stack.back());
+      stack.pop_back();
+      if (!visited.insert(m.operator->()).second) continue;
+      const std::vector<Module>& children = m->imports();
+      stack.insert(stack.end(), children.rbegin(), children.rend());
+      import_lookup_.emplace_back(std::move(m));
+    }
+  }
   PackedFunc pf;
-  for (Module& m : this->imports_) {
-    pf = m.GetFunction(name, true);
+  for (Module& m : this->import_lookup_) {
+    pf = m.operator->()->GetFunction(name, /*query_imports=*/false);
     if (pf != nullptr) break;
   }
   if (pf == nullptr) {
@@ -177,6 +197,58 @@ TVM_REGISTER_GLOBAL("runtime.ModuleGetTypeKey").set_body_typed([](Module mod) {
 
 TVM_REGISTER_GLOBAL("runtime.ModuleLoadFromFile").set_body_typed(Module::LoadFromFile);
 
+// Load several module files concurrently. Deserializing the device blob of a
+// large module (PTX, metadata tables) dominates its load time and is
+// independent per file, so a serving process that loads many model libraries
+// at startup scales with the number of cores instead of loading serially.
+TVM_REGISTER_GLOBAL("runtime.ModuleLoadFromFiles")
+    .set_body_typed([](Array<String> file_names, String format) {
+      std::vector<Module> modules(file_names.size());
+      std::vector<std::exception_ptr> errors(file_names.size());
+      size_t num_workers = std::min<size_t>(
+          file_names.size(), std::max<size_t>(1, std::thread::hardware_concurrency()));
+      std::atomic<size_t> next(0);
+      auto worker = [&]() {
+        size_t i;
+        while ((i = next.fetch_add(1)) < file_names.size()) {
+          try {
+            modules[i] = Module::LoadFromFile(file_names[i], format);
+          } catch (...) {
+            errors[i] = std::current_exception();
+          }
+        }
+      };
+      std::vector<std::thread> threads;
+      for (size_t i = 1; i < num_workers; ++i) {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (auto& t : threads) {
+        t.join();
+      }
+      for (auto& err : errors) {
+        if (err != nullptr) std::rethrow_exception(err);
+      }
+      return Array<Module>(modules.begin(), modules.end());
+    });
+
+// Walk a module and its imports and run the warm-up hook of every module that
+// provides one (e.g. the CUDA module eagerly cuModuleLoads its binary). Safe
+// to call from a background thread before the first inference.
+TVM_REGISTER_GLOBAL("runtime.ModuleWarmUp").set_body_typed([](Module mod, int device_id) {
+  std::vector<Module> stack{mod};
+  while (!stack.empty()) {
+    Module m = stack.back();
+    stack.pop_back();
+    if (PackedFunc f = m->GetFunction(symbol::tvm_module_warm_up, false)) {
+      f(device_id);
+    }
+    for (const Module& im : m->imports()) {
+      stack.push_back(im);
+    }
+  }
+});
+
 TVM_REGISTER_GLOBAL("runtime.ModuleSaveToFile")
     .set_body_typed([](Module mod, tvm::String name, tvm::String fmt) {
       mod->SaveToFile(name, fmt);
@@ -96,6 +96,51 @@ void ArrayCopyToBytes(const DLTensor* handle, void* data, size_t nbytes) {
   DeviceAPI::Get(handle->device)->StreamSync(handle->device, nullptr);
 }
 
+namespace {
+
+// Recycles container header blocks. The executors create and drop tensor
+// metadata at a high rate, in particular for rank-1 shape tensors in
+// dynamic-shape models, and all plain containers share one block size.
+struct ContainerHeaderCache {
+  static constexpr size_t kMaxCached = 1024;
+  std::vector<void*> blocks;
+  ~ContainerHeaderCache() {
+    for (void* block : blocks) {
+      ::operator delete(block);
+    }
+  }
+  static ContainerHeaderCache* ThreadLocal() {
+    static thread_local ContainerHeaderCache inst;
+    return &inst;
+  }
+};
+
+}  // namespace
+
+void* NDArray::Container::operator new(size_t nbytes) {
+  // Subclasses allocate a different size; only exact matches are recycled.
+  if (nbytes == sizeof(NDArray::Container)) {
+    ContainerHeaderCache* cache = ContainerHeaderCache::ThreadLocal();
+    if (!cache->blocks.empty()) {
+      void* block = cache->blocks.back();
+      cache->blocks.pop_back();
+      return block;
+    }
+  }
+  return ::operator new(nbytes);
+}
+
+void NDArray::Container::operator delete(void* ptr, size_t nbytes) {
+  if (nbytes == sizeof(NDArray::Container)) {
+    ContainerHeaderCache* cache = ContainerHeaderCache::ThreadLocal();
+    if (cache->blocks.size() < ContainerHeaderCache::kMaxCached) {
+      cache->blocks.push_back(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
 struct NDArray::Internal {
   // Default deleter for the container
   static void DefaultDeleter(Object* ptr_obj) {
@@ -133,9 +178,7 @@ struct NDArray::Internal {
     // RAII now in effect
     NDArray ret(GetObjectPtr<Object>(data));
     // setup shape
-    data->shape_ = std::move(shape);
-    data->dl_tensor.shape = dmlc::BeginPtr(data->shape_);
-    data->dl_tensor.ndim = static_cast<int>(data->shape_.size());
+    data->SetShape(std::move(shape));
     // setup dtype
     data->dl_tensor.dtype = dtype;
     // setup device
@@ -206,10 +249,8 @@ NDArray NDArray::FromDLPack(DLManagedTensor* tensor) {
   // fill up content.
   data->manager_ctx = tensor;
   data->dl_tensor = tensor->dl_tensor;
-  // update shape_
-  data->shape_.resize(data->dl_tensor.ndim);
-  data->shape_.assign(data->dl_tensor.shape, data->dl_tensor.shape + data->dl_tensor.ndim);
-  data->dl_tensor.shape = data->shape_.data();
+  // copy the shape into storage owned by the container
+  data->SetShape(data->dl_tensor.shape, data->dl_tensor.ndim);
   return NDArray(GetObjectPtr<Object>(data));
 }
 
@@ -242,7 +283,10 @@ void NDArray::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle str
   DeviceAPI::Get(dev)->CopyDataFromTo(const_cast<DLTensor*>(from), to, stream);
 }
 
-std::vector<int64_t> NDArray::Shape() const { return get_mutable()->shape_; }
+std::vector<int64_t> NDArray::Shape() const {
+  const DLTensor& t = get_mutable()->dl_tensor;
+  return std::vector<int64_t>(t.shape, t.shape + t.ndim);
+}
 runtime::DataType NDArray::DataType() const {
   return runtime::DataType(get_mutable()->dl_tensor.dtype);
 }
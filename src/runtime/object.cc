@@ -194,6 +194,39 @@ class TypeContext {
   std::unordered_map<std::string, uint32_t> type_key2index_;
 };
 
+/*!
+ * \brief Per-thread state of the deferred object reclaimer.
+ *
+ * Only the outermost release on a thread invokes deleters; objects whose
+ * reference count drops to zero while another deleter is running are
+ * pushed to the worklist and destroyed after that deleter returns. This
+ * turns the destructor cascade of a deep object graph into a loop, so
+ * the stack depth stays constant no matter how deep the graph is.
+ */
+struct DeferredDeleteState {
+  /*! \brief Objects released inside a running deleter. */
+  std::vector<Object*> worklist;
+  /*! \brief Whether a deleter is running on this thread. */
+  bool draining{false};
+};
+
+void Object::DeferredDelete(Object* self) {
+  static thread_local DeferredDeleteState state;
+  DeferredDeleteState* s = &state;
+  if (s->draining) {
+    s->worklist.push_back(self);
+    return;
+  }
+  s->draining = true;
+  (*self->deleter_)(self);
+  while (!s->worklist.empty()) {
+    Object* obj = s->worklist.back();
+    s->worklist.pop_back();
+    (*obj->deleter_)(obj);
+  }
+  s->draining = false;
+}
+
 uint32_t Object::GetOrAllocRuntimeTypeIndex(const std::string& key, uint32_t static_tindex,
                                             uint32_t parent_tindex, uint32_t num_child_slots,
                                             bool child_slots_can_overflow) {
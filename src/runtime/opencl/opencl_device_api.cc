@@ -23,6 +23,11 @@
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
 #include "opencl_common.h"
 
 namespace tvm {
@@ -32,6 +37,160 @@ namespace cl {
 std::string GetPlatformInfo(cl_platform_id pid, cl_platform_info param_name);
 std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
 
+/*!
+ * \brief Sub-buffer suballocator over large cl_mem slabs.
+ *
+ * clCreateBuffer goes through the driver on every call, which dominates
+ * allocation heavy workloads on mobile and embedded stacks. Small
+ * allocations are instead carved out of 16MB slabs as cl_mem sub-buffers
+ * with a best-fit free list and neighbor coalescing. Slabs for devices
+ * with host-unified memory are created with CL_MEM_ALLOC_HOST_PTR so
+ * mapping them exposes the actual storage instead of a bounce buffer.
+ */
+class OpenCLBufferPool {
+ public:
+  /*! \brief Size of one driver slab. */
+  static constexpr size_t kSlabBytes = 16 << 20;
+  /*! \brief Largest request served from a slab. */
+  static constexpr size_t kMaxSubAllocBytes = kSlabBytes / 4;
+
+  static OpenCLBufferPool* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of global state.
+    static auto* inst = new OpenCLBufferPool();
+    return inst;
+  }
+
+  /*!
+   * \brief Try to serve an allocation from a slab.
+   * \return The sub-buffer, or nullptr if the request is too large and
+   *         should go to the driver directly.
+   */
+  cl_mem Alloc(cl_context context, size_t nbytes, size_t alignment, bool zero_copy) {
+    if (nbytes == 0) nbytes = alignment;
+    nbytes = (nbytes + alignment - 1) / alignment * alignment;
+    if (nbytes > kMaxSubAllocBytes) return nullptr;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Pool& pool = pools_[PoolKey{context, alignment, zero_copy}];
+    auto it = pool.free_by_size.lower_bound(nbytes);
+    if (it == pool.free_by_size.end()) {
+      NewSlab(context, zero_copy, &pool);
+      it = pool.free_by_size.lower_bound(nbytes);
+      ICHECK(it != pool.free_by_size.end());
+    }
+    Block* block = it->second;
+    pool.free_by_size.erase(it);
+    block->free = false;
+    if (block->size >= nbytes + alignment) {
+      // Split the tail into a new free block.
+      Block* tail = new Block();
+      tail->parent = block->parent;
+      tail->offset = block->offset + nbytes;
+      tail->size = block->size - nbytes;
+      tail->free = true;
+      tail->prev = block;
+      tail->next = block->next;
+      if (tail->next != nullptr) tail->next->prev = tail;
+      block->next = tail;
+      block->size = nbytes;
+      tail->free_it = pool.free_by_size.emplace(tail->size, tail);
+    }
+    cl_buffer_region region;
+    region.origin = block->offset;
+    region.size = block->size;
+    cl_int err_code;
+    cl_mem sub = clCreateSubBuffer(block->parent, CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION,
+                                   &region, &err_code);
+    OPENCL_CHECK_ERROR(err_code);
+    sub_buffers_.emplace(sub, SubEntry{block, &pool});
+    return sub;
+  }
+
+  /*!
+   * \brief Return a sub-buffer to its slab.
+   * \return Whether the buffer came from the pool; the caller releases it
+   *         directly otherwise.
+   */
+  bool Free(cl_mem mem) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sub_buffers_.find(mem);
+    if (it == sub_buffers_.end()) return false;
+    Block* block = it->second.block;
+    Pool* pool = it->second.pool;
+    sub_buffers_.erase(it);
+    OPENCL_CALL(clReleaseMemObject(mem));
+    block->free = true;
+    // Coalesce with free neighbors inside the slab.
+    Block* next = block->next;
+    if (next != nullptr && next->free) {
+      pool->free_by_size.erase(next->free_it);
+      block->size += next->size;
+      block->next = next->next;
+      if (block->next != nullptr) block->next->prev = block;
+      delete next;
+    }
+    Block* prev = block->prev;
+    if (prev != nullptr && prev->free) {
+      pool->free_by_size.erase(prev->free_it);
+      prev->size += block->size;
+      prev->next = block->next;
+      if (prev->next != nullptr) prev->next->prev = prev;
+      delete block;
+      block = prev;
+    }
+    block->free_it = pool->free_by_size.emplace(block->size, block);
+    return true;
+  }
+
+ private:
+  struct Block {
+    cl_mem parent{nullptr};
+    size_t offset{0};
+    size_t size{0};
+    bool free{false};
+    Block* prev{nullptr};
+    Block* next{nullptr};
+    std::multimap<size_t, Block*>::iterator free_it;
+  };
+
+  struct Pool {
+    std::multimap<size_t, Block*> free_by_size;
+  };
+
+  struct PoolKey {
+    cl_context context;
+    size_t alignment;
+    bool zero_copy;
+    bool operator<(const PoolKey& other) const {
+      if (context != other.context) return context < other.context;
+      if (alignment != other.alignment) return alignment < other.alignment;
+      return zero_copy < other.zero_copy;
+    }
+  };
+
+  void NewSlab(cl_context context, bool zero_copy, Pool* pool) {
+    cl_mem_flags flags = CL_MEM_READ_WRITE;
+    if (zero_copy) flags |= CL_MEM_ALLOC_HOST_PTR;
+    cl_int err_code;
+    cl_mem slab = clCreateBuffer(context, flags, kSlabBytes, nullptr, &err_code);
+    OPENCL_CHECK_ERROR(err_code);
+    Block* block = new Block();
+    block->parent = slab;
+    block->offset = 0;
+    block->size = kSlabBytes;
+    block->free = true;
+    block->free_it = pool->free_by_size.emplace(block->size, block);
+  }
+
+  struct SubEntry {
+    Block* block;
+    Pool* pool;
+  };
+
+  std::mutex mutex_;
+  std::map<PoolKey, Pool> pools_;
+  std::unordered_map<cl_mem, SubEntry> sub_buffers_;
+};
+
 OpenCLThreadEntry* OpenCLWorkspace::GetThreadEntry() { return OpenCLThreadEntry::ThreadLocal(); }
 
 OpenCLWorkspace* OpenCLWorkspace::Global() {
@@ -133,12 +292,117 @@ void OpenCLWorkspace::GetAttr(Device dev, DeviceAttrKind kind, TVMRetValue* rv)
   }
 }
 
+/*! \brief The image2d extents a tensor shape flattens to. */
+struct Texture2DShape {
+  size_t width;
+  size_t height;
+  size_t channel;
+};
+
+/*!
+ * \brief Flatten an NDArray shape onto an image2d.
+ *
+ *  The innermost axis becomes the RGBA texel channel and must have extent 4,
+ *  the next-to-last axis becomes the image row, and all remaining outer axes
+ *  are collapsed into the image height.
+ */
+inline Texture2DShape ApplyTexture2DFlattening(const int64_t* shape, int ndim) {
+  ICHECK_GE(ndim, 3) << "Texture storage needs at least 3 axes, got ndim=" << ndim;
+  ICHECK_EQ(shape[ndim - 1], 4) << "The innermost axis of a texture backed tensor must have "
+                                << "extent 4 to match the RGBA texel, got " << shape[ndim - 1];
+  Texture2DShape ts;
+  ts.channel = static_cast<size_t>(shape[ndim - 1]);
+  ts.width = static_cast<size_t>(shape[ndim - 2]);
+  ts.height = 1;
+  for (int i = 0; i < ndim - 2; ++i) {
+    ts.height *= static_cast<size_t>(shape[i]);
+  }
+  return ts;
+}
+
+inline bool IsTextureStorage(const std::string& scope) {
+  return scope.find("texture") != std::string::npos;
+}
+
+inline cl_channel_type DTypeToChannelType(DLDataType dtype) {
+  ICHECK_EQ(dtype.lanes, 1) << "Texture channel type must be scalar, got lanes=" << dtype.lanes;
+  if (dtype.code == kDLFloat && dtype.bits == 32) return CL_FLOAT;
+  if (dtype.code == kDLFloat && dtype.bits == 16) return CL_HALF_FLOAT;
+  if (dtype.code == kDLInt && dtype.bits == 8) return CL_SIGNED_INT8;
+  if (dtype.code == kDLInt && dtype.bits == 16) return CL_SIGNED_INT16;
+  if (dtype.code == kDLInt && dtype.bits == 32) return CL_SIGNED_INT32;
+  if (dtype.code == kDLUInt && dtype.bits == 8) return CL_UNSIGNED_INT8;
+  if (dtype.code == kDLUInt && dtype.bits == 16) return CL_UNSIGNED_INT16;
+  if (dtype.code == kDLUInt && dtype.bits == 32) return CL_UNSIGNED_INT32;
+  LOG(FATAL) << "Datatype " << DLDataType2String(dtype) << " is not supported as texture storage";
+  return CL_FLOAT;
+}
+
+// Whether a cl_mem was created as an image2d rather than a buffer.
+inline bool IsImageObject(cl_mem mem) {
+  cl_mem_object_type mem_type;
+  OPENCL_CALL(clGetMemObjectInfo(mem, CL_MEM_TYPE, sizeof(mem_type), &mem_type, nullptr));
+  return mem_type == CL_MEM_OBJECT_IMAGE2D;
+}
+
+// The slab pool can be turned off to fall back to raw clCreateBuffer.
+static bool BufferPoolEnabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("TVM_OPENCL_BUFFER_POOL");
+    return env == nullptr || atoi(env) != 0;
+  }();
+  return enabled;
+}
+
 void* OpenCLWorkspace::AllocDataSpace(Device dev, size_t size, size_t alignment,
                                       DLDataType type_hint) {
   this->Init();
   ICHECK(context != nullptr) << "No OpenCL device";
+  size_t index = static_cast<size_t>(dev.device_id);
+  bool zero_copy = index < host_unified_memory.size() && host_unified_memory[index];
+  if (BufferPoolEnabled() && type_key == "opencl") {
+    size_t align = alignment;
+    if (index < mem_base_alignment.size()) {
+      align = std::max(align, mem_base_alignment[index]);
+    }
+    cl_mem sub = OpenCLBufferPool::Global()->Alloc(this->context, size, align, zero_copy);
+    if (sub != nullptr) return sub;
+  }
+  cl_mem_flags flags = CL_MEM_READ_WRITE;
+  if (zero_copy) {
+    flags |= CL_MEM_ALLOC_HOST_PTR;
+  }
   cl_int err_code;
-  cl_mem mptr = clCreateBuffer(this->context, CL_MEM_READ_WRITE, size, nullptr, &err_code);
+  cl_mem mptr = clCreateBuffer(this->context, flags, size, nullptr, &err_code);
+  OPENCL_CHECK_ERROR(err_code);
+  return mptr;
+}
+
+void* OpenCLWorkspace::AllocDataSpace(Device dev, int ndim, const int64_t* shape, DLDataType dtype,
+                                      Optional<String> mem_scope) {
+  if (!mem_scope.defined() || mem_scope.value() == "" || mem_scope.value() == "global") {
+    return DeviceAPI::AllocDataSpace(dev, ndim, shape, dtype, mem_scope);
+  }
+  ICHECK(IsTextureStorage(std::string(mem_scope.value())))
+      << "Device does not support allocating data space with "
+      << "the specified memory scope: " << mem_scope.value();
+  Texture2DShape ts = ApplyTexture2DFlattening(shape, ndim);
+  return AllocTexture(dev, ts.width, ts.height, dtype);
+}
+
+void* OpenCLWorkspace::AllocTexture(Device dev, size_t width, size_t height,
+                                    DLDataType type_hint) {
+  this->Init();
+  ICHECK(context != nullptr) << "No OpenCL device";
+  cl_image_format format = {CL_RGBA, DTypeToChannelType(type_hint)};
+  cl_image_desc desc;
+  std::memset(&desc, 0, sizeof(desc));
+  desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+  desc.image_width = width;
+  desc.image_height = height;
+  cl_int err_code;
+  cl_mem mptr =
+      clCreateImage(this->context, CL_MEM_READ_WRITE, &format, &desc, nullptr, &err_code);
   OPENCL_CHECK_ERROR(err_code);
   return mptr;
 }
@@ -149,9 +413,63 @@ void OpenCLWorkspace::FreeDataSpace(Device dev, void* ptr) {
   OPENCL_CALL(clFinish(this->GetQueue(dev)));
 
   cl_mem mptr = static_cast<cl_mem>(ptr);
+  if (OpenCLBufferPool::Global()->Free(mptr)) return;
   OPENCL_CALL(clReleaseMemObject(mptr));
 }
 
+void OpenCLWorkspace::CopyDataFromTo(DLTensor* from, DLTensor* to, TVMStreamHandle stream) {
+  this->Init();
+  ICHECK(stream == nullptr);
+  bool from_image = IsOpenCLDevice(from->device) && IsImageObject(static_cast<cl_mem>(from->data));
+  bool to_image = IsOpenCLDevice(to->device) && IsImageObject(static_cast<cl_mem>(to->data));
+  if (!from_image && !to_image) {
+    // Plain buffers keep going through the flat byte-offset path.
+    DeviceAPI::CopyDataFromTo(from, to, stream);
+    return;
+  }
+  ICHECK(IsContiguous(*from) && IsContiguous(*to))
+      << "CopyDataFromTo only support contiguous array for now";
+  ICHECK_EQ(GetDataSize(*from), GetDataSize(*to));
+  // Images cannot be addressed at a byte offset; the whole image is copied.
+  size_t origin[3] = {0, 0, 0};
+  size_t region[3];
+  cl_mem image = static_cast<cl_mem>(from_image ? from->data : to->data);
+  OPENCL_CALL(clGetImageInfo(image, CL_IMAGE_WIDTH, sizeof(size_t), &region[0], nullptr));
+  OPENCL_CALL(clGetImageInfo(image, CL_IMAGE_HEIGHT, sizeof(size_t), &region[1], nullptr));
+  region[2] = 1;
+  if (from_image) ICHECK_EQ(from->byte_offset, 0);
+  if (to_image) ICHECK_EQ(to->byte_offset, 0);
+  if (from_image && to_image) {
+    OPENCL_CALL(clEnqueueCopyImage(this->GetQueue(to->device), static_cast<cl_mem>(from->data),
+                                   static_cast<cl_mem>(to->data), origin, origin, region, 0,
+                                   nullptr, nullptr));
+  } else if (from_image && IsOpenCLDevice(to->device)) {
+    OPENCL_CALL(clEnqueueCopyImageToBuffer(this->GetQueue(to->device),
+                                           static_cast<cl_mem>(from->data),
+                                           static_cast<cl_mem>(to->data), origin, region,
+                                           to->byte_offset, 0, nullptr, nullptr));
+  } else if (from_image) {
+    ICHECK_EQ(to->device.device_type, kDLCPU);
+    OPENCL_CALL(clEnqueueReadImage(this->GetQueue(from->device),
+                                   static_cast<cl_mem>(from->data), CL_FALSE, origin, region, 0, 0,
+                                   static_cast<char*>(to->data) + to->byte_offset, 0, nullptr,
+                                   nullptr));
+    OPENCL_CALL(clFinish(this->GetQueue(from->device)));
+  } else if (IsOpenCLDevice(from->device)) {
+    OPENCL_CALL(clEnqueueCopyBufferToImage(this->GetQueue(to->device),
+                                           static_cast<cl_mem>(from->data),
+                                           static_cast<cl_mem>(to->data), from->byte_offset,
+                                           origin, region, 0, nullptr, nullptr));
+  } else {
+    ICHECK_EQ(from->device.device_type, kDLCPU);
+    OPENCL_CALL(clEnqueueWriteImage(this->GetQueue(to->device), static_cast<cl_mem>(to->data),
+                                    CL_FALSE, origin, region, 0, 0,
+                                    static_cast<const char*>(from->data) + from->byte_offset, 0,
+                                    nullptr, nullptr));
+    OPENCL_CALL(clFinish(this->GetQueue(to->device)));
+  }
+}
+
 void OpenCLWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void* to,
                                      size_t to_offset, size_t size, Device dev_from, Device dev_to,
                                      DLDataType type_hint, TVMStreamHandle stream) {
@@ -163,16 +481,45 @@ void OpenCLWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
                                     static_cast<cl_mem>(to), from_offset, to_offset, size, 0,
                                     nullptr, nullptr));
   } else if (IsOpenCLDevice(dev_from) && dev_to.device_type == kDLCPU) {
-    OPENCL_CALL(clEnqueueReadBuffer(this->GetQueue(dev_from),
-                                    static_cast<cl_mem>((void*)from),  // NOLINT(*)
-                                    CL_FALSE, from_offset, size, static_cast<char*>(to) + to_offset,
-                                    0, nullptr, nullptr));
-    OPENCL_CALL(clFinish(this->GetQueue(dev_from)));
+    if (IsHostUnified(dev_from)) {
+      // On host-unified devices the map exposes the actual storage, so the
+      // staged copy clEnqueueReadBuffer would do is skipped.
+      cl_int err_code;
+      void* mapped = clEnqueueMapBuffer(this->GetQueue(dev_from),
+                                        static_cast<cl_mem>((void*)from),  // NOLINT(*)
+                                        CL_TRUE, CL_MAP_READ, from_offset, size, 0, nullptr,
+                                        nullptr, &err_code);
+      OPENCL_CHECK_ERROR(err_code);
+      memcpy(static_cast<char*>(to) + to_offset, mapped, size);
+      OPENCL_CALL(clEnqueueUnmapMemObject(this->GetQueue(dev_from),
+                                          static_cast<cl_mem>((void*)from),  // NOLINT(*)
+                                          mapped, 0, nullptr, nullptr));
+      OPENCL_CALL(clFinish(this->GetQueue(dev_from)));
+    } else {
+      OPENCL_CALL(clEnqueueReadBuffer(this->GetQueue(dev_from),
+                                      static_cast<cl_mem>((void*)from),  // NOLINT(*)
+                                      CL_FALSE, from_offset, size,
+                                      static_cast<char*>(to) + to_offset, 0, nullptr, nullptr));
+      OPENCL_CALL(clFinish(this->GetQueue(dev_from)));
+    }
   } else if (dev_from.device_type == kDLCPU && IsOpenCLDevice(dev_to)) {
-    OPENCL_CALL(clEnqueueWriteBuffer(this->GetQueue(dev_to), static_cast<cl_mem>(to), CL_FALSE,
-                                     to_offset, size, static_cast<const char*>(from) + from_offset,
-                                     0, nullptr, nullptr));
-    OPENCL_CALL(clFinish(this->GetQueue(dev_to)));
+    if (IsHostUnified(dev_to)) {
+      cl_int err_code;
+      void* mapped = clEnqueueMapBuffer(this->GetQueue(dev_to), static_cast<cl_mem>(to), CL_TRUE,
+                                        CL_MAP_WRITE, to_offset, size, 0, nullptr, nullptr,
+                                        &err_code);
+      OPENCL_CHECK_ERROR(err_code);
+      memcpy(mapped, static_cast<const char*>(from) + from_offset, size);
+      OPENCL_CALL(clEnqueueUnmapMemObject(this->GetQueue(dev_to), static_cast<cl_mem>(to), mapped,
+                                          0, nullptr, nullptr));
+      OPENCL_CALL(clFinish(this->GetQueue(dev_to)));
+    } else {
+      OPENCL_CALL(clEnqueueWriteBuffer(this->GetQueue(dev_to), static_cast<cl_mem>(to), CL_FALSE,
+                                       to_offset, size,
+                                       static_cast<const char*>(from) + from_offset, 0, nullptr,
+                                       nullptr));
+      OPENCL_CALL(clFinish(this->GetQueue(dev_to)));
+    }
   } else {
     LOG(FATAL) << "Expect copy from/to OpenCL or between OpenCL";
   }
@@ -287,6 +634,15 @@ void OpenCLWorkspace::Init(const std::string& type_key, const std::string& devic
     cl_device_id did = this->devices[i];
     this->queues.push_back(clCreateCommandQueue(this->context, did, 0, &err_code));
     OPENCL_CHECK_ERROR(err_code);
+    cl_bool unified = CL_FALSE;
+    OPENCL_CALL(
+        clGetDeviceInfo(did, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified), &unified, nullptr));
+    this->host_unified_memory.push_back(unified == CL_TRUE);
+    cl_uint align_bits = 0;
+    OPENCL_CALL(clGetDeviceInfo(did, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(align_bits), &align_bits,
+                                nullptr));
+    // The query reports bits; sub-buffer origins must respect it in bytes.
+    this->mem_base_alignment.push_back(std::max<size_t>(align_bits / 8, kTempAllocaAlignment));
   }
   initialized_ = true;
 }
@@ -23,10 +23,13 @@
  */
 
 #include <tvm/ir/expr.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/profiling.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -448,6 +451,193 @@ TVM_REGISTER_OBJECT_TYPE(CountNode);
 TVM_REGISTER_OBJECT_TYPE(ReportNode);
 
 TVM_REGISTER_GLOBAL("runtime.profiling.AsCSV").set_body_typed([](Report n) { return n->AsCSV(); });
+
+EventRecorder::EventRecorder() {
+  const char* flag = std::getenv("TVM_PROFILE_EVENTS");
+  if (flag == nullptr || std::string(flag) == "0") return;
+  size_t capacity = 1 << 16;
+  if (const char* ring = std::getenv("TVM_PROFILE_EVENTS_RING")) {
+    capacity = static_cast<size_t>(std::atoll(ring));
+    ICHECK_GT(capacity, 0) << "TVM_PROFILE_EVENTS_RING must be a positive record count";
+  }
+  capacity_ = capacity;
+  ring_.resize(capacity_);
+}
+
+EventRecorder* EventRecorder::Global() {
+  static EventRecorder* inst = new EventRecorder();
+  return inst;
+}
+
+int64_t EventRecorder::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+int EventRecorder::RegisterSpan(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  span_names_.push_back(name);
+  return static_cast<int>(span_names_.size()) - 1;
+}
+
+void EventRecorder::Record(int span, int64_t begin_ns, int64_t end_ns, Device dev) {
+  if (capacity_ == 0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  ring_[next_ % capacity_] = EventRecord{span, begin_ns, end_ns, dev};
+  ++next_;
+}
+
+void EventRecorder::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  next_ = 0;
+}
+
+Report EventRecorder::Summary() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t num_records = static_cast<size_t>(std::min<uint64_t>(next_, capacity_));
+  // aggregate by (span, device)
+  std::map<std::pair<int, std::string>, std::pair<double, int64_t>> totals;
+  std::unordered_map<std::string, double> device_totals;
+  for (size_t i = 0; i < num_records; ++i) {
+    const EventRecord& rec = ring_[i];
+    double us = (rec.end_ns - rec.begin_ns) / 1e3;
+    auto& entry = totals[{rec.span, DeviceString(rec.dev)}];
+    entry.first += us;
+    entry.second += 1;
+    device_totals[DeviceString(rec.dev)] += us;
+  }
+  double overall_time = 0;
+  for (auto& p : device_totals) {
+    overall_time = std::max(overall_time, p.second);
+  }
+
+  std::vector<Map<String, ObjectRef>> rows;
+  for (auto& p : totals) {
+    std::unordered_map<String, ObjectRef> row;
+    row["Name"] = String(span_names_[p.first.first]);
+    row["Device"] = String(p.first.second);
+    row["Duration (us)"] = ObjectRef(make_object<DurationNode>(p.second.first));
+    row["Count"] = ObjectRef(make_object<CountNode>(p.second.second));
+    row["Percent"] = ObjectRef(make_object<PercentNode>(p.second.first / overall_time * 100));
+    rows.push_back(row);
+  }
+  std::unordered_map<String, Map<String, ObjectRef>> device_metrics;
+  for (auto& p : device_totals) {
+    std::unordered_map<String, ObjectRef> row;
+    row["Name"] = String("Total");
+    row["Duration (us)"] = ObjectRef(make_object<DurationNode>(p.second));
+    row["Percent"] = ObjectRef(make_object<PercentNode>(p.second / overall_time * 100));
+    row["Device"] = String(p.first);
+    device_metrics[p.first] = row;
+  }
+  return Report(rows, device_metrics);
+}
+
+std::string EventRecorder::AsChromeTrace() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::stringstream s;
+  s << "{\"traceEvents\":[";
+  uint64_t begin = next_ > capacity_ ? next_ - capacity_ : 0;
+  for (uint64_t i = begin; i < next_; ++i) {
+    const EventRecord& rec = ring_[i % capacity_];
+    if (i != begin) s << ",";
+    s << "{\"name\":\"" << span_names_[rec.span] << "\",\"ph\":\"X\""
+      << ",\"ts\":" << std::fixed << std::setprecision(3) << rec.begin_ns / 1e3
+      << ",\"dur\":" << (rec.end_ns - rec.begin_ns) / 1e3
+      << ",\"pid\":" << static_cast<int>(rec.dev.device_type) << ",\"tid\":" << rec.dev.device_id
+      << ",\"args\":{\"device\":\"" << DeviceString(rec.dev) << "\"}}";
+  }
+  s << "],\"displayTimeUnit\":\"ms\"}";
+  return s.str();
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.EventSummary").set_body_typed([]() {
+  return EventRecorder::Global()->Summary();
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.AsChromeTrace").set_body_typed([]() {
+  return String(EventRecorder::Global()->AsChromeTrace());
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.ClearEvents").set_body_typed([]() {
+  EventRecorder::Global()->Clear();
+});
+
+StageProfiler* StageProfiler::Global() {
+  static StageProfiler* inst = new StageProfiler();
+  return inst;
+}
+
+// Begin timestamps for the calling thread. Stages wrap loop nests, so the
+// pairs nest structurally and a stack suffices; generated kernels may run on
+// thread pool workers, hence thread_local rather than a member.
+static thread_local std::vector<int64_t> stage_begin_stack;
+
+void StageProfiler::Begin(const char* name) { stage_begin_stack.push_back(EventRecorder::Now()); }
+
+void StageProfiler::End(const char* name) {
+  int64_t end_ns = EventRecorder::Now();
+  if (stage_begin_stack.empty()) return;  // unmatched End; drop rather than crash
+  int64_t begin_ns = stage_begin_stack.back();
+  stage_begin_stack.pop_back();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& entry = totals_[name];
+  entry.first += end_ns - begin_ns;
+  entry.second += 1;
+}
+
+void StageProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  totals_.clear();
+}
+
+Report StageProfiler::Summary() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  double overall_us = 0;
+  for (auto& p : totals_) {
+    overall_us += p.second.first / 1e3;
+  }
+
+  std::vector<Map<String, ObjectRef>> rows;
+  for (auto& p : totals_) {
+    double us = p.second.first / 1e3;
+    std::unordered_map<String, ObjectRef> row;
+    row["Name"] = String(p.first);
+    row["Duration (us)"] = ObjectRef(make_object<DurationNode>(us));
+    row["Count"] = ObjectRef(make_object<CountNode>(p.second.second));
+    row["Percent"] = ObjectRef(make_object<PercentNode>(overall_us == 0 ? 0 : us / overall_us * 100));
+    rows.push_back(row);
+  }
+  // Stage counters are host-side wall time; report them under a single
+  // aggregate total rather than per device.
+  std::unordered_map<String, Map<String, ObjectRef>> device_metrics;
+  std::unordered_map<String, ObjectRef> total_row;
+  total_row["Name"] = String("Total");
+  total_row["Duration (us)"] = ObjectRef(make_object<DurationNode>(overall_us));
+  total_row["Percent"] = ObjectRef(make_object<PercentNode>(100));
+  total_row["Device"] = String("stages");
+  device_metrics["stages"] = total_row;
+  return Report(rows, device_metrics);
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.StageSummary").set_body_typed([]() {
+  return StageProfiler::Global()->Summary();
+});
+
+TVM_REGISTER_GLOBAL("runtime.profiling.ClearStageCounters").set_body_typed([]() {
+  StageProfiler::Global()->Clear();
+});
 }  // namespace profiling
 }  // namespace runtime
 }  // namespace tvm
+
+int TVMBackendProfileStageBegin(const char* name) {
+  tvm::runtime::profiling::StageProfiler::Global()->Begin(name);
+  return 0;
+}
+
+int TVMBackendProfileStageEnd(const char* name) {
+  tvm::runtime::profiling::StageProfiler::Global()->End(name);
+  return 0;
+}
@@ -37,13 +37,19 @@ namespace tvm {
 namespace runtime {
 
 struct Registry::Manager {
+  using FMap = std::unordered_map<std::string, Registry*>;
   // map storing the functions.
   // We deliberately used raw pointer
   // This is because PackedFunc can contain callbacks into the host languge(python)
   // and the resource can become invalid because of indeterminstic order of destruction and forking.
   // The resources will only be recycled during program exit.
-  std::unordered_map<std::string, Registry*> fmap;
-  // mutex
+  FMap fmap;
+  // Read-mostly snapshot of fmap, RCU style: Get reads the current snapshot
+  // without taking the mutex, while writers invalidate it under the mutex and
+  // the next lookup rebuilds it. Entries are never freed, so handles obtained
+  // through any snapshot stay valid for the lifetime of the process.
+  std::shared_ptr<const FMap> fmap_snapshot;
+  // mutex, serializing writers and snapshot rebuilds
   std::mutex mutex;
 
   Manager() {}
@@ -55,6 +61,12 @@ struct Registry::Manager {
     static Manager* inst = new Manager();
     return inst;
   }
+
+  // Drop the published snapshot after a mutation. Requires mutex to be held.
+  void InvalidateSnapshot() {
+    std::atomic_store_explicit(&fmap_snapshot, std::shared_ptr<const FMap>(nullptr),
+                               std::memory_order_release);
+  }
 };
 
 Registry& Registry::set_body(PackedFunc f) {  // NOLINT(*)
@@ -72,6 +84,7 @@ Registry& Registry::Register(const std::string& name, bool can_override) {  // N
   Registry* r = new Registry();
   r->name_ = name;
   m->fmap[name] = r;
+  m->InvalidateSnapshot();
   return *r;
 }
 
@@ -81,14 +94,27 @@ bool Registry::Remove(const std::string& name) {
   auto it = m->fmap.find(name);
   if (it == m->fmap.end()) return false;
   m->fmap.erase(it);
+  m->InvalidateSnapshot();
   return true;
 }
 
 const PackedFunc* Registry::Get(const std::string& name) {
   Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
+  // Fast path: read the current snapshot without taking the mutex. In the
+  // steady state (registrations happen at startup, lookups on serving paths)
+  // this is a single atomic load plus a hash lookup.
+  std::shared_ptr<const Manager::FMap> snap =
+      std::atomic_load_explicit(&m->fmap_snapshot, std::memory_order_acquire);
+  if (snap == nullptr) {
+    std::lock_guard<std::mutex> lock(m->mutex);
+    snap = std::atomic_load_explicit(&m->fmap_snapshot, std::memory_order_acquire);
+    if (snap == nullptr) {
+      snap = std::make_shared<const Manager::FMap>(m->fmap);
+      std::atomic_store_explicit(&m->fmap_snapshot, snap, std::memory_order_release);
+    }
+  }
+  auto it = snap->find(name);
+  if (it == snap->end()) return nullptr;
   return &(it->second->func_);
 }
 
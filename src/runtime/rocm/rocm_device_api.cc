@@ -29,11 +29,179 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "rocm_common.h"
 
 namespace tvm {
 namespace runtime {
 
+/*!
+ * \brief Double-buffered pinned staging pool for pageable host copies.
+ *
+ * Transfers from pageable host memory go through the driver's internal
+ * staging path and run well below interconnect peak. Large copies are
+ * instead pipelined through this pool: one pinned chunk is in flight on
+ * the copy stream while the host fills (or drains) the other. Buffers,
+ * events and the fallback stream are kept per device, lazily created and
+ * recycled across copies, mirroring the CUDA staging pool.
+ */
+class ROCMPinnedStagingPool {
+ public:
+  /*! \brief Size of one pinned staging chunk. */
+  static constexpr size_t kChunkBytes = 4 << 20;
+  /*! \brief Minimal copy size that goes through the pipeline. */
+  static constexpr size_t kMinPipelineBytes = 2 * kChunkBytes;
+  /*! \brief Number of staging chunks per device. */
+  static constexpr int kNumBuffers = 2;
+
+  /*!
+   * \brief Copy between pageable host memory and the current device.
+   * \param device_id The already activated device.
+   * \param from The source pointer.
+   * \param to The destination pointer.
+   * \param size Number of bytes, at least kMinPipelineBytes.
+   * \param kind Either hipMemcpyHostToDevice or hipMemcpyDeviceToHost.
+   * \param user_stream The caller stream, or nullptr for synchronous copy.
+   */
+  void Copy(int device_id, const void* from, void* to, size_t size, hipMemcpyKind kind,
+            hipStream_t user_stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeviceStaging& st = GetStaging(device_id);
+    hipStream_t stream = user_stream != nullptr ? user_stream : st.stream;
+    if (kind == hipMemcpyHostToDevice) {
+      int buf = 0;
+      for (size_t offset = 0; offset < size; offset += kChunkBytes) {
+        size_t nbytes = std::min(kChunkBytes, size - offset);
+        // Wait until the previous transfer out of this chunk has finished.
+        ROCM_CALL(hipEventSynchronize(st.events[buf]));
+        memcpy(st.buffers[buf], static_cast<const char*>(from) + offset, nbytes);
+        ROCM_CALL(hipMemcpyAsync(static_cast<char*>(to) + offset, st.buffers[buf], nbytes, kind,
+                                 stream));
+        ROCM_CALL(hipEventRecord(st.events[buf], stream));
+        buf = (buf + 1) % kNumBuffers;
+      }
+      // The pageable source is fully staged; only the internal stream has to
+      // preserve the synchronous contract of a null caller stream.
+      if (user_stream == nullptr) {
+        ROCM_CALL(hipStreamSynchronize(st.stream));
+      }
+    } else {
+      ICHECK(kind == hipMemcpyDeviceToHost);
+      std::array<size_t, kNumBuffers> chunk_offset;
+      std::array<size_t, kNumBuffers> chunk_bytes;
+      size_t issued = 0, drained = 0;
+      int issue_buf = 0, drain_buf = 0, inflight = 0;
+      while (drained < size) {
+        while (issued < size && inflight < kNumBuffers) {
+          size_t nbytes = std::min(kChunkBytes, size - issued);
+          ROCM_CALL(hipMemcpyAsync(st.buffers[issue_buf], static_cast<const char*>(from) + issued,
+                                   nbytes, kind, stream));
+          ROCM_CALL(hipEventRecord(st.events[issue_buf], stream));
+          chunk_offset[issue_buf] = issued;
+          chunk_bytes[issue_buf] = nbytes;
+          issued += nbytes;
+          issue_buf = (issue_buf + 1) % kNumBuffers;
+          ++inflight;
+        }
+        // Drain the oldest chunk while the other one is still in flight.
+        ROCM_CALL(hipEventSynchronize(st.events[drain_buf]));
+        memcpy(static_cast<char*>(to) + chunk_offset[drain_buf], st.buffers[drain_buf],
+               chunk_bytes[drain_buf]);
+        drained += chunk_bytes[drain_buf];
+        drain_buf = (drain_buf + 1) % kNumBuffers;
+        --inflight;
+      }
+    }
+  }
+
+ private:
+  struct DeviceStaging {
+    void* buffers[kNumBuffers];
+    hipEvent_t events[kNumBuffers];
+    hipStream_t stream;
+  };
+
+  DeviceStaging& GetStaging(int device_id) {
+    auto it = staging_.find(device_id);
+    if (it != staging_.end()) return it->second;
+    DeviceStaging st;
+    for (int i = 0; i < kNumBuffers; ++i) {
+      ROCM_CALL(hipHostMalloc(&st.buffers[i], kChunkBytes));
+      ROCM_CALL(hipEventCreateWithFlags(&st.events[i], hipEventDisableTiming));
+    }
+    ROCM_CALL(hipStreamCreate(&st.stream));
+    return staging_.emplace(device_id, st).first->second;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<int, DeviceStaging> staging_;
+};
+
+/*!
+ * \brief Recycling pool of HIP streams.
+ *
+ * Stream creation and destruction take a device-wide lock inside the
+ * runtime, which serializes executors that each manage their own streams.
+ * Released streams are parked per device and priority and handed back on
+ * the next request, mirroring the CUDA stream pool.
+ */
+class ROCMStreamPool {
+ public:
+  /*! \brief Maximal number of idle streams kept per device and priority. */
+  static constexpr size_t kMaxIdleStreams = 32;
+
+  hipStream_t Acquire(int device_id, int priority) {
+    // Clamp to the device range; numerically lower values run at higher
+    // priority and 0 is always valid.
+    int least, greatest;
+    ROCM_CALL(hipDeviceGetStreamPriorityRange(&least, &greatest));
+    priority = std::min(std::max(priority, greatest), least);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<hipStream_t>& idle = idle_[Key(device_id, priority)];
+      if (!idle.empty()) {
+        hipStream_t stream = idle.back();
+        idle.pop_back();
+        return stream;
+      }
+    }
+    hipStream_t stream;
+    ROCM_CALL(hipStreamCreateWithPriority(&stream, hipStreamDefault, priority));
+    return stream;
+  }
+
+  void Release(int device_id, hipStream_t stream) {
+    // Drain pending work so the next owner does not inherit dependencies.
+    ROCM_CALL(hipStreamSynchronize(stream));
+    int priority = 0;
+    ROCM_CALL(hipStreamGetPriority(stream, &priority));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::vector<hipStream_t>& idle = idle_[Key(device_id, priority)];
+      if (idle.size() < kMaxIdleStreams) {
+        idle.push_back(stream);
+        return;
+      }
+    }
+    ROCM_CALL(hipStreamDestroy(stream));
+  }
+
+ private:
+  static uint64_t Key(int device_id, int priority) {
+    return (static_cast<uint64_t>(device_id) << 32) | static_cast<uint32_t>(priority);
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<hipStream_t>> idle_;
+};
+
 class ROCMDeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final { ROCM_CALL(hipSetDevice(dev.device_id)); }
@@ -153,15 +321,46 @@ class ROCMDeviceAPI final : public DeviceAPI {
       }
     } else if (dev_from.device_type == kDLROCM && dev_to.device_type == kDLCPU) {
       ROCM_CALL(hipSetDevice(dev_from.device_id));
-      GPUCopy(from, to, size, hipMemcpyDeviceToHost, hip_stream);
+      if (UsePinnedStaging(to, size)) {
+        staging_pool_.Copy(dev_from.device_id, from, to, size, hipMemcpyDeviceToHost, hip_stream);
+      } else {
+        GPUCopy(from, to, size, hipMemcpyDeviceToHost, hip_stream);
+      }
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLROCM) {
       ROCM_CALL(hipSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, hipMemcpyHostToDevice, hip_stream);
+      if (UsePinnedStaging(from, size)) {
+        staging_pool_.Copy(dev_to.device_id, from, to, size, hipMemcpyHostToDevice, hip_stream);
+      } else {
+        GPUCopy(from, to, size, hipMemcpyHostToDevice, hip_stream);
+      }
     } else {
       LOG(FATAL) << "expect copy from/to GPU or between GPU";
     }
   }
 
+  TVMStreamHandle CreateStream(Device dev) { return CreateStream(dev, 0); }
+
+  TVMStreamHandle CreateStream(Device dev, int priority) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    return static_cast<TVMStreamHandle>(stream_pool_.Acquire(dev.device_id, priority));
+  }
+
+  void FreeStream(Device dev, TVMStreamHandle stream) {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    stream_pool_.Release(dev.device_id, static_cast<hipStream_t>(stream));
+  }
+
+  void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    hipStream_t src_stream = static_cast<hipStream_t>(event_src);
+    hipStream_t dst_stream = static_cast<hipStream_t>(event_dst);
+    hipEvent_t evt;
+    ROCM_CALL(hipEventCreate(&evt));
+    ROCM_CALL(hipEventRecord(evt, src_stream));
+    ROCM_CALL(hipStreamWaitEvent(dst_stream, evt, 0));
+    ROCM_CALL(hipEventDestroy(evt));
+  }
+
   void StreamSync(Device dev, TVMStreamHandle stream) final {
     ROCM_CALL(hipSetDevice(dev.device_id));
     ROCM_CALL(hipStreamSynchronize(static_cast<hipStream_t>(stream)));
@@ -193,6 +392,31 @@ class ROCMDeviceAPI final : public DeviceAPI {
       ROCM_CALL(hipMemcpy(to, from, size, kind));
     }
   }
+
+  // Whether the host pointer is already known to HIP, i.e. pinned or managed.
+  static bool IsPinnedHostPtr(const void* ptr) {
+    hipPointerAttribute_t attr;
+    if (hipPointerGetAttributes(&attr, ptr) != hipSuccess) {
+      // Unregistered host memory reports an error.
+      hipGetLastError();
+      return false;
+    }
+    return true;
+  }
+
+  // The staging pipeline pays off only for large pageable copies; pinned
+  // sources and destinations already transfer at full speed.
+  static bool UsePinnedStaging(const void* host_ptr, size_t size) {
+    static const bool enabled = []() {
+      const char* env = std::getenv("TVM_ROCM_PINNED_STAGING");
+      return env == nullptr || atoi(env) != 0;
+    }();
+    return enabled && size >= ROCMPinnedStagingPool::kMinPipelineBytes &&
+           !IsPinnedHostPtr(host_ptr);
+  }
+
+  ROCMPinnedStagingPool staging_pool_;
+  ROCMStreamPool stream_pool_;
 };
 
 typedef dmlc::ThreadLocalStore<ROCMThreadEntry> ROCMThreadStore;
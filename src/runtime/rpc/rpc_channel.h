@@ -36,6 +36,13 @@ namespace runtime {
  */
 class RPCChannel {
  public:
+  /*! \brief A contiguous piece of memory used for scatter/gather I/O. */
+  struct BufferSegment {
+    /*! \brief Pointer to the segment data. */
+    void* data;
+    /*! \brief Number of bytes in the segment. */
+    size_t size;
+  };
   /*! \brief virtual destructor */
   virtual ~RPCChannel() {}
   /*!
@@ -53,6 +60,42 @@ class RPCChannel {
    * \return The actual bytes received.
    */
   virtual size_t Recv(void* data, size_t size) = 0;
+  /*!
+   * \brief Send data gathered from multiple segments.
+   *
+   *  The default implementation loops over Send; transports that support
+   *  scatter/gather I/O override it with a single system call.
+   * \param segs The segments to send, in order.
+   * \param nsegs The number of segments.
+   * \return The actual bytes sent.
+   */
+  virtual size_t SendV(const BufferSegment* segs, int nsegs) {
+    size_t total = 0;
+    for (int i = 0; i < nsegs; ++i) {
+      size_t n = Send(segs[i].data, segs[i].size);
+      total += n;
+      if (n < segs[i].size) break;
+    }
+    return total;
+  }
+  /*!
+   * \brief Recv data scattered across multiple segments.
+   *
+   *  The default implementation loops over Recv; transports that support
+   *  scatter/gather I/O override it with a single system call.
+   * \param segs The segments to fill, in order.
+   * \param nsegs The number of segments.
+   * \return The actual bytes received.
+   */
+  virtual size_t RecvV(const BufferSegment* segs, int nsegs) {
+    size_t total = 0;
+    for (int i = 0; i < nsegs; ++i) {
+      size_t n = Recv(segs[i].data, segs[i].size);
+      total += n;
+      if (n < segs[i].size) break;
+    }
+    return total;
+  }
 };
 
 /*!
@@ -621,18 +621,51 @@ class RPCEndpoint::EventHandler : public dmlc::Stream {
   std::function<void()> flush_writer_;
 };
 
+/*!
+ * \brief Drain up to max_nbytes from the ring buffer into the channel with a
+ *  single gather-send call, avoiding the intermediate copy and the second
+ *  system call when the data wraps around the ring.
+ * \return The number of bytes actually sent.
+ */
+static size_t GatherSend(support::RingBuffer* buf, RPCChannel* channel, size_t max_nbytes) {
+  support::RingBuffer::Segment segs[2];
+  int nsegs = buf->ReadSegments(segs, max_nbytes);
+  if (nsegs == 0) return 0;
+  RPCChannel::BufferSegment csegs[2];
+  for (int i = 0; i < nsegs; ++i) {
+    csegs[i] = RPCChannel::BufferSegment{segs[i].data, segs[i].size};
+  }
+  size_t n = channel->SendV(csegs, nsegs);
+  buf->CommitRead(n);
+  return n;
+}
+
+/*!
+ * \brief Fill the ring buffer with up to max_nbytes from the channel with a
+ *  single scatter-receive call.
+ * \return The number of bytes actually received.
+ */
+static size_t ScatterRecv(support::RingBuffer* buf, RPCChannel* channel, size_t max_nbytes) {
+  support::RingBuffer::Segment segs[2];
+  int nsegs = buf->WriteSegments(segs, max_nbytes);
+  RPCChannel::BufferSegment csegs[2];
+  for (int i = 0; i < nsegs; ++i) {
+    csegs[i] = RPCChannel::BufferSegment{segs[i].data, segs[i].size};
+  }
+  size_t n = channel->RecvV(csegs, nsegs);
+  buf->CommitWrite(n);
+  return n;
+}
+
 RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn) {
   RPCCode code = RPCCode::kCallFunc;
   while (code != RPCCode::kReturn && code != RPCCode::kShutdown && code != RPCCode::kCopyAck) {
     while (writer_.bytes_available() != 0) {
-      writer_.ReadWithCallback(
-          [this](const void* data, size_t size) { return channel_->Send(data, size); },
-          writer_.bytes_available());
+      GatherSend(&writer_, channel_.get(), writer_.bytes_available());
     }
     size_t bytes_needed = handler_->BytesNeeded();
     if (bytes_needed != 0) {
-      size_t n = reader_.WriteWithCallback(
-          [this](void* data, size_t size) { return channel_->Recv(data, size); }, bytes_needed);
+      size_t n = ScatterRecv(&reader_, channel_.get(), bytes_needed);
       if (n == 0) {
         if (handler_->CanCleanShutdown()) {
           return RPCCode::kShutdown;
@@ -650,9 +683,7 @@ void RPCEndpoint::Init() {
   // callback to flush the writer.
   auto flush_writer = [this]() {
     while (writer_.bytes_available() != 0) {
-      size_t n = writer_.ReadWithCallback(
-          [this](const void* data, size_t size) { return channel_->Send(data, size); },
-          writer_.bytes_available());
+      size_t n = GatherSend(&writer_, channel_.get(), writer_.bytes_available());
       if (n == 0) break;
     }
   };
@@ -660,9 +691,18 @@ void RPCEndpoint::Init() {
   // Event handler
   handler_ = std::make_shared<EventHandler>(&reader_, &writer_, name_, &remote_key_, flush_writer);
 
+  // Number of pipelined requests that may be in flight before the endpoint
+  // synchronously drains the oldest one. Keeping the window bounded prevents
+  // the reply stream from filling both transport directions at once.
+  if (const char* val = getenv("TVM_RPC_PIPELINE_DEPTH")) {
+    max_pipeline_depth_ = static_cast<size_t>(std::max(1, atoi(val)));
+  }
+
   // Quick function to for syscall remote.
   syscall_remote_ = PackedFunc([this](TVMArgs all_args, TVMRetValue* rv) {
     std::lock_guard<std::mutex> lock(mutex_);
+    // complete pipelined requests first so replies stay matched
+    while (!pipeline_pending_.empty()) DrainOnePipelined();
     RPCCode code = static_cast<RPCCode>(all_args[0].operator int());
     TVMArgs args(all_args.values + 1, all_args.type_codes + 1, all_args.num_args - 1);
 
@@ -713,9 +753,7 @@ void RPCEndpoint::Shutdown() {
     // flush all writing buffer to output channel.
     try {
       while (writer_.bytes_available() != 0) {
-        size_t n = writer_.ReadWithCallback(
-            [this](const void* data, size_t size) { return channel_->Send(data, size); },
-            writer_.bytes_available());
+        size_t n = GatherSend(&writer_, channel_.get(), writer_.bytes_available());
         if (n == 0) break;
       }
     } catch (const Error& e) {
@@ -743,9 +781,7 @@ int RPCEndpoint::ServerAsyncIOEventHandler(const std::string& in_bytes, int even
     code = handler_->HandleNextEvent(false, true, [](TVMArgs) {});
   }
   if ((event_flag & 2) != 0 && writer_.bytes_available() != 0) {
-    writer_.ReadWithCallback(
-        [this](const void* data, size_t size) { return channel_->Send(data, size); },
-        writer_.bytes_available());
+    GatherSend(&writer_, channel_.get(), writer_.bytes_available());
   }
   ICHECK(code != RPCCode::kReturn && code != RPCCode::kCopyAck);
   if (code == RPCCode::kShutdown) return 0;
@@ -755,6 +791,7 @@ int RPCEndpoint::ServerAsyncIOEventHandler(const std::string& in_bytes, int even
 
 void RPCEndpoint::InitRemoteSession(TVMArgs args) {
   std::lock_guard<std::mutex> lock(mutex_);
+  while (!pipeline_pending_.empty()) DrainOnePipelined();
   RPCCode code = RPCCode::kInitServer;
   std::string protocol_ver = kRPCProtocolVer;
   uint64_t length = protocol_ver.length();
@@ -779,6 +816,8 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
                            const int* arg_type_codes, int num_args,
                            RPCSession::FEncodeReturn encode_return) {
   std::lock_guard<std::mutex> lock(mutex_);
+  // complete pipelined requests first so replies stay matched
+  while (!pipeline_pending_.empty()) DrainOnePipelined();
 
   handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
   RPCCode code = RPCCode::kCallFunc;
@@ -799,6 +838,7 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
 
 void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   std::lock_guard<std::mutex> lock(mutex_);
+  while (!pipeline_pending_.empty()) DrainOnePipelined();
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
@@ -819,6 +859,7 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
 
 void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
   std::lock_guard<std::mutex> lock(mutex_);
+  while (!pipeline_pending_.empty()) DrainOnePipelined();
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
@@ -839,6 +880,70 @@ void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes
   handler_->FinishCopyAck();
 }
 
+void RPCEndpoint::CallFuncPipelined(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                                    const int* arg_type_codes, int num_args,
+                                    RPCSession::FEncodeReturn encode_return) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
+  RPCCode code = RPCCode::kCallFunc;
+  uint64_t handle = reinterpret_cast<uint64_t>(h);
+
+  uint64_t packet_nbytes =
+      sizeof(code) + sizeof(handle) +
+      handler_->PackedSeqGetNumBytes(arg_values, arg_type_codes, num_args, true);
+
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  handler_->Write(handle);
+  handler_->SendPackedSeq(arg_values, arg_type_codes, num_args, true);
+
+  pipeline_pending_.push_back(std::move(encode_return));
+  while (pipeline_pending_.size() >= max_pipeline_depth_) {
+    DrainOnePipelined();
+  }
+}
+
+void RPCEndpoint::CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RPCCode code = RPCCode::kCopyToRemote;
+
+  uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
+  ICHECK_LE(to->byte_offset + nbytes, tensor_total_size_bytes)
+      << "CopyToRemotePipelined: overflow in tensor size: (byte_offset=" << to->byte_offset
+      << ", nbytes=" << nbytes << ", tensor_total_size=" << tensor_total_size_bytes << ")";
+
+  uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(to, code, nbytes);
+  uint64_t packet_nbytes = overhead + nbytes;
+
+  handler_->Write(packet_nbytes);
+  handler_->Write(code);
+  RPCReference::SendDLTensor(handler_, to);
+  handler_->Write(nbytes);
+  handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+
+  pipeline_pending_.push_back([](TVMArgs) {});
+  while (pipeline_pending_.size() >= max_pipeline_depth_) {
+    DrainOnePipelined();
+  }
+}
+
+void RPCEndpoint::FlushPipeline() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (!pipeline_pending_.empty()) {
+    DrainOnePipelined();
+  }
+}
+
+void RPCEndpoint::DrainOnePipelined() {
+  RPCSession::FEncodeReturn encode_return = std::move(pipeline_pending_.front());
+  pipeline_pending_.pop_front();
+  // The peer answers requests in order, so the next return event belongs to
+  // the oldest in-flight request.
+  RPCCode code = HandleUntilReturnEvent(true, encode_return);
+  ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+}
+
 // SysCallEventHandler functions
 void RPCGetGlobalFunc(RPCSession* handler, TVMArgs args, TVMRetValue* rv) {
   std::string name = args[0];
@@ -985,6 +1090,17 @@ void RPCEndpoint::EventHandler::HandleSyscall(RPCCode code) {
   }
 }
 
+// 64-bit FNV-1a over a chunk payload, used as the content address of
+// uploaded tensor chunks.
+static uint64_t ChunkHash(const void* data, size_t nbytes) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < nbytes; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ULL;
+  }
+  return hash;
+}
+
 /*!
  * \brief RPC client session that proxies all calls to an endpoint.
  */
@@ -1005,6 +1121,14 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     endpoint_->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
   }
 
+  void CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                         const int* arg_type_codes, int num_args,
+                         const FEncodeReturn& fencode_return) final {
+    endpoint_->CallFuncPipelined(func, arg_values, arg_type_codes, num_args, fencode_return);
+  }
+
+  void FlushPipeline() final { endpoint_->FlushPipeline(); }
+
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
     RPCCode code = RPCCode::kCopyToRemote;
     uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
@@ -1015,11 +1139,13 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     const uint64_t num_blocks = nbytes / block_size;
     void* from_bytes;
 
+    // pipeline the blocks so a chunked copy pays one round trip per window
+    // rather than one per block
     for (block_count = 0; block_count < num_blocks; block_count++) {
       remote_to->byte_offset = block_count * block_size;
       from_bytes = reinterpret_cast<void*>(
           (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
+      CopyBlockToRemote(from_bytes, remote_to, block_size);
     }
 
     const uint64_t remainder_bytes = nbytes % block_size;
@@ -1027,8 +1153,9 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
       remote_to->byte_offset = block_count * block_size;
       from_bytes = reinterpret_cast<void*>(
           (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
+      CopyBlockToRemote(from_bytes, remote_to, remainder_bytes);
     }
+    endpoint_->FlushPipeline();
   }
 
   void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
@@ -1123,6 +1250,61 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   bool IsLocalSession() const final { return false; }
 
  private:
+  // Copy one block, going through the server's content-addressed chunk cache
+  // when the server supports it: a chunk the server already holds is filled
+  // from its cache instead of re-transferred.
+  void CopyBlockToRemote(void* from_bytes, DLTensor* remote_to, uint64_t nbytes) {
+    if (!ChunkCacheEnabled()) {
+      endpoint_->CopyToRemotePipelined(from_bytes, remote_to, nbytes);
+      return;
+    }
+    int64_t hash = static_cast<int64_t>(ChunkHash(from_bytes, nbytes));
+    TVMValue values[3];
+    int codes[3];
+    TVMArgsSetter setter(values, codes);
+    setter(0, hash);
+    setter(1, static_cast<int64_t>(nbytes));
+    int has = 0;
+    endpoint_->CallFunc(fchunk_has_, values, codes, 2,
+                        [&has](TVMArgs args) { has = args[1].operator int(); });
+    if (has) {
+      setter(1, remote_to);
+      setter(2, static_cast<int64_t>(nbytes));
+      int filled = 0;
+      endpoint_->CallFunc(fchunk_fill_, values, codes, 3,
+                          [&filled](TVMArgs args) { filled = args[1].operator int(); });
+      // the chunk may have been evicted between the probe and the fill
+      if (filled) return;
+    }
+    TVMByteArray bytes;
+    bytes.data = static_cast<const char*>(from_bytes);
+    bytes.size = nbytes;
+    setter(1, bytes);
+    setter(2, remote_to);
+    endpoint_->CallFunc(fchunk_put_, values, codes, 3, [](TVMArgs) {});
+  }
+
+  // Probe the remote for chunk cache support once; TVM_RPC_CHUNK_CACHE=0
+  // forces the plain byte-copy path.
+  bool ChunkCacheEnabled() {
+    if (chunk_cache_state_ == 0) {
+      const char* val = getenv("TVM_RPC_CHUNK_CACHE");
+      // Chunk payloads bypass the endian handling of the tensor copy
+      // protocol, so the cache is only used between little-endian peers.
+      if ((val != nullptr && atoi(val) == 0) || !DMLC_IO_NO_ENDIAN_SWAP) {
+        chunk_cache_state_ = -1;
+      } else {
+        fchunk_has_ = GetFunction("tvm.rpc.server.chunk_cache.has");
+        fchunk_fill_ = GetFunction("tvm.rpc.server.chunk_cache.fill");
+        fchunk_put_ = GetFunction("tvm.rpc.server.chunk_cache.put");
+        bool supported =
+            fchunk_has_ != nullptr && fchunk_fill_ != nullptr && fchunk_put_ != nullptr;
+        chunk_cache_state_ = supported ? 1 : -1;
+      }
+    }
+    return chunk_cache_state_ == 1;
+  }
+
   uint64_t GetRPCMaxTransferSize() {
     if (rpc_chunk_max_size_bytes_ > 0) {
       return (uint64_t)rpc_chunk_max_size_bytes_;
@@ -1146,6 +1328,12 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
 
   std::shared_ptr<RPCEndpoint> endpoint_;
   int64_t rpc_chunk_max_size_bytes_ = -1;
+  // Chunk cache negotiation state: 0 unprobed, 1 supported, -1 unsupported
+  // or disabled.
+  int chunk_cache_state_ = 0;
+  PackedFuncHandle fchunk_has_ = nullptr;
+  PackedFuncHandle fchunk_fill_ = nullptr;
+  PackedFuncHandle fchunk_put_ = nullptr;
 };
 
 std::shared_ptr<RPCSession> CreateClientSession(std::shared_ptr<RPCEndpoint> endpoint) {
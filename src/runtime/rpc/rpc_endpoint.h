@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/packed_func.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -148,6 +149,40 @@ class RPCEndpoint {
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
 
+  /*!
+   * \brief Queue a remote call without waiting for its completion.
+   *
+   *  The request is appended to the write buffer and the reply is consumed
+   *  later, either by FlushPipeline or when the number of in-flight requests
+   *  reaches the pipeline depth (TVM_RPC_PIPELINE_DEPTH, default 64). The
+   *  peer answers requests in order, so encode_return runs when the matching
+   *  reply is drained. Latency-bound loops of small calls thus pay one round
+   *  trip per window instead of one per call.
+   *
+   * \param handle The function handle.
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param encode_return The function to receive return value encodings,
+   *        invoked when the reply is drained.
+   */
+  void CallFuncPipelined(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
+                         const int* arg_type_codes, int num_args,
+                         RPCSession::FEncodeReturn encode_return);
+  /*!
+   * \brief Queue a CopyToRemote without waiting for its completion.
+   * \param from_bytes The source host data, must stay alive until the
+   *        pipeline is flushed.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   */
+  void CopyToRemotePipelined(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  /*!
+   * \brief Wait until every queued pipelined request has completed and its
+   *        completion callback has run.
+   */
+  void FlushPipeline();
+
   /*!
    * \brief Call a remote defined system function with arguments.
    * \param fcode The function code.
@@ -172,6 +207,9 @@ class RPCEndpoint {
   // Handle events until receives a return
   // Also flushes channels so that the function advances.
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
+  // Wait for the oldest in-flight pipelined request and run its callback.
+  // Requires mutex_ to be held.
+  void DrainOnePipelined();
   // Initalization
   void Init();
   // Shutdown
@@ -180,6 +218,10 @@ class RPCEndpoint {
   std::unique_ptr<RPCChannel> channel_;
   // Internal mutex
   std::mutex mutex_;
+  // Completion callbacks of in-flight pipelined requests, oldest first.
+  std::deque<RPCSession::FEncodeReturn> pipeline_pending_;
+  // Maximum number of in-flight pipelined requests.
+  size_t max_pipeline_depth_{64};
   // Internal ring buffer.
   support::RingBuffer reader_, writer_;
   // Event handler.
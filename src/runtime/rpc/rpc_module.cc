@@ -31,6 +31,12 @@
 #if defined(_M_X64) || defined(__x86_64__)
 #include <immintrin.h>
 #endif
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "rpc_endpoint.h"
 #include "rpc_session.h"
@@ -189,7 +195,8 @@ class RPCModuleNode final : public ModuleNode {
   }
 
   PackedFunc GetTimeEvaluator(const std::string& name, Device dev, int number, int repeat,
-                              int min_repeat_ms, const std::string& f_preproc_name) {
+                              int min_repeat_ms, const std::string& f_preproc_name,
+                              bool collect_hw_counters) {
     InitRemoteFunc(&remote_get_time_evaluator_, "runtime.RPCTimeEvaluator");
     // Remove session mask because we pass dev by parts.
     ICHECK_EQ(GetRPCSessionIndex(dev), sess_->table_index())
@@ -199,11 +206,13 @@ class RPCModuleNode final : public ModuleNode {
     if (module_handle_ != nullptr) {
       return remote_get_time_evaluator_(GetRef<Module>(this), name,
                                         static_cast<int>(dev.device_type), dev.device_id, number,
-                                        repeat, min_repeat_ms, f_preproc_name);
+                                        repeat, min_repeat_ms, f_preproc_name,
+                                        collect_hw_counters);
     } else {
       return remote_get_time_evaluator_(Optional<Module>(nullptr), name,
                                         static_cast<int>(dev.device_type), dev.device_id, number,
-                                        repeat, min_repeat_ms, f_preproc_name);
+                                        repeat, min_repeat_ms, f_preproc_name,
+                                        collect_hw_counters);
     }
   }
 
@@ -241,7 +250,8 @@ class RPCModuleNode final : public ModuleNode {
   // The local channel
   std::shared_ptr<RPCSession> sess_;
   // remote function to get time evaluator
-  TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, std::string)>
+  TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, std::string,
+                             bool)>
       remote_get_time_evaluator_;
   // remote function getter for modules.
   TypedPackedFunc<PackedFunc(Module, std::string, bool)> remote_mod_get_function_;
@@ -342,8 +352,89 @@ inline void CPUCacheFlush(int begin_index, const TVMArgs& args) {
   }
 }
 
+#if defined(__linux__)
+/*!
+ * \brief A group of perf_event hardware counters covering the calling thread.
+ *
+ *  The four counters are opened as one kernel event group so they are
+ *  scheduled on and off the PMU together and stay mutually consistent.
+ *  Construction can fail (no PMU, perf_event_paranoid, seccomp); callers
+ *  must check valid() and degrade to zero counts.
+ */
+class PerfEventGroup {
+ public:
+  /*! \brief Counter order: instructions, cycles, cache refs, cache misses. */
+  static constexpr int kNumCounters = 4;
+
+  PerfEventGroup() {
+    static const uint64_t configs[kNumCounters] = {
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < kNumCounters; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = (i == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      int group_fd = (i == 0) ? -1 : fds_[0];
+      int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+      if (fd < 0) {
+        Close();
+        return;
+      }
+      fds_[i] = fd;
+    }
+  }
+
+  ~PerfEventGroup() { Close(); }
+
+  bool valid() const { return fds_[kNumCounters - 1] >= 0; }
+
+  void Start() {
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  void Stop(uint64_t* counters) {
+    ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    // PERF_FORMAT_GROUP read layout: { u64 nr; u64 values[nr]; }
+    uint64_t buf[1 + kNumCounters];
+    if (read(fds_[0], buf, sizeof(buf)) == static_cast<ssize_t>(sizeof(buf)) &&
+        buf[0] == kNumCounters) {
+      std::memcpy(counters, buf + 1, kNumCounters * sizeof(uint64_t));
+    } else {
+      std::memset(counters, 0, kNumCounters * sizeof(uint64_t));
+    }
+  }
+
+ private:
+  void Close() {
+    for (int i = 0; i < kNumCounters; ++i) {
+      if (fds_[i] >= 0) {
+        close(fds_[i]);
+        fds_[i] = -1;
+      }
+    }
+  }
+
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+#else
+class PerfEventGroup {
+ public:
+  static constexpr int kNumCounters = 4;
+  bool valid() const { return false; }
+  void Start() {}
+  void Stop(uint64_t* counters) { std::memset(counters, 0, kNumCounters * sizeof(uint64_t)); }
+};
+#endif
+
 PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat, int min_repeat_ms,
-                             PackedFunc f_preproc) {
+                             PackedFunc f_preproc, bool collect_hw_counters) {
   ICHECK(pf != nullptr);
 
   if (static_cast<int>(dev.device_type) == static_cast<int>(kDLMicroDev)) {
@@ -352,10 +443,19 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
     return (*get_micro_time_evaluator)(pf, dev, number, repeat);
   }
 
-  auto ftimer = [pf, dev, number, repeat, min_repeat_ms, f_preproc](TVMArgs args,
-                                                                    TVMRetValue* rv) mutable {
+  auto ftimer = [pf, dev, number, repeat, min_repeat_ms, f_preproc, collect_hw_counters](
+                    TVMArgs args, TVMRetValue* rv) mutable {
     TVMRetValue temp;
     std::ostringstream os;
+    std::ostringstream os_counters;
+    std::unique_ptr<PerfEventGroup> perf_group;
+    if (collect_hw_counters) {
+      perf_group = std::make_unique<PerfEventGroup>();
+      if (!perf_group->valid()) {
+        LOG(WARNING) << "Hardware counters requested but perf_event is unavailable, "
+                     << "reporting zero counts";
+      }
+    }
     // skip first time call, to activate lazy compilation components.
     pf.CallPacked(args, &temp);
 
@@ -366,6 +466,7 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
         f_preproc.CallPacked(args, &temp);
       }
       double duration_ms = 0.0;
+      uint64_t counters[PerfEventGroup::kNumCounters] = {0};
 
       do {
         if (duration_ms > 0.0) {
@@ -373,25 +474,34 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
                                              number * 1.618));  // 1.618 is chosen by random
         }
 
+        if (perf_group != nullptr && perf_group->valid()) perf_group->Start();
         Timer t = Timer::Start(dev);
         // start timing
         for (int i = 0; i < number; ++i) {
           pf.CallPacked(args, &temp);
         }
         t->Stop();
+        if (perf_group != nullptr && perf_group->valid()) perf_group->Stop(counters);
         int64_t t_nanos = t->SyncAndGetElapsedNanos();
         duration_ms = t_nanos / 1e6;
       } while (duration_ms < min_repeat_ms);
 
       double speed = duration_ms / 1e3 / number;
       os.write(reinterpret_cast<char*>(&speed), sizeof(speed));
+      if (collect_hw_counters) {
+        // report per-invocation averages, matching how the time is reported.
+        for (int k = 0; k < PerfEventGroup::kNumCounters; ++k) {
+          counters[k] /= static_cast<uint64_t>(number);
+        }
+        os_counters.write(reinterpret_cast<char*>(counters), sizeof(counters));
+      }
     }
 
-    std::string blob = os.str();
+    std::string blob = os.str() + os_counters.str();
     TVMByteArray arr;
     arr.size = blob.length();
     arr.data = blob.data();
-    // return the time.
+    // return the time, followed by the counters when they were requested.
     *rv = arr;
   };
   return PackedFunc(ftimer);
@@ -399,7 +509,8 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
 
 TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
     .set_body_typed([](Optional<Module> opt_mod, std::string name, int device_type, int device_id,
-                       int number, int repeat, int min_repeat_ms, std::string f_preproc_name) {
+                       int number, int repeat, int min_repeat_ms, std::string f_preproc_name,
+                       bool collect_hw_counters) {
       Device dev;
       dev.device_type = static_cast<DLDeviceType>(device_type);
       dev.device_id = device_id;
@@ -408,7 +519,8 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
         std::string tkey = m->type_key();
         if (tkey == "rpc") {
           return static_cast<RPCModuleNode*>(m.operator->())
-              ->GetTimeEvaluator(name, dev, number, repeat, min_repeat_ms, f_preproc_name);
+              ->GetTimeEvaluator(name, dev, number, repeat, min_repeat_ms, f_preproc_name,
+                                 collect_hw_counters);
         } else {
           PackedFunc f_preproc;
           if (!f_preproc_name.empty()) {
@@ -418,7 +530,7 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
             f_preproc = *pf_preproc;
           }
           return WrapTimeEvaluator(m.GetFunction(name, false), dev, number, repeat, min_repeat_ms,
-                                   f_preproc);
+                                   f_preproc, collect_hw_counters);
         }
       } else {
         auto* pf = runtime::Registry::Get(name);
@@ -430,7 +542,8 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
               << "Cannot find " << f_preproc_name << " in the global function";
           f_preproc = *pf_preproc;
         }
-        return WrapTimeEvaluator(*pf, dev, number, repeat, min_repeat_ms, f_preproc);
+        return WrapTimeEvaluator(*pf, dev, number, repeat, min_repeat_ms, f_preproc,
+                                 collect_hw_counters);
       }
     });
 
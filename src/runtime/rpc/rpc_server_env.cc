@@ -21,8 +21,15 @@
  * \file rpc_server_env.cc
  * \brief Server environment of the RPC.
  */
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 #include "../file_utils.h"
 
 namespace tvm {
@@ -57,5 +64,116 @@ TVM_REGISTER_GLOBAL("tvm.rpc.server.remove").set_body([](TVMArgs args, TVMRetVal
   RemoveFile(file_name);
 });
 
+namespace {
+
+// Copy a CPU chunk into (a byte range of) a device tensor, honoring the
+// tensor's byte_offset.
+void CopyChunkToTensor(const char* data, uint64_t nbytes, DLTensor* to) {
+  int64_t shape = static_cast<int64_t>(nbytes);
+  DLTensor from;
+  from.data = const_cast<char*>(data);
+  from.device = Device{kDLCPU, 0};
+  from.ndim = 1;
+  from.dtype = DLDataType{kDLUInt, 8, 1};
+  from.shape = &shape;
+  from.strides = nullptr;
+  from.byte_offset = 0;
+
+  DLTensor to_view = *to;
+  to_view.ndim = 1;
+  to_view.dtype = DLDataType{kDLUInt, 8, 1};
+  to_view.shape = &shape;
+  to_view.strides = nullptr;
+
+  DeviceAPI* api = DeviceAPI::Get(to->device);
+  api->CopyDataFromTo(&from, &to_view, nullptr);
+  api->StreamSync(to->device, nullptr);
+}
+
+/*!
+ * \brief Content-addressed cache of tensor chunks uploaded over RPC.
+ *
+ *  Clients hash each chunk before a CopyToRemote and skip the byte transfer
+ *  when the server already holds the chunk (see RPCClientSession). The cache
+ *  keeps CPU copies, capped by TVM_RPC_CHUNK_CACHE_BYTES (default 64MB,
+ *  0 disables caching), evicting in FIFO order.
+ */
+class RPCChunkCache {
+ public:
+  static RPCChunkCache* Global() {
+    static RPCChunkCache* inst = new RPCChunkCache();
+    return inst;
+  }
+
+  bool Has(uint64_t hash, uint64_t nbytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(hash);
+    return it != cache_.end() && it->second.size() == nbytes;
+  }
+
+  // Copy the cached chunk into the destination tensor; false when the chunk
+  // got evicted between the client's Has probe and this call.
+  bool Fill(uint64_t hash, DLTensor* to, uint64_t nbytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(hash);
+    if (it == cache_.end() || it->second.size() != nbytes) return false;
+    CopyChunkToTensor(it->second.data(), nbytes, to);
+    return true;
+  }
+
+  void Put(uint64_t hash, std::string data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (max_bytes_ == 0 || data.size() > max_bytes_) return;
+    if (cache_.count(hash)) return;
+    cur_bytes_ += data.size();
+    order_.push_back(hash);
+    cache_.emplace(hash, std::move(data));
+    while (cur_bytes_ > max_bytes_) {
+      auto it = cache_.find(order_.front());
+      order_.pop_front();
+      cur_bytes_ -= it->second.size();
+      cache_.erase(it);
+    }
+  }
+
+ private:
+  RPCChunkCache() {
+    if (const char* val = getenv("TVM_RPC_CHUNK_CACHE_BYTES")) {
+      max_bytes_ = static_cast<size_t>(atoll(val));
+    }
+  }
+
+  /*! \brief Cap on the cached bytes; 0 disables the cache. */
+  size_t max_bytes_{64 << 20};
+  size_t cur_bytes_{0};
+  /*! \brief Insertion order of the chunks, for FIFO eviction. */
+  std::deque<uint64_t> order_;
+  std::unordered_map<uint64_t, std::string> cache_;
+  std::mutex mutex_;
+};
+
+}  // namespace
+
+TVM_REGISTER_GLOBAL("tvm.rpc.server.chunk_cache.has").set_body([](TVMArgs args, TVMRetValue* rv) {
+  uint64_t hash = static_cast<uint64_t>(args[0].operator int64_t());
+  uint64_t nbytes = static_cast<uint64_t>(args[1].operator int64_t());
+  *rv = RPCChunkCache::Global()->Has(hash, nbytes);
+});
+
+TVM_REGISTER_GLOBAL("tvm.rpc.server.chunk_cache.fill").set_body([](TVMArgs args, TVMRetValue* rv) {
+  uint64_t hash = static_cast<uint64_t>(args[0].operator int64_t());
+  DLTensor* to = args[1];
+  uint64_t nbytes = static_cast<uint64_t>(args[2].operator int64_t());
+  *rv = RPCChunkCache::Global()->Fill(hash, to, nbytes);
+});
+
+TVM_REGISTER_GLOBAL("tvm.rpc.server.chunk_cache.put").set_body([](TVMArgs args, TVMRetValue* rv) {
+  uint64_t hash = static_cast<uint64_t>(args[0].operator int64_t());
+  std::string data = args[1];
+  DLTensor* to = args[2];
+  CopyChunkToTensor(data.data(), data.size(), to);
+  RPCChunkCache::Global()->Put(hash, std::move(data));
+});
+
 }  // namespace runtime
 }  // namespace tvm
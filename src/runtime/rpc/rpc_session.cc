@@ -34,6 +34,15 @@ namespace runtime {
 
 bool RPCSession::IsAsync() const { return false; }
 
+void RPCSession::CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                                   const int* arg_type_codes, int num_args,
+                                   const FEncodeReturn& fencode_return) {
+  // default: no pipelining support, complete the call synchronously.
+  this->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
+}
+
+void RPCSession::FlushPipeline() {}
+
 void RPCSession::SendException(FAsyncCallback callback, const char* msg) {
   TVMValue value;
   value.v_str = msg;
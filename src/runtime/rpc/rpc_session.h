@@ -125,6 +125,32 @@ class RPCSession {
                         const int* arg_type_codes, int num_args,
                         const FEncodeReturn& fencode_return) = 0;
 
+  /*!
+   * \brief Pipelined variant of CallFunc that queues the call without
+   *  waiting for its completion.
+   *
+   *  fencode_return runs when the matching reply is drained, at the latest
+   *  during the next FlushPipeline. Sessions that do not support pipelining
+   *  fall back to the synchronous CallFunc, in which case fencode_return is
+   *  invoked before this function returns.
+   *
+   * \param func The function handle.
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param fencode_return The function to set the return value.
+   */
+  virtual void CallFuncPipelined(PackedFuncHandle func, const TVMValue* arg_values,
+                                 const int* arg_type_codes, int num_args,
+                                 const FEncodeReturn& fencode_return);
+
+  /*!
+   * \brief Wait until every call queued through CallFuncPipelined has
+   *  completed and its callback has run. A no-op for sessions without
+   *  pipelining support.
+   */
+  virtual void FlushPipeline();
+
   /*!
    * \brief Copy bytes into remote array content.
    * \param local_from_bytes The source host data.
@@ -300,10 +326,13 @@ struct RemoteSpace {
  *        i.e., When the run time of one `repeat` falls below this time,
  *        the `number` parameter will be automatically increased.
  * \param f_preproc The function to be executed before we excetute time evaluator.
+ * \param collect_hw_counters Whether to collect hardware performance counters
+ *        (instructions, cycles, cache references/misses) for each `repeat` via
+ *        perf_event. Only supported on Linux; zeros are reported elsewhere.
  * \return f_timer A timer function.
  */
 PackedFunc WrapTimeEvaluator(PackedFunc f, Device dev, int number, int repeat, int min_repeat_ms,
-                             PackedFunc f_preproc = nullptr);
+                             PackedFunc f_preproc = nullptr, bool collect_hw_counters = false);
 
 /*!
  * \brief Create a Global RPC module that refers to the session.
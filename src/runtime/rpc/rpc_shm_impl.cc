@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_shm_impl.cc
+ * \brief Shared-memory RPC channel for same-host sessions.
+ *
+ *  The client and server rendezvous on a mmap-ed file holding a pair of
+ *  lock-free single-producer single-consumer rings, one per direction.
+ *  Messages then flow through plain memcpy instead of the TCP stack,
+ *  which removes the per-fragment system calls and protocol overhead of
+ *  the socket transport for co-located tuning setups.
+ */
+// Linux only for now, as linux is the most common usecase.
+#if defined(__linux__) || defined(__ANDROID__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <tvm/runtime/registry.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "rpc_endpoint.h"
+#include "rpc_local_session.h"
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief Control block of one single-producer single-consumer ring. */
+struct ShmRingState {
+  /*! \brief Monotonically increasing read position. */
+  std::atomic<uint64_t> head;
+  /*! \brief Monotonically increasing write position. */
+  std::atomic<uint64_t> tail;
+};
+
+/*! \brief Header of the shared mapping, followed by the two ring buffers. */
+struct ShmHeader {
+  /*! \brief Magic number identifying an initialized mapping. */
+  uint32_t magic;
+  /*! \brief Set to 1 by the server once the header is initialized. */
+  std::atomic<uint32_t> ready;
+  /*! \brief Byte capacity of each ring. */
+  uint64_t ring_bytes;
+  /*! \brief Ring 0 carries client to server data, ring 1 the reverse. */
+  ShmRingState rings[2];
+};
+
+static constexpr uint32_t kShmMagic = 0x525053U;  // "RPS"
+static constexpr uint64_t kShmDefaultRingBytes = 8 << 20;
+
+/*!
+ * \brief One direction of the shared-memory transport.
+ *
+ *  The producer owns tail and the consumer owns head, so no locking is
+ *  needed; both sides spin briefly and then yield while the ring is
+ *  full (producer) or empty (consumer).
+ */
+class ShmRing {
+ public:
+  ShmRing() = default;
+
+  void Init(ShmRingState* state, char* data, uint64_t capacity) {
+    state_ = state;
+    data_ = data;
+    capacity_ = capacity;
+  }
+
+  size_t Send(const void* data, size_t size) {
+    const char* src = static_cast<const char*>(data);
+    uint64_t tail = state_->tail.load(std::memory_order_relaxed);
+    uint64_t nfree = 0;
+    // wait for room for at least one byte, then write what fits
+    while ((nfree = capacity_ - (tail - state_->head.load(std::memory_order_acquire))) == 0) {
+      Wait();
+    }
+    size_t nwrite = static_cast<size_t>(std::min<uint64_t>(size, nfree));
+    CopyIn(tail, src, nwrite);
+    state_->tail.store(tail + nwrite, std::memory_order_release);
+    return nwrite;
+  }
+
+  size_t Recv(void* data, size_t size) {
+    char* dst = static_cast<char*>(data);
+    uint64_t head = state_->head.load(std::memory_order_relaxed);
+    uint64_t avail = 0;
+    while ((avail = state_->tail.load(std::memory_order_acquire) - head) == 0) {
+      Wait();
+    }
+    size_t nread = static_cast<size_t>(std::min<uint64_t>(size, avail));
+    CopyOut(head, dst, nread);
+    state_->head.store(head + nread, std::memory_order_release);
+    return nread;
+  }
+
+ private:
+  void CopyIn(uint64_t pos, const char* src, size_t size) {
+    uint64_t offset = pos % capacity_;
+    size_t ncopy = static_cast<size_t>(std::min<uint64_t>(size, capacity_ - offset));
+    std::memcpy(data_ + offset, src, ncopy);
+    if (ncopy < size) {
+      std::memcpy(data_, src + ncopy, size - ncopy);
+    }
+  }
+
+  void CopyOut(uint64_t pos, char* dst, size_t size) {
+    uint64_t offset = pos % capacity_;
+    size_t ncopy = static_cast<size_t>(std::min<uint64_t>(size, capacity_ - offset));
+    std::memcpy(dst, data_ + offset, ncopy);
+    if (ncopy < size) {
+      std::memcpy(dst + ncopy, data_, size - ncopy);
+    }
+  }
+
+  void Wait() {
+    if (++spin_count_ < kSpinBeforeYield) return;
+    spin_count_ = 0;
+    std::this_thread::yield();
+  }
+
+  static constexpr int kSpinBeforeYield = 1024;
+  ShmRingState* state_{nullptr};
+  char* data_{nullptr};
+  uint64_t capacity_{0};
+  int spin_count_{0};
+};
+
+/*! \brief RPCChannel backed by the shared-memory ring pair. */
+class ShmChannel final : public RPCChannel {
+ public:
+  /*!
+   * \brief Map the rendezvous file and attach to the rings.
+   * \param path Path of the file backing the shared mapping.
+   * \param ring_bytes Byte capacity of each ring, only used by the server.
+   * \param is_server Whether this side creates and initializes the mapping.
+   */
+  ShmChannel(const std::string& path, uint64_t ring_bytes, bool is_server) : path_(path) {
+    if (is_server) {
+      CreateMapping(ring_bytes);
+    } else {
+      OpenMapping();
+    }
+    // ring 0 carries client->server data, ring 1 the reverse.
+    char* ring_data = reinterpret_cast<char*>(header_) + sizeof(ShmHeader);
+    ShmRing* send_ring = is_server ? &rings_[1] : &rings_[0];
+    ShmRing* recv_ring = is_server ? &rings_[0] : &rings_[1];
+    send_ring->Init(&header_->rings[is_server ? 1 : 0],
+                    ring_data + (is_server ? header_->ring_bytes : 0), header_->ring_bytes);
+    recv_ring->Init(&header_->rings[is_server ? 0 : 1],
+                    ring_data + (is_server ? 0 : header_->ring_bytes), header_->ring_bytes);
+    send_ring_ = send_ring;
+    recv_ring_ = recv_ring;
+  }
+
+  ~ShmChannel() {
+    if (header_ != nullptr) {
+      munmap(header_, map_bytes_);
+    }
+  }
+
+  size_t Send(const void* data, size_t size) final { return send_ring_->Send(data, size); }
+
+  size_t Recv(void* data, size_t size) final { return recv_ring_->Recv(data, size); }
+
+ private:
+  void CreateMapping(uint64_t ring_bytes) {
+    map_bytes_ = sizeof(ShmHeader) + 2 * ring_bytes;
+    int fd = open(path_.c_str(), O_CREAT | O_RDWR, 0600);
+    ICHECK_GE(fd, 0) << "ShmChannel: cannot create " << path_;
+    ICHECK_EQ(ftruncate(fd, static_cast<off_t>(map_bytes_)), 0)
+        << "ShmChannel: cannot size " << path_;
+    header_ = static_cast<ShmHeader*>(
+        mmap(nullptr, map_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    ICHECK(header_ != MAP_FAILED) << "ShmChannel: mmap of " << path_ << " failed";
+    header_->magic = kShmMagic;
+    header_->ring_bytes = ring_bytes;
+    for (int i = 0; i < 2; ++i) {
+      header_->rings[i].head.store(0, std::memory_order_relaxed);
+      header_->rings[i].tail.store(0, std::memory_order_relaxed);
+    }
+    header_->ready.store(1, std::memory_order_release);
+  }
+
+  void OpenMapping() {
+    int fd = -1;
+    // the server may not have created the file yet
+    for (int retry = 0; retry < 5000 && fd < 0; ++retry) {
+      fd = open(path_.c_str(), O_RDWR);
+      if (fd < 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    ICHECK_GE(fd, 0) << "ShmChannel: cannot open " << path_;
+    struct stat st;
+    ICHECK_EQ(fstat(fd, &st), 0);
+    map_bytes_ = static_cast<size_t>(st.st_size);
+    ICHECK_GE(map_bytes_, sizeof(ShmHeader)) << "ShmChannel: " << path_ << " is not initialized";
+    header_ = static_cast<ShmHeader*>(
+        mmap(nullptr, map_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    close(fd);
+    ICHECK(header_ != MAP_FAILED) << "ShmChannel: mmap of " << path_ << " failed";
+    while (header_->ready.load(std::memory_order_acquire) == 0) {
+      std::this_thread::yield();
+    }
+    ICHECK_EQ(header_->magic, kShmMagic) << "ShmChannel: " << path_ << " is not a TVM RPC mapping";
+    ICHECK_EQ(map_bytes_, sizeof(ShmHeader) + 2 * header_->ring_bytes);
+  }
+
+  std::string path_;
+  ShmHeader* header_{nullptr};
+  size_t map_bytes_{0};
+  ShmRing rings_[2];
+  ShmRing* send_ring_{nullptr};
+  ShmRing* recv_ring_{nullptr};
+};
+
+Module CreateShmClient(std::string path) {
+  auto endpt = RPCEndpoint::Create(
+      std::unique_ptr<ShmChannel>(new ShmChannel(path, 0, /*is_server=*/false)), "shm", "shm");
+  endpt->InitRemoteSession(TVMArgs(nullptr, nullptr, 0));
+  return CreateRPCSessionModule(CreateClientSession(endpt));
+}
+
+void ShmServerLoop(std::string path, uint64_t ring_bytes) {
+  RPCEndpoint::Create(
+      std::unique_ptr<ShmChannel>(new ShmChannel(path, ring_bytes, /*is_server=*/true)),
+      "ShmServerLoop", "")
+      ->ServerLoop();
+  unlink(path.c_str());
+}
+
+TVM_REGISTER_GLOBAL("rpc.CreateShmClient").set_body([](TVMArgs args, TVMRetValue* rv) {
+  *rv = CreateShmClient(args[0].operator std::string());
+});
+
+TVM_REGISTER_GLOBAL("rpc.ShmServerLoop").set_body([](TVMArgs args, TVMRetValue* rv) {
+  uint64_t ring_bytes = kShmDefaultRingBytes;
+  if (args.size() > 1) {
+    ring_bytes = static_cast<uint64_t>(args[1].operator int64_t());
+  }
+  ShmServerLoop(args[0].operator std::string(), ring_bytes);
+});
+
+}  // namespace runtime
+}  // namespace tvm
+#endif
@@ -60,6 +60,30 @@ class SockChannel final : public RPCChannel {
     }
     return static_cast<size_t>(n);
   }
+  size_t SendV(const BufferSegment* segs, int nsegs) final {
+    support::TCPSocket::IOSegment iov[support::TCPSocket::kMaxIOSegments];
+    ICHECK_LE(nsegs, support::TCPSocket::kMaxIOSegments);
+    for (int i = 0; i < nsegs; ++i) {
+      iov[i] = support::TCPSocket::IOSegment{segs[i].data, segs[i].size};
+    }
+    ssize_t n = sock_.SendV(iov, nsegs);
+    if (n == -1) {
+      support::Socket::Error("SockChannel::SendV");
+    }
+    return static_cast<size_t>(n);
+  }
+  size_t RecvV(const BufferSegment* segs, int nsegs) final {
+    support::TCPSocket::IOSegment iov[support::TCPSocket::kMaxIOSegments];
+    ICHECK_LE(nsegs, support::TCPSocket::kMaxIOSegments);
+    for (int i = 0; i < nsegs; ++i) {
+      iov[i] = support::TCPSocket::IOSegment{segs[i].data, segs[i].size};
+    }
+    ssize_t n = sock_.RecvV(iov, nsegs);
+    if (n == -1) {
+      support::Socket::Error("SockChannel::RecvV");
+    }
+    return static_cast<size_t>(n);
+  }
 
  private:
   support::TCPSocket sock_;
@@ -0,0 +1,502 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_tracker.cc
+ * \brief Native implementation of the RPC tracker.
+ *
+ * The tracker matches RPC servers that PUT a device key with clients that
+ * REQUEST one, using the same wire protocol as python/tvm/rpc/tracker.py:
+ * a 4 byte magic handshake followed by [size(int32)] [json] messages.
+ *
+ * The Python tracker runs the event loop under the interpreter and becomes a
+ * bottleneck once several hundred tuning workers hammer it with REQUEST and
+ * PUT traffic.  This implementation runs a single-threaded poll based reactor
+ * (support::PollHelper) on a dedicated native thread.  Because every session
+ * table is owned by that one thread, no locking is needed on the request
+ * path; the only synchronization is the stop flag used to shut the loop down.
+ * In addition to the queue sizes the Python tracker reports, the SUMMARY
+ * reply includes per-key match-making counters so a tuning farm can see
+ * where device-pool scheduling spends its time.
+ */
+#define PICOJSON_USE_INT64
+#include <picojson.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../../support/socket.h"
+#include "rpc_endpoint.h"
+
+namespace tvm {
+namespace runtime {
+namespace rpc {
+
+using support::PollHelper;
+using support::SockAddr;
+using support::TCPSocket;
+
+/*! \brief Read a JSON number that may arrive as either int64 or double. */
+inline int64_t JSONToInt(const picojson::value& value) {
+  if (value.is<int64_t>()) return value.get<int64_t>();
+  return static_cast<int64_t>(value.get<double>());
+}
+
+/*!
+ * \brief Native RPC tracker server.
+ *
+ * All state is owned by the reactor thread; public methods only start and
+ * stop that thread.
+ */
+class TrackerServer {
+ public:
+  TrackerServer(const std::string& host, int port, int port_end, std::string stop_key)
+      : stop_key_(std::move(stop_key)) {
+    listen_sock_.Create();
+    my_port_ = listen_sock_.TryBindHost(host, port, port_end);
+    ICHECK_NE(my_port_, -1) << "Cannot bind tracker to " << host << " within [" << port << ", "
+                            << port_end << ")";
+    listen_sock_.Listen();
+    listen_sock_.SetNonBlock(true);
+    reactor_ = std::thread([this]() { this->EventLoop(); });
+  }
+
+  ~TrackerServer() { Stop(); }
+
+  /*! \return The port the tracker is listening on. */
+  int port() const { return my_port_; }
+
+  /*! \brief Request the event loop to terminate and wait for it. */
+  void Stop() {
+    stop_ = true;
+    if (reactor_.joinable()) {
+      reactor_.join();
+    }
+  }
+
+ private:
+  /*! \brief A device announced by an RPC server via PUT. */
+  struct Resource {
+    /*! \brief Id of the connection that announced the device. */
+    int64_t owner;
+    /*! \brief Address the client should connect to. */
+    std::string url;
+    /*! \brief Port the RPC server listens on. */
+    int port;
+    /*! \brief Match key identifying this announcement. */
+    std::string matchkey;
+  };
+
+  /*! \brief A pending REQUEST, scheduled by priority then arrival order. */
+  struct Request {
+    int64_t priority;
+    uint64_t order;
+    int64_t requester;
+
+    bool operator<(const Request& other) const {
+      // priority_queue pops the largest element; break priority ties FIFO.
+      if (priority != other.priority) return priority < other.priority;
+      return order > other.order;
+    }
+  };
+
+  /*! \brief Per-key scheduler state with match-making metrics. */
+  struct Scheduler {
+    std::deque<Resource> values;
+    std::priority_queue<Request> requests;
+    /*! \brief Ticket counter used to keep equal-priority requests FIFO. */
+    uint64_t request_order{0};
+    // match-making metrics, reported in SUMMARY
+    uint64_t num_puts{0};
+    uint64_t num_requests{0};
+    uint64_t num_matches{0};
+  };
+
+  /*! \brief State of one tracker client connection. */
+  struct Connection {
+    TCPSocket sock;
+    /*! \brief Peer address, used as the default url of PUT resources. */
+    std::string host;
+    /*! \brief Whether the magic handshake has completed. */
+    bool handshake_done{false};
+    std::string read_buffer;
+    std::string write_buffer;
+    /*! \brief Match keys announced but not yet handed to a client. */
+    std::unordered_set<std::string> pending_matchkeys;
+    /*! \brief (key, matchkey) of every live PUT, for cleanup on close. */
+    std::vector<std::pair<std::string, std::string>> put_values;
+    /*! \brief Client reported info, echoed in the SUMMARY reply. */
+    picojson::object info;
+  };
+
+  void EventLoop() {
+    while (!stop_) {
+      PollHelper poll;
+      poll.WatchRead(listen_sock_.sockfd);
+      for (const auto& kv : connections_) {
+        poll.WatchRead(kv.second->sock.sockfd);
+        if (!kv.second->write_buffer.empty()) {
+          poll.WatchWrite(kv.second->sock.sockfd);
+        }
+      }
+      // Wake up periodically so a Stop() from another thread is noticed.
+      poll.Poll(500);
+      if (stop_) break;
+      if (poll.CheckRead(listen_sock_.sockfd)) {
+        AcceptConnections();
+      }
+      // Handlers can close their own or other connections, so snapshot ids.
+      std::vector<int64_t> ids;
+      ids.reserve(connections_.size());
+      for (const auto& kv : connections_) ids.push_back(kv.first);
+      for (int64_t id : ids) {
+        auto it = connections_.find(id);
+        if (it == connections_.end()) continue;
+        Connection* conn = it->second.get();
+        if (poll.CheckRead(conn->sock.sockfd) && !HandleRead(id)) {
+          CloseConnection(id);
+          continue;
+        }
+        it = connections_.find(id);
+        if (it == connections_.end()) continue;
+        if (poll.CheckWrite(conn->sock.sockfd) && !FlushWrites(it->second.get())) {
+          CloseConnection(id);
+        }
+      }
+    }
+    std::vector<int64_t> ids;
+    for (const auto& kv : connections_) ids.push_back(kv.first);
+    for (int64_t id : ids) CloseConnection(id);
+    listen_sock_.Close();
+  }
+
+  void AcceptConnections() {
+    while (true) {
+      SockAddr addr;
+      TCPSocket client;
+      try {
+        client = listen_sock_.Accept(&addr);
+      } catch (const std::exception&) {
+        // the pending client reset the connection between poll and accept
+        break;
+      }
+      if (client.IsClosed()) break;
+      client.SetNonBlock(true);
+      client.SetKeepAlive(true);
+      auto conn = std::make_unique<Connection>();
+      conn->sock = client;
+      std::string addr_str = addr.AsString();
+      conn->host = addr_str.substr(0, addr_str.rfind(':'));
+      connections_.emplace(next_conn_id_++, std::move(conn));
+      // Accept(nullptr) raises on EAGAIN, so probe via poll for more clients.
+      pollfd pfd;
+      pfd.fd = listen_sock_.sockfd;
+      pfd.events = POLLIN;
+      if (poll(&pfd, 1, 0) <= 0) break;
+    }
+  }
+
+  /*! \brief Drain the socket and dispatch complete messages. \return false on EOF/error. */
+  bool HandleRead(int64_t conn_id) {
+    Connection* conn = connections_[conn_id].get();
+    char buf[4096];
+    while (true) {
+      ssize_t n = conn->sock.Recv(buf, sizeof(buf));
+      if (n == 0) return false;
+      if (n == -1) {
+        if (TCPSocket::LastErrorWouldBlock()) break;
+        return false;
+      }
+      conn->read_buffer.append(buf, static_cast<size_t>(n));
+      if (static_cast<size_t>(n) < sizeof(buf)) break;
+    }
+    return ProcessBuffer(conn_id);
+  }
+
+  /*! \brief Consume the handshake and any framed messages in the read buffer. */
+  bool ProcessBuffer(int64_t conn_id) {
+    Connection* conn = connections_[conn_id].get();
+    if (!conn->handshake_done) {
+      if (conn->read_buffer.size() < sizeof(int)) return true;
+      int magic;
+      std::memcpy(&magic, conn->read_buffer.data(), sizeof(int));
+      if (magic != kRPCTrackerMagic) {
+        LOG(WARNING) << "Invalid tracker magic from " << conn->host;
+        return false;
+      }
+      conn->read_buffer.erase(0, sizeof(int));
+      conn->handshake_done = true;
+      SendRaw(conn, reinterpret_cast<const char*>(&kRPCTrackerMagic), sizeof(int));
+    }
+    while (conn->read_buffer.size() >= sizeof(int32_t)) {
+      int32_t msg_size;
+      std::memcpy(&msg_size, conn->read_buffer.data(), sizeof(int32_t));
+      if (conn->read_buffer.size() < sizeof(int32_t) + static_cast<size_t>(msg_size)) break;
+      std::string msg = conn->read_buffer.substr(sizeof(int32_t), msg_size);
+      conn->read_buffer.erase(0, sizeof(int32_t) + msg_size);
+      if (!DispatchMessage(conn_id, msg)) return false;
+      // the handler may have closed this connection
+      auto it = connections_.find(conn_id);
+      if (it == connections_.end()) return true;
+      conn = it->second.get();
+    }
+    return true;
+  }
+
+  /*! \brief Handle one JSON message. \return false to drop the connection. */
+  bool DispatchMessage(int64_t conn_id, const std::string& msg) {
+    picojson::value args;
+    std::string err = picojson::parse(args, msg);
+    if (!err.empty() || !args.is<picojson::array>()) {
+      LOG(WARNING) << "Invalid tracker message: " << err;
+      return false;
+    }
+    const picojson::array& arr = args.get<picojson::array>();
+    Connection* conn = connections_[conn_id].get();
+    TrackerCode code = static_cast<TrackerCode>(JSONToInt(arr[0]));
+    switch (code) {
+      case TrackerCode::kPut: {
+        const std::string& key = arr[1].get<std::string>();
+        const picojson::array& pair = arr[2].get<picojson::array>();
+        Resource value;
+        value.owner = conn_id;
+        value.port = static_cast<int>(JSONToInt(pair[0]));
+        value.matchkey = pair[1].get<std::string>();
+        // an RPC server behind a proxy reports a custom address
+        if (arr.size() >= 4 && arr[3].is<std::string>()) {
+          value.url = arr[3].get<std::string>();
+        } else {
+          value.url = conn->host;
+        }
+        conn->pending_matchkeys.insert(value.matchkey);
+        conn->put_values.emplace_back(key, value.matchkey);
+        Scheduler* sched = &schedulers_[key];
+        sched->values.push_back(std::move(value));
+        ++sched->num_puts;
+        ReplyCode(conn, TrackerCode::kSuccess);
+        RunScheduler(sched);
+        break;
+      }
+      case TrackerCode::kRequest: {
+        const std::string& key = arr[1].get<std::string>();
+        Scheduler* sched = &schedulers_[key];
+        Request req;
+        req.priority = JSONToInt(arr[3]);
+        req.order = sched->request_order++;
+        req.requester = conn_id;
+        sched->requests.push(req);
+        ++sched->num_requests;
+        RunScheduler(sched);
+        break;
+      }
+      case TrackerCode::kPing:
+        ReplyCode(conn, TrackerCode::kSuccess);
+        break;
+      case TrackerCode::kGetPendingMatchKeys: {
+        picojson::array keys;
+        for (const std::string& matchkey : conn->pending_matchkeys) {
+          keys.push_back(picojson::value(matchkey));
+        }
+        Reply(conn, picojson::value(keys));
+        break;
+      }
+      case TrackerCode::kUpdateInfo: {
+        for (const auto& kv : arr[1].get<picojson::object>()) {
+          conn->info[kv.first] = kv.second;
+        }
+        ReplyCode(conn, TrackerCode::kSuccess);
+        break;
+      }
+      case TrackerCode::kSummary: {
+        picojson::array ret;
+        ret.push_back(picojson::value(static_cast<int64_t>(TrackerCode::kSuccess)));
+        ret.push_back(picojson::value(MakeSummary()));
+        Reply(conn, picojson::value(ret));
+        break;
+      }
+      case TrackerCode::kStop: {
+        if (arr[1].get<std::string>() == stop_key_) {
+          ReplyCode(conn, TrackerCode::kSuccess);
+          FlushWrites(conn);
+          stop_ = true;
+        } else {
+          ReplyCode(conn, TrackerCode::kFail);
+        }
+        break;
+      }
+      default:
+        LOG(WARNING) << "Unknown tracker code " << static_cast<int>(code);
+        return false;
+    }
+    return true;
+  }
+
+  /*! \brief Match queued requests against free resources for one key. */
+  void RunScheduler(Scheduler* sched) {
+    while (!sched->requests.empty() && !sched->values.empty()) {
+      Resource value = std::move(sched->values.front());
+      sched->values.pop_front();
+      Request req = sched->requests.top();
+      sched->requests.pop();
+      auto it = connections_.find(req.requester);
+      if (it == connections_.end()) {
+        // requester went away before a device was free; put the device back
+        sched->values.push_back(std::move(value));
+        continue;
+      }
+      picojson::array addr;
+      addr.push_back(picojson::value(value.url));
+      addr.push_back(picojson::value(static_cast<int64_t>(value.port)));
+      addr.push_back(picojson::value(value.matchkey));
+      picojson::array ret;
+      ret.push_back(picojson::value(static_cast<int64_t>(TrackerCode::kSuccess)));
+      ret.push_back(picojson::value(addr));
+      Reply(it->second.get(), picojson::value(ret));
+      auto owner = connections_.find(value.owner);
+      if (owner != connections_.end()) {
+        owner->second->pending_matchkeys.erase(value.matchkey);
+      }
+      ++sched->num_matches;
+    }
+  }
+
+  picojson::object MakeSummary() const {
+    picojson::object queue_info;
+    for (const auto& kv : schedulers_) {
+      picojson::object qstat;
+      qstat["free"] = picojson::value(static_cast<int64_t>(kv.second.values.size()));
+      qstat["pending"] = picojson::value(static_cast<int64_t>(kv.second.requests.size()));
+      qstat["matched"] = picojson::value(static_cast<int64_t>(kv.second.num_matches));
+      qstat["requested"] = picojson::value(static_cast<int64_t>(kv.second.num_requests));
+      queue_info[kv.first] = picojson::value(qstat);
+    }
+    picojson::array server_info;
+    for (const auto& kv : connections_) {
+      picojson::object info = kv.second->info;
+      if (info.count("addr") == 0) {
+        info["addr"] = picojson::value(kv.second->host);
+      }
+      server_info.push_back(picojson::value(info));
+    }
+    picojson::object summary;
+    summary["queue_info"] = picojson::value(queue_info);
+    summary["server_info"] = picojson::value(server_info);
+    return summary;
+  }
+
+  void Reply(Connection* conn, const picojson::value& value) {
+    std::string data = value.serialize();
+    int32_t size = static_cast<int32_t>(data.size());
+    SendRaw(conn, reinterpret_cast<const char*>(&size), sizeof(size));
+    SendRaw(conn, data.data(), data.size());
+  }
+
+  void ReplyCode(Connection* conn, TrackerCode code) {
+    Reply(conn, picojson::value(static_cast<int64_t>(code)));
+  }
+
+  void SendRaw(Connection* conn, const char* data, size_t size) {
+    conn->write_buffer.append(data, size);
+    FlushWrites(conn);
+  }
+
+  /*! \brief Send as much buffered data as the socket accepts. \return false on error. */
+  bool FlushWrites(Connection* conn) {
+    while (!conn->write_buffer.empty()) {
+      ssize_t n = conn->sock.Send(conn->write_buffer.data(), conn->write_buffer.size());
+      if (n == -1) {
+        return TCPSocket::LastErrorWouldBlock();
+      }
+      conn->write_buffer.erase(0, static_cast<size_t>(n));
+    }
+    return true;
+  }
+
+  void CloseConnection(int64_t conn_id) {
+    auto it = connections_.find(conn_id);
+    if (it == connections_.end()) return;
+    Connection* conn = it->second.get();
+    // devices announced by this connection are no longer reachable
+    for (const auto& kv : conn->put_values) {
+      auto sit = schedulers_.find(kv.first);
+      if (sit == schedulers_.end()) continue;
+      auto& values = sit->second.values;
+      values.erase(std::remove_if(values.begin(), values.end(),
+                                  [&](const Resource& v) {
+                                    return v.owner == conn_id && v.matchkey == kv.second;
+                                  }),
+                   values.end());
+    }
+    conn->sock.Close();
+    connections_.erase(it);
+  }
+
+  /*! \brief Key required by the STOP command. */
+  std::string stop_key_;
+  TCPSocket listen_sock_;
+  int my_port_{-1};
+  std::atomic<bool> stop_{false};
+  std::thread reactor_;
+  // reactor-thread-only state below
+  int64_t next_conn_id_{0};
+  std::map<int64_t, std::unique_ptr<Connection>> connections_;
+  std::unordered_map<std::string, Scheduler> schedulers_;
+};
+
+namespace {
+std::mutex tracker_mutex;
+std::unique_ptr<TrackerServer> global_tracker;
+}  // namespace
+
+TVM_REGISTER_GLOBAL("rpc.TrackerStart")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string host = args[0];
+      int port = args[1];
+      int port_end = args[2];
+      std::string stop_key = args[3];
+      std::lock_guard<std::mutex> lock(tracker_mutex);
+      ICHECK(global_tracker == nullptr) << "Tracker is already running";
+      global_tracker = std::make_unique<TrackerServer>(host, port, port_end, stop_key);
+      *rv = global_tracker->port();
+    });
+
+TVM_REGISTER_GLOBAL("rpc.TrackerStop").set_body([](TVMArgs args, TVMRetValue* rv) {
+  std::lock_guard<std::mutex> lock(tracker_mutex);
+  if (global_tracker != nullptr) {
+    global_tracker->Stop();
+    global_tracker.reset();
+  }
+});
+
+}  // namespace rpc
+}  // namespace runtime
+}  // namespace tvm
@@ -103,6 +103,24 @@ StackVM::State* StackVM::ThreadLocalState() { return StackVMStateStore::Get(); }
     return pc + 2;                                                               \
   }
 
+#define STACK_VM_PRINT_FUSED_IMM(CODE)                                     \
+  case CODE: {                                                             \
+    os << "[" << pc << "]\t" << #CODE << " " << code[pc + 1].v_int << "\n" \
+       << "[" << pc + 1 << "]" << std::endl                                \
+       << "[" << pc + 2 << "]" << std::endl;                               \
+    return pc + 3;                                                         \
+  }
+
+#define STACK_VM_PRINT_FUSED_MULADD(CODE)                                  \
+  case CODE: {                                                             \
+    os << "[" << pc << "]\t" << #CODE << " " << code[pc + 1].v_int << " "  \
+       << code[pc + 3].v_int << "\n";                                      \
+    for (int i = 1; i < 6; ++i) {                                          \
+      os << "[" << pc + i << "]" << std::endl;                             \
+    }                                                                      \
+    return pc + 6;                                                         \
+  }
+
 int64_t StackVM::PrintCode(std::ostream& os, int64_t pc) const {
   switch (code[pc].op_code) {
     // int
@@ -159,6 +177,11 @@ int64_t StackVM::PrintCode(std::ostream& os, int64_t pc) const {
     STACK_VM_PRINT_CODE0(TVM_DEVICE_ALLOCA);
     STACK_VM_PRINT_CODE0(TVM_DEVICE_FREE);
     STACK_VM_PRINT_CODE0(TVM_THROW_LAST_ERROR);
+    // superinstructions
+    STACK_VM_PRINT_FUSED_IMM(ADD_I64_IMM);
+    STACK_VM_PRINT_FUSED_IMM(MUL_I64_IMM);
+    STACK_VM_PRINT_FUSED_MULADD(LOAD_HEAP_MULADD_I64);
+    STACK_VM_PRINT_FUSED_MULADD(LOAD_HEAP_MULADD_F64);
     // packed function.
     case CALL_PACKED_LOWERED: {
       int call_fid = code[pc + 1].v_int;
@@ -202,9 +225,85 @@ void StackVM::Run(const runtime::TVMArgs& args, runtime::ModuleNode* mod_ctx) co
   this->Run(s);
 }
 
+// Number of code slots occupied by the instruction starting at pc.
+static int64_t InstrLen(const std::vector<StackVM::Code>& code, int64_t pc) {
+  switch (code[pc].op_code) {
+    case StackVM::ARRAY_LOAD_UINT32:
+    case StackVM::ARRAY_LOAD_INT32:
+    case StackVM::ARRAY_LOAD_INT64:
+    case StackVM::ARRAY_LOAD_FP64:
+    case StackVM::ARRAY_LOAD_HANDLE:
+    case StackVM::ARRAY_LOAD_TVMVALUE:
+    case StackVM::ARRAY_STORE_UINT32:
+    case StackVM::ARRAY_STORE_INT32:
+    case StackVM::ARRAY_STORE_INT64:
+    case StackVM::ARRAY_STORE_FP64:
+    case StackVM::ARRAY_STORE_HANDLE:
+    case StackVM::ARRAY_STORE_TVMVALUE:
+    case StackVM::PUSH_I64:
+    case StackVM::PUSH_VALUE:
+    case StackVM::LOAD_HEAP:
+    case StackVM::STORE_HEAP:
+    case StackVM::ASSERT:
+    case StackVM::RJUMP_IF_TRUE:
+    case StackVM::RJUMP_IF_FALSE:
+    case StackVM::RJUMP:
+    case StackVM::ASSERT_SP:
+    case StackVM::TVM_STACK_ALLOCA_BY_8BYTE:
+      return 2;
+    case StackVM::TVM_STRUCT_GET:
+    case StackVM::TVM_STRUCT_SET:
+    case StackVM::ADD_I64_IMM:
+    case StackVM::MUL_I64_IMM:
+      return 3;
+    case StackVM::CALL_PACKED_LOWERED:
+      return 4;
+    case StackVM::LOAD_HEAP_MULADD_I64:
+    case StackVM::LOAD_HEAP_MULADD_F64:
+      return 6;
+    default:
+      return 1;
+  }
+}
+
+void StackVM::FuseSuperInstructions() {
+  // The scan walks instruction boundaries, so operand slots are never
+  // misread as opcodes. Each rewrite only changes the opcode in the first
+  // slot of a matched sequence and lets the superinstruction advance pc by
+  // the original sequence length; the inner slots keep their original
+  // instructions, so a jump landing inside a fused sequence still executes
+  // the unfused tail with identical semantics.
+  const int64_t code_size = static_cast<int64_t>(code.size());
+  int64_t pc = 0;
+  while (pc < code_size) {
+    const int64_t len = InstrLen(code, pc);
+    if (code[pc].op_code == LOAD_HEAP && pc + 6 <= code_size && code[pc + 2].op_code == LOAD_HEAP &&
+        code[pc + 4].op_code == MUL_I64 && code[pc + 5].op_code == ADD_I64) {
+      code[pc].op_code = LOAD_HEAP_MULADD_I64;
+      pc += 6;
+    } else if (code[pc].op_code == LOAD_HEAP && pc + 6 <= code_size &&
+               code[pc + 2].op_code == LOAD_HEAP && code[pc + 4].op_code == MUL_F64 &&
+               code[pc + 5].op_code == ADD_F64) {
+      code[pc].op_code = LOAD_HEAP_MULADD_F64;
+      pc += 6;
+    } else if (code[pc].op_code == PUSH_I64 && pc + 3 <= code_size &&
+               code[pc + 2].op_code == ADD_I64) {
+      code[pc].op_code = ADD_I64_IMM;
+      pc += 3;
+    } else if (code[pc].op_code == PUSH_I64 && pc + 3 <= code_size &&
+               code[pc + 2].op_code == MUL_I64) {
+      code[pc].op_code = MUL_I64_IMM;
+      pc += 3;
+    } else {
+      pc += len;
+    }
+  }
+}
+
 void StackVM::InitCache() {
   extern_func_cache_.clear();
   extern_func_cache_.resize(extern_func_name.size(), PackedFunc(nullptr));
+  this->FuseSuperInstructions();
 }
 
 void StackVM::Save(dmlc::Stream* strm) const {
@@ -238,6 +337,29 @@ bool StackVM::Load(dmlc::Stream* strm) {
   return true;
 }
 
+#if defined(__GNUC__) || defined(__clang__)
+#define STACK_VM_USE_COMPUTED_GOTO 1
+#else
+#define STACK_VM_USE_COMPUTED_GOTO 0
+#endif
+
+#if STACK_VM_USE_COMPUTED_GOTO
+// Direct-threaded dispatch: every handler jumps to the next handler through
+// a label table, so the branch predictor sees one indirect branch per
+// handler instead of a single shared branch in a dispatch loop.
+#define STACK_VM_TARGET(OP) Target_##OP
+#define STACK_VM_DISPATCH()                              \
+  {                                                      \
+    ICHECK_GE(sp, alloca_sp) << "touch allocated space"; \
+    ICHECK_LT(sp, stack_cap) << "Stack overflow";        \
+    if (pc >= code_size) goto vm_exit;                   \
+    goto* kDispatchTable[code[pc].op_code];              \
+  }
+#else
+#define STACK_VM_TARGET(OP) case OP
+#define STACK_VM_DISPATCH() continue
+#endif
+
 void StackVM::Run(State* s) const {
   int64_t sp = s->sp;
   int64_t pc = s->pc;
@@ -252,177 +374,238 @@ void StackVM::Run(State* s) const {
     heap.resize(heap_size);
   }
   const int64_t code_size = static_cast<int64_t>(code.size());
+#if STACK_VM_USE_COMPUTED_GOTO
+  // Must stay in sync with the OpCode enum order.
+  static const void* const kDispatchTable[] = {
+      &&Target_ADD_I64,
+      &&Target_SUB_I64,
+      &&Target_MUL_I64,
+      &&Target_DIV_I64,
+      &&Target_MOD_I64,
+      &&Target_EQ_I64,
+      &&Target_LT_I64,
+      &&Target_LE_I64,
+      &&Target_ADD_F64,
+      &&Target_SUB_F64,
+      &&Target_MUL_F64,
+      &&Target_DIV_F64,
+      &&Target_EQ_F64,
+      &&Target_LT_F64,
+      &&Target_LE_F64,
+      &&Target_EQ_HANDLE,
+      &&Target_ARRAY_LOAD_UINT32,
+      &&Target_ARRAY_LOAD_INT32,
+      &&Target_ARRAY_LOAD_INT64,
+      &&Target_ARRAY_LOAD_FP64,
+      &&Target_ARRAY_LOAD_HANDLE,
+      &&Target_ARRAY_LOAD_TVMVALUE,
+      &&Target_ARRAY_STORE_UINT32,
+      &&Target_ARRAY_STORE_INT32,
+      &&Target_ARRAY_STORE_INT64,
+      &&Target_ARRAY_STORE_FP64,
+      &&Target_ARRAY_STORE_HANDLE,
+      &&Target_ARRAY_STORE_TVMVALUE,
+      &&Target_NOT,
+      &&Target_ADDR_ADD,
+      &&Target_PUSH_I64,
+      &&Target_PUSH_VALUE,
+      &&Target_LOAD_HEAP,
+      &&Target_STORE_HEAP,
+      &&Target_POP,
+      &&Target_SELECT,
+      &&Target_ASSERT,
+      &&Target_RJUMP_IF_TRUE,
+      &&Target_RJUMP_IF_FALSE,
+      &&Target_RJUMP,
+      &&Target_ASSERT_SP,
+      &&Target_CALL_PACKED_LOWERED,
+      &&Target_TVM_STACK_ALLOCA_BY_8BYTE,
+      &&Target_TVM_DEVICE_ALLOCA,
+      &&Target_TVM_DEVICE_FREE,
+      &&Target_TVM_THROW_LAST_ERROR,
+      &&Target_TVM_STRUCT_GET,
+      &&Target_TVM_STRUCT_SET,
+      &&Target_ADD_I64_IMM,
+      &&Target_MUL_I64_IMM,
+      &&Target_LOAD_HEAP_MULADD_I64,
+      &&Target_LOAD_HEAP_MULADD_F64,
+  };
+  STACK_VM_DISPATCH();
+#else
   while (pc < code_size) {
+    ICHECK_GE(sp, alloca_sp) << "touch allocated space";
+    ICHECK_LT(sp, stack_cap) << "Stack overflow";
     switch (code[pc].op_code) {
-      case ADD_I64:
+#endif
+      STACK_VM_TARGET(ADD_I64):
         STACK_VM_BINOP(+, v_int64);
-        break;
-      case SUB_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(SUB_I64):
         STACK_VM_BINOP(-, v_int64);
-        break;
-      case MUL_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(MUL_I64):
         STACK_VM_BINOP(*, v_int64);
-        break;
-      case DIV_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(DIV_I64):
         STACK_VM_BINOP(/, v_int64);
-        break;
-      case MOD_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(MOD_I64):
         STACK_VM_BINOP(%, v_int64);
-        break;
-      case EQ_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(EQ_I64):
         STACK_VM_CMPOP(==, v_int64);
-        break;
-      case LT_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(LT_I64):
         STACK_VM_CMPOP(<, v_int64);
-        break;
-      case LE_I64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(LE_I64):
         STACK_VM_CMPOP(<=, v_int64);
-        break;
-      case ADD_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ADD_F64):
         STACK_VM_BINOP(+, v_float64);
-        break;
-      case SUB_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(SUB_F64):
         STACK_VM_BINOP(-, v_float64);
-        break;
-      case MUL_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(MUL_F64):
         STACK_VM_BINOP(*, v_float64);
-        break;
-      case DIV_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(DIV_F64):
         STACK_VM_BINOP(/, v_float64);
-        break;
-      case EQ_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(EQ_F64):
         STACK_VM_CMPOP(==, v_float64);
-        break;
-      case LT_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(LT_F64):
         STACK_VM_CMPOP(<, v_float64);
-        break;
-      case LE_F64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(LE_F64):
         STACK_VM_CMPOP(<=, v_float64);
-        break;
-      case EQ_HANDLE:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(EQ_HANDLE):
         STACK_VM_CMPOP(==, v_handle);
-        break;
+        STACK_VM_DISPATCH();
       // addressing
-      case ARRAY_LOAD_UINT32:
+      STACK_VM_TARGET(ARRAY_LOAD_UINT32):
         STACK_VM_LOAD(.v_int64, int64_t, uint32_t);
-        break;
-      case ARRAY_LOAD_INT32:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_LOAD_INT32):
         STACK_VM_LOAD(.v_int64, int64_t, int32_t);
-        break;
-      case ARRAY_LOAD_INT64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_LOAD_INT64):
         STACK_VM_LOAD(.v_int64, int64_t, int64_t);
-        break;
-      case ARRAY_LOAD_FP64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_LOAD_FP64):
         STACK_VM_LOAD(.v_float64, double, double);
-        break;
-      case ARRAY_LOAD_HANDLE:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_LOAD_HANDLE):
         STACK_VM_LOAD(.v_handle, void*, void*);
-        break;
-      case ARRAY_LOAD_TVMVALUE:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_LOAD_TVMVALUE):
         STACK_VM_LOAD(, TVMValue, TVMValue);
-        break;
+        STACK_VM_DISPATCH();
       // store
-      case ARRAY_STORE_UINT32:
+      STACK_VM_TARGET(ARRAY_STORE_UINT32):
         STACK_VM_STORE(.v_int64, uint32_t);
-        break;
-      case ARRAY_STORE_INT32:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_STORE_INT32):
         STACK_VM_STORE(.v_int64, int32_t);
-        break;
-      case ARRAY_STORE_INT64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_STORE_INT64):
         STACK_VM_STORE(.v_int64, int64_t);
-        break;
-      case ARRAY_STORE_FP64:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_STORE_FP64):
         STACK_VM_STORE(.v_float64, double);
-        break;
-      case ARRAY_STORE_HANDLE:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_STORE_HANDLE):
         STACK_VM_STORE(.v_handle, void*);
-        break;
-      case ARRAY_STORE_TVMVALUE:
+        STACK_VM_DISPATCH();
+      STACK_VM_TARGET(ARRAY_STORE_TVMVALUE):
         STACK_VM_STORE(, TVMValue);
-        break;
+        STACK_VM_DISPATCH();
       // add
-      case ADDR_ADD: {
+      STACK_VM_TARGET(ADDR_ADD): {
         stack[sp - 1].v_handle = (char*)(stack[sp - 1].v_handle) + stack[sp].v_int64;  // NOLINT(*)
         sp = sp - 1;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case NOT: {
+      STACK_VM_TARGET(NOT): {
         stack[sp].v_int64 = !stack[sp].v_int64;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case PUSH_I64: {
+      STACK_VM_TARGET(PUSH_I64): {
         stack[sp + 1].v_int64 = code[pc + 1].v_int;
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case PUSH_VALUE: {
+      STACK_VM_TARGET(PUSH_VALUE): {
         int relpos = code[pc + 1].v_int;
         ICHECK_LE(relpos, 0);
         stack[sp + 1] = stack[sp + relpos];
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case POP: {
+      STACK_VM_TARGET(POP): {
         sp -= 1;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case SELECT: {
+      STACK_VM_TARGET(SELECT): {
         stack[sp - 2] = (stack[sp].v_int64 ? stack[sp - 2] : stack[sp - 1]);
         sp -= 2;
         pc += 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case LOAD_HEAP: {
+      STACK_VM_TARGET(LOAD_HEAP): {
         stack[sp + 1] = heap[code[pc + 1].v_int];
         sp += 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case STORE_HEAP: {
+      STACK_VM_TARGET(STORE_HEAP): {
         heap[code[pc + 1].v_int] = stack[sp];
         sp -= 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case ASSERT: {
+      STACK_VM_TARGET(ASSERT): {
         ICHECK(stack[sp].v_int64) << str_data[code[pc + 1].v_int];
         sp -= 1;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case RJUMP_IF_TRUE: {
+      STACK_VM_TARGET(RJUMP_IF_TRUE): {
         if (stack[sp].v_int64) {
           pc += code[pc + 1].v_int;
         } else {
           pc += 2;
         }
-        break;
+        STACK_VM_DISPATCH();
       }
-      case RJUMP_IF_FALSE: {
+      STACK_VM_TARGET(RJUMP_IF_FALSE): {
         if (!stack[sp].v_int64) {
           pc += code[pc + 1].v_int;
         } else {
           pc += 2;
         }
-        break;
+        STACK_VM_DISPATCH();
       }
-      case RJUMP: {
+      STACK_VM_TARGET(RJUMP): {
         pc += code[pc + 1].v_int;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case ASSERT_SP: {
+      STACK_VM_TARGET(ASSERT_SP): {
         int64_t expected = code[pc + 1].v_int;
         ICHECK_EQ(sp, expected) << "sp assertion failed, expected=" << expected << " now=" << sp
                                 << ", pc=" << pc;
         pc += 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case CALL_PACKED_LOWERED: {
+      STACK_VM_TARGET(CALL_PACKED_LOWERED): {
         // call packed function.
         TVMValue* value_stack = static_cast<TVMValue*>(stack[sp - 1].v_handle);
         int* type_stack = static_cast<int*>(stack[sp].v_handle);
@@ -437,10 +620,10 @@ void StackVM::Run(State* s) const {
         sp = sp - 1;
         stack[sp] = rv.value();
         pc += 4;
-        break;
+        STACK_VM_DISPATCH();
       }
       // intrinsics
-      case TVM_STRUCT_GET: {
+      STACK_VM_TARGET(TVM_STRUCT_GET): {
         int index = code[pc + 1].v_int;
         int kind = code[pc + 2].v_int;
         DLTensor* arr = static_cast<DLTensor*>(stack[sp].v_handle);
@@ -497,9 +680,9 @@ void StackVM::Run(State* s) const {
             LOG(FATAL) << "unhandled get " << kind;
         }
         pc = pc + 3;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case TVM_STRUCT_SET: {
+      STACK_VM_TARGET(TVM_STRUCT_SET): {
         int index = code[pc + 1].v_int;
         int kind = code[pc + 2].v_int;
         DLTensor* arr = static_cast<DLTensor*>(stack[sp - 1].v_handle);
@@ -553,10 +736,10 @@ void StackVM::Run(State* s) const {
         }
         sp -= 2;
         pc += 3;
-        break;
+        STACK_VM_DISPATCH();
       }
       // alloca
-      case TVM_STACK_ALLOCA_BY_8BYTE: {
+      STACK_VM_TARGET(TVM_STACK_ALLOCA_BY_8BYTE): {
         static_assert(sizeof(TVMValue) == 8, "invariance");
         int num = code[pc + 1].v_int;
         void* addr = &stack[sp] + 1;
@@ -564,9 +747,9 @@ void StackVM::Run(State* s) const {
         alloca_sp = sp - 1;
         stack[sp].v_handle = addr;
         pc = pc + 2;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case TVM_DEVICE_ALLOCA: {
+      STACK_VM_TARGET(TVM_DEVICE_ALLOCA): {
         int device_type = static_cast<int>(stack[sp - 4].v_int64);
         int device_id = static_cast<int>(stack[sp - 3].v_int64);
         size_t nbytes = static_cast<size_t>(stack[sp - 2].v_int64);
@@ -577,9 +760,9 @@ void StackVM::Run(State* s) const {
         stack[sp - 4].v_handle = ptr;
         sp = sp - 4;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case TVM_DEVICE_FREE: {
+      STACK_VM_TARGET(TVM_DEVICE_FREE): {
         int device_type = static_cast<int>(stack[sp - 2].v_int64);
         int device_id = static_cast<int>(stack[sp - 1].v_int64);
         void* ptr = stack[sp].v_handle;
@@ -587,18 +770,47 @@ void StackVM::Run(State* s) const {
         stack[sp - 2].v_int64 = ret;
         sp = sp - 2;
         pc = pc + 1;
-        break;
+        STACK_VM_DISPATCH();
       }
-      case TVM_THROW_LAST_ERROR: {
+      STACK_VM_TARGET(TVM_THROW_LAST_ERROR): {
         LOG(FATAL) << TVMGetLastError();
-        break;
+        STACK_VM_DISPATCH();
+      }
+      // superinstructions, see FuseSuperInstructions
+      STACK_VM_TARGET(ADD_I64_IMM): {
+        stack[sp].v_int64 += code[pc + 1].v_int;
+        pc += 3;
+        STACK_VM_DISPATCH();
+      }
+      STACK_VM_TARGET(MUL_I64_IMM): {
+        stack[sp].v_int64 *= code[pc + 1].v_int;
+        pc += 3;
+        STACK_VM_DISPATCH();
+      }
+      STACK_VM_TARGET(LOAD_HEAP_MULADD_I64): {
+        stack[sp].v_int64 += heap[code[pc + 1].v_int].v_int64 * heap[code[pc + 3].v_int].v_int64;
+        pc += 6;
+        STACK_VM_DISPATCH();
       }
+      STACK_VM_TARGET(LOAD_HEAP_MULADD_F64): {
+        stack[sp].v_float64 +=
+            heap[code[pc + 1].v_int].v_float64 * heap[code[pc + 3].v_int].v_float64;
+        pc += 6;
+        STACK_VM_DISPATCH();
+      }
+#if STACK_VM_USE_COMPUTED_GOTO
+vm_exit:
+  return;
+#else
     }
-    ICHECK_GE(sp, alloca_sp) << "touch allocated space";
-    ICHECK_LT(sp, stack_cap) << "Stack overflow";
   }
+#endif
 }
 
+#undef STACK_VM_USE_COMPUTED_GOTO
+#undef STACK_VM_TARGET
+#undef STACK_VM_DISPATCH
+
 const PackedFunc& StackVM::GetExtern(State* s, int fid) const {
   ICHECK_LT(static_cast<size_t>(fid), extern_func_cache_.size());
   // allow race write in this, since write is idempotent
@@ -283,7 +283,45 @@ class StackVM {
      *  sp = sp - 1
      * \endcode
      */
-    TVM_STRUCT_SET
+    TVM_STRUCT_SET,
+    // Superinstructions, produced by FuseSuperInstructions as in-place
+    // rewrites of common sequences. Only the first code slot of a fused
+    // sequence is rewritten; the remaining slots keep the original
+    // instructions so that jumps into the middle of a sequence stay valid.
+    /*!
+     * \brief Fused PUSH_I64; ADD_I64.
+     * \code
+     *  stack[sp].v_int64 += code[pc + 1].v_int;
+     *  pc = pc + 3;
+     * \endcode
+     */
+    ADD_I64_IMM,
+    /*!
+     * \brief Fused PUSH_I64; MUL_I64.
+     * \code
+     *  stack[sp].v_int64 *= code[pc + 1].v_int;
+     *  pc = pc + 3;
+     * \endcode
+     */
+    MUL_I64_IMM,
+    /*!
+     * \brief Fused LOAD_HEAP; LOAD_HEAP; MUL_I64; ADD_I64.
+     * \code
+     *  stack[sp].v_int64 += heap[code[pc + 1].v_int].v_int64 *
+     *                       heap[code[pc + 3].v_int].v_int64;
+     *  pc = pc + 6;
+     * \endcode
+     */
+    LOAD_HEAP_MULADD_I64,
+    /*!
+     * \brief Fused LOAD_HEAP; LOAD_HEAP; MUL_F64; ADD_F64.
+     * \code
+     *  stack[sp].v_float64 += heap[code[pc + 1].v_int].v_float64 *
+     *                         heap[code[pc + 3].v_int].v_float64;
+     *  pc = pc + 6;
+     * \endcode
+     */
+    LOAD_HEAP_MULADD_F64
   };
   /*! \brief The kind of structure field info */
   enum StructFieldKind : int {
@@ -324,6 +362,13 @@ class StackVM {
   };
   /*! \brief Initialize local cache*/
   void InitCache();
+  /*!
+   * \brief Rewrite common instruction sequences into superinstructions.
+   *
+   *  The rewrite happens in place and keeps the code length unchanged,
+   *  so relative jump offsets need no relocation. Idempotent.
+   */
+  void FuseSuperInstructions();
   /*!
    * \brief Save stackvm program to an output stream
    * \param strm The output stream
@@ -35,6 +35,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -50,12 +51,23 @@ namespace {
 
 constexpr uint32_t kDefaultSpinCount = 300000;
 
+// Spin count that makes workers spin forever instead of parking on the
+// condition variable. With spin-only workers Push/Pop never touch the mutex,
+// which removes the ~10us futex wakeup from the critical path of small ops.
+constexpr uint32_t kAlwaysSpinCount = std::numeric_limits<uint32_t>::max();
+
+// Task id pushed to worker queues in work-stealing mode; the real task id is
+// claimed from the launcher's shared cursor when the worker wakes up.
+constexpr int32_t kWorkStealingTaskId = -1;
+
 uint32_t GetSpinCount() {
   const char* val = getenv("TVM_THREAD_POOL_SPIN_COUNT");
   if (!val) {
     return kDefaultSpinCount;
   }
-  return atoi(val);
+  int count = atoi(val);
+  // a negative value requests spin-only workers
+  return count < 0 ? kAlwaysSpinCount : static_cast<uint32_t>(count);
 }
 
 }  // namespace
@@ -70,10 +82,16 @@ class ParallelLauncher {
  public:
   // Reset the the task request.
   void Init(FTVMParallelLambda flambda, void* cdata, int num_task, bool need_sync) {
+    // Publish every field a claimed task may read before opening the claim
+    // cursor below: in work-stealing mode a stale wakeup token left in a
+    // worker queue by the previous launch can reach FetchTask the moment the
+    // cursor opens.
     num_pending_.store(num_task);
+    chunk_cursor_.store(0);
     this->cdata = cdata;
     this->flambda = flambda;
     this->env.num_task = num_task;
+    this->env.chunk_handle = &chunk_cursor_;
     has_error_.store(false);
     // reshape
     if (static_cast<size_t>(num_task) > par_errors_.size()) {
@@ -91,6 +109,10 @@ class ParallelLauncher {
     } else {
       this->env.sync_handle = nullptr;
     }
+    // Open the claim cursor last; the release store pairs with the acquire
+    // in FetchTask so a successful claim implies all the stores above are
+    // visible to the claiming thread.
+    unclaimed_tasks_.store(num_task, std::memory_order_release);
   }
   ~ParallelLauncher() { delete[] sync_counter_; }
   // Wait n jobs to finish
@@ -117,6 +139,17 @@ class ParallelLauncher {
   }
   // Signal that one job has finished.
   void SignalJobFinish() { num_pending_.fetch_sub(1); }
+  // Claim the next unassigned task id, or kWorkStealingTaskId if all tasks are taken.
+  // Used by the work-stealing mode where task ids are not bound to workers.
+  // The counter counts down so a stale wakeup token from an already-finished
+  // launch only drains an exhausted (non-positive) cursor and returns without
+  // reading any other launcher field; a positive claim must have observed the
+  // value released by Init and therefore sees fully-published launcher state.
+  int32_t FetchTask() {
+    int32_t left = unclaimed_tasks_.fetch_sub(1, std::memory_order_acquire);
+    if (left <= 0) return kWorkStealingTaskId;
+    return env.num_task - left;
+  }
   // Get thread local version of the store.
   static ParallelLauncher* ThreadLocal() { return dmlc::ThreadLocalStore<ParallelLauncher>::Get(); }
   // The parallel lambda
@@ -132,6 +165,13 @@ class ParallelLauncher {
  private:
   // The pending jobs.
   std::atomic<int32_t> num_pending_;
+  // Number of task ids not yet claimed in work-stealing mode. Counts down
+  // from num_task; Init republishes it last with release ordering so that a
+  // claim through FetchTask acquires the rest of the launcher state.
+  std::atomic<int32_t> unclaimed_tasks_{0};
+  // Iteration cursor of dynamically scheduled loops, shared with the workers
+  // through env.chunk_handle (see TVMBackendParallelNextChunk).
+  std::atomic<int64_t> chunk_cursor_;
   // Whether error has been countered.
   std::atomic<bool> has_error_;
   // The counter page.
@@ -174,15 +214,25 @@ class SpscTaskQueue {
    * \return Whether pop is successful (true) or we need to exit now (false).
    */
   bool Pop(Task* output, uint32_t spin_count) {
-    // Busy wait a bit when the queue is empty.
-    // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
-    // The default spin count is set by following the typical omp convention
-    for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
-      tvm::runtime::threading::Yield();
-    }
-    if (pending_.fetch_sub(1) == 0) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      cv_.wait(lock, [this] { return pending_.load() >= 0 || exit_now_.load(); });
+    if (spin_count == kAlwaysSpinCount) {
+      // Spin-only consumer: never park on the condition variable, so the
+      // matching Push stays lock-free as well (pending_ never drops below 0).
+      while (pending_.load(std::memory_order_acquire) == 0) {
+        if (exit_now_.load(std::memory_order_relaxed)) return false;
+        tvm::runtime::threading::Yield();
+      }
+      pending_.fetch_sub(1);
+    } else {
+      // Busy wait a bit when the queue is empty.
+      // If a new task comes to the queue quickly, this wait avoid the worker from sleeping.
+      // The default spin count is set by following the typical omp convention
+      for (uint32_t i = 0; i < spin_count && pending_.load() == 0; ++i) {
+        tvm::runtime::threading::Yield();
+      }
+      if (pending_.fetch_sub(1) == 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return pending_.load() >= 0 || exit_now_.load(); });
+      }
     }
     if (exit_now_.load(std::memory_order_relaxed)) {
       return false;
@@ -266,6 +316,10 @@ class ThreadPool {
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
     }
+    const char* work_stealing = getenv("TVM_THREAD_POOL_WORK_STEALING");
+    if (work_stealing && atoi(work_stealing) != 0) {
+      work_stealing_ = true;
+    }
     threads_ = std::unique_ptr<tvm::runtime::threading::ThreadGroup>(
         new tvm::runtime::threading::ThreadGroup(
             num_workers_, [this](int worker_id) { this->RunWorker(worker_id); },
@@ -293,18 +347,26 @@ class ThreadPool {
     launcher->Init(flambda, cdata, num_task, need_sync != 0);
     SpscTaskQueue::Task tsk;
     tsk.launcher = launcher;
+    // In work-stealing mode the pushed task only acts as a wakeup; the worker
+    // claims the actual partition from the launcher's shared cursor, so a
+    // fast worker can take the partition of a slow-to-wake sibling.
+    tsk.task_id = kWorkStealingTaskId;
     // if worker0 is taken by the main, queues_[0] is abandoned
     for (int i = exclude_worker0_; i < num_task; ++i) {
-      tsk.task_id = i;
+      if (!work_stealing_) tsk.task_id = i;
       queues_[i]->Push(tsk);
     }
     // use the main thread to run task 0
     if (exclude_worker0_) {
-      TVMParallelGroupEnv* penv = &(tsk.launcher->env);
-      if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
-        tsk.launcher->SignalJobFinish();
+      if (work_stealing_) {
+        RunClaimedTasks(launcher);
       } else {
-        tsk.launcher->SignalJobError(tsk.task_id);
+        TVMParallelGroupEnv* penv = &(tsk.launcher->env);
+        if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
+          tsk.launcher->SignalJobFinish();
+        } else {
+          tsk.launcher->SignalJobError(tsk.task_id);
+        }
       }
     }
     int res = launcher->WaitForJobs();
@@ -313,6 +375,11 @@ class ThreadPool {
 
   static ThreadPool* ThreadLocal() { return dmlc::ThreadLocalStore<ThreadPool>::Get(); }
 
+  void UpdateSpinCount(int spin_count) {
+    spin_count_.store(spin_count < 0 ? kAlwaysSpinCount : static_cast<uint32_t>(spin_count),
+                      std::memory_order_relaxed);
+  }
+
   void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads) {
     // this will also reset the affinity of the ThreadGroup
     // may use less than the MaxConcurrency number of workers
@@ -323,17 +390,36 @@ class ThreadPool {
   }
 
  private:
+  // Run tasks claimed from the launcher's shared cursor until it is drained.
+  // Sync launches stop after one claim so that every barrier participant
+  // stays on its own thread.
+  static void RunClaimedTasks(ParallelLauncher* launcher) {
+    TVMParallelGroupEnv* penv = &(launcher->env);
+    void* cdata = launcher->cdata;
+    const bool single_claim = (penv->sync_handle != nullptr);
+    int32_t task_id;
+    while ((task_id = launcher->FetchTask()) != kWorkStealingTaskId) {
+      if ((*launcher->flambda)(task_id, penv, cdata) == 0) {
+        launcher->SignalJobFinish();
+      } else {
+        launcher->SignalJobError(task_id);
+      }
+      if (single_claim) break;
+    }
+  }
   // Internal worker function.
   void RunWorker(int worker_id) {
     SpscTaskQueue* queue = queues_[worker_id].get();
     SpscTaskQueue::Task task;
     ParallelLauncher::ThreadLocal()->is_worker = true;
-    // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
-    // the global first use of the ThreadPool.
-    // TODO(tulloch): should we make this configurable via standard APIs?
-    static size_t spin_count = GetSpinCount();
-    while (queue->Pop(&task, spin_count)) {
+    // The spin count is a per-pool property; re-read it every iteration so
+    // runtime.config_threadpool can retune a live pool.
+    while (queue->Pop(&task, spin_count_.load(std::memory_order_relaxed))) {
       ICHECK(task.launcher != nullptr);
+      if (task.task_id == kWorkStealingTaskId) {
+        RunClaimedTasks(task.launcher);
+        continue;
+      }
       TVMParallelGroupEnv* penv = &(task.launcher->env);
       void* cdata = task.launcher->cdata;
       if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
@@ -348,6 +434,13 @@ class ThreadPool {
   int num_workers_used_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
+  // whether workers claim task ids dynamically instead of a fixed round-robin
+  // assignment (from envvar TVM_THREAD_POOL_WORK_STEALING)
+  bool work_stealing_{false};
+  // number of iterations a worker spins before sleeping; kAlwaysSpinCount
+  // keeps the workers spinning (from envvar TVM_THREAD_POOL_SPIN_COUNT,
+  // negative values request spin-only, retunable via config_threadpool)
+  std::atomic<uint32_t> spin_count_{GetSpinCount()};
   std::vector<std::unique_ptr<SpscTaskQueue> > queues_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
@@ -357,6 +450,11 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRe
       static_cast<threading::ThreadGroup::AffinityMode>(static_cast<int>(args[0]));
   int nthreads = args[1];
   ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads);
+  // optional third argument retunes the worker spin count of this pool;
+  // a negative value switches the workers to spin-only (lock-free) waiting
+  if (args.num_args >= 3) {
+    ThreadPool::ThreadLocal()->UpdateSpinCount(args[2]);
+  }
 });
 
 }  // namespace runtime
@@ -366,9 +464,11 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
   int num_workers = tvm::runtime::threading::MaxConcurrency();
   if (num_workers == 1) {
     std::atomic<int32_t> sync_counter{0};
+    std::atomic<int64_t> chunk_cursor{0};
     TVMParallelGroupEnv env;
     env.num_task = 1;
     env.sync_handle = &sync_counter;
+    env.chunk_handle = &chunk_cursor;
     (*flambda)(0, &env, cdata);
     return 0;
   } else {
@@ -378,10 +478,12 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
 #else
     if (num_task == 0) num_task = num_workers;
     omp_set_num_threads(num_task);
+    std::atomic<int64_t> chunk_cursor{0};
 #pragma omp parallel num_threads(num_task)
     {
       TVMParallelGroupEnv env;
       env.num_task = num_task;
+      env.chunk_handle = &chunk_cursor;
       (*flambda)(omp_get_thread_num(), &env, cdata);
     }
     return 0;
@@ -389,6 +491,24 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
   }
 }
 
+int TVMBackendParallelNextChunk(TVMParallelGroupEnv* penv, int64_t extent, int64_t* out_begin,
+                                int64_t* out_end) {
+  std::atomic<int64_t>* cursor = reinterpret_cast<std::atomic<int64_t>*>(penv->chunk_handle);
+  int64_t cur = cursor->load(std::memory_order_relaxed);
+  while (cur < extent) {
+    // Guided scheduling: hand out half of the per-worker share of what is
+    // left, so chunks start large and shrink towards the tail.
+    int64_t chunk = (extent - cur) / (2 * penv->num_task);
+    if (chunk < 1) chunk = 1;
+    if (cursor->compare_exchange_weak(cur, cur + chunk, std::memory_order_relaxed)) {
+      *out_begin = cur;
+      *out_end = cur + chunk;
+      return 1;
+    }
+  }
+  return 0;
+}
+
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) {
 #if TVM_THREADPOOL_USE_OPENMP
 #pragma omp barrier
@@ -51,6 +51,7 @@ class ThreadGroup::Impl {
       threads_.emplace_back([worker_callback, i] { worker_callback(i); });
     }
     InitSortedOrder();
+    InitNumaTopology();
   }
   ~Impl() { Join(); }
 
@@ -66,6 +67,9 @@ class ThreadGroup::Impl {
       num_workers_used = little_count_;
     } else if (mode == kBig) {
       num_workers_used = big_count_;
+    } else if (mode == kNuma && !numa_nodes_.empty()) {
+      numa_node_used_ = GetNumaNode();
+      num_workers_used = static_cast<int>(numa_nodes_[numa_node_used_].size());
     } else {
       // use default
       num_workers_used = threading::MaxConcurrency();
@@ -83,7 +87,9 @@ class ThreadGroup::Impl {
     const char* val = getenv("TVM_BIND_THREADS");
     if (val == nullptr || atoi(val) == 1) {
       // Do not set affinity if there are more workers than found cores
-      if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
+      if (mode == kNuma && !numa_nodes_.empty()) {
+        SetNumaAffinity(exclude_worker0, numa_node_used_);
+      } else if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
         SetAffinity(exclude_worker0, mode == kLittle);
       } else {
         LOG(WARNING) << "The thread affinity cannot be set when the number of workers"
@@ -140,6 +146,30 @@ class ThreadGroup::Impl {
 #endif
   }
 
+  // bind worker threads to the cores of one NUMA node so that worker stacks
+  // and first-touched arenas stay in node-local memory. If worker 0 is
+  // offloaded to main, the main thread may migrate within the node.
+  void SetNumaAffinity(bool exclude_worker0, int node) {
+#if defined(__linux__)
+    const std::vector<unsigned int>& cores = numa_nodes_[node];
+    for (unsigned i = 0; i < threads_.size(); ++i) {
+      unsigned core_id = cores[(i + exclude_worker0) % cores.size()];
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      CPU_SET(core_id, &cpuset);
+      pthread_setaffinity_np(threads_[i].native_handle(), sizeof(cpu_set_t), &cpuset);
+    }
+    if (exclude_worker0) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for (unsigned core_id : cores) {
+        CPU_SET(core_id, &cpuset);
+      }
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    }
+#endif
+  }
+
   void SetMasterThreadFullCpuAffinity(bool reverse) {
 #if defined(__linux__) || defined(__ANDROID__)
     cpu_set_t cpuset;
@@ -218,9 +248,53 @@ class ThreadGroup::Impl {
     }
   }
 
+  // read the per-node cpu lists exposed by the kernel, e.g.
+  // /sys/devices/system/node/node1/cpulist = "32-63,96-127"
+  void InitNumaTopology() {
+#if defined(__linux__)
+    for (int node = 0;; ++node) {
+      std::ostringstream filepath;
+      filepath << "/sys/devices/system/node/node" << node << "/cpulist";
+      std::ifstream ifs(filepath.str());
+      if (ifs.fail()) break;
+      std::string cpulist;
+      std::getline(ifs, cpulist);
+      std::vector<unsigned int> cores;
+      std::istringstream iss(cpulist);
+      std::string range;
+      while (std::getline(iss, range, ',')) {
+        size_t dash = range.find('-');
+        if (dash == std::string::npos) {
+          cores.push_back(atoi(range.c_str()));
+        } else {
+          unsigned int lo = atoi(range.substr(0, dash).c_str());
+          unsigned int hi = atoi(range.substr(dash + 1).c_str());
+          for (unsigned int c = lo; c <= hi; ++c) {
+            cores.push_back(c);
+          }
+        }
+      }
+      if (!cores.empty()) numa_nodes_.push_back(cores);
+    }
+#endif
+  }
+
+  int GetNumaNode() const {
+    const char* val = getenv("TVM_NUMA_NODE");
+    int node = val ? atoi(val) : 0;
+    if (node < 0 || node >= static_cast<int>(numa_nodes_.size())) {
+      LOG(WARNING) << "TVM_NUMA_NODE=" << node << " is out of range, falling back to node 0.";
+      node = 0;
+    }
+    return node;
+  }
+
   int num_workers_;
   std::vector<std::thread> threads_;
   std::vector<unsigned int> sorted_order_;
+  // cores of each NUMA node, empty when the topology is unknown
+  std::vector<std::vector<unsigned int> > numa_nodes_;
+  int numa_node_used_ = 0;
   int big_count_ = 0;
   int little_count_ = 0;
 };
@@ -127,6 +127,20 @@ Instruction::Instruction(const Instruction& instr) {
       this->src_device_type = instr.src_device_type;
       this->dst_device_type = instr.dst_device_type;
       return;
+    case Opcode::AffineShape:
+      this->affine_shape.ndim = instr.affine_shape.ndim;
+      this->affine_shape.num_inputs = instr.affine_shape.num_inputs;
+      this->affine_shape.out = instr.affine_shape.out;
+      this->affine_shape.shape_inputs =
+          Duplicate<RegName>(instr.affine_shape.shape_inputs, instr.affine_shape.num_inputs);
+      this->affine_shape.src_input =
+          Duplicate<int64_t>(instr.affine_shape.src_input, instr.affine_shape.ndim);
+      this->affine_shape.src_elem =
+          Duplicate<int64_t>(instr.affine_shape.src_elem, instr.affine_shape.ndim);
+      this->affine_shape.coeff =
+          Duplicate<int64_t>(instr.affine_shape.coeff, instr.affine_shape.ndim);
+      this->affine_shape.bias = Duplicate<int64_t>(instr.affine_shape.bias, instr.affine_shape.ndim);
+      return;
     default:
       std::ostringstream out;
       out << "Invalid instruction " << static_cast<int>(instr.op);
@@ -233,6 +247,25 @@ Instruction& Instruction::operator=(const Instruction& instr) {
       this->src_device_type = instr.src_device_type;
       this->dst_device_type = instr.dst_device_type;
       return *this;
+    case Opcode::AffineShape:
+      this->affine_shape.ndim = instr.affine_shape.ndim;
+      this->affine_shape.num_inputs = instr.affine_shape.num_inputs;
+      this->affine_shape.out = instr.affine_shape.out;
+      FreeIf(this->affine_shape.shape_inputs);
+      this->affine_shape.shape_inputs =
+          Duplicate<RegName>(instr.affine_shape.shape_inputs, instr.affine_shape.num_inputs);
+      FreeIf(this->affine_shape.src_input);
+      this->affine_shape.src_input =
+          Duplicate<int64_t>(instr.affine_shape.src_input, instr.affine_shape.ndim);
+      FreeIf(this->affine_shape.src_elem);
+      this->affine_shape.src_elem =
+          Duplicate<int64_t>(instr.affine_shape.src_elem, instr.affine_shape.ndim);
+      FreeIf(this->affine_shape.coeff);
+      this->affine_shape.coeff =
+          Duplicate<int64_t>(instr.affine_shape.coeff, instr.affine_shape.ndim);
+      FreeIf(this->affine_shape.bias);
+      this->affine_shape.bias = Duplicate<int64_t>(instr.affine_shape.bias, instr.affine_shape.ndim);
+      return *this;
     default:
       std::ostringstream out;
       out << "Invalid instruction " << static_cast<int>(instr.op);
@@ -275,6 +308,13 @@ Instruction::~Instruction() {
     case Opcode::Invoke:
       delete[] this->invoke_args_registers;
       return;
+    case Opcode::AffineShape:
+      delete[] this->affine_shape.shape_inputs;
+      delete[] this->affine_shape.src_input;
+      delete[] this->affine_shape.src_elem;
+      delete[] this->affine_shape.coeff;
+      delete[] this->affine_shape.bias;
+      return;
     default:
       std::ostringstream out;
       LOG(FATAL) << "Invalid instruction " << static_cast<int>(this->op);
@@ -377,6 +417,33 @@ Instruction Instruction::DeviceCopy(RegName src, Index src_device_type, Index ds
   return instr;
 }
 
+Instruction Instruction::AffineShape(Index ndim, const std::vector<RegName>& shape_inputs,
+                                     const std::vector<int64_t>& src_input,
+                                     const std::vector<int64_t>& src_elem,
+                                     const std::vector<int64_t>& coeff,
+                                     const std::vector<int64_t>& bias, RegName out) {
+  Instruction instr;
+  instr.op = Opcode::AffineShape;
+  instr.affine_shape.ndim = ndim;
+  instr.affine_shape.num_inputs = shape_inputs.size();
+  instr.affine_shape.out = out;
+  instr.affine_shape.shape_inputs = new RegName[shape_inputs.size()];
+  for (size_t i = 0; i < shape_inputs.size(); ++i) {
+    instr.affine_shape.shape_inputs[i] = shape_inputs[i];
+  }
+  instr.affine_shape.src_input = new int64_t[ndim];
+  instr.affine_shape.src_elem = new int64_t[ndim];
+  instr.affine_shape.coeff = new int64_t[ndim];
+  instr.affine_shape.bias = new int64_t[ndim];
+  for (Index i = 0; i < ndim; ++i) {
+    instr.affine_shape.src_input[i] = src_input[i];
+    instr.affine_shape.src_elem[i] = src_elem[i];
+    instr.affine_shape.coeff[i] = coeff[i];
+    instr.affine_shape.bias[i] = bias[i];
+  }
+  return instr;
+}
+
 Instruction Instruction::AllocADT(Index tag, Index num_fields,
                                   const std::vector<RegName>& datatype_fields, RegName dst) {
   Instruction instr;
@@ -626,6 +693,25 @@ void InstructionPrint(std::ostream& os, const Instruction& instr) {
          << instr.src_device_type;
       break;
     }
+    case Opcode::AffineShape: {
+      os << "affine_shape $" << instr.affine_shape.out << " (in: $"
+         << StrJoin<RegName>(instr.affine_shape.shape_inputs, 0, instr.affine_shape.num_inputs,
+                             ", $")
+         << ") [";
+      for (Index i = 0; i < instr.affine_shape.ndim; ++i) {
+        if (i != 0) {
+          os << ", ";
+        }
+        if (instr.affine_shape.src_input[i] < 0) {
+          os << instr.affine_shape.bias[i];
+        } else {
+          os << instr.affine_shape.coeff[i] << "*in" << instr.affine_shape.src_input[i] << "["
+             << instr.affine_shape.src_elem[i] << "]+" << instr.affine_shape.bias[i];
+        }
+      }
+      os << "]";
+      break;
+    }
     default:
       LOG(FATAL) << "should never hit this case" << static_cast<int>(instr.op);
       break;
@@ -24,16 +24,20 @@
 
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/vm.h>
 
 #include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <sstream>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -116,7 +120,7 @@ std::string Executable::GetBytecode() const {
   std::ostringstream oss;
 
   for (size_t i = 0; i < functions.size(); ++i) {
-    const auto& func = functions[i];
+    const auto& func = EnsureFunction(i);
     // Print the header of the function format.
     oss << "VM Function[" << i << "]: " << func.name << "(";
     for (const auto& param : func.params) {
@@ -208,6 +212,13 @@ void SaveHeader(dmlc::Stream* strm) {
 }
 
 TVMByteArray Executable::Save() {
+  // The lazy byte windows alias code_, which is about to be rewritten, so
+  // every function must be decoded first.
+  for (size_t i = 0; i < functions.size(); ++i) {
+    EnsureFunction(i);
+  }
+  lazy_functions_.clear();
+
   // Initialize the stream object.
   code_.clear();
   dmlc::MemoryStringStream strm(&code_);
@@ -249,14 +260,37 @@ void Executable::SaveGlobalSection(dmlc::Stream* strm) {
 }
 
 void Executable::SaveConstantSection(dmlc::Stream* strm) {
-  std::vector<DLTensor*> arrays;
+  // keep device constants alive after the copy to host
+  std::vector<NDArray> arrays;
   for (const auto& obj : this->constants) {
-    const auto cell = Downcast<runtime::NDArray>(obj);
-    arrays.push_back(const_cast<DLTensor*>(cell.operator->()));
+    auto cell = Downcast<runtime::NDArray>(obj);
+    if (cell->device.device_type != kDLCPU) {
+      cell = cell.CopyTo(Device{kDLCPU, 0});
+    }
+    arrays.push_back(cell);
   }
-  strm->Write(static_cast<uint64_t>(this->constants.size()));
-  for (const auto& it : arrays) {
-    runtime::SaveDLTensor(strm, it);
+
+  strm->Write(kTVMVMConstantsAlignedMagic);
+  strm->Write(static_cast<uint64_t>(arrays.size()));
+  for (const NDArray& arr : arrays) {
+    const DLTensor* tensor = arr.operator->();
+    ICHECK(tensor->strides == nullptr && tensor->byte_offset == 0)
+        << "The constant section expects compact tensors";
+    strm->Write(tensor->dtype);
+    std::vector<int64_t> shape(tensor->shape, tensor->shape + tensor->ndim);
+    strm->Write(shape);
+    uint64_t nbytes = GetDataSize(*tensor);
+    strm->Write(nbytes);
+    // Pad so the payload starts at a kAllocAlignment boundary of the saved
+    // file. Save() streams into code_, so code_.size() is the current blob
+    // offset; SaveToBinary prefixes the blob with a uint64 length, hence the
+    // extra sizeof(uint64_t). LoadFromFileMmap relies on this alignment to
+    // alias the payloads in place.
+    uint8_t zero = 0;
+    while ((code_.size() + sizeof(uint64_t)) % kAllocAlignment != 0) {
+      strm->Write(zero);
+    }
+    strm->Write(tensor->data, nbytes);
   }
 
   // Save the const to device mapping.
@@ -446,6 +480,17 @@ VMInstructionSerializer SerializeInstruction(const Instruction& instr) {
       fields.assign({instr.src, instr.src_device_type, instr.dst_device_type, instr.dst});
       break;
     }
+    case Opcode::AffineShape: {
+      // Number of fields = 3 + instr.num_inputs + 4 * instr.ndim
+      const auto& as = instr.affine_shape;
+      fields.assign({as.ndim, as.num_inputs, as.out});
+      fields.insert(fields.end(), as.shape_inputs, as.shape_inputs + as.num_inputs);
+      fields.insert(fields.end(), as.src_input, as.src_input + as.ndim);
+      fields.insert(fields.end(), as.src_elem, as.src_elem + as.ndim);
+      fields.insert(fields.end(), as.coeff, as.coeff + as.ndim);
+      fields.insert(fields.end(), as.bias, as.bias + as.ndim);
+      break;
+    }
     default:
       LOG(FATAL) << "Invalid opcode" << static_cast<int>(instr.op);
       break;
@@ -515,6 +560,10 @@ runtime::Module Executable::Load(const std::string& code, const runtime::Module
   }
 
   exec->code_ = code;
+  // code_ is not touched again until Save, so the lazy code loader may keep
+  // byte windows into it (see LoadCodeSection).
+  exec->lazy_code_base_ = exec->code_.data();
+  exec->lazy_code_size_ = exec->code_.size();
   dmlc::MemoryStringStream strm(&exec->code_);
 
   // Load header.
@@ -535,6 +584,57 @@ runtime::Module Executable::Load(const std::string& code, const runtime::Module
   return runtime::Module(exec);
 }
 
+runtime::Module Executable::LoadFromFileMmap(const std::string& path, const runtime::Module lib) {
+  std::shared_ptr<MmapFile> mmap = MmapFile::Open(path);
+  if (mmap == nullptr) {
+    // No mmap on this platform: fall back to the in-memory loader.
+    std::string data;
+    LoadBinaryFromFile(path, &data);
+    dmlc::MemoryStringStream reader(&data);
+    dmlc::Stream* fallback_strm = &reader;
+    std::string code;
+    ICHECK(fallback_strm->Read(&code)) << "Invalid VM file " << path;
+    return Executable::Load(code, lib);
+  }
+
+  // The file holds the uint64 length prefix SaveToBinary wrote, followed by
+  // the serialized blob.
+  ICHECK_GE(mmap->size(), sizeof(uint64_t)) << "Invalid VM file " << path;
+  uint64_t blob_size = 0;
+  std::memcpy(&blob_size, mmap->data(), sizeof(blob_size));
+  ICHECK_LE(blob_size + sizeof(uint64_t), mmap->size()) << "Invalid VM file " << path;
+  char* blob = mmap->data() + sizeof(uint64_t);
+
+  auto exec = make_object<Executable>();
+  if (lib.defined()) {
+    exec->SetLib(lib);
+  }
+
+  // The mapping must outlive the lazy code loader's byte windows into it.
+  exec->mmap_ = mmap;
+  exec->lazy_code_base_ = blob;
+  exec->lazy_code_size_ = blob_size;
+
+  dmlc::MemoryFixedSizeStream strm(blob, blob_size);
+
+  // Load header.
+  LoadHeader(&strm);
+
+  // Global section.
+  exec->LoadGlobalSection(&strm);
+
+  // Constant section; the constants alias the mapping.
+  exec->LoadConstantSection(&strm, blob, mmap);
+
+  // Primitive names that will be invoked by `InvokePacked` instructions.
+  exec->LoadPrimitiveOpNames(&strm);
+
+  // Code section.
+  exec->LoadCodeSection(&strm);
+
+  return runtime::Module(exec);
+}
+
 void Executable::LoadGlobalSection(dmlc::Stream* strm) {
   std::vector<std::string> globals;
   STREAM_CHECK(strm->Read(&globals), "global");
@@ -543,17 +643,48 @@ void Executable::LoadGlobalSection(dmlc::Stream* strm) {
   }
 }
 
-void Executable::LoadConstantSection(dmlc::Stream* strm) {
+void Executable::LoadConstantSection(dmlc::SeekStream* strm, char* mmap_base,
+                                     std::shared_ptr<MmapFile> mmap) {
   uint64_t sz;
-  // Load the number of constants.
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
-
-  size_t size = static_cast<size_t>(sz);
-  // Load each of the constants.
-  for (size_t i = 0; i < size; i++) {
-    runtime::NDArray constant;
-    STREAM_CHECK(constant.Load(strm), "constant");
-    this->constants.push_back(constant);
+  size_t size;
+  if (sz == kTVMVMConstantsAlignedMagic) {
+    // Aligned layout: per constant dtype/shape/nbytes metadata, with the
+    // payload padded to a kAllocAlignment boundary of the saved file.
+    STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "constant");
+    size = static_cast<size_t>(sz);
+    for (size_t i = 0; i < size; i++) {
+      DLDataType dtype;
+      std::vector<int64_t> shape;
+      uint64_t nbytes;
+      STREAM_CHECK(strm->Read(&dtype), "constant");
+      STREAM_CHECK(strm->Read(&shape), "constant");
+      STREAM_CHECK(strm->Read(&nbytes), "constant");
+      // Skip the padding; offsets are aligned relative to the uint64
+      // length-prefixed file SaveToFile writes (see SaveConstantSection).
+      size_t pos = strm->Tell() + sizeof(uint64_t);
+      pos = (pos + kAllocAlignment - 1) / kAllocAlignment * kAllocAlignment - sizeof(uint64_t);
+      if (mmap != nullptr) {
+        // Alias the payload inside the mapped file; its pages are faulted in
+        // on first use rather than copied up front.
+        this->constants.push_back(NDArrayFromMmap(mmap, mmap_base + pos, std::move(shape), dtype));
+      } else {
+        NDArray constant = NDArray::Empty(shape, dtype, Device{kDLCPU, 0});
+        strm->Seek(pos);
+        STREAM_CHECK(strm->Read(constant.operator->()->data, nbytes) == nbytes, "constant");
+        this->constants.push_back(constant);
+      }
+      strm->Seek(pos + nbytes);
+    }
+  } else {
+    // Legacy layout: the word read above is the number of constants, each
+    // serialized through NDArray save/load.
+    size = static_cast<size_t>(sz);
+    for (size_t i = 0; i < size; i++) {
+      runtime::NDArray constant;
+      STREAM_CHECK(constant.Load(strm), "constant");
+      this->constants.push_back(constant);
+    }
   }
 
   // Load the const to device mapping.
@@ -764,40 +895,110 @@ Instruction DeserializeInstruction(const VMInstructionSerializer& instr) {
       return Instruction::DeviceCopy(instr.fields[0], instr.fields[1], instr.fields[2],
                                      instr.fields[3]);
     }
+    case Opcode::AffineShape: {
+      // Number of fields = 3 + instr.num_inputs + 4 * instr.ndim
+      DCHECK_GE(instr.fields.size(), 3U);
+      Index ndim = instr.fields[0];
+      Index num_inputs = instr.fields[1];
+      RegName out = instr.fields[2];
+      DCHECK_EQ(instr.fields.size(), 3U + static_cast<size_t>(num_inputs + 4 * ndim));
+
+      std::vector<Index> shape_inputs = ExtractFields(instr.fields, 3, num_inputs);
+      std::vector<Index> src_input = ExtractFields(instr.fields, 3 + num_inputs, ndim);
+      std::vector<Index> src_elem = ExtractFields(instr.fields, 3 + num_inputs + ndim, ndim);
+      std::vector<Index> coeff = ExtractFields(instr.fields, 3 + num_inputs + 2 * ndim, ndim);
+      std::vector<Index> bias = ExtractFields(instr.fields, 3 + num_inputs + 3 * ndim, ndim);
+
+      return Instruction::AffineShape(ndim, shape_inputs, src_input, src_elem, coeff, bias, out);
+    }
     default:
       LOG(FATAL) << "Invalid opcode" << instr.opcode;
       return Instruction();
   }
 }
 
-void Executable::LoadCodeSection(dmlc::Stream* strm) {
+void Executable::LoadCodeSection(dmlc::SeekStream* strm) {
   // Load the number of functions.
   uint64_t sz;
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "code");
 
   size_t num_funcs = static_cast<size_t>(sz);
   this->functions.resize(num_funcs);
+  this->lazy_functions_.resize(num_funcs);
   for (size_t i = 0; i < num_funcs; i++) {
     // Load the function info.
     VMFunctionSerializer loaded_func;
     STREAM_CHECK(loaded_func.Load(strm), "code/function");
 
-    // Load the instructions.
-    std::vector<Instruction> instructions;
+    // Only the header is decoded here. The instructions stay as a byte
+    // window of the blob and are deserialized by EnsureFunction when the
+    // function is first needed, so a multi-entry executable does not pay for
+    // functions the chosen entry point never reaches.
+    LazyFunction lazy;
+    lazy.begin = strm->Tell();
+    lazy.num_instructions = loaded_func.num_instructions;
     for (size_t j = 0; j < loaded_func.num_instructions; j++) {
-      VMInstructionSerializer instr;
-      std::vector<Index> instr_fields;
-      STREAM_CHECK(instr.Load(strm), "code/instruction");
-      instructions.push_back(DeserializeInstruction(instr));
+      // Each instruction is a length-prefixed vector of Index (see
+      // VMInstructionSerializer::Save); hop over it without decoding.
+      uint64_t num_fields;
+      STREAM_CHECK(strm->Read(&num_fields, sizeof(num_fields)), "code/instruction");
+      strm->Seek(strm->Tell() + num_fields * sizeof(Index));
     }
 
-    // Create the VM function.
-    VMFunction vm_func = VMFunction(loaded_func.name, loaded_func.params, instructions,
+    // Create the VM function without its instructions.
+    VMFunction vm_func = VMFunction(loaded_func.name, loaded_func.params, {},
                                     loaded_func.register_file_size, loaded_func.params_device_type);
     auto it = this->global_map.find(loaded_func.name);
     ICHECK(it != this->global_map.end());
     ICHECK_LE(it->second, this->global_map.size());
     this->functions[it->second] = vm_func;
+    this->lazy_functions_[it->second] = lazy;
+  }
+}
+
+const VMFunction& Executable::EnsureFunction(Index index) const {
+  ICHECK_LT(static_cast<size_t>(index), functions.size());
+  // Executables assembled in memory by the compiler carry no lazy state.
+  if (lazy_functions_.empty()) {
+    return functions[index];
+  }
+  std::lock_guard<std::mutex> lock(lazy_mutex_);
+  LazyFunction& lazy = lazy_functions_[index];
+  if (lazy.loaded) {
+    return functions[index];
+  }
+  dmlc::MemoryFixedSizeStream strm(const_cast<char*>(lazy_code_base_), lazy_code_size_);
+  strm.Seek(lazy.begin);
+  std::vector<Instruction> instructions;
+  instructions.reserve(lazy.num_instructions);
+  for (size_t j = 0; j < lazy.num_instructions; j++) {
+    VMInstructionSerializer instr;
+    STREAM_CHECK(instr.Load(&strm), "code/instruction");
+    instructions.push_back(DeserializeInstruction(instr));
+  }
+  functions[index].instructions = std::move(instructions);
+  lazy.loaded = true;
+  return functions[index];
+}
+
+void Executable::EnsureReachableFunctions(Index entry_index) const {
+  std::vector<Index> stack{entry_index};
+  std::unordered_set<Index> visited{entry_index};
+  while (!stack.empty()) {
+    Index index = stack.back();
+    stack.pop_back();
+    const VMFunction& func = EnsureFunction(index);
+    for (const Instruction& instr : func.instructions) {
+      Index callee = -1;
+      if (instr.op == Opcode::Invoke) {
+        callee = instr.func_index;
+      } else if (instr.op == Opcode::AllocClosure) {
+        callee = instr.clo_index;
+      }
+      if (callee >= 0 && visited.insert(callee).second) {
+        stack.push_back(callee);
+      }
+    }
   }
 }
 
@@ -889,6 +1090,11 @@ TVM_REGISTER_GLOBAL("runtime.Load_Executable")
       return Executable::Load(code, lib);
     });
 
+TVM_REGISTER_GLOBAL("runtime.Load_ExecutableMmap")
+    .set_body_typed([](std::string path, runtime::Module lib) {
+      return Executable::LoadFromFileMmap(path, lib);
+    });
+
 }  // namespace vm
 }  // namespace runtime
 }  // namespace tvm
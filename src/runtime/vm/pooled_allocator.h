@@ -39,21 +39,45 @@ class PooledAllocator final : public Allocator {
  public:
   static constexpr size_t kDefaultPageSize = 4096;
 
+  /*! \brief Usage counters of the pool, for monitoring dynamic workloads. */
+  struct PoolStats {
+    /*! \brief Allocations served from the pool. */
+    size_t hit_count{0};
+    /*! \brief Allocations that had to go to the device API. */
+    size_t miss_count{0};
+    /*! \brief Idle buffers released to honor the idle-memory cap. */
+    size_t eviction_count{0};
+    /*! \brief Bytes currently sitting idle in the pool. */
+    size_t idle_memory{0};
+  };
+
   explicit PooledAllocator(Device dev, size_t page_size = kDefaultPageSize)
-      : Allocator(kPooled), page_size_(page_size), used_memory_(0), device_(dev) {}
+      : Allocator(kPooled), page_size_(page_size), used_memory_(0), device_(dev) {
+    // Cap on the bytes kept idle in the pool; 0 keeps the old unbounded
+    // behavior. Beyond the cap the least recently used idle buffers are
+    // released back to the device.
+    const char* val = getenv("TVM_VM_POOL_MAX_IDLE_BYTES");
+    if (val != nullptr) {
+      max_idle_memory_ = static_cast<size_t>(atoll(val));
+    }
+  }
 
   ~PooledAllocator() { ReleaseAll(); }
 
   Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
     std::lock_guard<std::mutex> lock(mu_);
-    size_t size = ((nbytes + page_size_ - 1) / page_size_) * page_size_;
+    size_t size = RoundSize(nbytes);
     auto&& it = memory_pool_.find(size);
     if (it != memory_pool_.end() && !it->second.empty()) {
       auto&& pool = it->second;
-      auto ret = pool.back();
+      // take the most recently used buffer; eviction takes the front
+      auto ret = pool.back().buffer;
       pool.pop_back();
+      stats_.idle_memory -= size;
+      ++stats_.hit_count;
       return ret;
     }
+    ++stats_.miss_count;
     Buffer buf;
     buf.device = device_;
     buf.size = size;
@@ -66,33 +90,85 @@ class PooledAllocator final : public Allocator {
   void Free(const Buffer& buffer) override {
     std::lock_guard<std::mutex> lock(mu_);
     if (memory_pool_.find(buffer.size) == memory_pool_.end()) {
-      memory_pool_.emplace(buffer.size, std::vector<Buffer>{});
+      memory_pool_.emplace(buffer.size, std::vector<IdleBuffer>{});
     }
-    memory_pool_.at(buffer.size).push_back(buffer);
+    memory_pool_.at(buffer.size).push_back(IdleBuffer{buffer, ++tick_});
+    stats_.idle_memory += buffer.size;
+    EvictIfNeeded();
     DLOG(INFO) << "reclaim buffer " << buffer.size;
   }
 
   size_t UsedMemory() const override { return used_memory_.load(std::memory_order_relaxed); }
 
+  /*! \brief Snapshot the pool usage counters. */
+  PoolStats Stats() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return stats_;
+  }
+
  private:
+  /*! \brief An idle pooled buffer together with the time it went idle. */
+  struct IdleBuffer {
+    Buffer buffer;
+    uint64_t tick;
+  };
+
+  // Round the request to the next power of two (at least one page), so
+  // slightly different dynamic shapes fall into a small set of buckets
+  // instead of fragmenting the pool with exact sizes.
+  size_t RoundSize(size_t nbytes) const {
+    size_t size = page_size_;
+    while (size < nbytes) size <<= 1;
+    return size;
+  }
+
+  // Release least recently used idle buffers until the idle cap holds.
+  // Requires mu_ to be held.
+  void EvictIfNeeded() {
+    if (max_idle_memory_ == 0) return;
+    while (stats_.idle_memory > max_idle_memory_) {
+      // each bucket is FIFO, so the global LRU entry is the oldest front
+      auto lru = memory_pool_.end();
+      for (auto it = memory_pool_.begin(); it != memory_pool_.end(); ++it) {
+        if (it->second.empty()) continue;
+        if (lru == memory_pool_.end() || it->second.front().tick < lru->second.front().tick) {
+          lru = it;
+        }
+      }
+      if (lru == memory_pool_.end()) break;
+      const Buffer& buf = lru->second.front().buffer;
+      DeviceAPI::Get(buf.device)->FreeDataSpace(buf.device, buf.data);
+      used_memory_.fetch_sub(buf.size, std::memory_order_relaxed);
+      stats_.idle_memory -= buf.size;
+      ++stats_.eviction_count;
+      lru->second.erase(lru->second.begin());
+    }
+  }
+
   void ReleaseAll() {
     std::lock_guard<std::mutex> lock(mu_);
     for (auto const& it : memory_pool_) {
       auto const& pool = it.second;
       for (auto const& buf : pool) {
-        DeviceAPI::Get(buf.device)->FreeDataSpace(buf.device, buf.data);
+        DeviceAPI::Get(buf.buffer.device)->FreeDataSpace(buf.buffer.device, buf.buffer.data);
       }
     }
     memory_pool_.clear();
     used_memory_ = 0;
+    stats_.idle_memory = 0;
     DLOG(INFO) << "release all buffers";
   }
 
  private:
   size_t page_size_;
   std::atomic<size_t> used_memory_;
-  std::unordered_map<size_t, std::vector<Buffer> > memory_pool_;
-  std::mutex mu_;
+  /*! \brief Idle-memory cap in bytes; 0 means unbounded. */
+  size_t max_idle_memory_{0};
+  /*! \brief Monotonic clock used to order idle buffers for LRU eviction. */
+  uint64_t tick_{0};
+  PoolStats stats_;
+  std::unordered_map<size_t, std::vector<IdleBuffer> > memory_pool_;
+  mutable std::mutex mu_;
   Device device_;
 };
 
@@ -40,6 +40,13 @@ namespace vm {
 /*! \brief The magic number for the serialized VM bytecode file  */
 constexpr uint64_t kTVMVMBytecodeMagic = 0xD225DE2F4214151D;
 
+/*!
+ * \brief Marks the aligned constant section layout, where tensor payloads
+ * start at kAllocAlignment boundaries of the saved file so a loader can
+ * memory map the file and reference the payloads in place.
+ */
+constexpr uint64_t kTVMVMConstantsAlignedMagic = 0xD225DE2F4214151E;
+
 template <typename T>
 static inline uint64_t VectorHash(uint64_t key, const std::vector<T>& values) {
   for (const auto& it : values) {
@@ -31,8 +31,13 @@
 
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "../file_utils.h"
@@ -52,6 +57,93 @@ VMClosure::VMClosure(size_t func_index, std::vector<ObjectRef> free_vars) {
   data_ = std::move(ptr);
 }
 
+/*!
+ * \brief Object allocator that recycles the storage of small ADT objects.
+ *
+ * Every AllocADT instruction creates a fresh tuple object and most of them die
+ * within a few instructions, so the underlying blocks are kept in thread-local
+ * free lists instead of going back to the heap allocator each time. One extra
+ * slot in front of each block records its size class for the deleter; blocks
+ * above kMaxSlots, or freed while the matching list is full, use plain
+ * new/delete.
+ */
+class PooledADTAllocator : public ObjAllocatorBase<PooledADTAllocator> {
+ public:
+  template <typename ArrayType, typename ElemType>
+  class ArrayHandler {
+   public:
+    using StorageType = typename std::aligned_storage<sizeof(ArrayType), alignof(ArrayType)>::type;
+    static_assert(alignof(ArrayType) % alignof(ElemType) == 0 &&
+                      sizeof(ArrayType) % alignof(ElemType) == 0,
+                  "element alignment constraint");
+    static_assert(sizeof(StorageType) >= sizeof(size_t), "header slot must fit the size class");
+
+    template <typename... Args>
+    static ArrayType* New(PooledADTAllocator*, size_t num_elems, Args&&... args) {
+      size_t unit = sizeof(StorageType);
+      size_t requested_size = num_elems * sizeof(ElemType) + sizeof(ArrayType);
+      size_t num_slots = (requested_size + unit - 1) / unit;
+      StorageType* block = AllocBlock(num_slots);
+      new (block + 1) ArrayType(std::forward<Args>(args)...);
+      return reinterpret_cast<ArrayType*>(block + 1);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    /*! \brief Largest size class, in storage slots, kept in the free lists. */
+    static constexpr size_t kMaxSlots = 16;
+    /*! \brief Maximal number of cached blocks per size class. */
+    static constexpr size_t kMaxFreePerClass = 256;
+
+    struct FreeLists {
+      std::vector<StorageType*> lists[kMaxSlots + 1];
+      ~FreeLists() {
+        for (auto& list : lists) {
+          for (StorageType* block : list) delete[] block;
+        }
+      }
+    };
+
+    static FreeLists* ThreadLocalLists() {
+      static thread_local FreeLists lists;
+      return &lists;
+    }
+
+    static StorageType* AllocBlock(size_t num_slots) {
+      if (num_slots <= kMaxSlots) {
+        auto& list = ThreadLocalLists()->lists[num_slots];
+        if (!list.empty()) {
+          StorageType* block = list.back();
+          list.pop_back();
+          return block;
+        }
+      }
+      StorageType* block = new StorageType[num_slots + 1];
+      *reinterpret_cast<size_t*>(block) = num_slots;
+      return block;
+    }
+
+    static void Deleter_(Object* objptr) {
+      ArrayType* tptr = static_cast<ArrayType*>(objptr);
+      tptr->ArrayType::~ArrayType();
+      StorageType* block = reinterpret_cast<StorageType*>(tptr) - 1;
+      size_t num_slots = *reinterpret_cast<size_t*>(block);
+      if (num_slots <= kMaxSlots) {
+        // Objects may be released on a different thread than the one that
+        // allocated them; the blocks are interchangeable, so returning one to
+        // the releasing thread's list is fine.
+        auto& list = ThreadLocalLists()->lists[num_slots];
+        if (list.size() < kMaxFreePerClass) {
+          list.push_back(block);
+          return;
+        }
+      }
+      delete[] block;
+    }
+  };
+};
+
 void VMFunctionPrint(std::ostream& os, const VMFunction& vm_func) {
   os << vm_func.name << ": " << std::endl;
   for (size_t i = 0; i < vm_func.instructions.size(); ++i) {
@@ -122,6 +214,7 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
       auto git = exec_->global_map.find(func_name);
       ICHECK(git != exec_->global_map.end())
           << "Cannot find function " << func_name << " in the executable";
+      exec_->EnsureReachableFunctions(git->second);
       auto func = exec_->functions[git->second];
       if (func.params.empty()) {
         *rv = Invoke(func, {});
@@ -150,6 +243,24 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
         return Downcast<NDArray>(this->return_register_);
       }
     });
+  } else if (name == "get_shape_profile") {
+    // One line per observed entry-function signature: "<func> <sig> <count>".
+    // The signature encoding matches ShapeSignature; lines are sorted so the
+    // output is deterministic.
+    return TypedPackedFunc<std::string(void)>([this]() -> std::string {
+      std::vector<std::string> lines;
+      for (const auto& fkv : invoke_shape_profile_) {
+        for (const auto& skv : fkv.second) {
+          lines.push_back(fkv.first + " " + skv.first + " " + std::to_string(skv.second));
+        }
+      }
+      std::sort(lines.begin(), lines.end());
+      std::ostringstream os;
+      for (const auto& line : lines) {
+        os << line << "\n";
+      }
+      return os.str();
+    });
   } else if (name == "get_num_outputs") {
     return TypedPackedFunc<int64_t(void)>([this]() -> int64_t {
       // single output is an NDArray not an ADT
@@ -159,6 +270,11 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
         return 1;
       }
     });
+  } else if (name == "warmup") {
+    // Prefault one entry point: decode its reachable bytecode and bind its
+    // kernels ahead of the first call.
+    return TypedPackedFunc<void(std::string)>(
+        [this](std::string func_name) { this->Warmup(func_name); });
   } else if (name == "init") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       ICHECK_EQ(args.size() % 3, 0);
@@ -175,6 +291,21 @@ PackedFunc VirtualMachine::GetFunction(const std::string& name,
       }
       this->Init(devices, alloc_types);
     });
+  } else if (name == "set_reserve_storage") {
+    // Keep AllocStorage results alive across invocations and reuse them when
+    // large enough. Intended for dynamically batched serving: one warm-up
+    // call with maximum (envelope) shapes sizes every reservation, and
+    // steady-state calls with smaller shapes hit the allocator not at all.
+    // Only valid when the results of one invocation are consumed before the
+    // next one starts, since the reused buffers are overwritten.
+    return TypedPackedFunc<void(bool)>([this](bool enable) {
+      reserve_storage_ = enable;
+      if (!enable) {
+        storage_reservations_.clear();
+      }
+    });
+  } else if (name == "release_storage_reservations") {
+    return TypedPackedFunc<void()>([this]() { storage_reservations_.clear(); });
   } else if (name == "set_input") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       ICHECK(exec_) << "The executable is not created yet.";
@@ -227,16 +358,27 @@ inline Device VirtualMachine::GetDevice(Index device_type) const {
 }
 
 void VirtualMachine::PushFrame(Index arg_count, Index ret_pc, const VMFunction& vm_func) {
-  auto frame = VMFrame(ret_pc, func_index_, arg_count, code_, vm_func.register_file_size);
-  frames_.push_back(frame);
+  // Reuse a recycled register file when one is available; its buffer is
+  // already sized for a previous frame so steady-state invocation does not
+  // touch the heap.
+  std::vector<ObjectRef> register_file;
+  if (!free_register_files_.empty()) {
+    register_file = std::move(free_register_files_.back());
+    free_register_files_.pop_back();
+  }
+  register_file.resize(vm_func.register_file_size);
+  frames_.emplace_back(ret_pc, func_index_, arg_count, code_, std::move(register_file));
 }
 
 Index VirtualMachine::PopFrame() {
   ICHECK_GT(frames_.size(), 0);
-  const VMFrame& fr = frames_.back();
+  VMFrame& fr = frames_.back();
   func_index_ = fr.func_index;
   code_ = fr.code;
   pc_ = fr.pc;
+  // Drop the object references but keep the heap buffer for the next frame.
+  fr.register_file.clear();
+  free_register_files_.push_back(std::move(fr.register_file));
   auto call_stack_size = frames_.size();
   frames_.pop_back();
   return call_stack_size;
@@ -255,9 +397,43 @@ void VirtualMachine::InvokeGlobal(const VMFunction& func, const std::vector<Obje
   pc_ = 0;
 }
 
+// Cap on distinct signatures tracked per packed function; signatures beyond
+// the cap run the generic kernel without being counted.
+constexpr size_t kShapeSpecialMaxSignatures = 64;
+
+// Encode the shape of every tensor argument, e.g. "_16x64_64" for a call on a
+// (16, 64) and a (64,) tensor. Scalars encode as "s". The same encoding names
+// pre-seeded specialized symbols in the kernel library.
+std::string ShapeSignature(const std::vector<ObjectRef>& args) {
+  std::ostringstream os;
+  auto append = [&os](const NDArray& arr) {
+    os << '_';
+    if (arr->ndim == 0) {
+      os << 's';
+      return;
+    }
+    for (int i = 0; i < arr->ndim; ++i) {
+      if (i != 0) os << 'x';
+      os << arr->shape[i];
+    }
+  };
+  for (const ObjectRef& arg : args) {
+    if (const auto* dt_cell = arg.as<ADTObj>()) {
+      for (size_t fi = 0; fi < dt_cell->size; ++fi) {
+        append(Downcast<NDArray>((*dt_cell)[fi]));
+      }
+    } else {
+      append(Downcast<NDArray>(arg));
+    }
+  }
+  return os.str();
+}
+
 ObjectRef VirtualMachine::Invoke(const VMFunction& func, const std::vector<ObjectRef>& args) {
   DLOG(INFO) << "Executing Function: " << std::endl << func;
 
+  // Storage reservations made in an earlier invocation become reusable again.
+  ++invoke_epoch_;
   InvokeGlobal(func, args);
   RunLoop();
   return return_register_;
@@ -269,9 +445,101 @@ ObjectRef VirtualMachine::Invoke(const std::string& name, const std::vector<Obje
   ICHECK(it != exec_->global_map.end()) << "Cannot find function " << name << " in the executable";
   auto func_index_ = it->second;
   DLOG(INFO) << "Invoke Global " << name << " at index " << func_index_;
+  RecordShapeProfile(name, args);
+  exec_->EnsureReachableFunctions(func_index_);
   return Invoke(exec_->functions[func_index_], args);
 }
 
+void VirtualMachine::RecordShapeProfile(const std::string& name,
+                                        const std::vector<ObjectRef>& args) {
+  // Only tensor-like arguments can be encoded; entry functions invoked with
+  // closures or other objects are simply not profiled.
+  for (const ObjectRef& arg : args) {
+    if (!arg.defined() ||
+        (!arg->IsInstance<NDArray::ContainerType>() && !arg->IsInstance<ADTObj>())) {
+      return;
+    }
+  }
+  auto& profile = invoke_shape_profile_[name];
+  std::string sig = ShapeSignature(args);
+  auto pit = profile.find(sig);
+  if (pit != profile.end()) {
+    ++pit->second;
+  } else if (profile.size() < kShapeSpecialMaxSignatures) {
+    profile.emplace(std::move(sig), 1);
+  }
+}
+
+const PackedFunc& VirtualMachine::GetPackedFunc(Index packed_index) {
+  ICHECK_LT(static_cast<size_t>(packed_index), packed_funcs_.size());
+  PackedFunc& func = packed_funcs_[packed_index];
+  if (func == nullptr) {
+    runtime::Module lib = exec_->GetLib();
+    func = lib.GetFunction(packed_names_[packed_index], true);
+    ICHECK(func != nullptr) << "Cannot find function in module: " << packed_names_[packed_index];
+  }
+  return func;
+}
+
+void VirtualMachine::Warmup(const std::string& func_name) {
+  ICHECK(exec_) << "The executable is not created yet.";
+  auto git = exec_->global_map.find(func_name);
+  ICHECK(git != exec_->global_map.end())
+      << "Cannot find function " << func_name << " in the executable";
+  exec_->EnsureReachableFunctions(git->second);
+  // Bind every kernel the entry can reach so the first call does no symbol
+  // resolution either.
+  std::vector<Index> stack{git->second};
+  std::unordered_set<Index> visited{git->second};
+  while (!stack.empty()) {
+    const VMFunction& func = exec_->functions[stack.back()];
+    stack.pop_back();
+    for (const Instruction& instr : func.instructions) {
+      if (instr.op == Opcode::InvokePacked) {
+        GetPackedFunc(instr.packed_index);
+      } else if (instr.op == Opcode::Invoke && visited.insert(instr.func_index).second) {
+        stack.push_back(instr.func_index);
+      } else if (instr.op == Opcode::AllocClosure && visited.insert(instr.clo_index).second) {
+        stack.push_back(instr.clo_index);
+      }
+    }
+  }
+}
+
+const PackedFunc& VirtualMachine::SelectPackedFunc(Index packed_index,
+                                                   const std::vector<ObjectRef>& args) {
+  const PackedFunc& generic = GetPackedFunc(packed_index);
+  if (shape_special_threshold_ <= 0) return generic;
+  std::string sig = ShapeSignature(args);
+  auto& cache = shape_special_cache_[packed_index];
+  auto it = cache.find(sig);
+  if (it == cache.end()) {
+    if (cache.size() >= kShapeSpecialMaxSignatures) return generic;
+    it = cache.emplace(std::move(sig), ShapeSpecialEntry()).first;
+  }
+  ShapeSpecialEntry& entry = it->second;
+  if (entry.resolved) {
+    return entry.func != nullptr ? entry.func : generic;
+  }
+  if (++entry.hits < shape_special_threshold_) return generic;
+  // The signature is hot; resolve a specialized variant exactly once.
+  entry.resolved = true;
+  std::string spec_name = packed_names_[packed_index] + "_spec" + it->first;
+  runtime::Module lib = exec_->GetLib();
+  entry.func = lib.GetFunction(spec_name, true);
+  if (entry.func == nullptr) {
+    // The compiler may register a hook that JIT compiles a statically shaped
+    // variant. The runtime stays usable without it.
+    if (const PackedFunc* jit = Registry::Get("vm.shape_specialize")) {
+      TVMRetValue rv = (*jit)(packed_names_[packed_index], it->first);
+      if (rv.type_code() != kTVMNullptr) {
+        entry.func = rv;
+      }
+    }
+  }
+  return entry.func != nullptr ? entry.func : generic;
+}
+
 void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count,
                                   Index output_size, const std::vector<ObjectRef>& args) {
   size_t arity = 0;
@@ -332,14 +600,112 @@ void VirtualMachine::LoadExecutable(const Executable* exec) {
     auto packed_index = static_cast<size_t>(it.second);
     if (packed_funcs_.size() <= packed_index) {
       packed_funcs_.resize(packed_index + 1);
+      packed_names_.resize(packed_index + 1);
+    }
+    // The symbol is bound on first use (see GetPackedFunc); resolving
+    // thousands of symbols here dominates cold start for multi-entry
+    // executables that run only a few of them.
+    packed_names_[packed_index] = packed_name;
+  }
+  for (size_t i = 0; i < packed_names_.size(); ++i) {
+    ICHECK(!packed_names_[i].empty()) << "Packed function " << i << " is not initialized";
+  }
+  const char* parallel_packed = getenv("TVM_VM_PARALLEL_PACKED");
+  if (parallel_packed && atoi(parallel_packed) != 0) {
+    // The analysis walks every function's bytecode.
+    for (size_t i = 0; i < exec_->functions.size(); ++i) {
+      exec_->EnsureFunction(i);
+    }
+    AnalyzePackedGroups();
+  }
+  const char* shape_special = getenv("TVM_VM_SHAPE_SPECIALIZE");
+  if (shape_special && atoll(shape_special) > 0) {
+    shape_special_threshold_ = atoll(shape_special);
+    shape_special_cache_.assign(packed_funcs_.size(),
+                                std::unordered_map<std::string, ShapeSpecialEntry>());
+  }
+}
+
+void VirtualMachine::AnalyzePackedGroups() {
+  parallel_group_len_.clear();
+  // Collect the registers an InvokePacked reads and writes; outputs are the
+  // trailing output_size arguments.
+  auto collect = [](const Instruction& ins, std::unordered_set<RegName>* reads,
+                    std::unordered_set<RegName>* writes) {
+    Index num_inputs = ins.arity - ins.output_size;
+    for (Index k = 0; k < ins.arity; ++k) {
+      (k < num_inputs ? reads : writes)->insert(ins.packed_args[k]);
+    }
+  };
+  for (const auto& vm_func : exec_->functions) {
+    const auto& instrs = vm_func.instructions;
+    size_t i = 0;
+    while (i < instrs.size()) {
+      if (instrs[i].op != Opcode::InvokePacked) {
+        ++i;
+        continue;
+      }
+      std::unordered_set<RegName> reads, writes;
+      collect(instrs[i], &reads, &writes);
+      size_t j = i;
+      while (j + 1 < instrs.size() && instrs[j + 1].op == Opcode::InvokePacked) {
+        const Instruction& next = instrs[j + 1];
+        std::unordered_set<RegName> next_reads, next_writes;
+        collect(next, &next_reads, &next_writes);
+        // keep growing the group only while there is no RAW/WAR/WAW hazard
+        bool conflict = false;
+        for (RegName r : next_reads) {
+          if (writes.count(r)) {
+            conflict = true;
+            break;
+          }
+        }
+        if (!conflict) {
+          for (RegName r : next_writes) {
+            if (reads.count(r) || writes.count(r)) {
+              conflict = true;
+              break;
+            }
+          }
+        }
+        if (conflict) break;
+        reads.insert(next_reads.begin(), next_reads.end());
+        writes.insert(next_writes.begin(), next_writes.end());
+        ++j;
+      }
+      if (j > i) {
+        parallel_group_len_[&instrs[i]] = static_cast<Index>(j - i + 1);
+      }
+      i = j + 1;
     }
-    tvm::runtime::PackedFunc pf = lib.GetFunction(packed_name, true);
-    ICHECK(pf != nullptr) << "Cannot find function in module: " << packed_name;
-    packed_funcs_[packed_index] = pf;
   }
-  for (size_t i = 0; i < packed_funcs_.size(); ++i) {
-    ICHECK(packed_funcs_[i] != nullptr) << "Packed function " << i << " is not initialized";
+}
+
+void VirtualMachine::RunPackedGroup(Index group_size) {
+  // The group members have disjoint register sets, so their packed calls can
+  // be issued concurrently. Outputs are written through the argument tensors,
+  // which keeps the register state untouched during the calls.
+  std::vector<std::future<void>> pending;
+  for (Index g = 0; g < group_size; ++g) {
+    const Instruction& ins = code_[pc_ + g];
+    ICHECK_LE(ins.packed_index, packed_funcs_.size());
+    std::vector<ObjectRef> args;
+    for (Index i = 0; i < ins.arity; ++i) {
+      args.push_back(ReadRegister(ins.packed_args[i]));
+    }
+    const PackedFunc& func = GetPackedFunc(ins.packed_index);
+    Index packed_index = ins.packed_index;
+    Index arity = ins.arity;
+    Index output_size = ins.output_size;
+    pending.push_back(
+        std::async(std::launch::async, [this, packed_index, &func, arity, output_size, args]() {
+          this->InvokePacked(packed_index, func, arity, output_size, args);
+        }));
+  }
+  for (auto& f : pending) {
+    f.get();
   }
+  pc_ += group_size;
 }
 
 void VirtualMachine::Init(const std::vector<Device>& devs,
@@ -362,7 +728,11 @@ inline void VirtualMachine::WriteRegister(Index r, const ObjectRef& val) {
   frames_.back().register_file[r] = val;
 }
 
-inline ObjectRef VirtualMachine::ReadRegister(Index r) const {
+inline void VirtualMachine::WriteRegister(Index r, ObjectRef&& val) {
+  frames_.back().register_file[r] = std::move(val);
+}
+
+inline const ObjectRef& VirtualMachine::ReadRegister(Index r) const {
   return frames_.back().register_file[r];
 }
 
@@ -398,215 +768,293 @@ inline int64_t VirtualMachine::LoadScalarInt(Index r) const {
   return result;
 }
 
+// Use computed-goto (labels-as-values) dispatch where the compiler supports
+// it: every handler ends with its own indirect jump, which branch predictors
+// track much better than one shared switch jump. MSVC has no labels-as-values
+// and falls back to the switch.
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_VM_USE_COMPUTED_GOTO 1
+#else
+#define TVM_VM_USE_COMPUTED_GOTO 0
+#endif
+
+#if TVM_VM_USE_COMPUTED_GOTO
+#define VM_CASE(name) \
+  case Opcode::name:  \
+  vm_label_##name:
+#define VM_DISPATCH()                                               \
+  {                                                                 \
+    instr = &code_[this->pc_];                                      \
+    DLOG(INFO) << "Executing(" << pc_ << "): " << *instr;           \
+    goto* vm_dispatch_table[static_cast<size_t>(instr->op)];        \
+  }
+#else
+#define VM_CASE(name) case Opcode::name:
+#define VM_DISPATCH() goto main_loop
+#endif
+
 void VirtualMachine::RunLoop() {
   ICHECK(this->exec_);
   ICHECK(this->code_);
   pc_ = 0;
   Index frame_start = frames_.size();
+  const Instruction* instr = nullptr;
+#if TVM_VM_USE_COMPUTED_GOTO
+  // The table is indexed by opcode value and must stay in sync with the
+  // Opcode enum in bytecode.h.
+  static const void* vm_dispatch_table[] = {
+      &&vm_label_Move,           &&vm_label_Ret,          &&vm_label_Invoke,
+      &&vm_label_InvokeClosure,  &&vm_label_InvokePacked, &&vm_label_AllocTensor,
+      &&vm_label_AllocTensorReg, &&vm_label_AllocADT,     &&vm_label_AllocClosure,
+      &&vm_label_GetField,       &&vm_label_If,           &&vm_label_LoadConst,
+      &&vm_label_Goto,           &&vm_label_GetTag,       &&vm_label_LoadConsti,
+      &&vm_label_Fatal,          &&vm_label_AllocStorage, &&vm_label_ShapeOf,
+      &&vm_label_ReshapeTensor,  &&vm_label_DeviceCopy,   &&vm_label_AffineShape};
+#endif
   while (true) {
+#if !TVM_VM_USE_COMPUTED_GOTO
   main_loop:
-    auto const& instr = code_[this->pc_];
-    DLOG(INFO) << "Executing(" << pc_ << "): " << instr;
-
-    switch (instr.op) {
-      case Opcode::Move: {
-        ObjectRef from_obj;
-        from_obj = ReadRegister(instr.from);
-        WriteRegister(instr.dst, from_obj);
+#endif
+    instr = &code_[this->pc_];
+    DLOG(INFO) << "Executing(" << pc_ << "): " << *instr;
+#if TVM_VM_USE_COMPUTED_GOTO
+    goto* vm_dispatch_table[static_cast<size_t>(instr->op)];
+#endif
+
+    switch (instr->op) {
+      VM_CASE(Move) {
+        WriteRegister(instr->dst, ReadRegister(instr->from));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Fatal: {
+      VM_CASE(Fatal) {
         throw std::runtime_error("VM encountered fatal error");
       }
-      case Opcode::LoadConst: {
-        auto constant_obj = exec_->constants[instr.const_index];
+      VM_CASE(LoadConst) {
+        auto constant_obj = exec_->constants[instr->const_index];
         // We cache the allocated object in the constant pool. To measure, the
         // first iteration will set the pool up. The other iterations will
         // directly reuse the allocated objects.
-        if (const_pool_.size() <= static_cast<size_t>(instr.const_index)) {
-          const_pool_.resize(instr.const_index + 1);
+        if (const_pool_.size() <= static_cast<size_t>(instr->const_index)) {
+          const_pool_.resize(instr->const_index + 1);
         }
 
-        if (!const_pool_[instr.const_index].defined()) {
-          Device dev = GetDevice(exec_->const_device_type[instr.const_index]);
-          const_pool_[instr.const_index] = CopyTo(constant_obj, dev);
+        if (!const_pool_[instr->const_index].defined()) {
+          Device dev = GetDevice(exec_->const_device_type[instr->const_index]);
+          const_pool_[instr->const_index] = CopyTo(constant_obj, dev);
         }
-        WriteRegister(instr.dst, const_pool_[instr.const_index]);
+        WriteRegister(instr->dst, const_pool_[instr->const_index]);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::LoadConsti: {
+      VM_CASE(LoadConsti) {
         auto tensor = NDArray::Empty({1}, {kDLInt, 64, 1}, {kDLCPU, 0});
-        reinterpret_cast<int64_t*>(tensor->data)[0] = instr.load_consti.val;
-        WriteRegister(instr.dst, tensor);
+        reinterpret_cast<int64_t*>(tensor->data)[0] = instr->load_consti.val;
+        WriteRegister(instr->dst, std::move(tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Invoke: {
+      VM_CASE(Invoke) {
         std::vector<ObjectRef> args;
-        for (Index i = 0; i < instr.num_args; ++i) {
-          args.push_back(ReadRegister(instr.invoke_args_registers[i]));
+        for (Index i = 0; i < instr->num_args; ++i) {
+          args.push_back(ReadRegister(instr->invoke_args_registers[i]));
         }
-        InvokeGlobal(exec_->functions[instr.func_index], args);
-        frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
-      }
-      case Opcode::InvokePacked: {
-        DLOG(INFO) << "InvokedPacked " << instr.packed_index << " arity=" << instr.arity;
-        ICHECK_LE(instr.packed_index, packed_funcs_.size());
-        const auto& func = packed_funcs_[instr.packed_index];
-        const auto& arity = instr.arity;
+        InvokeGlobal(exec_->functions[instr->func_index], args);
+        frames_.back().caller_return_register = instr->dst;
+        VM_DISPATCH();
+      }
+      VM_CASE(InvokePacked) {
+        if (!parallel_group_len_.empty()) {
+          auto git = parallel_group_len_.find(instr);
+          if (git != parallel_group_len_.end()) {
+            RunPackedGroup(git->second);
+            VM_DISPATCH();
+          }
+        }
+        DLOG(INFO) << "InvokedPacked " << instr->packed_index << " arity=" << instr->arity;
+        ICHECK_LE(instr->packed_index, packed_funcs_.size());
+        const auto& arity = instr->arity;
         std::vector<ObjectRef> args;
         for (Index i = 0; i < arity; ++i) {
-          DLOG(INFO) << "arg" << i << " $" << instr.packed_args[i];
-          auto arg = ReadRegister(instr.packed_args[i]);
+          DLOG(INFO) << "arg" << i << " $" << instr->packed_args[i];
+          auto arg = ReadRegister(instr->packed_args[i]);
           args.push_back(arg);
         }
+        const auto& func = SelectPackedFunc(instr->packed_index, args);
 
         // We no longer need to write the registers back, we write directly
         // through the registers mutably.
-        InvokePacked(instr.packed_index, func, arity, instr.output_size, args);
+        InvokePacked(instr->packed_index, func, arity, instr->output_size, args);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::InvokeClosure: {
-        auto object = ReadRegister(instr.closure);
+      VM_CASE(InvokeClosure) {
+        auto object = ReadRegister(instr->closure);
         const auto* closure = object.as<VMClosureObj>();
 
         std::vector<ObjectRef> args;
         for (auto free_var : closure->free_vars) {
           args.push_back(free_var);
         }
-        for (Index i = 0; i < instr.num_closure_args; ++i) {
-          args.push_back(ReadRegister(instr.closure_args[i]));
+        for (Index i = 0; i < instr->num_closure_args; ++i) {
+          args.push_back(ReadRegister(instr->closure_args[i]));
         }
         InvokeGlobal(exec_->functions[closure->func_index], args);
-        frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
-      }
-      case Opcode::GetField: {
-        auto object = ReadRegister(instr.object);
-        const auto& tuple = Downcast<ADT>(object);
-        auto field = tuple[instr.field_index];
-        WriteRegister(instr.dst, field);
+        frames_.back().caller_return_register = instr->dst;
+        VM_DISPATCH();
+      }
+      VM_CASE(GetField) {
+        const auto& tuple = Downcast<ADT>(ReadRegister(instr->object));
+        auto field = tuple[instr->field_index];
+        WriteRegister(instr->dst, std::move(field));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::GetTag: {
-        auto object = ReadRegister(instr.get_tag.object);
-        const auto& adt = Downcast<ADT>(object);
+      VM_CASE(GetTag) {
+        const auto& adt = Downcast<ADT>(ReadRegister(instr->get_tag.object));
         auto tag = adt.tag();
         auto tag_tensor = NDArray::Empty({1}, {kDLInt, 32, 1}, {kDLCPU, 0});
         reinterpret_cast<int32_t*>(tag_tensor->data)[0] = tag;
-        WriteRegister(instr.dst, tag_tensor);
+        WriteRegister(instr->dst, std::move(tag_tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Goto: {
-        pc_ += instr.pc_offset;
-        goto main_loop;
+      VM_CASE(Goto) {
+        pc_ += instr->pc_offset;
+        VM_DISPATCH();
       }
-      case Opcode::If: {
-        int32_t test_val = LoadScalarInt(instr.if_op.test);
-        int32_t target_val = LoadScalarInt(instr.if_op.target);
+      VM_CASE(If) {
+        int32_t test_val = LoadScalarInt(instr->if_op.test);
+        int32_t target_val = LoadScalarInt(instr->if_op.target);
 
         if (test_val == target_val) {
-          ICHECK_NE(instr.if_op.true_offset, 0);
-          pc_ += instr.if_op.true_offset;
+          ICHECK_NE(instr->if_op.true_offset, 0);
+          pc_ += instr->if_op.true_offset;
         } else {
-          ICHECK_NE(instr.if_op.false_offset, 0);
-          pc_ += instr.if_op.false_offset;
+          ICHECK_NE(instr->if_op.false_offset, 0);
+          pc_ += instr->if_op.false_offset;
         }
 
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocTensor: {
-        auto shape = std::vector<int64_t>(instr.alloc_tensor.ndim);
+      VM_CASE(AllocTensor) {
+        OpStartHook(*instr);
+        auto shape = std::vector<int64_t>(instr->alloc_tensor.ndim);
 
-        for (uint32_t i = 0; i < instr.alloc_tensor.ndim; ++i) {
-          shape[i] = instr.alloc_tensor.shape[i];
+        for (uint32_t i = 0; i < instr->alloc_tensor.ndim; ++i) {
+          shape[i] = instr->alloc_tensor.shape[i];
         }
 
-        auto storage_obj = ReadRegister(instr.alloc_tensor.storage);
-        auto offset = LoadScalarInt(instr.alloc_tensor.offset);
+        auto storage_obj = ReadRegister(instr->alloc_tensor.storage);
+        auto offset = LoadScalarInt(instr->alloc_tensor.offset);
         auto storage = Downcast<Storage>(storage_obj);
-        auto obj = storage->AllocNDArray(offset, shape, instr.alloc_tensor.dtype);
+        auto obj = storage->AllocNDArray(offset, shape, instr->alloc_tensor.dtype);
 
-        WriteRegister(instr.dst, obj);
+        WriteRegister(instr->dst, std::move(obj));
+        OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocTensorReg: {
+      VM_CASE(AllocTensorReg) {
+        OpStartHook(*instr);
         Device cpu_dev = GetDevice(static_cast<Index>(kDLCPU));
-        auto shape_obj = ReadRegister(instr.alloc_tensor_reg.shape_register);
+        auto shape_obj = ReadRegister(instr->alloc_tensor_reg.shape_register);
         NDArray shape_tensor = Downcast<NDArray>(CopyTo(shape_obj, cpu_dev));
         auto shape = ToShape(shape_tensor);
-        auto storage_obj = ReadRegister(instr.alloc_tensor_reg.storage);
+        auto storage_obj = ReadRegister(instr->alloc_tensor_reg.storage);
         auto storage = Downcast<Storage>(storage_obj);
-        auto offset = LoadScalarInt(instr.alloc_tensor.offset);
-        auto obj = storage->AllocNDArray(offset, shape, instr.alloc_tensor_reg.dtype);
+        auto offset = LoadScalarInt(instr->alloc_tensor.offset);
+        auto obj = storage->AllocNDArray(offset, shape, instr->alloc_tensor_reg.dtype);
 
-        WriteRegister(instr.dst, obj);
+        WriteRegister(instr->dst, std::move(obj));
+        OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocADT: {
+      VM_CASE(AllocADT) {
         std::vector<ObjectRef> fields;
-        for (Index i = 0; i < instr.num_fields; ++i) {
-          fields.push_back(ReadRegister(instr.datatype_fields[i]));
+        for (Index i = 0; i < instr->num_fields; ++i) {
+          fields.push_back(ReadRegister(instr->datatype_fields[i]));
         }
-        ObjectRef obj = ADT(instr.constructor_tag, fields);
-        WriteRegister(instr.dst, obj);
+        PooledADTAllocator allocator;
+        ObjectRef obj =
+            ADT::Allocate(&allocator, instr->constructor_tag, fields.begin(), fields.end());
+        WriteRegister(instr->dst, std::move(obj));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocClosure: {
+      VM_CASE(AllocClosure) {
         std::vector<ObjectRef> free_vars;
-        for (Index i = 0; i < instr.num_freevar; i++) {
-          free_vars.push_back(ReadRegister(instr.free_vars[i]));
+        for (Index i = 0; i < instr->num_freevar; i++) {
+          free_vars.push_back(ReadRegister(instr->free_vars[i]));
         }
-        WriteRegister(instr.dst, VMClosure(instr.func_index, free_vars));
+        WriteRegister(instr->dst, VMClosure(instr->func_index, free_vars));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocStorage: {
-        auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
-        auto alignment = instr.alloc_storage.alignment;
+      VM_CASE(AllocStorage) {
+        OpStartHook(*instr);
+        auto size = LoadScalarInt(instr->alloc_storage.allocation_size);
+        auto alignment = instr->alloc_storage.alignment;
 
         DLOG(INFO) << "AllocStorage: allocation_size=" << size << ", alignment=" << alignment
-                   << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
-                   << ", device_type=" << instr.alloc_storage.device_type;
+                   << ", dtype_hint=" << DLDataType2String(instr->alloc_storage.dtype_hint)
+                   << ", device_type=" << instr->alloc_storage.device_type;
+
+        bool update_reservation = false;
+        if (reserve_storage_) {
+          auto it = storage_reservations_.find(instr);
+          // An instruction revisited within one invocation (a loop body) must
+          // not alias the buffer of its previous iteration, so only the first
+          // execution per invocation may touch the reservation.
+          if (it == storage_reservations_.end() || it->second.epoch != invoke_epoch_) {
+            if (it != storage_reservations_.end() &&
+                static_cast<int64_t>(it->second.storage->buffer.size) >= size) {
+              // Reuse the reservation made by an earlier (envelope-shaped)
+              // call; a smaller actual shape views a prefix of the buffer.
+              it->second.epoch = invoke_epoch_;
+              WriteRegister(instr->dst, it->second.storage);
+              OpStopHook();
+              pc_++;
+              VM_DISPATCH();
+            }
+            update_reservation = true;
+          }
+        }
 
         auto storage_obj = SimpleObjAllocator().make_object<StorageObj>();
-        auto dev_type = instr.alloc_storage.device_type;
+        auto dev_type = instr->alloc_storage.device_type;
         ICHECK_LT(static_cast<size_t>(dev_type), allocators_.size())
             << "Memory allocator for device " << dev_type << " has not been initialized";
         auto* alloc = allocators_[dev_type];
         ICHECK(alloc) << "Did you forget to init the VirtualMachine with devices?";
-        storage_obj->buffer = alloc->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
+        storage_obj->buffer = alloc->Alloc(size, alignment, instr->alloc_storage.dtype_hint);
         Storage storage(storage_obj);
-        WriteRegister(instr.dst, storage);
+        if (update_reservation) {
+          storage_reservations_[instr] = StorageReservation{storage, invoke_epoch_};
+        }
+        WriteRegister(instr->dst, std::move(storage));
+        OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::ShapeOf: {
-        auto input = ReadRegister(instr.shape_of.tensor);
+      VM_CASE(ShapeOf) {
+        auto input = ReadRegister(instr->shape_of.tensor);
         NDArray input_array = Downcast<NDArray>(input);
         int ndim = input_array->ndim;
         auto out_tensor = NDArray::Empty({ndim}, {kDLInt, 64, 1}, {kDLCPU, 0});
         for (int i = 0; i < ndim; ++i) {
           reinterpret_cast<int64_t*>(out_tensor->data)[i] = input_array->shape[i];
         }
-        WriteRegister(instr.dst, out_tensor);
+        WriteRegister(instr->dst, std::move(out_tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Ret: {
+      VM_CASE(Ret) {
         // If we have hit the point from which we started
         // running, we should return to the caller breaking
         // the dispatch loop.
-        return_register_ = ReadRegister(instr.result);
+        return_register_ = ReadRegister(instr->result);
         auto caller_return_register = frames_.back().caller_return_register;
 
         if (PopFrame() == frame_start) {
@@ -614,15 +1062,16 @@ void VirtualMachine::RunLoop() {
           // Otherwise we are just returning from a local call.
         } else {
           WriteRegister(caller_return_register, return_register_);
-          goto main_loop;
+          VM_DISPATCH();
         }
       }
-      case Opcode::ReshapeTensor: {
+      VM_CASE(ReshapeTensor) {
+        OpStartHook(*instr);
         Device cpu_dev = GetDevice(static_cast<Index>(kDLCPU));
-        auto tensor_obj = ReadRegister(instr.reshape_tensor.tensor);
+        auto tensor_obj = ReadRegister(instr->reshape_tensor.tensor);
         NDArray tensor_arr = Downcast<NDArray>(tensor_obj);
         // Read the shape from shape tensor
-        auto shape_obj = ReadRegister(instr.reshape_tensor.newshape);
+        auto shape_obj = ReadRegister(instr->reshape_tensor.newshape);
         NDArray shape_tensor = Downcast<NDArray>(CopyTo(shape_obj, cpu_dev));
         const DLTensor* dl_tensor = shape_tensor.operator->();
         ICHECK_EQ(dl_tensor->dtype.code, 0u);
@@ -632,31 +1081,59 @@ void VirtualMachine::RunLoop() {
         std::vector<int64_t> shape(dims, dims + ndim);
         // Reshape the input tensor
         auto out_tensor = tensor_arr.CreateView(shape, tensor_arr->dtype);
-        WriteRegister(instr.dst, out_tensor);
+        WriteRegister(instr->dst, std::move(out_tensor));
+        OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::DeviceCopy: {
-        auto tensor_src = ReadRegister(instr.src);
+      VM_CASE(DeviceCopy) {
+        OpStartHook(*instr);
+        auto tensor_src = ReadRegister(instr->src);
         NDArray src_data = Downcast<NDArray>(tensor_src);
         Device src_dev = src_data->device;
-        ICHECK_EQ(static_cast<Index>(src_dev.device_type), instr.src_device_type);
+        ICHECK_EQ(static_cast<Index>(src_dev.device_type), instr->src_device_type);
 
         Device dst_dev;
-        dst_dev.device_type = static_cast<DLDeviceType>(instr.dst_device_type);
+        dst_dev.device_type = static_cast<DLDeviceType>(instr->dst_device_type);
         dst_dev.device_id = 0;
 
         NDArray dst_data = src_data.CopyTo(dst_dev);
-        WriteRegister(instr.dst, dst_data);
+        WriteRegister(instr->dst, std::move(dst_data));
+        OpStopHook();
+        pc_++;
+        VM_DISPATCH();
+      }
+      VM_CASE(AffineShape) {
+        // Evaluate a closed-form shape function inline: every output element
+        // is an affine expression over one element of one input shape tensor.
+        // All tensors involved live on the CPU (see EmitShapeFunc).
+        const auto& affine = instr->affine_shape;
+        auto out = Downcast<NDArray>(ReadRegister(affine.out));
+        // Tensors allocated out of a storage keep their slot in byte_offset.
+        int64_t* out_data = reinterpret_cast<int64_t*>(static_cast<char*>(out->data) +
+                                                       out->byte_offset);
+        for (Index i = 0; i < affine.ndim; ++i) {
+          int64_t val = affine.bias[i];
+          if (affine.src_input[i] >= 0) {
+            auto in = Downcast<NDArray>(ReadRegister(affine.shape_inputs[affine.src_input[i]]));
+            const int64_t* in_data = reinterpret_cast<const int64_t*>(
+                static_cast<const char*>(in->data) + in->byte_offset);
+            val += affine.coeff[i] * in_data[affine.src_elem[i]];
+          }
+          out_data[i] = val;
+        }
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
       default:
-        LOG(FATAL) << "Unknown instruction opcode: " << int(instr.op);
+        LOG(FATAL) << "Unknown instruction opcode: " << int(instr->op);
     }
   }
 }
 
+#undef VM_CASE
+#undef VM_DISPATCH
+
 runtime::Module CreateVirtualMachine(const Executable* exec) {
   auto vm = make_object<VirtualMachine>();
   vm->LoadExecutable(exec);
@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #include "../file_utils.h"
 #include "../pack_args.h"
@@ -116,6 +118,9 @@ class VulkanThreadEntry {
 };
 
 struct VulkanPipeline {
+  /*! \brief Maximal number of descriptor sets cached per pipeline. */
+  static constexpr uint32_t kMaxCachedDescriptorSets = 16;
+
   VulkanContext* vctx_{nullptr};
   VkShaderModule shader{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptor_set_layout{VK_NULL_HANDLE};
@@ -125,10 +130,27 @@ struct VulkanPipeline {
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkDescriptorUpdateTemplateKHR descriptor_update_template{VK_NULL_HANDLE};
   bool use_ubo{false};
+  // Descriptor sets cached by the buffer bindings they were written with,
+  // so a repeated launch neither rewrites a set nor flushes the stream.
+  // Guarded by descriptor_cache_mutex; pipelines are shared across threads.
+  std::unordered_map<uint64_t, VkDescriptorSet> descriptor_set_cache;
+  std::mutex descriptor_cache_mutex;
 };
 
 typedef dmlc::ThreadLocalStore<VulkanThreadEntry> VulkanThreadStore;
 
+// One 64 bit FNV-1a step folding value into the running hash. Used to key
+// the descriptor set and secondary command buffer caches.
+inline uint64_t FNVHash64(uint64_t seed, uint64_t value) {
+  constexpr uint64_t kOffset = 14695981039346656037ULL;
+  constexpr uint64_t kPrime = 1099511628211ULL;
+  uint64_t hash = seed ^ kOffset;
+  for (int i = 0; i < 8; ++i) {
+    hash = (hash ^ ((value >> (i * 8)) & 0xff)) * kPrime;
+  }
+  return hash;
+}
+
 uint32_t FindMemoryType(const VulkanContext& vctx, VkBufferCreateInfo info,
                         VkMemoryPropertyFlags req_prop) {
   VkBuffer buffer;
@@ -881,12 +903,13 @@ class VulkanModuleNode final : public runtime::ModuleNode {
     }
     // Create new pipeline
     auto pe = std::make_shared<VulkanPipeline>();
+    auto sit = smap_.find(func_name);
+    ICHECK(sit != smap_.end());
+    const VulkanShader& shader = sit->second;
     {
       // create shader
-      auto sit = smap_.find(func_name);
-      ICHECK(sit != smap_.end());
-      pe->use_ubo = sit->second.flag & (1 << ShaderMetaDataFlagMask::kUseUBO);
-      const std::vector<uint32_t>& data = sit->second.data;
+      pe->use_ubo = shader.flag & (1 << ShaderMetaDataFlagMask::kUseUBO);
+      const std::vector<uint32_t>& data = shader.data;
       VkShaderModuleCreateInfo shader_cinfo;
       shader_cinfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
       shader_cinfo.pNext = nullptr;
@@ -976,7 +999,11 @@ class VulkanModuleNode final : public runtime::ModuleNode {
       descrip_pool_cinfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
       descrip_pool_cinfo.pNext = nullptr;
       descrip_pool_cinfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-      descrip_pool_cinfo.maxSets = 1;
+      // One shared set plus room for the per-binding descriptor set cache.
+      descrip_pool_cinfo.maxSets = 1 + VulkanPipeline::kMaxCachedDescriptorSets;
+      for (auto& psize : descriptor_set_pool_sizes) {
+        psize.descriptorCount *= descrip_pool_cinfo.maxSets;
+      }
       descrip_pool_cinfo.poolSizeCount = descriptor_set_pool_sizes.size();
       descrip_pool_cinfo.pPoolSizes = descriptor_set_pool_sizes.data();
       VULKAN_CALL(vkCreateDescriptorPool(vctx.device, &descrip_pool_cinfo, nullptr,
@@ -1015,6 +1042,27 @@ class VulkanModuleNode final : public runtime::ModuleNode {
     VULKAN_CALL(
         vkCreatePipelineLayout(vctx.device, &playout_cinfo, nullptr, &(pe->pipeline_layout)));
 
+    // Shaders built with SpecId-decorated constants (thread extents, tile
+    // sizes) carry their values next to the SPIR-V blob; bind them here so a
+    // single binary serves every configuration via driver-side specialization.
+    std::vector<VkSpecializationMapEntry> spec_entries;
+    VkSpecializationInfo spec_info;
+    const bool use_spec_constants =
+        (shader.flag & (1 << ShaderMetaDataFlagMask::kUseSpecConstants)) &&
+        !shader.spec_data.empty();
+    if (use_spec_constants) {
+      spec_entries.resize(shader.spec_data.size());
+      for (uint32_t i = 0; i < spec_entries.size(); ++i) {
+        spec_entries[i].constantID = i;
+        spec_entries[i].offset = i * sizeof(uint32_t);
+        spec_entries[i].size = sizeof(uint32_t);
+      }
+      spec_info.mapEntryCount = spec_entries.size();
+      spec_info.pMapEntries = spec_entries.data();
+      spec_info.dataSize = shader.spec_data.size() * sizeof(uint32_t);
+      spec_info.pData = shader.spec_data.data();
+    }
+
     VkComputePipelineCreateInfo pipeline_cinfo;
     pipeline_cinfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     pipeline_cinfo.pNext = nullptr;
@@ -1025,7 +1073,7 @@ class VulkanModuleNode final : public runtime::ModuleNode {
     pipeline_cinfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
     pipeline_cinfo.stage.module = pe->shader;
     pipeline_cinfo.stage.pName = func_name.c_str();
-    pipeline_cinfo.stage.pSpecializationInfo = nullptr;
+    pipeline_cinfo.stage.pSpecializationInfo = use_spec_constants ? &spec_info : nullptr;
     pipeline_cinfo.layout = pe->pipeline_layout;
     pipeline_cinfo.basePipelineHandle = VK_NULL_HANDLE;
     pipeline_cinfo.basePipelineIndex = 0;
@@ -1236,13 +1284,49 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
 
   // Otherwise, the more expensive deferred path.
   std::vector<ArgUnion64> pack_args_storage(pack_args, pack_args + num_pack_args_);
-  const auto& deferred_initializer = [&vctx, pipeline, descriptor_buffers]() {
+
+  // Reuse a descriptor set that was already written with these exact buffer
+  // bindings. A cached set skips vkUpdateDescriptorSets and, because each
+  // binding combination gets its own set, the stream token check no longer
+  // forces a flush when one kernel alternates between binding sets.
+  uint64_t binding_key = FNVHash64(0, descriptor_buffers.size());
+  for (const auto& binfo : descriptor_buffers) {
+    binding_key = FNVHash64(binding_key, (uint64_t)(binfo.buffer));
+  }
+  VkDescriptorSet descriptor_set = pipeline->descriptor_set;
+  bool write_descriptor_set = true;
+  {
+    std::lock_guard<std::mutex> lock(pipeline->descriptor_cache_mutex);
+    auto it = pipeline->descriptor_set_cache.find(binding_key);
+    if (it != pipeline->descriptor_set_cache.end()) {
+      descriptor_set = it->second;
+      write_descriptor_set = false;
+    } else if (pipeline->descriptor_set_cache.size() < VulkanPipeline::kMaxCachedDescriptorSets) {
+      VkDescriptorSetAllocateInfo alloc_info;
+      alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      alloc_info.pNext = nullptr;
+      alloc_info.descriptorPool = pipeline->descriptor_pool;
+      alloc_info.descriptorSetCount = 1;
+      alloc_info.pSetLayouts = &(pipeline->descriptor_set_layout);
+      VULKAN_CALL(vkAllocateDescriptorSets(vctx.device, &alloc_info, &descriptor_set));
+      pipeline->descriptor_set_cache.emplace(binding_key, descriptor_set);
+    }
+    // Otherwise fall back to the shared set; the stream token check
+    // synchronizes whenever its bindings change.
+  }
+
+  const auto& deferred_initializer = [&vctx, descriptor_set, write_descriptor_set, pipeline,
+                                      descriptor_buffers]() {
+    if (!write_descriptor_set) {
+      // The cached set already holds these bindings.
+      return;
+    }
     std::vector<VkWriteDescriptorSet> write_descriptor_sets;
     write_descriptor_sets.resize(descriptor_buffers.size());
     for (size_t i = 0; i < write_descriptor_sets.size(); i++) {
       write_descriptor_sets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
       write_descriptor_sets[i].pNext = 0;
-      write_descriptor_sets[i].dstSet = pipeline->descriptor_set;
+      write_descriptor_sets[i].dstSet = descriptor_set;
       write_descriptor_sets[i].dstBinding = i;
       write_descriptor_sets[i].dstArrayElement = 0;
       write_descriptor_sets[i].descriptorCount = 1;
@@ -1260,35 +1344,57 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
     vkUpdateDescriptorSets(vctx.device, write_descriptor_sets.size(), write_descriptor_sets.data(),
                            0, 0);
   };
-  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars,
-                                 device_id](VulkanStreamState* state) {
-    vkCmdBindPipeline(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
-    vkCmdBindDescriptorSets(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            pipeline->pipeline_layout, 0, 1, &(pipeline->descriptor_set), 0,
-                            nullptr);
 
+  // Identical launches replay a pre-recorded secondary command buffer, so a
+  // repeated graph execution only pays for vkCmdExecuteCommands per dispatch.
+  uint64_t launch_key = FNVHash64(binding_key, (uint64_t)(pipeline->pipeline));
+  launch_key = FNVHash64(launch_key, (uint64_t)(descriptor_set));
+  for (size_t i = 0; i < 3; ++i) {
+    launch_key = FNVHash64(launch_key, wl.grid_dim(i));
+  }
+  for (const ArgUnion64& arg : pack_args_storage) {
+    launch_key = FNVHash64(launch_key, arg.v_uint64);
+  }
+
+  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars, device_id,
+                                 descriptor_set, launch_key](VulkanStreamState* state) {
     if (pipeline->use_ubo) {
       auto ubo = VulkanThreadEntry::ThreadLocal()->GetUniformBuffer(device_id, nbytes_scalars);
       memcpy(ubo->host_addr, pack_args_storage.data(), nbytes_scalars);
-    } else if (num_pack_args_ > 0) {
-      vkCmdPushConstants(state->cmd_buffer_, pipeline->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT,
-                         0, pack_args_storage.size() * sizeof(ArgUnion64),
-                         pack_args_storage.data());
     }
+    const auto& record = [&](VkCommandBuffer cmd_buffer) {
+      vkCmdBindPipeline(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
+      vkCmdBindDescriptorSets(cmd_buffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                              pipeline->pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
+
+      if (!pipeline->use_ubo && num_pack_args_ > 0) {
+        vkCmdPushConstants(cmd_buffer, pipeline->pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           pack_args_storage.size() * sizeof(ArgUnion64),
+                           pack_args_storage.data());
+      }
 
-    vkCmdDispatch(state->cmd_buffer_, wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
-    VkMemoryBarrier barrier_info;
-    barrier_info.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-    barrier_info.pNext = nullptr;
-    barrier_info.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-    barrier_info.dstAccessMask = (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
-                                  VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
-    vkCmdPipelineBarrier(state->cmd_buffer_, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
-                         1, &barrier_info, 0, nullptr, 0, nullptr);
+      vkCmdDispatch(cmd_buffer, wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
+      VkMemoryBarrier barrier_info;
+      barrier_info.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+      barrier_info.pNext = nullptr;
+      barrier_info.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+      barrier_info.dstAccessMask = (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+      vkCmdPipelineBarrier(cmd_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           0, 1, &barrier_info, 0, nullptr, 0, nullptr);
+    };
+    VulkanStream* stream = VulkanThreadEntry::ThreadLocal()->Stream(device_id);
+    VkCommandBuffer secondary = stream->GetOrRecordSecondary(launch_key, record);
+    if (secondary != VK_NULL_HANDLE) {
+      vkCmdExecuteCommands(state->cmd_buffer_, 1, &secondary);
+    } else {
+      record(state->cmd_buffer_);
+    }
   };
+
   VulkanStreamToken deferred_token;
-  deferred_token.descriptor_set_ = pipeline->descriptor_set;
+  deferred_token.descriptor_set_ = descriptor_set;
   deferred_token.buffers_.resize(descriptor_buffers.size());
   for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
     deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
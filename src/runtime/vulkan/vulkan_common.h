@@ -37,9 +37,6 @@ namespace vulkan {
 
 const int kMaxPushConstantsBytes = 128;
 
-/*! \brief A mask used when we attach additional information to shaders */
-enum ShaderMetaDataFlagMask { kUseUBO = 0 };
-
 inline const char* VKGetErrorString(VkResult error) {
   switch (error) {
     case VK_SUCCESS:
@@ -31,19 +31,35 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+/*! \brief A mask used when we attach additional information to shaders */
+enum ShaderMetaDataFlagMask { kUseUBO = 0, kUseSpecConstants = 1 };
+
 struct VulkanShader {
   /*! \brief header flag */
   uint32_t flag{0};
   /*! \brief Data segment */
   std::vector<uint32_t> data;
+  /*!
+   * \brief Values for SpecId-decorated constants, indexed by constant id.
+   *
+   * Only serialized when kUseSpecConstants is set in flag, so binaries
+   * produced before specialization support still load.
+   */
+  std::vector<uint32_t> spec_data;
 
   void Save(dmlc::Stream* writer) const {
     writer->Write(flag);
     writer->Write(data);
+    if (flag & (1 << ShaderMetaDataFlagMask::kUseSpecConstants)) {
+      writer->Write(spec_data);
+    }
   }
   bool Load(dmlc::Stream* reader) {
     if (!reader->Read(&flag)) return false;
     if (!reader->Read(&data)) return false;
+    if (flag & (1 << ShaderMetaDataFlagMask::kUseSpecConstants)) {
+      if (!reader->Read(&spec_data)) return false;
+    }
     return true;
   }
 };
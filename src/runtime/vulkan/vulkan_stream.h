@@ -124,6 +124,57 @@ class VulkanStream {
     deferred_tokens_[deferred_token.descriptor_set_].push_back(deferred_token);
   }
 
+  /*!
+   * \brief Get a secondary command buffer pre-recorded for a launch signature.
+   *
+   * Repeated graph executions replay the recording through
+   * vkCmdExecuteCommands instead of re-recording every dispatch. On the
+   * first request for \p key the buffer is recorded by \p record; returns
+   * VK_NULL_HANDLE once the cache is full, in which case the caller should
+   * record into the primary buffer directly.
+   */
+  VkCommandBuffer GetOrRecordSecondary(uint64_t key,
+                                       const std::function<void(VkCommandBuffer)>& record) {
+    auto it = secondary_cache_.find(key);
+    if (it != secondary_cache_.end()) {
+      return it->second;
+    }
+    // Entries cannot be evicted here: they may still be referenced by the
+    // primary buffer under recording. The pool frees them on destruction.
+    if (secondary_cache_.size() >= kMaxSecondaryBuffers) {
+      return VK_NULL_HANDLE;
+    }
+    VkCommandBufferAllocateInfo buffer_alloc_info;
+    buffer_alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    buffer_alloc_info.pNext = nullptr;
+    buffer_alloc_info.commandPool = cmd_pool_;
+    buffer_alloc_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    buffer_alloc_info.commandBufferCount = 1;
+    VkCommandBuffer secondary;
+    VULKAN_CALL(vkAllocateCommandBuffers(vctx_->device, &buffer_alloc_info, &secondary));
+
+    VkCommandBufferInheritanceInfo inheritance;
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.pNext = nullptr;
+    inheritance.renderPass = VK_NULL_HANDLE;
+    inheritance.subpass = 0;
+    inheritance.framebuffer = VK_NULL_HANDLE;
+    inheritance.occlusionQueryEnable = VK_FALSE;
+    inheritance.queryFlags = 0;
+    inheritance.pipelineStatistics = 0;
+
+    VkCommandBufferBeginInfo cb_begin;
+    cb_begin.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cb_begin.pNext = nullptr;
+    cb_begin.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    cb_begin.pInheritanceInfo = &inheritance;
+    VULKAN_CALL(vkBeginCommandBuffer(secondary, &cb_begin));
+    record(secondary);
+    VULKAN_CALL(vkEndCommandBuffer(secondary));
+    secondary_cache_.emplace(key, secondary);
+    return secondary;
+  }
+
   // Synchronize the current stream `state_` with respect to the host.
   void Synchronize() {
     if (!vctx_->UseImmediate()) {
@@ -174,12 +225,17 @@ class VulkanStream {
   }
 
  private:
+  /*! \brief Maximal number of cached secondary command buffers. */
+  static constexpr size_t kMaxSecondaryBuffers = 256;
+
   const VulkanContext* vctx_;
   std::unique_ptr<VulkanStreamState> state_;
   // An index of deferred tokens, allowing us to efficiently detect duplicated
   // deferred_initializer blocks.
   std::unordered_map<VkDescriptorSet, std::vector<VulkanStreamToken>> deferred_tokens_;
   std::vector<std::function<void(VulkanStreamState*)>> deferred_kernels_;
+  // Pre-recorded secondary command buffers keyed by launch signature.
+  std::unordered_map<uint64_t, VkCommandBuffer> secondary_cache_;
   VkCommandPool cmd_pool_;
 };
 
@@ -23,7 +23,14 @@
  */
 #include "workspace_pool.h"
 
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <unordered_set>
 
 namespace tvm {
 namespace runtime {
@@ -31,6 +38,25 @@ namespace runtime {
 // page size.
 constexpr size_t kWorkspacePageSize = 4 << 10;
 
+namespace {
+
+// Thread-local tag attributing workspace allocations to the operator that the
+// thread is currently executing.
+thread_local const char* workspace_attribution_tag = nullptr;
+
+// Optional cap, in bytes, on the memory a single device's workspace pool may
+// reserve; exceeding it aborts with the pool report instead of letting the
+// pool grow until the device OOMs.
+size_t WorkspacePoolCapBytes() {
+  static const size_t cap = []() -> size_t {
+    const char* env = std::getenv("TVM_WORKSPACE_POOL_CAP_BYTES");
+    return env == nullptr ? 0 : static_cast<size_t>(atoll(env));
+  }();
+  return cap;
+}
+
+}  // namespace
+
 class WorkspacePool::Pool {
  public:
   // constructor
@@ -39,6 +65,7 @@ class WorkspacePool::Pool {
     Entry e;
     e.data = nullptr;
     e.size = 0;
+    e.tag = nullptr;
     free_list_.push_back(e);
     allocated_.push_back(e);
   }
@@ -58,10 +85,12 @@ class WorkspacePool::Pool {
       if (e.size < nbytes) {
         // resize the page
         device->FreeDataSpace(dev, e.data);
+        ReserveOrFail(dev, nbytes, e.size);
         e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
         e.size = nbytes;
       }
     } else if (free_list_.size() == 1) {
+      ReserveOrFail(dev, nbytes, 0);
       e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
       e.size = nbytes;
     } else {
@@ -77,10 +106,20 @@ class WorkspacePool::Pool {
         e = free_list_.back();
         free_list_.pop_back();
         device->FreeDataSpace(dev, e.data);
+        ReserveOrFail(dev, nbytes, e.size);
         e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
         e.size = nbytes;
       }
     }
+    const char* tag = workspace_attribution_tag;
+    TagStat& stat = tag_stats_[(tag != nullptr && tag[0] != '\0') ? tag : "(untagged)"];
+    stat.bytes_in_use += e.size;
+    stat.high_water = std::max(stat.high_water, stat.bytes_in_use);
+    ++stat.alloc_count;
+    e.tag = &stat;
+    bytes_in_use_ += e.size;
+    high_water_ = std::max(high_water_, bytes_in_use_);
+    ++alloc_count_;
     allocated_.push_back(e);
     return e.data;
   }
@@ -99,6 +138,10 @@ class WorkspacePool::Pool {
       e = allocated_[index];
       allocated_.erase(allocated_.begin() + index);
     }
+    bytes_in_use_ -= e.size;
+    if (e.tag != nullptr) {
+      e.tag->bytes_in_use -= e.size;
+    }
     if (free_list_.back().size < e.size) {
       free_list_.push_back(e);
     } else if (free_list_.size() == 2) {
@@ -119,24 +162,112 @@ class WorkspacePool::Pool {
       device->FreeDataSpace(dev, free_list_[i].data);
     }
     free_list_.clear();
+    bytes_reserved_ = 0;
+  }
+  // Accumulate counters under the given key prefix.
+  void CollectReport(const std::string& prefix,
+                     std::unordered_map<std::string, size_t>* report) const {
+    (*report)[prefix + ".bytes_reserved"] += bytes_reserved_;
+    (*report)[prefix + ".bytes_in_use"] += bytes_in_use_;
+    (*report)[prefix + ".high_water_bytes"] += high_water_;
+    (*report)[prefix + ".alloc_count"] += alloc_count_;
+    for (const auto& kv : tag_stats_) {
+      (*report)[prefix + ".tag." + kv.first + ".high_water_bytes"] += kv.second.high_water;
+      (*report)[prefix + ".tag." + kv.first + ".alloc_count"] += kv.second.alloc_count;
+    }
   }
 
  private:
+  /*! \brief Counters for allocations carrying the same attribution tag. */
+  struct TagStat {
+    size_t bytes_in_use{0};
+    size_t high_water{0};
+    size_t alloc_count{0};
+  };
   /*! \brief a single entry in the pool */
   struct Entry {
     void* data;
     size_t size;
+    /*! \brief The tag counters this entry is charged to; meaningful in allocated_ only. */
+    TagStat* tag;
   };
+  // Account an upcoming device allocation, aborting when it would push the
+  // pool past the configured cap.
+  void ReserveOrFail(Device dev, size_t incoming, size_t outgoing) {
+    size_t next = bytes_reserved_ + incoming - outgoing;
+    size_t cap = WorkspacePoolCapBytes();
+    if (cap != 0 && next > cap) {
+      std::unordered_map<std::string, size_t> report;
+      CollectReport(std::string(DeviceName(dev.device_type)), &report);
+      std::ostringstream os;
+      for (const auto& kv : report) {
+        os << "\n  " << kv.first << " = " << kv.second;
+      }
+      LOG(FATAL) << "Workspace pool on " << DeviceName(dev.device_type) << "("
+                 << dev.device_id << ") would grow to " << next << " bytes, "
+                 << "exceeding TVM_WORKSPACE_POOL_CAP_BYTES=" << cap << "." << os.str();
+    }
+    bytes_reserved_ = next;
+  }
   /*! \brief List of free items, sorted from small to big size */
   std::vector<Entry> free_list_;
   /*! \brief List of allocated items */
   std::vector<Entry> allocated_;
+  /*! \brief Counters keyed by attribution tag. */
+  std::unordered_map<std::string, TagStat> tag_stats_;
+  /*! \brief Bytes handed out to callers right now. */
+  size_t bytes_in_use_{0};
+  /*! \brief Largest bytes_in_use_ seen so far. */
+  size_t high_water_{0};
+  /*! \brief Bytes of device memory held by the pool, free or in use. */
+  size_t bytes_reserved_{0};
+  /*! \brief Number of workspace allocations served. */
+  size_t alloc_count_{0};
+};
+
+namespace {
+
+// Tracks the live workspace pools so the report can walk pools owned by other
+// threads' device APIs. Leaked on purpose: thread-local pools may be torn
+// down during process exit after function-local statics are destroyed.
+class WorkspacePoolRegistry {
+ public:
+  static WorkspacePoolRegistry* Global() {
+    static WorkspacePoolRegistry* inst = new WorkspacePoolRegistry();
+    return inst;
+  }
+  void Register(WorkspacePool* pool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.insert(pool);
+  }
+  void Unregister(WorkspacePool* pool) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pools_.erase(pool);
+  }
+  std::unordered_map<std::string, size_t> Report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unordered_map<std::string, size_t> report;
+    for (WorkspacePool* pool : pools_) {
+      pool->CollectReport(&report);
+    }
+    return report;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_set<WorkspacePool*> pools_;
 };
 
+}  // namespace
+
 WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
-    : device_type_(device_type), device_(device) {}
+    : device_type_(device_type), device_(device) {
+  WorkspacePoolRegistry::Global()->Register(this);
+}
 
 WorkspacePool::~WorkspacePool() {
+  WorkspacePoolRegistry::Global()->Unregister(this);
+  std::lock_guard<std::mutex> lock(mutex_);
   for (size_t i = 0; i < array_.size(); ++i) {
     if (array_[i] != nullptr) {
       Device dev;
@@ -149,6 +280,7 @@ WorkspacePool::~WorkspacePool() {
 }
 
 void* WorkspacePool::AllocWorkspace(Device dev, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (static_cast<size_t>(dev.device_id) >= array_.size()) {
     array_.resize(dev.device_id + 1, nullptr);
   }
@@ -159,9 +291,35 @@ void* WorkspacePool::AllocWorkspace(Device dev, size_t size) {
 }
 
 void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
+  std::lock_guard<std::mutex> lock(mutex_);
   ICHECK(static_cast<size_t>(dev.device_id) < array_.size() && array_[dev.device_id] != nullptr);
   array_[dev.device_id]->Free(ptr);
 }
 
+const char* WorkspacePool::SetAttributionTag(const char* tag) {
+  const char* prev = workspace_attribution_tag;
+  workspace_attribution_tag = tag;
+  return prev;
+}
+
+void WorkspacePool::CollectReport(std::unordered_map<std::string, size_t>* report) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < array_.size(); ++i) {
+    if (array_[i] != nullptr) {
+      std::ostringstream prefix;
+      prefix << DeviceName(device_type_) << ".dev" << i;
+      array_[i]->CollectReport(prefix.str(), report);
+    }
+  }
+}
+
+TVM_REGISTER_GLOBAL("runtime.WorkspacePoolReport").set_body([](TVMArgs args, TVMRetValue* rv) {
+  Map<String, ObjectRef> report;
+  for (const auto& kv : WorkspacePoolRegistry::Global()->Report()) {
+    report.Set(kv.first, ObjectRef(make_object<profiling::CountNode>(kv.second)));
+  }
+  *rv = report;
+});
+
 }  // namespace runtime
 }  // namespace tvm
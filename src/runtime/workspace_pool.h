@@ -27,6 +27,9 @@
 #include <tvm/runtime/device_api.h>
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace tvm {
@@ -65,6 +68,26 @@ class TVM_DLL WorkspacePool {
    * \param ptr The pointer to be freed.
    */
   void FreeWorkspace(Device dev, void* ptr);
+  /*!
+   * \brief Set the tag used to attribute subsequent workspace allocations.
+   *
+   * The tag applies to the calling thread and typically names the operator
+   * about to run, so the report can attribute high-water marks per op. The
+   * pointed-to string must stay alive until the tag is replaced.
+   *
+   * \param tag The new tag, or nullptr to clear it.
+   * \return The previously installed tag, so callers can restore it.
+   */
+  static const char* SetAttributionTag(const char* tag);
+  /*!
+   * \brief Accumulate this pool's counters into \p report.
+   *
+   * Keys take the form "<device>.devN.<counter>"; values from pools that
+   * share a prefix, such as per-thread CPU pools, are summed.
+   *
+   * \param report The report to accumulate into.
+   */
+  void CollectReport(std::unordered_map<std::string, size_t>* report) const;
 
  private:
   class Pool;
@@ -74,6 +97,8 @@ class TVM_DLL WorkspacePool {
   DLDeviceType device_type_;
   /*! \brief The device API */
   DeviceAPI* device_;
+  /*! \brief Protects array_ and the per-device pools against the report reader. */
+  mutable std::mutex mutex_;
 };
 
 }  // namespace runtime
@@ -0,0 +1,150 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file arena_map.h
+ * \brief Open-addressing hash map with pointer keys whose storage
+ *  is drawn from an Arena.
+ */
+#ifndef TVM_SUPPORT_ARENA_MAP_H_
+#define TVM_SUPPORT_ARENA_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "arena.h"
+
+namespace tvm {
+namespace support {
+
+/*!
+ * \brief Hash map from pointer keys to trivially destructible values.
+ *
+ *  The slot array is allocated from an Arena, so the map performs no
+ *  individual heap allocations and needs no destructor: everything is
+ *  reclaimed when the arena is recycled. This makes it suitable as a
+ *  memo table inside passes that already carry an arena, where an
+ *  unordered_map would allocate one node per entry.
+ *
+ *  Collisions are resolved by linear probing and the table grows by
+ *  doubling. Old slot arrays are not returned to the arena; they are
+ *  dead weight until the arena itself is freed, which is acceptable for
+ *  the short-lived per-pass arenas this is designed for.
+ *
+ * \tparam V the value type, which must be trivially destructible since
+ *  the arena never runs destructors.
+ */
+template <typename V>
+class ArenaPointerMap {
+ public:
+  static_assert(std::is_trivially_destructible<V>::value,
+                "ArenaPointerMap values live in arena memory and are never destructed");
+
+  /*!
+   * \brief Construct the map.
+   * \param arena The arena all slot storage is allocated from. Must
+   *  outlive the map.
+   */
+  explicit ArenaPointerMap(Arena* arena) : arena_(arena) {}
+
+  /*!
+   * \brief Look up the value stored under key.
+   * \param key The pointer key, must not be nullptr.
+   * \return A pointer to the stored value, or nullptr if absent.
+   *  Invalidated by the next Set.
+   */
+  V* Find(const void* key) {
+    if (size_ == 0) return nullptr;
+    for (size_t i = Hash(key);; i = (i + 1) & mask_) {
+      if (slots_[i].key == key) return &slots_[i].value;
+      if (slots_[i].key == nullptr) return nullptr;
+    }
+  }
+
+  /*!
+   * \brief Insert a value under key, overwriting any previous entry.
+   * \param key The pointer key, must not be nullptr.
+   * \param value The value to store.
+   */
+  void Set(const void* key, const V& value) {
+    if (slots_ == nullptr || size_ * 4 >= (mask_ + 1) * 3) {
+      Grow();
+    }
+    for (size_t i = Hash(key);; i = (i + 1) & mask_) {
+      if (slots_[i].key == key) {
+        slots_[i].value = value;
+        return;
+      }
+      if (slots_[i].key == nullptr) {
+        slots_[i].key = key;
+        slots_[i].value = value;
+        ++size_;
+        return;
+      }
+    }
+  }
+
+  /*! \return the number of entries in the map. */
+  size_t size() const { return size_; }
+
+ private:
+  struct Slot {
+    const void* key;
+    V value;
+  };
+
+  size_t Hash(const void* key) const {
+    // drop the alignment bits, then scatter with a Fibonacci multiplier.
+    uintptr_t h = reinterpret_cast<uintptr_t>(key) >> 3;
+    return static_cast<size_t>(h * 0x9E3779B97F4A7C15ULL) & mask_;
+  }
+
+  void Grow() {
+    Slot* old_slots = slots_;
+    size_t old_cap = slots_ ? mask_ + 1 : 0;
+    size_t new_cap = old_cap == 0 ? kInitSlots : old_cap * 2;
+    slots_ = arena_->template allocate_<Slot>(static_cast<int>(new_cap));
+    for (size_t i = 0; i < new_cap; ++i) {
+      slots_[i].key = nullptr;
+    }
+    mask_ = new_cap - 1;
+    for (size_t i = 0; i < old_cap; ++i) {
+      if (old_slots[i].key != nullptr) {
+        for (size_t j = Hash(old_slots[i].key);; j = (j + 1) & mask_) {
+          if (slots_[j].key == nullptr) {
+            slots_[j] = old_slots[i];
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  static constexpr size_t kInitSlots = 64;
+
+  Arena* arena_;
+  Slot* slots_{nullptr};
+  size_t mask_{0};
+  size_t size_{0};
+};
+
+}  // namespace support
+}  // namespace tvm
+#endif  // TVM_SUPPORT_ARENA_MAP_H_
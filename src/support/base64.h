@@ -30,8 +30,13 @@
 
 #include <cctype>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace tvm {
 namespace support {
 /*! \brief namespace of base64 decoding and encoding table */
@@ -85,6 +90,15 @@ class StreamBufferReader {
   }
   /*! \return whether we are reaching the end of file */
   bool AtEnd() const { return read_len_ == 0; }
+  /*! \return pointer to the unread bytes currently buffered */
+  const char* Ptr() const { return buffer_.data() + read_ptr_; }
+  /*! \return number of unread bytes currently buffered */
+  size_t Avail() const { return read_ptr_ < read_len_ ? read_len_ - read_ptr_ : 0; }
+  /*!
+   * \brief Consume `n` buffered bytes without copying them out.
+   * \param n The number of bytes, at most Avail().
+   */
+  void Advance(size_t n) { read_ptr_ += n; }
 
  private:
   /*! \brief the underlying stream */
@@ -145,6 +159,41 @@ class Base64InStream : public dmlc::Stream {
       }
     }
     if (tlen == 0) return size;
+#if defined(__SSSE3__)
+    // Bulk path: decode 16 characters (the looked-ahead temp_ch_ plus 15
+    // buffered bytes) into 12 output bytes per step. Padding, whitespace or
+    // an invalid byte fails the in-register validation before anything is
+    // consumed and falls through to the scalar paths below.
+    while (tlen >= 12 && temp_ch_ != EOF && reader_.Avail() >= 15) {
+      unsigned char block[16];
+      block[0] = static_cast<unsigned char>(temp_ch_);
+      std::memcpy(block + 1, reader_.Ptr(), 15);
+      if (!DecodeBlock16(block, cptr)) break;
+      cptr += 12;
+      tlen -= 12;
+      reader_.Advance(15);
+      temp_ch_ = reader_.GetChar();
+    }
+#endif
+    // Decode whole 4-character groups straight out of the read buffer,
+    // avoiding the per-character stream call and whitespace test of the tail
+    // loop below. Stops at padding, whitespace and buffer boundaries.
+    while (tlen >= 3 && reader_.Avail() >= 3 && temp_ch_ != EOF && !isspace(temp_ch_) &&
+           temp_ch_ != '=') {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(reader_.Ptr());
+      if (p[0] == '=' || p[1] == '=' || p[2] == '=' || isspace(p[0]) || isspace(p[1]) ||
+          isspace(p[2])) {
+        break;
+      }
+      int group = (DecodeTable[temp_ch_] << 18) | (DecodeTable[p[0]] << 12) |
+                  (DecodeTable[p[1]] << 6) | DecodeTable[p[2]];
+      *cptr++ = (group >> 16) & 0xFF;
+      *cptr++ = (group >> 8) & 0xFF;
+      *cptr++ = group & 0xFF;
+      tlen -= 3;
+      reader_.Advance(3);
+      temp_ch_ = reader_.GetChar();
+    }
     int nvalue;
     // note: everything goes with 4 bytes in Base64
     // so we process 4 bytes a unit
@@ -209,6 +258,50 @@ class Base64InStream : public dmlc::Stream {
   }
 
  private:
+#if defined(__SSSE3__)
+  /*!
+   * \brief Decode 16 base64 characters into 12 bytes using SSSE3 shuffles.
+   * \param src The 16 input characters.
+   * \param dst Output, receives the 12 decoded bytes on success.
+   * \return Whether all 16 characters belong to the base64 alphabet; padding,
+   *   whitespace and invalid bytes return false without writing anything.
+   */
+  static bool DecodeBlock16(const unsigned char* src, unsigned char* dst) {
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    // Classify each byte by its nibbles: a byte is in the alphabet iff the
+    // bitsets selected by its low and high nibble do not intersect.
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i mask_0f = _mm_set1_epi8(0x0F);
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), mask_0f);
+    const __m128i lo_nibbles = _mm_and_si128(input, mask_0f);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    const __m128i invalid = _mm_and_si128(lo, hi);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) {
+      return false;
+    }
+    // Translate characters to their 6-bit values by adding a per-range offset
+    // picked from the high nibble ('/' needs its own entry).
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+                                           0);
+    const __m128i eq_2f = _mm_cmpeq_epi8(input, _mm_set1_epi8(0x2F));
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    const __m128i values = _mm_add_epi8(input, roll);
+    // Pack the four 6-bit values in each 32-bit lane into three bytes, then
+    // gather the twelve payload bytes to the front of the register.
+    const __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    const __m128i shuffled = _mm_shuffle_epi8(
+        packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    unsigned char tmp[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(tmp), shuffled);
+    std::memcpy(dst, tmp, 12);
+    return true;
+  }
+#endif
   // internal reader
   StreamBufferReader reader_;
   int temp_ch_{0};
@@ -24,6 +24,7 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
 #include <future>
 #include <thread>
 #include <utility>
@@ -93,5 +94,38 @@ void parallel_for(int begin, int end, const std::function<void(int)>& f, int ste
   }
 }
 
+void parallel_for_dynamic(int begin, int end, int num_threads,
+                          const std::function<void(int thread_id, int task_id)>& f) {
+  // Step 1. Sanity checks
+  if (begin == end) {
+    return;
+  }
+  ICHECK_LE(begin, end) << "Invalid range with begin: " << begin << " end: " << end;
+  ICHECK_GT(num_threads, 0) << "Invalid number of threads: " << num_threads;
+  // Step 2. Launch (num_threads - 1) worker threads; the main thread works too.
+  std::atomic<int> counter{begin};
+  auto worker = [end, &counter, &f](int thread_id) {
+    for (int task_id; (task_id = counter.fetch_add(1)) < end;) {
+      f(thread_id, task_id);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
+    threads.emplace_back(worker, thread_id);
+  }
+  try {
+    worker(0);
+  } catch (const std::exception& e) {
+    for (auto&& thread : threads) {
+      thread.join();
+    }
+    LOG(FATAL) << "Parallel_for_dynamic error with " << e.what();
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+}
+
 }  // namespace support
 }  // namespace tvm
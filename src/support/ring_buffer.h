@@ -115,14 +115,87 @@ class RingBuffer {
     ICHECK_NE(size, 0U);
     size_t ncopy = std::min(size, ring_.size() - head_ptr_);
     size_t nsend = fsend(&ring_[0] + head_ptr_, ncopy);
+    head_ptr_ = (head_ptr_ + nsend) % ring_.size();
     bytes_available_ -= nsend;
     if (ncopy == nsend && ncopy < size) {
       size_t nsend2 = fsend(&ring_[0], size - ncopy);
+      head_ptr_ = (head_ptr_ + nsend2) % ring_.size();
       bytes_available_ -= nsend2;
       nsend += nsend2;
     }
     return nsend;
   }
+  /*! \brief A contiguous region of the ring exposed by the zero-copy API. */
+  struct Segment {
+    /*! \brief Pointer to the start of the region. */
+    void* data;
+    /*! \brief Number of bytes in the region. */
+    size_t size;
+  };
+  /*!
+   * \brief Expose the readable bytes as contiguous segments without copying.
+   *
+   *  At most two segments are produced, the second one when the data wraps
+   *  around the end of the ring. The caller consumes the bytes in place,
+   *  e.g. through a gather-send system call, then calls CommitRead with the
+   *  number of bytes actually consumed.
+   * \param segs Output array that can hold at least two segments.
+   * \param max_nbytes Maximum number of bytes to expose.
+   * \return The number of segments filled.
+   */
+  int ReadSegments(Segment* segs, size_t max_nbytes) {
+    size_t size = std::min(max_nbytes, bytes_available_);
+    if (size == 0) return 0;
+    size_t ncopy = std::min(size, ring_.size() - head_ptr_);
+    segs[0] = Segment{&ring_[0] + head_ptr_, ncopy};
+    if (ncopy < size) {
+      segs[1] = Segment{&ring_[0], size - ncopy};
+      return 2;
+    }
+    return 1;
+  }
+  /*!
+   * \brief Discard bytes previously exposed by ReadSegments.
+   * \param nbytes The number of bytes the caller consumed.
+   */
+  void CommitRead(size_t nbytes) {
+    ICHECK_GE(bytes_available_, nbytes);
+    head_ptr_ = (head_ptr_ + nbytes) % ring_.size();
+    bytes_available_ -= nbytes;
+  }
+  /*!
+   * \brief Reserve writable space and expose it as contiguous segments
+   *  without copying.
+   *
+   *  At most two segments are produced, the second one when the free space
+   *  wraps around the end of the ring. The caller produces bytes in place,
+   *  e.g. through a scatter-receive system call, then calls CommitWrite with
+   *  the number of bytes actually produced.
+   * \param segs Output array that can hold at least two segments.
+   * \param max_nbytes Maximum number of bytes to expose.
+   * \return The number of segments filled.
+   */
+  int WriteSegments(Segment* segs, size_t max_nbytes) {
+    ICHECK_NE(max_nbytes, 0U);
+    this->Reserve(bytes_available_ + max_nbytes);
+    size_t tail = head_ptr_ + bytes_available_;
+    if (tail >= ring_.size()) {
+      segs[0] = Segment{&ring_[0] + (tail - ring_.size()), max_nbytes};
+      return 1;
+    }
+    size_t ncopy = std::min(ring_.size() - tail, max_nbytes);
+    segs[0] = Segment{&ring_[0] + tail, ncopy};
+    if (ncopy < max_nbytes) {
+      segs[1] = Segment{&ring_[0], max_nbytes - ncopy};
+      return 2;
+    }
+    return 1;
+  }
+  /*!
+   * \brief Mark bytes previously exposed by WriteSegments as written.
+   * \param nbytes The number of bytes the caller produced.
+   */
+  void CommitWrite(size_t nbytes) { bytes_available_ += nbytes; }
   /*!
    * \brief Write data into buffer, always ensures all data is written.
    * \param data The data pointer
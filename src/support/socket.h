@@ -47,6 +47,7 @@ using ssize_t = int;
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif
 #include <tvm/runtime/logging.h>
@@ -515,6 +516,75 @@ class TCPSocket : public Socket {
     return RetryCallOnEINTR(
         [&]() { return recv(sockfd, buf, static_cast<sock_size_t>(len), flags); });
   }
+  /*! \brief Maximum number of segments per scatter/gather call. */
+  static const int kMaxIOSegments = 8;
+  /*! \brief A buffer segment for scatter/gather I/O. */
+  struct IOSegment {
+    /*! \brief Pointer to the segment data. */
+    void* data;
+    /*! \brief Number of bytes in the segment. */
+    size_t size;
+  };
+  /*!
+   * \brief Gather data from multiple segments into one send system call.
+   * \param segs The segments to send, in order.
+   * \param nsegs The number of segments, at most kMaxIOSegments.
+   * \return size of data actually sent
+   *         return -1 if error occurs
+   */
+  ssize_t SendV(const IOSegment* segs, int nsegs) {
+    ICHECK_LE(nsegs, kMaxIOSegments);
+#if defined(_WIN32)
+    WSABUF bufs[kMaxIOSegments];
+    for (int i = 0; i < nsegs; ++i) {
+      bufs[i].buf = reinterpret_cast<CHAR*>(segs[i].data);
+      bufs[i].len = static_cast<ULONG>(segs[i].size);
+    }
+    DWORD nsent = 0;
+    if (WSASend(sockfd, bufs, static_cast<DWORD>(nsegs), &nsent, 0, nullptr, nullptr) != 0) {
+      return -1;
+    }
+    return static_cast<ssize_t>(nsent);
+#else
+    iovec iov[kMaxIOSegments];
+    for (int i = 0; i < nsegs; ++i) {
+      iov[i].iov_base = segs[i].data;
+      iov[i].iov_len = segs[i].size;
+    }
+    return RetryCallOnEINTR([&]() { return writev(sockfd, iov, nsegs); });
+#endif
+  }
+  /*!
+   * \brief Scatter received data across multiple segments with one recv
+   *        system call.
+   * \param segs The segments to fill, in order.
+   * \param nsegs The number of segments, at most kMaxIOSegments.
+   * \return size of data actually received
+   *         return -1 if error occurs
+   */
+  ssize_t RecvV(const IOSegment* segs, int nsegs) {
+    ICHECK_LE(nsegs, kMaxIOSegments);
+#if defined(_WIN32)
+    WSABUF bufs[kMaxIOSegments];
+    for (int i = 0; i < nsegs; ++i) {
+      bufs[i].buf = reinterpret_cast<CHAR*>(segs[i].data);
+      bufs[i].len = static_cast<ULONG>(segs[i].size);
+    }
+    DWORD nrecv = 0;
+    DWORD flags = 0;
+    if (WSARecv(sockfd, bufs, static_cast<DWORD>(nsegs), &nrecv, &flags, nullptr, nullptr) != 0) {
+      return -1;
+    }
+    return static_cast<ssize_t>(nrecv);
+#else
+    iovec iov[kMaxIOSegments];
+    for (int i = 0; i < nsegs; ++i) {
+      iov[i].iov_base = segs[i].data;
+      iov[i].iov_len = segs[i].size;
+    }
+    return RetryCallOnEINTR([&]() { return readv(sockfd, iov, nsegs); });
+#endif
+  }
   /*!
    * \brief peform block write that will attempt to send all data out
    *    can still return smaller than request when error occurs
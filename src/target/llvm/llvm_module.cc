@@ -0,0 +1,730 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file llvm_module.cc
+ * \brief LLVM runtime module for TVM
+ */
+#ifdef TVM_LLVM_VERSION
+
+#include <tvm/ir/module.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/codegen.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "../../runtime/file_utils.h"
+#include "../../runtime/library_module.h"
+#include "../../support/utils.h"
+#include "../func_registry_generator.h"
+#include "codegen_blob.h"
+#include "codegen_cpu.h"
+#include "codegen_llvm.h"
+#include "llvm_common.h"
+
+namespace tvm {
+namespace codegen {
+
+using runtime::PackedFunc;
+using runtime::TVMArgs;
+using runtime::TVMRetValue;
+
+class LLVMModuleNode final : public runtime::ModuleNode {
+ public:
+  ~LLVMModuleNode() {
+    module_.reset();
+#if TVM_LLVM_VERSION >= 110
+    if (orc_jit_ != nullptr) {
+      if (auto err = orc_jit_->deinitialize(orc_jit_->getMainJITDylib())) {
+        llvm::consumeError(std::move(err));
+      }
+    }
+#endif
+    if (ee_ != nullptr) {
+      ee_->runStaticConstructorsDestructors(true);
+      delete ee_;
+    }
+  }
+
+  const char* type_key() const { return "llvm"; }
+
+  PackedFunc GetFunction(const std::string& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "__tvm_is_system_module") {
+      bool flag = (mptr_->getFunction("__tvm_module_startup") != nullptr);
+      return PackedFunc([flag](TVMArgs args, TVMRetValue* rv) { *rv = flag; });
+    } else if (name == "get_func_names") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->function_names_; });
+    } else if (name == "get_symbol") {
+      return PackedFunc(nullptr);
+    } else if (name == "get_const_vars") {
+      return PackedFunc(nullptr);
+    } else if (name == "_get_target_triple") {
+      std::string target_triple = tm_->getTargetTriple().str();
+      // getTargetTriple() doesn't include other flags besides the triple. Add back flags which are
+      // important for ModulePackImportsToLLVM.
+      if (tm_->Options.FloatABIType == llvm::FloatABI::ABIType::Soft) {
+        target_triple += " -mfloat-abi=soft";
+      }
+      return PackedFunc([target_triple](TVMArgs args, TVMRetValue* rv) { *rv = target_triple; });
+    }
+#if TVM_LLVM_VERSION >= 110
+    if (UseORCJIT()) {
+      if (orc_jit_ == nullptr) LazyInitORCJIT();
+    } else {
+      if (ee_ == nullptr) LazyInitJIT();
+    }
+#else
+    if (ee_ == nullptr) LazyInitJIT();
+#endif
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    TVMBackendPackedCFunc faddr;
+    if (name == runtime::symbol::tvm_module_main) {
+      const char* entry_name =
+          reinterpret_cast<const char*>(GetGlobalAddr(runtime::symbol::tvm_module_main));
+      ICHECK(entry_name != nullptr)
+          << "Symbol " << runtime::symbol::tvm_module_main << " is not presented";
+      faddr = reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(entry_name));
+    } else {
+      faddr = reinterpret_cast<TVMBackendPackedCFunc>(GetFunctionAddr(name));
+    }
+    if (faddr == nullptr) return PackedFunc();
+    return WrapPackedFunc(faddr, sptr_to_self);
+  }
+
+  void SaveToFile(const std::string& file_name, const std::string& format) final {
+    std::string fmt = runtime::GetFileFormat(file_name, format);
+    std::error_code ecode;
+    llvm::raw_fd_ostream dest(file_name, ecode, llvm::sys::fs::F_None);
+    ICHECK_EQ(ecode.value(), 0) << "Cannot open file: " << file_name << " " << ecode.message();
+    if (fmt == "o" || fmt == "obj") {
+#if TVM_LLVM_VERSION <= 60
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(mptr_);
+#else
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(*mptr_);
+#endif
+      llvm::legacy::PassManager pass;
+      ICHECK(tm_);
+#if TVM_LLVM_VERSION <= 60
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, llvm::TargetMachine::CGFT_ObjectFile) == 0)
+          << "Cannot emit target CGFT_ObjectFile";
+#elif TVM_LLVM_VERSION <= 90
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, nullptr, llvm::TargetMachine::CGFT_ObjectFile) ==
+             0)
+          << "Cannot emit target CGFT_ObjectFile";
+#else
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, nullptr, llvm::CGFT_ObjectFile) == 0)
+          << "Cannot emit target CGFT_ObjectFile";
+#endif
+      pass.run(*m);
+    } else if (fmt == "s" || fmt == "asm") {
+#if TVM_LLVM_VERSION <= 60
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(mptr_);
+#else
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(*mptr_);
+#endif
+      llvm::legacy::PassManager pass;
+      ICHECK(tm_);
+#if TVM_LLVM_VERSION <= 60
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, llvm::TargetMachine::CGFT_AssemblyFile) == 0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#elif TVM_LLVM_VERSION <= 90
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, nullptr,
+                                      llvm::TargetMachine::CGFT_AssemblyFile) == 0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#else
+      ICHECK(tm_->addPassesToEmitFile(pass, dest, nullptr, llvm::CGFT_AssemblyFile) == 0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#endif
+      pass.run(*m);
+    } else if (fmt == "ll") {
+      mptr_->print(dest, nullptr);
+    } else if (fmt == "bc") {
+#if TVM_LLVM_VERSION <= 60
+      llvm::WriteBitcodeToFile(mptr_, dest);
+#else
+      llvm::WriteBitcodeToFile(*mptr_, dest);
+#endif
+    } else {
+      LOG(FATAL) << "Do not know how to save file " << file_name << " with format=\'" << format
+                 << "\'";
+    }
+    dest.close();
+  }
+
+  void SaveToBinary(dmlc::Stream* stream) final {
+    LOG(FATAL) << "LLVMModule: SaveToBinary not supported";
+  }
+
+  std::string GetSource(const std::string& format) final {
+    std::string fmt = runtime::GetFileFormat("", format);
+    std::string type_str;
+    llvm::SmallString<256> str;
+    llvm::raw_svector_ostream rso(str);
+
+    if (fmt == "s" || fmt == "asm") {
+#if TVM_LLVM_VERSION <= 60
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(mptr_);
+#else
+      std::unique_ptr<llvm::Module> m = llvm::CloneModule(*mptr_);
+#endif
+      llvm::legacy::PassManager pass;
+      ICHECK(tm_);
+#if TVM_LLVM_VERSION <= 60
+      ICHECK(tm_->addPassesToEmitFile(pass, rso, llvm::TargetMachine::CGFT_AssemblyFile) == 0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#elif TVM_LLVM_VERSION <= 90
+      ICHECK(tm_->addPassesToEmitFile(pass, rso, nullptr, llvm::TargetMachine::CGFT_AssemblyFile) ==
+             0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#else
+      ICHECK(tm_->addPassesToEmitFile(pass, rso, nullptr, llvm::CGFT_AssemblyFile) == 0)
+          << "Cannot emit target CGFT_AssemblyFile";
+#endif
+      pass.run(*m);
+      return rso.str().str();
+    } else if (fmt == "" || fmt == "ll") {
+      std::string type_str;
+      llvm::raw_string_ostream rso(type_str);
+      ICHECK(mptr_ != nullptr);
+      mptr_->print(rso, nullptr);
+      return rso.str();
+    } else {
+      LOG(FATAL) << "Do not know how to get source code with format: " << format << "\'";
+    }
+    return "";
+  }
+
+  void Init(const IRModule& mod, const Target& target) {
+    InitializeLLVM();
+    tm_ = GetLLVMTargetMachine(target);
+    bool system_lib = target->GetAttr<Bool>("system-lib").value_or(Bool(false));
+    bool target_c_runtime = (target->GetAttr<String>("runtime").value_or("") == kTvmRuntimeCrt);
+    ctx_ = std::make_shared<llvm::LLVMContext>();
+
+    std::vector<PrimFunc> funcs;
+    std::string entry_func;
+    Map<String, LinkedParam> linked_params;
+    bool found_linked_params = false;
+    bool could_have_linked_params = target->GetAttr<Bool>("link-params").value_or(Bool(false));
+    for (auto kv : mod->functions) {
+      if (could_have_linked_params &&
+          kv.first->name_hint == ::tvm::runtime::symbol::tvm_lookup_linked_param) {
+        Map<String, ObjectRef> attrs_dict =
+            Downcast<Map<String, ObjectRef>>(kv.second->attrs->dict);
+        CHECK(attrs_dict.find(::tvm::tir::attr::kLinkedParams) != attrs_dict.end())
+            << "no " << ::tvm::tir::attr::kLinkedParams << " attribute found!";
+        linked_params =
+            Downcast<Map<String, LinkedParam>>(attrs_dict[::tvm::tir::attr::kLinkedParams]);
+        found_linked_params = true;
+        continue;
+      }
+      ICHECK(kv.second->IsInstance<PrimFuncNode>())
+          << "Can only lower IR Module with PrimFuncs, but got " << kv.second->GetTypeKey();
+      auto f = Downcast<PrimFunc>(kv.second);
+      auto global_symbol = f->GetAttr<String>(tvm::attr::kGlobalSymbol);
+      ICHECK(global_symbol.defined());
+      function_names_.push_back(global_symbol.value());
+      if (f->HasNonzeroAttr(tir::attr::kIsEntryFunc)) {
+        entry_func = global_symbol.value();
+      }
+      funcs.push_back(f);
+    }
+    ICHECK(funcs.size() > 0 || (could_have_linked_params && found_linked_params));
+
+    // The object cache compiles every function in its own module, which is
+    // incompatible with the module level features below.
+    const char* cache_dir = std::getenv("TVM_LLVM_CACHE_DIR");
+    bool use_cache = cache_dir != nullptr && cache_dir[0] != '\0' && !system_lib &&
+                     !found_linked_params && entry_func.empty() && funcs.size() > 0;
+    if (use_cache) {
+      BuildWithObjectCache(funcs, target, cache_dir, target_c_runtime);
+    } else {
+      std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(tm_.get());
+      // TODO(tqchen): remove the entry function behavior as it does not
+      // makes sense when we start to use multiple modules.
+      cg->Init("TVMMod", tm_.get(), ctx_.get(), system_lib, system_lib, target_c_runtime);
+      if (auto isas = target->GetAttr<Array<String>>("mversion")) {
+        cg->SetFunctionVersions(isas.value());
+      }
+
+      for (const auto& f : funcs) {
+        cg->AddFunction(f);
+      }
+
+      if (entry_func.length() != 0) {
+        cg->AddMainFunction(entry_func);
+      }
+
+      if (found_linked_params) {
+        cg->LinkParameters(linked_params);
+      }
+      auto tstart = std::chrono::high_resolution_clock::now();
+      module_ = cg->Finish();
+      if (TimingEnabled()) {
+        std::chrono::duration<double> dur = std::chrono::high_resolution_clock::now() - tstart;
+        LOG(INFO) << "LLVM middle-end over " << funcs.size() << " function(s): " << dur.count()
+                  << " s";
+      }
+    }
+    module_->addModuleFlag(llvm::Module::Warning, "tvm_target",
+                           llvm::MDString::get(*ctx_, LLVMTargetToString(target)));
+    module_->addModuleFlag(llvm::Module::Override, "Debug Info Version",
+                           llvm::DEBUG_METADATA_VERSION);
+
+    if (tm_->getTargetTriple().isOSDarwin()) {
+      module_->addModuleFlag(llvm::Module::Override, "Dwarf Version", 2);
+    }
+
+    std::string verify_errors_storage;
+    llvm::raw_string_ostream verify_errors(verify_errors_storage);
+    LOG_IF(FATAL, llvm::verifyModule(*module_, &verify_errors))
+        << "LLVM module verification failed with the following errors: \n"
+        << verify_errors.str();
+    target_ = target;
+    mptr_ = module_.get();
+  }
+
+  void Init(std::unique_ptr<llvm::Module> module, std::shared_ptr<llvm::LLVMContext> ctx) {
+    InitializeLLVM();
+    ctx_ = ctx;
+    llvm::SMDiagnostic err;
+    module_ = std::move(module);
+    if (module_ == nullptr) {
+      std::string msg = std::string(err.getMessage());
+      LOG(FATAL) << "Fail to load module: " << msg;
+    }
+    std::string target_metadata;
+    llvm::Metadata* tvm_target = module_->getModuleFlag("tvm_target");
+    if (tvm_target != nullptr) {
+      llvm::MDString* pstr = llvm::dyn_cast<llvm::MDString>(tvm_target);
+      ICHECK(pstr != nullptr);
+      target_metadata = pstr->getString().str();
+      if (!(target_metadata.length() >= 4 && target_metadata.substr(0, 4) == "llvm")) {
+        target_metadata = "llvm " + target_metadata;
+      }
+    } else {
+      std::ostringstream os;
+      os << "llvm -mtriple " << module_->getTargetTriple();
+      target_metadata = os.str();
+    }
+    mptr_ = module_.get();
+    tm_ = GetLLVMTargetMachine(Target(target_metadata));
+  }
+
+  void LoadIR(const std::string& file_name) {
+    auto ctx = std::make_shared<llvm::LLVMContext>();
+    llvm::SMDiagnostic err;
+    auto module = llvm::parseIRFile(file_name, err, *ctx);
+    if (module == nullptr) {
+      std::string msg = std::string(err.getMessage());
+      LOG(FATAL) << "Fail to load ir file " << file_name << "\n"
+                 << "line " << err.getLineNo() << ":" << msg;
+    }
+    Init(std::move(module), ctx);
+  }
+
+ private:
+  // Whether per-function LLVM timing logs are requested.
+  static bool TimingEnabled() {
+    const char* flag = std::getenv("TVM_LLVM_TIMEIT");
+    return flag != nullptr && atoi(flag) != 0;
+  }
+
+  // Content-addressed cache key of one function compiled for one target.
+  static std::string CacheKey(const PrimFunc& f, const Target& target) {
+    uint64_t key = StructuralHash::Cached(f);
+    key = support::HashCombine(key, std::hash<std::string>()(target->str()));
+    std::ostringstream os;
+    os << std::hex << std::setw(16) << std::setfill('0') << key;
+    return os.str();
+  }
+
+  // Write the optimized bitcode of one function to the cache. Failures only
+  // cost the caching, so they are not fatal.
+  static void SaveBitcode(llvm::Module* m, const std::string& path) {
+    std::error_code ecode;
+    llvm::raw_fd_ostream dest(path, ecode, llvm::sys::fs::F_None);
+    if (ecode.value() != 0) {
+      LOG(WARNING) << "Cannot write LLVM cache entry " << path << ": " << ecode.message();
+      return;
+    }
+#if TVM_LLVM_VERSION <= 60
+    llvm::WriteBitcodeToFile(m, dest);
+#else
+    llvm::WriteBitcodeToFile(*m, dest);
+#endif
+  }
+
+  // Compile each function in its own module so that unchanged functions can
+  // link their already optimized bitcode from the on-disk cache, keyed by
+  // structural hash and target string. Cache misses run the LLVM middle-end
+  // as usual and refresh their cache entry.
+  void BuildWithObjectCache(const std::vector<PrimFunc>& funcs, const Target& target,
+                            const std::string& cache_dir, bool target_c_runtime) {
+    bool timing = TimingEnabled();
+    std::unique_ptr<llvm::Module> lmod(new llvm::Module("TVMMod", *ctx_));
+    lmod->setTargetTriple(tm_->getTargetTriple().str());
+    lmod->setDataLayout(tm_->createDataLayout());
+    size_t num_hits = 0;
+    for (const auto& f : funcs) {
+      std::string name = f->GetAttr<String>(tvm::attr::kGlobalSymbol).value();
+      std::string path = cache_dir + "/" + CacheKey(f, target) + ".bc";
+      // A stale or truncated entry fails to parse and is treated as a miss.
+      llvm::SMDiagnostic err;
+      std::unique_ptr<llvm::Module> fmod = llvm::parseIRFile(path, err, *ctx_);
+      if (fmod != nullptr) {
+        ++num_hits;
+      } else {
+        auto tstart = std::chrono::high_resolution_clock::now();
+        std::unique_ptr<CodeGenLLVM> cg = CodeGenLLVM::Create(tm_.get());
+        cg->Init("TVMMod", tm_.get(), ctx_.get(), false, false, target_c_runtime);
+        if (auto isas = target->GetAttr<Array<String>>("mversion")) {
+          cg->SetFunctionVersions(isas.value());
+        }
+        cg->AddFunction(f);
+        fmod = cg->Finish();
+        if (timing) {
+          std::chrono::duration<double> dur = std::chrono::high_resolution_clock::now() - tstart;
+          LOG(INFO) << "LLVM middle-end " << name << ": " << dur.count() << " s";
+        }
+        SaveBitcode(fmod.get(), path);
+      }
+      ICHECK(!llvm::Linker::linkModules(*lmod, std::move(fmod)))
+          << "Failed to link function " << name;
+    }
+    if (timing) {
+      LOG(INFO) << "LLVM object cache: " << num_hits << "/" << funcs.size() << " hit";
+    }
+    module_ = std::move(lmod);
+  }
+
+  void LazyInitJIT() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ee_) {
+      return;
+    }
+    if (!target_.defined()) {
+      target_ = Target("llvm");
+    }
+    llvm::EngineBuilder builder(std::move(module_));
+    std::string triple, mcpu, mattr;
+    llvm::TargetOptions opt;
+    ParseLLVMTargetOptions(target_, &triple, &mcpu, &mattr, &opt);
+    builder.setEngineKind(llvm::EngineKind::JIT);
+    builder.setOptLevel(llvm::CodeGenOpt::Aggressive);
+    if (mcpu.length() != 0) {
+      builder.setMCPU(mcpu);
+    }
+    if (mattr.length() != 0) {
+      std::vector<std::string> mattrs{mattr};
+      builder.setMAttrs(mattrs);
+    }
+    builder.setTargetOptions(opt);
+    auto tm = std::unique_ptr<llvm::TargetMachine>(builder.selectTarget());
+    std::unique_ptr<llvm::TargetMachine> tm_sys = GetLLVMTargetMachine(Target("llvm"));
+    if (tm_sys->getTargetTriple().getArch() != tm->getTargetTriple().getArch()) {
+      LOG(FATAL) << "Cannot run module, architecture mismatch "
+                 << " module=" << tm->getTargetTriple().str()
+                 << " system=" << tm_sys->getTargetTriple().str();
+    }
+    llvm::DataLayout layout(tm->createDataLayout());
+    ICHECK(layout == mptr_->getDataLayout())
+        << "Data layout mismatch between module("
+        << mptr_->getDataLayout().getStringRepresentation() << ")"
+        << " and ExecutionEngine (" << layout.getStringRepresentation() << ")";
+    ee_ = builder.create(tm.release());
+    ICHECK(ee_ != nullptr) << "Failed to initialize jit engine for " << mptr_->getTargetTriple();
+    ee_->runStaticConstructorsDestructors(false);
+
+    if (void** ctx_addr =
+            reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx))) {
+      *ctx_addr = this;
+    }
+    runtime::InitContextFunctions(
+        [this](const char* name) { return reinterpret_cast<void*>(GetGlobalAddr(name)); });
+  }
+#if TVM_LLVM_VERSION >= 110
+  // Whether the lazy ORC engine was requested for JIT execution.
+  static bool UseORCJIT() {
+    const char* flag = std::getenv("TVM_LLVM_USE_ORC");
+    return flag != nullptr && atoi(flag) != 0;
+  }
+
+  void LazyInitORCJIT() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (orc_jit_) {
+      return;
+    }
+    if (!target_.defined()) {
+      target_ = Target("llvm");
+    }
+    std::unique_ptr<llvm::TargetMachine> tm_sys = GetLLVMTargetMachine(Target("llvm"));
+    if (tm_sys->getTargetTriple().getArch() != tm_->getTargetTriple().getArch()) {
+      LOG(FATAL) << "Cannot run module, architecture mismatch "
+                 << " module=" << tm_->getTargetTriple().str()
+                 << " system=" << tm_sys->getTargetTriple().str();
+    }
+    std::string triple, mcpu, mattr;
+    llvm::TargetOptions opt;
+    ParseLLVMTargetOptions(target_, &triple, &mcpu, &mattr, &opt);
+    llvm::orc::JITTargetMachineBuilder tmb(tm_->getTargetTriple());
+    if (mcpu.length() != 0) {
+      tmb.setCPU(mcpu);
+    }
+    if (mattr.length() != 0) {
+      tmb.addFeatures({mattr});
+    }
+    tmb.setOptions(opt);
+    tmb.setCodeGenOptLevel(llvm::CodeGenOpt::Aggressive);
+
+    llvm::orc::LLLazyJITBuilder builder;
+    builder.setJITTargetMachineBuilder(std::move(tmb));
+    builder.setNumCompileThreads(std::max(1U, std::thread::hardware_concurrency()));
+    auto jit = builder.create();
+    if (!jit) {
+      LOG(FATAL) << "Failed to create ORC JIT: " << llvm::toString(jit.takeError());
+    }
+    orc_jit_ = std::move(*jit);
+
+    // Resolve references into the hosting process, e.g. the TVM runtime API.
+    auto gen = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        orc_jit_->getDataLayout().getGlobalPrefix());
+    if (!gen) {
+      LOG(FATAL) << "Failed to create process symbol generator: "
+                 << llvm::toString(gen.takeError());
+    }
+    orc_jit_->getMainJITDylib().addGenerator(std::move(*gen));
+
+    llvm::DataLayout layout(orc_jit_->getDataLayout());
+    ICHECK(layout == mptr_->getDataLayout())
+        << "Data layout mismatch between module("
+        << mptr_->getDataLayout().getStringRepresentation() << ")"
+        << " and ORC JIT (" << layout.getStringRepresentation() << ")";
+
+    // Hand a copy of the module to the JIT in a context it owns exclusively,
+    // so the compile threads never race against users of mptr_. Function
+    // bodies only materialize on their first call.
+    llvm::SmallString<0> buf;
+    {
+      llvm::raw_svector_ostream os(buf);
+      llvm::WriteBitcodeToFile(*mptr_, os);
+    }
+    auto jit_ctx = std::make_unique<llvm::LLVMContext>();
+    auto jit_mod = llvm::parseBitcodeFile(
+        llvm::MemoryBufferRef(llvm::StringRef(buf.data(), buf.size()), mptr_->getName()), *jit_ctx);
+    if (!jit_mod) {
+      LOG(FATAL) << "Failed to reload module for ORC JIT: " << llvm::toString(jit_mod.takeError());
+    }
+    if (auto err = orc_jit_->addLazyIRModule(llvm::orc::ThreadSafeModule(
+            std::move(*jit_mod), llvm::orc::ThreadSafeContext(std::move(jit_ctx))))) {
+      LOG(FATAL) << "Failed to add module to ORC JIT: " << llvm::toString(std::move(err));
+    }
+    if (auto err = orc_jit_->initialize(orc_jit_->getMainJITDylib())) {
+      LOG(FATAL) << "Failed to run static constructors: " << llvm::toString(std::move(err));
+    }
+
+    if (void** ctx_addr =
+            reinterpret_cast<void**>(GetGlobalAddr(runtime::symbol::tvm_module_ctx))) {
+      *ctx_addr = this;
+    }
+    runtime::InitContextFunctions(
+        [this](const char* name) { return reinterpret_cast<void*>(GetGlobalAddr(name)); });
+  }
+
+  // Look up a symbol address in the ORC JIT, 0 when not found.
+  uint64_t ORCLookup(const std::string& name) const {
+    auto sym = orc_jit_->lookup(name);
+    if (!sym) {
+      llvm::consumeError(sym.takeError());
+      return 0;
+    }
+    return sym->getAddress();
+  }
+#endif
+
+  // Get global address from execution engine.
+  uint64_t GetGlobalAddr(const std::string& name) const {
+    // first verifies if GV exists.
+    if (mptr_->getGlobalVariable(name) == nullptr) {
+      return 0;
+    }
+#if TVM_LLVM_VERSION >= 110
+    if (orc_jit_ != nullptr) {
+      return ORCLookup(name);
+    }
+#endif
+    return ee_->getGlobalValueAddress(name);
+  }
+  uint64_t GetFunctionAddr(const std::string& name) const {
+    // first verifies if GV exists.
+    if (mptr_->getFunction(name) == nullptr) {
+      return 0;
+    }
+#if TVM_LLVM_VERSION >= 110
+    if (orc_jit_ != nullptr) {
+      return ORCLookup(name);
+    }
+#endif
+    return ee_->getFunctionAddress(name);
+  }
+
+  // The target configuration string
+  Target target_;
+  // JIT lock
+  std::mutex mutex_;
+  // execution engine
+  llvm::ExecutionEngine* ee_{nullptr};
+#if TVM_LLVM_VERSION >= 110
+  // lazy ORC execution engine, used instead of ee_ when requested.
+  std::unique_ptr<llvm::orc::LLLazyJIT> orc_jit_{nullptr};
+#endif
+  // The raw pointer to the module.
+  llvm::Module* mptr_{nullptr};
+  // The target machine
+  std::unique_ptr<llvm::TargetMachine> tm_{nullptr};
+  // The module, can be moved to ee if JIT is enabled.
+  std::unique_ptr<llvm::Module> module_;
+  // the context.
+  std::shared_ptr<llvm::LLVMContext> ctx_;
+  /* \brief names of the functions declared in this module */
+  Array<String> function_names_;
+};
+
+TVM_REGISTER_GLOBAL("target.build.llvm")
+    .set_body_typed([](IRModule mod, Target target) -> runtime::Module {
+      auto n = make_object<LLVMModuleNode>();
+      n->Init(mod, target);
+      return runtime::Module(n);
+    });
+
+TVM_REGISTER_GLOBAL("codegen.LLVMModuleCreate")
+    .set_body_typed([](std::string target_str, std::string module_name) -> runtime::Module {
+      Target target = Target(target_str);
+      auto n = make_object<LLVMModuleNode>();
+      // Generate a LLVM module from an input target string
+      InitializeLLVM();
+      auto tm = GetLLVMTargetMachine(target);
+      auto ctx = std::make_shared<llvm::LLVMContext>();
+      std::unique_ptr<llvm::Module> module(new llvm::Module(module_name, *ctx));
+      // Use a default data layout and target triple
+      auto triple = tm->getTargetTriple();
+      module->setTargetTriple(triple.str());
+      module->setDataLayout(tm->createDataLayout());
+      n->Init(std::move(module), ctx);
+      return runtime::Module(n);
+    });
+
+TVM_REGISTER_GLOBAL("target.llvm_lookup_intrinsic_id")
+    .set_body_typed([](std::string name) -> int64_t {
+      return static_cast<int64_t>(llvm::Function::lookupIntrinsicID(name));
+    });
+
+TVM_REGISTER_GLOBAL("target.llvm_version_major").set_body_typed([]() -> int {
+  return TVM_LLVM_VERSION / 10;
+});
+
+TVM_REGISTER_GLOBAL("runtime.module.loadfile_ll")
+    .set_body_typed([](std::string filename, std::string fmt) -> runtime::Module {
+      auto n = make_object<LLVMModuleNode>();
+      n->LoadIR(filename);
+      return runtime::Module(n);
+    });
+
+TVM_REGISTER_GLOBAL("codegen.llvm_target_enabled")
+    .set_body_typed([](std::string target_str) -> bool {
+      InitializeLLVM();
+      Target target = Target(target_str);
+      return (GetLLVMTargetMachine(target, true) != nullptr);
+    });
+
+TVM_REGISTER_GLOBAL("codegen.codegen_blob")
+    .set_body_typed([](std::string data, bool system_lib,
+                       std::string target_triple) -> runtime::Module {
+      auto n = make_object<LLVMModuleNode>();
+      auto p = CodeGenBlob(data, system_lib, target_triple);
+      n->Init(std::move(p.first), p.second);
+      return runtime::Module(n);
+    });
+
+runtime::Module CreateLLVMCrtMetadataModule(const Array<runtime::Module>& modules, Target target) {
+  Array<String> func_names;
+  for (runtime::Module mod : modules) {
+    auto pf_funcs = mod.GetFunction("get_func_names");
+    if (pf_funcs != nullptr) {
+      Array<String> func_names_ = pf_funcs();
+      for (const auto& fname : func_names_) {
+        func_names.push_back(fname);
+      }
+    }
+  }
+
+  InitializeLLVM();
+  auto tm = GetLLVMTargetMachine(target);
+  bool system_lib = target->GetAttr<Bool>("system-lib").value_or(Bool(false));
+  bool target_c_runtime = (target->GetAttr<String>("runtime").value_or("") == kTvmRuntimeCrt);
+  ICHECK(system_lib && target_c_runtime)
+      << "For LLVM C-runtime metadata module, must include --system-lib and --runtime=c; "
+      << "got target: " << target->str();
+  auto ctx = std::make_shared<llvm::LLVMContext>();
+  std::unique_ptr<CodeGenCPU> cg{new CodeGenCPU()};
+  cg->Init("TVMMetadataMod", tm.get(), ctx.get(), system_lib, system_lib, target_c_runtime);
+
+  cg->DefineFunctionRegistry(func_names);
+  auto mod = cg->Finish();
+  mod->addModuleFlag(llvm::Module::Warning, "tvm_target",
+                     llvm::MDString::get(*ctx, LLVMTargetToString(target)));
+  mod->addModuleFlag(llvm::Module::Override, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+
+  if (tm->getTargetTriple().isOSDarwin()) {
+    mod->addModuleFlag(llvm::Module::Override, "Dwarf Version", 2);
+  }
+
+  std::string verify_errors_storage;
+  llvm::raw_string_ostream verify_errors(verify_errors_storage);
+  LOG_IF(FATAL, llvm::verifyModule(*mod, &verify_errors))
+      << "LLVM module verification failed with the following errors: \n"
+      << verify_errors.str();
+
+  auto n = make_object<LLVMModuleNode>();
+  n->Init(std::move(mod), ctx);
+  for (auto m : modules) {
+    n->Import(m);
+  }
+  return runtime::Module(n);
+}
+
+TVM_REGISTER_GLOBAL("runtime.CreateLLVMCrtMetadataModule")
+    .set_body_typed([](const Array<runtime::Module>& modules, Target target) {
+      return CreateLLVMCrtMetadataModule(modules, target);
+    });
+
+}  // namespace codegen
+}  // namespace tvm
+#endif  // TVM_LLVM_VERSION
@@ -0,0 +1,306 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *  Build cuda modules from source.
+ *  requires cuda to be available.
+ *
+ * \file build_cuda.cc
+ */
+#if defined(__linux__)
+#include <sys/stat.h>
+#endif
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <nvrtc.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "../../runtime/cuda/cuda_common.h"
+#include "../../runtime/cuda/cuda_module.h"
+#include "../../support/utils.h"
+#include "../build_common.h"
+#include "../source/codegen_cuda.h"
+
+namespace tvm {
+namespace codegen {
+
+#define NVRTC_CALL(x)                                                                        \
+  {                                                                                          \
+    nvrtcResult result = x;                                                                  \
+    if (result != NVRTC_SUCCESS) {                                                           \
+      LOG(FATAL) << "NvrtcError: " #x " failed with error: " << nvrtcGetErrorString(result); \
+    }                                                                                        \
+  }
+
+std::string FindCUDAIncludePath() {
+#if defined(_WIN32)
+  const std::string delimiter = "\\";
+#else
+  const std::string delimiter = "/";
+#endif
+  std::string cuda_include_path;
+  const char* cuda_path_env = std::getenv("CUDA_PATH");
+  if (cuda_path_env != nullptr) {
+    cuda_include_path += cuda_path_env;
+    cuda_include_path += delimiter + "include";
+    return cuda_include_path;
+  }
+
+#if defined(__linux__)
+  struct stat st;
+  cuda_include_path = "/usr/local/cuda/include";
+  if (stat(cuda_include_path.c_str(), &st) == 0) {
+    return cuda_include_path;
+  }
+#endif
+  LOG(FATAL) << "Cannot find cuda include path."
+             << "CUDA_PATH is not set or CUDA is not installed in the default installation path."
+             << "In other than linux, it is necessary to set CUDA_PATH.";
+  return cuda_include_path;
+}
+
+std::string DetectCUDAComputeVersion() {
+  std::string cc = "30";
+  int major, minor;
+  cudaError_t e1 = cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
+  cudaError_t e2 = cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0);
+
+  if (e1 == cudaSuccess && e2 == cudaSuccess) {
+    cc = std::to_string(major) + std::to_string(minor);
+  } else {
+    LOG(WARNING) << "cannot detect compute capability from your device, "
+                 << "fall back to compute_30.";
+  }
+  return cc;
+}
+
+std::string NVRTCCompile(const std::string& code, bool include_path = false) {
+  std::vector<std::string> compile_params;
+  std::vector<const char*> param_cstrings{};
+  nvrtcProgram prog;
+  std::string cc = DetectCUDAComputeVersion();
+
+  compile_params.push_back("-arch=compute_" + cc);
+
+  if (include_path) {
+    std::string include_option = "--include-path=" + FindCUDAIncludePath();
+
+    compile_params.push_back(include_option);
+  }
+
+  for (const auto& string : compile_params) {
+    param_cstrings.push_back(string.c_str());
+  }
+  NVRTC_CALL(nvrtcCreateProgram(&prog, code.c_str(), nullptr, 0, nullptr, nullptr));
+  nvrtcResult compile_res = nvrtcCompileProgram(prog, param_cstrings.size(), param_cstrings.data());
+
+  size_t log_size;
+  NVRTC_CALL(nvrtcGetProgramLogSize(prog, &log_size));
+  std::string log;
+  log.resize(log_size);
+  NVRTC_CALL(nvrtcGetProgramLog(prog, &log[0]));
+  ICHECK_EQ(compile_res, NVRTC_SUCCESS) << log;
+  size_t ptx_size;
+  NVRTC_CALL(nvrtcGetPTXSize(prog, &ptx_size));
+
+  std::string ptx;
+  ptx.resize(ptx_size);
+  NVRTC_CALL(nvrtcGetPTX(prog, &ptx[0]));
+  NVRTC_CALL(nvrtcDestroyProgram(&prog));
+
+  return ptx;
+}
+
+// The cache file of a kernel, keyed by its postprocessed source and the
+// compile architecture.
+std::string PTXCacheFile(const std::string& cache_dir, const std::string& code,
+                         const std::string& cc) {
+  uint64_t key = support::HashCombine(std::hash<std::string>()(code),
+                                      std::hash<std::string>()(cc));
+  std::ostringstream os;
+  os << cache_dir << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".ptx";
+  return os.str();
+}
+
+bool LoadPTX(const std::string& path, std::string* ptx) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) return false;
+  std::ostringstream content;
+  content << in.rdbuf();
+  *ptx = content.str();
+  return !ptx->empty();
+}
+
+void SavePTX(const std::string& path, const std::string& ptx) {
+  std::ofstream out(path, std::ios::binary);
+  if (!out.is_open()) {
+    LOG(WARNING) << "Cannot write PTX cache file " << path;
+    return;
+  }
+  out << ptx;
+}
+
+// Link per-kernel PTX blobs into a single cubin with the driver JIT linker.
+// Returns an empty string if no device context is available.
+std::string LinkCUBIN(const std::vector<std::string>& ptx_blobs) {
+  if (cudaSetDevice(0) != cudaSuccess || cudaFree(nullptr) != cudaSuccess) return "";
+  CUlinkState link_state;
+  if (cuLinkCreate(0, nullptr, nullptr, &link_state) != CUDA_SUCCESS) return "";
+  for (const std::string& ptx : ptx_blobs) {
+    // The linker requires null terminated PTX; c_str() guarantees the extra byte.
+    CUresult res = cuLinkAddData(link_state, CU_JIT_INPUT_PTX, const_cast<char*>(ptx.c_str()),
+                                 ptx.size() + 1, "tvm_kernels", 0, nullptr, nullptr);
+    if (res != CUDA_SUCCESS) {
+      cuLinkDestroy(link_state);
+      return "";
+    }
+  }
+  void* cubin_data;
+  size_t cubin_size;
+  if (cuLinkComplete(link_state, &cubin_data, &cubin_size) != CUDA_SUCCESS) {
+    cuLinkDestroy(link_state);
+    return "";
+  }
+  std::string cubin(static_cast<const char*>(cubin_data), cubin_size);
+  cuLinkDestroy(link_state);
+  return cubin;
+}
+
+runtime::Module BuildCUDA(IRModule mod, Target target) {
+  using tvm::runtime::Registry;
+  bool output_ssa = false;
+
+  Array<PrimFunc> funcs;
+  for (auto kv : mod->functions) {
+    ICHECK(kv.second->IsInstance<PrimFuncNode>()) << "CodeGenCUDA: Can only take PrimFunc";
+    auto f = Downcast<PrimFunc>(kv.second);
+    auto calling_conv = f->GetAttr<Integer>(tvm::attr::kCallingConv);
+    ICHECK(calling_conv == CallingConv::kDeviceKernelLaunch)
+        << "CodeGenCUDA: expect calling_conv equals CallingConv::kDeviceKernelLaunch";
+    funcs.push_back(f);
+  }
+
+  const auto* postproc = Registry::Get("tvm_callback_cuda_postproc");
+  const auto* custom_compile = Registry::Get("tvm_callback_cuda_compile");
+
+  const char* cache_dir = std::getenv("TVM_CUDA_CACHE_DIR");
+  bool use_cache = cache_dir != nullptr && cache_dir[0] != '\0';
+  int num_threads = 1;
+  if (const char* env = std::getenv("TVM_CUDA_COMPILE_THREADS")) {
+    num_threads = std::max(1, atoi(env));
+  }
+
+  // Per-kernel compilation path: each kernel is generated and compiled on its
+  // own so an unchanged kernel hits the PTX cache and the NVRTC sessions run
+  // concurrently. Custom compile callbacks expect the whole source, so they
+  // keep the single-shot path.
+  if ((use_cache || num_threads > 1) && custom_compile == nullptr && !funcs.empty()) {
+    size_t num_kernels = funcs.size();
+    std::vector<std::string> sources(num_kernels);
+    std::vector<int> need_include(num_kernels, 0);
+    std::string code;
+    for (size_t i = 0; i < num_kernels; ++i) {
+      CodeGenCUDA cg;
+      cg.Init(output_ssa);
+      cg.AddFunction(funcs[i]);
+      std::string src = cg.Finish();
+      if (postproc != nullptr) {
+        src = (*postproc)(src).operator std::string();
+      }
+      need_include[i] = cg.need_include_path();
+      sources[i] = src;
+      code += src;
+    }
+    std::string cc = DetectCUDAComputeVersion();
+    std::vector<std::string> ptx_blobs(num_kernels);
+    std::mutex err_mutex;
+    std::string first_error;
+    auto worker = [&](size_t begin, size_t step) {
+      for (size_t i = begin; i < num_kernels; i += step) {
+        try {
+          std::string path;
+          if (use_cache) {
+            path = PTXCacheFile(cache_dir, sources[i], cc);
+            if (LoadPTX(path, &ptx_blobs[i])) continue;
+          }
+          ptx_blobs[i] = NVRTCCompile(sources[i], need_include[i]);
+          if (use_cache) {
+            SavePTX(path, ptx_blobs[i]);
+          }
+        } catch (const std::exception& e) {
+          std::lock_guard<std::mutex> lock(err_mutex);
+          if (first_error.empty()) first_error = e.what();
+        }
+      }
+    };
+    size_t num_workers = std::min<size_t>(std::max(num_threads, 1), num_kernels);
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < num_workers; ++t) {
+      workers.emplace_back(worker, t, num_workers);
+    }
+    worker(0, num_workers);
+    for (std::thread& t : workers) {
+      t.join();
+    }
+    ICHECK(first_error.empty()) << first_error;
+    if (num_kernels == 1) {
+      return CUDAModuleCreate(ptx_blobs[0], "ptx", ExtractFuncInfo(mod), code);
+    }
+    std::string cubin = LinkCUBIN(ptx_blobs);
+    if (!cubin.empty()) {
+      return CUDAModuleCreate(cubin, "cubin", ExtractFuncInfo(mod), code);
+    }
+    LOG(WARNING) << "BuildCUDA: cubin linking failed, "
+                 << "falling back to whole-module compilation";
+  }
+
+  CodeGenCUDA cg;
+  cg.Init(output_ssa);
+  for (auto f : funcs) {
+    cg.AddFunction(f);
+  }
+
+  std::string code = cg.Finish();
+
+  if (postproc != nullptr) {
+    code = (*postproc)(code).operator std::string();
+  }
+  std::string fmt = "ptx";
+  std::string ptx;
+  if (custom_compile != nullptr) {
+    ptx = (*custom_compile)(code).operator std::string();
+    // Dirty matching to check PTX vs cubin.
+    // TODO(tqchen) more reliable checks
+    if (ptx[0] != '/') fmt = "cubin";
+  } else {
+    ptx = NVRTCCompile(code, cg.need_include_path());
+  }
+  return CUDAModuleCreate(ptx, fmt, ExtractFuncInfo(mod), code);
+}
+
+TVM_REGISTER_GLOBAL("target.build.cuda").set_body_typed(BuildCUDA);
+}  // namespace codegen
+}  // namespace tvm
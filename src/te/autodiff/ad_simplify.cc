@@ -771,6 +771,96 @@ inline arith::IntConstraintsTransform IdentityTransformation(const arith::IntCon
   return arith::IntConstraintsTransform(domain, domain, identity_map, identity_map);
 }
 
+// Try to eliminate Kronecker delta conditions (var == expr) from the domain by direct
+// substitution. The Jacobian of any composition of direct tensor accesses consists of such
+// deltas, so for the bulk of autodiff output this removes every domain variable without
+// constructing and solving the integer linear system the general path below relies on.
+// Only deltas whose right hand side is free of domain variables are handled; everything
+// else is left for the solvers. Returns an empty optional when no variable was eliminated.
+dmlc::optional<arith::IntConstraintsTransform> TryEliminateKroneckerDeltas(
+    const arith::IntConstraints& domain) {
+  using tresult = dmlc::optional<arith::IntConstraintsTransform>;
+
+  std::unordered_set<const VarNode*> domain_vars;
+  for (const Var& v : domain->variables) {
+    domain_vars.insert(v.get());
+  }
+  auto uses_domain_var = [&domain_vars](const PrimExpr& e) {
+    return tir::ExprUseVar(e, [&domain_vars](const VarNode* v) { return domain_vars.count(v); });
+  };
+
+  Map<Var, PrimExpr> subst;
+  Array<PrimExpr> rest;
+  for (const PrimExpr& rel : domain->relations) {
+    if (const EQNode* eq = rel.as<EQNode>()) {
+      PrimExpr var_side = eq->a;
+      PrimExpr expr_side = eq->b;
+      if (!var_side.as<VarNode>() || uses_domain_var(expr_side)) {
+        std::swap(var_side, expr_side);
+      }
+      const VarNode* var = var_side.as<VarNode>();
+      if (var && domain_vars.count(var) && !subst.count(GetRef<Var>(var)) &&
+          !uses_domain_var(expr_side)) {
+        subst.Set(GetRef<Var>(var), expr_side);
+        continue;
+      }
+    }
+    rest.push_back(rel);
+  }
+
+  if (subst.empty()) {
+    return tresult();
+  }
+
+  Array<Var> new_variables;
+  for (const Var& v : domain->variables) {
+    if (!subst.count(v)) {
+      new_variables.push_back(v);
+    }
+  }
+  Map<Var, Range> new_ranges;
+  for (const auto& kv : domain->ranges) {
+    if (!subst.count(kv.first)) {
+      new_ranges.Set(kv.first, kv.second);
+    }
+  }
+
+  arith::Analyzer analyzer;
+  analyzer.Bind(new_ranges);
+  Array<PrimExpr> new_relations;
+  auto push_relation = [&](const PrimExpr& rel) {
+    PrimExpr simplified = analyzer.Simplify(rel, kSimplifyRewriteCanonicalRewrite);
+    if (!is_const_value(simplified, 1)) {
+      new_relations.push_back(simplified);
+    }
+  };
+  for (const PrimExpr& rel : rest) {
+    push_relation(Substitute(rel, subst));
+  }
+  // A delta var == expr additionally asserts that expr lies in the range of var;
+  // these conditions are free of domain variables, so they end up lifted outside.
+  for (const auto& kv : subst) {
+    ICHECK(domain->ranges.count(kv.first))
+        << "Range of " << kv.first << " was not provided in the domain.";
+    Range r = domain->ranges[kv.first];
+    push_relation(r->min <= kv.second);
+    push_relation(kv.second < r->min + r->extent);
+  }
+
+  Map<Var, PrimExpr> src_to_dst;
+  Map<Var, PrimExpr> dst_to_src;
+  for (const Var& v : new_variables) {
+    src_to_dst.Set(v, v);
+    dst_to_src.Set(v, v);
+  }
+  for (const auto& kv : subst) {
+    src_to_dst.Set(kv.first, kv.second);
+  }
+
+  arith::IntConstraints new_domain(new_variables, new_ranges, new_relations);
+  return tresult(arith::IntConstraintsTransform(domain, new_domain, src_to_dst, dst_to_src));
+}
+
 // Simplify an iteration domain.
 arith::IntConstraintsTransform SimplifyDomain(const arith::IntConstraints& iter_domains,
                                               bool eliminate_div_mod) {
@@ -780,6 +870,29 @@ arith::IntConstraintsTransform SimplifyDomain(const arith::IntConstraints& iter_
     transf = transf + EliminateDivModFromDomainConditions(transf->dst);
   }
 
+  // Fast path for autodiff output: factor out the Kronecker deltas first, so
+  // the solvers below see a much smaller (usually empty) system.
+  if (auto delta_transf = TryEliminateKroneckerDeltas(transf->dst)) {
+    transf = transf + delta_transf.value();
+    std::unordered_set<const VarNode*> remaining_vars;
+    for (const Var& v : transf->dst->variables) {
+      remaining_vars.insert(v.get());
+    }
+    bool solved = true;
+    for (const PrimExpr& rel : transf->dst->relations) {
+      if (tir::ExprUseVar(
+              rel, [&remaining_vars](const VarNode* v) { return remaining_vars.count(v); })) {
+        solved = false;
+        break;
+      }
+    }
+    // If no remaining relation constrains a domain variable there is nothing
+    // left to solve, only conditions for the caller to lift outside.
+    if (solved) {
+      return transf;
+    }
+  }
+
   // TODO(sgrechanik-h): Repeating the following steps has a positive effect, however we probably
   // should find a better terminating criterion (like stop when the domain volume stops decreasing)
   // Also 2 steps seems to be slightly better than 3
@@ -1230,9 +1343,50 @@ PrimExpr RemoveJacobianAndLiftNonzeroCondImpl(const PrimExpr& expr_orig, const A
   return analyzer.Simplify(result, kSimplifyRewriteCanonicalRewrite);
 }
 
+// Detect Kronecker deltas that survived simplification: an equality that still
+// constrains a reduction variable means the generated kernel iterates over a
+// region that is mostly zeros, making it asymptotically slower than necessary.
+class UnsimplifiedDeltaDetector : public ExprVisitor {
+ public:
+  bool Detect(const PrimExpr& e) {
+    found_ = false;
+    VisitExpr(e);
+    return found_;
+  }
+
+ private:
+  void VisitExpr_(const ReduceNode* op) final {
+    for (const IterVar& iv : op->axis) {
+      red_vars_.insert(iv->var.get());
+    }
+    ExprVisitor::VisitExpr_(op);
+    for (const IterVar& iv : op->axis) {
+      red_vars_.erase(iv->var.get());
+    }
+  }
+
+  void VisitExpr_(const EQNode* op) final {
+    if (!red_vars_.empty() &&
+        tir::ExprUseVar(GetRef<PrimExpr>(op),
+                        [this](const VarNode* v) { return red_vars_.count(v); })) {
+      found_ = true;
+    }
+    ExprVisitor::VisitExpr_(op);
+  }
+
+  bool found_{false};
+  std::unordered_set<const VarNode*> red_vars_;
+};
+
 Tensor RemoveJacobianAndLiftNonzeroCond(const Tensor& tensor, const Map<Var, Range>& vranges) {
-  auto transform_func = [&vranges](const PrimExpr& expr, const Array<IterVar>& axis) {
-    return RemoveJacobianAndLiftNonzeroCondImpl(expr, axis, vranges);
+  auto transform_func = [&vranges, &tensor](const PrimExpr& expr, const Array<IterVar>& axis) {
+    PrimExpr ret = RemoveJacobianAndLiftNonzeroCondImpl(expr, axis, vranges);
+    if (UnsimplifiedDeltaDetector().Detect(ret)) {
+      LOG(WARNING) << "te.Gradient could not eliminate all Kronecker deltas from the gradient of "
+                   << tensor->op->name << ": the generated backward kernel still sums over a "
+                   << "mostly-zero region and may be much slower than the forward computation.";
+    }
+    return ret;
   };
   return TransformTensorBody(tensor, transform_func);
 }
@@ -127,6 +127,15 @@ void InferRootBound(const Stage& stage, const GraphContext& ctx,
   //   - For thread index, use the thread scope.
   //
   Array<IterVar> stage_attach = ctx.attach_path.at(stage->op);
+  // The bounds inferred so far do not change while iterating over consumers,
+  // so bind them once per stage instead of once per consumer; with many
+  // consumers the repeated rebinding used to dominate bound inference time.
+  // Root iter var bindings of earlier consumers are inert for later ones
+  // since every operation has its own root iter vars.
+  arith::Analyzer analyzer;
+  for (auto entry : *rmap) {
+    analyzer.Bind(entry.first->var, entry.second);
+  }
   // The parent set.
   for (const Operation& op : consumers) {
     Map<Var, IntSet> relax_set;
@@ -179,10 +188,6 @@ void InferRootBound(const Stage& stage, const GraphContext& ctx,
     PassUpDomain(op_stage, *rmap, &up_state);
     // Relax if needed.
     std::unordered_map<const VarNode*, IntSet> dom_map;
-    arith::Analyzer analyzer;
-    for (auto entry : *rmap) {
-      analyzer.Bind(entry.first->var, entry.second);
-    }
     for (auto iv : op->root_iter_vars()) {
       Range r;
       if (up_state.count(iv)) {
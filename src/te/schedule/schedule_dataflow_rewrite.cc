@@ -187,6 +187,121 @@ Tensor Schedule::cache_read(const Tensor& tensor, const std::string& scope,
   return cache;
 }
 
+// Redirect reads of a tensor to the blocked layout of its packed copy.
+class PackedReadRewriter : public tir::StmtExprMutator {
+ public:
+  PackedReadRewriter(Tensor src, Tensor packed, Array<Integer> block_factors)
+      : src_(src), packed_(packed), block_factors_(block_factors) {}
+
+  PrimExpr VisitExpr_(const tir::ProducerLoadNode* op) final {
+    PrimExpr expr = StmtExprMutator::VisitExpr_(op);
+    op = expr.as<tir::ProducerLoadNode>();
+    if (Downcast<Tensor>(op->producer) != src_) return expr;
+    // block indices first, then the intra-block offsets.
+    Array<PrimExpr> indices;
+    for (size_t i = 0; i < op->indices.size(); ++i) {
+      indices.push_back(indexdiv(op->indices[i], block_factors_[i]));
+    }
+    for (size_t i = 0; i < op->indices.size(); ++i) {
+      indices.push_back(indexmod(op->indices[i], block_factors_[i]));
+    }
+    return tir::ProducerLoad(packed_, indices);
+  }
+
+ private:
+  Tensor src_;
+  Tensor packed_;
+  Array<Integer> block_factors_;
+};
+
+Tensor Schedule::pack(const Tensor& tensor, const Array<Integer>& block_factors,
+                      const std::string& scope, const Array<Operation>& readers) {
+  (*this)->InvalidateCache();
+  size_t ndim = tensor.ndim();
+  ICHECK_EQ(block_factors.size(), ndim) << "pack requires one block factor per dimension";
+  for (Integer factor : block_factors) {
+    ICHECK(factor.defined() && factor->value >= 1) << "pack factors must be positive constants";
+  }
+  std::ostringstream os;
+  os << tensor->op->name;
+  if (tensor->op->num_outputs() != 1) {
+    os << ".v" << tensor->value_index;
+  }
+  for (auto pair : (*this)->stage_map) {
+    auto stage = pair.second;
+    if (stage->op->name == os.str() + ".pack." + scope) {
+      os << ".d";
+    }
+  }
+  os << ".pack." << scope;
+
+  Stage s = operator[](tensor->op);
+  Tensor sugar_tensor = s->op.output(tensor->value_index);
+  arith::Analyzer analyzer;
+  Array<PrimExpr> shape;
+  bool exact = true;
+  for (size_t i = 0; i < ndim; ++i) {
+    PrimExpr factor = block_factors[i];
+    shape.push_back(analyzer.Simplify(indexdiv(sugar_tensor->shape[i] + (factor - 1), factor)));
+    exact = exact && analyzer.CanProve(indexmod(sugar_tensor->shape[i], factor) == 0);
+  }
+  for (size_t i = 0; i < ndim; ++i) {
+    shape.push_back(block_factors[i]);
+  }
+  Tensor packed = compute(
+      shape,
+      [&](const Array<Var>& i) {
+        Array<PrimExpr> src_indices;
+        PrimExpr in_range = const_true();
+        for (size_t k = 0; k < ndim; ++k) {
+          PrimExpr idx = i[k] * block_factors[k] + i[ndim + k];
+          src_indices.push_back(idx);
+          in_range = in_range && (idx < sugar_tensor->shape[k]);
+        }
+        PrimExpr value = sugar_tensor(src_indices);
+        // pad partial tail blocks; readers keep their original index range
+        // and therefore never touch the padding.
+        return exact ? value : if_then_else(in_range, value, make_zero(value.dtype()));
+      },
+      os.str());
+
+  std::unordered_map<Tensor, Tensor> vmap;
+  std::unordered_map<Tensor, Tensor> rvmap;
+  PackedReadRewriter rewriter(sugar_tensor, packed, block_factors);
+  for (Operation op : readers) {
+    Stage reader_stage = operator[](op);
+    const ComputeOpNode* reader = reader_stage->op.as<ComputeOpNode>();
+    ICHECK(reader) << "pack can only redirect compute op readers, but " << op << " is not one";
+    Array<PrimExpr> body;
+    bool changed = false;
+    for (const PrimExpr& e : reader->body) {
+      PrimExpr new_e = rewriter(e);
+      changed |= !new_e.same_as(e);
+      body.push_back(new_e);
+    }
+    ICHECK(changed) << "Cannot find " << tensor << " in the inputs of " << reader_stage->op;
+    Operation repl_op = ComputeOp(reader->name, reader->tag, reader->attrs, reader->axis, body);
+    vmap[reader_stage->op.output(0)] = repl_op.output(0);
+    rvmap[repl_op.output(0)] = reader_stage->op.output(0);
+    reader_stage->op = repl_op;
+  }
+  ReplaceDataFlow((*this)->stages, &vmap, &rvmap);
+  Array<Stage>& stages = (*this)->stages;
+  Stage op_stage = operator[](tensor->op);
+  size_t pos = FindNodeRef(stages.GetArrayNode(), op_stage);
+  Stage pack_stage = Stage(packed->op);
+  pack_stage.set_scope(scope);
+  ICHECK_LT(pos, stages.size());
+  stages.insert(stages.begin() + pos + 1, pack_stage);
+  (*this)->stage_map.Set(packed->op, pack_stage);
+  // Update group
+  pack_stage->group = op_stage->group;
+  if (pack_stage->group.defined()) {
+    ++pack_stage->group->num_child_stages;
+  }
+  return packed;
+}
+
 template <typename OpType>
 void PrepareAxisMapping(Stage orig_stage, OpType* op, std::unordered_set<IterVar>* p_red_axis,
                         Array<IterVar>* p_new_axis, std::unordered_map<IterVar, Range>* p_dom_map,
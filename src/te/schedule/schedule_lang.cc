@@ -885,6 +885,8 @@ TVM_REGISTER_GLOBAL("te.ScheduleCreateGroup").set_body_method(&Schedule::create_
 
 TVM_REGISTER_GLOBAL("te.ScheduleCacheRead").set_body_method(&Schedule::cache_read);
 
+TVM_REGISTER_GLOBAL("te.SchedulePack").set_body_method(&Schedule::pack);
+
 TVM_REGISTER_GLOBAL("te.ScheduleCacheWrite").set_body([](TVMArgs args, TVMRetValue* ret) {
   if (args[1].IsObjectRef<Tensor>()) {
     *ret = args[0].operator Schedule().cache_write(args[1].operator Tensor(), args[2]);
@@ -0,0 +1,290 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file common_subexpr_elim.cc
+ * \brief Eliminate repeated scalar subexpressions in lowered TIR.
+ *
+ *  Repeated address computations survive Simplify because the arith
+ *  rewriter works expression-local; LLVM only partially cleans them up at
+ *  -O2 and source backends (CUDA C) get no cleanup at all. This pass
+ *  hoists scalar subexpressions that occur more than once inside a loop
+ *  (or thread-extent) body into LetStmt bindings at the top of that body.
+ *
+ *  A candidate must be side-effect free. Buffer loads are hoisted only
+ *  when the body contains no store and no call that may write state, so a
+ *  binding can never observe a different value than the loads it replaces.
+ */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+/*! \brief Collect the vars a statement defines; they are out of scope above it. */
+class DefinedVarCollector : public StmtExprVisitor {
+ public:
+  void VisitStmt_(const ForNode* op) final {
+    defined_.insert(op->loop_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitStmt_(const LetStmtNode* op) final {
+    defined_.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitStmt_(const AllocateNode* op) final {
+    defined_.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+  void VisitExpr_(const LetNode* op) final {
+    defined_.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  std::unordered_set<const VarNode*> defined_;
+};
+
+/*! \brief Whether a statement contains a store or a call that may write state. */
+class WriteDetector : public StmtExprVisitor {
+ public:
+  void VisitStmt_(const StoreNode* op) final { has_write_ = true; }
+  void VisitStmt_(const BufferStoreNode* op) final { has_write_ = true; }
+  void VisitStmt_(const ProducerStoreNode* op) final { has_write_ = true; }
+  void VisitExpr_(const CallNode* op) final {
+    if (SideEffect(GetRef<PrimExpr>(op)) > CallEffectKind::kReadState) {
+      has_write_ = true;
+    } else {
+      StmtExprVisitor::VisitExpr_(op);
+    }
+  }
+  void VisitStmt(const Stmt& stmt) final {
+    if (has_write_) return;
+    StmtExprVisitor::VisitStmt(stmt);
+  }
+
+  bool has_write_{false};
+};
+
+/*! \brief Count structurally identical hoistable subexpressions in a statement. */
+class CandidateCollector : public StmtExprVisitor {
+ public:
+  struct Entry {
+    /*! \brief The expression of the first occurrence. */
+    PrimExpr expr;
+    /*! \brief Number of occurrences seen so far. */
+    int count;
+    /*! \brief Number of IR nodes in the expression. */
+    int size;
+  };
+
+  CandidateCollector(const std::unordered_set<const VarNode*>* out_of_scope, bool allow_loads)
+      : out_of_scope_(out_of_scope), allow_loads_(allow_loads) {}
+
+  void VisitExpr(const PrimExpr& expr) final {
+    if (Eligible(expr)) {
+      Record(expr);
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  /*! \brief The entry worth binding, largest first; nullptr if none repeats. */
+  const Entry* Best() const {
+    const Entry* best = nullptr;
+    for (const Entry& entry : entries_) {
+      if (entry.count < 2 || entry.size < kMinSize) continue;
+      if (best == nullptr || entry.size > best->size) best = &entry;
+    }
+    return best;
+  }
+
+ private:
+  // A lone leaf or a single cast is not worth a binding.
+  static constexpr int kMinSize = 3;
+
+  bool Eligible(const PrimExpr& expr) {
+    if (expr.as<VarNode>() || expr.as<IntImmNode>() || expr.as<FloatImmNode>() ||
+        expr.as<StringImmNode>()) {
+      return false;
+    }
+    if (expr.dtype().is_handle() || expr.dtype().lanes() != 1) return false;
+    CallEffectKind effect = SideEffect(expr);
+    if (effect > CallEffectKind::kReadState) return false;
+    if (!allow_loads_ && effect > CallEffectKind::kPure) return false;
+    // A binding is evaluated unconditionally at the top of the body, above
+    // any inner guard and even when every occurrence sits in a zero-trip
+    // loop, so a division whose divisor is not a provably nonzero constant
+    // must stay behind its guard.
+    bool safe = true;
+    PostOrderVisit(expr, [&safe](const ObjectRef& node) {
+      if (auto* div = node.as<DivNode>()) {
+        if (!NonzeroConstant(div->b)) safe = false;
+      } else if (auto* mod = node.as<ModNode>()) {
+        if (!NonzeroConstant(mod->b)) safe = false;
+      } else if (auto* fdiv = node.as<FloorDivNode>()) {
+        if (!NonzeroConstant(fdiv->b)) safe = false;
+      } else if (auto* fmod = node.as<FloorModNode>()) {
+        if (!NonzeroConstant(fmod->b)) safe = false;
+      }
+    });
+    return safe;
+  }
+
+  static bool NonzeroConstant(const PrimExpr& expr) {
+    auto* imm = expr.as<IntImmNode>();
+    return imm != nullptr && imm->value != 0;
+  }
+
+  void Record(const PrimExpr& expr) {
+    size_t hash = StructuralHash::Cached(expr);
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      Entry& entry = entries_[it->second];
+      if (StructuralEqual()(entry.expr, expr)) {
+        ++entry.count;
+        return;
+      }
+    }
+    // A candidate referencing a var defined inside the body cannot be bound
+    // above it; occurrences have identical vars, so check once per entry.
+    bool in_scope = true;
+    PostOrderVisit(expr, [this, &in_scope](const ObjectRef& node) {
+      if (auto* var = node.as<VarNode>()) {
+        if (out_of_scope_->count(var)) in_scope = false;
+      }
+    });
+    if (!in_scope) return;
+    int size = 0;
+    PostOrderVisit(expr, [&size](const ObjectRef&) { ++size; });
+    index_.emplace(hash, entries_.size());
+    entries_.push_back(Entry{expr, 1, size});
+  }
+
+  const std::unordered_set<const VarNode*>* out_of_scope_;
+  bool allow_loads_;
+  std::unordered_multimap<size_t, size_t> index_;
+  std::vector<Entry> entries_;
+};
+
+/*! \brief Replace every occurrence of one expression with a var. */
+class SubexprReplacer : public StmtExprMutator {
+ public:
+  SubexprReplacer(PrimExpr target, Var var) : target_(std::move(target)), var_(std::move(var)) {}
+
+  PrimExpr VisitExpr(const PrimExpr& expr) final {
+    if (expr->type_index() == target_->type_index() && expr.dtype() == target_.dtype() &&
+        StructuralEqual()(expr, target_)) {
+      return var_;
+    }
+    return StmtExprMutator::VisitExpr(expr);
+  }
+
+ private:
+  PrimExpr target_;
+  Var var_;
+};
+
+/*!
+ * \brief Bind the repeated subexpressions of a body right above it.
+ *
+ *  One binding is introduced per iteration, largest expression first, and
+ *  the body is re-scanned so smaller repeats remaining after a replacement
+ *  (and repeats of expressions that now contain earlier bindings' vars)
+ *  are still found. Bindings are emitted outermost-first, so later values
+ *  may reference earlier vars.
+ */
+class CommonSubexprEliminator : public StmtMutator {
+ public:
+  Stmt VisitStmt_(const ForNode* op) final {
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    Stmt body = Hoist(op->body);
+    if (body.same_as(op->body)) return stmt;
+    auto n = CopyOnWrite(op);
+    n->body = std::move(body);
+    return Stmt(n);
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<AttrStmtNode>();
+    if (op->attr_key != attr::thread_extent && op->attr_key != attr::virtual_thread) {
+      return stmt;
+    }
+    Stmt body = Hoist(op->body);
+    if (body.same_as(op->body)) return stmt;
+    auto n = CopyOnWrite(op);
+    n->body = std::move(body);
+    return Stmt(n);
+  }
+
+  Stmt Hoist(Stmt body) {
+    std::vector<std::pair<Var, PrimExpr>> bindings;
+    for (;;) {
+      DefinedVarCollector defined;
+      defined(body);
+      WriteDetector writes;
+      writes(body);
+      CandidateCollector collector(&defined.defined_, !writes.has_write_);
+      collector(body);
+      const CandidateCollector::Entry* best = collector.Best();
+      if (best == nullptr) break;
+      Var var("cse_var_" + std::to_string(++num_bindings_), best->expr.dtype());
+      body = SubexprReplacer(best->expr, var)(std::move(body));
+      bindings.emplace_back(std::move(var), best->expr);
+    }
+    for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+      body = LetStmt(it->first, it->second, body);
+    }
+    return body;
+  }
+
+ private:
+  int num_bindings_{0};
+};
+
+namespace transform {
+
+Pass CommonSubexprElim() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    CommonSubexprEliminator eliminator;
+    n->body = eliminator(std::move(n->body));
+    // the function body itself is a binding scope as well
+    n->body = eliminator.Hoist(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.CommonSubexprElim", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.CommonSubexprElim").set_body_typed(CommonSubexprElim);
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file flatten_parallel_loops.cc
+ * \brief Flatten perfectly nested serial loops into their parallel parent.
+ *
+ * A parallel loop with a small extent (a shallow batch or channel dim)
+ * underfills the thread pool: the parallel launch can hand out at most
+ * `extent` chunks of work. When such a loop perfectly nests constant-bound
+ * serial loops, the nest iterates a product space in lexicographic order, so
+ * collapsing it into a single parallel loop over the product extent is always
+ * legal and exposes the full iteration count to the launcher. The original
+ * indices are reconstructed with div/mod by the known constant bounds, which
+ * LowerIntrin strength-reduces.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+class ParallelLoopFlattener : public StmtExprMutator {
+ public:
+  Stmt VisitStmt_(const ForNode* op) final {
+    if (op->kind != ForKind::kParallel) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    // Collect the perfect nest below the parallel loop: every loop whose body
+    // is exactly the next serial loop with a zero min and a constant extent.
+    // Annotated or thread-bound loops carry meaning for later passes and stop
+    // the chain, as do vectorized and unrolled ones.
+    std::vector<const ForNode*> chain{op};
+    const ForNode* cur = op;
+    while (const ForNode* inner = cur->body.as<ForNode>()) {
+      if (inner->kind != ForKind::kSerial || !is_zero(inner->min) ||
+          !inner->extent->IsInstance<IntImmNode>() || inner->thread_binding.defined() ||
+          !inner->annotations.empty() || inner->loop_var.dtype() != op->loop_var.dtype()) {
+        break;
+      }
+      chain.push_back(inner);
+      cur = inner;
+    }
+    if (chain.size() < 2) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    // The fused variable walks the product space in the original order; the
+    // constituent indices are recovered by peeling constant strides off it.
+    DataType dtype = op->loop_var.dtype();
+    std::string fused_name = op->loop_var->name_hint;
+    for (size_t i = 1; i < chain.size(); ++i) {
+      fused_name += "." + chain[i]->loop_var->name_hint;
+    }
+    Var fused_var(fused_name + ".fused", dtype);
+    PrimExpr fused_extent = op->extent;
+    for (size_t i = 1; i < chain.size(); ++i) {
+      fused_extent = fused_extent * chain[i]->extent;
+    }
+    Map<Var, PrimExpr> index_map;
+    PrimExpr remainder = fused_var;
+    for (size_t i = chain.size() - 1; i > 0; --i) {
+      PrimExpr extent = chain[i]->extent;
+      index_map.Set(chain[i]->loop_var, analyzer_.Simplify(indexmod(remainder, extent)));
+      remainder = indexdiv(remainder, extent);
+    }
+    index_map.Set(op->loop_var, analyzer_.Simplify(op->min + remainder));
+    Stmt body = Substitute(chain.back()->body, index_map);
+    body = this->VisitStmt(body);
+    return For(fused_var, make_zero(dtype), analyzer_.Simplify(fused_extent), ForKind::kParallel,
+               body, op->thread_binding, op->annotations);
+  }
+
+ private:
+  arith::Analyzer analyzer_;
+};
+
+namespace transform {
+
+Pass FlattenParallelLoops() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = ParallelLoopFlattener()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.FlattenParallelLoops", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.FlattenParallelLoops").set_body_typed(FlattenParallelLoops);
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
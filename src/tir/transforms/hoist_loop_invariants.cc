@@ -0,0 +1,244 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file hoist_loop_invariants.cc
+ * \brief Move loop-invariant scalar computations out of loops.
+ *
+ *  HoistIfThenElse only restructures control flow; the address arithmetic
+ *  and guard conditions themselves are still recomputed every iteration,
+ *  which source backends (CUDA/C/OpenCL) emit verbatim because they get no
+ *  LLVM cleanup. This pass binds maximal subexpressions of a loop body that
+ *  reference no variable defined inside the loop into LetStmts right above
+ *  the loop, and peels invariant leading LetStmt bindings (including those
+ *  introduced by CommonSubexprElim) up through the nest so an expression
+ *  invariant to several levels ends up above all of them.
+ *
+ *  Only load-free expressions are hoisted: a hoisted value is evaluated
+ *  even when the loop runs zero times, which is safe for pure scalar
+ *  arithmetic but not for a load whose address is only valid under the
+ *  loop's guard. For the same reason div/mod by anything other than a
+ *  nonzero constant is left in place.
+ */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+/*! \brief Collect maximal invariant subexpressions of a loop body. */
+class InvariantCollector : public StmtExprVisitor {
+ public:
+  explicit InvariantCollector(const std::unordered_set<const VarNode*>* loop_defined)
+      : loop_defined_(loop_defined) {}
+
+  void VisitExpr(const PrimExpr& expr) final {
+    if (Eligible(expr)) {
+      Record(expr);
+      // Maximal only: the whole expression moves, so its pieces need no
+      // bindings of their own.
+      return;
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  /*! \brief The candidates in first-occurrence order. */
+  const std::vector<PrimExpr>& Candidates() const { return candidates_; }
+
+ private:
+  // A lone leaf or a single cast is not worth a binding.
+  static constexpr int kMinSize = 3;
+
+  bool Eligible(const PrimExpr& expr) {
+    if (expr.as<VarNode>() || expr.as<IntImmNode>() || expr.as<FloatImmNode>() ||
+        expr.as<StringImmNode>()) {
+      return false;
+    }
+    if (expr.dtype().is_handle() || expr.dtype().lanes() != 1) return false;
+    // kPure excludes loads; a hoisted load could observe memory before the
+    // stores of an enclosing iteration, or dereference a guarded address.
+    if (SideEffect(expr) != CallEffectKind::kPure) return false;
+    bool invariant = true;
+    PostOrderVisit(expr, [this, &invariant](const ObjectRef& node) {
+      if (auto* var = node.as<VarNode>()) {
+        if (loop_defined_->count(var)) invariant = false;
+      } else if (auto* div = node.as<DivNode>()) {
+        if (!NonzeroConstant(div->b)) invariant = false;
+      } else if (auto* mod = node.as<ModNode>()) {
+        if (!NonzeroConstant(mod->b)) invariant = false;
+      } else if (auto* fdiv = node.as<FloorDivNode>()) {
+        if (!NonzeroConstant(fdiv->b)) invariant = false;
+      } else if (auto* fmod = node.as<FloorModNode>()) {
+        if (!NonzeroConstant(fmod->b)) invariant = false;
+      }
+    });
+    if (!invariant) return false;
+    int size = 0;
+    PostOrderVisit(expr, [&size](const ObjectRef&) { ++size; });
+    return size >= kMinSize;
+  }
+
+  static bool NonzeroConstant(const PrimExpr& expr) {
+    auto* imm = expr.as<IntImmNode>();
+    return imm != nullptr && imm->value != 0;
+  }
+
+  void Record(const PrimExpr& expr) {
+    size_t hash = StructuralHash::Cached(expr);
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (StructuralEqual()(candidates_[it->second], expr)) return;
+    }
+    index_.emplace(hash, candidates_.size());
+    candidates_.push_back(expr);
+  }
+
+  const std::unordered_set<const VarNode*>* loop_defined_;
+  std::unordered_multimap<size_t, size_t> index_;
+  std::vector<PrimExpr> candidates_;
+};
+
+/*! \brief Replace every occurrence of the candidate expressions with their var. */
+class InvariantReplacer : public StmtExprMutator {
+ public:
+  explicit InvariantReplacer(const std::vector<std::pair<Var, PrimExpr>>* bindings)
+      : bindings_(bindings) {}
+
+  PrimExpr VisitExpr(const PrimExpr& expr) final {
+    for (const auto& binding : *bindings_) {
+      if (expr->type_index() == binding.second->type_index() &&
+          expr.dtype() == binding.second.dtype() && StructuralEqual()(expr, binding.second)) {
+        return binding.first;
+      }
+    }
+    return StmtExprMutator::VisitExpr(expr);
+  }
+
+ private:
+  const std::vector<std::pair<Var, PrimExpr>>* bindings_;
+};
+
+/*!
+ * \brief Hoist invariant computations out of every For loop, innermost first,
+ *        so values invariant to the whole nest migrate level by level to the
+ *        top of the function.
+ */
+class LoopInvariantHoister : public StmtMutator {
+ public:
+  Stmt VisitStmt_(const ForNode* op) final {
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    op = stmt.as<ForNode>();
+    // A thread binding is a scope, not a loop; nothing may move above it.
+    if (op->kind == ForKind::kThreadBinding) return stmt;
+
+    // Peel invariant leading bindings (ours from inner loops, or ones left
+    // by CommonSubexprElim) first, so a value invariant to the whole nest
+    // crosses this level instead of being rebound to a fresh var.
+    std::vector<std::pair<Var, PrimExpr>> bindings;
+    Stmt body = op->body;
+    while (auto* let = body.as<LetStmtNode>()) {
+      if (SideEffect(let->value) != CallEffectKind::kPure) break;
+      bool invariant = true;
+      PostOrderVisit(let->value, [&](const ObjectRef& node) {
+        if (auto* var = node.as<VarNode>()) {
+          if (var == op->loop_var.get()) invariant = false;
+        }
+      });
+      if (!invariant) break;
+      bindings.emplace_back(let->var, let->value);
+      body = let->body;
+    }
+
+    std::unordered_set<const VarNode*> loop_defined{op->loop_var.get()};
+    PostOrderVisit(body, [&loop_defined](const ObjectRef& node) {
+      if (auto* loop = node.as<ForNode>()) {
+        loop_defined.insert(loop->loop_var.get());
+      } else if (auto* let = node.as<LetStmtNode>()) {
+        loop_defined.insert(let->var.get());
+      } else if (auto* alloc = node.as<AllocateNode>()) {
+        loop_defined.insert(alloc->buffer_var.get());
+      } else if (auto* let = node.as<LetNode>()) {
+        loop_defined.insert(let->var.get());
+      }
+    });
+
+    InvariantCollector collector(&loop_defined);
+    collector(body);
+
+    std::vector<std::pair<Var, PrimExpr>> replacements;
+    for (const PrimExpr& expr : collector.Candidates()) {
+      // Reuse a peeled binding when the body still spells its value out.
+      Var var;
+      for (const auto& peeled : bindings) {
+        if (StructuralEqual()(peeled.second, expr)) {
+          var = peeled.first;
+          break;
+        }
+      }
+      if (!var.defined()) {
+        var = Var("licm_var_" + std::to_string(++num_bindings_), expr.dtype());
+        bindings.emplace_back(var, expr);
+      }
+      replacements.emplace_back(std::move(var), expr);
+    }
+    if (!replacements.empty()) {
+      body = InvariantReplacer(&replacements)(std::move(body));
+    }
+    if (bindings.empty()) return stmt;
+
+    auto n = CopyOnWrite(op);
+    n->body = std::move(body);
+    Stmt result = Stmt(n);
+    for (auto it = bindings.rbegin(); it != bindings.rend(); ++it) {
+      result = LetStmt(it->first, it->second, result);
+    }
+    return result;
+  }
+
+ private:
+  int num_bindings_{0};
+};
+
+namespace transform {
+
+Pass HoistLoopInvariants() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = LoopInvariantHoister()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.HoistLoopInvariants", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.HoistLoopInvariants").set_body_typed(HoistLoopInvariants);
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
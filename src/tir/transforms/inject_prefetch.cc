@@ -23,13 +23,16 @@
 // Inject prefetch op in HalideIR
 #include <tvm/arith/analyzer.h>
 #include <tvm/arith/bound.h>
+#include <tvm/arith/pattern.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
 #include <unordered_set>
+#include <vector>
 
 namespace tvm {
 namespace tir {
@@ -92,6 +95,90 @@ const Range PrefetchInjector::none;
 
 Stmt InjectPrefetch(Stmt stmt) { return PrefetchInjector()(std::move(stmt)); }
 
+struct AutoPrefetchConfigNode : public tvm::AttrsNode<AutoPrefetchConfigNode> {
+  bool enable;
+  int distance_bytes;
+
+  TVM_DECLARE_ATTRS(AutoPrefetchConfigNode, "tir.transform.AutoPrefetchConfig") {
+    TVM_ATTR_FIELD(enable).describe("Enable automatic prefetch injection").set_default(false);
+    TVM_ATTR_FIELD(distance_bytes)
+        .describe("How many bytes ahead of the current iteration to prefetch")
+        .set_default(512);
+  }
+};
+
+class AutoPrefetchConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(AutoPrefetchConfig, Attrs, AutoPrefetchConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(AutoPrefetchConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.AutoPrefetch", AutoPrefetchConfig);
+
+// Automatically prefetch streaming loads in innermost serial loops.
+// A load whose flattened index is linear in the loop variable with a
+// constant stride is prefetched distance_bytes ahead of the current
+// iteration; loads from locally allocated buffers are skipped.
+class AutoPrefetchInjector : public StmtExprMutator {
+ public:
+  explicit AutoPrefetchInjector(int distance_bytes) : distance_bytes_(distance_bytes) {}
+
+  Stmt VisitStmt_(const AllocateNode* op) final {
+    local_bufs_.insert(op->buffer_var.get());
+    return StmtExprMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    has_inner_loop_ = false;
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    bool innermost = !has_inner_loop_;
+    has_inner_loop_ = true;
+    op = stmt.as<ForNode>();
+    if (!innermost || op->kind != ForKind::kSerial) {
+      return stmt;
+    }
+    std::vector<Stmt> prefetches = MakePrefetches(op);
+    if (prefetches.empty()) {
+      return stmt;
+    }
+    return For(op->loop_var, op->min, op->extent, op->kind,
+               SeqStmt::Flatten(prefetches, op->body), op->thread_binding, op->annotations);
+  }
+
+ private:
+  std::vector<Stmt> MakePrefetches(const ForNode* op) {
+    std::vector<Stmt> result;
+    std::unordered_set<const VarNode*> prefetched;
+    Array<Var> loop_vars{op->loop_var};
+    PostOrderVisit(op->body, [&, this](const ObjectRef& obj) {
+      const LoadNode* load = obj.as<LoadNode>();
+      if (load == nullptr) return;
+      const VarNode* buf = load->buffer_var.get();
+      if (local_bufs_.count(buf) || prefetched.count(buf)) return;
+      Array<PrimExpr> coeffs = arith::DetectLinearEquation(load->index, loop_vars);
+      if (coeffs.size() != 2) return;
+      const IntImmNode* stride = coeffs[0].as<IntImmNode>();
+      if (stride == nullptr || stride->value == 0) return;
+      // Translate the byte distance into iterations of this stride.
+      int64_t stride_abs = stride->value < 0 ? -stride->value : stride->value;
+      int64_t stride_bytes = stride_abs * load->dtype.bytes();
+      int64_t iters = distance_bytes_ / stride_bytes;
+      if (iters < 1) iters = 1;
+      PrimExpr ahead = make_const(load->index.dtype(), iters * stride->value);
+      PrimExpr address =
+          Call(DataType::Handle(), builtin::address_of(),
+               {Load(load->dtype, load->buffer_var, load->index + ahead, load->predicate)});
+      result.push_back(Evaluate(Call(load->dtype, builtin::prefetch(), {address, 0, 3, 1})));
+      prefetched.insert(buf);
+    });
+    return result;
+  }
+
+  int distance_bytes_;
+  bool has_inner_loop_{false};
+  std::unordered_set<const VarNode*> local_bufs_;
+};
+
 namespace transform {
 
 Pass InjectPrefetch() {
@@ -105,6 +192,24 @@ Pass InjectPrefetch() {
 
 TVM_REGISTER_GLOBAL("tir.transform.InjectPrefetch").set_body_typed(InjectPrefetch);
 
+Pass AutoInjectPrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<AutoPrefetchConfig>("tir.AutoPrefetch");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<AutoPrefetchConfig>();
+    }
+    if (!cfg.value()->enable) {
+      return f;
+    }
+    auto* n = f.CopyOnWrite();
+    n->body = AutoPrefetchInjector(cfg.value()->distance_bytes)(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.AutoInjectPrefetch", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.AutoInjectPrefetch").set_body_typed(AutoInjectPrefetch);
+
 }  // namespace transform
 
 }  // namespace tir
@@ -0,0 +1,251 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Inject software pipelining that overlaps data fetch with compute.
+ * \file inject_software_pipeline.cc
+ *
+ *  Generalizes the rewrite done by InjectDoubleBuffer to a rolling buffer
+ *  with an arbitrary number of versions.  A producer marked with
+ *  attr::software_pipeline_scope value=N inside a loop is shifted N-1
+ *  iterations ahead of its consumers, its buffer gets N versions, and the
+ *  first N-1 copies are peeled into a predicated prologue before the loop.
+ */
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+// Detect the buffers that carry a software pipeline annotation.
+class SoftwarePipelineDetector : public StmtExprVisitor {
+ public:
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::software_pipeline_scope) {
+      const IntImmNode* depth = op->value.as<IntImmNode>();
+      ICHECK(depth != nullptr && depth->value >= 2)
+          << "software_pipeline_scope annotation must be an integer >= 2";
+      touched_[op->node.as<VarNode>()] = static_cast<int>(depth->value);
+      StmtExprVisitor::VisitStmt_(op);
+    } else {
+      StmtExprVisitor::VisitStmt_(op);
+    }
+  }
+
+  void VisitExpr_(const VarNode* op) final {
+    auto it = touched_.find(op);
+    if (it != touched_.end()) {
+      touched_.erase(it);
+    }
+  }
+  // The set of touched variables and their pipeline depth.
+  std::unordered_map<const VarNode*, int> touched_;
+};
+
+class SoftwarePipelineInjector : public StmtExprMutator {
+ public:
+  Stmt Inject(Stmt stmt) {
+    SoftwarePipelineDetector detector;
+    detector(stmt);
+    if (detector.touched_.empty()) return stmt;
+    for (const auto& kv : detector.touched_) {
+      pipeline_info_[kv.first].depth = kv.second;
+    }
+    return ConvertSSA(operator()(std::move(stmt)));
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::storage_scope) {
+      const VarNode* buf = op->node.as<VarNode>();
+      auto it = pipeline_info_.find(buf);
+      if (it != pipeline_info_.end()) {
+        it->second.scope = op->value.as<StringImmNode>()->value;
+        return this->VisitStmt(op->body);
+      } else {
+        return StmtExprMutator::VisitStmt_(op);
+      }
+    } else if (op->attr_key == attr::software_pipeline_scope) {
+      return MakeProducer(op);
+    } else {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+  }
+
+  Stmt VisitStmt_(const AllocateNode* op) final {
+    auto it = pipeline_info_.find(op->buffer_var.get());
+    if (it != pipeline_info_.end()) {
+      it->second.stride = foldl([](PrimExpr a, PrimExpr b, Span span) { return mul(a, b, span); },
+                                make_const(DataType::Int(32), 1), op->extents) *
+                          op->dtype.lanes();
+      Stmt stmt = StmtExprMutator::VisitStmt_(op);
+      op = stmt.as<AllocateNode>();
+      Array<PrimExpr> new_extents{make_const(op->extents[0].dtype(), it->second.depth)};
+      for (PrimExpr e : op->extents) {
+        new_extents.push_back(e);
+      }
+      ICHECK(it->second.loop != nullptr);
+      auto& alloc_nest = loop_allocs_[it->second.loop];
+      alloc_nest.emplace_back(
+          AttrStmt(op->buffer_var, attr::storage_scope, StringImm(it->second.scope), Evaluate(0)));
+      alloc_nest.emplace_back(
+          Allocate(op->buffer_var, op->dtype, new_extents, op->condition, Evaluate(0)));
+      return op->body;
+    } else {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    loop_nest_.push_back(op);
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    auto it = loop_pre_.find(op);
+    if (it != loop_pre_.end()) {
+      stmt = SeqStmt::Flatten(it->second, stmt);
+    }
+    it = loop_allocs_.find(op);
+    if (it != loop_allocs_.end()) {
+      stmt = MergeNest(it->second, stmt);
+    }
+    loop_nest_.pop_back();
+    return stmt;
+  }
+
+  Stmt VisitStmt_(const StoreNode* op) final {
+    Stmt stmt = StmtExprMutator::VisitStmt_(op);
+    op = stmt.as<StoreNode>();
+    auto it = pipeline_info_.find(op->buffer_var.get());
+    if (it != pipeline_info_.end()) {
+      const StorageEntry& e = it->second;
+      ICHECK(in_pipeline_scope_);
+      ICHECK(e.stride.defined());
+      return Store(op->buffer_var, op->value, e.switch_write_var * e.stride + op->index,
+                   op->predicate);
+    } else {
+      return stmt;
+    }
+  }
+
+  PrimExpr VisitExpr_(const LoadNode* op) final {
+    PrimExpr expr = StmtExprMutator::VisitExpr_(op);
+    op = expr.as<LoadNode>();
+    auto it = pipeline_info_.find(op->buffer_var.get());
+    if (it != pipeline_info_.end()) {
+      const StorageEntry& e = it->second;
+      ICHECK(e.stride.defined());
+      ICHECK(e.switch_read_var.defined());
+      return Load(op->dtype, op->buffer_var, e.switch_read_var * e.stride + op->index,
+                  op->predicate);
+    } else {
+      return expr;
+    }
+  }
+
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    ICHECK(!pipeline_info_.count(op));
+    return GetRef<PrimExpr>(op);
+  }
+
+ private:
+  Stmt MakeProducer(const AttrStmtNode* op) {
+    const Var buffer = Downcast<Var>(op->node);
+    ICHECK_NE(loop_nest_.size(), 0U) << "Software pipeline scope must be inside a loop";
+    auto it = pipeline_info_.find(buffer.get());
+    if (it == pipeline_info_.end()) {
+      LOG(WARNING) << "Skip software pipeline scope " << op->node;
+      return this->VisitStmt(op->body);
+    }
+    StorageEntry& e = it->second;
+    e.loop = loop_nest_.back();
+    DataType dtype = e.loop->loop_var.dtype();
+    PrimExpr depth = make_const(dtype, e.depth);
+    // The producer runs depth - 1 iterations ahead of its consumers, writing
+    // into the version of the buffer the consumers will reach at that point.
+    PrimExpr loop_shift = e.loop->loop_var + make_const(dtype, e.depth - 1);
+    e.switch_write_var = Var(e.loop->loop_var->name_hint + ".sp", dtype);
+    e.switch_read_var = indexmod(e.loop->loop_var, depth);
+    in_pipeline_scope_ = true;
+    Stmt body = this->VisitStmt(op->body);
+    in_pipeline_scope_ = false;
+    // Peel the first depth - 1 copies into a predicated prologue.
+    std::unordered_map<const VarNode*, PrimExpr> vmap;
+    for (int i = 0; i < e.depth - 1; ++i) {
+      PrimExpr idx = make_const(dtype, i);
+      vmap[e.switch_write_var.get()] = idx;
+      vmap[e.loop->loop_var.get()] = idx;
+      Stmt pre = Substitute(body, vmap);
+      if (i != 0) {
+        pre = IfThenElse(idx < e.loop->extent, pre);
+      }
+      loop_pre_[e.loop].emplace_back(pre);
+    }
+    vmap[e.loop->loop_var.get()] = loop_shift;
+    vmap[e.switch_write_var.get()] = indexmod(loop_shift, depth);
+    body = Substitute(body, vmap);
+    body = AttrStmt(buffer, attr::double_buffer_write, 1, body);
+    body = IfThenElse(loop_shift < e.loop->extent, body);
+    return body;
+  }
+  // Storage entry for buffers rewritten into rolling buffers.
+  struct StorageEntry {
+    // The number of buffered versions.
+    int depth{2};
+    // The size of one version of the buffer.
+    PrimExpr stride;
+    // The loop we pipeline across.
+    const ForNode* loop{nullptr};
+    // The version selector for writing.
+    Var switch_write_var;
+    // The version selector for reading.
+    PrimExpr switch_read_var;
+    // The storage scope.
+    std::string scope;
+  };
+  // Whether we are inside a software pipeline scope.
+  bool in_pipeline_scope_{false};
+  // The current loop nest
+  std::vector<const ForNode*> loop_nest_;
+  // The allocs to be appended before the loop
+  std::unordered_map<const ForNode*, std::vector<Stmt> > loop_allocs_;
+  // The stmt to be appended before the loop
+  std::unordered_map<const ForNode*, std::vector<Stmt> > loop_pre_;
+  // The storage entries of the pipelined buffers.
+  std::unordered_map<const VarNode*, StorageEntry> pipeline_info_;
+};
+
+namespace transform {
+
+Pass InjectSoftwarePipeline() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = SoftwarePipelineInjector().Inject(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectSoftwarePipeline", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InjectSoftwarePipeline").set_body_typed(InjectSoftwarePipeline);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -0,0 +1,79 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file instrument_profile_stages.cc
+ * \brief Wrap pragma-marked loop nests with stage profiling calls.
+ *
+ *  Loop nests annotated with `s[op].pragma(axis, "profile_stage", "name")`
+ *  are bracketed with calls to TVMBackendProfileStageBegin/End, which
+ *  accumulate wall time per stage in runtime::profiling::StageProfiler.
+ *  This attributes time to the individual stages of a fused kernel (e.g.
+ *  conv vs. bn vs. relu) without an external profiler. The injected symbols
+ *  resolve against the running process, so the pass targets host-side
+ *  (CPU) code; it is opt-in via the `tir.instrument_profile_stages`
+ *  pass config.
+ */
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+namespace tvm {
+namespace tir {
+
+/*! \brief The pragma key marking a profiled stage, as seen after lowering. */
+constexpr const char* kProfileStagePragma = "pragma_profile_stage";
+
+class StageInstrumenter : public StmtMutator {
+ public:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != kProfileStagePragma) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    const StringImmNode* name = op->value.as<StringImmNode>();
+    ICHECK(name != nullptr) << "profile_stage pragma expects a string stage name";
+    Stmt body = this->VisitStmt(op->body);
+    Stmt begin = Evaluate(Call(DataType::Int(32), builtin::call_extern(),
+                               {StringImm("TVMBackendProfileStageBegin"), op->value}));
+    Stmt end = Evaluate(Call(DataType::Int(32), builtin::call_extern(),
+                             {StringImm("TVMBackendProfileStageEnd"), op->value}));
+    // The pragma itself is consumed: codegen has no use for it.
+    return SeqStmt({begin, body, end});
+  }
+};
+
+namespace transform {
+
+Pass InstrumentProfileStages() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto* n = f.CopyOnWrite();
+    n->body = StageInstrumenter()(std::move(n->body));
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InstrumentProfileStages", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InstrumentProfileStages").set_body_typed(InstrumentProfileStages);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -41,12 +41,20 @@ namespace tir {
 struct LoopPartitionConfigNode : public tvm::AttrsNode<LoopPartitionConfigNode> {
   bool partition_const_loop;
   bool no_unroll_loop_with_extent_one;
+  bool auto_partition;
+  int max_auto_partition_size;
 
   TVM_DECLARE_ATTRS(LoopPartitionConfigNode, "tir.transform.LoopPartitionConfig") {
     TVM_ATTR_FIELD(partition_const_loop).describe("Split constant loop").set_default(false);
     TVM_ATTR_FIELD(no_unroll_loop_with_extent_one)
         .describe("Don't unroll loops with extent 1")
         .set_default(false);
+    TVM_ATTR_FIELD(auto_partition)
+        .describe("Split constant loops guarded by likely conditions when profitable")
+        .set_default(false);
+    TVM_ATTR_FIELD(max_auto_partition_size)
+        .describe("Maximum number of IR nodes in a loop body auto partition may duplicate")
+        .set_default(1024);
   }
 };
 
@@ -101,20 +109,36 @@ bool ExprUseVars(PrimExpr expr, const std::unordered_set<const VarNode*>& vars)
 // Rule:
 //   - the range should not be const
 //   - there exist a condition expression in the scope that use the var
+// Count the IR nodes of a statement, to estimate the cost of duplicating it.
+inline size_t CountIRNodes(const Stmt& stmt) {
+  size_t num_nodes = 0;
+  PostOrderVisit(stmt, [&num_nodes](const ObjectRef&) { ++num_nodes; });
+  return num_nodes;
+}
+
 class CandidateSelector final : public StmtExprVisitor {
  public:
   using VarIsUsed = bool;
-  explicit CandidateSelector(bool partition_const_loop)
-      : partition_const_loop_(partition_const_loop) {}
+  CandidateSelector(bool partition_const_loop, bool auto_partition, int max_auto_partition_size)
+      : partition_const_loop_(partition_const_loop),
+        auto_partition_(auto_partition),
+        max_auto_partition_size_(max_auto_partition_size) {}
 
   void VisitStmt_(const ForNode* op) final {
     // partition const loop when sets partition_const_loop_
-    if (!is_const_int(op->min) || !is_const_int(op->extent) || partition_const_loop_) {
+    bool const_loop = is_const_int(op->min) && is_const_int(op->extent);
+    if (!const_loop || partition_const_loop_ || auto_partition_) {
       const VarNode* var = op->loop_var.get();
       record_.insert({var, false});
       StmtExprVisitor::VisitStmt_(op);
       if (record_.at(var) && !no_split_) {
-        candidates.insert(GetRef<Stmt>(op));
+        // In auto mode the const loop is only split when duplicating the body
+        // for the boundary subranges stays below the size budget; inner loops
+        // with smaller bodies can still be picked up instead.
+        if (!const_loop || partition_const_loop_ ||
+            CountIRNodes(op->body) <= static_cast<size_t>(max_auto_partition_size_)) {
+          candidates.insert(GetRef<Stmt>(op));
+        }
       }
       record_.erase(var);
     } else {
@@ -179,6 +203,8 @@ class CandidateSelector final : public StmtExprVisitor {
   bool in_likely_{false};
   bool no_split_{false};
   bool partition_const_loop_{false};
+  bool auto_partition_{false};
+  int max_auto_partition_size_{0};
   std::unordered_map<const VarNode*, VarIsUsed> record_;
 };
 
@@ -338,8 +364,9 @@ class ThreadPartitionInserter : public StmtMutator {
 // likely conditions
 class LoopPartitioner : public StmtMutator {
  public:
-  explicit LoopPartitioner(bool partition_const_loop, bool no_unroll_loop_with_extent_one)
-      : selector(CandidateSelector(partition_const_loop)),
+  LoopPartitioner(bool partition_const_loop, bool no_unroll_loop_with_extent_one,
+                  bool auto_partition, int max_auto_partition_size)
+      : selector(CandidateSelector(partition_const_loop, auto_partition, max_auto_partition_size)),
         no_unroll_loop_with_extent_one_(no_unroll_loop_with_extent_one) {}
 
   Stmt VisitAndMutate(Stmt stmt) {
@@ -624,8 +651,10 @@ class RemoveLikelyTags : public StmtExprMutator {
   }
 };
 
-Stmt LoopPartition(Stmt stmt, bool partition_const_loop, bool no_unroll_loop_with_extent_one) {
-  stmt = LoopPartitioner(partition_const_loop, no_unroll_loop_with_extent_one)
+Stmt LoopPartition(Stmt stmt, bool partition_const_loop, bool no_unroll_loop_with_extent_one,
+                   bool auto_partition, int max_auto_partition_size) {
+  stmt = LoopPartitioner(partition_const_loop, no_unroll_loop_with_extent_one, auto_partition,
+                         max_auto_partition_size)
              .VisitAndMutate(std::move(stmt));
   stmt = RemoveLikelyTags()(std::move(stmt));
   return stmt;
@@ -641,7 +670,8 @@ Pass LoopPartition() {
       cfg = AttrsWithDefaultValues<LoopPartitionConfig>();
     }
     n->body = LoopPartition(std::move(n->body), cfg.value()->partition_const_loop,
-                            cfg.value()->no_unroll_loop_with_extent_one);
+                            cfg.value()->no_unroll_loop_with_extent_one,
+                            cfg.value()->auto_partition, cfg.value()->max_auto_partition_size);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.LoopPartition", {});
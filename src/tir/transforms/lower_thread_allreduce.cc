@@ -26,6 +26,7 @@
 #include <tvm/target/target.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
@@ -214,14 +215,13 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     // broadcast results from lane 0 to all other lanes and store
     // the final reduction result to the proper location.
     //
-    if (is_warp_reduction(types)) {
-      // TODO(tvm-team) sub-warp reduction support.
-      ICHECK_EQ(reduce_extent, warp_size_) << "not a warp reduction";
+    if (is_warp_reduction(types, group_extent, reduce_extent)) {
       //
       // This is the index to the reduction variable, one reduction
       // variable per warp. Local scope seems easier to reason without
       // relying on a pattern match pass to fix it later.
       PrimExpr index(0);
+      std::vector<Stmt> temp_allocs(size);
 
       for (size_t idx = 0; idx < size; ++idx) {
         Type ptr_type = PointerType(PrimType(types[idx]));
@@ -232,8 +232,8 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         // Uses a local variable to store the shuffled data.
         // Later on, this allocation will be properly attached to this statement.
         Var var("t" + std::to_string(idx), ptr_type);
-        Stmt s = Allocate(var, types[idx], {PrimExpr(1)}, pred, Evaluate(0));
-        local_vars.push_back(s);
+        temp_allocs[idx] = Allocate(var, types[idx], {PrimExpr(1)}, pred, Evaluate(0));
+        local_vars.push_back(temp_allocs[idx]);
       }
 
       // The mask for this reducer, as this reducer may sit inside
@@ -252,73 +252,107 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         local_vars.push_back(stmt);
       }
 
-      // Emit reductions within a warp.
-      for (int offset = warp_size_ / 2; offset > 0; offset /= 2) {
-        // Load reduction values, no synchronization needed.
-        Array<PrimExpr> a, b;
+      if (reduce_extent <= warp_size_) {
+        // Reduction stays within one warp, possibly a sub-warp segment.
+        // Non-power-of-two widths shuffle over the padded power of two
+        // and feed the combiner identity from the missing lanes.
+        int reduce_align = UpperPowerOfTwo(reduce_extent);
+        EmitWarpShuffleReduction(combiner, types, inits, shared_bufs, temp_allocs, mask_var,
+                                 reduce_index, reduce_align, reduce_extent, &seq);
+
+        // Broadcast the reduction result from lane 0 to all other lanes.
+        // This avoids to emit predicated stores, as all threads are
+        // uniformmly writting the same result.
+        //
         for (size_t i = 0; i < size; ++i) {
           Var var = shared_bufs[i];
           PrimExpr pred = const_true(types[i].lanes());
           PrimExpr val = Load(types[i], var, index, pred);
-          a.push_back(val);
-
-          // __shfl_*sync calls shall not appear in if_then_else expressions
-          // as this is causing extra divergency. E.g.
-          //
-          // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
-          //
-          // behaves differently from
-          //
-          // int t = __shfl_sync(mask, v1, 0);
-          // v1 = (v2 < v3) ? v3 : t;
-          //
-          // The former may cause dead lock as there is a divergent
-          // branch with a warp sync call inside.
-          //
-          PrimExpr other = WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_var, val, offset);
-          const AllocateNode* repl = local_vars[i].as<AllocateNode>();
-          Stmt s = Store(repl->buffer_var, other, index, pred);
-          seq.push_back(s);
-
-          PrimExpr load = Load(types[i], repl->buffer_var, index, pred);
-          b.push_back(load);
+          PrimExpr splat = WarpShuffle(builtin::tvm_warp_shuffle(), mask_var, val, 0, reduce_align);
+          seq.push_back(Store(var, splat, index, pred));
         }
 
-        // Do reductions.
-        Array<PrimExpr> ret = (*combiner)(a, b);
-
-        // Store the reduction result to itself.
-        std::vector<Stmt> stores(size);
+        // Update existing allocations.
         for (size_t i = 0; i < size; ++i) {
-          Var var = shared_bufs[i];
+          ICHECK(!load_remap_.count(buffers[i]));
           PrimExpr pred = const_true(types[i].lanes());
-          stores[i] = Store(var, ret[i], index, pred);
+          Var var = shared_bufs[i];
+          load_remap_[buffers[i]] = Load(types[i], var, index, pred);
+          Array<PrimExpr> extents{PrimExpr(1)};
+          auto node = Allocate(var, types[i], extents, pred, Evaluate(0));
+          alloc_remap_[buffers[i]] = node;
+          warp_allocs_.insert(node.get());
+        }
+      } else {
+        // Two-stage reduction over multiple warps: each warp first
+        // reduces its own lanes with shuffles, lane 0 of every warp
+        // publishes the partial result to shared memory, and the first
+        // warp of each group combines the staged partials.
+        int nwarps = reduce_extent / warp_size_;
+        PrimExpr lane = analyzer_.Simplify(indexmod(reduce_index, warp_size_));
+        PrimExpr warp_id = analyzer_.Simplify(indexdiv(reduce_index, warp_size_));
+
+        // The working variables become plain local allocations; the
+        // original reduction buffers are remapped to the shared staging
+        // area below.
+        std::vector<Var> staging(size);
+        for (size_t idx = 0; idx < size; ++idx) {
+          PrimExpr pred = const_true(types[idx].lanes());
+          staging[idx] =
+              Var("red_buf_staging" + std::to_string(idx), PointerType(PrimType(types[idx])));
+          local_vars.push_back(Allocate(shared_bufs[idx], types[idx], {PrimExpr(1)}, pred,
+                                        Evaluate(0)));
         }
-        seq.push_back(SeqStmt::Flatten(stores));
-      }
 
-      // Broadcast the reduction result from lane 0 to all other lanes.
-      // This avoids to emit predicated stores, as all threads are
-      // uniformmly writting the same result.
-      //
-      for (size_t i = 0; i < size; ++i) {
-        Var var = shared_bufs[i];
-        PrimExpr pred = const_true(types[i].lanes());
-        PrimExpr val = Load(types[i], var, index, pred);
-        PrimExpr splat = WarpShuffle(builtin::tvm_warp_shuffle(), mask_var, val, 0);
-        seq.push_back(Store(var, splat, index, pred));
-      }
+        // Stage 1: in-warp reduction of the full warp.
+        EmitWarpShuffleReduction(combiner, types, inits, shared_bufs, temp_allocs, mask_var, lane,
+                                 warp_size_, warp_size_, &seq);
+        {
+          std::vector<Stmt> stores(size);
+          for (size_t i = 0; i < size; ++i) {
+            PrimExpr pred = const_true(types[i].lanes());
+            PrimExpr val = Load(types[i], shared_bufs[i], index, pred);
+            stores[i] = Store(staging[i], val, StagingIndex(group_index, warp_id), pred);
+          }
+          seq.push_back(IfThenElse(lane == 0, SeqStmt::Flatten(stores)));
+          seq.push_back(SyncThread("shared"));
+        }
 
-      // Update existing allocations.
-      for (size_t i = 0; i < size; ++i) {
-        ICHECK(!load_remap_.count(buffers[i]));
-        PrimExpr pred = const_true(types[i].lanes());
-        Var var = shared_bufs[i];
-        load_remap_[buffers[i]] = Load(types[i], var, index, pred);
-        Array<PrimExpr> extents{PrimExpr(1)};
-        auto node = Allocate(var, types[i], extents, pred, Evaluate(0));
-        alloc_remap_[buffers[i]] = node;
-        warp_allocs_.insert(node.get());
+        // Stage 2: the first warp of each group reduces the partials.
+        // The staging buffers are padded to a full warp so the loads
+        // need no bound checks; lanes beyond the warp count feed the
+        // combiner identity instead.
+        std::vector<Stmt> stage2;
+        for (size_t i = 0; i < size; ++i) {
+          PrimExpr pred = const_true(types[i].lanes());
+          PrimExpr val = Load(types[i], staging[i], StagingIndex(group_index, lane), pred);
+          val = Select(lane < nwarps, val, inits[i]);
+          stage2.push_back(Store(shared_bufs[i], val, index, pred));
+        }
+        EmitWarpShuffleReduction(combiner, types, inits, shared_bufs, temp_allocs, mask_var, lane,
+                                 warp_size_, warp_size_, &stage2);
+        {
+          std::vector<Stmt> stores(size);
+          for (size_t i = 0; i < size; ++i) {
+            PrimExpr pred = const_true(types[i].lanes());
+            PrimExpr val = Load(types[i], shared_bufs[i], index, pred);
+            stores[i] = Store(staging[i], val, StagingIndex(group_index, 0), pred);
+          }
+          stage2.push_back(IfThenElse(lane == 0, SeqStmt::Flatten(stores)));
+        }
+        seq.push_back(IfThenElse(warp_id == 0, SeqStmt::Flatten(stage2)));
+        seq.push_back(SyncThread("shared"));
+
+        // All threads read the final result back from shared memory.
+        for (size_t idx = 0; idx < size; ++idx) {
+          ICHECK(!load_remap_.count(buffers[idx]));
+          PrimExpr pred = const_true(types[idx].lanes());
+          load_remap_[buffers[idx]] =
+              Load(types[idx], staging[idx], StagingIndex(group_index, 0), pred);
+          alloc_remap_[buffers[idx]] =
+              Allocate(staging[idx], types[idx], {PrimExpr(group_extent * warp_size_)}, pred,
+                       Evaluate(0));
+        }
       }
     } else {
       int threadx_extent = 1;
@@ -469,22 +503,96 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
   }
 
   // Emit warp shuffle  calls.
-  PrimExpr WarpShuffle(const Op& op, Var mask_var, PrimExpr val, int delta_or_lane) {
+  PrimExpr WarpShuffle(const Op& op, Var mask_var, PrimExpr val, int delta_or_lane, int width) {
     PrimExpr pred = const_true(1);
     PrimExpr index(0);
     PrimExpr mask = Load(DataType::UInt(32), mask_var, index, pred);
-    PrimExpr width = IntImm(DataType::Int(32), warp_size_);
-    Array<PrimExpr> args{mask, val, IntImm(DataType::Int(32), delta_or_lane), width, width};
+    Array<PrimExpr> args{mask, val, IntImm(DataType::Int(32), delta_or_lane),
+                         IntImm(DataType::Int(32), width), IntImm(DataType::Int(32), warp_size_)};
     return Call(val.dtype(), op, args);
   }
 
-  // Check if this is a reduction on threadIdx.x and its extent matches
-  // the warp size.
+  // Emit the shuffle-down reduction tree over reduce_align lanes into the
+  // local reduction buffers. When extent is smaller than reduce_align,
+  // shuffles that would read past extent feed the combiner identity so
+  // non-power-of-two widths reduce correctly.
+  void EmitWarpShuffleReduction(const CommReducerNode* combiner, const std::vector<DataType>& types,
+                                const Array<PrimExpr>& inits, const std::vector<Var>& red_bufs,
+                                const std::vector<Stmt>& temp_allocs, Var mask_var, PrimExpr lane,
+                                int reduce_align, int extent, std::vector<Stmt>* seq) {
+    size_t size = red_bufs.size();
+    PrimExpr index(0);
+    for (int offset = reduce_align / 2; offset > 0; offset /= 2) {
+      // Load reduction values, no synchronization needed.
+      Array<PrimExpr> a, b;
+      for (size_t i = 0; i < size; ++i) {
+        PrimExpr pred = const_true(types[i].lanes());
+        PrimExpr val = Load(types[i], red_bufs[i], index, pred);
+        a.push_back(val);
+
+        // __shfl_*sync calls shall not appear in if_then_else expressions
+        // as this is causing extra divergency. E.g.
+        //
+        // v1 = (v2 < v3) ? v3 : __shfl_sync(mask, v1, 0);
+        //
+        // behaves differently from
+        //
+        // int t = __shfl_sync(mask, v1, 0);
+        // v1 = (v2 < v3) ? v3 : t;
+        //
+        // The former may cause dead lock as there is a divergent
+        // branch with a warp sync call inside.
+        //
+        PrimExpr other =
+            WarpShuffle(builtin::tvm_warp_shuffle_down(), mask_var, val, offset, reduce_align);
+        const AllocateNode* repl = temp_allocs[i].as<AllocateNode>();
+        seq->push_back(Store(repl->buffer_var, other, index, pred));
+
+        PrimExpr load = Load(types[i], repl->buffer_var, index, pred);
+        if (extent != reduce_align) {
+          load = Select(lane + offset < extent, load, inits[i]);
+        }
+        b.push_back(load);
+      }
+
+      // Do reductions.
+      Array<PrimExpr> ret = (*combiner)(a, b);
+
+      // Store the reduction result to itself.
+      std::vector<Stmt> stores(size);
+      for (size_t i = 0; i < size; ++i) {
+        PrimExpr pred = const_true(types[i].lanes());
+        stores[i] = Store(red_bufs[i], ret[i], index, pred);
+      }
+      seq->push_back(SeqStmt::Flatten(stores));
+    }
+  }
+
+  // The index into the per-warp staging buffer of a group.
+  PrimExpr StagingIndex(PrimExpr group_index, PrimExpr offset) {
+    if (is_zero(group_index)) {
+      return offset;
+    }
+    return analyzer_.Simplify(group_index * warp_size_ + offset);
+  }
+
+  // The smallest power of two that is not less than n.
+  static int UpperPowerOfTwo(int n) {
+    int pow2 = 1;
+    while (pow2 < n) {
+      pow2 = pow2 << 1;
+    }
+    return pow2;
+  }
+
+  // Check if this reduction can be lowered with warp level primitives:
+  // the reduction must be carried by threadIdx.x and its extent either
+  // fits within a single warp or spans a whole number of warps.
   //
-  // TODO(tvm-team) reduction with a sub-warp of 8 or 16 threads.
   // Note: The ROCm backend will only have warp reductions for now.
   // Also, the warp/wavefront size differs (64 on rocm, 32 on cuda).
-  bool is_warp_reduction(const std::vector<DataType>& types) const {
+  bool is_warp_reduction(const std::vector<DataType>& types, int group_extent,
+                         int reduce_extent) const {
     // Only cuda target supports warp reductions.
     if ((target_->kind->name != "cuda") && (target_->kind->name != "rocm")) return false;
 
@@ -521,7 +629,20 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       e.extent = static_cast<int>(ptr->value);
     }
 
-    return e.extent == warp_size_ && e.scope.dim_index == 0 && e.scope.rank == 1;
+    if (e.scope.dim_index != 0 || e.scope.rank != 1) return false;
+    // The reduction must be exactly the innermost thread dimension.
+    if (e.extent != reduce_extent || reduce_extent < 2) return false;
+    if (reduce_extent <= warp_size_) {
+      // Sub-warp segments keep their lane alignment only for power of
+      // two widths. Other widths use masked shuffles, which requires the
+      // reduction to own the whole warp partition.
+      bool is_pow2 = (reduce_extent & (reduce_extent - 1)) == 0;
+      return is_pow2 || group_extent == 1;
+    }
+    // Multiple warps: lane 0 of each warp stages its partial result and
+    // the first warp combines them, as long as one warp can hold all of
+    // the per-warp partials.
+    return reduce_extent % warp_size_ == 0 && reduce_extent / warp_size_ <= warp_size_;
   }
 
   // The target.
@@ -27,7 +27,9 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "ir_utils.h"
 
@@ -44,6 +46,39 @@ inline PrimExpr StackAlloca(std::string type, size_t num) {
   return Call(DataType::Handle(), builtin::tvm_stack_alloca(), args);
 }
 
+// Collect the constant-size workspace allocations of a function so they can
+// be folded into one statically planned workspace buffer.
+class WorkspacePlanner : public StmtVisitor {
+ public:
+  void VisitStmt_(const ForNode* op) final {
+    if (op->kind == ForKind::kParallel) {
+      // Each worker thread needs its own allocation, keep those
+      // on the per-allocation path.
+      return;
+    }
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    int64_t nbytes = GetVectorBytes(op->dtype);
+    bool const_size = true;
+    for (const PrimExpr& e : op->extents) {
+      const IntImmNode* imm = e.as<IntImmNode>();
+      if (imm == nullptr) {
+        const_size = false;
+        break;
+      }
+      nbytes *= imm->value;
+    }
+    if (const_size && nbytes > 0) {
+      entries_.emplace_back(op->buffer_var.get(), static_cast<uint64_t>(nbytes));
+    }
+    StmtVisitor::VisitStmt_(op);
+  }
+  // The planned allocations and their sizes in bytes.
+  std::vector<std::pair<const VarNode*, uint64_t>> entries_;
+};
+
 // Calculate the statistics of packed function.
 // These information are needed during codegen.
 class BuiltinLower : public StmtExprMutator {
@@ -64,7 +99,52 @@ class BuiltinLower : public StmtExprMutator {
     uint64_t run_arg_stack{0};
   };
 
-  Stmt Build(Stmt stmt) { return this->VisitBodyAndRealizeAlloca(stmt); }
+  Stmt Build(Stmt stmt) {
+    // Assign static offsets in one shared workspace to the constant-size
+    // allocations, so the function issues a single workspace request that
+    // the runtime pool can reuse across all kernels of a graph plan.
+    WorkspacePlanner planner;
+    planner(stmt);
+    if (planner.entries_.size() >= 2) {
+      uint64_t total = 0;
+      for (const auto& kv : planner.entries_) {
+        ws_offset_[kv.first] = total;
+        total += (kv.second + runtime::kTempAllocaAlignment - 1) / runtime::kTempAllocaAlignment *
+                 runtime::kTempAllocaAlignment;
+      }
+      if (total <= static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        ws_total_ = total;
+      } else {
+        // Offsets are emitted as int32 indices, fall back for huge plans.
+        ws_offset_.clear();
+      }
+    }
+    stmt = this->VisitBodyAndRealizeAlloca(stmt);
+    if (!ws_offset_.empty()) {
+      ICHECK(device_type_.defined()) << "Unknown device type in current IR";
+      ICHECK(device_id_.defined()) << "Unknown device id in current IR";
+      Stmt throw_last_error =
+          Evaluate(Call(DataType::Int(32), builtin::tvm_throw_last_error(), {}));
+      Stmt body = SeqStmt(
+          {IfThenElse(Call(DataType::Bool(1), builtin::isnullptr(), {ws_base_}), throw_last_error),
+           stmt});
+      Stmt alloca = LetStmt(
+          ws_base_,
+          Call(ws_base_.dtype(), Op::Get("tir.TVMBackendAllocWorkspace"),
+               {cast(DataType::Int(32), device_type_), cast(DataType::Int(32), device_id_),
+                make_const(DataType::UInt(64), ws_total_), IntImm(DataType::Int(32), kDLUInt),
+                IntImm(DataType::Int(32), 8)}),
+          body);
+      PrimExpr free_op = Call(DataType::Int(32), Op::Get("tir.TVMBackendFreeWorkspace"),
+                              {cast(DataType::Int(32), device_type_),
+                               cast(DataType::Int(32), device_id_), ws_base_});
+      Stmt free_stmt = IfThenElse(free_op != make_zero(DataType::Int(32)), throw_last_error);
+      stmt = SeqStmt({alloca, free_stmt});
+      stmt = AttrStmt(ws_base_, attr::storage_alignment,
+                      make_const(DataType::Int(32), runtime::kTempAllocaAlignment), stmt);
+    }
+    return stmt;
+  }
 
   // Allcoate stack frames, only at parallel-for or root.
   Stmt VisitBodyAndRealizeAlloca(Stmt stmt) {
@@ -112,6 +192,17 @@ class BuiltinLower : public StmtExprMutator {
     // Lower allocate to device allocate when needed.
     Stmt stmt = StmtExprMutator::VisitStmt_(op);
     op = stmt.as<AllocateNode>();
+    auto it = ws_offset_.find(op->buffer_var.get());
+    if (it != ws_offset_.end()) {
+      // The buffer got a static offset in the shared workspace.
+      PrimExpr addr =
+          Call(DataType::Handle(), builtin::address_of(),
+               {Load(DataType::UInt(8), ws_base_, ConstInt32(it->second), const_true())});
+      Stmt body = LetStmt(op->buffer_var, addr, op->body);
+      body = AttrStmt(op->buffer_var, attr::storage_alignment,
+                      make_const(DataType::Int(32), runtime::kTempAllocaAlignment), body);
+      return body;
+    }
     // Get constant allocation bound.
     int64_t nbytes = GetVectorBytes(op->dtype);
     PrimExpr total_bytes = make_const(op->extents[0].dtype(), nbytes);
@@ -367,6 +458,10 @@ class BuiltinLower : public StmtExprMutator {
   std::vector<std::vector<Stmt>> prep_seq_stack_;
   PrimExpr device_type_;
   PrimExpr device_id_;
+  // The shared workspace buffer and the static offsets assigned into it.
+  Var ws_base_{"workspace", DataType::Handle()};
+  std::unordered_map<const VarNode*, uint64_t> ws_offset_;
+  uint64_t ws_total_{0};
 
   // Record all stack frames.
   std::vector<AllocaScope> alloca_scope_;
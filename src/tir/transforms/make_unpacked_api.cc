@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file make_unpacked_api.cc Lower PrimFunc to a C API that takes raw data
+ *  pointers instead of the packed calling convention.
+ */
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/buffer.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <utility>
+#include <vector>
+
+#include "arg_binder.h"
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+PrimFunc MakeUnpackedAPI(PrimFunc&& func) {
+  auto global_symbol = func->GetAttr<String>(tvm::attr::kGlobalSymbol);
+  ICHECK(global_symbol) << "MakeUnpackedAPI: Expect PrimFunc to have the global_symbol attribute";
+
+  auto target = func->GetAttr<Target>(tvm::attr::kTarget);
+  ICHECK(target.defined()) << "MakeUnpackedAPI: Require the target attribute";
+  int target_device_type = target.value()->kind->device_type;
+
+  auto* func_ptr = func.CopyOnWrite();
+  const Stmt nop = Evaluate(0);
+
+  // Every buffer argument is replaced by a plain handle carrying its data
+  // pointer; the buffer var is bound to the handle so the body is unchanged.
+  // Shapes and strides stay symbolic-free because callers of this API are
+  // compiled together with the function and agree on the layout statically.
+  Array<Var> args;
+  std::unordered_map<const VarNode*, PrimExpr> vmap;
+  ArgBinder binder(&vmap);
+
+  for (size_t i = 0; i < func_ptr->params.size(); ++i) {
+    Var param = func_ptr->params[i];
+    auto it = func_ptr->buffer_map.find(param);
+    if (it != func_ptr->buffer_map.end()) {
+      const Buffer& buffer = (*it).second;
+      Var v_arg(buffer->data->name_hint, DataType::Handle());
+      binder.Bind(buffer->data, v_arg, v_arg->name_hint, true);
+      args.push_back(v_arg);
+    } else {
+      args.push_back(param);
+    }
+  }
+
+  // Set the device context so that workspace allocations inside the
+  // function can still be lowered.
+  PrimExpr node = StringImm("default");
+  Integer device_type(target_device_type);
+  Integer device_id(0);
+  std::vector<Stmt> device_init;
+  device_init.push_back(AttrStmt(node, attr::device_id, device_id, nop));
+  device_init.push_back(AttrStmt(node, attr::device_type, device_type, nop));
+
+  func_ptr->body = MergeNest({device_init, binder.init_nest()}, func_ptr->body);
+  func_ptr->params = args;
+
+  Array<Var> undefined = UndefinedVars(func_ptr->body, func_ptr->params);
+  if (undefined.size() != 0) {
+    std::ostringstream os;
+    for (Var v : undefined) {
+      os << " \'" << v->name_hint << "\' ";
+    }
+    os << " is not bound to any variables";
+    LOG(FATAL) << "Not all Vars are passed in api_args: " << os.str();
+  }
+
+  func_ptr->buffer_map = Map<Var, Buffer>();
+  func_ptr->checked_type_ = func_ptr->func_type_annotation();
+  func_ptr->ret_type = PrimType(DataType::Int(32));
+
+  // return the function.
+  return std::move(func);
+}
+
+namespace transform {
+
+Pass MakeUnpackedAPI() {
+  auto pass_func = [](IRModule m, PassContext ctx) {
+    IRModuleNode* mptr = m.CopyOnWrite();
+    std::vector<std::pair<GlobalVar, PrimFunc> > updates;
+
+    for (const auto& kv : mptr->functions) {
+      if (auto* n = kv.second.as<PrimFuncNode>()) {
+        PrimFunc func = GetRef<PrimFunc>(n);
+        if (func->GetAttr<Integer>(tvm::attr::kCallingConv, Integer(CallingConv::kDefault)) ==
+            CallingConv::kDefault) {
+          auto updated_func = MakeUnpackedAPI(std::move(func));
+          updates.push_back({kv.first, updated_func});
+        }
+      }
+    }
+
+    for (const auto& pair : updates) {
+      mptr->AddUnchecked(pair.first, pair.second);
+    }
+    return m;
+  };
+
+  return tvm::transform::CreateModulePass(pass_func, 0, "tir.MakeUnpackedAPI", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.MakeUnpackedAPI").set_body_typed(MakeUnpackedAPI);
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
@@ -23,10 +23,15 @@
  */
 
 #include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/op.h>
+#include <tvm/tir/stmt.h>
 #include <tvm/tir/transform.h>
 
+#include <unordered_map>
+#include <utility>
+
 #include "../../arith/ir_mutator_with_analyzer.h"
 #include "../../arith/ir_visitor_with_analyzer.h"
 
@@ -72,20 +77,30 @@ using arith::IRMutatorWithAnalyzer;
 // Otherwise, `var` is not narrowed, that is, `vmap[var] = var.dtype.bits()`
 class DataTypeVisitor final : public StmtExprVisitor {
  public:
-  explicit DataTypeVisitor(int target_bits) : bits_(target_bits), target_bits_(target_bits) {}
+  explicit DataTypeVisitor(int target_bits, bool assume_fits = false)
+      : bits_(target_bits), target_bits_(target_bits), assume_fits_(assume_fits) {}
 
   void VisitExpr(const PrimExpr& e) {
     if (e.dtype().is_int()) {
       int bits = max_bits_;
-      if (bound_.find(e) == bound_.end()) {
-        analyzer_.const_int_bound(e, &bound_);
-      }
-      ConstIntBound bound = bound_[e];
-      int64_t ubound = Downcast<IntImm>(max_value(DataType::Int(target_bits_)))->value;
-      int64_t lbound = Downcast<IntImm>(min_value(DataType::Int(target_bits_)))->value;
-      if (e.dtype().bits() <= target_bits_ ||
-          (bound->max_value <= ubound && bound->min_value >= lbound)) {
-        bits = target_bits_;
+      if (assume_fits_) {
+        // Guarded mode: indices and extents are assumed to fit (the caller
+        // emits a runtime guard); everything else keeps its width so the
+        // assumption can never leak into stored values.
+        if (safe_ctx_ || e.dtype().bits() <= target_bits_) {
+          bits = target_bits_;
+        }
+      } else {
+        if (bound_.find(e) == bound_.end()) {
+          analyzer_.const_int_bound(e, &bound_);
+        }
+        ConstIntBound bound = bound_[e];
+        int64_t ubound = Downcast<IntImm>(max_value(DataType::Int(target_bits_)))->value;
+        int64_t lbound = Downcast<IntImm>(min_value(DataType::Int(target_bits_)))->value;
+        if (e.dtype().bits() <= target_bits_ ||
+            (bound->max_value <= ubound && bound->min_value >= lbound)) {
+          bits = target_bits_;
+        }
       }
       int tmp = bits > bits_ ? bits : bits_;
       std::swap(bits_, tmp);
@@ -99,7 +114,14 @@ class DataTypeVisitor final : public StmtExprVisitor {
   void VisitStmt_(const ForNode* op) {
     analyzer_.Bind(op->loop_var, Range::FromMinExtent(op->min, op->extent));
     vextent_[op->loop_var.as<VarNode>()] = op->extent.dtype();
-    return StmtExprVisitor::VisitStmt_(op);
+    {
+      bool tmp = true;
+      std::swap(safe_ctx_, tmp);
+      this->VisitExpr(op->min);
+      this->VisitExpr(op->extent);
+      std::swap(safe_ctx_, tmp);
+    }
+    this->VisitStmt(op->body);
   }
 
   void VisitStmt_(const AttrStmtNode* op) {
@@ -108,12 +130,37 @@ class DataTypeVisitor final : public StmtExprVisitor {
       ICHECK_NE(iv->thread_tag.length(), 0U);
       analyzer_.Bind(iv->var, Range::FromMinExtent(0, op->value));
       vextent_[iv->var.as<VarNode>()] = op->value.dtype();
-      StmtExprVisitor::VisitStmt_(op);
+      bool tmp = true;
+      std::swap(safe_ctx_, tmp);
+      this->VisitExpr(op->value);
+      std::swap(safe_ctx_, tmp);
+      this->VisitStmt(op->body);
     } else {
       StmtExprVisitor::VisitStmt_(op);
     }
   }
 
+  void VisitStmt_(const StoreNode* op) {
+    this->VisitExpr(op->value);
+    {
+      bool tmp = true;
+      std::swap(safe_ctx_, tmp);
+      this->VisitExpr(op->index);
+      std::swap(safe_ctx_, tmp);
+    }
+    this->VisitExpr(op->predicate);
+  }
+
+  void VisitExpr_(const LoadNode* op) {
+    {
+      bool tmp = true;
+      std::swap(safe_ctx_, tmp);
+      this->VisitExpr(op->index);
+      std::swap(safe_ctx_, tmp);
+    }
+    this->VisitExpr(op->predicate);
+  }
+
   void VisitExpr_(const ReduceNode* op) {
     // Setup the domain information before simplification.
     for (const IterVar& iv : op->axis) {
@@ -135,6 +182,17 @@ class DataTypeVisitor final : public StmtExprVisitor {
         // We take maximum bits for all the possible Expr where a var occurs
         vmap[op] = op->dtype.with_bits(std::max(vmap[op].bits(), bits));
       }
+    } else if (assume_fits_ && op->dtype.is_int() && op->dtype.bits() > target_bits_) {
+      // In guarded mode free vars (dynamic shape parameters) take part in
+      // index computations, so they are narrowed the same way; occurrences
+      // outside index or extent positions keep them at full width through
+      // the usual maximum rule.
+      int bits = std::min(op->dtype.bits(), bits_);
+      if (vmap.find(op) == vmap.end()) {
+        vmap[op] = op->dtype.with_bits(bits);
+      } else {
+        vmap[op] = op->dtype.with_bits(std::max(vmap[op].bits(), bits));
+      }
     }
     StmtExprVisitor::VisitExpr_(op);
   }
@@ -181,6 +239,10 @@ class DataTypeVisitor final : public StmtExprVisitor {
   int bits_;
   // the target bits
   int target_bits_;
+  // whether indices are assumed to fit (guarded narrowing)
+  bool assume_fits_;
+  // whether the visitor is inside an index or extent expression
+  bool safe_ctx_{false};
   // the extent of vars to be rewritten
   std::unordered_map<const VarNode*, DataType> vextent_;
   // the memorized bound generated by ConstIntBoundAnalyzer
@@ -189,7 +251,11 @@ class DataTypeVisitor final : public StmtExprVisitor {
 
 class DataTypeRewriter : public StmtExprMutator {
  public:
-  explicit DataTypeRewriter(int target_bits) : visitor_(target_bits) {}
+  explicit DataTypeRewriter(int target_bits, bool assume_fits = false)
+      : visitor_(target_bits, assume_fits) {}
+
+  /*! \brief Narrowed replacement of every rewritten var. */
+  const std::unordered_map<const VarNode*, Var>& var_remap() const { return vmap_; }
 
   Stmt operator()(Stmt s) {
     visitor_(s);
@@ -390,6 +456,53 @@ Pass NarrowDataType(int target_bits) {
 
 TVM_REGISTER_GLOBAL("tir.transform.NarrowDataType").set_body_typed(NarrowDataType);
 
+Pass GuardedNarrowDataType(int target_bits) {
+  auto pass_func = [target_bits](PrimFunc f, IRModule m, PassContext ctx) {
+    DataTypeRewriter rewriter(target_bits, /*assume_fits=*/true);
+    Stmt narrowed = rewriter(f->body);
+    if (narrowed.same_as(f->body)) {
+      return f;
+    }
+    // Bind narrowed copies of the free vars (dynamic shape parameters)
+    // right above the fast path.
+    bool has_free_remap = false;
+    for (const Var& v : UndefinedVars(f->body, {})) {
+      auto it = rewriter.var_remap().find(v.get());
+      if (it != rewriter.var_remap().end()) {
+        narrowed = LetStmt(it->second, cast(it->second.dtype(), v), narrowed);
+        has_free_remap = true;
+      }
+    }
+    // Every flattened buffer access is in bounds, so indices fit into the
+    // target type whenever each buffer's element count does; guard on that.
+    int64_t limit = Downcast<IntImm>(max_value(DataType::Int(target_bits)))->value;
+    PrimExpr guard = const_true();
+    for (const auto& kv : f->buffer_map) {
+      PrimExpr size = make_const(DataType::Int(64), 1);
+      for (const PrimExpr& dim : kv.second->shape) {
+        size = size * cast(DataType::Int(64), dim);
+      }
+      guard = guard && (size <= make_const(DataType::Int(64), limit));
+    }
+    Analyzer analyzer;
+    guard = analyzer.Simplify(guard);
+    if (is_one(guard) && has_free_remap) {
+      // free vars but no buffer to bound them with: cannot justify a guard
+      return f;
+    }
+    auto* n = f.CopyOnWrite();
+    if (is_one(guard)) {
+      n->body = std::move(narrowed);
+    } else if (!is_zero(guard)) {
+      n->body = IfThenElse(guard, narrowed, n->body);
+    }
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.GuardedNarrowDataType", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.GuardedNarrowDataType").set_body_typed(GuardedNarrowDataType);
+
 }  // namespace transform
 }  // namespace tir
 }  // namespace tvm
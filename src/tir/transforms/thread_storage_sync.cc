@@ -30,6 +30,11 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/tir/op.h>
+
+#include "../../arith/interval_set.h"
 #include "../../runtime/thread_storage_scope.h"
 #include "ir_utils.h"
 #include "storage_access.h"
@@ -182,20 +187,85 @@ class ThreadSyncPlanner : public StorageAccessVisitor {
       if (x.buffer.same_as(e.buffer)) {
         // Assumes no race between threads
         // Same index value means no conflicts
-        // TODO(tqchen) more standard set based testing.
         if (e.touched.IsSinglePoint() && x.touched.IsSinglePoint()) {
           if (ExprDeepEqual()(e.touched.PointValue(), x.touched.PointValue())) continue;
         }
+        // Access ranges that can never overlap between two threads
+        // do not need a barrier either.
+        const auto* x_int = x.touched.as<arith::IntervalSetNode>();
+        const auto* e_int = e.touched.as<arith::IntervalSetNode>();
+        if (x_int && e_int && x_int->HasLowerBound() && x_int->HasUpperBound() &&
+            e_int->HasLowerBound() && e_int->HasUpperBound()) {
+          if (PerThreadDisjoint(x_int, e_int)) continue;
+          // Thread-invariant ranges can be compared directly.
+          if (!UsesEnvThread(x_int) && !UsesEnvThread(e_int) &&
+              (analyzer_.CanProve(x_int->max_value < e_int->min_value) ||
+               analyzer_.CanProve(e_int->max_value < x_int->min_value))) {
+            continue;
+          }
+        }
         if (x.double_buffer_write && e.type == kRead && !loop_carry) continue;
         return true;
       }
     }
     return false;
   }
+  // Check whether the two access ranges can never overlap between two
+  // different threads.  Both bounds must be linear in the same thread index
+  // with one equal constant stride, and the combined extent of the residual
+  // ranges has to stay below that stride.
+  bool PerThreadDisjoint(const arith::IntervalSetNode* x, const arith::IntervalSetNode* e) {
+    for (const IterVar& iv : env_threads()) {
+      Array<Var> tvar{iv->var};
+      Array<PrimExpr> x_min = arith::DetectLinearEquation(x->min_value, tvar);
+      Array<PrimExpr> x_max = arith::DetectLinearEquation(x->max_value, tvar);
+      Array<PrimExpr> e_min = arith::DetectLinearEquation(e->min_value, tvar);
+      Array<PrimExpr> e_max = arith::DetectLinearEquation(e->max_value, tvar);
+      if (x_min.size() != 2 || x_max.size() != 2 || e_min.size() != 2 || e_max.size() != 2) {
+        continue;
+      }
+      const IntImmNode* stride = x_min[0].as<IntImmNode>();
+      if (stride == nullptr || stride->value == 0) continue;
+      ExprDeepEqual deep_equal;
+      if (!deep_equal(x_min[0], x_max[0]) || !deep_equal(x_min[0], e_min[0]) ||
+          !deep_equal(x_min[0], e_max[0])) {
+        continue;
+      }
+      // The residual bounds must not depend on any other thread index.
+      if (UsesEnvThreadExpr(x_min[1]) || UsesEnvThreadExpr(x_max[1]) ||
+          UsesEnvThreadExpr(e_min[1]) || UsesEnvThreadExpr(e_max[1])) {
+        continue;
+      }
+      int64_t stride_abs = stride->value < 0 ? -stride->value : stride->value;
+      PrimExpr lo = min(x_min[1], e_min[1]);
+      PrimExpr hi = max(x_max[1], e_max[1]);
+      if (analyzer_.CanProve(hi - lo < make_const(hi.dtype(), stride_abs))) {
+        return true;
+      }
+    }
+    return false;
+  }
+  // Check whether an expression references one of the environment threads.
+  bool UsesEnvThreadExpr(const PrimExpr& expr) {
+    bool used = false;
+    PostOrderVisit(expr, [this, &used](const ObjectRef& obj) {
+      if (const VarNode* v = obj.as<VarNode>()) {
+        for (const IterVar& iv : env_threads()) {
+          if (iv->var.get() == v) used = true;
+        }
+      }
+    });
+    return used;
+  }
+  bool UsesEnvThread(const arith::IntervalSetNode* set) {
+    return UsesEnvThreadExpr(set->min_value) || UsesEnvThreadExpr(set->max_value);
+  }
 
  private:
   // synchronization scope
   StorageScope sync_scope_;
+  // analyzer used to prove access ranges disjoint
+  arith::Analyzer analyzer_;
 };
 
 class ThreadSyncInserter : public StmtExprMutator {
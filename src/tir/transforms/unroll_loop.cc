@@ -23,6 +23,8 @@
  */
 // Unrolls the loop as in Halide pipeline.
 #include <tvm/arith/analyzer.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
@@ -43,6 +45,8 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
   int auto_max_depth;
   int auto_max_extent;
   int explicit_unroll;
+  int auto_max_body_size;
+  int auto_max_live_values;
 
   TVM_DECLARE_ATTRS(UnrollLoopConfigNode, "tir.transform.UnrollLoopConfig") {
     TVM_ATTR_FIELD(auto_max_step)
@@ -57,6 +61,16 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
     TVM_ATTR_FIELD(explicit_unroll)
         .describe("Whether to explicitly unroll the loop instead of setting a pragma")
         .set_default(true);
+    TVM_ATTR_FIELD(auto_max_body_size)
+        .describe(
+            "Maximum number of IR nodes the unrolled body may expand to, an icache "
+            "proxy; 0 disables the limit")
+        .set_default(0);
+    TVM_ATTR_FIELD(auto_max_live_values)
+        .describe(
+            "Maximum estimated live values of the unrolled body, a register pressure "
+            "proxy; 0 disables the limit")
+        .set_default(0);
   }
 };
 
@@ -68,14 +82,76 @@ class UnrollLoopConfig : public Attrs {
 TVM_REGISTER_NODE_TYPE(UnrollLoopConfigNode);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.UnrollLoop", UnrollLoopConfig);
 
+/*!
+ * \brief Estimate what unrolling a loop costs.
+ *
+ *  body_size counts IR nodes and stands in for icache footprint.
+ *  live_values counts distinct loads plus let bindings: after unrolling
+ *  each iteration materializes its own copies, so both multiplied by the
+ *  extent approximate the expanded footprint and the register pressure.
+ *  The step_count thresholds alone cannot see either, which is why they
+ *  routinely lose to hand-picked unroll factors on large bodies.
+ */
+class UnrollCostEstimator : public StmtExprVisitor {
+ public:
+  void VisitStmt(const Stmt& stmt) final {
+    ++body_size_;
+    StmtExprVisitor::VisitStmt(stmt);
+  }
+
+  void VisitExpr(const PrimExpr& expr) final {
+    ++body_size_;
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  void VisitExpr_(const LoadNode* op) final {
+    RecordLoad(GetRef<PrimExpr>(op));
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    ++num_lets_;
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const LetStmtNode* op) final {
+    ++num_lets_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  /*! \brief Number of IR nodes of one iteration. */
+  int body_size() const { return body_size_; }
+  /*! \brief Estimated live values of one iteration. */
+  int live_values() const { return static_cast<int>(loads_.size()) + num_lets_; }
+
+ private:
+  void RecordLoad(const PrimExpr& expr) {
+    // loads of the same address share a register, so count distinct ones
+    size_t hash = StructuralHash::Cached(expr);
+    auto range = load_index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (StructuralEqual()(loads_[it->second], expr)) return;
+    }
+    load_index_.emplace(hash, loads_.size());
+    loads_.push_back(expr);
+  }
+
+  int body_size_{0};
+  int num_lets_{0};
+  std::unordered_multimap<size_t, size_t> load_index_;
+  std::vector<PrimExpr> loads_;
+};
+
 class LoopUnroller : public StmtExprMutator {
  public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth, int auto_max_extent,
-                        bool explicit_unroll)
+                        bool explicit_unroll, int auto_max_body_size, int auto_max_live_values)
       : auto_max_step_(auto_max_step),
         auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent),
-        explicit_unroll_(explicit_unroll) {}
+        explicit_unroll_(explicit_unroll),
+        auto_max_body_size_(auto_max_body_size),
+        auto_max_live_values_(auto_max_live_values) {}
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
@@ -106,6 +182,20 @@ class LoopUnroller : public StmtExprMutator {
     auto_unroll =
         auto_unroll && (value * step_count_ <= auto_max_step_ || value <= auto_max_extent_);
 
+    // Profitability: stay within the expanded-body and register budgets.
+    // The body has already been mutated, so inner unrolled loops count at
+    // their expanded size. Explicit kUnrolled requests are never blocked.
+    if (auto_unroll && (auto_max_body_size_ > 0 || auto_max_live_values_ > 0)) {
+      UnrollCostEstimator estimator;
+      estimator(op->body);
+      if (auto_max_body_size_ > 0 && value * estimator.body_size() > auto_max_body_size_) {
+        auto_unroll = false;
+      }
+      if (auto_max_live_values_ > 0 && value * estimator.live_values() > auto_max_live_values_) {
+        auto_unroll = false;
+      }
+    }
+
     if (op->kind == ForKind::kUnrolled) {
       ICHECK_GE(value, 0) << "Cannot unroll non-constant loop";
       auto_unroll = true;
@@ -198,6 +288,10 @@ class LoopUnroller : public StmtExprMutator {
   // this not not count the total steps, only count the number of loops
   int auto_max_extent_;
   bool explicit_unroll_;
+  // expanded body size budget (icache proxy), 0 means unlimited
+  int auto_max_body_size_;
+  // expanded live value budget (register proxy), 0 means unlimited
+  int auto_max_live_values_;
   // Number of normal loops in scope
   int normal_loop_depth_{0};
   // number of unrolled cases in current scope.
@@ -210,7 +304,8 @@ class LoopUnroller : public StmtExprMutator {
 
 Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll)(stmt);
+                          cfg->explicit_unroll, cfg->auto_max_body_size,
+                          cfg->auto_max_live_values)(stmt);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -218,6 +313,33 @@ Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
   }
 }
 
+/*!
+ * \brief Report the unroll cost estimate of a loop, so schedule search can
+ *        weigh candidate unroll factors against the same model the pass
+ *        applies instead of enumerating pragma values blindly.
+ */
+Map<String, Integer> EstimateUnrollCost(const For& loop) {
+  arith::Analyzer analyzer;
+  int extent = -1;
+  const IntImmNode* imm = analyzer.Simplify(loop->extent).as<IntImmNode>();
+  if (imm != nullptr && imm->value <= std::numeric_limits<int>::max()) {
+    extent = static_cast<int>(imm->value);
+  }
+  UnrollCostEstimator estimator;
+  estimator(loop->body);
+  Map<String, Integer> result;
+  result.Set("extent", Integer(extent));
+  result.Set("body_size", Integer(estimator.body_size()));
+  result.Set("live_values", Integer(estimator.live_values()));
+  if (extent >= 0) {
+    result.Set("expanded_size", Integer(extent * estimator.body_size()));
+    result.Set("expanded_live_values", Integer(extent * estimator.live_values()));
+  }
+  return result;
+}
+
+TVM_REGISTER_GLOBAL("tir.analysis.estimate_unroll_cost").set_body_typed(EstimateUnrollCost);
+
 namespace transform {
 
 Pass UnrollLoop() {
@@ -92,6 +92,32 @@ class VecAllocAccess : public StmtExprMutator {
   int var_lanes_;
 };
 
+// Mask out-of-bound lanes on the loads that feed a predicated store.
+class MaskedLoadRewriter : public StmtExprMutator {
+ public:
+  explicit MaskedLoadRewriter(PrimExpr mask) : mask_(mask) {}
+
+  PrimExpr VisitExpr_(const LoadNode* op) final {
+    PrimExpr expr = StmtExprMutator::VisitExpr_(op);
+    op = expr.as<LoadNode>();
+    if (op->dtype.lanes() == 1) {
+      // A scalar load is uniform across the lanes, keep it as is.
+      return expr;
+    }
+    if (op->dtype.lanes() != mask_.dtype().lanes()) {
+      success_ = false;
+      return expr;
+    }
+    return Load(op->dtype, op->buffer_var, op->index, op->predicate && mask_);
+  }
+
+  // Whether every vector load could be masked.
+  bool success_{true};
+
+ private:
+  PrimExpr mask_;
+};
+
 // We use ExprFunctor directly instead of StmtExprMutator
 // This is because the transformation can change the dtype of the Expr
 // The existing ExprMutator transformation rules may not be well defined.
@@ -100,7 +126,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool enable_masked)
+      : var_(var), var_lanes_(var_lanes), enable_masked_(enable_masked) {
     ramp_ = Ramp(0, 1, var_lanes);
   }
 
@@ -374,6 +401,16 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     ICHECK(!op->condition.dtype().is_vector());
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
+      // Predicate the stores in the branch with the vector condition when
+      // possible, so the tail of a non-divisible loop stays vectorized
+      // instead of unrolling into scalar iterations.
+      if (enable_masked_ && !op->else_case.defined()) {
+        Stmt then_case = this->VisitStmt(op->then_case);
+        Stmt masked;
+        if (TryPredicateStores(then_case, condition, &masked)) {
+          return masked;
+        }
+      }
       return Scalarize(GetRef<Stmt>(op));
     }
     Stmt then_case = this->VisitStmt(op->then_case);
@@ -437,6 +474,32 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  // Try to rewrite a statement guarded by a vectorized condition into
+  // predicated stores, masking the vector loads that feed them. Returns
+  // false if the statement contains anything but stores, in which case the
+  // caller has to scalarize.
+  bool TryPredicateStores(const Stmt& stmt, const PrimExpr& cond, Stmt* out) {
+    if (const auto* store = stmt.as<StoreNode>()) {
+      if (store->value.dtype().lanes() != cond.dtype().lanes()) return false;
+      MaskedLoadRewriter rewriter(cond);
+      PrimExpr value = rewriter(store->value);
+      if (!rewriter.success_) return false;
+      *out = Store(store->buffer_var, value, store->index, store->predicate && cond);
+      return true;
+    }
+    if (const auto* seq = stmt.as<SeqStmtNode>()) {
+      Array<Stmt> masked;
+      for (const Stmt& s : seq->seq) {
+        Stmt res;
+        if (!TryPredicateStores(s, cond, &res)) return false;
+        masked.push_back(res);
+      }
+      *out = SeqStmt(masked);
+      return true;
+    }
+    return false;
+  }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
     Var idx(var_->name_hint + ".s", var_->dtype);
@@ -459,6 +522,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   Var var_;
   // the lanes.
   int var_lanes_;
+  // whether to emit predicated stores and masked loads for vector branches.
+  bool enable_masked_{false};
   // ramp representing the var.
   PrimExpr ramp_;
   // flag to mark requirment of scalarization.
@@ -530,6 +595,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool enable_masked = false) : enable_masked_(enable_masked) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->kind == ForKind::kVectorized) {
       ICHECK(is_zero(op->min));
@@ -537,11 +604,15 @@ class LoopVectorizer : public StmtMutator {
       if (!extent_as_int || extent_as_int->value < 1) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value),
+                        enable_masked_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  bool enable_masked_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -563,12 +634,18 @@ Stmt SkipVectorize(Stmt stmt) { return VectorizeSkipper()(std::move(stmt)); }
 
 namespace transform {
 
+// Predicated stores and masked loads are only understood by the LLVM
+// backend, so they are opt-in.
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_masked_vectorize", Bool);
+
 // TODO(tvm-team): Make it as a target property.
 Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
+    bool enable_masked =
+        ctx->GetConfig<Bool>("tir.enable_masked_vectorize", Bool(false)).value();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      n->body = LoopVectorizer(enable_masked)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
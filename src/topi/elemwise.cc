@@ -93,6 +93,10 @@ TVM_REGISTER_GLOBAL("topi.sigmoid").set_body([](TVMArgs args, TVMRetValue* rv) {
   *rv = sigmoid(args[0]);
 });
 
+TVM_REGISTER_GLOBAL("topi.fast_sigmoid").set_body([](TVMArgs args, TVMRetValue* rv) {
+  *rv = fast_sigmoid(args[0]);
+});
+
 TVM_REGISTER_GLOBAL("topi.sqrt").set_body([](TVMArgs args, TVMRetValue* rv) {
   *rv = sqrt(args[0]);
 });
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file arith_bench.cc
+ * \brief Microbenchmarks for the arithmetic simplifiers, which dominate
+ *  lowering time on index-heavy schedules.
+ *
+ *  Build with `make cppbench` and run with `--benchmark_format=json` to
+ *  produce machine-readable output for CI regression tracking.
+ */
+#include <benchmark/benchmark.h>
+#include <tvm/arith/analyzer.h>
+#include <tvm/te/operation.h>
+
+#include <vector>
+
+namespace {
+
+using tvm::PrimExpr;
+
+// Index expressions of the shape the lowering passes feed the simplifiers:
+// flattened multi-dimensional addressing with div/mod chains.
+std::vector<PrimExpr> MakeIndexExprs() {
+  auto x = tvm::te::var("x");
+  auto y = tvm::te::var("y");
+  auto z = tvm::te::var("z");
+  std::vector<PrimExpr> exprs;
+  exprs.push_back(x + 0);
+  exprs.push_back(x * 1 + y * 0);
+  exprs.push_back((x + y) - y);
+  exprs.push_back((x * 4) / 2);
+  exprs.push_back((x / 8) * 8 + x % 8);
+  exprs.push_back(tvm::min(x + 1, tvm::min(x, y) + 1));
+  exprs.push_back(tvm::max(x, 1) - tvm::max(x, 1));
+  exprs.push_back(((x * 64 + y) * 16 + z) / 16);
+  exprs.push_back(((x * 64 + y) * 16 + z) % 16);
+  exprs.push_back((x % 16) + ((x / 16) * 16) - x);
+  return exprs;
+}
+
+void BM_RewriteSimplify(benchmark::State& state) {
+  tvm::arith::Analyzer ana;
+  std::vector<PrimExpr> exprs = MakeIndexExprs();
+  for (auto _ : state) {
+    for (const PrimExpr& e : exprs) {
+      PrimExpr res = ana.rewrite_simplify(e);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * exprs.size());
+}
+BENCHMARK(BM_RewriteSimplify);
+
+void BM_CanonicalSimplify(benchmark::State& state) {
+  tvm::arith::Analyzer ana;
+  std::vector<PrimExpr> exprs = MakeIndexExprs();
+  for (auto _ : state) {
+    for (const PrimExpr& e : exprs) {
+      PrimExpr res = ana.canonical_simplify(e);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * exprs.size());
+}
+BENCHMARK(BM_CanonicalSimplify);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -216,6 +216,20 @@ TEST(Array, ResizeReserveClear) {
   }
 }
 
+TEST(Array, SharedEmpty) {
+  using namespace tvm;
+  // default-constructed arrays share one empty node until mutated
+  Array<Integer> a;
+  Array<Integer> b;
+  ASSERT_EQ(a.GetArrayNode(), b.GetArrayNode());
+  a.push_back(1);
+  ASSERT_NE(a.GetArrayNode(), b.GetArrayNode());
+  ASSERT_EQ(a.size(), 1);
+  ASSERT_EQ(b.size(), 0);
+  a.clear();
+  ASSERT_EQ(a.size(), 0);
+}
+
 TEST(Array, InsertErase) {
   using namespace tvm;
   Array<Integer> a;
@@ -323,6 +337,20 @@ TEST(Map, Clear) {
   ICHECK(dict.size() == 0);
 }
 
+TEST(Map, SharedEmpty) {
+  using namespace tvm;
+  // default-constructed maps share one empty node until mutated
+  Map<String, Integer> a;
+  Map<String, Integer> b;
+  ICHECK_EQ(a.get(), b.get());
+  a.Set("x", 1);
+  ICHECK_NE(a.get(), b.get());
+  ICHECK_EQ(a.size(), 1);
+  ICHECK_EQ(b.size(), 0);
+  a.clear();
+  ICHECK_EQ(a.size(), 0);
+}
+
 TEST(Map, Iterator) {
   using namespace tvm;
   PrimExpr a = 1, b = 2;
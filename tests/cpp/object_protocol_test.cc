@@ -27,6 +27,14 @@ namespace test {
 
 using namespace tvm::runtime;
 
+class LinkObj : public Object {
+ public:
+  ObjectRef next;
+  static constexpr const uint32_t _type_index = TypeIndex::kDynamic;
+  static constexpr const char* _type_key = "test.Link";
+  TVM_DECLARE_FINAL_OBJECT_INFO(LinkObj, Object);
+};
+
 class ObjBase : public Object {
  public:
   // dynamically allocate slow
@@ -59,6 +67,7 @@ class ObjAA : public ObjA {
   TVM_DECLARE_FINAL_OBJECT_INFO(ObjAA, ObjA);
 };
 
+TVM_REGISTER_OBJECT_TYPE(LinkObj);
 TVM_REGISTER_OBJECT_TYPE(ObjBase);
 TVM_REGISTER_OBJECT_TYPE(ObjA);
 TVM_REGISTER_OBJECT_TYPE(ObjB);
@@ -96,6 +105,21 @@ TEST(ObjectHierachy, Basic) {
   ICHECK(refB.as<ObjB>() != nullptr);
 }
 
+TEST(ObjectReclaim, DeepChain) {
+  using namespace tvm::runtime;
+  using namespace tvm::test;
+
+  // dropping the last reference to a deep chain must not overflow the
+  // stack; deleters of nested objects are drained iteratively.
+  ObjectRef head(make_object<LinkObj>());
+  for (int i = 0; i < 1000000; ++i) {
+    ObjectPtr<LinkObj> n = make_object<LinkObj>();
+    n->next = head;
+    head = ObjectRef(n);
+  }
+  head = ObjectRef();
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   testing::FLAGS_gtest_death_test_style = "threadsafe";
@@ -241,6 +241,31 @@ def test_gru_like():
             tvm.testing.assert_allclose(out, ref, rtol=1e-5, atol=1e-5)
 
 
+def test_reorder_branchy_graph():
+    # a diamond with several independent branches; the emitted node order
+    # must stay a valid topological order and the result must not change
+    x = relay.var("x", shape=(10,))
+    base = relay.exp(x)
+    branches = [relay.exp(base + relay.const(float(i))) for i in range(4)]
+    out = branches[0]
+    for b in branches[1:]:
+        out = out + b
+    func = relay.Function([x], out)
+
+    graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), "llvm")
+    graph_json = json.loads(graph)
+    for i, node in enumerate(graph_json["nodes"]):
+        for ref in node["inputs"]:
+            assert ref[0] < i
+
+    mod = graph_executor.create(graph, lib, device=tvm.cpu(0))
+    x_data = np.random.uniform(size=(10,)).astype(np.float32)
+    mod.set_input(x=x_data)
+    mod.run()
+    ref = sum(np.exp(np.exp(x_data) + float(i)) for i in range(4))
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), ref, rtol=1e-5, atol=1e-5)
+
+
 def test_compile_nested_tuples():
     x = relay.var("x", shape=(10,))
     x1 = x + relay.const(1.0)
@@ -295,4 +320,5 @@ if __name__ == "__main__":
     test_add_op_tensor()
     test_add_op_broadcast()
     test_gru_like()
+    test_reorder_branchy_graph()
     test_compile_nested_tuples()
@@ -966,6 +966,34 @@ def test_func_attrs():
     assert_parses_as(func.astext(), func)
 
 
+def test_fast_parse_mode_round_trip():
+    """fast parse mode (TVM_PARSER_FAST_PARSE) must not change parse results"""
+    import subprocess
+    import sys as _sys
+    import os
+
+    program = """
+    #[version = "0.0.5"]
+    def @main(%x: Tensor[(2, 3), float32]) {
+        let %v1 = add(%x, %x);
+        multiply(%v1, %v1)
+    }
+    """
+    script = (
+        "import tvm\n"
+        "from tvm import relay\n"
+        "program = {!r}\n"
+        "x = relay.var('x', shape=(2, 3))\n"
+        "v1 = relay.add(x, x)\n"
+        "expected = tvm.IRModule.from_expr(relay.Function([x], relay.multiply(v1, v1)))\n"
+        "expected = relay.transform.InferType()(expected)\n"
+        "parsed = tvm.parser.parse(program)\n"
+        "assert tvm.ir.structural_equal(parsed, expected)\n"
+    ).format(program)
+    env = dict(os.environ, TVM_PARSER_FAST_PARSE="1")
+    subprocess.check_call([_sys.executable, "-c", script], env=env)
+
+
 if __name__ == "__main__":
     import sys
 
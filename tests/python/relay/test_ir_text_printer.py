@@ -264,5 +264,16 @@ def test_span():
     assert "Add1" in txt
 
 
+def test_astext_to_file(tmp_path):
+    mod, _ = testing.synthetic.get_workload()
+    file_name = str(tmp_path / "mod.txt")
+    mod.astext_to_file(file_name)
+    with open(file_name) as f:
+        text = f.read()
+    assert text == mod.astext()
+    roundtrip_mod = tvm.parser.fromtext(text)
+    tvm.ir.assert_structural_equal(roundtrip_mod, mod, map_free_vars=True)
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -18,6 +18,7 @@ import tvm
 from tvm import te
 import numpy as np
 from tvm import relay
+from tvm.contrib import graph_executor
 
 
 def check_memory_plan(func, check_fn):
@@ -54,6 +55,51 @@ def storage_type(mod):
     return relay.TypeCall(mod.get_global_type_var("Storage"), [])
 
 
+def plan_graph_memory(func, fuse_opt_level=0, enable_storage_views=False):
+    """Run the graph-executor memory planner and return (main, plan).
+
+    The plan maps each expression of main to [storage_ids, device_types,
+    sizes_in_bytes, byte_offsets], one entry per output tensor.
+    """
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps(fuse_opt_level)(mod)
+    mod = relay.transform.InferType()(mod)
+    main = mod["main"]
+    plan = tvm.get_global_func("relay.backend.GraphPlanMemory")(main, enable_storage_views)
+    return main, plan
+
+
+def storage_id(plan, expr, index=0):
+    return int(plan[expr][0][index])
+
+
+def byte_offset(plan, expr, index=0):
+    return int(plan[expr][3][index])
+
+
+def test_plan_inplace_elemwise():
+    # negative keeps dtype and element count, so the planner may run the
+    # fused call in place on the dying add intermediate.
+    x = relay.var("x", shape=(8, 8))
+    body = relay.negative(relay.add(x, x))
+    main, plan = plan_graph_memory(relay.Function([x], body))
+    assert storage_id(plan, main.body) == storage_id(plan, main.body.args[0])
+
+
+def test_plan_no_inplace_for_dtype_change():
+    x = relay.var("x", shape=(8, 8))
+    a = relay.add(x, x)
+    # A width-changing cast moves element i to a different byte offset, so
+    # the output must not overwrite the dying input.
+    for dtype in ["float16", "float64", "bool"]:
+        main, plan = plan_graph_memory(relay.Function([x], relay.cast(a, dtype)))
+        assert storage_id(plan, main.body) != storage_id(plan, main.body.args[0])
+    # An equal-width cast keeps element i on the same bytes and may reuse.
+    main, plan = plan_graph_memory(relay.Function([x], relay.cast(a, "int32")))
+    assert storage_id(plan, main.body) == storage_id(plan, main.body.args[0])
+
+
 def test_tyck_alloc_storage():
     mod = tvm.IRModule()
     mod.import_from_std("core.rly")
@@ -69,6 +115,128 @@ def test_tyck_alloc_tensor():
     relay.transform.InferType()(mod)
 
 
+def test_plan_concat_storage_view():
+    # Outermost-axis concat of single-reader, call-produced inputs: the
+    # producers write straight into adjacent ranges of the concat buffer and
+    # the concat itself carries no storage of its own.
+    x = relay.var("x", shape=(8, 16))
+    y = relay.var("y", shape=(8, 16))
+    w1 = relay.var("w1", shape=(8, 16))
+    w2 = relay.var("w2", shape=(8, 16))
+    a = relay.nn.dense(x, w1)
+    b = relay.nn.dense(y, w2)
+    c = relay.concatenate([a, b], axis=0)
+    main, plan = plan_graph_memory(
+        relay.Function([x, y, w1, w2], c), fuse_opt_level=2, enable_storage_views=True
+    )
+    concat = main.body
+    a_call, b_call = concat.args
+    assert storage_id(plan, a_call) == storage_id(plan, concat)
+    assert storage_id(plan, b_call) == storage_id(plan, concat)
+    assert byte_offset(plan, a_call) == 0
+    assert byte_offset(plan, b_call) == 8 * 8 * 4
+    assert byte_offset(plan, concat) == 0
+
+
+def test_plan_split_storage_view():
+    # Split outputs become views at prefix-sum offsets into the split input.
+    x = relay.var("x", shape=(8, 16))
+    w = relay.var("w", shape=(8, 16))
+    a = relay.nn.dense(x, w)
+    s = relay.split(a, 2, axis=0)
+    main, plan = plan_graph_memory(
+        relay.Function([x, w], relay.Tuple([s[0], s[1]])),
+        fuse_opt_level=2,
+        enable_storage_views=True,
+    )
+    split_call = main.body.fields[0].tuple_value
+    a_call = split_call.args[0]
+    assert storage_id(plan, split_call, 0) == storage_id(plan, a_call)
+    assert storage_id(plan, split_call, 1) == storage_id(plan, a_call)
+    assert byte_offset(plan, split_call, 0) == 0
+    assert byte_offset(plan, split_call, 1) == 4 * 8 * 4
+
+
+def test_plan_storage_view_ineligible():
+    x = relay.var("x", shape=(8, 16))
+    y = relay.var("y", shape=(8, 16))
+    w1 = relay.var("w1", shape=(8, 16))
+    w2 = relay.var("w2", shape=(8, 16))
+    a = relay.nn.dense(x, w1)
+    b = relay.nn.dense(y, w2)
+    # a has a second reader, so redirecting its producer would clobber
+    # bytes the other reader still needs.
+    c = relay.concatenate([a, b], axis=0)
+    main, plan = plan_graph_memory(
+        relay.Function([x, y, w1, w2], relay.Tuple([c, a])),
+        fuse_opt_level=2,
+        enable_storage_views=True,
+    )
+    concat = main.body.fields[0]
+    assert storage_id(plan, concat.args[0]) != storage_id(plan, concat)
+    assert storage_id(plan, concat.args[1]) != storage_id(plan, concat)
+    # Parameters own their storage, so a parameter input disables the view.
+    p = relay.var("p", shape=(8, 8))
+    c2 = relay.concatenate([p, relay.nn.dense(y, w2)], axis=0)
+    main, plan = plan_graph_memory(
+        relay.Function([p, y, w2], c2), fuse_opt_level=2, enable_storage_views=True
+    )
+    assert storage_id(plan, main.body.args[1]) != storage_id(plan, main.body)
+    # An inner-axis concat interleaves rows and cannot be a flat view.
+    c3 = relay.concatenate([a, b], axis=1)
+    main, plan = plan_graph_memory(
+        relay.Function([x, y, w1, w2], c3), fuse_opt_level=2, enable_storage_views=True
+    )
+    assert storage_id(plan, main.body.args[0]) != storage_id(plan, main.body)
+    # Without the opt-in flag nothing is marked.
+    main, plan = plan_graph_memory(
+        relay.Function([x, y, w1, w2], c), fuse_opt_level=2, enable_storage_views=False
+    )
+    assert storage_id(plan, main.body.args[0]) != storage_id(plan, main.body)
+
+
+def run_on_graph_executor(func, args):
+    mod = tvm.IRModule.from_expr(func)
+    with tvm.transform.PassContext(opt_level=3):
+        lib = relay.build(mod, target="llvm")
+    m = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+    for name, value in args.items():
+        m.set_input(name, value)
+    m.run()
+    return [m.get_output(i).numpy() for i in range(m.get_num_outputs())]
+
+
+def test_storage_view_execution():
+    # End-to-end through the graph executor: the eligible concat and split
+    # become nops, the multi-reader concat falls back to the real kernel,
+    # and all of them must still produce the numpy result.
+    x = relay.var("x", shape=(8, 16))
+    y = relay.var("y", shape=(8, 16))
+    w1 = relay.var("w1", shape=(8, 16))
+    w2 = relay.var("w2", shape=(8, 16))
+    a = relay.nn.dense(x, w1)
+    b = relay.nn.dense(y, w2)
+    c = relay.concatenate([a, b], axis=0)
+    s = relay.split(c, 2, axis=0)
+    args = {name: np.random.rand(8, 16).astype("float32") for name in ["x", "y", "w1", "w2"]}
+    an = np.matmul(args["x"], args["w1"].T)
+    bn = np.matmul(args["y"], args["w2"].T)
+    cn = np.concatenate([an, bn], axis=0)
+
+    # eligible: the dense kernels write into views of the concat buffer.
+    outs = run_on_graph_executor(relay.Function([x, y, w1, w2], c), args)
+    np.testing.assert_allclose(outs[0], cn, rtol=1e-5)
+
+    # the split outputs read the two halves back through views.
+    outs = run_on_graph_executor(relay.Function([x, y, w1, w2], s[0] + s[1]), args)
+    np.testing.assert_allclose(outs[0], an + bn, rtol=1e-5)
+
+    # a second reader of a concat input forces the kernel fallback.
+    outs = run_on_graph_executor(relay.Function([x, y, w1, w2], relay.Tuple([c, a])), args)
+    np.testing.assert_allclose(outs[0], cn, rtol=1e-5)
+    np.testing.assert_allclose(outs[1], an, rtol=1e-5)
+
+
 def check_add(x):
     return x + x
 
@@ -114,7 +282,49 @@ def test_no_fuse():
     check_memory_plan(func, check_no_fuse)
 
 
+def check_chain(x, w1, w2, w3):
+    z = np.matmul(x, np.transpose(w1))
+    z = np.matmul(z, np.transpose(w2))
+    return np.matmul(z, np.transpose(w3))
+
+
+def test_storage_reuse():
+    # A chain of unfusable ops, so the first intermediate is dead by the time
+    # the third output is allocated and its storage can be rebound.
+    x = relay.var("x", shape=(5, 5))
+    w1 = relay.var("w1", shape=(5, 5))
+    w2 = relay.var("w2", shape=(5, 5))
+    w3 = relay.var("w3", shape=(5, 5))
+    z = relay.op.nn.dense(x, w1)
+    z = relay.op.nn.dense(z, w2)
+    z = relay.op.nn.dense(z, w3)
+    func = relay.Function([x, w1, w2, w3], z)
+    mod = tvm.IRModule().from_expr(func)
+
+    args = []
+    for param in func.params:
+        sh = [int(sh) for sh in param.type_annotation.shape]
+        data = np.random.rand(*sh).astype(param.type_annotation.dtype)
+        args.append(tvm.nd.array(data))
+
+    ex = relay.create_executor("vm", mod)
+    baseline = ex.evaluate(mod["main"])(*args)
+    with tvm.transform.PassContext(config={"relay.ManifestAlloc.reuse_storage": True}):
+        reused = ex.evaluate(mod["main"])(*args)
+
+    py_res = check_chain(*[arg.numpy() for arg in args])
+    np.testing.assert_allclose(reused.numpy(), baseline.numpy())
+    np.testing.assert_allclose(reused.numpy(), py_res)
+
+
 if __name__ == "__main__":
     test_tyck_alloc_tensor()
     test_add()
     test_add_sub()
+    test_storage_reuse()
+    test_plan_inplace_elemwise()
+    test_plan_no_inplace_for_dtype_change()
+    test_plan_concat_storage_view()
+    test_plan_split_storage_view()
+    test_plan_storage_view_ineligible()
+    test_storage_view_execution()
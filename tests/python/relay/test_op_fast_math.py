@@ -56,6 +56,7 @@ def test_fastmath():
     test_apply(relay.exp, "fast_exp", np.exp, low=-88, high=88, step=0.01)
     test_apply(relay.erf, "fast_erf", scipy.special.erf, low=-10, high=10, step=0.01)
     test_apply(relay.tanh, "fast_tanh", np.tanh, low=-10, high=10, step=0.01)
+    test_apply(relay.sigmoid, "fast_sigmoid", scipy.special.expit, low=-20, high=20, step=0.01)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,74 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import relay
+from tvm.relay.transform import AutoCheckpoint
+
+
+def dense_chain_module():
+    x = relay.var("x", shape=(32, 256), dtype="float32")
+    y = x
+    for i in range(3):
+        w = relay.var("w%d" % i, shape=(256, 256), dtype="float32")
+        y = relay.nn.relu(relay.nn.dense(y, w))
+    func = relay.Function(relay.analysis.free_vars(y), y)
+    return tvm.IRModule.from_expr(func)
+
+
+def test_insert_checkpoints():
+    mod = dense_chain_module()
+    # A budget below one dense output (32 * 256 * 4 bytes) cuts at every dense.
+    ckpt_mod = AutoCheckpoint(max_segment_bytes=1024)(mod)
+    assert ckpt_mod.astext().count("annotation.checkpoint") == 3
+
+
+def test_budget_keeps_small_graphs_untouched():
+    mod = dense_chain_module()
+    ckpt_mod = AutoCheckpoint()(mod)
+    assert "annotation.checkpoint" not in ckpt_mod.astext()
+
+
+def test_boundary_prefers_expensive_ops():
+    # relu is elemwise, so every cut must land on a dense even though the
+    # budget also overflows at the relus.
+    mod = dense_chain_module()
+    ckpt_mod = AutoCheckpoint(max_segment_bytes=1024)(mod)
+
+    wrapped_ops = []
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and getattr(expr.op, "name", "") == "annotation.checkpoint":
+            wrapped_ops.append(expr.args[0].op.name)
+
+    relay.analysis.post_order_visit(ckpt_mod["main"], visit)
+    assert wrapped_ops == ["nn.dense"] * 3
+
+
+def test_gradient_of_checkpointed_graph():
+    mod = dense_chain_module()
+    mod = AutoCheckpoint(max_segment_bytes=1024)(mod)
+    mod = relay.transform.InferType()(mod)
+    grad = relay.transform.gradient(mod["main"], mod)
+    # The checkpointed function must still be differentiable and well typed.
+    relay.transform.InferType()(tvm.IRModule.from_expr(grad))
+
+
+if __name__ == "__main__":
+    test_insert_checkpoints()
+    test_budget_keeps_small_graphs_untouched()
+    test_boundary_prefers_expensive_ops()
+    test_gradient_of_checkpointed_graph()
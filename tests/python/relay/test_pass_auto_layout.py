@@ -0,0 +1,85 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Tests for the target-aware automatic layout selection pass."""
+import tvm
+from tvm import relay
+
+
+def _conv_net(data_layout, kernel_layout, dtype):
+    if data_layout == "NCHW":
+        dshape = (1, 64, 56, 56)
+        wshape = (64, 64, 3, 3) if kernel_layout == "OIHW" else (3, 3, 64, 64)
+    else:
+        dshape = (1, 56, 56, 64)
+        wshape = (3, 3, 64, 64) if kernel_layout == "HWIO" else (64, 64, 3, 3)
+    x = relay.var("x", shape=dshape, dtype=dtype)
+    w = relay.var("w", shape=wshape, dtype=dtype)
+    y = relay.nn.conv2d(
+        x,
+        w,
+        channels=64,
+        kernel_size=(3, 3),
+        padding=(1, 1),
+        data_layout=data_layout,
+        kernel_layout=kernel_layout,
+    )
+    y = relay.nn.relu(y)
+    return tvm.IRModule.from_expr(relay.Function([x, w], y))
+
+
+def _collect(mod):
+    layouts = []
+    transforms = [0]
+
+    def fvisit(expr):
+        if isinstance(expr, relay.Call) and isinstance(expr.op, tvm.ir.Op):
+            if expr.op.name == "nn.conv2d":
+                layouts.append(expr.attrs.data_layout)
+            elif expr.op.name == "layout_transform":
+                transforms[0] += 1
+
+    relay.analysis.post_order_visit(mod["main"], fvisit)
+    return layouts, transforms[0]
+
+
+def test_auto_layout_keeps_preferred():
+    mod = _conv_net("NCHW", "OIHW", "float32")
+    mod = relay.transform.AutoLayout("llvm")(mod)
+    layouts, num_transforms = _collect(mod)
+    assert layouts == ["NCHW"]
+    assert num_transforms == 0
+
+
+def test_auto_layout_converts_to_target_preference():
+    mod = _conv_net("NHWC", "HWIO", "float32")
+    mod = relay.transform.AutoLayout("llvm")(mod)
+    layouts, num_transforms = _collect(mod)
+    assert layouts == ["NCHW"]
+    assert num_transforms > 0
+
+
+def test_auto_layout_fp16_cuda_prefers_nhwc():
+    mod = _conv_net("NCHW", "OIHW", "float16")
+    mod = relay.transform.AutoLayout("cuda")(mod)
+    layouts, _ = _collect(mod)
+    assert layouts == ["NHWC"]
+
+
+if __name__ == "__main__":
+    test_auto_layout_keeps_preferred()
+    test_auto_layout_converts_to_target_preference()
+    test_auto_layout_fp16_cuda_prefers_nhwc()
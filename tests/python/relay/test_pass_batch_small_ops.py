@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+
+
+def count_primitive_calls(mod):
+    count = [0]
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and isinstance(expr.op, relay.Function):
+            if expr.op.attrs and int(expr.op.attrs["Primitive"]) == 1:
+                count[0] += 1
+
+    relay.analysis.post_order_visit(mod["main"].body, visit)
+    return count[0]
+
+
+def run_batch_small_ops(mod, max_output_size=1024):
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps()(mod)
+    mod = relay.transform.InferType()(mod)
+    with tvm.transform.PassContext(
+        config={"relay.BatchSmallOps.max_output_size": max_output_size}
+    ):
+        mod = relay.transform.BatchSmallOps()(mod)
+    return relay.transform.InferType()(mod)
+
+
+def test_batch_independent_ops():
+    x = relay.var("x", shape=(4,))
+    y = relay.var("y", shape=(4,))
+    a = relay.add(x, relay.const(1.0))
+    b = relay.multiply(y, relay.const(2.0))
+    func = relay.Function([x, y], relay.Tuple([a, b]))
+    mod = tvm.IRModule.from_expr(func)
+    mod = run_batch_small_ops(mod)
+    # The two independent kernels collapse into one batched dispatch.
+    assert count_primitive_calls(mod) == 1
+
+    x_np = np.random.uniform(size=(4,)).astype("float32")
+    y_np = np.random.uniform(size=(4,)).astype("float32")
+    ex = relay.create_executor("graph", mod=mod, device=tvm.cpu(0), target="llvm")
+    res_a, res_b = ex.evaluate()(x_np, y_np)
+    tvm.testing.assert_allclose(res_a.asnumpy(), x_np + 1.0)
+    tvm.testing.assert_allclose(res_b.asnumpy(), y_np * 2.0)
+
+
+def test_dependent_ops_not_batched():
+    x = relay.var("x", shape=(4,))
+    a = relay.add(x, relay.const(1.0))
+    b = relay.exp(relay.sum(a, axis=[0], keepdims=True))
+    c = relay.multiply(b, relay.const(2.0))
+    func = relay.Function([x], c)
+    mod = tvm.IRModule.from_expr(func)
+    before = run_batch_small_ops(tvm.IRModule.from_expr(func), max_output_size=0)
+    after = run_batch_small_ops(mod)
+    # A straight dependence chain offers nothing to batch.
+    assert count_primitive_calls(before) == count_primitive_calls(after)
+
+
+def test_disabled_by_default():
+    x = relay.var("x", shape=(4,))
+    y = relay.var("y", shape=(4,))
+    func = relay.Function([x, y], relay.Tuple([relay.add(x, y), relay.subtract(x, y)]))
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps()(mod)
+    mod = relay.transform.InferType()(mod)
+    unbatched = count_primitive_calls(mod)
+    # Without the config the pass leaves the module alone.
+    mod = relay.transform.BatchSmallOps()(mod)
+    assert count_primitive_calls(mod) == unbatched
+
+
+if __name__ == "__main__":
+    test_batch_independent_ops()
+    test_dependent_ops_not_batched()
+    test_disabled_by_default()
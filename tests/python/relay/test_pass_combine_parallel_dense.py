@@ -35,34 +35,34 @@ def run_opt_pass(expr, opt_pass):
 
 
 def test_combine_parallel_dense():
-    """Simple testcase. One dense cannot be combined due to shape mismatch"""
+    """Simple testcase. Branches with a different output dim are combined too"""
 
     def before(x, w1, w2, w3, w4):
         args = [x, w1, w2, w3, w4]
         y1 = relay.nn.dense(x, w1)
         y2 = relay.nn.dense(x, w2)
 
-        # y3 cannot be combined
+        # y3 has a different output dim
         y3 = relay.nn.dense(x, w3)
 
         y4 = relay.nn.dense(x, w4)
         y = relay.Tuple((y1, y2, y3, y4))
         return relay.Function(args, y)
 
-    def expected(x, w1, w2, w3, w4):
+    def expected(x, w1, w2, w3, w4, j):
         # use a fixed order of args so alpha equal check can pass
         args = [x, w1, w2, w3, w4]
-        x_stacked = relay.stack((x, x, x), axis=0)
-        w = relay.stack((w1, w2, w4), axis=0)
-        y = relay.nn.batch_matmul(x_stacked, w)
-        (y1, y2, y4) = relay.split(y, 3)
-        y1 = relay.squeeze(y1, [0])
-        y2 = relay.squeeze(y2, [0])
-        y4 = relay.squeeze(y4, [0])
-
-        # y3 cannot be combined
-        y3 = relay.nn.dense(x, w3)
-
+        w_stacked = relay.concatenate((w1, w2, w3, w4), axis=0)
+        y = relay.nn.dense(x, w_stacked, units=4 * j + 1)
+        strides = [1, 1]
+        y1 = relay.strided_slice(y, begin=[0, 0], end=[-1, j], strides=strides, slice_mode="size")
+        y2 = relay.strided_slice(y, begin=[0, j], end=[-1, j], strides=strides, slice_mode="size")
+        y3 = relay.strided_slice(
+            y, begin=[0, 2 * j], end=[-1, j + 1], strides=strides, slice_mode="size"
+        )
+        y4 = relay.strided_slice(
+            y, begin=[0, 3 * j + 1], end=[-1, j], strides=strides, slice_mode="size"
+        )
         y = relay.Tuple((y1, y2, y3, y4))
         return relay.Function(args, y)
 
@@ -75,7 +75,7 @@ def test_combine_parallel_dense():
 
         y_before = before(x, w1, w2, w3, w4)
         y = run_opt_pass(y_before, transform.CombineParallelDense(min_num_branches=2))
-        y_expected = expected(x, w1, w2, w3, w4)
+        y_expected = expected(x, w1, w2, w3, w4, j)
         y_expected = run_opt_pass(y_expected, transform.InferType())
         tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
 
@@ -83,6 +83,43 @@ def test_combine_parallel_dense():
     check(100, 200, 300)
 
 
+def test_combine_parallel_dense_batch_fallback():
+    """Branches whose output dims are not static fall back to batch_matmul"""
+
+    def before(x, w1, w2):
+        args = [x, w1, w2]
+        y1 = relay.nn.dense(x, w1)
+        y2 = relay.nn.dense(x, w2)
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    def expected(x, w1, w2):
+        args = [x, w1, w2]
+        x_stacked = relay.stack((x, x), axis=0)
+        w = relay.stack((w1, w2), axis=0)
+        y = relay.nn.batch_matmul(x_stacked, w)
+        (y1, y2) = relay.split(y, 2)
+        y1 = relay.squeeze(y1, [0])
+        y2 = relay.squeeze(y2, [0])
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    def check(i, k):
+        j = te.var("j")
+        x = relay.var("x", shape=(i, k))
+        w1 = relay.var("w1", shape=(j, k))
+        w2 = relay.var("w2", shape=(j, k))
+
+        y_before = before(x, w1, w2)
+        y = run_opt_pass(y_before, transform.CombineParallelDense(min_num_branches=2))
+        y_expected = expected(x, w1, w2)
+        y_expected = run_opt_pass(y_expected, transform.InferType())
+        tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    check(3, 4)
+    check(100, 300)
+
+
 def test_combine_parallel_dense_biasadd():
     """Testcase of combining dense + 1d biasadd"""
 
@@ -95,21 +132,17 @@ def test_combine_parallel_dense_biasadd():
         y = relay.Tuple((y1, y2))
         return relay.Function(args, y)
 
-    def expected(x, w1, w2, b1, b2, is_2d_bias):
+    def expected(x, w1, w2, b1, b2, j, is_2d_bias):
         args = [x, w1, w2, b1, b2]
-        x_stacked = relay.stack((x, x), axis=0)
-        w = relay.stack((w1, w2), axis=0)
-        y = relay.nn.batch_matmul(x_stacked, w)
-
-        if not is_2d_bias:
-            b1 = relay.expand_dims(b1, 0)
-            b2 = relay.expand_dims(b2, 0)
+        w_stacked = relay.concatenate((w1, w2), axis=0)
+        y = relay.nn.dense(x, w_stacked, units=2 * j)
 
-        b = relay.stack((b1, b2), axis=0)
+        concat_axis = 1 if is_2d_bias else 0
+        b = relay.concatenate((b1, b2), axis=concat_axis)
         y = relay.add(y, b)
-        (y1, y2) = relay.split(y, 2)
-        y1 = relay.squeeze(y1, [0])
-        y2 = relay.squeeze(y2, [0])
+        strides = [1, 1]
+        y1 = relay.strided_slice(y, begin=[0, 0], end=[-1, j], strides=strides, slice_mode="size")
+        y2 = relay.strided_slice(y, begin=[0, j], end=[-1, j], strides=strides, slice_mode="size")
         y = relay.Tuple((y1, y2))
         return relay.Function(args, y)
 
@@ -127,7 +160,7 @@ def test_combine_parallel_dense_biasadd():
 
         y_before = before(x, w1, w2, b1, b2)
         y = run_opt_pass(y_before, transform.CombineParallelDense(min_num_branches=2))
-        y_expected = expected(x, w1, w2, b1, b2, is_2d_bias)
+        y_expected = expected(x, w1, w2, b1, b2, j, is_2d_bias)
         y_expected = run_opt_pass(y_expected, transform.InferType())
         tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
 
@@ -153,22 +186,19 @@ def test_combine_parallel_dense_biasadd_scale_reshape():
         y = relay.Tuple((y1, y2))
         return relay.Function(args, y)
 
-    def expected(x, w1, w2, b1, b2, scale1, scale2, newshape):
+    def expected(x, w1, w2, b1, b2, scale1, scale2, newshape, j):
         args = [x, w1, w2, b1, b2, scale1, scale2]
-        x_stacked = relay.stack((x, x), axis=0)
-        w = relay.stack((w1, w2), axis=0)
-        y = relay.nn.batch_matmul(x_stacked, w)
-        b1 = relay.expand_dims(b1, 0)
-        b2 = relay.expand_dims(b2, 0)
-        b = relay.stack((b1, b2), axis=0)
+        w_stacked = relay.concatenate((w1, w2), axis=0)
+        y = relay.nn.dense(x, w_stacked, units=2 * j)
+        b = relay.concatenate((b1, b2), axis=0)
         y = relay.add(y, b)
-        scale1 = relay.expand_dims(scale1, 0)
-        scale2 = relay.expand_dims(scale2, 0)
-        scale = relay.stack((scale1, scale2), axis=0)
+        scale1 = relay.repeat(scale1, j, 0)
+        scale2 = relay.repeat(scale2, j, 0)
+        scale = relay.concatenate((scale1, scale2), axis=0)
         y = relay.multiply(y, scale)
-        (y1, y2) = relay.split(y, 2)
-        y1 = relay.squeeze(y1, [0])
-        y2 = relay.squeeze(y2, [0])
+        strides = [1, 1]
+        y1 = relay.strided_slice(y, begin=[0, 0], end=[-1, j], strides=strides, slice_mode="size")
+        y2 = relay.strided_slice(y, begin=[0, j], end=[-1, j], strides=strides, slice_mode="size")
         y1 = relay.reshape(y1, newshape=newshape)
         y2 = relay.reshape(y2, newshape=newshape)
         y = relay.Tuple((y1, y2))
@@ -185,7 +215,7 @@ def test_combine_parallel_dense_biasadd_scale_reshape():
 
         y_before = before(x, w1, w2, b1, b2, scale1, scale2, newshape)
         y = run_opt_pass(y_before, transform.CombineParallelDense(min_num_branches=2))
-        y_expected = expected(x, w1, w2, b1, b2, scale1, scale2, newshape)
+        y_expected = expected(x, w1, w2, b1, b2, scale1, scale2, newshape, j)
         y_expected = run_opt_pass(y_expected, transform.InferType())
         tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
 
@@ -361,6 +391,7 @@ def test_combine_parallel_dense_flat_biasadd_scale_reshape():
 
 if __name__ == "__main__":
     test_combine_parallel_dense()
+    test_combine_parallel_dense_batch_fallback()
     test_combine_parallel_dense_biasadd()
     test_combine_parallel_dense_biasadd_scale_reshape()
     test_combine_parallel_dense_flat()
@@ -50,6 +50,36 @@ def test_tanh():
     assert "fast_tanh" in fast_mod[0].astext()
 
 
+def test_sigmoid():
+    x = relay.var("x", shape=(1, 16, 16, 16), dtype="float32")
+    y = relay.sigmoid(x)
+    func = relay.Function([x], y)
+    mod = tvm.IRModule.from_expr(func)
+
+    fast_mod = FastMath()(mod)
+    assert "fast_sigmoid" in fast_mod.astext()
+
+    # Check that FastMath option works for relay.build.
+    with tvm.transform.PassContext(opt_level=3, required_pass=["FastMath"]):
+        fast_mod = relay.optimize(mod, target="llvm", params=None)
+    assert "fast_sigmoid" in fast_mod[0].astext()
+
+
+def test_softmax():
+    x = relay.var("x", shape=(1, 16), dtype="float32")
+    y = relay.nn.softmax(x)
+    func = relay.Function([x], y)
+    mod = tvm.IRModule.from_expr(func)
+
+    fast_mod = FastMath()(mod)
+    assert "nn.fast_softmax" in fast_mod.astext()
+
+    # Check that FastMath option works for relay.build.
+    with tvm.transform.PassContext(opt_level=3, required_pass=["FastMath"]):
+        fast_mod = relay.optimize(mod, target="llvm", params=None)
+    assert "nn.fast_softmax" in fast_mod[0].astext()
+
+
 def test_erf():
     x = relay.var("x", shape=(1, 16, 16, 16), dtype="float32")
     y = relay.erf(x)
@@ -68,4 +98,6 @@ def test_erf():
 if __name__ == "__main__":
     test_exp()
     test_tanh()
+    test_sigmoid()
+    test_softmax()
     test_erf()
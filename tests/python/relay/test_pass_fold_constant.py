@@ -298,6 +298,25 @@ def test_fold_dropout():
     assert tvm.ir.structural_equal(run_infer_type(before_mod["main"]), after_mod["main"])
 
 
+def test_fold_with_eval_cache():
+    c_data = np.array([[1, 2, 3]]).astype("float32")
+
+    def before():
+        a = relay.const(c_data)
+        b = relay.const(c_data)
+        x = relay.var("x", shape=(1, 3))
+        y = relay.concatenate((a, b), axis=0) + relay.const(1.0)
+        return relay.Function([x], relay.Tuple([y, x]))
+
+    zexpected = run_opt_pass(before(), transform.FoldConstant())
+    with tvm.transform.PassContext(config={"relay.use_const_eval_cache": True}):
+        # Run twice so the second run is served from the cache.
+        zz = run_opt_pass(before(), transform.FoldConstant())
+        assert tvm.ir.structural_equal(zz, zexpected)
+        zz = run_opt_pass(before(), transform.FoldConstant())
+        assert tvm.ir.structural_equal(zz, zexpected)
+
+
 if __name__ == "__main__":
     test_fold_const()
     test_fold_let()
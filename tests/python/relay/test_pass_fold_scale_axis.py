@@ -888,6 +888,73 @@ def test_fold_bwd_negative_scale():
     check((2, 2, 10, 10, 2), 8, (2, 2))
 
 
+def test_fold_fwd_dense():
+    """Dense testcase."""
+
+    def before(x, weight, in_scale):
+        args = [x, weight]
+        x = relay.multiply(x, in_scale)
+        y = relay.nn.dense(x, weight)
+        return relay.Function(args, y)
+
+    def expected(x, weight, in_scale):
+        args = [x, weight]
+        weight = relay.multiply(weight, in_scale)
+        y = relay.nn.dense(x, weight)
+        return relay.Function(args, y)
+
+    def check(data_shape, weight_shape):
+        x = relay.var("x", shape=data_shape)
+        weight = relay.var("weight", shape=weight_shape)
+        in_scale = relay.const(_get_positive_scale((data_shape[1],)))
+        y1 = before(x, weight, in_scale)
+        y1 = run_opt_pass(y1, transform.InferType())
+        y1_folded = run_opt_pass(y1, transform.ForwardFoldScaleAxis())
+        y1_expected = expected(x, weight, in_scale)
+        y1_expected = run_opt_pass(y1_expected, transform.InferType())
+        assert tvm.ir.structural_equal(y1_folded, y1_expected)
+
+    check((2, 4), (3, 4))
+    check((3, 5), (4, 5))
+
+
+def test_fold_bwd_dense():
+    """Dense testcase."""
+
+    def before(x, weight, out_bias, out_scale):
+        args = [x, weight, out_bias]
+        y = relay.nn.dense(x, weight)
+        y = relay.add(y, out_bias)
+        y = relay.nn.relu(y)
+        y = relay.multiply(y, out_scale)
+        return relay.Function(args, y)
+
+    def expected(x, weight, out_bias, out_scale):
+        args = [x, weight, out_bias]
+        weight = relay.multiply(weight, relay.expand_dims(out_scale, axis=1))
+        y = relay.nn.dense(x, weight)
+        out_bias = relay.multiply(out_bias, out_scale)
+        y = relay.add(y, out_bias)
+        y = relay.nn.relu(y)
+        return relay.Function(args, y)
+
+    def check(data_shape, weight_shape):
+        units = weight_shape[0]
+        x = relay.var("x", shape=data_shape)
+        weight = relay.var("weight", shape=weight_shape)
+        out_bias = relay.var("out_bias", shape=(units,))
+        out_scale = relay.const(_get_positive_scale((units,)))
+        y1 = before(x, weight, out_bias, out_scale)
+        y1 = run_opt_pass(y1, transform.InferType())
+        y1_folded = run_opt_pass(y1, transform.BackwardFoldScaleAxis())
+        y1_expected = expected(x, weight, out_bias, out_scale)
+        y1_expected = run_opt_pass(y1_expected, transform.InferType())
+        assert tvm.ir.structural_equal(y1_folded, y1_expected)
+
+    check((2, 4), (3, 4))
+    check((3, 5), (4, 5))
+
+
 if __name__ == "__main__":
     test_fold_fwd_simple()
     test_fold_fwd_dual_path()
@@ -900,3 +967,5 @@ if __name__ == "__main__":
     test_fold_bwd_fail()
     test_fold_bwd_relu_fail()
     test_fold_bwd_negative_scale()
+    test_fold_fwd_dense()
+    test_fold_bwd_dense()
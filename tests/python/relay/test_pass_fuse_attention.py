@@ -0,0 +1,122 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay import transform
+from tvm.relay.testing import run_opt_pass
+
+
+def make_unfused(q, k, v, scale=None, divide=False, transpose_axes=(0, 2, 1)):
+    scores = relay.nn.batch_matmul(q, k)
+    if scale is not None:
+        const = relay.const(scale, "float32")
+        scores = scores / const if divide else scores * const
+    probs = relay.nn.softmax(scores, axis=-1)
+    return relay.nn.batch_matmul(probs, relay.transpose(v, axes=list(transpose_axes)))
+
+
+def test_fuse_attention():
+    def before():
+        q = relay.var("q", shape=(2, 16, 8), dtype="float32")
+        k = relay.var("k", shape=(2, 24, 8), dtype="float32")
+        v = relay.var("v", shape=(2, 24, 12), dtype="float32")
+        return relay.Function([q, k, v], make_unfused(q, k, v, scale=0.125))
+
+    def expected():
+        q = relay.var("q", shape=(2, 16, 8), dtype="float32")
+        k = relay.var("k", shape=(2, 24, 8), dtype="float32")
+        v = relay.var("v", shape=(2, 24, 12), dtype="float32")
+        return relay.Function([q, k, v], relay.nn.fused_attention(q, k, v, scale=0.125))
+
+    zz = run_opt_pass(before(), transform.FuseAttention())
+    after = run_opt_pass(expected(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+
+
+def test_fuse_attention_divide_scale():
+    def before():
+        q = relay.var("q", shape=(1, 4, 16), dtype="float32")
+        k = relay.var("k", shape=(1, 4, 16), dtype="float32")
+        v = relay.var("v", shape=(1, 4, 16), dtype="float32")
+        return relay.Function([q, k, v], make_unfused(q, k, v, scale=4.0, divide=True))
+
+    def expected():
+        q = relay.var("q", shape=(1, 4, 16), dtype="float32")
+        k = relay.var("k", shape=(1, 4, 16), dtype="float32")
+        v = relay.var("v", shape=(1, 4, 16), dtype="float32")
+        return relay.Function([q, k, v], relay.nn.fused_attention(q, k, v, scale=0.25))
+
+    zz = run_opt_pass(before(), transform.FuseAttention())
+    after = run_opt_pass(expected(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+
+
+def test_no_fuse_wrong_transpose():
+    # The value matrix is not transposed back, so this is not the attention
+    # idiom; square shapes keep the graph well typed.
+    def before():
+        q = relay.var("q", shape=(1, 8, 8), dtype="float32")
+        k = relay.var("k", shape=(1, 8, 8), dtype="float32")
+        v = relay.var("v", shape=(1, 8, 8), dtype="float32")
+        return relay.Function(
+            [q, k, v], make_unfused(q, k, v, scale=0.125, transpose_axes=(0, 1, 2))
+        )
+
+    zz = run_opt_pass(before(), transform.FuseAttention())
+    after = run_opt_pass(before(), transform.InferType())
+    assert tvm.ir.structural_equal(zz, after)
+
+
+def test_fuse_attention_numeric():
+    shape_q, shape_k, shape_v = (2, 16, 8), (2, 24, 8), (2, 24, 12)
+    q = relay.var("q", shape=shape_q, dtype="float32")
+    k = relay.var("k", shape=shape_k, dtype="float32")
+    v = relay.var("v", shape=shape_v, dtype="float32")
+    func = relay.Function([q, k, v], make_unfused(q, k, v, scale=0.125))
+
+    q_np = np.random.uniform(-1, 1, size=shape_q).astype("float32")
+    k_np = np.random.uniform(-1, 1, size=shape_k).astype("float32")
+    v_np = np.random.uniform(-1, 1, size=shape_v).astype("float32")
+
+    mod = tvm.IRModule.from_expr(func)
+    with tvm.transform.PassContext(opt_level=3):
+        ref = (
+            relay.create_executor("graph", mod=mod, target="llvm")
+            .evaluate()(q_np, k_np, v_np)
+            .numpy()
+        )
+
+    fused_mod = tvm.IRModule.from_expr(func)
+    fused_mod = transform.FuseAttention()(fused_mod)
+    assert "fused_attention" in fused_mod["main"].astext()
+    with tvm.transform.PassContext(opt_level=3):
+        out = (
+            relay.create_executor("graph", mod=fused_mod, target="llvm")
+            .evaluate()(q_np, k_np, v_np)
+            .numpy()
+        )
+
+    np.testing.assert_allclose(out, ref, rtol=1e-5, atol=1e-5)
+
+
+if __name__ == "__main__":
+    test_fuse_attention()
+    test_fuse_attention_divide_scale()
+    test_no_fuse_wrong_transpose()
+    test_fuse_attention_numeric()
@@ -784,6 +784,63 @@ def test_fuse_dynamic_squeeze_slice_take():
     assert np.allclose(result.numpy(), np_result)
 
 
+def test_fuse_data_dependent_shape_func():
+    """Producers fuse into shape-only args of a data-dependent op, never
+    into its data-dependent args."""
+
+    def ops_in_fused_funcs(body):
+        groups = []
+        for call in [body] + list(body.args):
+            if isinstance(call, relay.Call) and isinstance(call.op, relay.Function):
+                names = set()
+
+                def fvisit(e, names=names):
+                    if isinstance(e, relay.Call) and isinstance(e.op, tvm.ir.Op):
+                        names.add(e.op.name)
+
+                relay.analysis.post_order_visit(call.op.body, fvisit)
+                groups.append(names)
+        return groups
+
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    s = relay.var("s", shape=(2,), dtype="int64")
+    # dyn.reshape's shape argument is data dependent; its data argument is not
+    newshape = relay.add(s, relay.const(0, "int64"))
+    y = relay.reshape(relay.exp(x), newshape)
+    fused = run_opt_pass(relay.Function([x, s], y), transform.FuseOps(fuse_opt_level=2))
+
+    groups = ops_in_fused_funcs(fused.body)
+    assert any("exp" in g and "dyn.reshape" in g for g in groups)
+    assert all("add" not in g or "dyn.reshape" not in g for g in groups)
+
+    # end to end on the vm
+    x_np = np.random.random([3, 4]).astype("float32")
+    s_np = np.array([6, 2], dtype="int64")
+    mod = tvm.IRModule.from_expr(relay.Function([x, s], y))
+    ex = relay.create_executor("vm", mod=mod, device=tvm.cpu(), target="llvm")
+    result = ex.evaluate()(x_np, s_np)
+    assert np.allclose(result.numpy(), np.exp(x_np).reshape(6, 2))
+
+
+def test_fuse_incremental():
+    """The incremental cache must return the same fusion as a fresh run."""
+
+    def before(dshape):
+        x = relay.var("x", shape=dshape)
+        y = relay.add(x, relay.const(1, "float32"))
+        z = relay.exp(y)
+        w = relay.squeeze(z)
+        return relay.Function([x], w)
+
+    dshape = (1, 16, 64, 64)
+    fresh = run_opt_pass(before(dshape), transform.FuseOps())
+    with tvm.transform.PassContext(config={"relay.FuseOps.incremental": True}):
+        first = run_opt_pass(before(dshape), transform.FuseOps())
+        second = run_opt_pass(before(dshape), transform.FuseOps())
+    assert tvm.ir.structural_equal(first, fresh)
+    assert tvm.ir.structural_equal(second, fresh)
+
+
 if __name__ == "__main__":
     test_fuse_simple()
     test_conv2d_fuse()
@@ -804,3 +861,4 @@ if __name__ == "__main__":
     test_fuse_gather_nd()
     test_fuse_bcast_reduce_scalar()
     test_fuse_max_diamond()
+    test_fuse_data_dependent_shape_func()
@@ -343,6 +343,27 @@ def test_nat_update():
     transform.PartialEvaluate()(m)
 
 
+def test_step_budget():
+    # With a tiny step budget the recursive call cannot be unrolled, so the
+    # function must be left as written instead of blowing up.
+    t = relay.TensorType([], "int32")
+    x = Var("x", t)
+    f_var = Var("f")
+    f = Function([x], If(op.equal(x, const(0)), const(0), x + f_var(x - const(1))))
+    orig = run_infer_type(Let(f_var, f, f_var(const(10))))
+    def make_mod():
+        return transform.InferType()(tvm.IRModule.from_expr(Function([], orig)))
+
+    expected = make_mod()["main"]
+    with tvm.transform.PassContext(opt_level=3, config={"relay.PartialEval.max_steps": 4}):
+        after = transform.PartialEvaluate()(make_mod())
+    tvm.ir.assert_structural_equal(after["main"], expected)
+    # The default budget is generous enough to specialize it fully.
+    with tvm.transform.PassContext(opt_level=3):
+        after = transform.PartialEvaluate()(make_mod())
+    assert not tvm.ir.structural_equal(after["main"], expected)
+
+
 def test_tuple_match():
     a = relay.Var("a")
     b = relay.Var("b")
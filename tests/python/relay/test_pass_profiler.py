@@ -14,6 +14,8 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import json
+
 import tvm
 import tvm.relay
 from tvm.relay import op
@@ -39,3 +41,32 @@ def test_pass_profiler():
 
     tvm.transform.clear_pass_profiles()
     tvm.transform.disable_pass_profiling()
+
+
+def test_pass_profiler_json():
+    x, y = [tvm.relay.var(c, shape=(3, 4), dtype="float32") for c in "xy"]
+    mod = tvm.IRModule.from_expr(op.add(x, y))
+
+    tvm.transform.enable_pass_profiling()
+
+    mod = tvm.relay.transform.ToANormalForm()(mod)
+    mod = tvm.relay.transform.InferType()(mod)
+
+    profiles = json.loads(tvm.transform.render_pass_profiles_json())
+    names = [p["name"] for p in profiles]
+    assert "ToANormalForm" in names
+    assert "InferType" in names
+    for p in profiles:
+        assert p["duration_us"] >= 0
+        assert int(p["hash_before"], 16) != 0
+        assert int(p["hash_after"], 16) != 0
+    # A pass run back to back on the same module must report the same input
+    # hash both times; that stability is what makes build artifacts diffable.
+    tvm.transform.clear_pass_profiles()
+    tvm.relay.transform.InferType()(mod)
+    tvm.relay.transform.InferType()(mod)
+    profiles = json.loads(tvm.transform.render_pass_profiles_json())
+    assert profiles[0]["hash_before"] == profiles[1]["hash_before"]
+
+    tvm.transform.clear_pass_profiles()
+    tvm.transform.disable_pass_profiling()
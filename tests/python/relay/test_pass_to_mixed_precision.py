@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+
+
+def make_conv_net():
+    x = relay.var("x", shape=(1, 3, 8, 8))
+    w = relay.var("w", shape=(4, 3, 3, 3))
+    y = relay.nn.conv2d(x, w, kernel_size=(3, 3), padding=(1, 1), channels=4)
+    y = relay.nn.relu(y)
+    y = relay.nn.softmax(y, axis=1)
+    return relay.Function([x, w], y)
+
+
+def run_pass(func, **config):
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.InferType()(mod)
+    with tvm.transform.PassContext(config=config):
+        mod = relay.transform.ToMixedPrecision()(mod)
+    return relay.transform.InferType()(mod)
+
+
+def collect_ops(mod):
+    ops = []
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and isinstance(expr.op, tvm.ir.Op):
+            ops.append(expr)
+
+    relay.analysis.post_order_visit(mod["main"].body, visit)
+    return ops
+
+
+def test_conv_converts_softmax_stays_fp32():
+    mod = run_pass(make_conv_net())
+    # The function signature is preserved.
+    assert mod["main"].checked_type.ret_type.dtype == "float32"
+    for call in collect_ops(mod):
+        if call.op.name == "nn.conv2d":
+            # Inputs are fp16, accumulation pinned to fp32.
+            assert call.args[0].checked_type.dtype == "float16"
+            assert call.attrs.out_dtype == "float32"
+        if call.op.name == "nn.softmax":
+            # Sensitive op runs in an fp32 island.
+            assert call.args[0].checked_type.dtype == "float32"
+
+
+def test_numerics_close_to_fp32():
+    func = make_conv_net()
+    mod = tvm.IRModule.from_expr(func)
+    mod = relay.transform.InferType()(mod)
+    mixed = run_pass(func)
+
+    x_np = np.random.uniform(-1, 1, (1, 3, 8, 8)).astype("float32")
+    w_np = np.random.uniform(-1, 1, (4, 3, 3, 3)).astype("float32")
+    ref = (
+        relay.create_executor("graph", mod=mod, device=tvm.cpu(0), target="llvm")
+        .evaluate()(x_np, w_np)
+        .numpy()
+    )
+    out = (
+        relay.create_executor("graph", mod=mixed, device=tvm.cpu(0), target="llvm")
+        .evaluate()(x_np, w_np)
+        .numpy()
+    )
+    tvm.testing.assert_allclose(out, ref, rtol=1e-2, atol=1e-2)
+
+
+def test_skip_ops_forces_fp32():
+    mod = run_pass(make_conv_net(), **{"relay.ToMixedPrecision.skip_ops": ["nn.conv2d"]})
+    for call in collect_ops(mod):
+        if call.op.name == "nn.conv2d":
+            assert call.args[0].checked_type.dtype == "float32"
+
+
+if __name__ == "__main__":
+    test_conv_converts_softmax_stays_fp32()
+    test_numerics_close_to_fp32()
+    test_skip_ops_forces_fp32()
@@ -0,0 +1,81 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay.shape_specialize import (
+    parse_shape_signature,
+    specialize_from_profile,
+    specialize_module,
+    ShapeGuardedVirtualMachine,
+)
+from tvm.runtime.vm import VirtualMachine
+
+
+def dynamic_module():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    y = relay.nn.relu(x + relay.const(1.0, "float32"))
+    return tvm.IRModule.from_expr(relay.Function([x], y))
+
+
+def build_vm(mod):
+    exe = relay.vm.compile(mod, target="llvm")
+    return VirtualMachine(exe, tvm.cpu())
+
+
+def test_parse_shape_signature():
+    assert parse_shape_signature("_8x4") == [(8, 4)]
+    assert parse_shape_signature("_8x4_s_16") == [(8, 4), (), (16,)]
+
+
+def test_specialize_module():
+    static_mod = specialize_module(dynamic_module(), [(8, 4)])
+    param = static_mod["main"].params[0]
+    assert [int(d) for d in param.checked_type.shape] == [8, 4]
+
+
+def test_profile_and_specialize():
+    mod = dynamic_module()
+    vm = build_vm(mod)
+    data = np.random.uniform(-1, 1, size=(8, 4)).astype("float32")
+    for _ in range(3):
+        dyn_result = vm.run(data)
+    profile = vm.get_shape_profile()
+    assert profile["main"]["_8x4"] == 3
+
+    static_mod, input_shapes = specialize_from_profile(mod, profile)
+    assert input_shapes == [(8, 4)]
+    static_result = build_vm(static_mod).run(data)
+    tvm.testing.assert_allclose(static_result.numpy(), dyn_result.numpy())
+
+
+def test_guarded_fallback():
+    mod = dynamic_module()
+    static_mod = specialize_module(mod, [(8, 4)])
+    guarded = ShapeGuardedVirtualMachine(build_vm(static_mod), build_vm(mod), [(8, 4)])
+    for rows in (8, 5):
+        data = np.random.uniform(-1, 1, size=(rows, 4)).astype("float32")
+        expected = np.maximum(data + 1.0, 0.0)
+        tvm.testing.assert_allclose(guarded.run(data).numpy(), expected)
+
+
+if __name__ == "__main__":
+    test_parse_shape_signature()
+    test_specialize_module()
+    test_profile_and_specialize()
+    test_guarded_fallback()
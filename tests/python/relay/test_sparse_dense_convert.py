@@ -86,5 +86,50 @@ def test_bsr_sparse_dense():
     np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
 
 
+def test_csr_sparse_dense():
+    data = relay.var("data", shape=(1, 128), dtype="float32")
+    x = relay.nn.relu(data)
+    w = relay.var("weight", shape=(768, 128), dtype="float32")
+    y = relay.nn.dense(x, w)
+    z = relay.nn.relu(y)
+    func = relay.Function(relay.analysis.free_vars(z), z)
+
+    params = {"weight": tvm.nd.array(random_bsr_matrix(768, 128, 1, 1, 0.1).todense())}
+
+    x_np = np.random.randn(1, 128).astype("float32")
+    # dense output
+    dense_output = run_func(func, params, x_np)
+    # sparse with CSR weights
+    sparse_func, params = relay.data_dep_optimization.bsr_dense.convert(func, params, (1, 1), 0.2)
+    sparse_output = run_func(sparse_func, params, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
+
+
+def test_auto_format_sparse_dense():
+    data = relay.var("data", shape=(1, 128), dtype="float32")
+    x = relay.nn.relu(data)
+    # one blocky weight and one unstructured weight in the same model
+    w1 = relay.var("w1", shape=(768, 128), dtype="float32")
+    w2 = relay.var("w2", shape=(768, 768), dtype="float32")
+    y = relay.nn.dense(relay.nn.dense(x, w1), w2)
+    z = relay.nn.relu(y)
+    func = relay.Function(relay.analysis.free_vars(z), z)
+
+    params = {
+        "w1": tvm.nd.array(random_bsr_matrix(768, 128, 16, 1, 0.1).todense()),
+        "w2": tvm.nd.array(random_bsr_matrix(768, 768, 1, 1, 0.05).todense()),
+    }
+
+    x_np = np.random.randn(1, 128).astype("float32")
+    # dense output
+    dense_output = run_func(func, params, x_np)
+    # per-layer format selection
+    sparse_func, params = relay.data_dep_optimization.bsr_dense.convert(func, params, None, 0.2)
+    sparse_output = run_func(sparse_func, params, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_bsr_sparse_dense()
+    test_csr_sparse_dense()
+    test_auto_format_sparse_dense()
@@ -915,5 +915,41 @@ def test_get_output_multiple():
     np.testing.assert_allclose(outputs[1].numpy(), inp)
 
 
+def test_vm_affine_shape_func():
+    # The shape function of an elementwise op just copies the input shape
+    # elements, so the compiler should evaluate it inline with an
+    # affine_shape instruction instead of a packed-func call.
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    mod = tvm.IRModule()
+    mod["main"] = relay.Function([x], relay.nn.relu(x))
+    exe = relay.vm.compile(mod, "llvm")
+    assert "affine_shape" in exe.bytecode
+
+    data = np.random.uniform(-1.0, 1.0, size=(6, 4)).astype("float32")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    result = vm.invoke("main", data)
+    tvm.testing.assert_allclose(result.numpy(), np.maximum(data, 0.0))
+
+
+def test_vm_constant_pooling():
+    # Structurally identical constants, even across functions, should share
+    # one entry in the executable's constant pool.
+    w_np = np.random.uniform(size=(4, 4)).astype("float32")
+    x = relay.var("x", shape=(4, 4), dtype="float32")
+    mod = tvm.IRModule()
+    sub = relay.GlobalVar("sub")
+    mod[sub] = relay.Function([x], relay.add(x, relay.const(w_np)))
+    y = relay.var("y", shape=(4, 4), dtype="float32")
+    mod["main"] = relay.Function([y], relay.add(sub(y), relay.const(w_np)))
+
+    exe = relay.vm.compile(mod, "llvm")
+    assert "Constant shapes (# 1)" in exe.stats
+
+    data = np.random.uniform(size=(4, 4)).astype("float32")
+    vm_rt = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    result = vm_rt.invoke("main", data)
+    tvm.testing.assert_allclose(result.numpy(), data + 2 * w_np)
+
+
 if __name__ == "__main__":
     pytest.main([__file__])
@@ -0,0 +1,66 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test code for the micro kernel registry"""
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import te
+from tvm.topi.micro_kernel import micro_kernel
+
+
+def test_micro_kernel_lookup():
+    with tvm.target.Target("llvm"):
+        assert micro_kernel("gemm_6x16", "float32") is not None
+        assert micro_kernel("gemm_6x16", "float16") is None
+    # int8 dot cores are only registered for ISAs that have them
+    with tvm.target.Target("llvm -mcpu=skylake-avx512"):
+        assert micro_kernel("dot_16x1x16", "uint8,int8,int32") is not None
+    with tvm.target.Target("llvm"):
+        assert micro_kernel("dot_16x1x16", "uint8,int8,int32") is None
+
+
+@tvm.testing.requires_llvm
+def test_gemm_6x16_fp32_tensorize():
+    M, N, K = 12, 32, 8
+    A = te.placeholder((M, K), name="A")
+    B = te.placeholder((K, N), name="B")
+    k = te.reduce_axis((0, K), name="k")
+    C = te.compute((M, N), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="C")
+    s = te.create_schedule(C.op)
+    with tvm.target.Target("llvm"):
+        intrin = micro_kernel("gemm_6x16", "float32")
+    i, j = s[C].op.axis
+    io, ii = s[C].split(i, factor=6)
+    jo, ji = s[C].split(j, factor=16)
+    ko, ki = s[C].split(k, factor=1)
+    s[C].reorder(io, jo, ko, ii, ji, ki)
+    s[C].tensorize(ii, intrin)
+
+    func = tvm.build(s, [A, B, C], "llvm")
+    dev = tvm.cpu(0)
+    a_np = np.random.uniform(size=(M, K)).astype("float32")
+    b_np = np.random.uniform(size=(K, N)).astype("float32")
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(b_np, dev)
+    c = tvm.nd.array(np.zeros((M, N), dtype="float32"), dev)
+    func(a, b, c)
+    tvm.testing.assert_allclose(c.asnumpy(), np.dot(a_np, b_np), rtol=1e-5)
+
+
+if __name__ == "__main__":
+    test_micro_kernel_lookup()
+    test_gemm_6x16_fp32_tensorize()
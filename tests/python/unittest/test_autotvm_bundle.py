@@ -0,0 +1,70 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""test the bundled schedule database"""
+from tvm import autotvm
+from tvm.autotvm.measure import MeasureInput, MeasureResult
+from tvm.contrib import utils
+
+from test_autotvm_common import get_sample_task
+
+
+def test_bundle_roundtrip():
+    temp = utils.tempdir()
+    path = temp.relpath("llvm.schdb")
+
+    tsk, target = get_sample_task()
+    records = [
+        (MeasureInput(target, tsk, tsk.config_space.get(0)), MeasureResult((0.1,), 0, 2.3, 0)),
+        (MeasureInput(target, tsk, tsk.config_space.get(1)), MeasureResult((0.3,), 0, 2.3, 0)),
+        (MeasureInput(target, tsk, tsk.config_space.get(2)), MeasureResult((0.01,), 0, 2.3, 0)),
+        (MeasureInput(target, tsk, tsk.config_space.get(4)), MeasureResult((0.4,), 0, 2.3, 0)),
+    ]
+    autotvm.bundle.create_bundle(iter(records), path)
+
+    ctx = autotvm.bundle.ApplyBundle(path)
+    x = ctx.query(target, tsk.workload)
+    assert str(x) == str(tsk.config_space.get(2))
+
+    # an unknown workload falls through to the fallback context
+    missing = ctx.query(target, tsk.workload + ("x",))
+    assert missing.is_fallback
+
+
+def test_bundle_context(monkeypatch):
+    temp = utils.tempdir()
+    path = temp.relpath("llvm.schdb")
+
+    tsk, target = get_sample_task()
+    records = [
+        (MeasureInput(target, tsk, tsk.config_space.get(0)), MeasureResult((0.1,), 0, 2.3, 0)),
+    ]
+    autotvm.bundle.create_bundle(iter(records), path)
+
+    # nothing shipped, nothing configured: empty context
+    monkeypatch.delenv(autotvm.bundle.AUTOTVM_BUNDLE_PATH_VAR, raising=False)
+    ctx = autotvm.bundle.context(target)
+    assert isinstance(ctx, autotvm.utils.EmptyContext)
+
+    # explicitly configured bundles are picked up
+    monkeypatch.setenv(autotvm.bundle.AUTOTVM_BUNDLE_PATH_VAR, path)
+    ctx = autotvm.bundle.context(target)
+    x = ctx.query(target, tsk.workload)
+    assert str(x) == str(tsk.config_space.get(0))
+
+
+if __name__ == "__main__":
+    test_bundle_roundtrip()
@@ -81,6 +81,28 @@ def test_curve_feature_gemm():
     assert len(feas) == 30 * 3 * 4 * 2
 
 
+def test_flatten_feature_batch():
+    """batched extraction matches the single-statement API"""
+    N = 128
+
+    def make_sched(tile):
+        k = te.reduce_axis((0, N), "k")
+        A = te.placeholder((N, N), name="A")
+        B = te.placeholder((N, N), name="B")
+        C = te.compute(A.shape, lambda y, x: te.sum(A[y, k] * B[k, x], axis=k), name="C")
+        s = te.create_schedule(C.op)
+        y, x = s[C].op.axis
+        s[C].tile(y, x, tile, tile)
+        return s, [A, B, C]
+
+    pairs = [make_sched(tile) for tile in (4, 8, 16)]
+    batch = feature.get_itervar_feature_flatten_batch(pairs, take_log=True)
+    assert len(batch) == len(pairs)
+    for fea, (s, args) in zip(batch, pairs):
+        single = feature.get_itervar_feature_flatten(s, args, take_log=True)
+        np.testing.assert_allclose(fea, single, rtol=1e-6)
+
+
 def test_feature_shape():
     """test the dimensions of flatten feature are the same"""
 
@@ -133,4 +155,5 @@ def test_feature_shape():
 if __name__ == "__main__":
     test_iter_feature_gemm()
     test_curve_feature_gemm()
+    test_flatten_feature_batch()
     test_feature_shape()
@@ -0,0 +1,75 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test the request-batching executor."""
+import threading
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import graph_executor
+
+
+def _build_executor(batch):
+    x = relay.var("x", shape=(batch, 8), dtype="float32")
+    y = relay.add(relay.multiply(x, relay.const(2.0)), relay.const(1.0))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    lib = relay.build(mod, target="llvm")
+    dev = tvm.cpu(0)
+    return graph_executor.GraphModule(lib["default"](dev))
+
+
+@tvm.testing.requires_llvm
+def test_batching_executor():
+    m1 = _build_executor(1)
+    m4 = _build_executor(4)
+    create = tvm.get_global_func("tvm.batching_executor.create")
+    batcher = create(20000, 1, m1.module, 4, m4.module)
+    assert batcher["max_batch"]() == 4
+    infer = batcher["infer"]
+    dev = tvm.cpu(0)
+
+    data = [np.random.uniform(size=(1, 8)).astype("float32") for _ in range(4)]
+    results = [None] * 4
+
+    def worker(i):
+        out = infer("x", tvm.nd.array(data[i], dev))
+        results[i] = out[0].numpy()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    for i in range(4):
+        np.testing.assert_allclose(results[i], data[i] * 2 + 1, rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_batching_executor_single_request():
+    m2 = _build_executor(2)
+    create = tvm.get_global_func("tvm.batching_executor.create")
+    batcher = create(1000, 2, m2.module)
+    data = np.random.uniform(size=(1, 8)).astype("float32")
+    out = batcher["infer"]("x", tvm.nd.array(data, tvm.cpu(0)))
+    np.testing.assert_allclose(out[0].numpy(), data * 2 + 1, rtol=1e-5)
+
+
+if __name__ == "__main__":
+    test_batching_executor()
+    test_batching_executor_single_request()
@@ -139,6 +139,41 @@ def test_load_unexpected_params():
     rt_mod.load_params(runtime.save_param_dict(new_params))
 
 
+@tvm.testing.requires_llvm
+def test_managed_storage():
+    # Two dense layers keep the weights in separate kernels, so a budget of
+    # one weight forces the executor to stream them in and out per op.
+    x = relay.var("x", shape=(1, 8))
+    w1 = relay.var("w1", shape=(8, 8))
+    w2 = relay.var("w2", shape=(8, 8))
+    z = relay.nn.dense(relay.nn.dense(x, w1), w2)
+    mod = tvm.IRModule.from_expr(relay.Function([x, w1, w2], z))
+
+    lib = relay.build(mod, target="llvm")
+    m = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+
+    x_np = np.random.uniform(size=(1, 8)).astype("float32")
+    w1_np = np.random.uniform(size=(8, 8)).astype("float32")
+    w2_np = np.random.uniform(size=(8, 8)).astype("float32")
+    m.set_input("w1", w1_np)
+    m.set_input("w2", w2_np)
+    m.set_managed_storage(w1_np.nbytes, ["w1", "w2"])
+
+    expected = x_np.dot(w1_np.T).dot(w2_np.T)
+    for _ in range(3):
+        m.set_input("x", x_np)
+        m.run()
+        np.testing.assert_allclose(m.get_output(0).numpy(), expected, rtol=1e-5)
+
+    # updating a managed weight must invalidate its cached device copy
+    w1_np = np.random.uniform(size=(8, 8)).astype("float32")
+    m.set_input("w1", w1_np)
+    m.run()
+    expected = x_np.dot(w1_np.T).dot(w2_np.T)
+    np.testing.assert_allclose(m.get_output(0).numpy(), expected, rtol=1e-5)
+
+
 if __name__ == "__main__":
     test_graph_simple()
     test_load_unexpected_params()
+    test_managed_storage()
@@ -56,5 +56,30 @@ def test_min_repeat_ms():
     assert ct > 10 + 2
 
 
+def test_collect_hw_counters():
+    n = 128
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    func = tvm.build(s, [A, B])
+
+    dev = tvm.cpu()
+    a = tvm.nd.array(tvm.nd.empty((n,)).numpy(), dev)
+    b = tvm.nd.empty((n,), device=dev)
+    ftimer = func.time_evaluator(func.entry_name, dev, number=2, repeat=3, collect_hw_counters=True)
+    res = ftimer(a, b)
+
+    assert len(res.results) == 3
+    assert res.hw_counters is not None and len(res.hw_counters) == 3
+    for counters in res.hw_counters:
+        # zeros are allowed: perf_event may be unavailable in the test environment
+        assert set(counters) == {"instructions", "cycles", "cache_references", "cache_misses", "ipc"}
+
+    # counters are not collected unless asked for
+    res = func.time_evaluator(func.entry_name, dev, number=1, repeat=1)(a, b)
+    assert res.hw_counters is None
+
+
 if __name__ == "__main__":
     test_min_repeat_ms()
+    test_collect_hw_counters()
@@ -0,0 +1,94 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test online kernel variant selection in the graph executor"""
+import json
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import graph_executor
+
+
+def _build_dense(num_variants):
+    x = relay.var("x", shape=(8, 16))
+    w = relay.var("w", shape=(32, 16))
+    y = relay.nn.dense(x, w)
+    mod = tvm.IRModule.from_expr(relay.Function([x, w], y))
+    config = {}
+    if num_variants > 1:
+        config["relay.backend.kernel_variants"] = num_variants
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        lib = relay.build(mod, "llvm")
+    return lib
+
+
+def _has_function(mod, name):
+    try:
+        return mod.get_function(name, query_imports=True) is not None
+    except AttributeError:
+        return False
+
+
+def _dense_func_name(lib):
+    graph = json.loads(lib.get_executor_config())
+    for node in graph["nodes"]:
+        if node["op"] == "tvm_op" and "dense" in node["attrs"]["func_name"]:
+            return node["attrs"]["func_name"]
+    raise AssertionError("no dense node in graph")
+
+
+def test_online_variant_selection():
+    lib = _build_dense(num_variants=2)
+    # the alternative lowering rides along in the module
+    func_name = _dense_func_name(lib)
+    assert _has_function(lib.get_lib(), func_name + "__variant_1")
+
+    dev = tvm.cpu(0)
+    gmod = graph_executor.GraphModule(lib["default"](dev))
+    gmod.set_online_tuning(2)
+
+    x_np = np.random.uniform(size=(8, 16)).astype("float32")
+    w_np = np.random.uniform(size=(32, 16)).astype("float32")
+    expected = np.dot(x_np, w_np.T)
+
+    # every run must be correct, whichever variant is being timed
+    for _ in range(8):
+        gmod.run(x=x_np, w=w_np)
+        tvm.testing.assert_allclose(gmod.get_output(0).numpy(), expected, rtol=1e-5)
+
+    report = gmod.online_tuning_report()
+    assert "dense" in report
+    # after 2 rounds per variant over 8 runs the winner is locked in
+    assert "->" in report
+
+
+def test_variants_disabled_by_default():
+    lib = _build_dense(num_variants=1)
+    func_name = _dense_func_name(lib)
+    assert not _has_function(lib.get_lib(), func_name + "__variant_1")
+
+    dev = tvm.cpu(0)
+    gmod = graph_executor.GraphModule(lib["default"](dev))
+    # report is empty when no op has variants
+    assert gmod.online_tuning_report() == ""
+
+
+if __name__ == "__main__":
+    test_online_variant_selection()
+    test_variants_disabled_by_default()
@@ -0,0 +1,66 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test the replicated multi-device executor."""
+import threading
+
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+
+
+def _build_factory():
+    x = relay.var("x", shape=(1, 16), dtype="float32")
+    y = relay.add(relay.multiply(x, relay.const(3.0)), relay.const(2.0))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+    return relay.build(mod, target="llvm")
+
+
+@tvm.testing.requires_llvm
+def test_replicated_executor():
+    lib = _build_factory()
+    create = tvm.get_global_func("tvm.replicated_executor.create")
+    # two replicas on the same cpu device stand in for per-GPU replicas
+    cpu = tvm.cpu(0)
+    rep = create(lib.module, "default", cpu.device_type, cpu.device_id, cpu.device_type,
+                 cpu.device_id)
+    assert rep["num_replicas"]() == 2
+    infer = rep["infer"]
+
+    data = [np.random.uniform(size=(1, 16)).astype("float32") for _ in range(8)]
+    results = [None] * len(data)
+
+    def worker(i):
+        out = infer("x", tvm.nd.array(data[i], cpu))
+        results[i] = out[0].numpy()
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(len(data))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    for i in range(len(data)):
+        np.testing.assert_allclose(results[i], data[i] * 3 + 2, rtol=1e-5)
+
+    report = rep["stats"]()
+    assert "replica 0" in report
+    assert "replica 1" in report
+
+
+if __name__ == "__main__":
+    test_replicated_executor()
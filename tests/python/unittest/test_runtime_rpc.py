@@ -124,6 +124,33 @@ def test_rpc_array():
     fremote(r_cpu)
 
 
+def _shm_server_loop(path):
+    tvm.get_global_func("rpc.ShmServerLoop")(path)
+
+
+@tvm.testing.requires_rpc
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="shm channel is linux only")
+def test_rpc_shm_session():
+    temp = utils.tempdir()
+    path = temp.relpath("shm_rpc")
+    proc = multiprocessing.Process(target=_shm_server_loop, args=(path,))
+    proc.start()
+    try:
+        client = rpc.ShmSession(path)
+        f1 = client.get_function("rpc.test.addone")
+        assert f1(10) == 11
+        x = np.random.uniform(size=(1024,)).astype("float32")
+        r_cpu = tvm.nd.array(x, client.cpu(0))
+        np.testing.assert_equal(r_cpu.numpy(), x)
+        del r_cpu
+        # dropping the session sends shutdown, which ends the server loop
+        del client
+    finally:
+        proc.join(timeout=10)
+        if proc.is_alive():
+            proc.terminate()
+
+
 @tvm.testing.requires_rpc
 def test_rpc_large_array():
     # testcase of large array creation
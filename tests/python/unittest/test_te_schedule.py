@@ -191,6 +191,31 @@ def test_vectorize_commreduce():
         s[O].vectorize(ax)  # should throw here
 
 
+def test_pack():
+    A = te.placeholder((128, 64), name="A")
+    B = te.placeholder((64, 128), name="B")
+    k = te.reduce_axis((0, 64), name="k")
+    C = te.compute((128, 128), lambda i, j: te.sum(A[i, k] * B[k, j], axis=k), name="C")
+    s = te.create_schedule(C.op)
+    BP = s.pack(B, [8, 16], "global", [C.op])
+    # blocked shape: block indices first, then intra-block offsets
+    assert tuple(BP.shape) == (8, 8, 8, 16)
+    assert BP.op in [stage.op for stage in s.stages]
+    # the reader now loads from the packed layout
+    assert "B.pack.global" in str(s[C].op.body[0])
+    tvm.lower(s, [A, B, C])
+
+
+def test_pack_padding():
+    A = te.placeholder((100,), name="A")
+    B = te.compute((100,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    AP = s.pack(A, [16], "global", [B.op])
+    # 100 = 6 * 16 + 4, the tail block is padded
+    assert tuple(AP.shape) == (7, 16)
+    tvm.lower(s, [A, B])
+
+
 def test_pragma():
     m = 100
     A = te.placeholder((m,), name="A")
@@ -350,6 +375,8 @@ def test_compute_at():
 
 if __name__ == "__main__":
     test_singleton()
+    test_pack()
+    test_pack_padding()
     test_pragma()
     test_tensor_intrin()
     test_tensor_intrin_scalar_params()
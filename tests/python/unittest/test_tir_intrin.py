@@ -181,6 +181,38 @@ def test_clz():
                 np.testing.assert_equal(b.numpy(), ref)
 
 
+def test_dp4a():
+    n = 64
+    A = te.placeholder((n * 4,), name="A", dtype="int8")
+    B = te.placeholder((n * 4,), name="B", dtype="int8")
+
+    def extern_func(ins, outs):
+        ib = tvm.tir.ir_builder.create()
+        aa, bb = ins
+        cc = outs[0]
+        cptr = ib.buffer_ptr(cc)
+        with ib.for_range(0, n, name="i") as i:
+            cptr[i] = tvm.tir.dp4a(
+                aa.vload([i * 4], "int8x4"),
+                bb.vload([i * 4], "int8x4"),
+                tvm.tir.const(0, "int32"),
+            )
+        return ib.get()
+
+    C = te.extern((n,), [A, B], extern_func, name="C", dtype="int32")
+    s = te.create_schedule(C.op)
+    f = tvm.build(s, [A, B, C], "llvm")
+    dev = tvm.cpu(0)
+    a_np = np.random.randint(-128, 128, size=(n * 4,)).astype("int8")
+    b_np = np.random.randint(-128, 128, size=(n * 4,)).astype("int8")
+    a = tvm.nd.array(a_np, dev)
+    b = tvm.nd.array(b_np, dev)
+    c = tvm.nd.array(np.zeros((n,), dtype="int32"), dev)
+    f(a, b, c)
+    ref = (a_np.astype("int32") * b_np.astype("int32")).reshape(n, 4).sum(axis=1)
+    np.testing.assert_equal(c.numpy(), ref)
+
+
 @tvm.script.tir
 class Module:
     def test_tir_fma(A: ty.handle, B: ty.handle, C: ty.handle, d: ty.handle) -> None:
@@ -253,4 +285,5 @@ if __name__ == "__main__":
     test_binary_intrin()
     test_ldexp()
     test_clz()
+    test_dp4a()
     test_fma()
@@ -26,6 +26,18 @@ def test_const():
     assert isinstance(x, tvm.tir.IntImm)
 
 
+def test_imm_interning():
+    # small span-less immediates are interned and shared
+    a = tvm.tir.IntImm("int32", 7)
+    b = tvm.tir.IntImm("int32", 7)
+    assert a.same_as(b)
+    assert not a.same_as(tvm.tir.IntImm("int32", 8))
+    assert not a.same_as(tvm.tir.IntImm("int64", 7))
+    f1 = tvm.tir.FloatImm("float32", 1.5)
+    f2 = tvm.tir.FloatImm("float32", 1.5)
+    assert f1.same_as(f2)
+
+
 def test_scalar_dtype_inference():
     for data in [
         True,
@@ -494,3 +506,4 @@ if __name__ == "__main__":
     test_equality()
     test_equality_string_imm()
     test_block_blockrealize()
+    test_imm_interning()
@@ -0,0 +1,108 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def test_cse_hoist_index_computation():
+    i = te.var("i")
+    n = te.var("n")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    two = tvm.runtime.convert(2.0)
+    body = tvm.tir.SeqStmt(
+        [
+            tvm.tir.Store(Ab.data, one, i * n + n),
+            tvm.tir.Store(Ab.data, two, i * n + n),
+        ]
+    )
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, body)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n], stmt))
+    ret = tvm.tir.transform.CommonSubexprElim()(mod)["main"].body
+
+    assert isinstance(ret, tvm.tir.For)
+    let = ret.body
+    assert isinstance(let, tvm.tir.LetStmt)
+    assert tvm.ir.structural_equal(let.value, i * n + n)
+    seq = let.body
+    assert isinstance(seq.seq[0].index, tvm.tir.Var)
+    assert seq.seq[1].index.same_as(seq.seq[0].index)
+
+
+def test_cse_hoist_load_from_write_free_body():
+    i = te.var("i")
+    n = te.var("n")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    load = tvm.tir.Load("float32", Ab.data, 0)
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, tvm.tir.Evaluate(load + load))
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n], stmt))
+    ret = tvm.tir.transform.CommonSubexprElim()(mod)["main"].body
+
+    let = ret.body
+    assert isinstance(let, tvm.tir.LetStmt)
+    assert tvm.ir.structural_equal(let.value, load)
+
+
+def test_cse_no_load_hoist_across_store():
+    i = te.var("i")
+    n = te.var("n")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    load = tvm.tir.Load("float32", Ab.data, 0)
+    stmt = tvm.tir.For(
+        i, 0, n, tvm.tir.ForKind.SERIAL, tvm.tir.Store(Ab.data, load + load, i)
+    )
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n], stmt))
+    ret = tvm.tir.transform.CommonSubexprElim()(mod)["main"].body
+
+    # the body writes Ab, so the repeated load must stay in place
+    assert isinstance(ret.body, tvm.tir.Store)
+
+
+def test_cse_no_speculative_division():
+    i = te.var("i")
+    n = te.var("n")
+    m = te.var("m")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    two = tvm.runtime.convert(2.0)
+    # the divisor is not a nonzero constant, so the repeated index must not be
+    # bound above the body, where a guard like m != 0 no longer protects it
+    body = tvm.tir.SeqStmt(
+        [
+            tvm.tir.Store(Ab.data, one, i + tvm.tir.truncdiv(n, m)),
+            tvm.tir.Store(Ab.data, two, i + tvm.tir.truncdiv(n, m)),
+        ]
+    )
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, body)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n, m], stmt))
+    ret = tvm.tir.transform.CommonSubexprElim()(mod)["main"].body
+
+    # neither the loop body nor the function scope may bind n / m
+    assert isinstance(ret, tvm.tir.For)
+    assert isinstance(ret.body, tvm.tir.SeqStmt)
+    assert tvm.ir.structural_equal(ret.body.seq[0].index, i + tvm.tir.truncdiv(n, m))
+
+
+if __name__ == "__main__":
+    test_cse_hoist_index_computation()
+    test_cse_hoist_load_from_write_free_body()
+    test_cse_no_load_hoist_across_store()
+    test_cse_no_speculative_division()
@@ -0,0 +1,99 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+import tvm
+import tvm.testing
+from tvm import te
+
+
+def _apply(stmt, buffers):
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc(buffers, stmt))
+    return tvm.tir.transform.FlattenParallelLoops()(mod)["main"].body
+
+
+def test_flatten_perfect_nest():
+    i = te.var("i")
+    j = te.var("j")
+    Ab = tvm.tir.decl_buffer((4, 128), "float32")
+    store = tvm.tir.Store(Ab.data, 1.0, i * 128 + j)
+    stmt = tvm.tir.For(
+        i,
+        0,
+        4,
+        tvm.tir.ForKind.PARALLEL,
+        tvm.tir.For(j, 0, 128, tvm.tir.ForKind.SERIAL, store),
+    )
+
+    ret = _apply(stmt, [Ab])
+    assert isinstance(ret, tvm.tir.For)
+    assert ret.kind == tvm.tir.ForKind.PARALLEL
+    assert ret.extent.value == 4 * 128
+    assert not isinstance(ret.body, tvm.tir.For)
+
+
+def test_keep_imperfect_nest():
+    # A statement between the loops makes the nest imperfect; it must be kept.
+    i = te.var("i")
+    j = te.var("j")
+    Ab = tvm.tir.decl_buffer((4, 128), "float32")
+    store = tvm.tir.Store(Ab.data, 1.0, i * 128 + j)
+    inner = tvm.tir.For(j, 0, 128, tvm.tir.ForKind.SERIAL, store)
+    body = tvm.tir.SeqStmt([tvm.tir.Store(Ab.data, 0.0, i), inner])
+    stmt = tvm.tir.For(i, 0, 4, tvm.tir.ForKind.PARALLEL, body)
+
+    ret = _apply(stmt, [Ab])
+    assert ret.extent.value == 4
+
+
+def test_keep_dynamic_inner_extent():
+    i = te.var("i")
+    j = te.var("j")
+    n = te.var("n")
+    Ab = tvm.tir.decl_buffer((4, n), "float32")
+    store = tvm.tir.Store(Ab.data, 1.0, i * n + j)
+    stmt = tvm.tir.For(
+        i,
+        0,
+        4,
+        tvm.tir.ForKind.PARALLEL,
+        tvm.tir.For(j, 0, n, tvm.tir.ForKind.SERIAL, store),
+    )
+
+    ret = _apply(stmt, [Ab])
+    assert ret.extent.value == 4
+    assert isinstance(ret.body, tvm.tir.For)
+
+
+def test_flatten_build_correctness():
+    A = te.placeholder((4, 8, 32), name="A")
+    B = te.compute(A.shape, lambda i, j, k: A[i, j, k] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    s[B].parallel(B.op.axis[0])
+
+    f = tvm.build(s, [A, B], "llvm")
+    dev = tvm.cpu(0)
+    a = tvm.nd.array(np.random.uniform(size=(4, 8, 32)).astype(A.dtype), dev)
+    b = tvm.nd.array(np.zeros((4, 8, 32), dtype=B.dtype), dev)
+    f(a, b)
+    tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+
+if __name__ == "__main__":
+    test_flatten_perfect_nest()
+    test_keep_imperfect_nest()
+    test_keep_dynamic_inner_extent()
+    test_flatten_build_correctness()
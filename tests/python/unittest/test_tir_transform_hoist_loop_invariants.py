@@ -0,0 +1,121 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def test_licm_hoist_invariant_index():
+    i = te.var("i")
+    n = te.var("n")
+    m = te.var("m")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    # n * m + 7 does not depend on i and must move above the loop
+    body = tvm.tir.Store(Ab.data, one, i + n * m + 7)
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, body)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n, m], stmt))
+    ret = tvm.tir.transform.HoistLoopInvariants()(mod)["main"].body
+
+    assert isinstance(ret, tvm.tir.LetStmt)
+    assert tvm.ir.structural_equal(ret.value, n * m + 7)
+    loop = ret.body
+    assert isinstance(loop, tvm.tir.For)
+    assert tvm.ir.structural_equal(loop.body.index, i + ret.var)
+
+
+def test_licm_hoist_through_nest():
+    i = te.var("i")
+    j = te.var("j")
+    n = te.var("n")
+    m = te.var("m")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    inner = tvm.tir.For(
+        j, 0, m, tvm.tir.ForKind.SERIAL, tvm.tir.Store(Ab.data, one, j + n * m)
+    )
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, inner)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n, m], stmt))
+    ret = tvm.tir.transform.HoistLoopInvariants()(mod)["main"].body
+
+    # n * m is invariant to both loops, so its binding ends up above the nest
+    assert isinstance(ret, tvm.tir.LetStmt)
+    assert tvm.ir.structural_equal(ret.value, n * m)
+    assert isinstance(ret.body, tvm.tir.For)
+    assert isinstance(ret.body.body, tvm.tir.For)
+
+
+def test_licm_keep_variant_and_loads():
+    i = te.var("i")
+    n = te.var("n")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    load = tvm.tir.Load("float32", Ab.data, 0)
+    # i * n varies with i and load + load reads memory; neither may move
+    stmt = tvm.tir.For(
+        i, 0, n, tvm.tir.ForKind.SERIAL, tvm.tir.Store(Ab.data, load + load, i * n)
+    )
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n], stmt))
+    ret = tvm.tir.transform.HoistLoopInvariants()(mod)["main"].body
+
+    assert isinstance(ret, tvm.tir.For)
+    assert isinstance(ret.body, tvm.tir.Store)
+
+
+def test_licm_no_speculative_division():
+    i = te.var("i")
+    n = te.var("n")
+    m = te.var("m")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    # the loop may run zero times, so n / m must not be evaluated above it
+    body = tvm.tir.Store(Ab.data, one, i + tvm.tir.truncdiv(n, m) * 2)
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, body)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n, m], stmt))
+    ret = tvm.tir.transform.HoistLoopInvariants()(mod)["main"].body
+
+    assert isinstance(ret, tvm.tir.For)
+
+
+def test_licm_hoist_invariant_guard_condition():
+    i = te.var("i")
+    n = te.var("n")
+    m = te.var("m")
+    Ab = tvm.tir.decl_buffer((n,), "float32")
+    one = tvm.runtime.convert(1.0)
+    guard = tvm.tir.IfThenElse(
+        n * 4 < m + 3, tvm.tir.Store(Ab.data, one, i), None
+    )
+    stmt = tvm.tir.For(i, 0, n, tvm.tir.ForKind.SERIAL, guard)
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab, n, m], stmt))
+    ret = tvm.tir.transform.HoistLoopInvariants()(mod)["main"].body
+
+    assert isinstance(ret, tvm.tir.LetStmt)
+    assert tvm.ir.structural_equal(ret.value, n * 4 < m + 3)
+    assert isinstance(ret.body.body, tvm.tir.IfThenElse)
+    assert ret.body.body.condition.same_as(ret.var)
+
+
+if __name__ == "__main__":
+    test_licm_hoist_invariant_index()
+    test_licm_hoist_through_nest()
+    test_licm_keep_variant_and_loads()
+    test_licm_no_speculative_division()
+    test_licm_hoist_invariant_guard_condition()
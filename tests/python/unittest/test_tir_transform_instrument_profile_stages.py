@@ -0,0 +1,63 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def collect_extern_calls(stmt):
+    calls = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.name == "tir.call_extern":
+            calls.append(node)
+
+    tvm.tir.stmt_functor.post_order_visit(stmt, visit)
+    return calls
+
+
+def make_schedule():
+    A = te.placeholder((128,), name="A")
+    B = te.compute((128,), lambda i: A[i] + 1.0, name="B")
+    C = te.compute((128,), lambda i: B[i] * 2.0, name="C")
+    s = te.create_schedule(C.op)
+    s[B].pragma(B.op.axis[0], "profile_stage", "add_one")
+    s[C].pragma(C.op.axis[0], "profile_stage", "times_two")
+    return s, [A, C]
+
+
+def test_instrument_profile_stages():
+    s, args = make_schedule()
+    with tvm.transform.PassContext(config={"tir.instrument_profile_stages": True}):
+        mod = tvm.lower(s, args)
+    calls = collect_extern_calls(mod["main"].body)
+    begins = [c for c in calls if c.args[0].value == "TVMBackendProfileStageBegin"]
+    ends = [c for c in calls if c.args[0].value == "TVMBackendProfileStageEnd"]
+    assert len(begins) == 2
+    assert len(ends) == 2
+    assert sorted(c.args[1].value for c in begins) == ["add_one", "times_two"]
+    assert sorted(c.args[1].value for c in ends) == ["add_one", "times_two"]
+
+
+def test_disabled_by_default():
+    s, args = make_schedule()
+    mod = tvm.lower(s, args)
+    assert len(collect_extern_calls(mod["main"].body)) == 0
+
+
+if __name__ == "__main__":
+    test_instrument_profile_stages()
+    test_disabled_by_default()
@@ -66,6 +66,34 @@ def test_const_loop():
     assert not any(collect_visit(stmt, lambda x: isinstance(x, tvm.tir.IfThenElse)))
 
 
+def test_auto_partition_const_loop():
+    n = 21
+    A = te.placeholder((n,), name="A")
+    B = te.placeholder((n,), name="B")
+
+    T = te.compute((n,), lambda i: A[i] + B[i])
+    s = te.create_schedule(T.op)
+    xo, xi = s[T].split(T.op.axis[0], factor=4)
+
+    bounds = tvm.te.schedule.InferBound(s)
+    stmt = tvm.te.schedule.ScheduleOps(s, bounds)
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([], stmt))
+
+    # Auto mode partitions the guarded const loop.
+    with tvm.transform.PassContext(config={"tir.LoopPartition": {"auto_partition": True}}):
+        mod1 = tvm.tir.transform.LoopPartition()(mod)
+        stmt1 = tvm.tir.transform.Simplify()(mod1)["main"].body
+    assert not any(collect_visit(stmt1, lambda x: isinstance(x, tvm.tir.IfThenElse)))
+
+    # With a zero size budget the const loop is left alone.
+    with tvm.transform.PassContext(
+        config={"tir.LoopPartition": {"auto_partition": True, "max_auto_partition_size": 0}}
+    ):
+        mod2 = tvm.tir.transform.LoopPartition()(mod)
+        stmt2 = tvm.tir.transform.Simplify()(mod2)["main"].body
+    assert any(collect_visit(stmt2, lambda x: isinstance(x, tvm.tir.IfThenElse)))
+
+
 def test_no_unroll_loop():
     n = 21
     A = te.placeholder((n,), name="A")
@@ -541,6 +569,7 @@ def test_simple_rfactor():
 if __name__ == "__main__":
     test_basic()
     test_const_loop()
+    test_auto_partition_const_loop()
     test_multi_loop()
     test_multi_if()
     test_thread_axis()
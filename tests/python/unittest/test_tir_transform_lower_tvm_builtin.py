@@ -138,6 +138,40 @@ def test_lower_packed_func():
     check_packed_func("stackvm")
 
 
+def test_workspace_planning():
+    n = 256
+    ib = tvm.tir.ir_builder.create()
+    A = ib.allocate("float32", n, name="A", scope="global")
+    B = ib.allocate("float32", n, name="B", scope="global")
+    with ib.for_range(0, n) as i:
+        B[i] = A[i] + 1.0
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([], stmt))
+    target = tvm.target.Target("llvm")
+    mod = tvm.tir.transform.Apply(lambda f: f.with_attr("target", target))(mod)
+    mod = tvm.tir.transform.Apply(lambda f: f.with_attr("global_symbol", "main"))(mod)
+    mod = tvm.tir.transform.MakePackedAPI()(mod)
+    mod = tvm.tir.transform.LowerTVMBuiltin()(mod)
+    body = mod.functions.items()[0][1].body
+
+    allocs = []
+    addrs = []
+
+    def visit(op):
+        if isinstance(op, tvm.tir.Call):
+            if op.op.same_as(tvm.ir.Op.get("tir.TVMBackendAllocWorkspace")):
+                allocs.append(op)
+            elif op.op.same_as(tvm.ir.Op.get("tir.address_of")):
+                addrs.append(op)
+
+    tvm.tir.stmt_functor.post_order_visit(body, visit)
+    # Both temporaries share one workspace request at static offsets.
+    assert len(allocs) == 1
+    assert len(addrs) == 2
+    assert allocs[0].args[2].value == 2048
+
+
 @tvm.testing.requires_llvm
 def test_call_packed_return_non_i32():
     # This call packed that return non i32 types
@@ -175,3 +209,4 @@ def test_call_packed_return_non_i32():
 if __name__ == "__main__":
     test_call_packed_return_non_i32()
     test_lower_packed_func()
+    test_workspace_planning()
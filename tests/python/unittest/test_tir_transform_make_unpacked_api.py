@@ -0,0 +1,80 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm import te
+
+
+def _lowered_mod():
+    A = te.placeholder((16,), name="A")
+    B = te.placeholder((16,), name="B")
+    C = te.compute(A.shape, lambda *i: A(*i) + B(*i), name="C")
+    s = te.create_schedule(C.op)
+
+    bounds = tvm.te.schedule.InferBound(s)
+    stmt = tvm.te.schedule.ScheduleOps(s, bounds)
+    func = tvm.te.schedule.SchedulePostProcToPrimFunc([A, B, C], stmt, None)
+    mod = tvm.IRModule.from_expr(func)
+    mod = tvm.tir.transform.StorageFlatten(64)(mod)
+    mod = tvm.tir.transform.Apply(
+        lambda f: f.with_attr(
+            {
+                "target": tvm.target.Target("llvm"),
+                "global_symbol": "main",
+            }
+        )
+    )(mod)
+    return mod
+
+
+def test_makeunpackedapi():
+    mod = _lowered_mod()
+    f = tvm.tir.transform.MakeUnpackedAPI()(mod)["main"]
+    # One raw pointer per buffer argument, no packed args/type codes/ret value
+    assert len(f.params) == 3
+    for param in f.params:
+        assert param.dtype == "handle"
+    assert f.ret_type == tvm.ir.PrimType("int32")
+
+
+def test_makeunpackedapi_keeps_scalar_params():
+    n = te.size_var("n")
+    A = te.placeholder((16,), name="A")
+    B = te.compute(A.shape, lambda i: A[i] + n.astype("float32"), name="B")
+    s = te.create_schedule(B.op)
+
+    bounds = tvm.te.schedule.InferBound(s)
+    stmt = tvm.te.schedule.ScheduleOps(s, bounds)
+    func = tvm.te.schedule.SchedulePostProcToPrimFunc([A, n, B], stmt, None)
+    mod = tvm.IRModule.from_expr(func)
+    mod = tvm.tir.transform.StorageFlatten(64)(mod)
+    mod = tvm.tir.transform.Apply(
+        lambda f: f.with_attr(
+            {
+                "target": tvm.target.Target("llvm"),
+                "global_symbol": "main",
+            }
+        )
+    )(mod)
+
+    f = tvm.tir.transform.MakeUnpackedAPI()(mod)["main"]
+    assert len(f.params) == 3
+    assert f.params[1].dtype == "int32"
+
+
+if __name__ == "__main__":
+    test_makeunpackedapi()
+    test_makeunpackedapi_keeps_scalar_params()
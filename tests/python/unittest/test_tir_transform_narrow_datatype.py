@@ -257,6 +257,44 @@ def test_relay_take():
     )
 
 
+def test_guarded_narrow():
+    def build(m, n):
+        ib = tvm.tir.ir_builder.create()
+        Ab = tvm.tir.decl_buffer((m, n), name="A")
+        A = ib.buffer_ptr(Ab)
+        Bb = tvm.tir.decl_buffer((m, n), name="B")
+        B = ib.buffer_ptr(Bb)
+        with ib.for_range(0, m, name="i", dtype="int64") as i:
+            with ib.for_range(0, n, name="j", dtype="int64") as j:
+                B[i * n + j] = A[i * n + j] + 1
+        func = tvm.tir.PrimFunc([Ab, Bb], ib.get())
+        mod = tvm.tir.transform.GuardedNarrowDataType(32)(tvm.IRModule.from_expr(func))
+        return mod["main"].body
+
+    # symbolic i64 shape: a guarded i32 fast path with an i64 fallback
+    m = te.size_var("m", dtype="int64")
+    n = te.size_var("n", dtype="int64")
+    ret = build(m, n)
+    assert isinstance(ret, tvm.tir.IfThenElse)
+    fast = ret.then_case
+    while isinstance(fast, tvm.tir.LetStmt):
+        assert fast.var.dtype == "int32"
+        fast = fast.body
+    assert fast.loop_var.dtype == "int32"
+    assert fast.body.loop_var.dtype == "int32"
+    assert ret.else_case.loop_var.dtype == "int64"
+
+    # static shape that fits needs no guard
+    ret = build(const(2 ** 10, "int64"), const(2 ** 10, "int64"))
+    assert isinstance(ret, tvm.tir.For)
+    assert ret.loop_var.dtype == "int32"
+
+    # static shape that cannot fit stays wide
+    ret = build(const(2 ** 16, "int64"), const(2 ** 16, "int64"))
+    assert isinstance(ret, tvm.tir.For)
+    assert ret.loop_var.dtype == "int64"
+
+
 if __name__ == "__main__":
     test_basic()
     test_thread_axis()
@@ -265,3 +303,4 @@ if __name__ == "__main__":
     test_slice()
     test_relay_basic()
     test_relay_take()
+    test_guarded_narrow()
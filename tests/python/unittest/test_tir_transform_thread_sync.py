@@ -56,5 +56,38 @@ def test_thread_storage_sync():
     assert body_list[1].value.op.same_as(tvm.ir.Op.get("tir.tvm_storage_sync"))
 
 
+def test_sync_elimination_per_thread_range():
+    def build(read_offset):
+        ib = tvm.tir.ir_builder.create()
+        tx = te.thread_axis("threadIdx.x")
+        ib.scope_attr(tx, "thread_extent", 32)
+        A = ib.allocate("float32", 64, name="A", scope="shared")
+        B = ib.allocate("float32", 64, name="B", scope="local")
+        A[tx * 2] = tvm.tir.const(1, "float32")
+        A[tx * 2 + 1] = tvm.tir.const(2, "float32")
+        B[0] = A[tx * 2 + read_offset]
+        stmt = ib.get()
+        mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([], stmt))
+        return tvm.tir.transform.ThreadSync("shared")(mod)["main"]
+
+    def num_syncs(f):
+        count = [0]
+
+        def visit(stmt):
+            if isinstance(stmt, tvm.tir.Call) and stmt.op.same_as(
+                tvm.ir.Op.get("tir.tvm_storage_sync")
+            ):
+                count[0] += 1
+
+        tvm.tir.stmt_functor.post_order_visit(f.body, visit)
+        return count[0]
+
+    # Each thread reads back only the strided range it wrote: no barrier needed.
+    assert num_syncs(build(read_offset=0)) == 0
+    # Reading into the neighboring thread's range still requires a barrier.
+    assert num_syncs(build(read_offset=2)) == 1
+
+
 if __name__ == "__main__":
     test_thread_storage_sync()
+    test_sync_elimination_per_thread_range()
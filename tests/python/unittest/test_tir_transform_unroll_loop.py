@@ -110,7 +110,97 @@ def test_unroll_single_count_loops():
         assert ret == stmt
 
 
+def test_unroll_body_size_budget():
+    ib = tvm.tir.ir_builder.create()
+    dtype = "int64"
+    n = te.size_var("n")
+    Ab = tvm.tir.decl_buffer((n,), dtype)
+    Aptr = ib.buffer_ptr(Ab)
+    with ib.for_range(0, 4, name="i") as i:
+        Aptr[i] = Aptr[i] + 1
+
+    stmt = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab], stmt))
+
+    # within the step threshold but over the expanded body size budget
+    with tvm.transform.PassContext(
+        config={"tir.UnrollLoop": {"auto_max_step": 16, "auto_max_body_size": 8}}
+    ):
+        ret = tvm.tir.transform.UnrollLoop()(mod)["main"].body
+        assert isinstance(ret, tvm.tir.For)
+
+    with tvm.transform.PassContext(
+        config={"tir.UnrollLoop": {"auto_max_step": 16, "auto_max_body_size": 10000}}
+    ):
+        ret = tvm.tir.transform.UnrollLoop()(mod)["main"].body
+        assert not isinstance(ret, tvm.tir.For)
+
+    # explicit unroll requests are never blocked by the budgets
+    with ib.for_range(0, 4, name="i", kind="unroll") as i:
+        Aptr[i] = Aptr[i] + 1
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab], ib.get()))
+    with tvm.transform.PassContext(config={"tir.UnrollLoop": {"auto_max_body_size": 8}}):
+        ret = tvm.tir.transform.UnrollLoop()(mod)["main"].body
+        assert not isinstance(ret, tvm.tir.For)
+
+
+def test_unroll_live_value_budget():
+    ib = tvm.tir.ir_builder.create()
+    dtype = "int64"
+    n = te.size_var("n")
+    Ab = tvm.tir.decl_buffer((n,), dtype)
+    Aptr = ib.buffer_ptr(Ab)
+    with ib.for_range(0, 8, name="i") as i:
+        # two distinct loads live per iteration, sixteen after unrolling
+        Aptr[i] = Aptr[i] + Aptr[i + 1]
+
+    stmt = ib.get()
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([Ab], stmt))
+
+    with tvm.transform.PassContext(
+        config={"tir.UnrollLoop": {"auto_max_step": 16, "auto_max_live_values": 8}}
+    ):
+        ret = tvm.tir.transform.UnrollLoop()(mod)["main"].body
+        assert isinstance(ret, tvm.tir.For)
+
+    with tvm.transform.PassContext(
+        config={"tir.UnrollLoop": {"auto_max_step": 16, "auto_max_live_values": 16}}
+    ):
+        ret = tvm.tir.transform.UnrollLoop()(mod)["main"].body
+        assert not isinstance(ret, tvm.tir.For)
+
+
+def test_estimate_unroll_cost():
+    ib = tvm.tir.ir_builder.create()
+    dtype = "int64"
+    n = te.size_var("n")
+    Ab = tvm.tir.decl_buffer((n,), dtype)
+    Aptr = ib.buffer_ptr(Ab)
+    with ib.for_range(0, 8, name="i") as i:
+        Aptr[i] = Aptr[i] + Aptr[i + 1]
+
+    loop = ib.get()
+    assert isinstance(loop, tvm.tir.For)
+    cost = tvm.tir.analysis.estimate_unroll_cost(loop)
+    assert cost["extent"] == 8
+    assert cost["live_values"] == 2
+    assert cost["body_size"] > 0
+    assert cost["expanded_size"] == 8 * cost["body_size"]
+    assert cost["expanded_live_values"] == 16
+
+    # symbolic extents report no expanded numbers
+    ib = tvm.tir.ir_builder.create()
+    with ib.for_range(0, n, name="i") as i:
+        Aptr[i] = Aptr[i] + 1
+    cost = tvm.tir.analysis.estimate_unroll_cost(ib.get())
+    assert cost["extent"] == -1
+    assert "expanded_size" not in cost
+
+
 if __name__ == "__main__":
     test_unroll_loop()
     test_unroll_fake_loop()
     test_unroll_single_count_loops()
+    test_unroll_body_size_budget()
+    test_unroll_live_value_budget()
+    test_estimate_unroll_cost()
@@ -82,6 +82,31 @@ def test_vectorize_with_if():
     assert isinstance(stmt.else_case, tvm.tir.For)
 
 
+def test_vectorize_with_if_masked():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.pointer("float32", name="A")
+    C = ib.pointer("float32", name="C")
+    with ib.for_range(0, 4, kind="vectorize") as i:
+        with ib.if_scope(i < n):
+            C[i] = A[i] + 1
+    stmt = ib.get()
+
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, C, n], stmt))
+    with tvm.transform.PassContext(config={"tir.enable_masked_vectorize": True}):
+        stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+
+    # The tail branch becomes a predicated store fed by a masked load.
+    assert isinstance(stmt, tvm.tir.Store)
+    assert stmt.predicate.dtype == "uint1x4"
+    assert isinstance(stmt.value.a, tvm.tir.Load)
+    assert stmt.value.a.predicate.dtype == "uint1x4"
+
+    # Without the opt-in flag the branch is scalarized as before.
+    stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.For)
+
+
 def test_vectorize_let():
     v = tvm.tir.Var("v", "float32")
     ib = tvm.tir.ir_builder.create()
@@ -208,6 +233,7 @@ def test_vectorize_while_fail():
 if __name__ == "__main__":
     test_vectorize_vector()
     test_vectorize_with_if()
+    test_vectorize_with_if_masked()
     test_vectorize_loop()
     test_vectorize_if_then_else()
     test_vectorize_with_le_cond()
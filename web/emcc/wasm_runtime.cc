@@ -54,6 +54,15 @@
 
 // --- Implementations of backend and wasm runtime API. ---
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+// Builds with the wasm threads proposal enabled (USE_THREADS=1, served with
+// cross-origin isolation so SharedArrayBuffer is available) get the regular
+// pthreads-backed TVM thread pool, with workers scheduled onto Web Workers
+// by emscripten.
+#include "src/runtime/thread_pool.cc"
+#include "src/runtime/threading_backend.cc"
+#else
+// Single-threaded fallback: run every task inline.
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
   TVMParallelGroupEnv env;
   env.num_task = 1;
@@ -62,6 +71,7 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
 }
 
 int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) { return 0; }
+#endif  // __EMSCRIPTEN_PTHREADS__
 
 // --- Environment PackedFuncs for testing ---
 namespace tvm {